@@ -12,6 +12,7 @@
 
 #include <array>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -26,7 +27,7 @@
 
 // Version number for shader translation API.
 // It is incremented every time the API changes.
-#define ANGLE_SH_VERSION 375
+#define ANGLE_SH_VERSION 378
 
 enum ShShaderSpec
 {
@@ -477,6 +478,11 @@ struct ShCompileOptions
     // Whether inactive shader variables from the output.
     uint64_t removeInactiveVariables : 1;
 
+    // Run transformations that only affect function bodies on each function in parallel, using
+    // the worker thread pool given to the compiler with SetWorkerThreadPool().  Temporary variable
+    // names may differ from a serial compilation, but the output is deterministic.
+    uint64_t parallelFunctionTransformations : 1;
+
     ShCompileOptionsMetal metal;
     ShPixelLocalStorageOptions pls;
 };
@@ -753,6 +759,12 @@ struct ShBuiltInResources
 //
 using ShHandle = void *;
 
+namespace angle
+{
+struct PlatformMethods;
+class WorkerThreadPool;
+}  // namespace angle
+
 namespace sh
 {
 using BinaryBlob       = std::vector<uint32_t>;
@@ -823,6 +835,15 @@ bool Compile(const ShHandle handle,
 // Clears the results from the previous compilation.
 void ClearResults(const ShHandle handle);
 
+// Sets the platform through which the time spent in each compiler pass is reported with trace
+// events.  Passes are not traced if |platformMethods| is nullptr, which is the default.
+void SetPlatformMethods(const ShHandle handle, angle::PlatformMethods *platformMethods);
+
+// Sets the pool on which ShCompileOptions::parallelFunctionTransformations runs function body
+// transformations.  The option has no effect if |workerThreadPool| is null, which is the default.
+void SetWorkerThreadPool(const ShHandle handle,
+                         const std::shared_ptr<angle::WorkerThreadPool> &workerThreadPool);
+
 // Return the version of the shader language.
 int GetShaderVersion(const ShHandle handle);
 
@@ -1478,6 +1478,12 @@ struct FeaturesVk : FeatureSetBase
         &members,
     };
 
+    FeatureInfo elideRedundantSecondaryCommands = {
+        "elideRedundantSecondaryCommands",
+        FeatureCategory::VulkanFeatures,
+        &members,
+    };
+
 };
 
 inline FeaturesVk::FeaturesVk()  = default;
@@ -183,6 +183,18 @@ struct FrontendFeatures : FeatureSetBase
         &members,
     };
 
+    FeatureInfo useWorkStealingWorkerPool = {
+        "useWorkStealingWorkerPool",
+        FeatureCategory::FrontendFeatures,
+        &members,
+    };
+
+    FeatureInfo transformShaderFunctionsInParallel = {
+        "transformShaderFunctionsInParallel",
+        FeatureCategory::FrontendFeatures,
+        &members,
+    };
+
 };
 
 inline FrontendFeatures::FrontendFeatures()  = default;
@@ -0,0 +1,186 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ConcurrentReadMap.h:
+//   An insert-only hash map whose lookups don't take a lock.
+//
+
+#ifndef COMMON_CONCURRENTREADMAP_H_
+#define COMMON_CONCURRENTREADMAP_H_
+
+#include "common/angleutils.h"
+#include "common/debug.h"
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace angle
+{
+// class ConcurrentReadMap: A hash map for read-mostly caches that are shared between threads.
+// find() doesn't take a lock, and can run concurrently with other calls to find() and with one call
+// to insert().  The caller must serialize the calls to insert(), typically with a lock that is only
+// taken once find() misses.  As another thread may have inserted the key in the meantime, the
+// caller must call find() again after taking the lock.
+//
+// Entries are never modified, moved or removed once inserted, so the value returned by find() can
+// be used without a lock.  The table is open addressing, and is kept at most half full.  When it
+// grows, the previous table is retired instead of freed because readers may still be probing it,
+// and it no longer sees new entries; readers that miss in it take the lock and find the entry in
+// the current table.  The retired tables add up to less than the size of the current table, and
+// are freed by clear().  clear() and iteration must not run concurrently with any other call.
+template <typename Key,
+          typename Value,
+          typename Hash     = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class ConcurrentReadMap final : angle::NonCopyable
+{
+  public:
+    using value_type     = std::pair<const Key, Value>;
+    using Storage        = std::deque<value_type>;
+    using const_iterator = typename Storage::const_iterator;
+
+    ConcurrentReadMap();
+    ~ConcurrentReadMap();
+
+    // Returns the value of |key|, or nullptr if it is not in the map.
+    const Value *find(const Key &key) const;
+    // |key| must not be in the map.
+    const Value &insert(const Key &key, Value &&value);
+
+    size_t size() const { return mEntries.size(); }
+    bool empty() const { return mEntries.empty(); }
+    void clear();
+
+    const_iterator begin() const { return mEntries.begin(); }
+    const_iterator end() const { return mEntries.end(); }
+
+  private:
+    static constexpr size_t kInitialCapacity = 16;
+
+    struct Table
+    {
+        explicit Table(size_t capacity);
+
+        size_t mask;
+        std::unique_ptr<std::atomic<const value_type *>[]> slots;
+    };
+
+    // Stores |entry| in the first free slot of its probe sequence.
+    static void InsertIntoTable(Table *table, const value_type *entry);
+
+    void grow();
+
+    // The table readers probe.
+    std::atomic<Table *> mTable;
+    // The retired tables followed by the current one.
+    std::vector<std::unique_ptr<Table>> mTables;
+    // The entries are stored in a deque so they never move once inserted.
+    Storage mEntries;
+};
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+ConcurrentReadMap<Key, Value, Hash, KeyEqual>::Table::Table(size_t capacity)
+    : mask(capacity - 1), slots(new std::atomic<const value_type *>[capacity])
+{
+    ASSERT((capacity & (capacity - 1)) == 0);
+    for (size_t index = 0; index < capacity; ++index)
+    {
+        slots[index].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+ConcurrentReadMap<Key, Value, Hash, KeyEqual>::ConcurrentReadMap() : mTable(nullptr)
+{}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+ConcurrentReadMap<Key, Value, Hash, KeyEqual>::~ConcurrentReadMap() = default;
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+const Value *ConcurrentReadMap<Key, Value, Hash, KeyEqual>::find(const Key &key) const
+{
+    const Table *table = mTable.load(std::memory_order_acquire);
+    if (table == nullptr)
+    {
+        return nullptr;
+    }
+
+    for (size_t index = Hash()(key) & table->mask;; index = (index + 1) & table->mask)
+    {
+        const value_type *entry = table->slots[index].load(std::memory_order_acquire);
+        if (entry == nullptr)
+        {
+            return nullptr;
+        }
+        if (KeyEqual()(entry->first, key))
+        {
+            return &entry->second;
+        }
+    }
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+const Value &ConcurrentReadMap<Key, Value, Hash, KeyEqual>::insert(const Key &key, Value &&value)
+{
+    ASSERT(find(key) == nullptr);
+
+    Table *table = mTable.load(std::memory_order_relaxed);
+    if (table == nullptr || (mEntries.size() + 1) * 2 > table->mask + 1)
+    {
+        grow();
+        table = mTable.load(std::memory_order_relaxed);
+    }
+
+    mEntries.emplace_back(key, std::move(value));
+    InsertIntoTable(table, &mEntries.back());
+
+    return mEntries.back().second;
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+void ConcurrentReadMap<Key, Value, Hash, KeyEqual>::clear()
+{
+    mTable.store(nullptr, std::memory_order_relaxed);
+    mTables.clear();
+    mEntries.clear();
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+void ConcurrentReadMap<Key, Value, Hash, KeyEqual>::InsertIntoTable(Table *table,
+                                                                    const value_type *entry)
+{
+    size_t index = Hash()(entry->first) & table->mask;
+    while (table->slots[index].load(std::memory_order_relaxed) != nullptr)
+    {
+        index = (index + 1) & table->mask;
+    }
+
+    // Publishes the entry to the readers of the table.
+    table->slots[index].store(entry, std::memory_order_release);
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+void ConcurrentReadMap<Key, Value, Hash, KeyEqual>::grow()
+{
+    const Table *table    = mTable.load(std::memory_order_relaxed);
+    const size_t capacity = table == nullptr ? kInitialCapacity : (table->mask + 1) * 2;
+
+    std::unique_ptr<Table> newTable = std::make_unique<Table>(capacity);
+    for (const value_type &entry : mEntries)
+    {
+        InsertIntoTable(newTable.get(), &entry);
+    }
+
+    // The previous table is kept alive for the readers that are still probing it.
+    mTable.store(newTable.get(), std::memory_order_release);
+    mTables.push_back(std::move(newTable));
+}
+}  // namespace angle
+
+#endif  // COMMON_CONCURRENTREADMAP_H_
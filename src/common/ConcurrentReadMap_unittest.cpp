@@ -0,0 +1,145 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ConcurrentReadMap_unittest:
+//   Tests of the ConcurrentReadMap class
+//
+
+#include <gtest/gtest.h>
+
+#include "common/ConcurrentReadMap.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace angle
+{
+// Test basic insertion and lookup.
+TEST(ConcurrentReadMap, InsertAndFind)
+{
+    ConcurrentReadMap<std::string, int> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(nullptr, map.find("a"));
+
+    EXPECT_EQ(1, map.insert("a", 1));
+    EXPECT_EQ(2, map.insert("b", 2));
+    EXPECT_EQ(2u, map.size());
+
+    ASSERT_NE(nullptr, map.find("a"));
+    EXPECT_EQ(1, *map.find("a"));
+    ASSERT_NE(nullptr, map.find("b"));
+    EXPECT_EQ(2, *map.find("b"));
+    EXPECT_EQ(nullptr, map.find("c"));
+}
+
+// Test that entries don't move when the table grows.
+TEST(ConcurrentReadMap, Grow)
+{
+    constexpr int kCount = 1000;
+
+    ConcurrentReadMap<int, int> map;
+    std::vector<const int *> values;
+    for (int key = 0; key < kCount; ++key)
+    {
+        values.push_back(&map.insert(key, key * 2));
+    }
+
+    EXPECT_EQ(static_cast<size_t>(kCount), map.size());
+    for (int key = 0; key < kCount; ++key)
+    {
+        EXPECT_EQ(values[key], map.find(key));
+        EXPECT_EQ(key * 2, *values[key]);
+    }
+    EXPECT_EQ(nullptr, map.find(kCount));
+
+    int count = 0;
+    for (const auto &entry : map)
+    {
+        EXPECT_EQ(entry.first * 2, entry.second);
+        ++count;
+    }
+    EXPECT_EQ(kCount, count);
+}
+
+// Test that clear() removes all entries, and that the map can be reused.
+TEST(ConcurrentReadMap, Clear)
+{
+    ConcurrentReadMap<int, int> map;
+    for (int key = 0; key < 100; ++key)
+    {
+        map.insert(key, key + 1);
+    }
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(nullptr, map.find(0));
+    EXPECT_EQ(map.begin(), map.end());
+
+    map.insert(5, 10);
+    ASSERT_NE(nullptr, map.find(5));
+    EXPECT_EQ(10, *map.find(5));
+}
+
+// Test that lookups from several threads see either no entry or the complete entry while another
+// thread inserts, including while the table grows.
+TEST(ConcurrentReadMap, FindWhileInserting)
+{
+    constexpr int kCount       = 20000;
+    constexpr int kReaderCount = 4;
+
+    ConcurrentReadMap<int, std::string> map;
+    std::atomic<int> insertedCount(0);
+    std::atomic<bool> failed(false);
+
+    std::vector<std::thread> readers;
+    for (int reader = 0; reader < kReaderCount; ++reader)
+    {
+        readers.emplace_back([&map, &insertedCount, &failed, reader]() {
+            int key = reader;
+            while (insertedCount.load(std::memory_order_acquire) < kCount)
+            {
+                // Keys that are known to be inserted must be found.
+                const int inserted       = insertedCount.load(std::memory_order_acquire);
+                const int knownKey       = inserted > 0 ? key % inserted : -1;
+                const std::string *value = map.find(knownKey);
+                if (knownKey >= 0 && (value == nullptr || *value != std::to_string(knownKey)))
+                {
+                    failed = true;
+                }
+
+                // Keys that may be in the middle of being inserted may or may not be found.
+                value = map.find(inserted);
+                if (value != nullptr && *value != std::to_string(inserted))
+                {
+                    failed = true;
+                }
+
+                key += 7;
+            }
+        });
+    }
+
+    for (int key = 0; key < kCount; ++key)
+    {
+        map.insert(key, std::to_string(key));
+        insertedCount.store(key + 1, std::memory_order_release);
+    }
+
+    for (std::thread &reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_FALSE(failed);
+    for (int key = 0; key < kCount; ++key)
+    {
+        const std::string *value = map.find(key);
+        ASSERT_NE(nullptr, value);
+        EXPECT_EQ(std::to_string(key), *value);
+    }
+}
+}  // namespace angle
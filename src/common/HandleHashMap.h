@@ -0,0 +1,350 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// HandleHashMap.h:
+//   An open-addressing hash map from 32-bit handles to small trivially copyable values, such as
+//   object pointers.  Slots are organized in groups of 16, and every slot has a control byte that
+//   is either empty, deleted, or holds 7 bits of the hash of the slot's key.  A lookup compares the
+//   control bytes of a whole group at once (with SSE2 or NEON where available) and only compares
+//   the keys of the slots whose hash bits match.
+//
+
+#ifndef COMMON_HANDLEHASHMAP_H_
+#define COMMON_HANDLEHASHMAP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "common/angleutils.h"
+#include "common/debug.h"
+#include "common/mathutil.h"
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define ANGLE_HANDLE_HASH_MAP_USE_SSE2
+#    if defined(_MSC_VER)
+#        include <intrin.h>
+#    endif
+#    include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#    define ANGLE_HANDLE_HASH_MAP_USE_NEON
+#    include <arm_neon.h>
+#endif
+
+namespace angle
+{
+namespace priv
+{
+// Control byte values.  Full slots hold 7 bits of the hash of their key, so are never negative.
+constexpr int8_t kHandleHashMapEmpty     = -128;
+constexpr int8_t kHandleHashMapDeleted   = -2;
+constexpr size_t kHandleHashMapGroupSize = 16;
+
+// A mask with one bit (or with NEON, one bit out of every four) per slot of a group.
+#if defined(ANGLE_HANDLE_HASH_MAP_USE_NEON)
+using HandleHashMapMask                       = uint64_t;
+constexpr unsigned int kHandleHashMapMaskShift = 2;
+#else
+using HandleHashMapMask                       = uint32_t;
+constexpr unsigned int kHandleHashMapMaskShift = 0;
+#endif
+
+ANGLE_INLINE size_t HandleHashMapMaskFirstSlot(HandleHashMapMask mask)
+{
+    ASSERT(mask != 0);
+    return static_cast<size_t>(gl::ScanForward(mask)) >> kHandleHashMapMaskShift;
+}
+
+// Returns the mask of the slots in the group starting at |ctrl| whose control byte is |value|.
+ANGLE_INLINE HandleHashMapMask HandleHashMapMatch(const int8_t *ctrl, int8_t value)
+{
+#if defined(ANGLE_HANDLE_HASH_MAP_USE_SSE2)
+    const __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl));
+    return static_cast<HandleHashMapMask>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(value))));
+#elif defined(ANGLE_HANDLE_HASH_MAP_USE_NEON)
+    // Narrow the 0x00/0xFF comparison result to a nibble per slot.
+    const uint8x16_t equal  = vceqq_s8(vld1q_s8(ctrl), vdupq_n_s8(value));
+    const uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(equal), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & 0x8888888888888888ull;
+#else
+    HandleHashMapMask mask = 0;
+    for (size_t index = 0; index < kHandleHashMapGroupSize; ++index)
+    {
+        mask |= static_cast<HandleHashMapMask>(ctrl[index] == value) << index;
+    }
+    return mask;
+#endif
+}
+
+// Returns the mask of the slots in the group starting at |ctrl| that are empty or deleted.
+ANGLE_INLINE HandleHashMapMask HandleHashMapMatchNotFull(const int8_t *ctrl)
+{
+#if defined(ANGLE_HANDLE_HASH_MAP_USE_SSE2)
+    const __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl));
+    return static_cast<HandleHashMapMask>(_mm_movemask_epi8(group));
+#elif defined(ANGLE_HANDLE_HASH_MAP_USE_NEON)
+    const uint8x16_t notFull = vcltq_s8(vld1q_s8(ctrl), vdupq_n_s8(0));
+    const uint8x8_t nibbles  = vshrn_n_u16(vreinterpretq_u16_u8(notFull), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & 0x8888888888888888ull;
+#else
+    HandleHashMapMask mask = 0;
+    for (size_t index = 0; index < kHandleHashMapGroupSize; ++index)
+    {
+        mask |= static_cast<HandleHashMapMask>(ctrl[index] < 0) << index;
+    }
+    return mask;
+#endif
+}
+}  // namespace priv
+
+template <typename T>
+class HandleHashMap final : angle::NonCopyable
+{
+  public:
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "HandleHashMap is meant for values such as pointers and handles");
+
+    using value_type = std::pair<uint32_t, T>;
+
+    class const_iterator final
+    {
+      public:
+        bool operator==(const const_iterator &other) const { return mIndex == other.mIndex; }
+        bool operator!=(const const_iterator &other) const { return mIndex != other.mIndex; }
+
+        const_iterator &operator++()
+        {
+            mIndex = mMap->nextFullSlot(mIndex + 1);
+            return *this;
+        }
+
+        const value_type &operator*() const { return mMap->mSlots[mIndex]; }
+        const value_type *operator->() const { return &mMap->mSlots[mIndex]; }
+
+      private:
+        friend class HandleHashMap;
+        const_iterator(const HandleHashMap *map, size_t index) : mMap(map), mIndex(index) {}
+
+        const HandleHashMap *mMap;
+        size_t mIndex;
+    };
+
+    size_t size() const { return mSize; }
+    bool empty() const { return mSize == 0; }
+
+    // Number of slots, full or not.
+    size_t capacity() const { return mGroupCount * kGroupSize; }
+
+    const_iterator begin() const { return const_iterator(this, nextFullSlot(0)); }
+    const_iterator end() const { return const_iterator(this, capacity()); }
+
+    // Returns a pointer to the value of |key|, or nullptr if it is not in the map.
+    ANGLE_INLINE const T *find(uint32_t key) const
+    {
+        const size_t slot = findSlot(key);
+        return slot == kNotFound ? nullptr : &mSlots[slot].second;
+    }
+    ANGLE_INLINE T *find(uint32_t key)
+    {
+        const size_t slot = findSlot(key);
+        return slot == kNotFound ? nullptr : &mSlots[slot].second;
+    }
+
+    bool contains(uint32_t key) const { return findSlot(key) != kNotFound; }
+
+    // Returns the value of |key|, inserting a value-initialized one if it is not in the map.
+    T &operator[](uint32_t key)
+    {
+        T *existing = find(key);
+        if (existing != nullptr)
+        {
+            return *existing;
+        }
+
+        if (mSize + mDeletedCount + 1 > maxFullSlots(capacity()))
+        {
+            // Grow if the map is getting full, otherwise just get rid of the deleted slots.
+            const bool grow = (mSize + 1) * 2 > maxFullSlots(capacity());
+            rehash(grow ? std::max<size_t>(mGroupCount * 2, 1) : mGroupCount);
+        }
+
+        const size_t hash = Hash(key);
+        const size_t slot = findInsertSlot(hash);
+        if (mCtrl[slot] == priv::kHandleHashMapDeleted)
+        {
+            --mDeletedCount;
+        }
+        mCtrl[slot]  = HashTag(hash);
+        mSlots[slot] = value_type(key, T());
+        ++mSize;
+
+        return mSlots[slot].second;
+    }
+
+    // Removes |key| from the map, returning its value in |valueOut|.  Returns false if |key| was
+    // not in the map.
+    bool erase(uint32_t key, T *valueOut)
+    {
+        const size_t slot = findSlot(key);
+        if (slot == kNotFound)
+        {
+            return false;
+        }
+        *valueOut = mSlots[slot].second;
+
+        // Lookups stop at the first group with an empty slot, so if this group has one, no lookup
+        // could have gone past it, and the slot can become empty again.  Otherwise, it's marked
+        // deleted so lookups continue past it.
+        const size_t groupStart = slot & ~(kGroupSize - 1);
+        if (priv::HandleHashMapMatch(&mCtrl[groupStart], priv::kHandleHashMapEmpty) != 0)
+        {
+            mCtrl[slot] = priv::kHandleHashMapEmpty;
+        }
+        else
+        {
+            mCtrl[slot] = priv::kHandleHashMapDeleted;
+            ++mDeletedCount;
+        }
+        --mSize;
+        return true;
+    }
+
+    // Removes all entries and frees the memory.
+    void clear()
+    {
+        mCtrl.reset();
+        mSlots.reset();
+        mGroupCount   = 0;
+        mSize         = 0;
+        mDeletedCount = 0;
+    }
+
+  private:
+    static constexpr size_t kGroupSize = priv::kHandleHashMapGroupSize;
+    static constexpr size_t kNotFound  = std::numeric_limits<size_t>::max();
+
+    // The map is rehashed when more than 7/8 of the slots are full or deleted.
+    static constexpr size_t maxFullSlots(size_t capacity) { return capacity - capacity / 8; }
+
+    // Handles are mostly allocated sequentially, so they are mixed with a multiplication.  The high
+    // half of the product is folded into the low half, which alone only depends on the low bits of
+    // the handle.
+    ANGLE_INLINE static size_t Hash(uint32_t key)
+    {
+        const uint64_t product = static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(product ^ (product >> 32));
+    }
+    ANGLE_INLINE static int8_t HashTag(size_t hash) { return static_cast<int8_t>(hash & 0x7F); }
+    ANGLE_INLINE size_t firstGroup(size_t hash) const { return (hash >> 7) & (mGroupCount - 1); }
+
+    // Groups are visited in triangular number order, which visits every group when the number of
+    // groups is a power of two.
+    ANGLE_INLINE size_t nextGroup(size_t group, size_t probe) const
+    {
+        return (group + probe) & (mGroupCount - 1);
+    }
+
+    ANGLE_INLINE size_t findSlot(uint32_t key) const
+    {
+        if (mGroupCount == 0)
+        {
+            return kNotFound;
+        }
+
+        const size_t hash = Hash(key);
+        const int8_t tag  = HashTag(hash);
+        size_t group      = firstGroup(hash);
+        for (size_t probe = 1;; ++probe)
+        {
+            const int8_t *ctrl = &mCtrl[group * kGroupSize];
+            for (priv::HandleHashMapMask mask = priv::HandleHashMapMatch(ctrl, tag); mask != 0;
+                 mask &= mask - 1)
+            {
+                const size_t slot = group * kGroupSize + priv::HandleHashMapMaskFirstSlot(mask);
+                if (ANGLE_LIKELY(mSlots[slot].first == key))
+                {
+                    return slot;
+                }
+            }
+
+            // There is always an empty slot somewhere as the map is never completely full.
+            if (ANGLE_LIKELY(priv::HandleHashMapMatch(ctrl, priv::kHandleHashMapEmpty) != 0))
+            {
+                return kNotFound;
+            }
+            group = nextGroup(group, probe);
+            ASSERT(probe <= mGroupCount);
+        }
+    }
+
+    // Returns the first empty or deleted slot in the probe sequence of |hash|.
+    size_t findInsertSlot(size_t hash) const
+    {
+        size_t group = firstGroup(hash);
+        for (size_t probe = 1;; ++probe)
+        {
+            const priv::HandleHashMapMask mask =
+                priv::HandleHashMapMatchNotFull(&mCtrl[group * kGroupSize]);
+            if (mask != 0)
+            {
+                return group * kGroupSize + priv::HandleHashMapMaskFirstSlot(mask);
+            }
+            group = nextGroup(group, probe);
+            ASSERT(probe <= mGroupCount);
+        }
+    }
+
+    size_t nextFullSlot(size_t slot) const
+    {
+        while (slot < capacity() && mCtrl[slot] < 0)
+        {
+            ++slot;
+        }
+        return slot;
+    }
+
+    void rehash(size_t newGroupCount)
+    {
+        ASSERT(gl::isPow2(newGroupCount));
+
+        std::unique_ptr<int8_t[]> oldCtrl      = std::move(mCtrl);
+        std::unique_ptr<value_type[]> oldSlots = std::move(mSlots);
+        const size_t oldCapacity               = capacity();
+
+        mGroupCount   = newGroupCount;
+        mCtrl         = std::make_unique<int8_t[]>(capacity());
+        mSlots        = std::make_unique<value_type[]>(capacity());
+        mDeletedCount = 0;
+        memset(mCtrl.get(), priv::kHandleHashMapEmpty, capacity());
+
+        for (size_t slot = 0; slot < oldCapacity; ++slot)
+        {
+            if (oldCtrl[slot] >= 0)
+            {
+                const size_t hash    = Hash(oldSlots[slot].first);
+                const size_t newSlot = findInsertSlot(hash);
+                mCtrl[newSlot]       = HashTag(hash);
+                mSlots[newSlot]      = oldSlots[slot];
+            }
+        }
+    }
+
+    std::unique_ptr<int8_t[]> mCtrl;
+    std::unique_ptr<value_type[]> mSlots;
+    size_t mGroupCount   = 0;
+    size_t mSize         = 0;
+    size_t mDeletedCount = 0;
+};
+}  // namespace angle
+
+#endif  // COMMON_HANDLEHASHMAP_H_
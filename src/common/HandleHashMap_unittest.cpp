@@ -0,0 +1,147 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// HandleHashMap_unittest:
+//   Tests of the HandleHashMap class
+//
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+
+#include "common/HandleHashMap.h"
+
+namespace angle
+{
+// Test inserting, finding and erasing a few handles.
+TEST(HandleHashMap, Basic)
+{
+    HandleHashMap<int> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(nullptr, map.find(0));
+    EXPECT_TRUE(map.begin() == map.end());
+
+    map[0]          = 10;
+    map[5]          = 15;
+    map[0xFFFFFFFF] = 20;
+    EXPECT_EQ(3u, map.size());
+
+    ASSERT_NE(nullptr, map.find(0));
+    EXPECT_EQ(10, *map.find(0));
+    EXPECT_EQ(15, *map.find(5));
+    EXPECT_EQ(20, *map.find(0xFFFFFFFF));
+    EXPECT_EQ(nullptr, map.find(1));
+    EXPECT_TRUE(map.contains(5));
+    EXPECT_FALSE(map.contains(6));
+
+    // Assigning an existing handle replaces its value.
+    map[5] = 25;
+    EXPECT_EQ(3u, map.size());
+    EXPECT_EQ(25, *map.find(5));
+
+    int erased = 0;
+    EXPECT_TRUE(map.erase(5, &erased));
+    EXPECT_EQ(25, erased);
+    EXPECT_FALSE(map.erase(5, &erased));
+    EXPECT_FALSE(map.contains(5));
+    EXPECT_EQ(2u, map.size());
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_FALSE(map.contains(0));
+    EXPECT_TRUE(map.begin() == map.end());
+}
+
+// Test the map against std::map with random insertions and erasures of sparse handles, which leave
+// many deleted slots behind.
+TEST(HandleHashMap, RandomOperations)
+{
+    constexpr size_t kOperationCount = 100000;
+    constexpr uint32_t kHandleRange  = 4096;
+
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<uint32_t> handleDistribution(0, kHandleRange - 1);
+
+    HandleHashMap<uint32_t> map;
+    std::map<uint32_t, uint32_t> expected;
+
+    for (size_t operation = 0; operation < kOperationCount; ++operation)
+    {
+        // Spread the handles over the whole range of values.
+        const uint32_t handle = handleDistribution(generator) * 1048573u;
+        const uint32_t value  = static_cast<uint32_t>(operation);
+
+        if (generator() % 2 == 0)
+        {
+            map[handle]      = value;
+            expected[handle] = value;
+        }
+        else
+        {
+            uint32_t erased     = 0;
+            const bool didErase = map.erase(handle, &erased);
+            ASSERT_EQ(expected.count(handle) != 0, didErase);
+            if (didErase)
+            {
+                ASSERT_EQ(expected[handle], erased);
+                expected.erase(handle);
+            }
+        }
+        ASSERT_EQ(expected.size(), map.size());
+    }
+
+    // The map doesn't grow because of deleted slots.
+    EXPECT_LE(map.capacity(), kHandleRange * 2);
+
+    for (const auto &handleAndValue : expected)
+    {
+        ASSERT_TRUE(map.contains(handleAndValue.first));
+        EXPECT_EQ(handleAndValue.second, *map.find(handleAndValue.first));
+    }
+
+    size_t iterated = 0;
+    for (const auto &handleAndValue : map)
+    {
+        ASSERT_EQ(1u, expected.count(handleAndValue.first));
+        EXPECT_EQ(expected[handleAndValue.first], handleAndValue.second);
+        ++iterated;
+    }
+    EXPECT_EQ(expected.size(), iterated);
+}
+
+// Test that sequential handles, which is how they are usually allocated, are all found.
+TEST(HandleHashMap, SequentialHandles)
+{
+    constexpr uint32_t kFirstHandle = 1000000;
+    constexpr uint32_t kCount       = 50000;
+
+    HandleHashMap<uint32_t> map;
+    for (uint32_t handle = kFirstHandle; handle < kFirstHandle + kCount; ++handle)
+    {
+        map[handle] = handle * 3;
+    }
+    EXPECT_EQ(kCount, map.size());
+
+    for (uint32_t handle = kFirstHandle; handle < kFirstHandle + kCount; ++handle)
+    {
+        ASSERT_NE(nullptr, map.find(handle));
+        EXPECT_EQ(handle * 3, *map.find(handle));
+    }
+    EXPECT_FALSE(map.contains(kFirstHandle - 1));
+    EXPECT_FALSE(map.contains(kFirstHandle + kCount));
+
+    // Erase every other handle and make sure the rest is intact.
+    for (uint32_t handle = kFirstHandle; handle < kFirstHandle + kCount; handle += 2)
+    {
+        uint32_t erased = 0;
+        ASSERT_TRUE(map.erase(handle, &erased));
+    }
+    for (uint32_t handle = kFirstHandle; handle < kFirstHandle + kCount; ++handle)
+    {
+        EXPECT_EQ((handle - kFirstHandle) % 2 == 1, map.contains(handle));
+    }
+}
+}  // namespace angle
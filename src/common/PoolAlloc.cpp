@@ -13,6 +13,10 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+
 #include "common/angleutils.h"
 #include "common/debug.h"
 #include "common/mathutil.h"
@@ -153,6 +157,93 @@ class PageHeader
     Allocation *lastAllocation;
 #    endif
 };
+
+namespace
+{
+std::atomic<size_t> gThreadPageCacheLimit(PoolAllocator::kDefaultThreadPageCacheLimit);
+
+// Single pages released by the recycling allocators of a thread, kept for reuse by the next
+// allocator on that thread.  Pages of each size are kept in a separate list; in practice only one
+// or two page sizes are in use.
+class ThreadPageCache : angle::NonCopyable
+{
+  public:
+    ~ThreadPageCache() { release(); }
+
+    PageHeader *take(size_t pageSize)
+    {
+        for (SizeClass &sizeClass : mSizeClasses)
+        {
+            if (sizeClass.pageSize == pageSize && sizeClass.pages != nullptr)
+            {
+                PageHeader *page = sizeClass.pages;
+                sizeClass.pages  = page->nextPage;
+                mSize -= pageSize;
+                return page;
+            }
+        }
+        return nullptr;
+    }
+
+    // Returns false if the page doesn't fit in the cache, in which case the caller frees it.
+    bool give(PageHeader *page, size_t pageSize)
+    {
+        if (mSize + pageSize > gThreadPageCacheLimit.load(std::memory_order_relaxed))
+        {
+            return false;
+        }
+
+        for (SizeClass &sizeClass : mSizeClasses)
+        {
+            if (sizeClass.pages == nullptr)
+            {
+                sizeClass.pageSize = pageSize;
+            }
+            if (sizeClass.pageSize == pageSize)
+            {
+                page->nextPage  = sizeClass.pages;
+                sizeClass.pages = page;
+                mSize += pageSize;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void release()
+    {
+        for (SizeClass &sizeClass : mSizeClasses)
+        {
+            while (sizeClass.pages != nullptr)
+            {
+                PageHeader *next = sizeClass.pages->nextPage;
+                delete[] reinterpret_cast<char *>(sizeClass.pages);
+                sizeClass.pages = next;
+            }
+        }
+        mSize = 0;
+    }
+
+    size_t size() const { return mSize; }
+
+  private:
+    struct SizeClass
+    {
+        size_t pageSize   = 0;
+        PageHeader *pages = nullptr;
+    };
+    static constexpr size_t kMaxSizeClasses = 4;
+
+    std::array<SizeClass, kMaxSizeClasses> mSizeClasses;
+    size_t mSize = 0;
+};
+
+ThreadPageCache &GetThreadPageCache()
+{
+    thread_local ThreadPageCache cache;
+    return cache;
+}
+}  // anonymous namespace
 #endif
 
 //
@@ -167,8 +258,13 @@ PoolAllocator::PoolAllocator(int growthIncrement, int allocationAlignment)
       mInUseList(nullptr),
       mNumCalls(0),
       mTotalBytes(0),
+      mPagesAllocated(0),
+      mPagesReused(0),
+      mInUseBytes(0),
+      mPeakInUseBytes(0),
 #endif
-      mLocked(false)
+      mLocked(false),
+      mRecyclePages(false)
 {
     initialize(growthIncrement, allocationAlignment);
 }
@@ -220,9 +316,10 @@ PoolAllocator::~PoolAllocator()
 #if !defined(ANGLE_DISABLE_POOL_ALLOC)
     while (mInUseList)
     {
-        PageHeader *next = mInUseList->nextPage;
+        const size_t pageCount = mInUseList->pageCount;
+        PageHeader *next       = mInUseList->nextPage;
         mInUseList->~PageHeader();
-        delete[] reinterpret_cast<char *>(mInUseList);
+        releasePage(mInUseList, pageCount);
         mInUseList = next;
     }
     // We should not check the guard blocks
@@ -232,7 +329,7 @@ PoolAllocator::~PoolAllocator()
     while (mFreeList)
     {
         PageHeader *next = mFreeList->nextPage;
-        delete[] reinterpret_cast<char *>(mFreeList);
+        releasePage(mFreeList, 1);
         mFreeList = next;
     }
 #else  // !defined(ANGLE_DISABLE_POOL_ALLOC)
@@ -310,9 +407,11 @@ void PoolAllocator::pop(ReleaseStrategy releaseStrategy)
         // invoke destructor to free allocation list
         mInUseList->~PageHeader();
 
+        mInUseBytes -= pageCount * mPageSize;
+
         if (pageCount > 1 || releaseStrategy == ReleaseStrategy::All)
         {
-            delete[] reinterpret_cast<char *>(mInUseList);
+            releasePage(mInUseList, pageCount);
         }
         else
         {
@@ -401,6 +500,8 @@ void *PoolAllocator::allocate(size_t numBytes)
         // Use placement-new to initialize header
         new (memory) PageHeader(mInUseList, (numBytesToAlloc + mPageSize - 1) / mPageSize);
         mInUseList = memory;
+        mPagesAllocated += memory->pageCount;
+        onPageAcquired(memory->pageCount);
 
         // Make next allocation come from a new page
         mCurrentPageOffset = mPageSize;
@@ -429,13 +530,18 @@ void *PoolAllocator::allocate(size_t numBytes)
 #if !defined(ANGLE_DISABLE_POOL_ALLOC)
 uint8_t *PoolAllocator::allocateNewPage(size_t numBytes)
 {
-    // Need a simple page to allocate from.  Pick a page from the free list, if any.  Otherwise need
-    // to make the allocation.
-    PageHeader *memory;
+    // Need a simple page to allocate from.  Pick a page from the free list or the thread's page
+    // cache, if any.  Otherwise need to make the allocation.
+    PageHeader *memory = nullptr;
     if (mFreeList)
     {
         memory    = mFreeList;
         mFreeList = mFreeList->nextPage;
+        ++mPagesReused;
+    }
+    else if (mRecyclePages && (memory = GetThreadPageCache().take(mPageSize)) != nullptr)
+    {
+        ++mPagesReused;
     }
     else
     {
@@ -444,10 +550,12 @@ uint8_t *PoolAllocator::allocateNewPage(size_t numBytes)
         {
             return nullptr;
         }
+        ++mPagesAllocated;
     }
     // Use placement-new to initialize header
     new (memory) PageHeader(mInUseList, 1);
     mInUseList = memory;
+    onPageAcquired(1);
 
     // Leave room for the page header.
     mCurrentPageOffset      = mPageHeaderSkip;
@@ -463,6 +571,27 @@ uint8_t *PoolAllocator::allocateNewPage(size_t numBytes)
     return reinterpret_cast<uint8_t *>(mInUseList) + mPageHeaderSkip + preAllocationPadding;
 }
 
+void PoolAllocator::releasePage(PageHeader *page, size_t pageCount)
+{
+    if (mRecyclePages && pageCount == 1)
+    {
+#    if defined(ANGLE_WITH_ASAN)
+        __asan_unpoison_memory_region(page, mPageSize);
+#    endif
+        if (GetThreadPageCache().give(page, mPageSize))
+        {
+            return;
+        }
+    }
+    delete[] reinterpret_cast<char *>(page);
+}
+
+void PoolAllocator::onPageAcquired(size_t pageCount)
+{
+    mInUseBytes += pageCount * mPageSize;
+    mPeakInUseBytes = std::max(mPeakInUseBytes, mInUseBytes);
+}
+
 void *PoolAllocator::initializeAllocation(uint8_t *memory, size_t numBytes)
 {
 #    if defined(ANGLE_POOL_ALLOC_GUARD_BLOCKS)
@@ -474,6 +603,50 @@ void *PoolAllocator::initializeAllocation(uint8_t *memory, size_t numBytes)
 }
 #endif
 
+void PoolAllocator::SetThreadPageCacheLimit(size_t bytes)
+{
+#if !defined(ANGLE_DISABLE_POOL_ALLOC)
+    gThreadPageCacheLimit = bytes;
+#endif
+}
+
+size_t PoolAllocator::GetThreadPageCacheLimit()
+{
+#if !defined(ANGLE_DISABLE_POOL_ALLOC)
+    return gThreadPageCacheLimit;
+#else
+    return 0;
+#endif
+}
+
+size_t PoolAllocator::GetThreadPageCacheSize()
+{
+#if !defined(ANGLE_DISABLE_POOL_ALLOC)
+    return GetThreadPageCache().size();
+#else
+    return 0;
+#endif
+}
+
+void PoolAllocator::ReleaseThreadPageCache()
+{
+#if !defined(ANGLE_DISABLE_POOL_ALLOC)
+    GetThreadPageCache().release();
+#endif
+}
+
+PoolAllocator::Statistics PoolAllocator::getStatistics() const
+{
+    Statistics statistics = {};
+#if !defined(ANGLE_DISABLE_POOL_ALLOC)
+    statistics.bytesAllocated = mTotalBytes;
+    statistics.pagesAllocated = mPagesAllocated;
+    statistics.pagesReused    = mPagesReused;
+    statistics.peakBytes      = mPeakInUseBytes;
+#endif
+    return statistics;
+}
+
 void PoolAllocator::lock()
 {
     ASSERT(!mLocked);
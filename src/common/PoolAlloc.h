@@ -63,6 +63,21 @@ class PoolAllocator : angle::NonCopyable
     };
 
     static const int kDefaultAlignment = sizeof(void *);
+
+    // Default for SetThreadPageCacheLimit().
+    static constexpr size_t kDefaultThreadPageCacheLimit = 1024 * 1024;
+
+    struct Statistics
+    {
+        // Number of bytes requested through allocate().
+        size_t bytesAllocated;
+        // Number of pages allocated from the OS, including multi-page allocations.
+        size_t pagesAllocated;
+        // Number of pages reused from this allocator's free list or the thread's page cache.
+        size_t pagesReused;
+        // Largest amount of page memory in use at once.
+        size_t peakBytes;
+    };
     //
     // Create PoolAllocator. If alignment is set to 1 byte then fastAllocate()
     //  function can be used to make allocations with less overhead.
@@ -96,6 +111,29 @@ class PoolAllocator : angle::NonCopyable
     //
     void popAll();
 
+    //
+    // Normally, pages freed with ReleaseStrategy::All or by the destructor are returned to the OS.
+    // With page recycling, single pages are instead kept in a cache shared by the recycling
+    // allocators of the calling thread, which reuse them before asking the OS for new pages.  This
+    // avoids most OS allocations for allocators that are repeatedly filled and emptied.
+    //
+    void enablePageRecycling() { mRecyclePages = true; }
+
+    //
+    // Sets how many bytes of pages each thread's page cache can hold.  Pages freed beyond that are
+    // returned to the OS.  Setting the limit to zero disables caching.
+    //
+    static void SetThreadPageCacheLimit(size_t bytes);
+    static size_t GetThreadPageCacheLimit();
+
+    // Returns the number of bytes of pages in the calling thread's cache.
+    static size_t GetThreadPageCacheSize();
+
+    // Returns the calling thread's cached pages to the OS.
+    static void ReleaseThreadPageCache();
+
+    Statistics getStatistics() const;
+
     //
     // Call allocate() to actually acquire memory.  Returns 0 if no memory
     // available, otherwise a properly aligned pointer to 'numBytes' of memory.
@@ -151,6 +189,9 @@ class PoolAllocator : angle::NonCopyable
 
     // Slow path of allocation when we have to get a new page.
     uint8_t *allocateNewPage(size_t numBytes);
+    // Returns a page to the thread's page cache if recycling, otherwise to the OS.
+    void releasePage(PageHeader *page, size_t pageCount);
+    void onPageAcquired(size_t pageCount);
     // Track allocations if and only if we're using guard blocks
     void *initializeAllocation(uint8_t *memory, size_t numBytes);
 
@@ -174,12 +215,17 @@ class PoolAllocator : angle::NonCopyable
 
     int mNumCalls;       // just an interesting statistic
     size_t mTotalBytes;  // just an interesting statistic
+    size_t mPagesAllocated;
+    size_t mPagesReused;
+    size_t mInUseBytes;
+    size_t mPeakInUseBytes;
 
 #else  // !defined(ANGLE_DISABLE_POOL_ALLOC)
     std::vector<std::vector<void *>> mStack;
 #endif
 
     bool mLocked;
+    bool mRecyclePages;
 };
 
 }  // namespace angle
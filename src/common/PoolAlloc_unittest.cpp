@@ -77,4 +77,135 @@ INSTANTIATE_TEST_SUITE_P(,
                          testing::Values(2, 4, 8, 16, 32, 64, 128),
                          testing::PrintToStringParamName());
 #endif
+
+#if !defined(ANGLE_DISABLE_POOL_ALLOC)
+constexpr size_t kTestPageSize = 4096;
+
+// Fills about |pageCount| pages of |poolAllocator| with small allocations.
+void FillPages(PoolAllocator *poolAllocator, size_t pageCount)
+{
+    for (size_t i = 0; i < pageCount * 4; ++i)
+    {
+        void *allocation = poolAllocator->allocate(kTestPageSize / 4 - 64);
+        ASSERT_NE(nullptr, allocation);
+    }
+}
+
+class PoolAllocatorPageRecyclingTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        mLimit = PoolAllocator::GetThreadPageCacheLimit();
+        PoolAllocator::ReleaseThreadPageCache();
+    }
+
+    void TearDown() override
+    {
+        PoolAllocator::SetThreadPageCacheLimit(mLimit);
+        PoolAllocator::ReleaseThreadPageCache();
+    }
+
+    size_t mLimit = 0;
+};
+
+// Verify the statistics of an allocator
+TEST(PoolAllocatorTest, Statistics)
+{
+    PoolAllocator poolAllocator(kTestPageSize);
+
+    poolAllocator.push();
+    FillPages(&poolAllocator, 8);
+    PoolAllocator::Statistics statistics = poolAllocator.getStatistics();
+    EXPECT_EQ(8 * 4 * (kTestPageSize / 4 - 64), statistics.bytesAllocated);
+    EXPECT_GE(statistics.pagesAllocated, 8u);
+    EXPECT_EQ(0u, statistics.pagesReused);
+    EXPECT_EQ(statistics.pagesAllocated * kTestPageSize, statistics.peakBytes);
+    poolAllocator.pop();
+
+    // The pages kept by pop() are reused, and don't increase the peak.
+    const size_t pagesAllocated = statistics.pagesAllocated;
+    const size_t peakBytes      = statistics.peakBytes;
+    poolAllocator.push();
+    FillPages(&poolAllocator, 4);
+    statistics = poolAllocator.getStatistics();
+    EXPECT_EQ(pagesAllocated, statistics.pagesAllocated);
+    EXPECT_GE(statistics.pagesReused, 4u);
+    EXPECT_EQ(peakBytes, statistics.peakBytes);
+    poolAllocator.pop();
+}
+
+// Verify that pages released by one recycling allocator are reused by the next one on the thread
+TEST_F(PoolAllocatorPageRecyclingTest, ReuseAcrossAllocators)
+{
+    PoolAllocator::SetThreadPageCacheLimit(64 * kTestPageSize);
+
+    size_t pagesAllocated = 0;
+    {
+        PoolAllocator poolAllocator(kTestPageSize);
+        poolAllocator.enablePageRecycling();
+        poolAllocator.push();
+        FillPages(&poolAllocator, 8);
+        pagesAllocated = poolAllocator.getStatistics().pagesAllocated;
+        poolAllocator.pop(PoolAllocator::ReleaseStrategy::All);
+    }
+    EXPECT_EQ(pagesAllocated * kTestPageSize, PoolAllocator::GetThreadPageCacheSize());
+
+    {
+        PoolAllocator poolAllocator(kTestPageSize);
+        poolAllocator.enablePageRecycling();
+        poolAllocator.push();
+        FillPages(&poolAllocator, 8);
+        PoolAllocator::Statistics statistics = poolAllocator.getStatistics();
+        EXPECT_EQ(0u, statistics.pagesAllocated);
+        EXPECT_EQ(pagesAllocated, statistics.pagesReused);
+        EXPECT_EQ(0u, PoolAllocator::GetThreadPageCacheSize());
+        poolAllocator.pop();
+    }
+
+    // Allocators that don't recycle pages don't use the cache.
+    {
+        PoolAllocator poolAllocator(kTestPageSize);
+        poolAllocator.push();
+        FillPages(&poolAllocator, 8);
+        EXPECT_EQ(0u, poolAllocator.getStatistics().pagesReused);
+        poolAllocator.pop();
+    }
+    EXPECT_EQ(pagesAllocated * kTestPageSize, PoolAllocator::GetThreadPageCacheSize());
+
+    // Pages of a different size are kept apart.
+    {
+        PoolAllocator poolAllocator(2 * kTestPageSize);
+        poolAllocator.enablePageRecycling();
+        poolAllocator.allocate(64);
+        EXPECT_EQ(0u, poolAllocator.getStatistics().pagesReused);
+    }
+    EXPECT_EQ(pagesAllocated * kTestPageSize + 2 * kTestPageSize,
+              PoolAllocator::GetThreadPageCacheSize());
+}
+
+// Verify that the thread's page cache doesn't grow past its limit
+TEST_F(PoolAllocatorPageRecyclingTest, Limit)
+{
+    PoolAllocator::SetThreadPageCacheLimit(4 * kTestPageSize);
+    {
+        PoolAllocator poolAllocator(kTestPageSize);
+        poolAllocator.enablePageRecycling();
+        FillPages(&poolAllocator, 16);
+    }
+    EXPECT_EQ(4 * kTestPageSize, PoolAllocator::GetThreadPageCacheSize());
+
+    PoolAllocator::ReleaseThreadPageCache();
+    EXPECT_EQ(0u, PoolAllocator::GetThreadPageCacheSize());
+
+    // A limit of zero disables the cache.
+    PoolAllocator::SetThreadPageCacheLimit(0);
+    {
+        PoolAllocator poolAllocator(kTestPageSize);
+        poolAllocator.enablePageRecycling();
+        FillPages(&poolAllocator, 16);
+    }
+    EXPECT_EQ(0u, PoolAllocator::GetThreadPageCacheSize());
+}
+#endif
 }  // namespace angle
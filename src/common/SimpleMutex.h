@@ -75,6 +75,12 @@ class MutexOnFutex
             }
         }
     }
+    bool try_lock()
+    {
+        uint32_t oldState = kUnlocked;
+        return mState.compare_exchange_strong(oldState, kLocked, std::memory_order_acquire,
+                                              std::memory_order_relaxed);
+    }
     void unlock()
     {
         // Unlock the mutex
@@ -105,6 +111,7 @@ class MutexOnStd
 {
   public:
     void lock() { mutex.lock(); }
+    bool try_lock() { return mutex.try_lock(); }
     void unlock() { mutex.unlock(); }
     void assertLocked() { ASSERT(isLocked()); }
 
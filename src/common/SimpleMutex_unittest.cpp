@@ -79,6 +79,27 @@ TEST(MutexTest, BasicSimpleMutex)
     EXPECT_TRUE(runBasicMutexTest<SimpleMutex>());
 }
 
+// Tests that angle::SimpleMutex::try_lock fails only while the mutex is held.
+TEST(MutexTest, SimpleMutexTryLock)
+{
+    SimpleMutex mutex;
+    ASSERT_TRUE(mutex.try_lock());
+
+    bool lockedByOtherThread = true;
+    std::thread([&]() { lockedByOtherThread = mutex.try_lock(); }).join();
+    EXPECT_FALSE(lockedByOtherThread);
+
+    mutex.unlock();
+    std::thread([&]() {
+        lockedByOtherThread = mutex.try_lock();
+        if (lockedByOtherThread)
+        {
+            mutex.unlock();
+        }
+    }).join();
+    EXPECT_TRUE(lockedByOtherThread);
+}
+
 // Tests failure with NoOpMutex.  Disabled because it can and will flake.
 TEST(MutexTest, DISABLED_BasicNoOpMutex)
 {
@@ -11,6 +11,7 @@
 #include "common/WorkerThread.h"
 
 #include "common/angleutils.h"
+#include "common/mathutil.h"
 #include "common/system_utils.h"
 
 // Controls if our threading code uses std::async or falls back to single-threaded operations.
@@ -20,7 +21,9 @@
 #endif  // !defined(ANGLE_STD_ASYNC_WORKERS) && & !defined(ANGLE_ENABLE_WINDOWS_UWP)
 
 #if ANGLE_DELEGATE_WORKERS || ANGLE_STD_ASYNC_WORKERS
+#    include <atomic>
 #    include <future>
+#    include <limits>
 #    include <queue>
 #    include <thread>
 #endif  // ANGLE_DELEGATE_WORKERS || ANGLE_STD_ASYNC_WORKERS
@@ -60,6 +63,13 @@ bool AsyncWaitableEvent::isReady()
 WorkerThreadPool::WorkerThreadPool()  = default;
 WorkerThreadPool::~WorkerThreadPool() = default;
 
+std::shared_ptr<WaitableEvent> WorkerThreadPool::postWorkerTaskWithAffinity(
+    const std::shared_ptr<Closure> &task,
+    size_t affinity)
+{
+    return postWorkerTask(task);
+}
+
 class SingleThreadedWorkerPool final : public WorkerThreadPool
 {
   public:
@@ -199,6 +209,542 @@ bool AsyncWorkerPool::isAsync()
     return true;
 }
 
+// A Chase-Lev deque.  Only the owning thread may push and pop at the bottom, while any thread may
+// steal from the top.  Based on "Correct and Efficient Work-Stealing for Weak Memory Models" (Le
+// et al., PPoPP 2013).
+template <typename T>
+class WorkStealingDeque final : angle::NonCopyable
+{
+  public:
+    WorkStealingDeque() : mTop(0), mBottom(0)
+    {
+        mArrays.emplace_back(new Array(kInitialCapacity));
+        mArray.store(mArrays.back().get(), std::memory_order_relaxed);
+    }
+
+    // Owner only.
+    void push(T *item)
+    {
+        const int64_t bottom = mBottom.load(std::memory_order_relaxed);
+        const int64_t top    = mTop.load(std::memory_order_acquire);
+        Array *array         = mArray.load(std::memory_order_relaxed);
+        if (bottom - top > array->capacity - 1)
+        {
+            array = grow(array, top, bottom);
+        }
+        array->put(bottom, item);
+        mBottom.store(bottom + 1, std::memory_order_release);
+    }
+
+    // Owner only.  Returns the most recently pushed item, or nullptr if empty.
+    T *pop()
+    {
+        const int64_t bottom = mBottom.load(std::memory_order_relaxed) - 1;
+        Array *array         = mArray.load(std::memory_order_relaxed);
+        mBottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = mTop.load(std::memory_order_relaxed);
+
+        if (top > bottom)
+        {
+            mBottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        T *item = array->get(bottom);
+        if (top == bottom)
+        {
+            // Last item, race against the thieves for it.
+            if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                              std::memory_order_relaxed))
+            {
+                item = nullptr;
+            }
+            mBottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    // Any thread.  Returns the oldest item, or nullptr if empty or another thread took it first.
+    T *steal()
+    {
+        int64_t top = mTop.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t bottom = mBottom.load(std::memory_order_acquire);
+
+        if (top >= bottom)
+        {
+            return nullptr;
+        }
+
+        // Arrays are only freed with the deque, so a stale array is still safe to read.
+        T *item = mArray.load(std::memory_order_acquire)->get(top);
+        if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed))
+        {
+            return nullptr;
+        }
+        return item;
+    }
+
+    bool empty() const
+    {
+        return mBottom.load(std::memory_order_acquire) <= mTop.load(std::memory_order_acquire);
+    }
+
+  private:
+    static constexpr int64_t kInitialCapacity = 64;
+
+    struct Array
+    {
+        explicit Array(int64_t capacityIn)
+            : capacity(capacityIn), items(new std::atomic<T *>[capacityIn])
+        {
+            ASSERT(gl::isPow2(capacityIn));
+        }
+
+        T *get(int64_t index) const
+        {
+            return items[index & (capacity - 1)].load(std::memory_order_relaxed);
+        }
+        void put(int64_t index, T *item)
+        {
+            items[index & (capacity - 1)].store(item, std::memory_order_relaxed);
+        }
+
+        const int64_t capacity;
+        std::unique_ptr<std::atomic<T *>[]> items;
+    };
+
+    Array *grow(Array *array, int64_t top, int64_t bottom)
+    {
+        mArrays.emplace_back(new Array(array->capacity * 2));
+        Array *newArray = mArrays.back().get();
+        for (int64_t index = top; index < bottom; ++index)
+        {
+            newArray->put(index, array->get(index));
+        }
+        mArray.store(newArray, std::memory_order_release);
+        return newArray;
+    }
+
+    std::atomic<int64_t> mTop;
+    std::atomic<int64_t> mBottom;
+    std::atomic<Array *> mArray;
+    // All the arrays ever used, as thieves may still be reading an old one.  Owner only.
+    std::vector<std::unique_ptr<Array>> mArrays;
+};
+
+// A bounded multi-producer multi-consumer queue that doesn't take locks (D. Vyukov).
+template <typename T>
+class BoundedTaskQueue final : angle::NonCopyable
+{
+  public:
+    explicit BoundedTaskQueue(size_t capacity)
+        : mCells(new Cell[capacity]), mMask(capacity - 1), mEnqueuePos(0), mDequeuePos(0)
+    {
+        ASSERT(gl::isPow2(capacity));
+        for (size_t index = 0; index < capacity; ++index)
+        {
+            mCells[index].sequence.store(index, std::memory_order_relaxed);
+        }
+    }
+
+    // Returns false if the queue is full.
+    bool push(T *item)
+    {
+        size_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+        Cell *cell;
+        while (true)
+        {
+            cell                = &mCells[pos & mMask];
+            const size_t seq    = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = mEnqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->item = item;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Returns nullptr if the queue is empty.
+    T *pop()
+    {
+        size_t pos = mDequeuePos.load(std::memory_order_relaxed);
+        Cell *cell;
+        while (true)
+        {
+            cell                = &mCells[pos & mMask];
+            const size_t seq    = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0)
+            {
+                if (mDequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return nullptr;
+            }
+            else
+            {
+                pos = mDequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        T *item = cell->item;
+        cell->sequence.store(pos + mMask + 1, std::memory_order_release);
+        return item;
+    }
+
+    bool empty() const
+    {
+        return mEnqueuePos.load(std::memory_order_acquire) ==
+               mDequeuePos.load(std::memory_order_acquire);
+    }
+
+  private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        T *item;
+    };
+
+    std::unique_ptr<Cell[]> mCells;
+    const size_t mMask;
+    std::atomic<size_t> mEnqueuePos;
+    std::atomic<size_t> mDequeuePos;
+};
+
+class WorkStealingWorkerPool final : public WorkerThreadPool
+{
+  public:
+    WorkStealingWorkerPool(size_t numThreads);
+
+    ~WorkStealingWorkerPool() override;
+
+    std::shared_ptr<WaitableEvent> postWorkerTask(const std::shared_ptr<Closure> &task) override;
+    std::shared_ptr<WaitableEvent> postWorkerTaskWithAffinity(const std::shared_ptr<Closure> &task,
+                                                              size_t affinity) override;
+
+    bool isAsync() override;
+
+  private:
+    static constexpr size_t kNoAffinity       = std::numeric_limits<size_t>::max();
+    static constexpr size_t kNotAWorker       = std::numeric_limits<size_t>::max();
+    static constexpr size_t kMailboxCapacity  = 256;
+    static constexpr uint32_t kSpinIterations = 64;
+
+    struct Task
+    {
+        std::shared_ptr<AsyncWaitableEvent> waitable;
+        std::shared_ptr<Closure> closure;
+    };
+
+    struct Worker
+    {
+        Worker() : mailbox(kMailboxCapacity) {}
+
+        // Tasks posted by this worker's own tasks.
+        WorkStealingDeque<Task> deque;
+        // Tasks posted by other threads.
+        BoundedTaskQueue<Task> mailbox;
+    };
+
+    void createThreads();
+    size_t getCurrentWorkerIndex() const;
+    void pushToMailbox(Task *task, size_t workerIndex);
+    Task *findTask(size_t workerIndex);
+    bool hasPendingTasks() const;
+    void wakeWorker();
+    // Returns false when the pool is being destroyed.
+    bool park();
+    void runTask(Task *task);
+
+    // Thread's main loop
+    void threadLoop(size_t workerIndex);
+
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+    std::once_flag mThreadsCreated;
+    std::vector<std::thread> mThreads;
+    std::vector<std::thread::id> mThreadIds;
+    std::atomic<size_t> mNextMailbox;
+
+    // Used when all the mailboxes are full.
+    std::mutex mOverflowMutex;
+    std::deque<Task *> mOverflowTasks;
+    std::atomic<size_t> mOverflowTaskCount;
+
+    // Idle workers spin for a little while, then park on |mParkCondVar|.
+    std::mutex mParkMutex;
+    std::condition_variable mParkCondVar;
+    std::atomic<size_t> mParkedWorkerCount;
+    size_t mPendingWakeUps;
+    bool mTerminated;
+};
+
+// WorkStealingWorkerPool implementation.
+
+WorkStealingWorkerPool::WorkStealingWorkerPool(size_t numThreads)
+    : mNextMailbox(0),
+      mOverflowTaskCount(0),
+      mParkedWorkerCount(0),
+      mPendingWakeUps(0),
+      mTerminated(false)
+{
+    ASSERT(numThreads != 0);
+    for (size_t index = 0; index < numThreads; ++index)
+    {
+        mWorkers.emplace_back(new Worker);
+    }
+}
+
+WorkStealingWorkerPool::~WorkStealingWorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mParkMutex);
+        mTerminated = true;
+    }
+    mParkCondVar.notify_all();
+    for (std::thread &thread : mThreads)
+    {
+        ASSERT(thread.get_id() != std::this_thread::get_id());
+        thread.join();
+    }
+
+    // The workers run every task before parking, so there is nothing left to free unless tasks
+    // were posted during destruction.
+    for (std::unique_ptr<Worker> &worker : mWorkers)
+    {
+        ASSERT(worker->deque.empty() && worker->mailbox.empty());
+    }
+    ASSERT(mOverflowTasks.empty());
+}
+
+void WorkStealingWorkerPool::createThreads()
+{
+    mThreadIds.reserve(mWorkers.size());
+    for (size_t index = 0; index < mWorkers.size(); ++index)
+    {
+        mThreads.emplace_back(&WorkStealingWorkerPool::threadLoop, this, index);
+        mThreadIds.push_back(mThreads.back().get_id());
+    }
+}
+
+size_t WorkStealingWorkerPool::getCurrentWorkerIndex() const
+{
+    const std::thread::id currentThreadId = std::this_thread::get_id();
+    for (size_t index = 0; index < mThreadIds.size(); ++index)
+    {
+        if (mThreadIds[index] == currentThreadId)
+        {
+            return index;
+        }
+    }
+    return kNotAWorker;
+}
+
+std::shared_ptr<WaitableEvent> WorkStealingWorkerPool::postWorkerTask(
+    const std::shared_ptr<Closure> &task)
+{
+    return postWorkerTaskWithAffinity(task, kNoAffinity);
+}
+
+std::shared_ptr<WaitableEvent> WorkStealingWorkerPool::postWorkerTaskWithAffinity(
+    const std::shared_ptr<Closure> &task,
+    size_t affinity)
+{
+    // Thread safety: This function is thread-safe because the threads are created only once, after
+    // which |mThreadIds| doesn't change, and the task queues are safe to push to concurrently.
+    // Only the owning worker pushes to its deque.
+    std::call_once(mThreadsCreated, [this] { createThreads(); });
+
+    auto waitable = std::make_shared<AsyncWaitableEvent>();
+    Task *newTask = new Task{waitable, task};
+
+    const size_t currentWorker = getCurrentWorkerIndex();
+    if (affinity == kNoAffinity && currentWorker != kNotAWorker)
+    {
+        // Tasks posted by tasks likely use the same data, so keep them on this thread unless
+        // another one is idle.
+        mWorkers[currentWorker]->deque.push(newTask);
+    }
+    else
+    {
+        const size_t workerIndex =
+            affinity == kNoAffinity ? mNextMailbox.fetch_add(1, std::memory_order_relaxed)
+                                    : affinity;
+        pushToMailbox(newTask, workerIndex % mWorkers.size());
+    }
+
+    wakeWorker();
+    return waitable;
+}
+
+void WorkStealingWorkerPool::pushToMailbox(Task *task, size_t workerIndex)
+{
+    for (size_t attempt = 0; attempt < mWorkers.size(); ++attempt)
+    {
+        if (mWorkers[(workerIndex + attempt) % mWorkers.size()]->mailbox.push(task))
+        {
+            return;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mOverflowMutex);
+    mOverflowTasks.push_back(task);
+    mOverflowTaskCount.fetch_add(1, std::memory_order_release);
+}
+
+WorkStealingWorkerPool::Task *WorkStealingWorkerPool::findTask(size_t workerIndex)
+{
+    Worker *self = mWorkers[workerIndex].get();
+    if (Task *task = self->deque.pop())
+    {
+        return task;
+    }
+    if (Task *task = self->mailbox.pop())
+    {
+        return task;
+    }
+
+    for (size_t offset = 1; offset < mWorkers.size(); ++offset)
+    {
+        Worker *victim = mWorkers[(workerIndex + offset) % mWorkers.size()].get();
+        if (Task *task = victim->deque.steal())
+        {
+            return task;
+        }
+        if (Task *task = victim->mailbox.pop())
+        {
+            return task;
+        }
+    }
+
+    if (mOverflowTaskCount.load(std::memory_order_acquire) > 0)
+    {
+        std::lock_guard<std::mutex> lock(mOverflowMutex);
+        if (!mOverflowTasks.empty())
+        {
+            Task *task = mOverflowTasks.front();
+            mOverflowTasks.pop_front();
+            mOverflowTaskCount.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+
+    return nullptr;
+}
+
+bool WorkStealingWorkerPool::hasPendingTasks() const
+{
+    for (const std::unique_ptr<Worker> &worker : mWorkers)
+    {
+        if (!worker->deque.empty() || !worker->mailbox.empty())
+        {
+            return true;
+        }
+    }
+    return mOverflowTaskCount.load(std::memory_order_acquire) > 0;
+}
+
+void WorkStealingWorkerPool::wakeWorker()
+{
+    // Pairs with the fence in park(): either the parking worker sees the new task, or this sees
+    // the parked worker.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (mParkedWorkerCount.load(std::memory_order_relaxed) == 0)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mParkMutex);
+        if (mPendingWakeUps >= mParkedWorkerCount.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+        ++mPendingWakeUps;
+    }
+    mParkCondVar.notify_one();
+}
+
+bool WorkStealingWorkerPool::park()
+{
+    std::unique_lock<std::mutex> lock(mParkMutex);
+    mParkedWorkerCount.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (!mTerminated && !hasPendingTasks())
+    {
+        mParkCondVar.wait(lock, [this] { return mPendingWakeUps > 0 || mTerminated; });
+        if (mPendingWakeUps > 0)
+        {
+            --mPendingWakeUps;
+        }
+    }
+
+    mParkedWorkerCount.fetch_sub(1, std::memory_order_relaxed);
+    return !mTerminated;
+}
+
+void WorkStealingWorkerPool::runTask(Task *task)
+{
+    // Note: always add an ANGLE_TRACE_EVENT* macro in the closure.  Then the job will show up in
+    // traces.
+    (*task->closure)();
+
+    // Release shared_ptr<Closure> before notifying the event to allow for destructor based
+    // dependencies (example: anglebug.com/42267099)
+    std::shared_ptr<AsyncWaitableEvent> waitable = std::move(task->waitable);
+    delete task;
+    waitable->markAsReady();
+}
+
+void WorkStealingWorkerPool::threadLoop(size_t workerIndex)
+{
+    angle::SetCurrentThreadName("ANGLE-Worker");
+
+    while (true)
+    {
+        Task *task = findTask(workerIndex);
+        for (uint32_t spin = 0; task == nullptr && spin < kSpinIterations; ++spin)
+        {
+            std::this_thread::yield();
+            task = findTask(workerIndex);
+        }
+
+        if (task != nullptr)
+        {
+            runTask(task);
+        }
+        else if (!park())
+        {
+            return;
+        }
+    }
+}
+
+bool WorkStealingWorkerPool::isAsync()
+{
+    return true;
+}
+
 #endif  // ANGLE_STD_ASYNC_WORKERS
 
 #if ANGLE_DELEGATE_WORKERS
@@ -278,7 +824,8 @@ bool DelegateWorkerPool::isAsync()
 
 // static
 std::shared_ptr<WorkerThreadPool> WorkerThreadPool::Create(size_t numThreads,
-                                                           PlatformMethods *platform)
+                                                           PlatformMethods *platform,
+                                                           WorkerTaskQueue taskQueue)
 {
     const bool multithreaded = numThreads != 1;
     std::shared_ptr<WorkerThreadPool> pool(nullptr);
@@ -293,8 +840,16 @@ std::shared_ptr<WorkerThreadPool> WorkerThreadPool::Create(size_t numThreads,
 #if ANGLE_STD_ASYNC_WORKERS
     if (!pool && multithreaded)
     {
-        pool = std::shared_ptr<WorkerThreadPool>(new AsyncWorkerPool(
-            numThreads == 0 ? std::thread::hardware_concurrency() : numThreads));
+        const size_t threadCount =
+            numThreads == 0 ? std::thread::hardware_concurrency() : numThreads;
+        if (taskQueue == WorkerTaskQueue::WorkStealing)
+        {
+            pool = std::shared_ptr<WorkerThreadPool>(new WorkStealingWorkerPool(threadCount));
+        }
+        else
+        {
+            pool = std::shared_ptr<WorkerThreadPool>(new AsyncWorkerPool(threadCount));
+        }
     }
 #endif
     if (!pool)
@@ -303,4 +858,5 @@ std::shared_ptr<WorkerThreadPool> WorkerThreadPool::Create(size_t numThreads,
     }
     return pool;
 }
+
 }  // namespace angle
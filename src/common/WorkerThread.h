@@ -100,6 +100,16 @@ class AsyncWaitableEvent final : public WaitableEvent
     std::condition_variable mCondition;
 };
 
+// How a multi-threaded pool run by ANGLE hands out its tasks.
+enum class WorkerTaskQueue
+{
+    // All threads share one locked queue.
+    Shared,
+    // Each thread has its own task queue, from which idle threads steal.  This reduces contention
+    // and wake-up latency when many short tasks are posted.
+    WorkStealing,
+};
+
 // Request WorkerThreads from the WorkerThreadPool. Each pool can keep worker threads around so
 // we avoid the costly spin up and spin down time.
 class WorkerThreadPool : angle::NonCopyable
@@ -113,13 +123,24 @@ class WorkerThreadPool : angle::NonCopyable
     // If numThreads is 1, the pool will be single-threaded. Tasks will run on the calling thread.
     // Other numbers indicate how many threads the pool should spawn.
     // Note that based on build options, this class may not actually run tasks in threads, or it may
-    // hook into the provided PlatformMethods::postWorkerTask, in which case numThreads is ignored.
-    static std::shared_ptr<WorkerThreadPool> Create(size_t numThreads, PlatformMethods *platform);
+    // hook into the provided PlatformMethods::postWorkerTask, in which case numThreads and
+    // taskQueue are ignored.
+    static std::shared_ptr<WorkerThreadPool> Create(
+        size_t numThreads,
+        PlatformMethods *platform,
+        WorkerTaskQueue taskQueue = WorkerTaskQueue::Shared);
 
     // Returns an event to wait on for the task to finish.  If the pool fails to create the task,
     // returns null.  This function is thread-safe.
     virtual std::shared_ptr<WaitableEvent> postWorkerTask(const std::shared_ptr<Closure> &task) = 0;
 
+    // Same as postWorkerTask(), but hints that tasks posted with the same |affinity| should run on
+    // the same thread, for example because they use the same data.  Idle threads may still run the
+    // task.  Pools that have no use for the hint ignore it.
+    virtual std::shared_ptr<WaitableEvent> postWorkerTaskWithAffinity(
+        const std::shared_ptr<Closure> &task,
+        size_t affinity);
+
     virtual bool isAsync() = 0;
 
   private:
@@ -8,6 +8,10 @@
 
 #include <gtest/gtest.h>
 #include <array>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "common/WorkerThread.h"
 
@@ -27,9 +31,10 @@ TEST(WorkerPoolTest, SimpleTask)
         bool fired = false;
     };
 
-    std::array<std::shared_ptr<WorkerThreadPool>, 2> pools = {
+    std::array<std::shared_ptr<WorkerThreadPool>, 3> pools = {
         {WorkerThreadPool::Create(1, ANGLEPlatformCurrent()),
-         WorkerThreadPool::Create(0, ANGLEPlatformCurrent())}};
+         WorkerThreadPool::Create(0, ANGLEPlatformCurrent()),
+         WorkerThreadPool::Create(0, ANGLEPlatformCurrent(), WorkerTaskQueue::WorkStealing)}};
     for (auto &pool : pools)
     {
         std::array<std::shared_ptr<TestTask>, 4> tasks = {
@@ -48,4 +53,113 @@ TEST(WorkerPoolTest, SimpleTask)
     }
 }
 
+class CountingTask : public Closure
+{
+  public:
+    CountingTask(std::atomic<int> *counter) : mCounter(counter) {}
+    void operator()() override { mCounter->fetch_add(1); }
+
+  private:
+    std::atomic<int> *mCounter;
+};
+
+// Tests that tasks posted from many threads at once, more than fit in the work-stealing pool's
+// per-thread queues, all run.
+TEST(WorkerPoolTest, WorkStealingManyTasks)
+{
+    constexpr int kPosterCount    = 4;
+    constexpr int kTasksPerPoster = 2000;
+    std::shared_ptr<WorkerThreadPool> pool =
+        WorkerThreadPool::Create(4, ANGLEPlatformCurrent(), WorkerTaskQueue::WorkStealing);
+
+    std::atomic<int> counter(0);
+    std::vector<std::vector<std::shared_ptr<WaitableEvent>>> waitables(kPosterCount);
+    std::vector<std::thread> posters;
+    for (int poster = 0; poster < kPosterCount; ++poster)
+    {
+        posters.emplace_back([&, poster] {
+            for (int task = 0; task < kTasksPerPoster; ++task)
+            {
+                auto closure = std::make_shared<CountingTask>(&counter);
+                waitables[poster].push_back(
+                    task % 2 == 0 ? pool->postWorkerTask(closure)
+                                  : pool->postWorkerTaskWithAffinity(closure, poster));
+            }
+        });
+    }
+    for (std::thread &poster : posters)
+    {
+        poster.join();
+    }
+    for (auto &posterWaitables : waitables)
+    {
+        WaitableEvent::WaitMany(&posterWaitables);
+    }
+
+    EXPECT_EQ(kPosterCount * kTasksPerPoster, counter.load());
+}
+
+// Tests that tasks posted by tasks, which the work-stealing pool keeps on the posting thread unless
+// others are idle, all run.
+TEST(WorkerPoolTest, WorkStealingNestedTasks)
+{
+    struct State
+    {
+        WorkerThreadPool *pool;
+        std::atomic<int> counter{0};
+        std::mutex mutex;
+        std::vector<std::shared_ptr<WaitableEvent>> waitables;
+    };
+
+    class ForkTask : public Closure
+    {
+      public:
+        ForkTask(State *state, int depth) : mState(state), mDepth(depth) {}
+
+        void operator()() override
+        {
+            mState->counter.fetch_add(1);
+            for (int child = 0; mDepth > 0 && child < 2; ++child)
+            {
+                std::shared_ptr<WaitableEvent> waitable = mState->pool->postWorkerTask(
+                    std::make_shared<ForkTask>(mState, mDepth - 1));
+                std::lock_guard<std::mutex> lock(mState->mutex);
+                mState->waitables.push_back(waitable);
+            }
+        }
+
+      private:
+        State *mState;
+        int mDepth;
+    };
+
+    constexpr int kDepth = 10;
+    std::shared_ptr<WorkerThreadPool> pool =
+        WorkerThreadPool::Create(4, ANGLEPlatformCurrent(), WorkerTaskQueue::WorkStealing);
+
+    State state;
+    state.pool = pool.get();
+    pool->postWorkerTask(std::make_shared<ForkTask>(&state, kDepth))->wait();
+
+    // Tasks add their children's events before completing, so waiting for all the known events
+    // until no new ones appear waits for the whole tree.
+    size_t waitedCount = 0;
+    while (true)
+    {
+        std::vector<std::shared_ptr<WaitableEvent>> pending;
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            pending.assign(state.waitables.begin() + waitedCount, state.waitables.end());
+        }
+        if (pending.empty())
+        {
+            break;
+        }
+        WaitableEvent::WaitMany(&pending);
+        waitedCount += pending.size();
+    }
+
+    EXPECT_EQ((1 << (kDepth + 1)) - 1, state.counter.load());
+}
+
 }  // anonymous namespace
@@ -163,7 +163,12 @@ struct PerfMonitorTriplet
     FN(dynamicBufferAllocations)                   \
     FN(framebufferCacheSize)                       \
     FN(pendingSubmissionGarbageObjects)            \
-    FN(graphicsDriverUniformsUpdated)
+    FN(graphicsDriverUniformsUpdated)              \
+    FN(elidedSecondaryCommands)                    \
+    FN(commandMemorySizeBytes)                     \
+    FN(commandMemoryPoolFreeBytes)                 \
+    FN(coalescedBufferUpdates)                     \
+    FN(imageUpdateStagingBytes)
 
 #define ANGLE_DECLARE_PERF_COUNTER(COUNTER) uint64_t COUNTER;
 
@@ -0,0 +1,111 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// cpu_features.cpp: Detection of the instruction set extensions supported by the CPU at runtime.
+
+#include "common/cpu_features.h"
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#    define ANGLE_CPU_FEATURES_X86
+#    if defined(_MSC_VER)
+#        include <immintrin.h>
+#        include <intrin.h>
+#    endif
+#endif
+
+namespace angle
+{
+namespace
+{
+#if defined(ANGLE_CPU_FEATURES_X86)
+struct CPUFeatures
+{
+    bool popcnt = false;
+    bool ssse3  = false;
+    bool sse41  = false;
+    bool avx2   = false;
+};
+
+CPUFeatures DetectCPUFeatures()
+{
+    CPUFeatures features;
+
+#    if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    if (maxLeaf < 1)
+    {
+        return features;
+    }
+
+    __cpuid(info, 1);
+    features.ssse3  = (info[2] & (1 << 9)) != 0;
+    features.sse41  = (info[2] & (1 << 19)) != 0;
+    features.popcnt = (info[2] & (1 << 23)) != 0;
+
+    // Make sure the OS saves the YMM registers before checking for AVX2.
+    constexpr int kOSXSAVEAndAVX = (1 << 27) | (1 << 28);
+    if (maxLeaf >= 7 && (info[2] & kOSXSAVEAndAVX) == kOSXSAVEAndAVX &&
+        (_xgetbv(0) & 0x6) == 0x6)
+    {
+        __cpuidex(info, 7, 0);
+        features.avx2 = (info[1] & (1 << 5)) != 0;
+    }
+#    else
+    features.popcnt = __builtin_cpu_supports("popcnt");
+    features.ssse3  = __builtin_cpu_supports("ssse3");
+    features.sse41  = __builtin_cpu_supports("sse4.1");
+    features.avx2   = __builtin_cpu_supports("avx2");
+#    endif
+
+    return features;
+}
+
+const CPUFeatures &GetCPUFeatures()
+{
+    static const CPUFeatures kFeatures = DetectCPUFeatures();
+    return kFeatures;
+}
+#endif  // defined(ANGLE_CPU_FEATURES_X86)
+}  // anonymous namespace
+
+bool SupportsPOPCNT()
+{
+#if defined(ANGLE_CPU_FEATURES_X86)
+    return GetCPUFeatures().popcnt;
+#else
+    return false;
+#endif
+}
+
+bool SupportsSSSE3()
+{
+#if defined(ANGLE_CPU_FEATURES_X86)
+    return GetCPUFeatures().ssse3;
+#else
+    return false;
+#endif
+}
+
+bool SupportsSSE41()
+{
+#if defined(ANGLE_CPU_FEATURES_X86)
+    return GetCPUFeatures().sse41;
+#else
+    return false;
+#endif
+}
+
+bool SupportsAVX2()
+{
+#if defined(ANGLE_CPU_FEATURES_X86)
+    return GetCPUFeatures().avx2;
+#else
+    return false;
+#endif
+}
+}  // namespace angle
@@ -0,0 +1,24 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// cpu_features.h: Detection of the instruction set extensions supported by the CPU at runtime.
+
+#ifndef COMMON_CPU_FEATURES_H_
+#define COMMON_CPU_FEATURES_H_
+
+namespace angle
+{
+
+// Whether the CPU supports the given x86 extension, and, for AVX2, whether the OS saves the YMM
+// registers.  The CPU is only queried once.  Always false on other architectures.
+bool SupportsPOPCNT();
+bool SupportsSSSE3();
+bool SupportsSSE41();
+bool SupportsAVX2();
+
+}  // namespace angle
+
+#endif  // COMMON_CPU_FEATURES_H_
@@ -35,6 +35,13 @@ size_t ComputeGenericHash(const T &key)
     return ComputeGenericHash(&key, sizeof(key));
 }
 
+// Computes a 64-bit checksum of data of any size.  Unlike ComputeGenericHash, the result doesn't
+// depend on the CPU, so it can be stored alongside data that is shared between processes.
+inline uint64_t ComputeChecksum64(const void *data, size_t size, uint64_t seed = 0)
+{
+    return XXH64(data, size, seed);
+}
+
 inline void HashCombine(size_t &seed) {}
 
 template <typename T, typename... Rest>
@@ -19,6 +19,7 @@
 
 #include <anglebase/numerics/safe_math.h>
 
+#include "common/cpu_features.h"
 #include "common/debug.h"
 #include "common/platform.h"
 
@@ -1127,11 +1128,7 @@ namespace priv
 {
 // Check POPCNT instruction support and cache the result.
 // https://docs.microsoft.com/en-us/cpp/intrinsics/popcnt16-popcnt-popcnt64#remarks
-static const bool kHasPopcnt = [] {
-    int info[4];
-    __cpuid(&info[0], 1);
-    return static_cast<bool>(info[2] & 0x800000);
-}();
+static const bool kHasPopcnt = angle::SupportsPOPCNT();
 }  // namespace priv
 
 // Polyfills for x86/x64 CPUs without POPCNT.
@@ -8,12 +8,29 @@
 
 #include "common/utilities.h"
 #include "GLES3/gl3.h"
+#include "common/cpu_features.h"
 #include "common/mathutil.h"
 #include "common/platform.h"
 #include "common/string_utils.h"
 
+#include <cstring>
 #include <set>
 
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define ANGLE_INDEX_RANGE_USE_SSE2
+#    define ANGLE_INDEX_RANGE_USE_AVX2
+#    include <immintrin.h>
+#    if defined(__clang__) || defined(__GNUC__)
+#        define ANGLE_AVX2_TARGET __attribute__((target("avx2")))
+#    else
+#        define ANGLE_AVX2_TARGET
+#    endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#    define ANGLE_INDEX_RANGE_USE_NEON
+#    include <arm_neon.h>
+#endif
+
 #if defined(ANGLE_ENABLE_WINDOWS_UWP)
 #    include <windows.applicationmodel.core.h>
 #    include <windows.graphics.display.h>
@@ -24,15 +41,344 @@
 namespace
 {
 
+// Reduces the lanes of the vectors holding partial results into the running min and max.
+template <class IndexType, class VectorType>
+void ReduceIndexMinMax(const VectorType &minValues,
+                       const VectorType &maxValues,
+                       IndexType *minInOut,
+                       IndexType *maxInOut)
+{
+    constexpr size_t kLanes = sizeof(VectorType) / sizeof(IndexType);
+    IndexType minLanes[kLanes];
+    IndexType maxLanes[kLanes];
+    memcpy(minLanes, &minValues, sizeof(VectorType));
+    memcpy(maxLanes, &maxValues, sizeof(VectorType));
+    for (size_t lane = 0; lane < kLanes; ++lane)
+    {
+        *minInOut = std::min(*minInOut, minLanes[lane]);
+        *maxInOut = std::max(*maxInOut, maxLanes[lane]);
+    }
+}
+
+// The vector kernels below process the largest multiple of the vector width and return the number
+// of indices processed.  The primitive restart index is the largest representable value, so it
+// never affects the minimum; it only has to be cleared before taking the maximum.  If all indices
+// are restart indices, the minimum is left as the restart index, just like the scalar loop does.
+#if defined(ANGLE_INDEX_RANGE_USE_SSE2)
 template <class IndexType>
-gl::IndexRange ComputeTypedIndexRange(const IndexType *indices,
-                                      size_t count,
-                                      bool primitiveRestartEnabled)
+__m128i MinSSE2(__m128i a, __m128i b)
+{
+    if constexpr (sizeof(IndexType) == 1)
+    {
+        return _mm_min_epu8(a, b);
+    }
+    else if constexpr (sizeof(IndexType) == 2)
+    {
+        // SSE2 has no unsigned 16-bit min: a - max(a - b, 0).
+        return _mm_sub_epi16(a, _mm_subs_epu16(a, b));
+    }
+    else
+    {
+        // Nor any unsigned 32-bit compare: flip the sign bits to use the signed one.
+        const __m128i signBits = _mm_set1_epi32(static_cast<int>(0x80000000u));
+        const __m128i aGreater =
+            _mm_cmpgt_epi32(_mm_xor_si128(a, signBits), _mm_xor_si128(b, signBits));
+        return _mm_or_si128(_mm_and_si128(aGreater, b), _mm_andnot_si128(aGreater, a));
+    }
+}
+
+template <class IndexType>
+__m128i MaxSSE2(__m128i a, __m128i b)
+{
+    if constexpr (sizeof(IndexType) == 1)
+    {
+        return _mm_max_epu8(a, b);
+    }
+    else if constexpr (sizeof(IndexType) == 2)
+    {
+        // b + max(a - b, 0).
+        return _mm_add_epi16(b, _mm_subs_epu16(a, b));
+    }
+    else
+    {
+        const __m128i signBits = _mm_set1_epi32(static_cast<int>(0x80000000u));
+        const __m128i aGreater =
+            _mm_cmpgt_epi32(_mm_xor_si128(a, signBits), _mm_xor_si128(b, signBits));
+        return _mm_or_si128(_mm_and_si128(aGreater, a), _mm_andnot_si128(aGreater, b));
+    }
+}
+
+template <class IndexType>
+__m128i CmpEqSSE2(__m128i a, __m128i b)
+{
+    if constexpr (sizeof(IndexType) == 1)
+    {
+        return _mm_cmpeq_epi8(a, b);
+    }
+    else if constexpr (sizeof(IndexType) == 2)
+    {
+        return _mm_cmpeq_epi16(a, b);
+    }
+    else
+    {
+        return _mm_cmpeq_epi32(a, b);
+    }
+}
+
+template <class IndexType, bool kPrimitiveRestartEnabled>
+size_t ComputeIndexMinMaxSSE2(const IndexType *indices,
+                              size_t count,
+                              IndexType *minInOut,
+                              IndexType *maxInOut)
+{
+    constexpr size_t kLanes = sizeof(__m128i) / sizeof(IndexType);
+    const size_t vectorCount = count - count % kLanes;
+    if (vectorCount == 0)
+    {
+        return 0;
+    }
+
+    const __m128i restartIndices = _mm_set1_epi32(-1);
+    __m128i minValues            = restartIndices;
+    __m128i maxValues            = _mm_setzero_si128();
+    for (size_t i = 0; i < vectorCount; i += kLanes)
+    {
+        __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(indices + i));
+        minValues      = MinSSE2<IndexType>(minValues, values);
+        if constexpr (kPrimitiveRestartEnabled)
+        {
+            values = _mm_andnot_si128(CmpEqSSE2<IndexType>(values, restartIndices), values);
+        }
+        maxValues = MaxSSE2<IndexType>(maxValues, values);
+    }
+
+    ReduceIndexMinMax(minValues, maxValues, minInOut, maxInOut);
+    return vectorCount;
+}
+#endif  // defined(ANGLE_INDEX_RANGE_USE_SSE2)
+
+#if defined(ANGLE_INDEX_RANGE_USE_AVX2)
+template <class IndexType>
+ANGLE_AVX2_TARGET __m256i MinAVX2(__m256i a, __m256i b)
+{
+    if constexpr (sizeof(IndexType) == 1)
+    {
+        return _mm256_min_epu8(a, b);
+    }
+    else if constexpr (sizeof(IndexType) == 2)
+    {
+        return _mm256_min_epu16(a, b);
+    }
+    else
+    {
+        return _mm256_min_epu32(a, b);
+    }
+}
+
+template <class IndexType>
+ANGLE_AVX2_TARGET __m256i MaxAVX2(__m256i a, __m256i b)
+{
+    if constexpr (sizeof(IndexType) == 1)
+    {
+        return _mm256_max_epu8(a, b);
+    }
+    else if constexpr (sizeof(IndexType) == 2)
+    {
+        return _mm256_max_epu16(a, b);
+    }
+    else
+    {
+        return _mm256_max_epu32(a, b);
+    }
+}
+
+template <class IndexType>
+ANGLE_AVX2_TARGET __m256i CmpEqAVX2(__m256i a, __m256i b)
+{
+    if constexpr (sizeof(IndexType) == 1)
+    {
+        return _mm256_cmpeq_epi8(a, b);
+    }
+    else if constexpr (sizeof(IndexType) == 2)
+    {
+        return _mm256_cmpeq_epi16(a, b);
+    }
+    else
+    {
+        return _mm256_cmpeq_epi32(a, b);
+    }
+}
+
+template <class IndexType, bool kPrimitiveRestartEnabled>
+ANGLE_AVX2_TARGET size_t ComputeIndexMinMaxAVX2(const IndexType *indices,
+                                                size_t count,
+                                                IndexType *minInOut,
+                                                IndexType *maxInOut)
+{
+    constexpr size_t kLanes = sizeof(__m256i) / sizeof(IndexType);
+    const size_t vectorCount = count - count % kLanes;
+    if (vectorCount == 0)
+    {
+        return 0;
+    }
+
+    const __m256i restartIndices = _mm256_set1_epi32(-1);
+    __m256i minValues            = restartIndices;
+    __m256i maxValues            = _mm256_setzero_si256();
+    for (size_t i = 0; i < vectorCount; i += kLanes)
+    {
+        __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(indices + i));
+        minValues      = MinAVX2<IndexType>(minValues, values);
+        if constexpr (kPrimitiveRestartEnabled)
+        {
+            values = _mm256_andnot_si256(CmpEqAVX2<IndexType>(values, restartIndices), values);
+        }
+        maxValues = MaxAVX2<IndexType>(maxValues, values);
+    }
+
+    ReduceIndexMinMax(minValues, maxValues, minInOut, maxInOut);
+    return vectorCount;
+}
+#endif  // defined(ANGLE_INDEX_RANGE_USE_AVX2)
+
+#if defined(ANGLE_INDEX_RANGE_USE_NEON)
+// Overloads to write the NEON kernel once for all index types.
+inline uint8x16_t LoadNEON(const uint8_t *indices)
+{
+    return vld1q_u8(indices);
+}
+inline uint16x8_t LoadNEON(const uint16_t *indices)
+{
+    return vld1q_u16(indices);
+}
+inline uint32x4_t LoadNEON(const uint32_t *indices)
+{
+    return vld1q_u32(indices);
+}
+inline uint8x16_t DupNEON(uint8_t value)
+{
+    return vdupq_n_u8(value);
+}
+inline uint16x8_t DupNEON(uint16_t value)
+{
+    return vdupq_n_u16(value);
+}
+inline uint32x4_t DupNEON(uint32_t value)
+{
+    return vdupq_n_u32(value);
+}
+inline uint8x16_t MinNEON(uint8x16_t a, uint8x16_t b)
+{
+    return vminq_u8(a, b);
+}
+inline uint16x8_t MinNEON(uint16x8_t a, uint16x8_t b)
+{
+    return vminq_u16(a, b);
+}
+inline uint32x4_t MinNEON(uint32x4_t a, uint32x4_t b)
+{
+    return vminq_u32(a, b);
+}
+inline uint8x16_t MaxNEON(uint8x16_t a, uint8x16_t b)
+{
+    return vmaxq_u8(a, b);
+}
+inline uint16x8_t MaxNEON(uint16x8_t a, uint16x8_t b)
+{
+    return vmaxq_u16(a, b);
+}
+inline uint32x4_t MaxNEON(uint32x4_t a, uint32x4_t b)
+{
+    return vmaxq_u32(a, b);
+}
+// Clears the lanes of |a| that are equal to |b|.
+inline uint8x16_t ClearEqualNEON(uint8x16_t a, uint8x16_t b)
+{
+    return vbicq_u8(a, vceqq_u8(a, b));
+}
+inline uint16x8_t ClearEqualNEON(uint16x8_t a, uint16x8_t b)
+{
+    return vbicq_u16(a, vceqq_u16(a, b));
+}
+inline uint32x4_t ClearEqualNEON(uint32x4_t a, uint32x4_t b)
+{
+    return vbicq_u32(a, vceqq_u32(a, b));
+}
+
+template <class IndexType, bool kPrimitiveRestartEnabled>
+size_t ComputeIndexMinMaxNEON(const IndexType *indices,
+                              size_t count,
+                              IndexType *minInOut,
+                              IndexType *maxInOut)
+{
+    using VectorType         = decltype(LoadNEON(indices));
+    constexpr size_t kLanes  = sizeof(VectorType) / sizeof(IndexType);
+    const size_t vectorCount = count - count % kLanes;
+    if (vectorCount == 0)
+    {
+        return 0;
+    }
+
+    const VectorType restartIndices = DupNEON(std::numeric_limits<IndexType>::max());
+    VectorType minValues            = restartIndices;
+    VectorType maxValues            = DupNEON(static_cast<IndexType>(0));
+    for (size_t i = 0; i < vectorCount; i += kLanes)
+    {
+        VectorType values = LoadNEON(indices + i);
+        minValues         = MinNEON(minValues, values);
+        if constexpr (kPrimitiveRestartEnabled)
+        {
+            values = ClearEqualNEON(values, restartIndices);
+        }
+        maxValues = MaxNEON(maxValues, values);
+    }
+
+    ReduceIndexMinMax(minValues, maxValues, minInOut, maxInOut);
+    return vectorCount;
+}
+#endif  // defined(ANGLE_INDEX_RANGE_USE_NEON)
+
+// Returns the number of indices processed with vector instructions, which start the range.
+template <class IndexType>
+size_t ComputeTypedIndexMinMaxVectorized(const IndexType *indices,
+                                         size_t count,
+                                         bool primitiveRestartEnabled,
+                                         IndexType *minInOut,
+                                         IndexType *maxInOut)
+{
+#if defined(ANGLE_INDEX_RANGE_USE_AVX2)
+    if (angle::SupportsAVX2())
+    {
+        return primitiveRestartEnabled
+                   ? ComputeIndexMinMaxAVX2<IndexType, true>(indices, count, minInOut, maxInOut)
+                   : ComputeIndexMinMaxAVX2<IndexType, false>(indices, count, minInOut, maxInOut);
+    }
+#endif  // defined(ANGLE_INDEX_RANGE_USE_AVX2)
+
+#if defined(ANGLE_INDEX_RANGE_USE_SSE2)
+    return primitiveRestartEnabled
+               ? ComputeIndexMinMaxSSE2<IndexType, true>(indices, count, minInOut, maxInOut)
+               : ComputeIndexMinMaxSSE2<IndexType, false>(indices, count, minInOut, maxInOut);
+#elif defined(ANGLE_INDEX_RANGE_USE_NEON)
+    return primitiveRestartEnabled
+               ? ComputeIndexMinMaxNEON<IndexType, true>(indices, count, minInOut, maxInOut)
+               : ComputeIndexMinMaxNEON<IndexType, false>(indices, count, minInOut, maxInOut);
+#else
+    return 0;
+#endif
+}
+
+// The reference implementation, used for the indices not handled by the vector kernels.
+template <class IndexType>
+void ComputeTypedIndexMinMax(const IndexType *indices,
+                             size_t count,
+                             bool primitiveRestartEnabled,
+                             IndexType *minInOut,
+                             IndexType *maxInOut)
 {
     constexpr IndexType primitiveRestartIndex = std::numeric_limits<IndexType>::max();
-    IndexType minIndex                        = primitiveRestartIndex;
-    IndexType maxIndex                        = 0;
-    bool hasVertices                          = false;
+    IndexType minIndex                        = *minInOut;
+    IndexType maxIndex                        = *maxInOut;
 
     if (primitiveRestartEnabled)
     {
@@ -43,9 +389,8 @@ gl::IndexRange ComputeTypedIndexRange(const IndexType *indices,
             {
                 continue;
             }
-            hasVertices = true;
-            minIndex    = std::min(minIndex, index);
-            maxIndex    = std::max(maxIndex, index);
+            minIndex = std::min(minIndex, index);
+            maxIndex = std::max(maxIndex, index);
         }
     }
     else
@@ -56,8 +401,30 @@ gl::IndexRange ComputeTypedIndexRange(const IndexType *indices,
             minIndex        = std::min(minIndex, index);
             maxIndex        = std::max(maxIndex, index);
         }
-        hasVertices = count > 0;
     }
+
+    *minInOut = minIndex;
+    *maxInOut = maxIndex;
+}
+
+template <class IndexType>
+gl::IndexRange ComputeTypedIndexRange(const IndexType *indices,
+                                      size_t count,
+                                      bool primitiveRestartEnabled)
+{
+    constexpr IndexType primitiveRestartIndex = std::numeric_limits<IndexType>::max();
+    IndexType minIndex                        = primitiveRestartIndex;
+    IndexType maxIndex                        = 0;
+
+    const size_t vectorCount = ComputeTypedIndexMinMaxVectorized(
+        indices, count, primitiveRestartEnabled, &minIndex, &maxIndex);
+    ComputeTypedIndexMinMax(indices + vectorCount, count - vectorCount, primitiveRestartEnabled,
+                            &minIndex, &maxIndex);
+
+    // Every index other than the restart index is smaller than it, so the range is only empty if
+    // the minimum was never lowered.
+    const bool hasVertices =
+        primitiveRestartEnabled ? minIndex != primitiveRestartIndex : count > 0;
     if (!hasVertices)
     {
         return gl::IndexRange();
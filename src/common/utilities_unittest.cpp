@@ -254,4 +254,75 @@ TEST(Utilities, IndexRanges)
     EXPECT_EQ(ComputeIndexRange(b, vertices2, 3, false), gl::IndexRange(2, 255));
 }
 
+template <typename IndexType>
+gl::IndexRange ComputeReferenceIndexRange(const IndexType *indices,
+                                          size_t count,
+                                          bool primitiveRestartEnabled)
+{
+    constexpr IndexType kRestartIndex = std::numeric_limits<IndexType>::max();
+    bool hasVertices                  = false;
+    IndexType minIndex                = kRestartIndex;
+    IndexType maxIndex                = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (primitiveRestartEnabled && indices[i] == kRestartIndex)
+        {
+            continue;
+        }
+        hasVertices = true;
+        minIndex    = std::min(minIndex, indices[i]);
+        maxIndex    = std::max(maxIndex, indices[i]);
+    }
+    return hasVertices ? gl::IndexRange(minIndex, maxIndex) : gl::IndexRange();
+}
+
+template <typename IndexType>
+void TestLongIndexRanges(gl::DrawElementsType type)
+{
+    constexpr IndexType kRestartIndex = std::numeric_limits<IndexType>::max();
+
+    // Mix in restart indices, and values close to the maximum to catch signed comparisons.
+    std::vector<IndexType> indices(200);
+    uint32_t seed = 1;
+    for (IndexType &index : indices)
+    {
+        seed  = seed * 1103515245 + 12345;
+        index = (seed >> 16) % 8 == 0
+                    ? kRestartIndex
+                    : static_cast<IndexType>(kRestartIndex / 4 + (seed >> 8) % (kRestartIndex / 2));
+    }
+    indices[37]  = kRestartIndex - 1;
+    indices[150] = 1;
+
+    // Cover unaligned starts and every tail length handled by the scalar loop.
+    for (size_t offset : {0, 1, 3, 7})
+    {
+        for (size_t count = 0; count + offset <= indices.size(); ++count)
+        {
+            for (bool primitiveRestartEnabled : {false, true})
+            {
+                const IndexType *data = indices.data() + offset;
+                EXPECT_EQ(ComputeIndexRange(type, data, count, primitiveRestartEnabled),
+                          ComputeReferenceIndexRange(data, count, primitiveRestartEnabled))
+                    << "offset " << offset << " count " << count;
+            }
+        }
+    }
+
+    // A range made only of restart indices is empty.
+    std::vector<IndexType> restartIndices(100, kRestartIndex);
+    EXPECT_EQ(ComputeIndexRange(type, restartIndices.data(), restartIndices.size(), true),
+              gl::IndexRange());
+    EXPECT_EQ(ComputeIndexRange(type, restartIndices.data(), restartIndices.size(), false),
+              gl::IndexRange(kRestartIndex, kRestartIndex));
+}
+
+// Tests gl::ComputeIndexRange() with ranges long enough to use vector instructions.
+TEST(Utilities, LongIndexRanges)
+{
+    TestLongIndexRanges<uint8_t>(gl::DrawElementsType::UnsignedByte);
+    TestLongIndexRanges<uint16_t>(gl::DrawElementsType::UnsignedShort);
+    TestLongIndexRanges<uint32_t>(gl::DrawElementsType::UnsignedInt);
+}
+
 }  // anonymous namespace
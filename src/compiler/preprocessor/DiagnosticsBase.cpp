@@ -16,9 +16,9 @@ namespace pp
 
 Diagnostics::~Diagnostics() {}
 
-void Diagnostics::report(ID id, const SourceLocation &loc, const std::string &text)
+void Diagnostics::report(ID id, const SourceLocation &loc, std::string_view text)
 {
-    print(id, loc, text);
+    print(id, loc, std::string(text));
 }
 
 bool Diagnostics::isError(ID id)
@@ -8,6 +8,7 @@
 #define COMPILER_PREPROCESSOR_DIAGNOSTICSBASE_H_
 
 #include <string>
+#include <string_view>
 
 namespace angle
 {
@@ -86,7 +87,7 @@ class Diagnostics
 
     virtual ~Diagnostics();
 
-    void report(ID id, const SourceLocation &loc, const std::string &text);
+    void report(ID id, const SourceLocation &loc, std::string_view text);
 
   protected:
     bool isError(ID id);
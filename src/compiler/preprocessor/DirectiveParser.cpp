@@ -121,18 +121,18 @@ void skipUntilEOD(pp::Lexer *lexer, pp::Token *token)
     }
 }
 
-bool isMacroNameReserved(const std::string &name)
+bool isMacroNameReserved(std::string_view name)
 {
     // Names prefixed with "GL_" and the name "defined" are reserved.
     return name == "defined" || (name.substr(0, 3) == "GL_");
 }
 
-bool hasDoubleUnderscores(const std::string &name)
+bool hasDoubleUnderscores(std::string_view name)
 {
-    return (name.find("__") != std::string::npos);
+    return (name.find("__") != std::string_view::npos);
 }
 
-bool isMacroPredefined(const std::string &name, const pp::MacroSet &macroSet)
+bool isMacroPredefined(std::string_view name, const pp::MacroSet &macroSet)
 {
     pp::MacroSet::const_iterator iter = macroSet.find(name);
     return iter != macroSet.end() ? iter->second->predefined : false;
@@ -144,6 +144,7 @@ namespace pp
 {
 DirectiveParser::DirectiveParser(Tokenizer *tokenizer,
                                  MacroSet *macroSet,
+                                 InternTable *internTable,
                                  Diagnostics *diagnostics,
                                  DirectiveHandler *directiveHandler,
                                  const PreprocessorSettings &settings)
@@ -152,6 +153,7 @@ DirectiveParser::DirectiveParser(Tokenizer *tokenizer,
       mSeenNonPreprocessorToken(false),
       mTokenizer(tokenizer),
       mMacroSet(macroSet),
+      mInternTable(internTable),
       mDiagnostics(diagnostics),
       mDirectiveHandler(directiveHandler),
       mShaderVersion(100),
@@ -339,7 +341,7 @@ void DirectiveParser::parseDefine(Token *token)
                 return;
             }
 
-            macro->parameters.push_back(token->text);
+            macro->parameters.emplace_back(token->text);
 
             mTokenizer->lex(token);  // Get ','.
         } while (token->type == ',');
@@ -812,7 +814,8 @@ void DirectiveParser::parseLine(Token *token)
     bool parsedFileNumber = false;
     int line = 0, file = 0;
 
-    MacroExpander macroExpander(mTokenizer, mMacroSet, mDiagnostics, mSettings, false);
+    MacroExpander macroExpander(mTokenizer, mMacroSet, mInternTable, mDiagnostics, mSettings,
+                                false);
 
     // Lex the first token after "#line" so we can check it for EOD.
     macroExpander.lex(token);
@@ -920,7 +923,8 @@ int DirectiveParser::parseExpressionIf(Token *token)
 {
     ASSERT((getDirective(token) == DIRECTIVE_IF) || (getDirective(token) == DIRECTIVE_ELIF));
 
-    MacroExpander macroExpander(mTokenizer, mMacroSet, mDiagnostics, mSettings, true);
+    MacroExpander macroExpander(mTokenizer, mMacroSet, mInternTable, mDiagnostics, mSettings,
+                                true);
     ExpressionParser expressionParser(&macroExpander, mDiagnostics);
 
     int expression = 0;
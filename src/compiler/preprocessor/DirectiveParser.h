@@ -20,6 +20,7 @@ namespace pp
 
 class Diagnostics;
 class DirectiveHandler;
+class InternTable;
 class Tokenizer;
 
 class DirectiveParser : public Lexer
@@ -27,6 +28,7 @@ class DirectiveParser : public Lexer
   public:
     DirectiveParser(Tokenizer *tokenizer,
                     MacroSet *macroSet,
+                    InternTable *internTable,
                     Diagnostics *diagnostics,
                     DirectiveHandler *directiveHandler,
                     const PreprocessorSettings &settings);
@@ -77,6 +79,7 @@ class DirectiveParser : public Lexer
     std::vector<ConditionalBlock> mConditionalStack;
     Tokenizer *mTokenizer;
     MacroSet *mMacroSet;
+    InternTable *mInternTable;
     Diagnostics *mDiagnostics;
     DirectiveHandler *mDirectiveHandler;
     int mShaderVersion;
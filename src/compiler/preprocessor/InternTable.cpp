@@ -0,0 +1,169 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "compiler/preprocessor/InternTable.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+namespace angle
+{
+
+namespace pp
+{
+
+namespace
+{
+constexpr size_t kBlockSize         = 4096;
+constexpr size_t kInitialEntryCount = 256;
+constexpr uint64_t kHashSeed        = 0x9E3779B97F4A7C15ull;
+constexpr uint64_t kHashMultiplier  = 0xFF51AFD7ED558CCDull;
+
+// Single character tokens, such as operators and newlines, are the most common ones.  They are
+// served from this table without a lookup.
+struct SingleCharacterStrings
+{
+    constexpr SingleCharacterStrings() : characters()
+    {
+        for (size_t index = 0; index < 256; ++index)
+        {
+            characters[index] = static_cast<char>(index);
+        }
+    }
+
+    char characters[256];
+};
+
+constexpr SingleCharacterStrings kSingleCharacterStrings;
+
+// Identifiers are short, so they are hashed a word at a time with a multiplicative hash.
+uint32_t HashText(std::string_view text)
+{
+    const char *data = text.data();
+    size_t size      = text.size();
+
+    uint64_t hash = kHashSeed ^ size;
+    while (size > 0)
+    {
+        uint64_t word       = 0;
+        const size_t length = std::min<size_t>(size, sizeof(word));
+        memcpy(&word, data, length);
+
+        hash = (hash ^ word) * kHashMultiplier;
+        hash ^= hash >> 29;
+
+        data += length;
+        size -= length;
+    }
+    return static_cast<uint32_t>(hash);
+}
+}  // anonymous namespace
+
+InternTable::InternTable()
+    : mEntries(kInitialEntryCount, Entry{nullptr, 0, 0}),
+      mEntryCount(0),
+      mBlockCurrent(nullptr),
+      mBlockRemaining(0)
+{}
+
+InternTable::~InternTable() = default;
+
+std::string_view InternTable::intern(std::string_view text)
+{
+    if (text.size() <= 1)
+    {
+        return store(text);
+    }
+
+    const uint32_t hash = HashText(text);
+    const size_t mask   = mEntries.size() - 1;
+    for (size_t index = hash & mask;; index = (index + 1) & mask)
+    {
+        Entry &entry = mEntries[index];
+        if (entry.data == nullptr)
+        {
+            const std::string_view interned = store(text);
+            entry = Entry{interned.data(), static_cast<uint32_t>(interned.size()), hash};
+
+            // Keep the table at most half full, so lookups rarely probe more than a couple of
+            // entries.
+            if (++mEntryCount * 2 > mEntries.size())
+            {
+                grow();
+            }
+            return interned;
+        }
+        if (entry.hash == hash && entry.size == text.size() &&
+            memcmp(entry.data, text.data(), text.size()) == 0)
+        {
+            return std::string_view(entry.data, entry.size);
+        }
+    }
+}
+
+std::string_view InternTable::store(std::string_view text)
+{
+    if (text.empty())
+    {
+        return std::string_view();
+    }
+    if (text.size() == 1)
+    {
+        const uint8_t character = static_cast<uint8_t>(text[0]);
+        return std::string_view(&kSingleCharacterStrings.characters[character], 1);
+    }
+
+    char *storage = allocate(text.size());
+    memcpy(storage, text.data(), text.size());
+    return std::string_view(storage, text.size());
+}
+
+char *InternTable::allocate(size_t size)
+{
+    // Large strings get a block of their own, so they don't waste the rest of the current block.
+    if (size > kBlockSize / 4)
+    {
+        mBlocks.emplace_back(new char[size]);
+        return mBlocks.back().get();
+    }
+
+    if (size > mBlockRemaining)
+    {
+        mBlocks.emplace_back(new char[kBlockSize]);
+        mBlockCurrent   = mBlocks.back().get();
+        mBlockRemaining = kBlockSize;
+    }
+
+    char *storage = mBlockCurrent;
+    mBlockCurrent += size;
+    mBlockRemaining -= size;
+    return storage;
+}
+
+void InternTable::grow()
+{
+    std::vector<Entry> entries(mEntries.size() * 2, Entry{nullptr, 0, 0});
+    const size_t mask = entries.size() - 1;
+    for (const Entry &entry : mEntries)
+    {
+        if (entry.data == nullptr)
+        {
+            continue;
+        }
+        size_t index = entry.hash & mask;
+        while (entries[index].data != nullptr)
+        {
+            index = (index + 1) & mask;
+        }
+        entries[index] = entry;
+    }
+    mEntries = std::move(entries);
+}
+
+}  // namespace pp
+
+}  // namespace angle
@@ -0,0 +1,65 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#ifndef COMPILER_PREPROCESSOR_INTERNTABLE_H_
+#define COMPILER_PREPROCESSOR_INTERNTABLE_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "common/angleutils.h"
+
+namespace angle
+{
+
+namespace pp
+{
+
+// Storage for the text of the tokens of a shader.  Tokens refer to it with a std::string_view, so
+// they can be copied around during macro expansion without allocating.  The strings live as long
+// as the table.
+class InternTable : angle::NonCopyable
+{
+  public:
+    InternTable();
+    ~InternTable();
+
+    // Returns a view of a copy of |text|.  Interning equal strings returns the same view, so
+    // identifiers are only stored once however many times they are used.
+    std::string_view intern(std::string_view text);
+
+    // Returns a view of a copy of |text|, without looking for an equal string.  This is cheaper
+    // for text that rarely repeats, such as numbers.
+    std::string_view store(std::string_view text);
+
+  private:
+    struct Entry
+    {
+        const char *data;
+        uint32_t size;
+        uint32_t hash;
+    };
+
+    char *allocate(size_t size);
+    void grow();
+
+    // Open addressing hash table of the interned strings.
+    std::vector<Entry> mEntries;
+    size_t mEntryCount;
+
+    std::vector<std::unique_ptr<char[]>> mBlocks;
+    char *mBlockCurrent;
+    size_t mBlockRemaining;
+};
+
+}  // namespace pp
+
+}  // namespace angle
+
+#endif  // COMPILER_PREPROCESSOR_INTERNTABLE_H_
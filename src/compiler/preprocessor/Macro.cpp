@@ -27,14 +27,15 @@ bool Macro::equals(const Macro &other) const
 
 void PredefineMacro(MacroSet *macroSet, const char *name, int value)
 {
-    Token token;
-    token.type = Token::CONST_INT;
-    token.text = ToString(value);
-
     std::shared_ptr<Macro> macro = std::make_shared<Macro>();
     macro->predefined            = true;
     macro->type                  = Macro::kTypeObj;
     macro->name                  = name;
+    macro->predefinedValue       = ToString(value);
+
+    Token token;
+    token.type = Token::CONST_INT;
+    token.text = macro->predefinedValue;
     macro->replacements.push_back(token);
 
     (*macroSet)[name] = macro;
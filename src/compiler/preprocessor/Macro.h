@@ -42,9 +42,14 @@ struct Macro
     std::string name;
     Parameters parameters;
     Replacements replacements;
+
+    // Storage for the text of the replacement of predefined macros, which isn't in the
+    // preprocessor's InternTable.
+    std::string predefinedValue;
 };
 
-typedef std::map<std::string, std::shared_ptr<Macro>> MacroSet;
+// Ordered with std::less<> so macros can be looked up with the text of tokens without copying it.
+typedef std::map<std::string, std::shared_ptr<Macro>, std::less<>> MacroSet;
 
 void PredefineMacro(MacroSet *macroSet, const char *name, int value);
 
@@ -11,6 +11,7 @@
 
 #include "common/debug.h"
 #include "compiler/preprocessor/DiagnosticsBase.h"
+#include "compiler/preprocessor/InternTable.h"
 #include "compiler/preprocessor/Token.h"
 
 namespace angle
@@ -86,11 +87,13 @@ MacroExpander::ScopedMacroReenabler::~ScopedMacroReenabler()
 
 MacroExpander::MacroExpander(Lexer *lexer,
                              MacroSet *macroSet,
+                             InternTable *internTable,
                              Diagnostics *diagnostics,
                              const PreprocessorSettings &settings,
                              bool parseDefined)
     : mLexer(lexer),
       mMacroSet(macroSet),
+      mInternTable(internTable),
       mDiagnostics(diagnostics),
       mParseDefined(parseDefined),
       mTotalTokensInContexts(0),
@@ -142,7 +145,7 @@ void MacroExpander::lex(Token *token)
                 break;
             }
             auto iter              = mMacroSet->find(token->text);
-            std::string expression = iter != mMacroSet->end() ? "1" : "0";
+            const char *expression = iter != mMacroSet->end() ? "1" : "0";
 
             if (paren)
             {
@@ -309,11 +312,11 @@ bool MacroExpander::expandMacro(const Macro &macro,
             Token &repl = replacements->front();
             if (macro.name == kLine)
             {
-                repl.text = ToString(identifier.location.line);
+                repl.text = mInternTable->intern(ToString(identifier.location.line));
             }
             else if (macro.name == kFile)
             {
-                repl.text = ToString(identifier.location.file);
+                repl.text = mInternTable->intern(ToString(identifier.location.file));
             }
         }
     }
@@ -429,6 +432,8 @@ bool MacroExpander::collectMacroArgs(const Macro &macro,
     size_t numTokens = 0;
     for (auto &arg : *args)
     {
+        // The expanded argument is usually at least as long as the argument.
+        const size_t argSize = arg.size();
         TokenLexer lexer(&arg);
         if (mSettings.maxMacroExpansionDepth < 1)
         {
@@ -438,9 +443,11 @@ bool MacroExpander::collectMacroArgs(const Macro &macro,
         }
         PreprocessorSettings nestedSettings(mSettings.shaderSpec);
         nestedSettings.maxMacroExpansionDepth = mSettings.maxMacroExpansionDepth - 1;
-        MacroExpander expander(&lexer, mMacroSet, mDiagnostics, nestedSettings, mParseDefined);
+        MacroExpander expander(&lexer, mMacroSet, mInternTable, mDiagnostics, nestedSettings,
+                               mParseDefined);
 
         arg.clear();
+        arg.reserve(argSize);
         expander.lex(&token);
         while (token.type != Token::LAST)
         {
@@ -461,6 +468,7 @@ void MacroExpander::replaceMacroParams(const Macro &macro,
                                        const std::vector<MacroArg> &args,
                                        std::vector<Token> *replacements)
 {
+    replacements->reserve(macro.replacements.size());
     for (std::size_t i = 0; i < macro.replacements.size(); ++i)
     {
         if (!replacements->empty() &&
@@ -22,6 +22,7 @@ namespace pp
 {
 
 class Diagnostics;
+class InternTable;
 struct SourceLocation;
 
 class MacroExpander : public Lexer
@@ -29,6 +30,7 @@ class MacroExpander : public Lexer
   public:
     MacroExpander(Lexer *lexer,
                   MacroSet *macroSet,
+                  InternTable *internTable,
                   Diagnostics *diagnostics,
                   const PreprocessorSettings &settings,
                   bool parseDefined);
@@ -71,6 +73,7 @@ class MacroExpander : public Lexer
 
     Lexer *mLexer;
     MacroSet *mMacroSet;
+    InternTable *mInternTable;
     Diagnostics *mDiagnostics;
     bool mParseDefined;
 
@@ -9,6 +9,7 @@
 #include "common/debug.h"
 #include "compiler/preprocessor/DiagnosticsBase.h"
 #include "compiler/preprocessor/DirectiveParser.h"
+#include "compiler/preprocessor/InternTable.h"
 #include "compiler/preprocessor/Macro.h"
 #include "compiler/preprocessor/MacroExpander.h"
 #include "compiler/preprocessor/Token.h"
@@ -23,6 +24,7 @@ namespace pp
 struct PreprocessorImpl
 {
     Diagnostics *diagnostics;
+    InternTable internTable;
     MacroSet macroSet;
     Tokenizer tokenizer;
     DirectiveParser directiveParser;
@@ -32,9 +34,9 @@ struct PreprocessorImpl
                      DirectiveHandler *directiveHandler,
                      const PreprocessorSettings &settings)
         : diagnostics(diag),
-          tokenizer(diag),
-          directiveParser(&tokenizer, &macroSet, diag, directiveHandler, settings),
-          macroExpander(&directiveParser, &macroSet, diag, settings, false)
+          tokenizer(diag, &internTable),
+          directiveParser(&tokenizer, &macroSet, &internTable, diag, directiveHandler, settings),
+          macroExpander(&directiveParser, &macroSet, &internTable, diag, settings, false)
     {}
 };
 
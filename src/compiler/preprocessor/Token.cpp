@@ -20,7 +20,7 @@ void Token::reset()
     type     = 0;
     flags    = 0;
     location = SourceLocation();
-    text.clear();
+    text     = std::string_view();
 }
 
 bool Token::equals(const Token &other) const
@@ -56,13 +56,13 @@ void Token::setExpansionDisabled(bool disable)
 bool Token::iValue(int *value) const
 {
     ASSERT(type == CONST_INT);
-    return numeric_lex_int(text, value);
+    return numeric_lex_int(std::string(text), value);
 }
 
 bool Token::uValue(unsigned int *value) const
 {
     ASSERT(type == CONST_INT);
-    return numeric_lex_int(text, value);
+    return numeric_lex_int(std::string(text), value);
 }
 
 std::ostream &operator<<(std::ostream &out, const Token &token)
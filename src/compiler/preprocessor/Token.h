@@ -8,7 +8,7 @@
 #define COMPILER_PREPROCESSOR_TOKEN_H_
 
 #include <ostream>
-#include <string>
+#include <string_view>
 
 #include "compiler/preprocessor/SourceLocation.h"
 
@@ -91,7 +91,9 @@ struct Token
     int type;
     unsigned int flags;
     SourceLocation location;
-    std::string text;
+    // Points to the preprocessor's InternTable or to static storage, so tokens are cheap to copy.
+    // The text lives as long as the preprocessor that produced the token.
+    std::string_view text;
 };
 
 inline bool operator==(const Token &lhs, const Token &rhs)
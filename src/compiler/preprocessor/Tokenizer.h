@@ -18,6 +18,7 @@ namespace pp
 {
 
 class Diagnostics;
+class InternTable;
 
 class Tokenizer : public Lexer
 {
@@ -36,7 +37,7 @@ class Tokenizer : public Lexer
         bool lineStart;
     };
 
-    Tokenizer(Diagnostics *diagnostics);
+    Tokenizer(Diagnostics *diagnostics, InternTable *internTable);
     ~Tokenizer() override;
 
     bool init(size_t count, const char *const string[], const int length[]);
@@ -51,9 +52,10 @@ class Tokenizer : public Lexer
     bool initScanner();
     void destroyScanner();
 
-    void *mHandle;         // Scanner handle.
-    Context mContext;      // Scanner extra.
-    size_t mMaxTokenSize;  // Maximum token size
+    void *mHandle;              // Scanner handle.
+    Context mContext;           // Scanner extra.
+    InternTable *mInternTable;  // Storage for the token text.
+    size_t mMaxTokenSize;       // Maximum token size
 };
 
 }  // namespace pp
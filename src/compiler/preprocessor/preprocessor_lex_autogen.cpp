@@ -691,6 +691,7 @@ IF YOU MODIFY THIS FILE YOU ALSO NEED TO RUN scripts/run_code_generation.py
 #include "compiler/preprocessor/Tokenizer.h"
 
 #include "compiler/preprocessor/DiagnosticsBase.h"
+#include "compiler/preprocessor/InternTable.h"
 #include "compiler/preprocessor/Token.h"
 
 #if defined(__GNUC__)
@@ -719,7 +720,7 @@ IF YOU MODIFY THIS FILE YOU ALSO NEED TO RUN scripts/run_code_generation.py
 #    endif
 #endif
 
-typedef std::string YYSTYPE;
+typedef std::string_view YYSTYPE;
 typedef angle::pp::SourceLocation YYLTYPE;
 
 // Use the unused yycolumn variable to track file (string) number.
@@ -1123,7 +1124,7 @@ YY_DECL
                     YY_RULE_SETUP
                     {
                         // # is only valid at start of line for preprocessor directives.
-                        yylval->assign(1, yytext[0]);
+                        *yylval = std::string_view(yytext, 1);
                         return yyextra->lineStart ? angle::pp::Token::PP_HASH
                                                   : angle::pp::Token::PP_OTHER;
                     }
@@ -1131,21 +1132,21 @@ YY_DECL
                 case 8:
                     YY_RULE_SETUP
                     {
-                        yylval->assign(yytext, yyleng);
+                        *yylval = std::string_view(yytext, yyleng);
                         return angle::pp::Token::IDENTIFIER;
                     }
                     YY_BREAK
                 case 9:
                     YY_RULE_SETUP
                     {
-                        yylval->assign(yytext, yyleng);
+                        *yylval = std::string_view(yytext, yyleng);
                         return angle::pp::Token::CONST_INT;
                     }
                     YY_BREAK
                 case 10:
                     YY_RULE_SETUP
                     {
-                        yylval->assign(yytext, yyleng);
+                        *yylval = std::string_view(yytext, yyleng);
                         return angle::pp::Token::CONST_FLOAT;
                     }
                     YY_BREAK
@@ -1154,161 +1155,161 @@ YY_DECL
                 case 11:
                     YY_RULE_SETUP
                     {
-                        yylval->assign(yytext, yyleng);
+                        *yylval = std::string_view(yytext, yyleng);
                         return angle::pp::Token::PP_NUMBER;
                     }
                     YY_BREAK
                 case 12:
                     YY_RULE_SETUP
                     {
-                        yylval->assign(yytext, yyleng);
+                        *yylval = std::string_view(yytext, yyleng);
                         return angle::pp::Token::OP_INC;
                     }
                     YY_BREAK
                 case 13:
                     YY_RULE_SETUP
                     {
-                        yylval->assign(yytext, yyleng);
+                        *yylval = std::string_view(yytext, yyleng);
                         return angle::pp::Token::OP_DEC;
                     }
                     YY_BREAK
                 case 14:
                     YY_RULE_SETUP
                     {
-                        yylval->assign(yytext, yyleng);
+                        *yylval = std::string_view(yytext, yyleng);
                         return angle::pp::Token::OP_LEFT;
                     }
                     YY_BREAK
                 case 15:
                     YY_RULE_SETUP
                     {
-                        yylval->assign(yytext, yyleng);
+                        *yylval = std::string_view(yytext, yyleng);
                         return angle::pp::Token::OP_RIGHT;
                     }
                     YY_BREAK
                 case 16:
                     YY_RULE_SETUP
                     {
-                        yylval->assign(yytext, yyleng);
+                        *yylval = std::string_view(yytext, yyleng);
                         return angle::pp::Token::OP_LE;
                     }
                     YY_BREAK
                 case 17:
                     YY_RULE_SETUP
                     {
-                        yylval->assign(yytext, yyleng);
+                        *yylval = std::string_view(yytext, yyleng);
                         return angle::pp::Token::OP_GE;
                     }
                     YY_BREAK
                 case 18:
                     YY_RULE_SETUP
                     {
-                        yylval->assign(yytext, yyleng);
+                        *yylval = std::string_view(yytext, yyleng);
                         return angle::pp::Token::OP_EQ;
                     }
                     YY_BREAK
                 case 19:
                     YY_RULE_SETUP
                     {
-                        yylval->assign(yytext, yyleng);
+                        *yylval = std::string_view(yytext, yyleng);
                         return angle::pp::Token::OP_NE;
                     }
                     YY_BREAK
                 case 20:
                     YY_RULE_SETUP
                     {
-                        yylval->assign(yytext, yyleng);
+                        *yylval = std::string_view(yytext, yyleng);
                         return angle::pp::Token::OP_AND;
                     }
                     YY_BREAK
                 case 21:
                     YY_RULE_SETUP
                     {
-                        yylval->assign(yytext, yyleng);
+                        *yylval = std::string_view(yytext, yyleng);
                         return angle::pp::Token::OP_XOR;
                     }
                     YY_BREAK
                 case 22:
                     YY_RULE_SETUP
                     {
-                        yylval->assign(yytext, yyleng);
+                        *yylval = std::string_view(yytext, yyleng);
                         return angle::pp::Token::OP_OR;
                     }
                     YY_BREAK
                 case 23:
                     YY_RULE_SETUP
                     {
-                        yylval->assign(yytext, yyleng);
+                        *yylval = std::string_view(yytext, yyleng);
                         return angle::pp::Token::OP_ADD_ASSIGN;
                     }
                     YY_BREAK
                 case 24:
                     YY_RULE_SETUP
                     {
-                        yylval->assign(yytext, yyleng);
+                        *yylval = std::string_view(yytext, yyleng);
                         return angle::pp::Token::OP_SUB_ASSIGN;
                     }
                     YY_BREAK
                 case 25:
                     YY_RULE_SETUP
                     {
-                        yylval->assign(yytext, yyleng);
+                        *yylval = std::string_view(yytext, yyleng);
                         return angle::pp::Token::OP_MUL_ASSIGN;
                     }
                     YY_BREAK
                 case 26:
                     YY_RULE_SETUP
                     {
-                        yylval->assign(yytext, yyleng);
+                        *yylval = std::string_view(yytext, yyleng);
                         return angle::pp::Token::OP_DIV_ASSIGN;
                     }
                     YY_BREAK
                 case 27:
                     YY_RULE_SETUP
                     {
-                        yylval->assign(yytext, yyleng);
+                        *yylval = std::string_view(yytext, yyleng);
                         return angle::pp::Token::OP_MOD_ASSIGN;
                     }
                     YY_BREAK
                 case 28:
                     YY_RULE_SETUP
                     {
-                        yylval->assign(yytext, yyleng);
+                        *yylval = std::string_view(yytext, yyleng);
                         return angle::pp::Token::OP_LEFT_ASSIGN;
                     }
                     YY_BREAK
                 case 29:
                     YY_RULE_SETUP
                     {
-                        yylval->assign(yytext, yyleng);
+                        *yylval = std::string_view(yytext, yyleng);
                         return angle::pp::Token::OP_RIGHT_ASSIGN;
                     }
                     YY_BREAK
                 case 30:
                     YY_RULE_SETUP
                     {
-                        yylval->assign(yytext, yyleng);
+                        *yylval = std::string_view(yytext, yyleng);
                         return angle::pp::Token::OP_AND_ASSIGN;
                     }
                     YY_BREAK
                 case 31:
                     YY_RULE_SETUP
                     {
-                        yylval->assign(yytext, yyleng);
+                        *yylval = std::string_view(yytext, yyleng);
                         return angle::pp::Token::OP_XOR_ASSIGN;
                     }
                     YY_BREAK
                 case 32:
                     YY_RULE_SETUP
                     {
-                        yylval->assign(yytext, yyleng);
+                        *yylval = std::string_view(yytext, yyleng);
                         return angle::pp::Token::OP_OR_ASSIGN;
                     }
                     YY_BREAK
                 case 33:
                     YY_RULE_SETUP
                     {
-                        yylval->assign(1, yytext[0]);
+                        *yylval = std::string_view(yytext, 1);
                         return yytext[0];
                     }
                     YY_BREAK
@@ -1328,14 +1329,14 @@ YY_DECL
                             return angle::pp::Token::GOT_ERROR;
                         }
                         ++yylineno;
-                        yylval->assign(1, '\n');
+                        *yylval = "\n";
                         return '\n';
                     }
                     YY_BREAK
                 case 36:
                     YY_RULE_SETUP
                     {
-                        yylval->assign(1, yytext[0]);
+                        *yylval = std::string_view(yytext, 1);
                         return angle::pp::Token::PP_OTHER;
                     }
                     YY_BREAK
@@ -1359,7 +1360,7 @@ YY_DECL
                     }
                     yylloc->file = yyfileno;
                     yylloc->line = yylineno;
-                    yylval->clear();
+                    *yylval = std::string_view();
 
                     // Line number overflows fake EOFs to exit early, check for this case.
                     if (yylineno == INT_MAX)
@@ -2539,7 +2540,8 @@ namespace angle
 namespace pp
 {
 
-Tokenizer::Tokenizer(Diagnostics *diagnostics) : mHandle(nullptr), mMaxTokenSize(256)
+Tokenizer::Tokenizer(Diagnostics *diagnostics, InternTable *internTable)
+    : mHandle(nullptr), mInternTable(internTable), mMaxTokenSize(256)
 {
     mContext.diagnostics = diagnostics;
 }
@@ -2577,11 +2579,14 @@ void Tokenizer::setMaxTokenSize(size_t maxTokenSize)
 
 void Tokenizer::lex(Token *token)
 {
-    int tokenType = yylex(&token->text, &token->location, mHandle);
+    // The scanned text points into the scanner's buffer, which is overwritten by the next token, so
+    // it is copied to the intern table.
+    std::string_view text;
+    int tokenType = yylex(&text, &token->location, mHandle);
 
     if (tokenType == Token::GOT_ERROR)
     {
-        mContext.diagnostics->report(Diagnostics::PP_TOKENIZER_ERROR, token->location, token->text);
+        mContext.diagnostics->report(Diagnostics::PP_TOKENIZER_ERROR, token->location, text);
         token->type = Token::LAST;
     }
     else
@@ -2589,12 +2594,15 @@ void Tokenizer::lex(Token *token)
         token->type = tokenType;
     }
 
-    if (token->text.size() > mMaxTokenSize)
+    if (text.size() > mMaxTokenSize)
     {
-        mContext.diagnostics->report(Diagnostics::PP_TOKEN_TOO_LONG, token->location, token->text);
-        token->text.erase(mMaxTokenSize);
+        mContext.diagnostics->report(Diagnostics::PP_TOKEN_TOO_LONG, token->location, text);
+        text = text.substr(0, mMaxTokenSize);
     }
 
+    // Identifiers are interned, as they are looked up in the macro set and repeat the most.
+    token->text  = token->type == Token::IDENTIFIER ? mInternTable->intern(text)
+                                                    : mInternTable->store(text);
     token->flags = 0;
 
     token->setAtStartOfLine(mContext.lineStart);
@@ -8,6 +8,7 @@
 #include "angle_gl.h"
 #include "compiler/translator/Symbol.h"
 #include "compiler/translator/tree_util/IntermTraverse.h"
+#include "compiler/translator/tree_util/PassManager.h"
 
 namespace sh
 {
@@ -140,6 +141,16 @@ void BuiltInFunctionEmulator::markBuiltInFunctionsForEmulation(TIntermNode *root
     root->traverse(&marker);
 }
 
+void BuiltInFunctionEmulator::queueMarkBuiltInFunctionsForEmulation(PassManager *passManager)
+{
+    if (mEmulatedFunctions.empty() && mQueryFunctions.empty())
+        return;
+
+    passManager->queueAnalysis({"BuiltInFunctionEmulation",
+                                std::make_unique<BuiltInFunctionEmulationMarker>(*this),
+                                AnalysisEffects::Results, nullptr});
+}
+
 void BuiltInFunctionEmulator::cleanup()
 {
     mFunctions.clear();
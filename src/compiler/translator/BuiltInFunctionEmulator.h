@@ -12,6 +12,7 @@
 namespace sh
 {
 
+class PassManager;
 class TIntermNode;
 class TFunction;
 class TSymbolUniqueId;
@@ -29,6 +30,8 @@ class BuiltInFunctionEmulator
     BuiltInFunctionEmulator();
 
     void markBuiltInFunctionsForEmulation(TIntermNode *root);
+    // Same as above, but the functions are marked once |passManager| runs its analyses.
+    void queueMarkBuiltInFunctionsForEmulation(PassManager *passManager);
 
     void cleanup();
 
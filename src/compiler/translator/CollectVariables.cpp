@@ -12,6 +12,7 @@
 #include "compiler/translator/HashNames.h"
 #include "compiler/translator/SymbolTable.h"
 #include "compiler/translator/tree_util/IntermTraverse.h"
+#include "compiler/translator/tree_util/PassManager.h"
 #include "compiler/translator/util.h"
 
 namespace sh
@@ -1294,27 +1295,29 @@ bool CollectVariablesTraverser::visitBinary(Visit, TIntermBinary *binaryNode)
 
 }  // anonymous namespace
 
-void CollectVariables(TIntermBlock *root,
-                      std::vector<ShaderVariable> *attributes,
-                      std::vector<ShaderVariable> *outputVariables,
-                      std::vector<ShaderVariable> *uniforms,
-                      std::vector<ShaderVariable> *inputVaryings,
-                      std::vector<ShaderVariable> *outputVaryings,
-                      std::vector<ShaderVariable> *sharedVariables,
-                      std::vector<InterfaceBlock> *uniformBlocks,
-                      std::vector<InterfaceBlock> *shaderStorageBlocks,
-                      ShHashFunction64 hashFunction,
-                      TSymbolTable *symbolTable,
-                      GLenum shaderType,
-                      const TExtensionBehavior &extensionBehavior,
-                      const ShBuiltInResources &resources,
-                      int tessControlShaderOutputVertices)
+void QueueCollectVariables(PassManager *passManager,
+                           std::vector<ShaderVariable> *attributes,
+                           std::vector<ShaderVariable> *outputVariables,
+                           std::vector<ShaderVariable> *uniforms,
+                           std::vector<ShaderVariable> *inputVaryings,
+                           std::vector<ShaderVariable> *outputVaryings,
+                           std::vector<ShaderVariable> *sharedVariables,
+                           std::vector<InterfaceBlock> *uniformBlocks,
+                           std::vector<InterfaceBlock> *shaderStorageBlocks,
+                           ShHashFunction64 hashFunction,
+                           TSymbolTable *symbolTable,
+                           GLenum shaderType,
+                           const TExtensionBehavior &extensionBehavior,
+                           const ShBuiltInResources &resources,
+                           int tessControlShaderOutputVertices)
 {
-    CollectVariablesTraverser collect(
-        attributes, outputVariables, uniforms, inputVaryings, outputVaryings, sharedVariables,
-        uniformBlocks, shaderStorageBlocks, hashFunction, symbolTable, shaderType,
-        extensionBehavior, resources, tessControlShaderOutputVertices);
-    root->traverse(&collect);
+    passManager->queueAnalysis(
+        {"CollectVariables",
+         std::make_unique<CollectVariablesTraverser>(
+             attributes, outputVariables, uniforms, inputVaryings, outputVaryings, sharedVariables,
+             uniformBlocks, shaderStorageBlocks, hashFunction, symbolTable, shaderType,
+             extensionBehavior, resources, tessControlShaderOutputVertices),
+         AnalysisEffects::Results, nullptr});
 }
 
 }  // namespace sh
@@ -15,24 +15,26 @@
 namespace sh
 {
 
-class TIntermBlock;
+class PassManager;
 class TSymbolTable;
 
-void CollectVariables(TIntermBlock *root,
-                      std::vector<ShaderVariable> *attributes,
-                      std::vector<ShaderVariable> *outputVariables,
-                      std::vector<ShaderVariable> *uniforms,
-                      std::vector<ShaderVariable> *inputVaryings,
-                      std::vector<ShaderVariable> *outputVaryings,
-                      std::vector<ShaderVariable> *sharedVariables,
-                      std::vector<InterfaceBlock> *uniformBlocks,
-                      std::vector<InterfaceBlock> *shaderStorageBlocks,
-                      ShHashFunction64 hashFunction,
-                      TSymbolTable *symbolTable,
-                      GLenum shaderType,
-                      const TExtensionBehavior &extensionBehavior,
-                      const ShBuiltInResources &resources,
-                      int tessControlShaderOutputVertices);
+// Queues the collection in |passManager|.  The variables are only collected once it runs its
+// analyses.
+void QueueCollectVariables(PassManager *passManager,
+                           std::vector<ShaderVariable> *attributes,
+                           std::vector<ShaderVariable> *outputVariables,
+                           std::vector<ShaderVariable> *uniforms,
+                           std::vector<ShaderVariable> *inputVaryings,
+                           std::vector<ShaderVariable> *outputVaryings,
+                           std::vector<ShaderVariable> *sharedVariables,
+                           std::vector<InterfaceBlock> *uniformBlocks,
+                           std::vector<InterfaceBlock> *shaderStorageBlocks,
+                           ShHashFunction64 hashFunction,
+                           TSymbolTable *symbolTable,
+                           GLenum shaderType,
+                           const TExtensionBehavior &extensionBehavior,
+                           const ShBuiltInResources &resources,
+                           int tessControlShaderOutputVertices);
 }  // namespace sh
 
 #endif  // COMPILER_TRANSLATOR_COLLECTVARIABLES_H_
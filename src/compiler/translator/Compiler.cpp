@@ -64,6 +64,7 @@
 #include "compiler/translator/tree_util/BuiltIn.h"
 #include "compiler/translator/tree_util/FindSymbolNode.h"
 #include "compiler/translator/tree_util/IntermNodePatternMatcher.h"
+#include "compiler/translator/tree_util/PassManager.h"
 #include "compiler/translator/tree_util/ReplaceShadowingVariables.h"
 #include "compiler/translator/tree_util/ReplaceVariable.h"
 #include "compiler/translator/util.h"
@@ -368,6 +369,9 @@ bool ValidateFragColorAndFragData(GLenum shaderType,
 
 TShHandleBase::TShHandleBase()
 {
+    // Every compile fills and empties the allocator, so keep its pages for the next compile on the
+    // thread instead of returning them to the OS.
+    allocator.enablePageRecycling();
     allocator.push();
     SetGlobalPoolAllocator(&allocator);
 }
@@ -401,7 +405,9 @@ TCompiler::TCompiler(sh::GLenum type, ShShaderSpec spec, ShShaderOutput output)
       mHasAnyPreciseType(false),
       mAdvancedBlendEquations(0),
       mUsesDerivatives(false),
-      mCompileOptions{}
+      mCompileOptions{},
+      mValidateASTDisabled(false),
+      mPlatformMethods(nullptr)
 {}
 
 TCompiler::~TCompiler() {}
@@ -732,7 +738,7 @@ bool TCompiler::getShaderBinary(const ShHandle compilerHandle,
 
 bool TCompiler::validateAST(TIntermNode *root)
 {
-    if (mCompileOptions.validateAST)
+    if (mCompileOptions.validateAST && !mValidateASTDisabled)
     {
         bool valid = ValidateAST(root, &mDiagnostics, mValidateASTOptions);
 
@@ -778,6 +784,19 @@ void TCompiler::restoreValidateVariableReferences(bool enable)
     mValidateASTOptions.validateVariableReferences = enable;
 }
 
+bool TCompiler::disableValidateAST()
+{
+    bool wasEnabled      = !mValidateASTDisabled;
+    mValidateASTDisabled = true;
+    return wasEnabled;
+}
+
+void TCompiler::restoreValidateAST(bool enable)
+{
+    ASSERT(mValidateASTDisabled);
+    mValidateASTDisabled = !enable;
+}
+
 void TCompiler::enableValidateNoMoreTransformations()
 {
     mValidateASTOptions.validateNoMoreTransformations = true;
@@ -789,15 +808,21 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
 {
     mValidateASTOptions = {};
 
+    // Every pass is timed through a trace event.  Analyses that only read the tree are queued
+    // instead, so that consecutive ones share a traversal.
+    PassManager passManager(root, mPlatformMethods);
+
     // Disallow expressions deemed too complex.
     // This needs to be checked before other functions that will traverse the AST
     // to prevent potential stack overflow crashes.
-    if (compileOptions.limitExpressionComplexity && !limitExpressionComplexity(root))
+    if (compileOptions.limitExpressionComplexity &&
+        !passManager.runPass("LimitExpressionComplexity",
+                             [&] { return limitExpressionComplexity(root); }))
     {
         return false;
     }
 
-    if (!validateAST(root))
+    if (!passManager.runPass("ValidateAST", [&] { return validateAST(root); }))
     {
         return false;
     }
@@ -809,7 +834,9 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
          IsExtensionEnabled(mExtensionBehavior,
                             TExtension::EXT_shader_framebuffer_fetch_non_coherent)))
     {
-        if (!RemoveUnusedFramebufferFetch(this, root, &mSymbolTable))
+        if (!passManager.runPass("RemoveUnusedFramebufferFetch", [&] {
+                return RemoveUnusedFramebufferFetch(this, root, &mSymbolTable);
+            }))
         {
             return false;
         }
@@ -825,8 +852,10 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
     {
         ASSERT(
             IsExtensionEnabled(mExtensionBehavior, TExtension::ANGLE_shader_pixel_local_storage));
-        if (!RewritePixelLocalStorage(this, root, getSymbolTable(), compileOptions,
-                                      getShaderVersion()))
+        if (!passManager.runPass("RewritePixelLocalStorage", [&] {
+                return RewritePixelLocalStorage(this, root, getSymbolTable(), compileOptions,
+                                                getShaderVersion());
+            }))
         {
             mDiagnostics.globalError("internal compiler error translating pixel local storage");
             return false;
@@ -834,7 +863,9 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
     }
 
     if (shouldRunLoopAndIndexingValidation(compileOptions) &&
-        !ValidateLimitations(root, mShaderType, &mSymbolTable, &mDiagnostics))
+        !passManager.runPass("ValidateLimitations", [&] {
+            return ValidateLimitations(root, mShaderType, &mSymbolTable, &mDiagnostics);
+        }))
     {
         return false;
     }
@@ -846,7 +877,8 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
 
     // Fold expressions that could not be folded before validation that was done as a part of
     // parsing.
-    if (!FoldExpressions(this, root, &mDiagnostics))
+    if (!passManager.runPass("FoldExpressions",
+                             [&] { return FoldExpressions(this, root, &mDiagnostics); }))
     {
         return false;
     }
@@ -863,9 +895,12 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
         parseContext.isExtensionEnabled(TExtension::APPLE_clip_distance))
     {
         bool isClipDistanceUsed = false;
-        if (!ValidateClipCullDistance(this, root, &mDiagnostics,
-                                      mResources.MaxCombinedClipAndCullDistances,
-                                      &mClipDistanceSize, &mCullDistanceSize, &isClipDistanceUsed))
+        if (!passManager.runPass("ValidateClipCullDistance", [&] {
+                return ValidateClipCullDistance(this, root, &mDiagnostics,
+                                                mResources.MaxCombinedClipAndCullDistances,
+                                                &mClipDistanceSize, &mCullDistanceSize,
+                                                &isClipDistanceUsed);
+            }))
         {
             return false;
         }
@@ -873,7 +908,9 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
     }
 
     // Validate no barrier() after return before prunning it in |PruneNoOps()| below.
-    if (mShaderType == GL_TESS_CONTROL_SHADER && !ValidateBarrierFunctionCall(root, &mDiagnostics))
+    if (mShaderType == GL_TESS_CONTROL_SHADER &&
+        !passManager.runPass("ValidateBarrierFunctionCall",
+                             [&] { return ValidateBarrierFunctionCall(root, &mDiagnostics); }))
     {
         return false;
     }
@@ -886,7 +923,7 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
     //      invalid ESSL.
     //   3. Any unreachable statement after a discard, return, break or continue.
     // After this empty declarations are not allowed in the AST.
-    if (!PruneNoOps(this, root, &mSymbolTable))
+    if (!passManager.runPass("PruneNoOps", [&] { return PruneNoOps(this, root, &mSymbolTable); }))
     {
         return false;
     }
@@ -913,16 +950,17 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
     // This is because MSL doesn't allow statically initialized non-const globals.
     bool forceDeferNonConstGlobalInitializers = getOutputType() == SH_MSL_METAL_OUTPUT;
 
-    if (enableNonConstantInitializers &&
-        !DeferGlobalInitializers(this, root, initializeLocalsAndGlobals, canUseLoopsToInitialize,
-                                 highPrecisionSupported, forceDeferNonConstGlobalInitializers,
-                                 &mSymbolTable))
+    if (enableNonConstantInitializers && !passManager.runPass("DeferGlobalInitializers", [&] {
+            return DeferGlobalInitializers(this, root, initializeLocalsAndGlobals,
+                                           canUseLoopsToInitialize, highPrecisionSupported,
+                                           forceDeferNonConstGlobalInitializers, &mSymbolTable);
+        }))
     {
         return false;
     }
 
     // Create the function DAG and check there is no recursion
-    if (!initCallDag(root))
+    if (!passManager.runPass("InitCallDag", [&] { return initCallDag(root); }))
     {
         return false;
     }
@@ -940,36 +978,45 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
         return false;
     }
 
-    if (!pruneUnusedFunctions(root))
+    if (!passManager.runPass("PruneUnusedFunctions", [&] { return pruneUnusedFunctions(root); }))
     {
         return false;
     }
 
     if (IsSpecWithFunctionBodyNewScope(mShaderSpec, mShaderVersion))
     {
-        if (!ReplaceShadowingVariables(this, root, &mSymbolTable))
+        if (!passManager.runPass("ReplaceShadowingVariables", [&] {
+                return ReplaceShadowingVariables(this, root, &mSymbolTable);
+            }))
         {
             return false;
         }
     }
 
-    if (mShaderVersion >= 310 && !ValidateVaryingLocations(root, &mDiagnostics, mShaderType))
+    if (mShaderVersion >= 310 && !passManager.runPass("ValidateVaryingLocations", [&] {
+            return ValidateVaryingLocations(root, &mDiagnostics, mShaderType);
+        }))
     {
         return false;
     }
 
     // anglebug.com/42265954: The ESSL spec has a bug with images as function arguments. The
     // recommended workaround is to inline functions that accept image arguments.
-    if (mShaderVersion >= 310 && !MonomorphizeUnsupportedFunctions(
-                                     this, root, &mSymbolTable,
-                                     UnsupportedFunctionArgsBitSet{UnsupportedFunctionArgs::Image}))
+    if (mShaderVersion >= 310 && !passManager.runPass("MonomorphizeUnsupportedFunctions", [&] {
+            return MonomorphizeUnsupportedFunctions(
+                this, root, &mSymbolTable,
+                UnsupportedFunctionArgsBitSet{UnsupportedFunctionArgs::Image});
+        }))
     {
         return false;
     }
 
     if (mShaderVersion >= 300 && mShaderType == GL_FRAGMENT_SHADER &&
-        !ValidateOutputs(root, getExtensionBehavior(), mResources, hasPixelLocalStorageUniforms(),
-                         IsWebGLBasedSpec(mShaderSpec), &mDiagnostics))
+        !passManager.runPass("ValidateOutputs", [&] {
+            return ValidateOutputs(root, getExtensionBehavior(), mResources,
+                                   hasPixelLocalStorageUniforms(), IsWebGLBasedSpec(mShaderSpec),
+                                   &mDiagnostics);
+        }))
     {
         return false;
     }
@@ -977,7 +1024,9 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
     // Clamping uniform array bounds needs to happen after validateLimitations pass.
     if (compileOptions.clampIndirectArrayBounds)
     {
-        if (!ClampIndirectIndices(this, root, &mSymbolTable))
+        if (!passManager.runPass("ClampIndirectIndices", [&] {
+                return ClampIndirectIndices(this, root, &mSymbolTable);
+            }))
         {
             return false;
         }
@@ -988,8 +1037,10 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
          parseContext.isExtensionEnabled(TExtension::OVR_multiview)) &&
         getShaderType() != GL_COMPUTE_SHADER)
     {
-        if (!DeclareAndInitBuiltinsForInstancedMultiview(
-                this, root, mNumViews, mShaderType, compileOptions, mOutputType, &mSymbolTable))
+        if (!passManager.runPass("DeclareAndInitBuiltinsForInstancedMultiview", [&] {
+                return DeclareAndInitBuiltinsForInstancedMultiview(
+                    this, root, mNumViews, mShaderType, compileOptions, mOutputType, &mSymbolTable);
+            }))
         {
             return false;
         }
@@ -998,7 +1049,8 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
     // This pass might emit short circuits so keep it before the short circuit unfolding
     if (compileOptions.rewriteDoWhileLoops)
     {
-        if (!RewriteDoWhile(this, root, &mSymbolTable))
+        if (!passManager.runPass("RewriteDoWhile",
+                                 [&] { return RewriteDoWhile(this, root, &mSymbolTable); }))
         {
             return false;
         }
@@ -1006,7 +1058,8 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
 
     if (compileOptions.addAndTrueToLoopCondition)
     {
-        if (!AddAndTrueToLoopCondition(this, root))
+        if (!passManager.runPass("AddAndTrueToLoopCondition",
+                                 [&] { return AddAndTrueToLoopCondition(this, root); }))
         {
             return false;
         }
@@ -1014,7 +1067,8 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
 
     if (compileOptions.unfoldShortCircuit)
     {
-        if (!UnfoldShortCircuitAST(this, root))
+        if (!passManager.runPass("UnfoldShortCircuitAST",
+                                 [&] { return UnfoldShortCircuitAST(this, root); }))
         {
             return false;
         }
@@ -1022,7 +1076,8 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
 
     if (compileOptions.regenerateStructNames)
     {
-        if (!RegenerateStructNames(this, root, &mSymbolTable))
+        if (!passManager.runPass("RegenerateStructNames",
+                                 [&] { return RegenerateStructNames(this, root, &mSymbolTable); }))
         {
             return false;
         }
@@ -1033,7 +1088,9 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
     {
         if (compileOptions.emulateGLDrawID)
         {
-            if (!EmulateGLDrawID(this, root, &mSymbolTable, &mUniforms))
+            if (!passManager.runPass("EmulateGLDrawID", [&] {
+                    return EmulateGLDrawID(this, root, &mSymbolTable, &mUniforms);
+                }))
             {
                 return false;
             }
@@ -1046,8 +1103,10 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
     {
         if (compileOptions.emulateGLBaseVertexBaseInstance)
         {
-            if (!EmulateGLBaseVertexBaseInstance(this, root, &mSymbolTable, &mUniforms,
-                                                 compileOptions.addBaseVertexToVertexID))
+            if (!passManager.runPass("EmulateGLBaseVertexBaseInstance", [&] {
+                    return EmulateGLBaseVertexBaseInstance(this, root, &mSymbolTable, &mUniforms,
+                                                           compileOptions.addBaseVertexToVertexID);
+                }))
             {
                 return false;
             }
@@ -1058,17 +1117,26 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
         mResources.MaxDrawBuffers > 1 &&
         IsExtensionEnabled(mExtensionBehavior, TExtension::EXT_draw_buffers))
     {
-        if (!EmulateGLFragColorBroadcast(this, root, mResources.MaxDrawBuffers,
-                                         mResources.MaxDualSourceDrawBuffers, &mOutputVariables,
-                                         &mSymbolTable, mShaderVersion))
+        if (!passManager.runPass("EmulateGLFragColorBroadcast", [&] {
+                return EmulateGLFragColorBroadcast(this, root, mResources.MaxDrawBuffers,
+                                                   mResources.MaxDualSourceDrawBuffers,
+                                                   &mOutputVariables, &mSymbolTable,
+                                                   mShaderVersion);
+            }))
         {
             return false;
         }
     }
 
+    // Loops can only appear inside functions, so loop conditions of different functions are
+    // simplified independently.
     if (compileOptions.simplifyLoopConditions)
     {
-        if (!SimplifyLoopConditions(this, root, &getSymbolTable()))
+        if (!passManager.runPass("SimplifyLoopConditions", [&] {
+                return runPerFunctionPass(root, [this](TIntermBlock *block) {
+                    return SimplifyLoopConditions(this, block, &getSymbolTable());
+                });
+            }))
         {
             return false;
         }
@@ -1078,10 +1146,15 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
         // Split multi declarations and remove calls to array length().
         // Note that SimplifyLoopConditions needs to be run before any other AST transformations
         // that may need to generate new statements from loop conditions or loop expressions.
-        if (!SimplifyLoopConditions(this, root,
-                                    IntermNodePatternMatcher::kMultiDeclaration |
-                                        IntermNodePatternMatcher::kArrayLengthMethod,
-                                    &getSymbolTable()))
+        if (!passManager.runPass("SimplifyLoopConditions", [&] {
+                return runPerFunctionPass(root, [this](TIntermBlock *block) {
+                    return SimplifyLoopConditions(
+                        this, block,
+                        IntermNodePatternMatcher::kMultiDeclaration |
+                            IntermNodePatternMatcher::kArrayLengthMethod,
+                        &getSymbolTable());
+                });
+            }))
         {
             return false;
         }
@@ -1089,7 +1162,10 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
 
     // Note that separate declarations need to be run before other AST transformations that
     // generate new statements from expressions.
-    if (!SeparateDeclarations(*this, *root, mCompileOptions.separateCompoundStructDeclarations))
+    if (!passManager.runPass("SeparateDeclarations", [&] {
+            return SeparateDeclarations(*this, *root,
+                                        mCompileOptions.separateCompoundStructDeclarations);
+        }))
     {
         return false;
     }
@@ -1098,7 +1174,9 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
     {
         // Remove infinite loops, they are not supposed to exist in shaders.
         bool anyInfiniteLoops = false;
-        if (!PruneInfiniteLoops(this, root, &mSymbolTable, &anyInfiniteLoops))
+        if (!passManager.runPass("PruneInfiniteLoops", [&] {
+                return PruneInfiniteLoops(this, root, &mSymbolTable, &anyInfiniteLoops);
+            }))
         {
             return false;
         }
@@ -1114,7 +1192,8 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
 
     if (compileOptions.rescopeGlobalVariables)
     {
-        if (!RescopeGlobalVariables(*this, *root))
+        if (!passManager.runPass("RescopeGlobalVariables",
+                                 [&] { return RescopeGlobalVariables(*this, *root); }))
         {
             return false;
         }
@@ -1122,23 +1201,29 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
 
     mValidateASTOptions.validateMultiDeclarations = true;
 
-    if (!SplitSequenceOperator(this, root, IntermNodePatternMatcher::kArrayLengthMethod,
-                               &getSymbolTable()))
+    if (!passManager.runPass("SplitSequenceOperator", [&] {
+            return SplitSequenceOperator(this, root, IntermNodePatternMatcher::kArrayLengthMethod,
+                                         &getSymbolTable());
+        }))
     {
         return false;
     }
 
-    if (!RemoveArrayLengthMethod(this, root))
+    if (!passManager.runPass("RemoveArrayLengthMethod",
+                             [&] { return RemoveArrayLengthMethod(this, root); }))
     {
         return false;
     }
     // Fold the expressions again, because |RemoveArrayLengthMethod| can introduce new constants.
-    if (!FoldExpressions(this, root, &mDiagnostics))
+    if (!passManager.runPass("FoldExpressions",
+                             [&] { return FoldExpressions(this, root, &mDiagnostics); }))
     {
         return false;
     }
 
-    if (!RemoveUnreferencedVariables(this, root, &mSymbolTable))
+    if (!passManager.runPass("RemoveUnreferencedVariables", [&] {
+            return RemoveUnreferencedVariables(this, root, &mSymbolTable);
+        }))
     {
         return false;
     }
@@ -1149,27 +1234,39 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
     // left switch statements that only contained an empty declaration inside the final case in an
     // invalid state. Relies on that PruneNoOps and RemoveUnreferencedVariables have already been
     // run.
-    if (!PruneEmptyCases(this, root))
+    if (!passManager.runPass("PruneEmptyCases", [&] {
+            return runPerFunctionPass(
+                root, [this](TIntermBlock *block) { return PruneEmptyCases(this, block); });
+        }))
     {
         return false;
     }
 
     // Run after RemoveUnreferencedVariables, validate that the shader does not have excessively
-    // large variables.
-    if (shouldLimitTypeSizes() && !ValidateTypeSizeLimitations(root, &mSymbolTable, &mDiagnostics))
+    // large variables.  ScalarizeVecAndMatConstructorArgs adds temporaries, which count towards the
+    // private variable size, so the validation is queued before it and
+    // ForceShaderPrecisionToMediump if either runs.  Otherwise the tree it sees is the same either
+    // way, and it is queued last so that it can share the traversal of the analyses below, which
+    // can't fail.
+    const bool transformBeforeCollectingVariables =
+        compileOptions.scalarizeVecAndMatConstructorArgs ||
+        compileOptions.forceShaderPrecisionHighpToMediump;
+    if (shouldLimitTypeSizes() && transformBeforeCollectingVariables)
     {
-        return false;
+        QueueValidateTypeSizeLimitations(&passManager, &mSymbolTable, &mDiagnostics);
     }
 
     // Built-in function emulation needs to happen after validateLimitations pass.
     GetGlobalPoolAllocator()->lock();
     initBuiltInFunctionEmulator(&mBuiltInFunctionEmulator, compileOptions);
     GetGlobalPoolAllocator()->unlock();
-    mBuiltInFunctionEmulator.markBuiltInFunctionsForEmulation(root);
+    mBuiltInFunctionEmulator.queueMarkBuiltInFunctionsForEmulation(&passManager);
 
     if (compileOptions.scalarizeVecAndMatConstructorArgs)
     {
-        if (!ScalarizeVecAndMatConstructorArgs(this, root, &mSymbolTable))
+        if (!passManager.runPass("ScalarizeVecAndMatConstructorArgs", [&] {
+                return ScalarizeVecAndMatConstructorArgs(this, root, &mSymbolTable);
+            }))
         {
             return false;
         }
@@ -1177,22 +1274,38 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
 
     if (compileOptions.forceShaderPrecisionHighpToMediump)
     {
-        if (!ForceShaderPrecisionToMediump(root, &mSymbolTable, mShaderType))
+        if (!passManager.runPass("ForceShaderPrecisionToMediump", [&] {
+                return ForceShaderPrecisionToMediump(root, &mSymbolTable, mShaderType);
+            }))
         {
             return false;
         }
     }
 
+    // If none of the above passes run, the functions are marked in the same traversal as the
+    // variables are collected and their sizes validated.
     ASSERT(!mVariablesCollected);
-    CollectVariables(root, &mAttributes, &mOutputVariables, &mUniforms, &mInputVaryings,
-                     &mOutputVaryings, &mSharedVariables, &mUniformBlocks, &mShaderStorageBlocks,
-                     mResources.HashFunction, &mSymbolTable, mShaderType, mExtensionBehavior,
-                     mResources, mTessControlShaderOutputVertices);
+    QueueCollectVariables(&passManager, &mAttributes, &mOutputVariables, &mUniforms,
+                          &mInputVaryings, &mOutputVaryings, &mSharedVariables, &mUniformBlocks,
+                          &mShaderStorageBlocks, mResources.HashFunction, &mSymbolTable,
+                          mShaderType, mExtensionBehavior, mResources,
+                          mTessControlShaderOutputVertices);
+
+    if (shouldLimitTypeSizes() && !transformBeforeCollectingVariables)
+    {
+        QueueValidateTypeSizeLimitations(&passManager, &mSymbolTable, &mDiagnostics);
+    }
+    if (!passManager.runAnalyses())
+    {
+        return false;
+    }
     collectInterfaceBlocks();
     mVariablesCollected = true;
     if (compileOptions.useUnusedStandardSharedBlocks)
     {
-        if (!useAllMembersInUnusedStandardAndSharedBlocks(root))
+        if (!passManager.runPass("UseAllMembersInUnusedStandardAndSharedBlocks", [&] {
+                return useAllMembersInUnusedStandardAndSharedBlocks(root);
+            }))
         {
             return false;
         }
@@ -1221,10 +1334,12 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
     // For the MSL output, keep the inactive fragment outputs, but remove them otherwise.
     if (compileOptions.removeInactiveVariables)
     {
-        if (!RemoveInactiveInterfaceVariables(this, root, &getSymbolTable(), getAttributes(),
-                                              getInputVaryings(), getOutputVariables(),
-                                              getUniforms(), getInterfaceBlocks(),
-                                              mOutputType != SH_MSL_METAL_OUTPUT))
+        if (!passManager.runPass("RemoveInactiveInterfaceVariables", [&] {
+                return RemoveInactiveInterfaceVariables(
+                    this, root, &getSymbolTable(), getAttributes(), getInputVaryings(),
+                    getOutputVariables(), getUniforms(), getInterfaceBlocks(),
+                    mOutputType != SH_MSL_METAL_OUTPUT);
+            }))
         {
             return false;
         }
@@ -1236,7 +1351,8 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
         compileOptions.initFragmentOutputVariables && mShaderType == GL_FRAGMENT_SHADER;
     if (needInitializeOutputVariables)
     {
-        if (!initializeOutputVariables(root))
+        if (!passManager.runPass("InitializeOutputVariables",
+                                 [&] { return initializeOutputVariables(root); }))
         {
             return false;
         }
@@ -1246,7 +1362,8 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
     // Otherwise, built-in invariant declarations don't apply.
     if (RemoveInvariant(mShaderType, mShaderVersion, mOutputType, compileOptions))
     {
-        if (!RemoveInvariantDeclaration(this, root))
+        if (!passManager.runPass("RemoveInvariantDeclaration",
+                                 [&] { return RemoveInvariantDeclaration(this, root); }))
         {
             return false;
         }
@@ -1258,7 +1375,8 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
     if (mShaderType == GL_VERTEX_SHADER && !mGLPositionInitialized &&
         (compileOptions.initGLPosition || mOutputType == SH_GLSL_COMPATIBILITY_OUTPUT))
     {
-        if (!initializeGLPosition(root))
+        if (!passManager.runPass("InitializeGLPosition",
+                                 [&] { return initializeGLPosition(root); }))
         {
             return false;
         }
@@ -1272,10 +1390,11 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
     // Exception: if EXT_shader_non_constant_global_initializers is enabled, we must generate global
     // initializers before we generate the DAG, since initializers may call functions which must not
     // be optimized out
-    if (!enableNonConstantInitializers &&
-        !DeferGlobalInitializers(this, root, initializeLocalsAndGlobals, canUseLoopsToInitialize,
-                                 highPrecisionSupported, forceDeferNonConstGlobalInitializers,
-                                 &mSymbolTable))
+    if (!enableNonConstantInitializers && !passManager.runPass("DeferGlobalInitializers", [&] {
+            return DeferGlobalInitializers(this, root, initializeLocalsAndGlobals,
+                                           canUseLoopsToInitialize, highPrecisionSupported,
+                                           forceDeferNonConstGlobalInitializers, &mSymbolTable);
+        }))
     {
         return false;
     }
@@ -1292,17 +1411,25 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
 
         if (!shouldRunLoopAndIndexingValidation(compileOptions))
         {
-            if (!SimplifyLoopConditions(this, root,
-                                        IntermNodePatternMatcher::kArrayDeclaration |
-                                            IntermNodePatternMatcher::kNamelessStructDeclaration,
-                                        &getSymbolTable()))
+            if (!passManager.runPass("SimplifyLoopConditions", [&] {
+                    return runPerFunctionPass(root, [this](TIntermBlock *block) {
+                        return SimplifyLoopConditions(
+                            this, block,
+                            IntermNodePatternMatcher::kArrayDeclaration |
+                                IntermNodePatternMatcher::kNamelessStructDeclaration,
+                            &getSymbolTable());
+                    });
+                }))
             {
                 return false;
             }
         }
 
-        if (!InitializeUninitializedLocals(this, root, getShaderVersion(), canUseLoopsToInitialize,
-                                           highPrecisionSupported, &getSymbolTable()))
+        if (!passManager.runPass("InitializeUninitializedLocals", [&] {
+                return InitializeUninitializedLocals(this, root, getShaderVersion(),
+                                                     canUseLoopsToInitialize,
+                                                     highPrecisionSupported, &getSymbolTable());
+            }))
         {
             return false;
         }
@@ -1310,8 +1437,10 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
 
     if (getShaderType() == GL_VERTEX_SHADER && compileOptions.clampPointSize)
     {
-        if (!ClampPointSize(this, root, mResources.MinPointSize, mResources.MaxPointSize,
-                            &getSymbolTable()))
+        if (!passManager.runPass("ClampPointSize", [&] {
+                return ClampPointSize(this, root, mResources.MinPointSize,
+                                      mResources.MaxPointSize, &getSymbolTable());
+            }))
         {
             return false;
         }
@@ -1319,7 +1448,8 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
 
     if (getShaderType() == GL_FRAGMENT_SHADER && compileOptions.clampFragDepth)
     {
-        if (!ClampFragDepth(this, root, &getSymbolTable()))
+        if (!passManager.runPass("ClampFragDepth",
+                                 [&] { return ClampFragDepth(this, root, &getSymbolTable()); }))
         {
             return false;
         }
@@ -1327,7 +1457,8 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
 
     if (compileOptions.rewriteRepeatedAssignToSwizzled)
     {
-        if (!sh::RewriteRepeatedAssignToSwizzled(this, root))
+        if (!passManager.runPass("RewriteRepeatedAssignToSwizzled",
+                                 [&] { return sh::RewriteRepeatedAssignToSwizzled(this, root); }))
         {
             return false;
         }
@@ -1335,7 +1466,10 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
 
     if (compileOptions.removeDynamicIndexingOfSwizzledVector)
     {
-        if (!sh::RemoveDynamicIndexingOfSwizzledVector(this, root, &getSymbolTable(), nullptr))
+        if (!passManager.runPass("RemoveDynamicIndexingOfSwizzledVector", [&] {
+                return sh::RemoveDynamicIndexingOfSwizzledVector(this, root, &getSymbolTable(),
+                                                                 nullptr);
+            }))
         {
             return false;
         }
@@ -1607,6 +1741,17 @@ void TCompiler::collectInterfaceBlocks()
                             mShaderStorageBlocks.end());
 }
 
+bool TCompiler::runPerFunctionPass(TIntermBlock *root, const PerFunctionPass &pass)
+{
+    if (!mCompileOptions.parallelFunctionTransformations)
+    {
+        return pass(root);
+    }
+
+    return RunPerFunctionPasses(this, root, &mSymbolTable, mWorkerThreadPool.get(), pass,
+                                &mPerFunctionPassAllocators);
+}
+
 void TCompiler::clearResults()
 {
     mInfoSink.info.erase();
@@ -1652,6 +1797,8 @@ void TCompiler::clearResults()
     mSourcePath = nullptr;
 
     mSymbolTable.clearCompilationResults();
+
+    mPerFunctionPassAllocators.clear();
 }
 
 bool TCompiler::initCallDag(TIntermNode *root)
@@ -26,6 +26,12 @@
 #include "compiler/translator/Pragma.h"
 #include "compiler/translator/SymbolTable.h"
 #include "compiler/translator/ValidateAST.h"
+#include "compiler/translator/tree_util/RunPerFunctionPasses.h"
+
+namespace angle
+{
+struct PlatformMethods;
+}  // namespace angle
 
 namespace sh
 {
@@ -66,6 +72,10 @@ class TShHandleBase
     TShHandleBase();
     virtual ~TShHandleBase();
     virtual TCompiler *getAsCompiler() { return nullptr; }
+    angle::PoolAllocator::Statistics getPoolAllocatorStatistics() const
+    {
+        return allocator.getStatistics();
+    }
 #ifdef ANGLE_ENABLE_HLSL
     virtual TranslatorHLSL *getAsTranslatorHLSL() { return nullptr; }
 #endif  // ANGLE_ENABLE_HLSL
@@ -124,6 +134,19 @@ class TCompiler : public TShHandleBase
     // Clears the results from the previous compilation.
     void clearResults();
 
+    // Sets the pool used to transform function bodies in parallel when
+    // ShCompileOptions::parallelFunctionTransformations is set.
+    void setWorkerThreadPool(const std::shared_ptr<angle::WorkerThreadPool> &workerThreadPool)
+    {
+        mWorkerThreadPool = workerThreadPool;
+    }
+
+    // Sets the platform through which the time spent in each pass is reported with trace events.
+    void setPlatformMethods(angle::PlatformMethods *platformMethods)
+    {
+        mPlatformMethods = platformMethods;
+    }
+
     const std::vector<sh::ShaderVariable> &getAttributes() const { return mAttributes; }
     const std::vector<sh::ShaderVariable> &getOutputVariables() const { return mOutputVariables; }
     const std::vector<sh::ShaderVariable> &getUniforms() const { return mUniforms; }
@@ -216,6 +239,8 @@ class TCompiler : public TShHandleBase
     void restoreValidateFunctionCall(bool enable);
     bool disableValidateVariableReferences();
     void restoreValidateVariableReferences(bool enable);
+    bool disableValidateAST();
+    void restoreValidateAST(bool enable);
     // When the AST is post-processed (such as to determine precise-ness of intermediate nodes),
     // it's expected to no longer transform.
     void enableValidateNoMoreTransformations();
@@ -327,6 +352,10 @@ class TCompiler : public TShHandleBase
 
     bool postParseChecks(const TParseContext &parseContext);
 
+    // Runs a transformation that only affects function bodies, either on the whole tree or on
+    // each function in parallel if so requested.
+    [[nodiscard]] bool runPerFunctionPass(TIntermBlock *root, const PerFunctionPass &pass);
+
     sh::GLenum mShaderType;
     ShShaderSpec mShaderSpec;
     ShShaderOutput mOutputType;
@@ -396,6 +425,17 @@ class TCompiler : public TShHandleBase
     TPragma mPragma;
 
     ShCompileOptions mCompileOptions;
+
+    // Set while function bodies are being transformed in parallel, during which the tree is not
+    // validated after each pass.
+    bool mValidateASTDisabled;
+
+    // Used for ShCompileOptions::parallelFunctionTransformations.  The allocators hold the nodes
+    // created on worker threads, and live as long as the compilation results.
+    std::shared_ptr<angle::WorkerThreadPool> mWorkerThreadPool;
+    std::vector<std::unique_ptr<angle::PoolAllocator>> mPerFunctionPassAllocators;
+
+    angle::PlatformMethods *mPlatformMethods;
 };
 
 //
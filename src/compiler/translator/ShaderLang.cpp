@@ -421,6 +421,21 @@ void ClearResults(const ShHandle handle)
     compiler->clearResults();
 }
 
+void SetPlatformMethods(const ShHandle handle, angle::PlatformMethods *platformMethods)
+{
+    TCompiler *compiler = GetCompilerFromHandle(handle);
+    ASSERT(compiler);
+    compiler->setPlatformMethods(platformMethods);
+}
+
+void SetWorkerThreadPool(const ShHandle handle,
+                         const std::shared_ptr<angle::WorkerThreadPool> &workerThreadPool)
+{
+    TCompiler *compiler = GetCompilerFromHandle(handle);
+    ASSERT(compiler);
+    compiler->setWorkerThreadPool(workerThreadPool);
+}
+
 int GetShaderVersion(const ShHandle handle)
 {
     TCompiler *compiler = GetCompilerFromHandle(handle);
@@ -13,7 +13,11 @@
 
 #include "compiler/translator/SymbolTable.h"
 
+#include <mutex>
+
 #include "angle_gl.h"
+#include "common/SimpleMutex.h"
+#include "common/base/anglebase/no_destructor.h"
 #include "compiler/translator/ImmutableString.h"
 #include "compiler/translator/IntermNode.h"
 #include "compiler/translator/StaticType.h"
@@ -23,6 +27,9 @@ namespace sh
 {
 namespace
 {
+// The id range installed on this thread by TSymbolTable::ScopedUniqueIdRange, if any.
+thread_local TSymbolTable::ScopedUniqueIdRange *gCurrentUniqueIdRange = nullptr;
+
 bool CheckShaderType(Shader expected, GLenum actual)
 {
     switch (expected)
@@ -51,6 +58,32 @@ bool CheckShaderType(Shader expected, GLenum actual)
     }
 }
 
+void ComputeLazyTypeProperties(const TType &type);
+
+void ComputeLazyFieldListProperties(const TFieldListCollection &fieldList)
+{
+    fieldList.objectSize();
+    fieldList.deepestNesting();
+    fieldList.mangledFieldList();
+    for (const TField *field : fieldList.fields())
+    {
+        ComputeLazyTypeProperties(*field->type());
+    }
+}
+
+void ComputeLazyTypeProperties(const TType &type)
+{
+    type.getMangledName();
+    if (type.getStruct() != nullptr)
+    {
+        ComputeLazyFieldListProperties(*type.getStruct());
+    }
+    if (type.getInterfaceBlock() != nullptr)
+    {
+        ComputeLazyFieldListProperties(*type.getInterfaceBlock());
+    }
+}
+
 bool CheckExtension(uint32_t extensionIndex, const ShBuiltInResources &resources)
 {
     const int *resourcePtr = reinterpret_cast<const int *>(&resources);
@@ -58,6 +91,35 @@ bool CheckExtension(uint32_t extensionIndex, const ShBuiltInResources &resources
 }
 }  // namespace
 
+void ComputeLazySymbolProperties(const TSymbol *symbol)
+{
+    if (symbol == nullptr)
+    {
+        return;
+    }
+    if (symbol->isVariable())
+    {
+        ComputeLazyTypeProperties(static_cast<const TVariable *>(symbol)->getType());
+    }
+    else if (symbol->isStruct())
+    {
+        ComputeLazyFieldListProperties(*static_cast<const TStructure *>(symbol));
+    }
+    else if (symbol->isInterfaceBlock())
+    {
+        ComputeLazyFieldListProperties(*static_cast<const TInterfaceBlock *>(symbol));
+    }
+    else if (symbol->isFunction())
+    {
+        const TFunction *function = static_cast<const TFunction *>(symbol);
+        ComputeLazyTypeProperties(function->getReturnType());
+        for (size_t paramIndex = 0; paramIndex < function->getParamCount(); ++paramIndex)
+        {
+            ComputeLazySymbolProperties(function->getParam(paramIndex));
+        }
+    }
+}
+
 class TSymbolTable::TSymbolTableLevel
 {
   public:
@@ -364,10 +426,151 @@ void TSymbolTable::clearCompilationResults()
 
 int TSymbolTable::nextUniqueIdValue()
 {
+    if (gCurrentUniqueIdRange != nullptr)
+    {
+        ASSERT(gCurrentUniqueIdRange->mNextId < gCurrentUniqueIdRange->mEndId);
+        return gCurrentUniqueIdRange->mNextId++;
+    }
+
     ASSERT(mUniqueIdCounter < std::numeric_limits<int>::max());
     return ++mUniqueIdCounter;
 }
 
+bool TSymbolTable::reserveUniqueIdRange(int count, int *firstIdOut)
+{
+    ASSERT(count > 0);
+    if (count > std::numeric_limits<int>::max() - mUniqueIdCounter)
+    {
+        return false;
+    }
+
+    *firstIdOut = mUniqueIdCounter + 1;
+    mUniqueIdCounter += count;
+    return true;
+}
+
+TSymbolTable::ScopedUniqueIdRange::ScopedUniqueIdRange(int firstId, int count)
+    : mNextId(firstId), mEndId(firstId + count), mPrevious(gCurrentUniqueIdRange)
+{
+    gCurrentUniqueIdRange = this;
+}
+
+TSymbolTable::ScopedUniqueIdRange::~ScopedUniqueIdRange()
+{
+    ASSERT(gCurrentUniqueIdRange == this);
+    gCurrentUniqueIdRange = mPrevious;
+}
+
+// The built-in variables that depend on the resources, such as gl_MaxDrawBuffers, are created in
+// their own pool so they can outlive the compiler that created them.  Compilers are often created
+// with identical parameters, for example by every context or for every parallel compile, and they
+// share these variables instead of creating them again.  The variables are never modified once
+// created.
+struct TSymbolTable::BuiltInVariables : angle::NonCopyable
+{
+    sh::GLenum shaderType;
+    ShShaderSpec spec;
+    ShBuiltInResources resources;
+
+    angle::PoolAllocator allocator;
+    TSymbolTableBase symbols;
+};
+
+class TSymbolTable::BuiltInVariableCache : angle::NonCopyable
+{
+  public:
+    static BuiltInVariableCache &Get()
+    {
+        static angle::base::NoDestructor<BuiltInVariableCache> sCache;
+        return *sCache;
+    }
+
+    std::shared_ptr<const BuiltInVariables> getOrCreate(sh::GLenum shaderType,
+                                                        ShShaderSpec spec,
+                                                        const ShBuiltInResources &resources);
+    void clear();
+
+  private:
+    // Processes typically compile shaders with a single set of resources, so only the most
+    // recently used few are kept.
+    static constexpr size_t kMaxEntries = 8;
+
+    angle::SimpleMutex mMutex;
+    // Ordered from the least to the most recently used.
+    std::vector<std::shared_ptr<const BuiltInVariables>> mEntries;
+};
+
+std::shared_ptr<const TSymbolTable::BuiltInVariables>
+TSymbolTable::BuiltInVariableCache::getOrCreate(sh::GLenum shaderType,
+                                                ShShaderSpec spec,
+                                                const ShBuiltInResources &resources)
+{
+    std::lock_guard<angle::SimpleMutex> lock(mMutex);
+
+    // The resources are memset to zero by InitBuiltInResources, so they can be compared with
+    // memcmp.  At worst, garbage in padding bytes results in a cache miss.
+    for (auto iter = mEntries.begin(); iter != mEntries.end(); ++iter)
+    {
+        const BuiltInVariables &entry = **iter;
+        if (entry.shaderType == shaderType && entry.spec == spec &&
+            memcmp(&entry.resources, &resources, sizeof(resources)) == 0)
+        {
+            std::shared_ptr<const BuiltInVariables> found = *iter;
+            mEntries.erase(iter);
+            mEntries.push_back(found);
+            return found;
+        }
+    }
+
+    auto created        = std::make_shared<BuiltInVariables>();
+    created->shaderType = shaderType;
+    created->spec       = spec;
+    created->resources  = resources;
+
+    created->allocator.push();
+    angle::PoolAllocator *compilerAllocator = GetGlobalPoolAllocator();
+    SetGlobalPoolAllocator(&created->allocator);
+    {
+        TSymbolTable symbolTable;
+        symbolTable.initializeBuiltInVariables(shaderType, spec, resources);
+        created->symbols = static_cast<const TSymbolTableBase &>(symbolTable);
+    }
+
+    // Compute the lazily calculated properties of the built-in types now, so they are never
+    // written after the variables are shared.
+    created->symbols.forEachSymbol(ComputeLazySymbolProperties);
+
+    SetGlobalPoolAllocator(compilerAllocator);
+
+    if (mEntries.size() >= kMaxEntries)
+    {
+        mEntries.erase(mEntries.begin());
+    }
+    mEntries.push_back(created);
+    return created;
+}
+
+void TSymbolTable::BuiltInVariableCache::clear()
+{
+    std::lock_guard<angle::SimpleMutex> lock(mMutex);
+    mEntries.clear();
+}
+
+// static
+std::shared_ptr<const TSymbolTable::BuiltInVariables> TSymbolTable::GetBuiltInVariables(
+    sh::GLenum shaderType,
+    ShShaderSpec spec,
+    const ShBuiltInResources &resources)
+{
+    return BuiltInVariableCache::Get().getOrCreate(shaderType, spec, resources);
+}
+
+// static
+void TSymbolTable::ReleaseBuiltInVariableCache()
+{
+    BuiltInVariableCache::Get().clear();
+}
+
 void TSymbolTable::initializeBuiltIns(sh::GLenum type,
                                       ShShaderSpec spec,
                                       const ShBuiltInResources &resources)
@@ -417,7 +620,8 @@ void TSymbolTable::initializeBuiltIns(sh::GLenum type,
 
     setDefaultPrecision(EbtAtomicCounter, EbpHigh);
 
-    initializeBuiltInVariables(type, spec, resources);
+    mBuiltInVariables = GetBuiltInVariables(type, spec, resources);
+    static_cast<TSymbolTableBase &>(*this) = mBuiltInVariables->symbols;
     mUniqueIdCounter = kFirstUserDefinedSymbolId;
 }
 
@@ -270,6 +270,28 @@ class TSymbolTable : angle::NonCopyable, TSymbolTableBase
 
     const TSymbolUniqueId nextUniqueId() { return TSymbolUniqueId(this); }
 
+    // Reserves |count| consecutive unique ids, which can later be handed out through a
+    // ScopedUniqueIdRange.  Returns false if the id space is exhausted.
+    [[nodiscard]] bool reserveUniqueIdRange(int count, int *firstIdOut);
+
+    // While in scope, symbols created on the current thread take their unique ids from the given
+    // reserved range instead of the shared counter.  This lets transformations that run
+    // concurrently on different functions create symbols without synchronization, and keeps the
+    // ids independent of how the work was scheduled.
+    class [[nodiscard]] ScopedUniqueIdRange : angle::NonCopyable
+    {
+      public:
+        ScopedUniqueIdRange(int firstId, int count);
+        ~ScopedUniqueIdRange();
+
+      private:
+        friend class TSymbolTable;
+
+        int mNextId;
+        int mEndId;
+        ScopedUniqueIdRange *mPrevious;
+    };
+
     // Gets the built-in accessible by a shader with the specified version, if any.
     bool isUnmangledBuiltInName(const ImmutableString &name,
                                 int shaderVersion,
@@ -280,6 +302,9 @@ class TSymbolTable : angle::NonCopyable, TSymbolTableBase
                             const ShBuiltInResources &resources);
     void clearCompilationResults();
 
+    // Frees the cached built-in variables that are not used by any symbol table.
+    static void ReleaseBuiltInVariableCache();
+
     ShShaderSpec getShaderSpec() const { return mShaderSpec; }
 
   private:
@@ -296,9 +321,16 @@ class TSymbolTable : angle::NonCopyable, TSymbolTableBase
     int nextUniqueIdValue();
 
     class TSymbolTableLevel;
+    struct BuiltInVariables;
+    class BuiltInVariableCache;
 
     void initSamplerDefaultPrecision(TBasicType samplerType);
 
+    static std::shared_ptr<const BuiltInVariables> GetBuiltInVariables(
+        sh::GLenum shaderType,
+        ShShaderSpec spec,
+        const ShBuiltInResources &resources);
+
     void initializeBuiltInVariables(sh::GLenum shaderType,
                                     ShShaderSpec spec,
                                     const ShBuiltInResources &resources);
@@ -322,6 +354,10 @@ class TSymbolTable : angle::NonCopyable, TSymbolTableBase
     ShShaderSpec mShaderSpec;
     ShBuiltInResources mResources;
 
+    // Owns the built-in variables that depend on the resources, which are shared with other symbol
+    // tables initialized with the same parameters.
+    std::shared_ptr<const BuiltInVariables> mBuiltInVariables;
+
     // Indexed by unique id. Map instead of vector since the variables are fairly sparse.
     std::map<int, VariableMetadata> mVariableMetadata;
 
@@ -331,6 +367,11 @@ class TSymbolTable : angle::NonCopyable, TSymbolTableBase
     friend struct SymbolIdChecker;
 };
 
+// Computes the properties of the symbol's types that are otherwise calculated and cached on first
+// query, such as mangled names and object sizes.  Types that are shared between threads must have
+// them computed beforehand, as the cache is written without synchronization.
+void ComputeLazySymbolProperties(const TSymbol *symbol);
+
 }  // namespace sh
 
 #endif  // COMPILER_TRANSLATOR_SYMBOLTABLE_H_
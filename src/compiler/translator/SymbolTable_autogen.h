@@ -18,7 +18,157 @@ namespace sh
 class TSymbolTableBase
 {
   public:
-    TSymbolTableBase()                                       = default;
+    TSymbolTableBase() = default;
+
+    // Calls |f| with each of the symbols below.
+    template <typename F>
+    void forEachSymbol(F &&f) const
+    {
+        f(m_gl_DepthRangeParameters);
+        f(m_gl_DepthRange);
+        f(m_gl_MaxVertexAttribs);
+        f(m_gl_MaxVertexUniformVectors);
+        f(m_gl_MaxVertexTextureImageUnits);
+        f(m_gl_MaxCombinedTextureImageUnits);
+        f(m_gl_MaxTextureImageUnits);
+        f(m_gl_MaxFragmentUniformVectors);
+        f(m_gl_MaxVaryingVectors);
+        f(m_gl_MaxDrawBuffers);
+        f(m_gl_MaxDualSourceDrawBuffersEXT);
+        f(m_gl_MaxVertexOutputVectors);
+        f(m_gl_MaxFragmentInputVectors);
+        f(m_gl_MinProgramTexelOffset);
+        f(m_gl_MaxProgramTexelOffset);
+        f(m_gl_MaxImageUnits);
+        f(m_gl_MaxVertexImageUniforms);
+        f(m_gl_MaxFragmentImageUniforms);
+        f(m_gl_MaxComputeImageUniforms);
+        f(m_gl_MaxCombinedImageUniforms);
+        f(m_gl_MaxCombinedShaderOutputResources);
+        f(m_gl_MaxComputeWorkGroupCount);
+        f(m_gl_MaxComputeWorkGroupSize);
+        f(m_gl_MaxComputeUniformComponents);
+        f(m_gl_MaxComputeTextureImageUnits);
+        f(m_gl_MaxComputeAtomicCounters);
+        f(m_gl_MaxComputeAtomicCounterBuffers);
+        f(m_gl_MaxVertexAtomicCounters);
+        f(m_gl_MaxFragmentAtomicCounters);
+        f(m_gl_MaxCombinedAtomicCounters);
+        f(m_gl_MaxAtomicCounterBindings);
+        f(m_gl_MaxVertexAtomicCounterBuffers);
+        f(m_gl_MaxFragmentAtomicCounterBuffers);
+        f(m_gl_MaxCombinedAtomicCounterBuffers);
+        f(m_gl_MaxAtomicCounterBufferSize);
+        f(m_gl_MaxGeometryInputComponents);
+        f(m_gl_MaxGeometryInputComponentsES3_2);
+        f(m_gl_MaxGeometryOutputComponents);
+        f(m_gl_MaxGeometryOutputComponentsES3_2);
+        f(m_gl_MaxGeometryImageUniforms);
+        f(m_gl_MaxGeometryImageUniformsES3_2);
+        f(m_gl_MaxGeometryTextureImageUnits);
+        f(m_gl_MaxGeometryTextureImageUnitsES3_2);
+        f(m_gl_MaxGeometryOutputVertices);
+        f(m_gl_MaxGeometryOutputVerticesES3_2);
+        f(m_gl_MaxGeometryTotalOutputComponents);
+        f(m_gl_MaxGeometryTotalOutputComponentsES3_2);
+        f(m_gl_MaxGeometryUniformComponents);
+        f(m_gl_MaxGeometryUniformComponentsES3_2);
+        f(m_gl_MaxGeometryAtomicCounters);
+        f(m_gl_MaxGeometryAtomicCountersES3_2);
+        f(m_gl_MaxGeometryAtomicCounterBuffers);
+        f(m_gl_MaxGeometryAtomicCounterBuffersES3_2);
+        f(m_gl_MaxTessControlInputComponents);
+        f(m_gl_MaxTessControlInputComponentsES3_2);
+        f(m_gl_MaxTessControlOutputComponents);
+        f(m_gl_MaxTessControlOutputComponentsES3_2);
+        f(m_gl_MaxTessControlTextureImageUnits);
+        f(m_gl_MaxTessControlTextureImageUnitsES3_2);
+        f(m_gl_MaxTessControlUniformComponents);
+        f(m_gl_MaxTessControlUniformComponentsES3_2);
+        f(m_gl_MaxTessControlTotalOutputComponents);
+        f(m_gl_MaxTessControlTotalOutputComponentsES3_2);
+        f(m_gl_MaxTessControlImageUniforms);
+        f(m_gl_MaxTessControlImageUniformsES3_2);
+        f(m_gl_MaxTessControlAtomicCounters);
+        f(m_gl_MaxTessControlAtomicCountersES3_2);
+        f(m_gl_MaxTessControlAtomicCounterBuffers);
+        f(m_gl_MaxTessControlAtomicCounterBuffersES3_2);
+        f(m_gl_MaxTessPatchComponents);
+        f(m_gl_MaxTessPatchComponentsES3_2);
+        f(m_gl_MaxPatchVertices);
+        f(m_gl_MaxPatchVerticesES3_2);
+        f(m_gl_MaxTessGenLevel);
+        f(m_gl_MaxTessGenLevelES3_2);
+        f(m_gl_MaxTessEvaluationInputComponents);
+        f(m_gl_MaxTessEvaluationInputComponentsES3_2);
+        f(m_gl_MaxTessEvaluationOutputComponents);
+        f(m_gl_MaxTessEvaluationOutputComponentsES3_2);
+        f(m_gl_MaxTessEvaluationTextureImageUnits);
+        f(m_gl_MaxTessEvaluationTextureImageUnitsES3_2);
+        f(m_gl_MaxTessEvaluationUniformComponents);
+        f(m_gl_MaxTessEvaluationUniformComponentsES3_2);
+        f(m_gl_MaxTessEvaluationImageUniforms);
+        f(m_gl_MaxTessEvaluationImageUniformsES3_2);
+        f(m_gl_MaxTessEvaluationAtomicCounters);
+        f(m_gl_MaxTessEvaluationAtomicCountersES3_2);
+        f(m_gl_MaxTessEvaluationAtomicCounterBuffers);
+        f(m_gl_MaxTessEvaluationAtomicCounterBuffersES3_2);
+        f(m_gl_MaxSamples);
+        f(m_gl_MaxSamplesES3_2);
+        f(m_gl_MaxClipDistancesAPPLE);
+        f(m_gl_MaxClipDistances);
+        f(m_gl_MaxCullDistances);
+        f(m_gl_MaxCombinedClipAndCullDistances);
+        f(m_gl_FragData);
+        f(m_gl_SecondaryFragDataEXT);
+        f(m_gl_FragDepthEXT);
+        f(m_gl_LastFragData);
+        f(m_gl_LastFragDataNV);
+        f(m_gl_SampleMaskIn);
+        f(m_gl_SampleMaskInES3_2);
+        f(m_gl_SampleMask);
+        f(m_gl_SampleMaskES3_2);
+        f(m_gl_ClipDistanceAPPLE);
+        f(m_gl_PerVertex);
+        f(m_gl_PerVertexES3_2);
+        f(m_gl_in);
+        f(m_gl_inES3_2);
+        f(m_gl_PositionGS);
+        f(m_gl_PositionGSES3_2);
+        f(m_gl_TessLevelOuterTCS);
+        f(m_gl_TessLevelOuterTCSES3_2);
+        f(m_gl_TessLevelInnerTCS);
+        f(m_gl_TessLevelInnerTCSES3_2);
+        f(m_gl_PerVertexTCS);
+        f(m_gl_PerVertexTCSES3_2);
+        f(m_gl_inTCS);
+        f(m_gl_inTCSES3_2);
+        f(m_gl_outTCS);
+        f(m_gl_outTCSES3_2);
+        f(m_gl_BoundingBoxTCS);
+        f(m_gl_BoundingBoxTCSES3_2);
+        f(m_gl_PositionTCS);
+        f(m_gl_PositionTCSES3_2);
+        f(m_gl_BoundingBoxEXTTCS);
+        f(m_gl_BoundingBoxEXTTCSES3_2);
+        f(m_gl_BoundingBoxOESTCS);
+        f(m_gl_BoundingBoxOESTCSES3_2);
+        f(m_gl_TessLevelOuterTES);
+        f(m_gl_TessLevelOuterTESES3_2);
+        f(m_gl_TessLevelInnerTES);
+        f(m_gl_TessLevelInnerTESES3_2);
+        f(m_gl_PerVertexTES);
+        f(m_gl_PerVertexTESES3_2);
+        f(m_gl_inTES);
+        f(m_gl_inTESES3_2);
+        f(m_gl_outTES);
+        f(m_gl_outTESES3_2);
+        f(m_gl_PositionTES);
+        f(m_gl_PositionTESES3_2);
+        f(m_gl_ClipDistance);
+        f(m_gl_CullDistance);
+    }
+
     TSymbol *m_gl_DepthRangeParameters                       = nullptr;
     TSymbol *m_gl_DepthRange                                 = nullptr;
     TSymbol *m_gl_MaxVertexAttribs                           = nullptr;
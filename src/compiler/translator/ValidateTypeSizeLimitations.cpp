@@ -14,6 +14,7 @@
 #include "compiler/translator/SymbolTable.h"
 #include "compiler/translator/blocklayout.h"
 #include "compiler/translator/tree_util/IntermTraverse.h"
+#include "compiler/translator/tree_util/PassManager.h"
 #include "compiler/translator/util.h"
 
 namespace sh
@@ -337,14 +338,19 @@ class ValidateTypeSizeLimitationsTraverser : public TIntermTraverser
 
 }  // namespace
 
-bool ValidateTypeSizeLimitations(TIntermNode *root,
-                                 TSymbolTable *symbolTable,
-                                 TDiagnostics *diagnostics)
+void QueueValidateTypeSizeLimitations(PassManager *passManager,
+                                      TSymbolTable *symbolTable,
+                                      TDiagnostics *diagnostics)
 {
-    ValidateTypeSizeLimitationsTraverser validate(symbolTable, diagnostics);
-    root->traverse(&validate);
-    validate.validateTotalPrivateVariableSize();
-    return diagnostics->numErrors() == 0;
+    auto validate =
+        std::make_unique<ValidateTypeSizeLimitationsTraverser>(symbolTable, diagnostics);
+    ValidateTypeSizeLimitationsTraverser *validatePtr = validate.get();
+
+    passManager->queueAnalysis({"ValidateTypeSizeLimitations", std::move(validate),
+                                AnalysisEffects::Diagnostics, [validatePtr, diagnostics]() {
+                                    validatePtr->validateTotalPrivateVariableSize();
+                                    return diagnostics->numErrors() == 0;
+                                }});
 }
 
 }  // namespace sh
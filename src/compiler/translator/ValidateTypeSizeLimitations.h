@@ -12,13 +12,14 @@
 namespace sh
 {
 
+class PassManager;
 class TDiagnostics;
 
-// Returns true if the given shader does not violate certain
+// Queues the validation in |passManager|.  Its analysis fails if the given shader violates certain
 // implementation-defined limits on the size of variables' types.
-bool ValidateTypeSizeLimitations(TIntermNode *root,
-                                 TSymbolTable *symbolTable,
-                                 TDiagnostics *diagnostics);
+void QueueValidateTypeSizeLimitations(PassManager *passManager,
+                                      TSymbolTable *symbolTable,
+                                      TDiagnostics *diagnostics);
 
 }  // namespace sh
 
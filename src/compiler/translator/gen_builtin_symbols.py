@@ -228,6 +228,14 @@ class TSymbolTableBase
 {{
   public:
     TSymbolTableBase() = default;
+
+    // Calls |f| with each of the symbols below.
+    template <typename F>
+    void forEachSymbol(F &&f) const
+    {{
+{for_each_member_variable}
+    }}
+
 {declare_member_variables}
 }};
 
@@ -1147,6 +1155,7 @@ class VariablesData:
 
         # Code for defining TVariables stored as members of TSymbolTable.
         self.declare_member_variables = []
+        self.for_each_member_variable = []
         self.init_member_variables = []
 
         # Declarations of static array sizes if any builtin TVariable is array.
@@ -1842,6 +1851,10 @@ return &k{name_with_suffix};
         variables.declare_member_variables.append(
             template_declare_member_variable.format(**template_args))
 
+        template_for_each_member_variable = 'f(m_{name_with_suffix});'
+        variables.for_each_member_variable.append(
+            template_for_each_member_variable.format(**template_args))
+
         obj = 'm_{name_with_suffix}'.format(**template_args)
 
         mangled_builtins.add_entry(essl_level, shader_type, template_args['name'], obj,
@@ -1991,6 +2004,8 @@ def generate_files(args, functions_txt_filename, variables_json_filename,
             '\n'.join(sorted(variables.get_variable_definitions)),
         'declare_member_variables':
             '\n'.join(variables.declare_member_variables),
+        'for_each_member_variable':
+            '\n'.join(variables.for_each_member_variable),
         'init_member_variables':
             '\n'.join(variables.init_member_variables),
         'mangled_names_array':
@@ -3904,8 +3904,8 @@ yy_size_t string_input(char *buf, yy_size_t max_size, yyscan_t yyscanner)
     angle::pp::Token token;
     yyget_extra(yyscanner)->getPreprocessor().lex(&token);
     yy_size_t len = token.type == angle::pp::Token::LAST ? 0 : token.text.size();
-    if (len < max_size)
-        memcpy(buf, token.text.c_str(), len);
+    if (len > 0 && len < max_size)
+        memcpy(buf, token.text.data(), len);
     yyset_column(token.location.file, yyscanner);
     yyset_lineno(token.location.line, yyscanner);
 
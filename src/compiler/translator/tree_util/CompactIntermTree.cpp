@@ -0,0 +1,175 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// CompactIntermTree.cpp:
+//     A flattened view of the AST, with the nodes in contiguous arrays linked by 32-bit indices.
+//
+
+#include "compiler/translator/tree_util/CompactIntermTree.h"
+
+#include "compiler/translator/tree_util/IntermTraverse.h"
+
+namespace sh
+{
+
+// Visits the nodes in the same order as the other passes, so that the compact tree lists them in
+// that order.
+class CompactIntermTree::Builder : public TIntermTraverser
+{
+  public:
+    Builder(CompactIntermTree *tree) : TIntermTraverser(true, false, true), mTree(tree) {}
+
+    void visitSymbol(TIntermSymbol *node) override
+    {
+        addLeaf(node, CompactNodeKind::Symbol);
+        mTree->mSymbolVariables.push_back(&node->variable());
+    }
+    void visitConstantUnion(TIntermConstantUnion *node) override
+    {
+        addLeaf(node, CompactNodeKind::ConstantUnion);
+    }
+    void visitFunctionPrototype(TIntermFunctionPrototype *node) override
+    {
+        addLeaf(node, CompactNodeKind::FunctionPrototype);
+    }
+    void visitPreprocessorDirective(TIntermPreprocessorDirective *node) override
+    {
+        addLeaf(node, CompactNodeKind::PreprocessorDirective);
+    }
+
+    bool visitSwizzle(Visit visit, TIntermSwizzle *node) override
+    {
+        return visitParent(visit, node, CompactNodeKind::Swizzle);
+    }
+    bool visitBinary(Visit visit, TIntermBinary *node) override
+    {
+        return visitParent(visit, node, CompactNodeKind::Binary, node->getOp());
+    }
+    bool visitUnary(Visit visit, TIntermUnary *node) override
+    {
+        return visitParent(visit, node, CompactNodeKind::Unary, node->getOp());
+    }
+    bool visitTernary(Visit visit, TIntermTernary *node) override
+    {
+        return visitParent(visit, node, CompactNodeKind::Ternary);
+    }
+    bool visitIfElse(Visit visit, TIntermIfElse *node) override
+    {
+        return visitParent(visit, node, CompactNodeKind::IfElse);
+    }
+    bool visitSwitch(Visit visit, TIntermSwitch *node) override
+    {
+        return visitParent(visit, node, CompactNodeKind::Switch);
+    }
+    bool visitCase(Visit visit, TIntermCase *node) override
+    {
+        return visitParent(visit, node, CompactNodeKind::Case);
+    }
+    bool visitFunctionDefinition(Visit visit, TIntermFunctionDefinition *node) override
+    {
+        return visitParent(visit, node, CompactNodeKind::FunctionDefinition);
+    }
+    bool visitAggregate(Visit visit, TIntermAggregate *node) override
+    {
+        return visitParent(visit, node, CompactNodeKind::Aggregate, node->getOp());
+    }
+    bool visitBlock(Visit visit, TIntermBlock *node) override
+    {
+        return visitParent(visit, node, CompactNodeKind::Block);
+    }
+    bool visitGlobalQualifierDeclaration(Visit visit,
+                                         TIntermGlobalQualifierDeclaration *node) override
+    {
+        return visitParent(visit, node, CompactNodeKind::GlobalQualifierDeclaration);
+    }
+    bool visitDeclaration(Visit visit, TIntermDeclaration *node) override
+    {
+        return visitParent(visit, node, CompactNodeKind::Declaration);
+    }
+    bool visitLoop(Visit visit, TIntermLoop *node) override
+    {
+        return visitParent(visit, node, CompactNodeKind::Loop);
+    }
+    bool visitBranch(Visit visit, TIntermBranch *node) override
+    {
+        return visitParent(visit, node, CompactNodeKind::Branch);
+    }
+
+  private:
+    NodeIndex addNode(TIntermNode *node, CompactNodeKind kind, TOperator op)
+    {
+        const NodeIndex index = static_cast<NodeIndex>(mTree->mNodes.size());
+        ASSERT(index != kInvalidIndex);
+
+        mTree->mNodes.push_back(node);
+        mTree->mKinds.push_back(kind);
+        mTree->mOps.push_back(op);
+        mTree->mParents.push_back(mOpenNodes.empty() ? kInvalidIndex : mOpenNodes.back());
+        mTree->mSubtreeEnds.push_back(index + 1);
+        mTree->mNodesByKind[static_cast<size_t>(kind)].push_back(index);
+        return index;
+    }
+
+    void addLeaf(TIntermNode *node, CompactNodeKind kind) { addNode(node, kind, EOpNull); }
+
+    bool visitParent(Visit visit, TIntermNode *node, CompactNodeKind kind, TOperator op = EOpNull)
+    {
+        if (visit == PreVisit)
+        {
+            mOpenNodes.push_back(addNode(node, kind, op));
+        }
+        else
+        {
+            ASSERT(visit == PostVisit && mTree->mNodes[mOpenNodes.back()] == node);
+            mTree->mSubtreeEnds[mOpenNodes.back()] = static_cast<NodeIndex>(mTree->mNodes.size());
+            mOpenNodes.pop_back();
+        }
+        return true;
+    }
+
+    CompactIntermTree *mTree;
+    // The nodes whose children are being visited.
+    std::vector<NodeIndex> mOpenNodes;
+};
+
+CompactIntermTree::CompactIntermTree() = default;
+
+CompactIntermTree::~CompactIntermTree() = default;
+
+void CompactIntermTree::build(TIntermNode *root)
+{
+    clear();
+
+    Builder builder(this);
+    root->traverse(&builder);
+}
+
+void CompactIntermTree::clear()
+{
+    mNodes.clear();
+    mKinds.clear();
+    mOps.clear();
+    mParents.clear();
+    mSubtreeEnds.clear();
+    for (std::vector<NodeIndex> &nodes : mNodesByKind)
+    {
+        nodes.clear();
+    }
+    mSymbolVariables.clear();
+}
+
+size_t CompactIntermTree::getChildCount(NodeIndex index) const
+{
+    const NodeIndex end = mSubtreeEnds[index];
+
+    size_t count = 0;
+    for (NodeIndex child = index + 1; child < end; child = mSubtreeEnds[child])
+    {
+        ++count;
+    }
+    return count;
+}
+
+}  // namespace sh
@@ -0,0 +1,120 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// CompactIntermTree.h:
+//     A flattened view of the AST.  The nodes are stored in pre-order in contiguous arrays and are
+//     linked with 32-bit indices, so analyses that walk the whole tree can do so with a linear scan
+//     instead of chasing pointers across the pool and making virtual calls for every node.
+//
+//     The compact tree refers back to the TIntermNodes it was built from, so it works alongside
+//     the existing TIntermTraverser and TIntermRebuild passes; they keep operating on the pointer
+//     tree, and the compact tree must be rebuilt after any pass that modifies the AST.
+//
+
+#ifndef COMPILER_TRANSLATOR_TREEUTIL_COMPACTINTERMTREE_H_
+#define COMPILER_TRANSLATOR_TREEUTIL_COMPACTINTERMTREE_H_
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "common/angleutils.h"
+#include "compiler/translator/Operator_autogen.h"
+
+namespace sh
+{
+
+class TIntermNode;
+class TVariable;
+
+// One value per TIntermTraverser::visit* function.
+enum class CompactNodeKind : uint8_t
+{
+    Symbol,
+    ConstantUnion,
+    FunctionPrototype,
+    PreprocessorDirective,
+    Swizzle,
+    Binary,
+    Unary,
+    Ternary,
+    IfElse,
+    Switch,
+    Case,
+    FunctionDefinition,
+    Aggregate,
+    Block,
+    GlobalQualifierDeclaration,
+    Declaration,
+    Loop,
+    Branch,
+
+    EnumCount,
+};
+
+class CompactIntermTree : angle::NonCopyable
+{
+  public:
+    using NodeIndex = uint32_t;
+
+    static constexpr NodeIndex kRootIndex    = 0;
+    static constexpr NodeIndex kInvalidIndex = 0xFFFFFFFFu;
+
+    CompactIntermTree();
+    ~CompactIntermTree();
+
+    // Flattens the tree rooted at |root|, replacing the previous contents.  The memory of the
+    // previous contents is reused.
+    void build(TIntermNode *root);
+    void clear();
+
+    size_t size() const { return mNodes.size(); }
+    bool empty() const { return mNodes.empty(); }
+
+    TIntermNode *getNode(NodeIndex index) const { return mNodes[index]; }
+    CompactNodeKind getKind(NodeIndex index) const { return mKinds[index]; }
+    // The operator of binary, unary and aggregate nodes, and EOpNull for the other nodes.
+    TOperator getOp(NodeIndex index) const { return mOps[index]; }
+
+    NodeIndex getParent(NodeIndex index) const { return mParents[index]; }
+    // The subtree of a node is the range [index, getSubtreeEnd(index)).
+    NodeIndex getSubtreeEnd(NodeIndex index) const { return mSubtreeEnds[index]; }
+    NodeIndex getFirstChild(NodeIndex index) const
+    {
+        return index + 1 < mSubtreeEnds[index] ? index + 1 : kInvalidIndex;
+    }
+    NodeIndex getNextSibling(NodeIndex index) const
+    {
+        const NodeIndex parent = mParents[index];
+        const NodeIndex next   = mSubtreeEnds[index];
+        return parent != kInvalidIndex && next < mSubtreeEnds[parent] ? next : kInvalidIndex;
+    }
+    size_t getChildCount(NodeIndex index) const;
+
+    // The nodes of a kind, in pre-order.
+    const std::vector<NodeIndex> &getNodesOfKind(CompactNodeKind kind) const
+    {
+        return mNodesByKind[static_cast<size_t>(kind)];
+    }
+    // The variables referenced by the symbol nodes, in the order of getNodesOfKind(Symbol).
+    const std::vector<const TVariable *> &getSymbolVariables() const { return mSymbolVariables; }
+
+  private:
+    class Builder;
+
+    std::vector<TIntermNode *> mNodes;
+    std::vector<CompactNodeKind> mKinds;
+    std::vector<TOperator> mOps;
+    std::vector<NodeIndex> mParents;
+    std::vector<NodeIndex> mSubtreeEnds;
+
+    std::array<std::vector<NodeIndex>, static_cast<size_t>(CompactNodeKind::EnumCount)>
+        mNodesByKind;
+    std::vector<const TVariable *> mSymbolVariables;
+};
+
+}  // namespace sh
+
+#endif  // COMPILER_TRANSLATOR_TREEUTIL_COMPACTINTERMTREE_H_
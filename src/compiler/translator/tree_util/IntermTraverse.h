@@ -134,6 +134,8 @@ class TIntermTraverser : angle::NonCopyable
     friend void TIntermSymbol::traverse(TIntermTraverser *);
     friend void TIntermConstantUnion::traverse(TIntermTraverser *);
     friend void TIntermFunctionPrototype::traverse(TIntermTraverser *);
+    // Visits the tree on behalf of other traversers, so it keeps their traversal state.
+    friend class FusedTraverser;
 
     TIntermNode *getParentNode() const
     {
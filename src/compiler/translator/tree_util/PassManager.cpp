@@ -0,0 +1,371 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PassManager.cpp: Runs the passes of a compilation, fusing the traversals of the analyses.
+//
+
+#include "compiler/translator/tree_util/PassManager.h"
+
+#include "compiler/translator/tree_util/IntermTraverse.h"
+#include "platform/PlatformMethods.h"
+
+namespace sh
+{
+namespace
+{
+constexpr char kTraceCategory[]          = "gpu.angle";
+constexpr char kFusedAnalysesEventName[] = "FusedAnalyses";
+constexpr char kTraceEventPhaseBegin     = 'B';
+constexpr char kTraceEventPhaseEnd       = 'E';
+}  // anonymous namespace
+
+// Visits the tree once on behalf of several traversers.  Every traverser sees the same sequence of
+// visits it would see if it traversed the tree by itself, including its traversal path, and
+// returning false from a visit only skips the rest of the subtree for that traverser.
+class FusedTraverser : public TIntermTraverser
+{
+  public:
+    FusedTraverser(const std::vector<TIntermTraverser *> &traversers)
+        : TIntermTraverser(true, AnyInVisit(traversers), true)
+    {
+        mTraversers.reserve(traversers.size());
+        for (TIntermTraverser *traverser : traversers)
+        {
+            mTraversers.push_back({traverser, nullptr});
+        }
+    }
+
+    void visitSymbol(TIntermSymbol *node) override { visitLeaf(node, true); }
+    void visitConstantUnion(TIntermConstantUnion *node) override { visitLeaf(node, true); }
+    void visitFunctionPrototype(TIntermFunctionPrototype *node) override
+    {
+        visitLeaf(node, true);
+    }
+    void visitPreprocessorDirective(TIntermPreprocessorDirective *node) override
+    {
+        // Preprocessor directives are not added to the traversal path.
+        visitLeaf(node, false);
+    }
+
+    bool visitSwizzle(Visit visit, TIntermSwizzle *node) override
+    {
+        return visitParent(visit, node);
+    }
+    bool visitBinary(Visit visit, TIntermBinary *node) override { return visitParent(visit, node); }
+    bool visitUnary(Visit visit, TIntermUnary *node) override { return visitParent(visit, node); }
+    bool visitTernary(Visit visit, TIntermTernary *node) override
+    {
+        return visitParent(visit, node);
+    }
+    bool visitIfElse(Visit visit, TIntermIfElse *node) override { return visitParent(visit, node); }
+    bool visitSwitch(Visit visit, TIntermSwitch *node) override { return visitParent(visit, node); }
+    bool visitCase(Visit visit, TIntermCase *node) override { return visitParent(visit, node); }
+    bool visitFunctionDefinition(Visit visit, TIntermFunctionDefinition *node) override
+    {
+        return visitParent(visit, node);
+    }
+    bool visitAggregate(Visit visit, TIntermAggregate *node) override
+    {
+        return visitParent(visit, node);
+    }
+    bool visitBlock(Visit visit, TIntermBlock *node) override { return visitParent(visit, node); }
+    bool visitGlobalQualifierDeclaration(Visit visit,
+                                         TIntermGlobalQualifierDeclaration *node) override
+    {
+        return visitParent(visit, node);
+    }
+    bool visitDeclaration(Visit visit, TIntermDeclaration *node) override
+    {
+        return visitParent(visit, node);
+    }
+    bool visitLoop(Visit visit, TIntermLoop *node) override { return visitParent(visit, node); }
+    bool visitBranch(Visit visit, TIntermBranch *node) override { return visitParent(visit, node); }
+
+  private:
+    struct FusedTraversal
+    {
+        TIntermTraverser *traverser;
+        // The node whose subtree the traverser is skipping, or nullptr if it is visiting nodes.
+        TIntermNode *skippedSubtree;
+    };
+
+    static bool AnyInVisit(const std::vector<TIntermTraverser *> &traversers)
+    {
+        for (TIntermTraverser *traverser : traversers)
+        {
+            if (traverser->inVisit)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Makes the state the traverser sees match the fused traversal.
+    void syncState(TIntermTraverser *traverser) const
+    {
+        traverser->mCurrentChildIndex = mCurrentChildIndex;
+        traverser->mInGlobalScope     = mInGlobalScope;
+    }
+
+    void visitLeaf(TIntermNode *node, bool addToPath)
+    {
+        for (FusedTraversal &traversal : mTraversers)
+        {
+            if (traversal.skippedSubtree != nullptr)
+            {
+                continue;
+            }
+
+            // Like the traversal of the leaves, this ignores the depth limit.
+            TIntermTraverser *traverser = traversal.traverser;
+            syncState(traverser);
+            if (addToPath)
+            {
+                traverser->incrementDepth(node);
+            }
+            node->visit(PreVisit, traverser);
+            if (addToPath)
+            {
+                traverser->decrementDepth();
+            }
+        }
+    }
+
+    bool visitParent(Visit visit, TIntermNode *node)
+    {
+        bool anyVisiting = false;
+
+        switch (visit)
+        {
+            case PreVisit:
+                for (FusedTraversal &traversal : mTraversers)
+                {
+                    if (traversal.skippedSubtree != nullptr)
+                    {
+                        continue;
+                    }
+
+                    TIntermTraverser *traverser = traversal.traverser;
+                    syncState(traverser);
+                    bool visitChildren = traverser->incrementDepth(node);
+                    if (visitChildren && traverser->preVisit)
+                    {
+                        visitChildren = node->visit(PreVisit, traverser);
+                    }
+
+                    if (visitChildren)
+                    {
+                        anyVisiting = true;
+                    }
+                    else
+                    {
+                        traversal.skippedSubtree = node;
+                    }
+                }
+                break;
+
+            case InVisit:
+                for (FusedTraversal &traversal : mTraversers)
+                {
+                    if (traversal.skippedSubtree != nullptr)
+                    {
+                        continue;
+                    }
+
+                    TIntermTraverser *traverser = traversal.traverser;
+                    if (traverser->inVisit)
+                    {
+                        syncState(traverser);
+                        if (!node->visit(InVisit, traverser))
+                        {
+                            traversal.skippedSubtree = node;
+                            continue;
+                        }
+                    }
+                    anyVisiting = true;
+                }
+                break;
+
+            case PostVisit:
+                for (FusedTraversal &traversal : mTraversers)
+                {
+                    TIntermTraverser *traverser = traversal.traverser;
+                    if (traversal.skippedSubtree == nullptr && traverser->postVisit)
+                    {
+                        syncState(traverser);
+                        node->visit(PostVisit, traverser);
+                    }
+                }
+                leaveNode(node);
+                return true;
+        }
+
+        // Once no traverser visits the children, the fused traversal doesn't either, and there is
+        // no post-visit for this node.
+        if (!anyVisiting)
+        {
+            leaveNode(node);
+        }
+        return anyVisiting;
+    }
+
+    // Removes |node| from the traversal path of the traversers that had entered it.
+    void leaveNode(TIntermNode *node)
+    {
+        for (FusedTraversal &traversal : mTraversers)
+        {
+            if (traversal.skippedSubtree == node)
+            {
+                traversal.skippedSubtree = nullptr;
+            }
+            else if (traversal.skippedSubtree != nullptr)
+            {
+                continue;
+            }
+            traversal.traverser->decrementDepth();
+        }
+    }
+
+    std::vector<FusedTraversal> mTraversers;
+};
+
+PassManager::ScopedTraceEvent::ScopedTraceEvent(PassManager *passManager, const char *name)
+    : mPassManager(passManager), mName(name)
+{
+    if (mPassManager->mTraceCategoryEnabled != nullptr && *mPassManager->mTraceCategoryEnabled)
+    {
+        mPassManager->addTraceEvent(kTraceEventPhaseBegin, mName);
+    }
+    else
+    {
+        mPassManager = nullptr;
+    }
+}
+
+PassManager::ScopedTraceEvent::~ScopedTraceEvent()
+{
+    if (mPassManager != nullptr)
+    {
+        mPassManager->addTraceEvent(kTraceEventPhaseEnd, mName);
+    }
+}
+
+PassManager::PassManager(TIntermBlock *root, angle::PlatformMethods *platform)
+    : mRoot(root),
+      mPlatform(platform),
+      mTraceCategoryEnabled(platform != nullptr
+                                ? platform->getTraceCategoryEnabledFlag(platform, kTraceCategory)
+                                : nullptr)
+{}
+
+PassManager::~PassManager() = default;
+
+void PassManager::queueAnalysis(Analysis &&analysis)
+{
+    ASSERT(analysis.traverser);
+    mQueuedAnalyses.push_back(std::move(analysis));
+}
+
+bool PassManager::runAnalyses()
+{
+    while (!mQueuedAnalyses.empty())
+    {
+        size_t count = 1;
+        while (count < mQueuedAnalyses.size() && !needsSeparateTraversal(count))
+        {
+            ++count;
+        }
+
+        const bool success = runFusedAnalyses(count);
+        mQueuedAnalyses.erase(mQueuedAnalyses.begin(), mQueuedAnalyses.begin() + count);
+
+        if (!success)
+        {
+            mQueuedAnalyses.clear();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool PassManager::needsSeparateTraversal(size_t index) const
+{
+    const Analysis &analysis = mQueuedAnalyses[index];
+    if (analysis.effects == AnalysisEffects::None)
+    {
+        return false;
+    }
+
+    for (size_t previous = 0; previous < index; ++previous)
+    {
+        // If the previous analysis fails, this one should not have had any effect.  Otherwise the
+        // effects would have followed whatever the previous analysis does when it finishes.
+        if (mQueuedAnalyses[previous].finish)
+        {
+            return true;
+        }
+        // Diagnostics of the two traversals would be interleaved.
+        if (analysis.effects == AnalysisEffects::Diagnostics &&
+            mQueuedAnalyses[previous].effects == AnalysisEffects::Diagnostics)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void PassManager::addTraceEvent(char phase, const char *name)
+{
+    // As with the trace events of libANGLE, events are dropped if the platform can't time them.
+    const double timestamp = mPlatform->monotonicallyIncreasingTime(mPlatform);
+    if (timestamp != 0)
+    {
+        mPlatform->addTraceEvent(mPlatform, phase, mTraceCategoryEnabled, name, 0, timestamp, 0,
+                                 nullptr, nullptr, nullptr, 0);
+    }
+}
+
+bool PassManager::runFusedAnalyses(size_t count)
+{
+    if (count == 1)
+    {
+        Analysis &analysis = mQueuedAnalyses.front();
+
+        ScopedTraceEvent traceEvent(this, analysis.name);
+        mRoot->traverse(analysis.traverser.get());
+        return !analysis.finish || analysis.finish();
+    }
+
+    {
+        std::vector<TIntermTraverser *> traversers;
+        traversers.reserve(count);
+        for (size_t index = 0; index < count; ++index)
+        {
+            traversers.push_back(mQueuedAnalyses[index].traverser.get());
+        }
+
+        ScopedTraceEvent traceEvent(this, kFusedAnalysesEventName);
+        FusedTraverser fusedTraverser(traversers);
+        mRoot->traverse(&fusedTraverser);
+    }
+
+    for (size_t index = 0; index < count; ++index)
+    {
+        Analysis &analysis = mQueuedAnalyses[index];
+
+        ScopedTraceEvent traceEvent(this, analysis.name);
+        if (analysis.finish && !analysis.finish())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}  // namespace sh
@@ -0,0 +1,117 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PassManager.h: Runs the passes of a compilation, reporting the time spent in each through trace
+// events.  Analyses, which only read the tree, are queued so that consecutive ones share a single
+// traversal of the tree.
+//
+
+#ifndef COMPILER_TRANSLATOR_TREEUTIL_PASSMANAGER_H_
+#define COMPILER_TRANSLATOR_TREEUTIL_PASSMANAGER_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "common/angleutils.h"
+
+namespace angle
+{
+struct PlatformMethods;
+}  // namespace angle
+
+namespace sh
+{
+class TIntermBlock;
+class TIntermTraverser;
+
+// What the traverser of an analysis affects during the traversal, other than its own state.  This
+// decides which analyses can share a traversal while producing the same results as if they were
+// run one after the other.
+enum class AnalysisEffects
+{
+    // The traverser only gathers information in itself.
+    None,
+    // The traverser reports diagnostics.
+    Diagnostics,
+    // The traverser records its results in the compiler, or marks the nodes it visits.  Every
+    // analysis is assumed to record its results in different places.
+    Results,
+};
+
+struct Analysis
+{
+    // The name of the trace event.  Must have static storage duration.
+    const char *name;
+
+    // Gathers information from the tree.  It must not modify the tree, override the traverse*()
+    // functions or query the parent block, as it may be visiting the nodes along with other
+    // traversers.
+    std::unique_ptr<TIntermTraverser> traverser;
+    AnalysisEffects effects;
+
+    // Called once the tree is traversed.  Returns false if compilation should fail.  Analyses
+    // without this step can't fail.
+    std::function<bool()> finish;
+};
+
+class PassManager : angle::NonCopyable
+{
+  public:
+    // Trace events are only emitted if |platform| is not null.
+    PassManager(TIntermBlock *root, angle::PlatformMethods *platform);
+    ~PassManager();
+
+    // Runs |pass| by itself, after the queued analyses.  Returns false if either the analyses or
+    // the pass fail.
+    template <typename Pass>
+    [[nodiscard]] bool runPass(const char *name, Pass &&pass)
+    {
+        if (!runAnalyses())
+        {
+            return false;
+        }
+
+        ScopedTraceEvent traceEvent(this, name);
+        return pass();
+    }
+
+    // Queues an analysis.  The traversers of the queued analyses visit the tree together, and the
+    // finish steps are then called in the order the analyses are queued.  If an analysis fails, the
+    // later ones don't finish, and don't start if they have effects during the traversal.
+    void queueAnalysis(Analysis &&analysis);
+
+    // Runs the queued analyses.  Must be called before anything depending on their results.
+    [[nodiscard]] bool runAnalyses();
+
+  private:
+    class ScopedTraceEvent : angle::NonCopyable
+    {
+      public:
+        ScopedTraceEvent(PassManager *passManager, const char *name);
+        ~ScopedTraceEvent();
+
+      private:
+        PassManager *mPassManager;
+        const char *mName;
+    };
+
+    // Whether the analysis at |index| in the queue can't be run in the same traversal as the
+    // analyses queued before it.
+    bool needsSeparateTraversal(size_t index) const;
+    // Runs the first |count| queued analyses in one traversal.
+    bool runFusedAnalyses(size_t count);
+    void addTraceEvent(char phase, const char *name);
+
+    TIntermBlock *mRoot;
+    angle::PlatformMethods *mPlatform;
+    const unsigned char *mTraceCategoryEnabled;
+
+    std::vector<Analysis> mQueuedAnalyses;
+};
+
+}  // namespace sh
+
+#endif  // COMPILER_TRANSLATOR_TREEUTIL_PASSMANAGER_H_
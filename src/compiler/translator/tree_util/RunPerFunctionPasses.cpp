@@ -0,0 +1,228 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// RunPerFunctionPasses.cpp: Runs a transformation on function bodies in parallel.
+//
+
+#include "compiler/translator/tree_util/RunPerFunctionPasses.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+#include "common/PoolAlloc.h"
+#include "common/WorkerThread.h"
+#include "compiler/translator/Compiler.h"
+#include "compiler/translator/IntermNode.h"
+#include "compiler/translator/PoolAlloc.h"
+#include "compiler/translator/SymbolTable.h"
+
+namespace sh
+{
+namespace
+{
+// The number of unique ids reserved for the symbols each function body may create.  Passes
+// typically only create a handful of temporaries per function, so this is never expected to run
+// out.
+constexpr int kUniqueIdsPerFunction = 1 << 16;
+
+// State shared between the compiling thread and the worker tasks.  Tasks may start running after
+// all the work has been claimed (and even after the compilation has finished), in which case they
+// only touch this object, which they keep alive.
+struct PerFunctionPassState : angle::NonCopyable
+{
+    PerFunctionPassState(std::vector<TIntermBlock *> &&bodiesIn,
+                         int firstUniqueIdIn,
+                         const PerFunctionPass &passIn)
+        : bodies(std::move(bodiesIn)), firstUniqueId(firstUniqueIdIn), pass(passIn)
+    {}
+
+    const std::vector<TIntermBlock *> bodies;
+    const int firstUniqueId;
+    const PerFunctionPass pass;
+
+    // The index of the next body to transform.
+    std::atomic<size_t> nextBody{0};
+
+    // Protects the following fields.
+    std::mutex mutex;
+    std::condition_variable doneCondition;
+    size_t doneCount = 0;
+    bool failed      = false;
+    std::vector<std::unique_ptr<angle::PoolAllocator>> allocators;
+};
+
+// Claims and transforms function bodies until there are none left.  On worker threads, nodes are
+// allocated from a pool allocator created for this call, since the compiler's allocator is not
+// thread-safe.
+void ProcessFunctionBodies(PerFunctionPassState *state, bool onWorkerThread)
+{
+    angle::PoolAllocator *previousAllocator = nullptr;
+    angle::PoolAllocator *allocator         = nullptr;
+
+    size_t index;
+    while ((index = state->nextBody.fetch_add(1, std::memory_order_relaxed)) <
+           state->bodies.size())
+    {
+        if (onWorkerThread && allocator == nullptr)
+        {
+            std::unique_ptr<angle::PoolAllocator> newAllocator =
+                std::make_unique<angle::PoolAllocator>();
+            newAllocator->push();
+            allocator = newAllocator.get();
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->allocators.push_back(std::move(newAllocator));
+            }
+
+            previousAllocator = GetGlobalPoolAllocator();
+            SetGlobalPoolAllocator(allocator);
+        }
+
+        bool result = false;
+        {
+            TSymbolTable::ScopedUniqueIdRange idRange(
+                state->firstUniqueId + static_cast<int>(index) * kUniqueIdsPerFunction,
+                kUniqueIdsPerFunction);
+            result = state->pass(state->bodies[index]);
+        }
+
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->failed = state->failed || !result;
+        if (++state->doneCount == state->bodies.size())
+        {
+            state->doneCondition.notify_all();
+        }
+    }
+
+    if (allocator != nullptr)
+    {
+        SetGlobalPoolAllocator(previousAllocator);
+    }
+}
+
+// Computes the lazily calculated properties of the types that are shared between function bodies,
+// i.e. those of the global variables, struct and interface block declarations and functions, so
+// that passes running concurrently never write them.
+void ComputeSharedLazyProperties(TIntermBlock *root)
+{
+    for (TIntermNode *node : *root->getSequence())
+    {
+        if (TIntermFunctionDefinition *functionDefinition = node->getAsFunctionDefinition())
+        {
+            ComputeLazySymbolProperties(functionDefinition->getFunction());
+        }
+        else if (TIntermFunctionPrototype *prototype = node->getAsFunctionPrototypeNode())
+        {
+            ComputeLazySymbolProperties(prototype->getFunction());
+        }
+        else if (TIntermGlobalQualifierDeclaration *qualifierDeclaration =
+                     node->getAsGlobalQualifierDeclarationNode())
+        {
+            ComputeLazySymbolProperties(&qualifierDeclaration->getSymbol()->variable());
+        }
+        else if (TIntermDeclaration *declaration = node->getAsDeclarationNode())
+        {
+            for (TIntermNode *declarator : *declaration->getSequence())
+            {
+                TIntermSymbol *symbol = declarator->getAsSymbolNode();
+                if (symbol == nullptr)
+                {
+                    TIntermBinary *initialization = declarator->getAsBinaryNode();
+                    ASSERT(initialization != nullptr);
+                    symbol = initialization->getLeft()->getAsSymbolNode();
+                }
+                ASSERT(symbol != nullptr);
+                ComputeLazySymbolProperties(&symbol->variable());
+            }
+        }
+    }
+}
+
+class PerFunctionPassTask final : public angle::Closure
+{
+  public:
+    PerFunctionPassTask(const std::shared_ptr<PerFunctionPassState> &state) : mState(state) {}
+
+    void operator()() override { ProcessFunctionBodies(mState.get(), true); }
+
+  private:
+    std::shared_ptr<PerFunctionPassState> mState;
+};
+}  // anonymous namespace
+
+bool RunPerFunctionPasses(TCompiler *compiler,
+                          TIntermBlock *root,
+                          TSymbolTable *symbolTable,
+                          angle::WorkerThreadPool *workerPool,
+                          const PerFunctionPass &pass,
+                          std::vector<std::unique_ptr<angle::PoolAllocator>> *workerAllocatorsOut)
+{
+    std::vector<TIntermBlock *> bodies;
+    if (workerPool != nullptr && workerPool->isAsync())
+    {
+        for (TIntermNode *node : *root->getSequence())
+        {
+            TIntermFunctionDefinition *functionDefinition = node->getAsFunctionDefinition();
+            if (functionDefinition != nullptr)
+            {
+                bodies.push_back(functionDefinition->getBody());
+            }
+        }
+    }
+
+    // Not worth distributing a single function.
+    constexpr size_t kMaxFunctionCount =
+        static_cast<size_t>(std::numeric_limits<int>::max() / kUniqueIdsPerFunction);
+    int firstUniqueId = 0;
+    if (bodies.size() < 2 || bodies.size() > kMaxFunctionCount ||
+        !symbolTable->reserveUniqueIdRange(static_cast<int>(bodies.size()) * kUniqueIdsPerFunction,
+                                           &firstUniqueId))
+    {
+        return pass(root);
+    }
+
+    ComputeSharedLazyProperties(root);
+
+    auto state = std::make_shared<PerFunctionPassState>(std::move(bodies), firstUniqueId, pass);
+    const size_t bodyCount = state->bodies.size();
+
+    // The pass validates the function bodies it transforms, which would fail as they are not
+    // complete shaders.  The whole tree is validated once all functions are done instead.
+    bool wasValidationEnabled = compiler->disableValidateAST();
+
+    // The compiling thread takes part in the work as well, so that progress is made even if all
+    // the pool's threads are busy.  For the same reason, the tasks' own events are not waited on;
+    // only the completion of every function body is.
+    size_t taskCount = std::min<size_t>(bodyCount - 1, std::thread::hardware_concurrency());
+    for (size_t taskIndex = 0; taskIndex < taskCount; ++taskIndex)
+    {
+        workerPool->postWorkerTask(std::make_shared<PerFunctionPassTask>(state));
+    }
+    ProcessFunctionBodies(state.get(), false);
+
+    bool failed = false;
+    {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->doneCondition.wait(lock,
+                                  [&state, bodyCount] { return state->doneCount == bodyCount; });
+        failed = state->failed;
+
+        for (std::unique_ptr<angle::PoolAllocator> &allocator : state->allocators)
+        {
+            workerAllocatorsOut->push_back(std::move(allocator));
+        }
+        state->allocators.clear();
+    }
+
+    compiler->restoreValidateAST(wasValidationEnabled);
+
+    return !failed && compiler->validateAST(root);
+}
+
+}  // namespace sh
@@ -0,0 +1,57 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// RunPerFunctionPasses.h: Runs a transformation that only affects function bodies on every
+// function of the shader, distributing the functions among the threads of a worker pool.
+//
+
+#ifndef COMPILER_TRANSLATOR_TREEUTIL_RUNPERFUNCTIONPASSES_H_
+#define COMPILER_TRANSLATOR_TREEUTIL_RUNPERFUNCTIONPASSES_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "common/angleutils.h"
+
+namespace angle
+{
+class PoolAllocator;
+class WorkerThreadPool;
+}  // namespace angle
+
+namespace sh
+{
+class TCompiler;
+class TIntermBlock;
+class TSymbolTable;
+
+// A transformation that is applied to either the whole tree or a single function body.  When run
+// per function, it may only modify nodes inside the body it is given, must not generate
+// diagnostics and must not modify the compiler or symbol table beyond creating new symbols.
+//
+// The types of global variables, structs, interface blocks and functions are shared between the
+// bodies.  Their lazily cached properties (such as mangled names and object sizes) are computed
+// before the bodies are distributed, so the pass may query them, but it must not otherwise modify
+// these types or the symbols that hold them.
+using PerFunctionPass = std::function<bool(TIntermBlock *root)>;
+
+// Runs |pass| on the body of every function definition in |root|.  If |workerPool| is
+// asynchronous and there are enough functions, the bodies are transformed concurrently; otherwise
+// |pass| is simply run on |root|.
+//
+// Symbols created by the pass take their unique ids from a range reserved per function, so the
+// result does not depend on scheduling.  Nodes created on worker threads are allocated from pool
+// allocators that are appended to |workerAllocatorsOut|, which must outlive the tree.
+[[nodiscard]] bool RunPerFunctionPasses(
+    TCompiler *compiler,
+    TIntermBlock *root,
+    TSymbolTable *symbolTable,
+    angle::WorkerThreadPool *workerPool,
+    const PerFunctionPass &pass,
+    std::vector<std::unique_ptr<angle::PoolAllocator>> *workerAllocatorsOut);
+}  // namespace sh
+
+#endif  // COMPILER_TRANSLATOR_TREEUTIL_RUNPERFUNCTIONPASSES_H_
@@ -7,9 +7,11 @@
 
 #include <gmock/gmock.h>
 #include <vector>
+#include "common/WorkerThread.h"
 #include "common/debug.h"
 #include "common/mathutil.h"
 #include "image_util/loadimage.h"
+#include "image_util/loadimage_simd.h"
 
 using namespace angle;
 using namespace testing;
@@ -500,4 +502,247 @@ TEST(LoadToNative3To4, LoadByteRGBToRGBAWithUnalignedWidthAndAlignment4)
         TestLoadByteRGBToRGBAForAllCases(context, alignment, 5, 5, 1, 0, 0, alignment);
     }
 }
-}  // namespace
\ No newline at end of file
+
+// Checks that the row function selected for this CPU matches the reference implementation for all
+// widths around the vector sizes, with every combination of source and destination misalignment.
+void TestLoadRowFunctionMatchesScalar(priv::LoadRowFunction loadRow,
+                                      priv::LoadRowFunction scalarLoadRow,
+                                      size_t inputPixelBytes,
+                                      size_t outputPixelBytes)
+{
+    constexpr size_t kMaxWidth  = 70;
+    constexpr size_t kMaxOffset = 3;
+
+    std::vector<uint8_t> input(kMaxWidth * inputPixelBytes + kMaxOffset);
+    for (size_t i = 0; i < input.size(); i++)
+    {
+        input[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+
+    for (size_t width = 0; width <= kMaxWidth; width++)
+    {
+        for (size_t inputOffset = 0; inputOffset <= kMaxOffset; inputOffset++)
+        {
+            for (size_t outputOffset = 0; outputOffset <= kMaxOffset; outputOffset++)
+            {
+                // Fill the outputs with a pattern, so writes past the end of the row are caught.
+                std::vector<uint8_t> expected(kMaxWidth * outputPixelBytes + 2 * kMaxOffset, 0xCD);
+                std::vector<uint8_t> actual(expected);
+
+                scalarLoadRow(input.data() + inputOffset, expected.data() + outputOffset, width);
+                loadRow(input.data() + inputOffset, actual.data() + outputOffset, width);
+
+                ASSERT_EQ(expected, actual) << "width: " << width << ", input offset: "
+                                            << inputOffset << ", output offset: " << outputOffset;
+            }
+        }
+    }
+}
+
+// Tests that the vectorized A8 to RGBA8 row conversion matches the scalar one.
+TEST(LoadToNativeSIMD, A8ToRGBA8)
+{
+    TestLoadRowFunctionMatchesScalar(priv::GetLoadRowFunctions().a8ToRGBA8,
+                                     priv::GetScalarLoadRowFunctions().a8ToRGBA8, 1, 4);
+}
+
+// Tests that the vectorized L8 to RGBA8 row conversion matches the scalar one.
+TEST(LoadToNativeSIMD, L8ToRGBA8)
+{
+    TestLoadRowFunctionMatchesScalar(priv::GetLoadRowFunctions().l8ToRGBA8,
+                                     priv::GetScalarLoadRowFunctions().l8ToRGBA8, 1, 4);
+}
+
+// Tests that the vectorized LA8 to RGBA8 row conversion matches the scalar one.
+TEST(LoadToNativeSIMD, LA8ToRGBA8)
+{
+    TestLoadRowFunctionMatchesScalar(priv::GetLoadRowFunctions().la8ToRGBA8,
+                                     priv::GetScalarLoadRowFunctions().la8ToRGBA8, 2, 4);
+}
+
+// Tests that the vectorized RGB8 to RGBA8 row conversion matches the scalar one.
+TEST(LoadToNativeSIMD, RGB8ToRGBA8)
+{
+    TestLoadRowFunctionMatchesScalar(priv::GetLoadRowFunctions().rgb8ToRGBA8,
+                                     priv::GetScalarLoadRowFunctions().rgb8ToRGBA8, 3, 4);
+}
+
+// Tests that the vectorized RGB8 to BGRX8 row conversion matches the scalar one.
+TEST(LoadToNativeSIMD, RGB8ToBGRX8)
+{
+    TestLoadRowFunctionMatchesScalar(priv::GetLoadRowFunctions().rgb8ToBGRX8,
+                                     priv::GetScalarLoadRowFunctions().rgb8ToBGRX8, 3, 4);
+}
+
+// Tests that the vectorized RGBA8 to BGRA8 row conversion matches the scalar one.
+TEST(LoadToNativeSIMD, RGBA8ToBGRA8)
+{
+    TestLoadRowFunctionMatchesScalar(priv::GetLoadRowFunctions().rgba8ToBGRA8,
+                                     priv::GetScalarLoadRowFunctions().rgba8ToBGRA8, 4, 4);
+}
+
+// Tests that loading an image with padded rows and slices gives the same result as loading each
+// row separately, and leaves the padding untouched.
+TEST(LoadToNativeSIMD, LoadRowsWithPadding)
+{
+    constexpr size_t kWidth            = 19;
+    constexpr size_t kHeight           = 5;
+    constexpr size_t kDepth            = 3;
+    constexpr size_t kInputRowPitch    = kWidth * 3 + 5;
+    constexpr size_t kInputDepthPitch  = kInputRowPitch * kHeight + 7;
+    constexpr size_t kOutputRowPitch   = kWidth * 4 + 12;
+    constexpr size_t kOutputDepthPitch = kOutputRowPitch * kHeight + 8;
+
+    std::vector<uint8_t> input(kInputDepthPitch * kDepth);
+    for (size_t i = 0; i < input.size(); i++)
+    {
+        input[i] = static_cast<uint8_t>(i * 13 + 5);
+    }
+
+    ImageLoadContext context;
+    std::vector<uint8_t> actual(kOutputDepthPitch * kDepth, 0xCD);
+    LoadRGB8ToRGBA8(context, kWidth, kHeight, kDepth, input.data(), kInputRowPitch,
+                    kInputDepthPitch, actual.data(), kOutputRowPitch, kOutputDepthPitch);
+
+    std::vector<uint8_t> expected(kOutputDepthPitch * kDepth, 0xCD);
+    for (size_t z = 0; z < kDepth; z++)
+    {
+        for (size_t y = 0; y < kHeight; y++)
+        {
+            priv::GetScalarLoadRowFunctions().rgb8ToRGBA8(
+                input.data() + z * kInputDepthPitch + y * kInputRowPitch,
+                expected.data() + z * kOutputDepthPitch + y * kOutputRowPitch, kWidth);
+        }
+    }
+
+    EXPECT_EQ(expected, actual);
+}
+
+// Checks that loading an image with a multi-threaded pool gives the same result as loading it on
+// the calling thread.
+void TestLoadImageInStripes(priv::LoadImageFunction loadFunction,
+                            size_t inputPixelBytes,
+                            size_t outputPixelBytes,
+                            size_t width,
+                            size_t height,
+                            size_t depth)
+{
+    // Pad the rows and slices so stripes that use the wrong pitch are caught.
+    const size_t inputRowPitch    = width * inputPixelBytes + 4;
+    const size_t inputDepthPitch  = inputRowPitch * height + 8;
+    const size_t outputRowPitch   = width * outputPixelBytes + 4;
+    const size_t outputDepthPitch = outputRowPitch * height + 8;
+
+    std::vector<uint8_t> input(inputDepthPitch * depth);
+    for (size_t i = 0; i < input.size(); i++)
+    {
+        input[i] = static_cast<uint8_t>(i * 7 + i / 251);
+    }
+
+    ImageLoadContext serialContext;
+    std::vector<uint8_t> expected(outputDepthPitch * depth, 0xCD);
+    loadFunction(serialContext, width, height, depth, input.data(), inputRowPitch, inputDepthPitch,
+                 expected.data(), outputRowPitch, outputDepthPitch);
+
+    ImageLoadContext parallelContext;
+    parallelContext.singleThreadPool = WorkerThreadPool::Create(1, ANGLEPlatformCurrent());
+    parallelContext.multiThreadPool  = WorkerThreadPool::Create(0, ANGLEPlatformCurrent());
+    std::vector<uint8_t> actual(outputDepthPitch * depth, 0xCD);
+    loadFunction(parallelContext, width, height, depth, input.data(), inputRowPitch,
+                 inputDepthPitch, actual.data(), outputRowPitch, outputDepthPitch);
+
+    EXPECT_EQ(expected, actual);
+}
+
+// Tests that large 2D images converted in parallel stripes of rows match the serial conversion.
+TEST(LoadToNativeParallel, Rows)
+{
+    TestLoadImageInStripes(LoadRGB8ToRGBA8, 3, 4, 1537, 1031, 1);
+    TestLoadImageInStripes(LoadToNative3To4<uint8_t, 0x01>, 3, 4, 1537, 1031, 1);
+    TestLoadImageInStripes(LoadL8ToRGBA8, 1, 4, 2048, 1024, 1);
+    TestLoadImageInStripes(LoadRGB16FToRG11B10F, 6, 4, 1024, 1025, 1);
+}
+
+// Tests that large 3D images converted in parallel stripes of slices match the serial conversion.
+TEST(LoadToNativeParallel, Slices)
+{
+    TestLoadImageInStripes(LoadRGB8ToRGBA8, 3, 4, 257, 255, 19);
+    TestLoadImageInStripes(Load32FTo16F<4>, 16, 8, 256, 256, 17);
+}
+
+// Checks that splitting an image in a given number of stripes, converted on a pool with a given
+// number of threads, gives the same result as loading it on the calling thread.  Unlike
+// TestLoadImageInStripes(), this splits the image even on machines with few CPUs.
+void TestLoadImageInStripeCount(priv::LoadImageFunction loadFunction,
+                                size_t inputPixelBytes,
+                                size_t outputPixelBytes,
+                                size_t width,
+                                size_t height,
+                                size_t depth)
+{
+    const size_t inputRowPitch    = width * inputPixelBytes + 4;
+    const size_t inputDepthPitch  = inputRowPitch * height + 8;
+    const size_t outputRowPitch   = width * outputPixelBytes + 4;
+    const size_t outputDepthPitch = outputRowPitch * height + 8;
+
+    std::vector<uint8_t> input(inputDepthPitch * depth);
+    for (size_t i = 0; i < input.size(); i++)
+    {
+        input[i] = static_cast<uint8_t>(i * 13 + i / 241);
+    }
+
+    ImageLoadContext serialContext;
+    std::vector<uint8_t> expected(outputDepthPitch * depth, 0xCD);
+    loadFunction(serialContext, width, height, depth, input.data(), inputRowPitch, inputDepthPitch,
+                 expected.data(), outputRowPitch, outputDepthPitch);
+
+    ImageLoadContext parallelContext;
+    parallelContext.multiThreadPool = WorkerThreadPool::Create(4, ANGLEPlatformCurrent());
+    const bool isAsync              = parallelContext.multiThreadPool->isAsync();
+
+    for (size_t stripeCount : {2, 3, 4, 7, 16})
+    {
+        std::vector<uint8_t> actual(outputDepthPitch * depth, 0xCD);
+        const bool split = priv::LoadImageInStripeCount(
+            parallelContext, loadFunction, stripeCount, width, height, depth, input.data(),
+            inputRowPitch, inputDepthPitch, actual.data(), outputRowPitch, outputDepthPitch);
+
+        // Pools are synchronous in builds without threads, in which case the caller converts.
+        EXPECT_EQ(isAsync, split) << "stripe count " << stripeCount;
+        if (split)
+        {
+            EXPECT_EQ(expected, actual) << "stripe count " << stripeCount;
+        }
+    }
+}
+
+// Tests that 2D images split in a given number of stripes of rows on a 4-thread pool match the
+// serial conversion, including when the rows don't divide evenly between the stripes.
+TEST(LoadToNativeParallel, ExplicitStripeCountRows)
+{
+    TestLoadImageInStripeCount(LoadRGB8ToRGBA8, 3, 4, 67, 45, 1);
+    TestLoadImageInStripeCount(LoadA16FToRGBA16F, 2, 8, 31, 17, 1);
+    TestLoadImageInStripeCount(LoadRGB16FToRGB9E5, 6, 4, 29, 23, 1);
+}
+
+// Tests that 3D images split in a given number of stripes of slices on a 4-thread pool match the
+// serial conversion.
+TEST(LoadToNativeParallel, ExplicitStripeCountSlices)
+{
+    TestLoadImageInStripeCount(LoadRGBA8ToBGRA8, 4, 4, 33, 9, 11);
+    TestLoadImageInStripeCount(Load32FTo16F<3>, 12, 6, 19, 7, 5);
+}
+
+// Tests that small images are left to the caller.
+TEST(LoadToNativeParallel, SmallImageNotSplit)
+{
+    ImageLoadContext context;
+    context.multiThreadPool = WorkerThreadPool::Create(0, ANGLEPlatformCurrent());
+
+    std::vector<uint8_t> input(64 * 64 * 3);
+    std::vector<uint8_t> output(64 * 64 * 4);
+    EXPECT_FALSE(priv::LoadImageInStripes(context, LoadRGB8ToRGBA8, 64, 64, 1, input.data(),
+                                          64 * 3, 64 * 64 * 3, output.data(), 64 * 4,
+                                          64 * 64 * 4));
+}
+}  // namespace
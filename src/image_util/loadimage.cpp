@@ -8,47 +8,15 @@
 
 #include "image_util/loadimage.h"
 
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "common/WorkerThread.h"
 #include "common/mathutil.h"
 #include "common/platform.h"
 #include "image_util/imageformats.h"
-
-#if defined(ANGLE_PLATFORM_WINDOWS) && !defined(_M_ARM) && !defined(_M_ARM64)
-#    if defined(_MSC_VER)
-#        include <intrin.h>
-#        define ANGLE_LOADIMAGE_USE_SSE
-#    elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
-#        include <x86intrin.h>
-#        if __SSE__
-#            define ANGLE_LOADIMAGE_USE_SSE
-#        endif
-#    endif
-#endif
-
-#if defined(ANGLE_LOADIMAGE_USE_SSE)
-inline bool supportsSSE2()
-{
-    static bool checked  = false;
-    static bool supports = false;
-
-    if (checked)
-    {
-        return supports;
-    }
-
-    int info[4];
-    __cpuid(info, 0);
-
-    if (info[0] >= 1)
-    {
-        __cpuid(info, 1);
-
-        supports = (info[3] >> 26) & 1;
-    }
-
-    checked = true;
-    return supports;
-}
-#endif
+#include "image_util/loadimage_simd.h"
 
 namespace angle
 {
@@ -56,7 +24,23 @@ ImageLoadContext::ImageLoadContext()                              = default;
 ImageLoadContext::~ImageLoadContext()                             = default;
 ImageLoadContext::ImageLoadContext(const ImageLoadContext &other) = default;
 
-void LoadA8ToRGBA8(const ImageLoadContext &context,
+namespace
+{
+// Images smaller than this are converted on the calling thread, as posting the tasks would cost
+// more than it saves.
+constexpr size_t kMinPixelsForParallelLoad = 1024 * 1024;
+constexpr size_t kMinPixelsPerLoadStripe   = 256 * 1024;
+
+size_t MaxLoadStripes()
+{
+    static const size_t numThreads = std::min(16u, std::thread::hardware_concurrency());
+    return numThreads;
+}
+
+class LoadStripeTask final : public Closure
+{
+  public:
+    LoadStripeTask(priv::LoadImageFunction loadFunction,
                    size_t width,
                    size_t height,
                    size_t depth,
@@ -66,69 +50,161 @@ void LoadA8ToRGBA8(const ImageLoadContext &context,
                    uint8_t *output,
                    size_t outputRowPitch,
                    size_t outputDepthPitch)
+        : mLoadFunction(loadFunction),
+          mWidth(width),
+          mHeight(height),
+          mDepth(depth),
+          mInput(input),
+          mInputRowPitch(inputRowPitch),
+          mInputDepthPitch(inputDepthPitch),
+          mOutput(output),
+          mOutputRowPitch(outputRowPitch),
+          mOutputDepthPitch(outputDepthPitch)
+    {}
+
+    void operator()() override
+    {
+        // The stripe is converted with an empty context so it is not split any further.
+        mLoadFunction(ImageLoadContext(), mWidth, mHeight, mDepth, mInput, mInputRowPitch,
+                      mInputDepthPitch, mOutput, mOutputRowPitch, mOutputDepthPitch);
+    }
+
+  private:
+    priv::LoadImageFunction mLoadFunction;
+    size_t mWidth;
+    size_t mHeight;
+    size_t mDepth;
+    const uint8_t *mInput;
+    size_t mInputRowPitch;
+    size_t mInputDepthPitch;
+    uint8_t *mOutput;
+    size_t mOutputRowPitch;
+    size_t mOutputDepthPitch;
+};
+}  // anonymous namespace
+
+namespace priv
+{
+bool LoadImageInStripes(const ImageLoadContext &context,
+                        LoadImageFunction loadFunction,
+                        size_t width,
+                        size_t height,
+                        size_t depth,
+                        const uint8_t *input,
+                        size_t inputRowPitch,
+                        size_t inputDepthPitch,
+                        uint8_t *output,
+                        size_t outputRowPitch,
+                        size_t outputDepthPitch)
 {
-#if defined(ANGLE_LOADIMAGE_USE_SSE)
-    if (supportsSSE2())
+    const size_t pixelCount = width * height * depth;
+    if (pixelCount < kMinPixelsForParallelLoad)
     {
-        __m128i zeroWide = _mm_setzero_si128();
+        return false;
+    }
 
-        for (size_t z = 0; z < depth; z++)
-        {
-            for (size_t y = 0; y < height; y++)
-            {
-                const uint8_t *source =
-                    priv::OffsetDataPointer<uint8_t>(input, y, z, inputRowPitch, inputDepthPitch);
-                uint32_t *dest = priv::OffsetDataPointer<uint32_t>(output, y, z, outputRowPitch,
-                                                                   outputDepthPitch);
-
-                size_t x = 0;
-
-                // Make output writes aligned
-                for (; ((reinterpret_cast<intptr_t>(&dest[x]) & 0xF) != 0 && x < width); x++)
-                {
-                    dest[x] = static_cast<uint32_t>(source[x]) << 24;
-                }
-
-                for (; x + 7 < width; x += 8)
-                {
-                    __m128i sourceData =
-                        _mm_loadl_epi64(reinterpret_cast<const __m128i *>(&source[x]));
-                    // Interleave each byte to 16bit, make the lower byte to zero
-                    sourceData = _mm_unpacklo_epi8(zeroWide, sourceData);
-                    // Interleave each 16bit to 32bit, make the lower 16bit to zero
-                    __m128i lo = _mm_unpacklo_epi16(zeroWide, sourceData);
-                    __m128i hi = _mm_unpackhi_epi16(zeroWide, sourceData);
-
-                    _mm_store_si128(reinterpret_cast<__m128i *>(&dest[x]), lo);
-                    _mm_store_si128(reinterpret_cast<__m128i *>(&dest[x + 4]), hi);
-                }
-
-                // Handle the remainder
-                for (; x < width; x++)
-                {
-                    dest[x] = static_cast<uint32_t>(source[x]) << 24;
-                }
-            }
-        }
+    return LoadImageInStripeCount(
+        context, loadFunction, std::min(MaxLoadStripes(), pixelCount / kMinPixelsPerLoadStripe),
+        width, height, depth, input, inputRowPitch, inputDepthPitch, output, outputRowPitch,
+        outputDepthPitch);
+}
+
+bool LoadImageInStripeCount(const ImageLoadContext &context,
+                            LoadImageFunction loadFunction,
+                            size_t maxStripeCount,
+                            size_t width,
+                            size_t height,
+                            size_t depth,
+                            const uint8_t *input,
+                            size_t inputRowPitch,
+                            size_t inputDepthPitch,
+                            uint8_t *output,
+                            size_t outputRowPitch,
+                            size_t outputDepthPitch)
+{
+    const std::shared_ptr<WorkerThreadPool> &pool = context.multiThreadPool;
+    if (!pool || !pool->isAsync())
+    {
+        return false;
+    }
 
-        return;
+    // 3D images are split by slices, 2D images by rows.
+    const bool splitSlices   = depth > 1;
+    const size_t splitExtent = splitSlices ? depth : height;
+    const size_t stripeCount = std::min(maxStripeCount, splitExtent);
+    if (stripeCount <= 1)
+    {
+        return false;
     }
-#endif
 
-    for (size_t z = 0; z < depth; z++)
+    const size_t inputStripePitch  = splitSlices ? inputDepthPitch : inputRowPitch;
+    const size_t outputStripePitch = splitSlices ? outputDepthPitch : outputRowPitch;
+
+    std::vector<std::shared_ptr<WaitableEvent>> waitEvents;
+    for (size_t stripe = 0; stripe < stripeCount; ++stripe)
     {
-        for (size_t y = 0; y < height; y++)
+        const size_t start  = splitExtent * stripe / stripeCount;
+        const size_t extent = splitExtent * (stripe + 1) / stripeCount - start;
+
+        auto task = std::make_shared<LoadStripeTask>(
+            loadFunction, width, splitSlices ? height : extent, splitSlices ? extent : 1,
+            input + start * inputStripePitch, inputRowPitch, inputDepthPitch,
+            output + start * outputStripePitch, outputRowPitch, outputDepthPitch);
+
+        // The calling thread converts the last stripe itself instead of waiting idly.  If a task
+        // can't be posted, it is converted here too.
+        std::shared_ptr<WaitableEvent> waitEvent;
+        if (stripe + 1 < stripeCount)
         {
-            const uint8_t *source =
-                priv::OffsetDataPointer<uint8_t>(input, y, z, inputRowPitch, inputDepthPitch);
-            uint32_t *dest =
-                priv::OffsetDataPointer<uint32_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
-            {
-                dest[x] = static_cast<uint32_t>(source[x]) << 24;
-            }
+            waitEvent = pool->postWorkerTask(task);
+        }
+        if (waitEvent)
+        {
+            waitEvents.push_back(waitEvent);
+        }
+        else
+        {
+            (*task)();
         }
     }
+    WaitableEvent::WaitMany(&waitEvents);
+
+    return true;
+}
+}  // namespace priv
+
+namespace
+{
+void LoadA8ToRGBA8Serial(const ImageLoadContext &context,
+                         size_t width,
+                         size_t height,
+                         size_t depth,
+                         const uint8_t *input,
+                         size_t inputRowPitch,
+                         size_t inputDepthPitch,
+                         uint8_t *output,
+                         size_t outputRowPitch,
+                         size_t outputDepthPitch)
+{
+    priv::LoadRows(priv::GetLoadRowFunctions().a8ToRGBA8, 1, 4, width, height, depth, input,
+                   inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
+}
+}  // anonymous namespace
+
+void LoadA8ToRGBA8(const ImageLoadContext &context,
+                   size_t width,
+                   size_t height,
+                   size_t depth,
+                   const uint8_t *input,
+                   size_t inputRowPitch,
+                   size_t inputDepthPitch,
+                   uint8_t *output,
+                   size_t outputRowPitch,
+                   size_t outputDepthPitch)
+{
+    priv::LoadImageInStripesOrSerially<LoadA8ToRGBA8Serial>(context, width, height, depth, input,
+                                                            inputRowPitch, inputDepthPitch, output,
+                                                            outputRowPitch, outputDepthPitch);
 }
 
 void LoadA8ToBGRA8(const ImageLoadContext &context,
@@ -147,16 +223,18 @@ void LoadA8ToBGRA8(const ImageLoadContext &context,
                   outputRowPitch, outputDepthPitch);
 }
 
-void LoadA32FToRGBA32F(const ImageLoadContext &context,
-                       size_t width,
-                       size_t height,
-                       size_t depth,
-                       const uint8_t *input,
-                       size_t inputRowPitch,
-                       size_t inputDepthPitch,
-                       uint8_t *output,
-                       size_t outputRowPitch,
-                       size_t outputDepthPitch)
+namespace
+{
+void LoadA32FToRGBA32FSerial(const ImageLoadContext &context,
+                             size_t width,
+                             size_t height,
+                             size_t depth,
+                             const uint8_t *input,
+                             size_t inputRowPitch,
+                             size_t inputDepthPitch,
+                             uint8_t *output,
+                             size_t outputRowPitch,
+                             size_t outputDepthPitch)
 {
     for (size_t z = 0; z < depth; z++)
     {
@@ -176,8 +254,9 @@ void LoadA32FToRGBA32F(const ImageLoadContext &context,
         }
     }
 }
+}  // anonymous namespace
 
-void LoadA16FToRGBA16F(const ImageLoadContext &context,
+void LoadA32FToRGBA32F(const ImageLoadContext &context,
                        size_t width,
                        size_t height,
                        size_t depth,
@@ -187,6 +266,24 @@ void LoadA16FToRGBA16F(const ImageLoadContext &context,
                        uint8_t *output,
                        size_t outputRowPitch,
                        size_t outputDepthPitch)
+{
+    priv::LoadImageInStripesOrSerially<LoadA32FToRGBA32FSerial>(
+        context, width, height, depth, input, inputRowPitch, inputDepthPitch, output,
+        outputRowPitch, outputDepthPitch);
+}
+
+namespace
+{
+void LoadA16FToRGBA16FSerial(const ImageLoadContext &context,
+                             size_t width,
+                             size_t height,
+                             size_t depth,
+                             const uint8_t *input,
+                             size_t inputRowPitch,
+                             size_t inputDepthPitch,
+                             uint8_t *output,
+                             size_t outputRowPitch,
+                             size_t outputDepthPitch)
 {
     for (size_t z = 0; z < depth; z++)
     {
@@ -206,6 +303,41 @@ void LoadA16FToRGBA16F(const ImageLoadContext &context,
         }
     }
 }
+}  // anonymous namespace
+
+void LoadA16FToRGBA16F(const ImageLoadContext &context,
+                       size_t width,
+                       size_t height,
+                       size_t depth,
+                       const uint8_t *input,
+                       size_t inputRowPitch,
+                       size_t inputDepthPitch,
+                       uint8_t *output,
+                       size_t outputRowPitch,
+                       size_t outputDepthPitch)
+{
+    priv::LoadImageInStripesOrSerially<LoadA16FToRGBA16FSerial>(
+        context, width, height, depth, input, inputRowPitch, inputDepthPitch, output,
+        outputRowPitch, outputDepthPitch);
+}
+
+namespace
+{
+void LoadL8ToRGBA8Serial(const ImageLoadContext &context,
+                         size_t width,
+                         size_t height,
+                         size_t depth,
+                         const uint8_t *input,
+                         size_t inputRowPitch,
+                         size_t inputDepthPitch,
+                         uint8_t *output,
+                         size_t outputRowPitch,
+                         size_t outputDepthPitch)
+{
+    priv::LoadRows(priv::GetLoadRowFunctions().l8ToRGBA8, 1, 4, width, height, depth, input,
+                   inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
+}
+}  // anonymous namespace
 
 void LoadL8ToRGBA8(const ImageLoadContext &context,
                    size_t width,
@@ -218,24 +350,9 @@ void LoadL8ToRGBA8(const ImageLoadContext &context,
                    size_t outputRowPitch,
                    size_t outputDepthPitch)
 {
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y++)
-        {
-            const uint8_t *source =
-                priv::OffsetDataPointer<uint8_t>(input, y, z, inputRowPitch, inputDepthPitch);
-            uint8_t *dest =
-                priv::OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
-            {
-                uint8_t sourceVal = source[x];
-                dest[4 * x + 0]   = sourceVal;
-                dest[4 * x + 1]   = sourceVal;
-                dest[4 * x + 2]   = sourceVal;
-                dest[4 * x + 3]   = 0xFF;
-            }
-        }
-    }
+    priv::LoadImageInStripesOrSerially<LoadL8ToRGBA8Serial>(context, width, height, depth, input,
+                                                            inputRowPitch, inputDepthPitch, output,
+                                                            outputRowPitch, outputDepthPitch);
 }
 
 void LoadL8ToBGRA8(const ImageLoadContext &context,
@@ -254,16 +371,18 @@ void LoadL8ToBGRA8(const ImageLoadContext &context,
                   outputRowPitch, outputDepthPitch);
 }
 
-void LoadL32FToRGBA32F(const ImageLoadContext &context,
-                       size_t width,
-                       size_t height,
-                       size_t depth,
-                       const uint8_t *input,
-                       size_t inputRowPitch,
-                       size_t inputDepthPitch,
-                       uint8_t *output,
-                       size_t outputRowPitch,
-                       size_t outputDepthPitch)
+namespace
+{
+void LoadL32FToRGBA32FSerial(const ImageLoadContext &context,
+                             size_t width,
+                             size_t height,
+                             size_t depth,
+                             const uint8_t *input,
+                             size_t inputRowPitch,
+                             size_t inputDepthPitch,
+                             uint8_t *output,
+                             size_t outputRowPitch,
+                             size_t outputDepthPitch)
 {
     for (size_t z = 0; z < depth; z++)
     {
@@ -283,8 +402,9 @@ void LoadL32FToRGBA32F(const ImageLoadContext &context,
         }
     }
 }
+}  // anonymous namespace
 
-void LoadL16FToRGBA16F(const ImageLoadContext &context,
+void LoadL32FToRGBA32F(const ImageLoadContext &context,
                        size_t width,
                        size_t height,
                        size_t depth,
@@ -294,6 +414,24 @@ void LoadL16FToRGBA16F(const ImageLoadContext &context,
                        uint8_t *output,
                        size_t outputRowPitch,
                        size_t outputDepthPitch)
+{
+    priv::LoadImageInStripesOrSerially<LoadL32FToRGBA32FSerial>(
+        context, width, height, depth, input, inputRowPitch, inputDepthPitch, output,
+        outputRowPitch, outputDepthPitch);
+}
+
+namespace
+{
+void LoadL16FToRGBA16FSerial(const ImageLoadContext &context,
+                             size_t width,
+                             size_t height,
+                             size_t depth,
+                             const uint8_t *input,
+                             size_t inputRowPitch,
+                             size_t inputDepthPitch,
+                             uint8_t *output,
+                             size_t outputRowPitch,
+                             size_t outputDepthPitch)
 {
     for (size_t z = 0; z < depth; z++)
     {
@@ -313,6 +451,23 @@ void LoadL16FToRGBA16F(const ImageLoadContext &context,
         }
     }
 }
+}  // anonymous namespace
+
+void LoadL16FToRGBA16F(const ImageLoadContext &context,
+                       size_t width,
+                       size_t height,
+                       size_t depth,
+                       const uint8_t *input,
+                       size_t inputRowPitch,
+                       size_t inputDepthPitch,
+                       uint8_t *output,
+                       size_t outputRowPitch,
+                       size_t outputDepthPitch)
+{
+    priv::LoadImageInStripesOrSerially<LoadL16FToRGBA16FSerial>(
+        context, width, height, depth, input, inputRowPitch, inputDepthPitch, output,
+        outputRowPitch, outputDepthPitch);
+}
 
 void LoadLA8ToRGBA4(const ImageLoadContext &context,
                     size_t width,
@@ -344,6 +499,24 @@ void LoadLA8ToRGBA4(const ImageLoadContext &context,
     }
 }
 
+namespace
+{
+void LoadLA8ToRGBA8Serial(const ImageLoadContext &context,
+                          size_t width,
+                          size_t height,
+                          size_t depth,
+                          const uint8_t *input,
+                          size_t inputRowPitch,
+                          size_t inputDepthPitch,
+                          uint8_t *output,
+                          size_t outputRowPitch,
+                          size_t outputDepthPitch)
+{
+    priv::LoadRows(priv::GetLoadRowFunctions().la8ToRGBA8, 2, 4, width, height, depth, input,
+                   inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
+}
+}  // anonymous namespace
+
 void LoadLA8ToRGBA8(const ImageLoadContext &context,
                     size_t width,
                     size_t height,
@@ -355,23 +528,9 @@ void LoadLA8ToRGBA8(const ImageLoadContext &context,
                     size_t outputRowPitch,
                     size_t outputDepthPitch)
 {
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y++)
-        {
-            const uint8_t *source =
-                priv::OffsetDataPointer<uint8_t>(input, y, z, inputRowPitch, inputDepthPitch);
-            uint8_t *dest =
-                priv::OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
-            {
-                dest[4 * x + 0] = source[2 * x + 0];
-                dest[4 * x + 1] = source[2 * x + 0];
-                dest[4 * x + 2] = source[2 * x + 0];
-                dest[4 * x + 3] = source[2 * x + 1];
-            }
-        }
-    }
+    priv::LoadImageInStripesOrSerially<LoadLA8ToRGBA8Serial>(context, width, height, depth, input,
+                                                             inputRowPitch, inputDepthPitch, output,
+                                                             outputRowPitch, outputDepthPitch);
 }
 
 void LoadLA8ToBGRA8(const ImageLoadContext &context,
@@ -390,16 +549,18 @@ void LoadLA8ToBGRA8(const ImageLoadContext &context,
                    outputRowPitch, outputDepthPitch);
 }
 
-void LoadLA32FToRGBA32F(const ImageLoadContext &context,
-                        size_t width,
-                        size_t height,
-                        size_t depth,
-                        const uint8_t *input,
-                        size_t inputRowPitch,
-                        size_t inputDepthPitch,
-                        uint8_t *output,
-                        size_t outputRowPitch,
-                        size_t outputDepthPitch)
+namespace
+{
+void LoadLA32FToRGBA32FSerial(const ImageLoadContext &context,
+                              size_t width,
+                              size_t height,
+                              size_t depth,
+                              const uint8_t *input,
+                              size_t inputRowPitch,
+                              size_t inputDepthPitch,
+                              uint8_t *output,
+                              size_t outputRowPitch,
+                              size_t outputDepthPitch)
 {
     for (size_t z = 0; z < depth; z++)
     {
@@ -419,8 +580,9 @@ void LoadLA32FToRGBA32F(const ImageLoadContext &context,
         }
     }
 }
+}  // anonymous namespace
 
-void LoadLA16FToRGBA16F(const ImageLoadContext &context,
+void LoadLA32FToRGBA32F(const ImageLoadContext &context,
                         size_t width,
                         size_t height,
                         size_t depth,
@@ -430,6 +592,24 @@ void LoadLA16FToRGBA16F(const ImageLoadContext &context,
                         uint8_t *output,
                         size_t outputRowPitch,
                         size_t outputDepthPitch)
+{
+    priv::LoadImageInStripesOrSerially<LoadLA32FToRGBA32FSerial>(
+        context, width, height, depth, input, inputRowPitch, inputDepthPitch, output,
+        outputRowPitch, outputDepthPitch);
+}
+
+namespace
+{
+void LoadLA16FToRGBA16FSerial(const ImageLoadContext &context,
+                              size_t width,
+                              size_t height,
+                              size_t depth,
+                              const uint8_t *input,
+                              size_t inputRowPitch,
+                              size_t inputDepthPitch,
+                              uint8_t *output,
+                              size_t outputRowPitch,
+                              size_t outputDepthPitch)
 {
     for (size_t z = 0; z < depth; z++)
     {
@@ -449,6 +629,23 @@ void LoadLA16FToRGBA16F(const ImageLoadContext &context,
         }
     }
 }
+}  // anonymous namespace
+
+void LoadLA16FToRGBA16F(const ImageLoadContext &context,
+                        size_t width,
+                        size_t height,
+                        size_t depth,
+                        const uint8_t *input,
+                        size_t inputRowPitch,
+                        size_t inputDepthPitch,
+                        uint8_t *output,
+                        size_t outputRowPitch,
+                        size_t outputDepthPitch)
+{
+    priv::LoadImageInStripesOrSerially<LoadLA16FToRGBA16FSerial>(
+        context, width, height, depth, input, inputRowPitch, inputDepthPitch, output,
+        outputRowPitch, outputDepthPitch);
+}
 
 void LoadRGB8ToBGR565(const ImageLoadContext &context,
                       size_t width,
@@ -516,6 +713,58 @@ void LoadRGB565ToBGR565(const ImageLoadContext &context,
     }
 }
 
+namespace
+{
+void LoadRGB8ToRGBA8Serial(const ImageLoadContext &context,
+                           size_t width,
+                           size_t height,
+                           size_t depth,
+                           const uint8_t *input,
+                           size_t inputRowPitch,
+                           size_t inputDepthPitch,
+                           uint8_t *output,
+                           size_t outputRowPitch,
+                           size_t outputDepthPitch)
+{
+    priv::LoadRows(priv::GetLoadRowFunctions().rgb8ToRGBA8, 3, 4, width, height, depth, input,
+                   inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
+}
+}  // anonymous namespace
+
+void LoadRGB8ToRGBA8(const ImageLoadContext &context,
+                     size_t width,
+                     size_t height,
+                     size_t depth,
+                     const uint8_t *input,
+                     size_t inputRowPitch,
+                     size_t inputDepthPitch,
+                     uint8_t *output,
+                     size_t outputRowPitch,
+                     size_t outputDepthPitch)
+{
+    priv::LoadImageInStripesOrSerially<LoadRGB8ToRGBA8Serial>(
+        context, width, height, depth, input, inputRowPitch, inputDepthPitch, output,
+        outputRowPitch, outputDepthPitch);
+}
+
+namespace
+{
+void LoadRGB8ToBGRX8Serial(const ImageLoadContext &context,
+                           size_t width,
+                           size_t height,
+                           size_t depth,
+                           const uint8_t *input,
+                           size_t inputRowPitch,
+                           size_t inputDepthPitch,
+                           uint8_t *output,
+                           size_t outputRowPitch,
+                           size_t outputDepthPitch)
+{
+    priv::LoadRows(priv::GetLoadRowFunctions().rgb8ToBGRX8, 3, 4, width, height, depth, input,
+                   inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
+}
+}  // anonymous namespace
+
 void LoadRGB8ToBGRX8(const ImageLoadContext &context,
                      size_t width,
                      size_t height,
@@ -527,23 +776,9 @@ void LoadRGB8ToBGRX8(const ImageLoadContext &context,
                      size_t outputRowPitch,
                      size_t outputDepthPitch)
 {
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y++)
-        {
-            const uint8_t *source =
-                priv::OffsetDataPointer<uint8_t>(input, y, z, inputRowPitch, inputDepthPitch);
-            uint8_t *dest =
-                priv::OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
-            {
-                dest[4 * x + 0] = source[x * 3 + 2];
-                dest[4 * x + 1] = source[x * 3 + 1];
-                dest[4 * x + 2] = source[x * 3 + 0];
-                dest[4 * x + 3] = 0xFF;
-            }
-        }
-    }
+    priv::LoadImageInStripesOrSerially<LoadRGB8ToBGRX8Serial>(
+        context, width, height, depth, input, inputRowPitch, inputDepthPitch, output,
+        outputRowPitch, outputDepthPitch);
 }
 
 void LoadRG8ToBGRX8(const ImageLoadContext &context,
@@ -674,6 +909,24 @@ void LoadR5G6B5ToRGBA8(const ImageLoadContext &context,
     }
 }
 
+namespace
+{
+void LoadRGBA8ToBGRA8Serial(const ImageLoadContext &context,
+                            size_t width,
+                            size_t height,
+                            size_t depth,
+                            const uint8_t *input,
+                            size_t inputRowPitch,
+                            size_t inputDepthPitch,
+                            uint8_t *output,
+                            size_t outputRowPitch,
+                            size_t outputDepthPitch)
+{
+    priv::LoadRows(priv::GetLoadRowFunctions().rgba8ToBGRA8, 4, 4, width, height, depth, input,
+                   inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
+}
+}  // anonymous namespace
+
 void LoadRGBA8ToBGRA8(const ImageLoadContext &context,
                       size_t width,
                       size_t height,
@@ -685,73 +938,9 @@ void LoadRGBA8ToBGRA8(const ImageLoadContext &context,
                       size_t outputRowPitch,
                       size_t outputDepthPitch)
 {
-#if defined(ANGLE_LOADIMAGE_USE_SSE)
-    if (supportsSSE2())
-    {
-        __m128i brMask = _mm_set1_epi32(0x00ff00ff);
-
-        for (size_t z = 0; z < depth; z++)
-        {
-            for (size_t y = 0; y < height; y++)
-            {
-                const uint32_t *source =
-                    priv::OffsetDataPointer<uint32_t>(input, y, z, inputRowPitch, inputDepthPitch);
-                uint32_t *dest = priv::OffsetDataPointer<uint32_t>(output, y, z, outputRowPitch,
-                                                                   outputDepthPitch);
-
-                size_t x = 0;
-
-                // Make output writes aligned
-                for (; ((reinterpret_cast<intptr_t>(&dest[x]) & 15) != 0) && x < width; x++)
-                {
-                    uint32_t rgba = source[x];
-                    dest[x]       = (ANGLE_ROTL(rgba, 16) & 0x00ff00ff) | (rgba & 0xff00ff00);
-                }
-
-                for (; x + 3 < width; x += 4)
-                {
-                    __m128i sourceData =
-                        _mm_loadu_si128(reinterpret_cast<const __m128i *>(&source[x]));
-                    // Mask out g and a, which don't change
-                    __m128i gaComponents = _mm_andnot_si128(brMask, sourceData);
-                    // Mask out b and r
-                    __m128i brComponents = _mm_and_si128(sourceData, brMask);
-                    // Swap b and r
-                    __m128i brSwapped = _mm_shufflehi_epi16(
-                        _mm_shufflelo_epi16(brComponents, _MM_SHUFFLE(2, 3, 0, 1)),
-                        _MM_SHUFFLE(2, 3, 0, 1));
-                    __m128i result = _mm_or_si128(gaComponents, brSwapped);
-                    _mm_store_si128(reinterpret_cast<__m128i *>(&dest[x]), result);
-                }
-
-                // Perform leftover writes
-                for (; x < width; x++)
-                {
-                    uint32_t rgba = source[x];
-                    dest[x]       = (ANGLE_ROTL(rgba, 16) & 0x00ff00ff) | (rgba & 0xff00ff00);
-                }
-            }
-        }
-
-        return;
-    }
-#endif
-
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y++)
-        {
-            const uint32_t *source =
-                priv::OffsetDataPointer<uint32_t>(input, y, z, inputRowPitch, inputDepthPitch);
-            uint32_t *dest =
-                priv::OffsetDataPointer<uint32_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
-            {
-                uint32_t rgba = source[x];
-                dest[x]       = (ANGLE_ROTL(rgba, 16) & 0x00ff00ff) | (rgba & 0xff00ff00);
-            }
-        }
-    }
+    priv::LoadImageInStripesOrSerially<LoadRGBA8ToBGRA8Serial>(
+        context, width, height, depth, input, inputRowPitch, inputDepthPitch, output,
+        outputRowPitch, outputDepthPitch);
 }
 
 void LoadRGBA8ToBGRA4(const ImageLoadContext &context,
@@ -1397,16 +1586,18 @@ void LoadBGR10A2ToRGB10A2(const ImageLoadContext &context,
     }
 }
 
-void LoadRGB16FToRGB9E5(const ImageLoadContext &context,
-                        size_t width,
-                        size_t height,
-                        size_t depth,
-                        const uint8_t *input,
-                        size_t inputRowPitch,
-                        size_t inputDepthPitch,
-                        uint8_t *output,
-                        size_t outputRowPitch,
-                        size_t outputDepthPitch)
+namespace
+{
+void LoadRGB16FToRGB9E5Serial(const ImageLoadContext &context,
+                              size_t width,
+                              size_t height,
+                              size_t depth,
+                              const uint8_t *input,
+                              size_t inputRowPitch,
+                              size_t inputDepthPitch,
+                              uint8_t *output,
+                              size_t outputRowPitch,
+                              size_t outputDepthPitch)
 {
     for (size_t z = 0; z < depth; z++)
     {
@@ -1425,8 +1616,9 @@ void LoadRGB16FToRGB9E5(const ImageLoadContext &context,
         }
     }
 }
+}  // anonymous namespace
 
-void LoadRGB32FToRGB9E5(const ImageLoadContext &context,
+void LoadRGB16FToRGB9E5(const ImageLoadContext &context,
                         size_t width,
                         size_t height,
                         size_t depth,
@@ -1436,6 +1628,24 @@ void LoadRGB32FToRGB9E5(const ImageLoadContext &context,
                         uint8_t *output,
                         size_t outputRowPitch,
                         size_t outputDepthPitch)
+{
+    priv::LoadImageInStripesOrSerially<LoadRGB16FToRGB9E5Serial>(
+        context, width, height, depth, input, inputRowPitch, inputDepthPitch, output,
+        outputRowPitch, outputDepthPitch);
+}
+
+namespace
+{
+void LoadRGB32FToRGB9E5Serial(const ImageLoadContext &context,
+                              size_t width,
+                              size_t height,
+                              size_t depth,
+                              const uint8_t *input,
+                              size_t inputRowPitch,
+                              size_t inputDepthPitch,
+                              uint8_t *output,
+                              size_t outputRowPitch,
+                              size_t outputDepthPitch)
 {
     for (size_t z = 0; z < depth; z++)
     {
@@ -1453,17 +1663,36 @@ void LoadRGB32FToRGB9E5(const ImageLoadContext &context,
         }
     }
 }
+}  // anonymous namespace
 
-void LoadRGB16FToRG11B10F(const ImageLoadContext &context,
-                          size_t width,
-                          size_t height,
-                          size_t depth,
-                          const uint8_t *input,
-                          size_t inputRowPitch,
-                          size_t inputDepthPitch,
-                          uint8_t *output,
-                          size_t outputRowPitch,
-                          size_t outputDepthPitch)
+void LoadRGB32FToRGB9E5(const ImageLoadContext &context,
+                        size_t width,
+                        size_t height,
+                        size_t depth,
+                        const uint8_t *input,
+                        size_t inputRowPitch,
+                        size_t inputDepthPitch,
+                        uint8_t *output,
+                        size_t outputRowPitch,
+                        size_t outputDepthPitch)
+{
+    priv::LoadImageInStripesOrSerially<LoadRGB32FToRGB9E5Serial>(
+        context, width, height, depth, input, inputRowPitch, inputDepthPitch, output,
+        outputRowPitch, outputDepthPitch);
+}
+
+namespace
+{
+void LoadRGB16FToRG11B10FSerial(const ImageLoadContext &context,
+                                size_t width,
+                                size_t height,
+                                size_t depth,
+                                const uint8_t *input,
+                                size_t inputRowPitch,
+                                size_t inputDepthPitch,
+                                uint8_t *output,
+                                size_t outputRowPitch,
+                                size_t outputDepthPitch)
 {
     for (size_t z = 0; z < depth; z++)
     {
@@ -1482,8 +1711,9 @@ void LoadRGB16FToRG11B10F(const ImageLoadContext &context,
         }
     }
 }
+}  // anonymous namespace
 
-void LoadRGB32FToRG11B10F(const ImageLoadContext &context,
+void LoadRGB16FToRG11B10F(const ImageLoadContext &context,
                           size_t width,
                           size_t height,
                           size_t depth,
@@ -1493,6 +1723,24 @@ void LoadRGB32FToRG11B10F(const ImageLoadContext &context,
                           uint8_t *output,
                           size_t outputRowPitch,
                           size_t outputDepthPitch)
+{
+    priv::LoadImageInStripesOrSerially<LoadRGB16FToRG11B10FSerial>(
+        context, width, height, depth, input, inputRowPitch, inputDepthPitch, output,
+        outputRowPitch, outputDepthPitch);
+}
+
+namespace
+{
+void LoadRGB32FToRG11B10FSerial(const ImageLoadContext &context,
+                                size_t width,
+                                size_t height,
+                                size_t depth,
+                                const uint8_t *input,
+                                size_t inputRowPitch,
+                                size_t inputDepthPitch,
+                                uint8_t *output,
+                                size_t outputRowPitch,
+                                size_t outputDepthPitch)
 {
     for (size_t z = 0; z < depth; z++)
     {
@@ -1511,6 +1759,23 @@ void LoadRGB32FToRG11B10F(const ImageLoadContext &context,
         }
     }
 }
+}  // anonymous namespace
+
+void LoadRGB32FToRG11B10F(const ImageLoadContext &context,
+                          size_t width,
+                          size_t height,
+                          size_t depth,
+                          const uint8_t *input,
+                          size_t inputRowPitch,
+                          size_t inputDepthPitch,
+                          uint8_t *output,
+                          size_t outputRowPitch,
+                          size_t outputDepthPitch)
+{
+    priv::LoadImageInStripesOrSerially<LoadRGB32FToRG11B10FSerial>(
+        context, width, height, depth, input, inputRowPitch, inputDepthPitch, output,
+        outputRowPitch, outputDepthPitch);
+}
 
 void LoadD24S8ToS8D24(const ImageLoadContext &context,
                       size_t width,
@@ -28,6 +28,74 @@ struct ImageLoadContext
     std::shared_ptr<WorkerThreadPool> multiThreadPool;
 };
 
+namespace priv
+{
+using LoadImageFunction = void (*)(const ImageLoadContext &context,
+                                   size_t width,
+                                   size_t height,
+                                   size_t depth,
+                                   const uint8_t *input,
+                                   size_t inputRowPitch,
+                                   size_t inputDepthPitch,
+                                   uint8_t *output,
+                                   size_t outputRowPitch,
+                                   size_t outputDepthPitch);
+
+// Splits large images in stripes of rows, or of slices for 3D images, and converts them with
+// |loadFunction| in parallel on the context's multi-threaded pool.  Each pixel is converted exactly
+// as it would be on a single thread.  Returns false without doing anything if the image is too
+// small to benefit or there is no such pool, in which case the caller converts the image itself.
+bool LoadImageInStripes(const ImageLoadContext &context,
+                        LoadImageFunction loadFunction,
+                        size_t width,
+                        size_t height,
+                        size_t depth,
+                        const uint8_t *input,
+                        size_t inputRowPitch,
+                        size_t inputDepthPitch,
+                        uint8_t *output,
+                        size_t outputRowPitch,
+                        size_t outputDepthPitch);
+
+// Same as LoadImageInStripes(), but splits any image in up to |maxStripeCount| stripes, regardless
+// of its size and of the number of CPUs.
+bool LoadImageInStripeCount(const ImageLoadContext &context,
+                            LoadImageFunction loadFunction,
+                            size_t maxStripeCount,
+                            size_t width,
+                            size_t height,
+                            size_t depth,
+                            const uint8_t *input,
+                            size_t inputRowPitch,
+                            size_t inputDepthPitch,
+                            uint8_t *output,
+                            size_t outputRowPitch,
+                            size_t outputDepthPitch);
+
+// Converts the image with |kLoadFunction| in parallel stripes if LoadImageInStripes() splits it,
+// and on the calling thread otherwise.  The load functions worth parallelizing forward to this
+// with their single-threaded implementation.
+template <LoadImageFunction kLoadFunction>
+void LoadImageInStripesOrSerially(const ImageLoadContext &context,
+                                  size_t width,
+                                  size_t height,
+                                  size_t depth,
+                                  const uint8_t *input,
+                                  size_t inputRowPitch,
+                                  size_t inputDepthPitch,
+                                  uint8_t *output,
+                                  size_t outputRowPitch,
+                                  size_t outputDepthPitch)
+{
+    if (!LoadImageInStripes(context, kLoadFunction, width, height, depth, input, inputRowPitch,
+                            inputDepthPitch, output, outputRowPitch, outputDepthPitch))
+    {
+        kLoadFunction(context, width, height, depth, input, inputRowPitch, inputDepthPitch, output,
+                      outputRowPitch, outputDepthPitch);
+    }
+}
+}  // namespace priv
+
 void LoadA8ToRGBA8(const ImageLoadContext &context,
                    size_t width,
                    size_t height,
@@ -193,6 +261,17 @@ void LoadRGB565ToBGR565(const ImageLoadContext &context,
                         size_t outputRowPitch,
                         size_t outputDepthPitch);
 
+void LoadRGB8ToRGBA8(const ImageLoadContext &context,
+                     size_t width,
+                     size_t height,
+                     size_t depth,
+                     const uint8_t *input,
+                     size_t inputRowPitch,
+                     size_t inputDepthPitch,
+                     uint8_t *output,
+                     size_t outputRowPitch,
+                     size_t outputDepthPitch);
+
 void LoadRGB8ToBGRX8(const ImageLoadContext &context,
                      size_t width,
                      size_t height,
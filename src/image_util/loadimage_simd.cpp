@@ -0,0 +1,454 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// loadimage_simd.cpp: Implements the row conversion functions with SSE2, SSSE3 and NEON.
+
+#include "image_util/loadimage_simd.h"
+
+#include "common/cpu_features.h"
+#include "common/platform.h"
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define ANGLE_LOADIMAGE_USE_SSE2
+#    include <emmintrin.h>
+#    include <tmmintrin.h>
+#    if defined(__clang__) || defined(__GNUC__)
+#        define ANGLE_SSSE3_TARGET __attribute__((target("ssse3")))
+#    else
+#        define ANGLE_SSSE3_TARGET
+#    endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#    define ANGLE_LOADIMAGE_USE_NEON
+#    include <arm_neon.h>
+#endif
+
+namespace angle
+{
+namespace priv
+{
+namespace
+{
+void LoadA8ToRGBA8Row(const uint8_t *source, uint8_t *dest, size_t width)
+{
+    for (size_t x = 0; x < width; x++)
+    {
+        dest[4 * x + 0] = 0;
+        dest[4 * x + 1] = 0;
+        dest[4 * x + 2] = 0;
+        dest[4 * x + 3] = source[x];
+    }
+}
+
+void LoadL8ToRGBA8Row(const uint8_t *source, uint8_t *dest, size_t width)
+{
+    for (size_t x = 0; x < width; x++)
+    {
+        uint8_t sourceVal = source[x];
+        dest[4 * x + 0]   = sourceVal;
+        dest[4 * x + 1]   = sourceVal;
+        dest[4 * x + 2]   = sourceVal;
+        dest[4 * x + 3]   = 0xFF;
+    }
+}
+
+void LoadLA8ToRGBA8Row(const uint8_t *source, uint8_t *dest, size_t width)
+{
+    for (size_t x = 0; x < width; x++)
+    {
+        dest[4 * x + 0] = source[2 * x + 0];
+        dest[4 * x + 1] = source[2 * x + 0];
+        dest[4 * x + 2] = source[2 * x + 0];
+        dest[4 * x + 3] = source[2 * x + 1];
+    }
+}
+
+void LoadRGB8ToRGBA8Row(const uint8_t *source, uint8_t *dest, size_t width)
+{
+    for (size_t x = 0; x < width; x++)
+    {
+        dest[4 * x + 0] = source[3 * x + 0];
+        dest[4 * x + 1] = source[3 * x + 1];
+        dest[4 * x + 2] = source[3 * x + 2];
+        dest[4 * x + 3] = 0xFF;
+    }
+}
+
+void LoadRGB8ToBGRX8Row(const uint8_t *source, uint8_t *dest, size_t width)
+{
+    for (size_t x = 0; x < width; x++)
+    {
+        dest[4 * x + 0] = source[3 * x + 2];
+        dest[4 * x + 1] = source[3 * x + 1];
+        dest[4 * x + 2] = source[3 * x + 0];
+        dest[4 * x + 3] = 0xFF;
+    }
+}
+
+void LoadRGBA8ToBGRA8Row(const uint8_t *source, uint8_t *dest, size_t width)
+{
+    for (size_t x = 0; x < width; x++)
+    {
+        dest[4 * x + 0] = source[4 * x + 2];
+        dest[4 * x + 1] = source[4 * x + 1];
+        dest[4 * x + 2] = source[4 * x + 0];
+        dest[4 * x + 3] = source[4 * x + 3];
+    }
+}
+
+constexpr LoadRowFunctions kScalarLoadRowFunctions = {
+    LoadA8ToRGBA8Row,   LoadL8ToRGBA8Row,   LoadLA8ToRGBA8Row,
+    LoadRGB8ToRGBA8Row, LoadRGB8ToBGRX8Row, LoadRGBA8ToBGRA8Row,
+};
+
+// The vectorized functions convert as many pixels as possible in blocks and leave the rest to the
+// scalar functions.
+#if defined(ANGLE_LOADIMAGE_USE_SSE2)
+inline __m128i Load128(const uint8_t *source)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(source));
+}
+
+inline void Store128(uint8_t *dest, __m128i value)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dest), value);
+}
+
+void LoadA8ToRGBA8RowSSE2(const uint8_t *source, uint8_t *dest, size_t width)
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    size_t x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        const __m128i alpha = Load128(source + x);
+        // Interleave each byte with zeros twice to move it to the top byte of a 32-bit pixel.
+        const __m128i alphaLo = _mm_unpacklo_epi8(zero, alpha);
+        const __m128i alphaHi = _mm_unpackhi_epi8(zero, alpha);
+        Store128(dest + 4 * x, _mm_unpacklo_epi16(zero, alphaLo));
+        Store128(dest + 4 * x + 16, _mm_unpackhi_epi16(zero, alphaLo));
+        Store128(dest + 4 * x + 32, _mm_unpacklo_epi16(zero, alphaHi));
+        Store128(dest + 4 * x + 48, _mm_unpackhi_epi16(zero, alphaHi));
+    }
+
+    LoadA8ToRGBA8Row(source + x, dest + 4 * x, width - x);
+}
+
+void LoadL8ToRGBA8RowSSE2(const uint8_t *source, uint8_t *dest, size_t width)
+{
+    const __m128i opaque = _mm_set1_epi8(-1);
+
+    size_t x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        const __m128i luminance = Load128(source + x);
+        // Make LL and LA 16-bit pairs, then interleave them to LLLA.
+        const __m128i llLo = _mm_unpacklo_epi8(luminance, luminance);
+        const __m128i llHi = _mm_unpackhi_epi8(luminance, luminance);
+        const __m128i laLo = _mm_unpacklo_epi8(luminance, opaque);
+        const __m128i laHi = _mm_unpackhi_epi8(luminance, opaque);
+        Store128(dest + 4 * x, _mm_unpacklo_epi16(llLo, laLo));
+        Store128(dest + 4 * x + 16, _mm_unpackhi_epi16(llLo, laLo));
+        Store128(dest + 4 * x + 32, _mm_unpacklo_epi16(llHi, laHi));
+        Store128(dest + 4 * x + 48, _mm_unpackhi_epi16(llHi, laHi));
+    }
+
+    LoadL8ToRGBA8Row(source + x, dest + 4 * x, width - x);
+}
+
+void LoadLA8ToRGBA8RowSSE2(const uint8_t *source, uint8_t *dest, size_t width)
+{
+    const __m128i lowBytes = _mm_set1_epi16(0x00FF);
+
+    size_t x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        // Each 16-bit lane holds an LA pair.  Make an LL pair and interleave them to LLLA.
+        const __m128i la        = Load128(source + 2 * x);
+        const __m128i luminance = _mm_and_si128(la, lowBytes);
+        const __m128i ll        = _mm_or_si128(luminance, _mm_slli_epi16(luminance, 8));
+        Store128(dest + 4 * x, _mm_unpacklo_epi16(ll, la));
+        Store128(dest + 4 * x + 16, _mm_unpackhi_epi16(ll, la));
+    }
+
+    LoadLA8ToRGBA8Row(source + 2 * x, dest + 4 * x, width - x);
+}
+
+void LoadRGBA8ToBGRA8RowSSE2(const uint8_t *source, uint8_t *dest, size_t width)
+{
+    const __m128i brMask = _mm_set1_epi32(0x00FF00FF);
+
+    size_t x = 0;
+    for (; x + 4 <= width; x += 4)
+    {
+        const __m128i sourceData = Load128(source + 4 * x);
+        // Mask out g and a, which don't change
+        const __m128i gaComponents = _mm_andnot_si128(brMask, sourceData);
+        // Mask out b and r
+        const __m128i brComponents = _mm_and_si128(sourceData, brMask);
+        // Swap b and r
+        const __m128i brSwapped =
+            _mm_shufflehi_epi16(_mm_shufflelo_epi16(brComponents, _MM_SHUFFLE(2, 3, 0, 1)),
+                                _MM_SHUFFLE(2, 3, 0, 1));
+        Store128(dest + 4 * x, _mm_or_si128(gaComponents, brSwapped));
+    }
+
+    LoadRGBA8ToBGRA8Row(source + 4 * x, dest + 4 * x, width - x);
+}
+
+constexpr LoadRowFunctions kSSE2LoadRowFunctions = {
+    LoadA8ToRGBA8RowSSE2, LoadL8ToRGBA8RowSSE2, LoadLA8ToRGBA8RowSSE2,
+    LoadRGB8ToRGBA8Row,   LoadRGB8ToBGRX8Row,   LoadRGBA8ToBGRA8RowSSE2,
+};
+
+// Expands 16 packed 3-byte pixels to 4-byte pixels, with the bytes of each pixel ordered by
+// |shuffle| and the fourth byte set to 0xFF.
+ANGLE_SSSE3_TARGET inline void Expand3To4SSSE3(const uint8_t *source,
+                                               uint8_t *dest,
+                                               __m128i shuffle)
+{
+    const __m128i opaque = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+    const __m128i a      = Load128(source);
+    const __m128i b      = Load128(source + 16);
+    const __m128i c      = Load128(source + 32);
+
+    // Each 12 bytes of input make 4 pixels.
+    const __m128i pixels0 = _mm_shuffle_epi8(a, shuffle);
+    const __m128i pixels1 = _mm_shuffle_epi8(_mm_alignr_epi8(b, a, 12), shuffle);
+    const __m128i pixels2 = _mm_shuffle_epi8(_mm_alignr_epi8(c, b, 8), shuffle);
+    const __m128i pixels3 = _mm_shuffle_epi8(_mm_srli_si128(c, 4), shuffle);
+
+    Store128(dest, _mm_or_si128(pixels0, opaque));
+    Store128(dest + 16, _mm_or_si128(pixels1, opaque));
+    Store128(dest + 32, _mm_or_si128(pixels2, opaque));
+    Store128(dest + 48, _mm_or_si128(pixels3, opaque));
+}
+
+ANGLE_SSSE3_TARGET void LoadRGB8ToRGBA8RowSSSE3(const uint8_t *source, uint8_t *dest, size_t width)
+{
+    // Indices with the top bit set produce zeros.
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+
+    size_t x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        Expand3To4SSSE3(source + 3 * x, dest + 4 * x, shuffle);
+    }
+
+    LoadRGB8ToRGBA8Row(source + 3 * x, dest + 4 * x, width - x);
+}
+
+ANGLE_SSSE3_TARGET void LoadRGB8ToBGRX8RowSSSE3(const uint8_t *source, uint8_t *dest, size_t width)
+{
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+
+    size_t x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        Expand3To4SSSE3(source + 3 * x, dest + 4 * x, shuffle);
+    }
+
+    LoadRGB8ToBGRX8Row(source + 3 * x, dest + 4 * x, width - x);
+}
+
+ANGLE_SSSE3_TARGET void LoadRGBA8ToBGRA8RowSSSE3(const uint8_t *source,
+                                                 uint8_t *dest,
+                                                 size_t width)
+{
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+    size_t x = 0;
+    for (; x + 4 <= width; x += 4)
+    {
+        Store128(dest + 4 * x, _mm_shuffle_epi8(Load128(source + 4 * x), shuffle));
+    }
+
+    LoadRGBA8ToBGRA8Row(source + 4 * x, dest + 4 * x, width - x);
+}
+
+constexpr LoadRowFunctions kSSSE3LoadRowFunctions = {
+    LoadA8ToRGBA8RowSSE2,    LoadL8ToRGBA8RowSSE2,    LoadLA8ToRGBA8RowSSE2,
+    LoadRGB8ToRGBA8RowSSSE3, LoadRGB8ToBGRX8RowSSSE3, LoadRGBA8ToBGRA8RowSSSE3,
+};
+#endif  // defined(ANGLE_LOADIMAGE_USE_SSE2)
+
+#if defined(ANGLE_LOADIMAGE_USE_NEON)
+void LoadA8ToRGBA8RowNEON(const uint8_t *source, uint8_t *dest, size_t width)
+{
+    uint8x16x4_t rgba;
+    rgba.val[0] = vdupq_n_u8(0);
+    rgba.val[1] = rgba.val[0];
+    rgba.val[2] = rgba.val[0];
+
+    size_t x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        rgba.val[3] = vld1q_u8(source + x);
+        vst4q_u8(dest + 4 * x, rgba);
+    }
+
+    LoadA8ToRGBA8Row(source + x, dest + 4 * x, width - x);
+}
+
+void LoadL8ToRGBA8RowNEON(const uint8_t *source, uint8_t *dest, size_t width)
+{
+    uint8x16x4_t rgba;
+    rgba.val[3] = vdupq_n_u8(0xFF);
+
+    size_t x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        rgba.val[0] = vld1q_u8(source + x);
+        rgba.val[1] = rgba.val[0];
+        rgba.val[2] = rgba.val[0];
+        vst4q_u8(dest + 4 * x, rgba);
+    }
+
+    LoadL8ToRGBA8Row(source + x, dest + 4 * x, width - x);
+}
+
+void LoadLA8ToRGBA8RowNEON(const uint8_t *source, uint8_t *dest, size_t width)
+{
+    size_t x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        const uint8x16x2_t la = vld2q_u8(source + 2 * x);
+        uint8x16x4_t rgba;
+        rgba.val[0] = la.val[0];
+        rgba.val[1] = la.val[0];
+        rgba.val[2] = la.val[0];
+        rgba.val[3] = la.val[1];
+        vst4q_u8(dest + 4 * x, rgba);
+    }
+
+    LoadLA8ToRGBA8Row(source + 2 * x, dest + 4 * x, width - x);
+}
+
+void LoadRGB8ToRGBA8RowNEON(const uint8_t *source, uint8_t *dest, size_t width)
+{
+    uint8x16x4_t rgba;
+    rgba.val[3] = vdupq_n_u8(0xFF);
+
+    size_t x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        const uint8x16x3_t rgb = vld3q_u8(source + 3 * x);
+        rgba.val[0]            = rgb.val[0];
+        rgba.val[1]            = rgb.val[1];
+        rgba.val[2]            = rgb.val[2];
+        vst4q_u8(dest + 4 * x, rgba);
+    }
+
+    LoadRGB8ToRGBA8Row(source + 3 * x, dest + 4 * x, width - x);
+}
+
+void LoadRGB8ToBGRX8RowNEON(const uint8_t *source, uint8_t *dest, size_t width)
+{
+    uint8x16x4_t bgrx;
+    bgrx.val[3] = vdupq_n_u8(0xFF);
+
+    size_t x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        const uint8x16x3_t rgb = vld3q_u8(source + 3 * x);
+        bgrx.val[0]            = rgb.val[2];
+        bgrx.val[1]            = rgb.val[1];
+        bgrx.val[2]            = rgb.val[0];
+        vst4q_u8(dest + 4 * x, bgrx);
+    }
+
+    LoadRGB8ToBGRX8Row(source + 3 * x, dest + 4 * x, width - x);
+}
+
+void LoadRGBA8ToBGRA8RowNEON(const uint8_t *source, uint8_t *dest, size_t width)
+{
+    size_t x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        uint8x16x4_t pixels  = vld4q_u8(source + 4 * x);
+        const uint8x16_t red = pixels.val[0];
+        pixels.val[0]        = pixels.val[2];
+        pixels.val[2]        = red;
+        vst4q_u8(dest + 4 * x, pixels);
+    }
+
+    LoadRGBA8ToBGRA8Row(source + 4 * x, dest + 4 * x, width - x);
+}
+
+constexpr LoadRowFunctions kNEONLoadRowFunctions = {
+    LoadA8ToRGBA8RowNEON,   LoadL8ToRGBA8RowNEON,   LoadLA8ToRGBA8RowNEON,
+    LoadRGB8ToRGBA8RowNEON, LoadRGB8ToBGRX8RowNEON, LoadRGBA8ToBGRA8RowNEON,
+};
+#endif  // defined(ANGLE_LOADIMAGE_USE_NEON)
+
+const LoadRowFunctions *SelectLoadRowFunctions()
+{
+#if defined(ANGLE_LOADIMAGE_USE_SSE2)
+    return angle::SupportsSSSE3() ? &kSSSE3LoadRowFunctions : &kSSE2LoadRowFunctions;
+#elif defined(ANGLE_LOADIMAGE_USE_NEON)
+    return &kNEONLoadRowFunctions;
+#else
+    return &kScalarLoadRowFunctions;
+#endif
+}
+}  // anonymous namespace
+
+const LoadRowFunctions &GetLoadRowFunctions()
+{
+    static const LoadRowFunctions *functions = SelectLoadRowFunctions();
+    return *functions;
+}
+
+const LoadRowFunctions &GetScalarLoadRowFunctions()
+{
+    return kScalarLoadRowFunctions;
+}
+
+void LoadRows(LoadRowFunction loadRow,
+              size_t inputPixelBytes,
+              size_t outputPixelBytes,
+              size_t width,
+              size_t height,
+              size_t depth,
+              const uint8_t *input,
+              size_t inputRowPitch,
+              size_t inputDepthPitch,
+              uint8_t *output,
+              size_t outputRowPitch,
+              size_t outputDepthPitch)
+{
+    const bool rowsPacked =
+        inputRowPitch == width * inputPixelBytes && outputRowPitch == width * outputPixelBytes;
+    const bool slicesPacked = rowsPacked && inputDepthPitch == height * inputRowPitch &&
+                              outputDepthPitch == height * outputRowPitch;
+
+    if (slicesPacked)
+    {
+        loadRow(input, output, width * height * depth);
+        return;
+    }
+
+    for (size_t z = 0; z < depth; z++)
+    {
+        const uint8_t *source = input + z * inputDepthPitch;
+        uint8_t *dest         = output + z * outputDepthPitch;
+
+        if (rowsPacked)
+        {
+            loadRow(source, dest, width * height);
+            continue;
+        }
+
+        for (size_t y = 0; y < height; y++)
+        {
+            loadRow(source, dest, width);
+            source += inputRowPitch;
+            dest += outputRowPitch;
+        }
+    }
+}
+}  // namespace priv
+}  // namespace angle
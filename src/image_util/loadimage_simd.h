@@ -0,0 +1,56 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// loadimage_simd.h: Row conversion functions behind the most common image loading functions, with
+//   vectorized implementations selected at runtime based on the CPU.
+
+#ifndef IMAGEUTIL_LOADIMAGE_SIMD_H_
+#define IMAGEUTIL_LOADIMAGE_SIMD_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace angle
+{
+namespace priv
+{
+// Converts |width| pixels from |source| to |dest|.  Neither needs to be aligned.
+using LoadRowFunction = void (*)(const uint8_t *source, uint8_t *dest, size_t width);
+
+struct LoadRowFunctions
+{
+    LoadRowFunction a8ToRGBA8;
+    LoadRowFunction l8ToRGBA8;
+    LoadRowFunction la8ToRGBA8;
+    LoadRowFunction rgb8ToRGBA8;
+    LoadRowFunction rgb8ToBGRX8;
+    LoadRowFunction rgba8ToBGRA8;
+};
+
+// The fastest implementations supported by the CPU.
+const LoadRowFunctions &GetLoadRowFunctions();
+
+// The reference implementations, which the vectorized ones must match bit for bit.
+const LoadRowFunctions &GetScalarLoadRowFunctions();
+
+// Calls |loadRow| for every row of the image.  If the rows are tightly packed, they are converted
+// with a single call instead.
+void LoadRows(LoadRowFunction loadRow,
+              size_t inputPixelBytes,
+              size_t outputPixelBytes,
+              size_t width,
+              size_t height,
+              size_t depth,
+              const uint8_t *input,
+              size_t inputRowPitch,
+              size_t inputDepthPitch,
+              uint8_t *output,
+              size_t outputRowPitch,
+              size_t outputDepthPitch);
+}  // namespace priv
+}  // namespace angle
+
+#endif  // IMAGEUTIL_LOADIMAGE_SIMD_H_
@@ -32,6 +32,7 @@ void BlobCache::put(const gl::Context *context,
     }
     else
     {
+        mFileCache.put(key, value.data(), value.size());
         populate(key, std::move(value), CacheSource::Memory);
     }
 }
@@ -125,17 +126,31 @@ bool BlobCache::get(const gl::Context *context,
         return true;
     }
 
-    std::scoped_lock<angle::SimpleMutex> lock(mBlobCacheMutex);
-    // Otherwise we are doing caching internally, so try to find it there
-    const CacheEntry *entry;
-    bool result = mBlobCache.get(key, &entry);
+    {
+        std::scoped_lock<angle::SimpleMutex> lock(mBlobCacheMutex);
+        // Otherwise we are doing caching internally, so try to find it there
+        const CacheEntry *entry;
+        if (mBlobCache.get(key, &entry))
+        {
+            *valueOut = BlobCache::Value(entry->first.data(), entry->first.size());
+            return true;
+        }
+    }
 
-    if (result)
+    // Fall back to the file cache, which may have been populated by another process.  Blobs found
+    // there are kept in memory too, so that they are read from the file only once.
+    if (scratchBuffer == nullptr || !mFileCache.get(key, scratchBuffer, valueOut))
     {
-        *valueOut = BlobCache::Value(entry->first.data(), entry->first.size());
+        return false;
     }
 
-    return result;
+    angle::MemoryBuffer value;
+    if (value.resize(valueOut->size()))
+    {
+        memcpy(value.data(), valueOut->data(), valueOut->size());
+        populate(key, std::move(value), CacheSource::Disk);
+    }
+    return true;
 }
 
 bool BlobCache::getAt(size_t index, const BlobCache::Key **keyOut, BlobCache::Value *valueOut)
@@ -181,8 +196,11 @@ BlobCache::GetAndDecompressResult BlobCache::getAndDecompress(
 
 void BlobCache::remove(const BlobCache::Key &key)
 {
-    std::scoped_lock<angle::SimpleMutex> lock(mBlobCacheMutex);
-    mBlobCache.eraseByKey(key);
+    {
+        std::scoped_lock<angle::SimpleMutex> lock(mBlobCacheMutex);
+        mBlobCache.eraseByKey(key);
+    }
+    mFileCache.remove(key);
 }
 
 void BlobCache::setBlobCacheFuncs(EGLSetBlobFuncANDROID set, EGLGetBlobFuncANDROID get)
@@ -192,6 +210,11 @@ void BlobCache::setBlobCacheFuncs(EGLSetBlobFuncANDROID set, EGLGetBlobFuncANDRO
     mGetBlobFunc = get;
 }
 
+bool BlobCache::enableFileCache(const std::string &directory, size_t maxSizeBytes)
+{
+    return mFileCache.isOpen() || mFileCache.open(directory, maxSizeBytes);
+}
+
 bool BlobCache::areBlobCacheFuncsSet() const
 {
     std::scoped_lock<angle::SimpleMutex> lock(mBlobCacheMutex);
@@ -203,7 +226,8 @@ bool BlobCache::areBlobCacheFuncsSet() const
 
 bool BlobCache::isCachingEnabled(const gl::Context *context) const
 {
-    return areBlobCacheFuncsSet() || (context && context->areBlobCacheFuncsSet()) || maxSize() > 0;
+    return areBlobCacheFuncsSet() || (context && context->areBlobCacheFuncsSet()) ||
+           maxSize() > 0 || mFileCache.isOpen();
 }
 
 size_t BlobCache::callBlobGetCallback(const gl::Context *context,
@@ -15,6 +15,7 @@
 
 #include "common/SimpleMutex.h"
 #include "libANGLE/Error.h"
+#include "libANGLE/FileBlobCache.h"
 #include "libANGLE/SizedMRUCache.h"
 #include "libANGLE/angletypes.h"
 
@@ -128,6 +129,13 @@ class BlobCache final : angle::NonCopyable
 
     void setBlobCacheFuncs(EGLSetBlobFuncANDROID set, EGLGetBlobFuncANDROID get);
 
+    // Back the internal cache with a directory on disk that is shared by all processes using it.
+    // Blobs missing from memory are looked up there, so they survive across process runs.  Does
+    // nothing if the file cache is already enabled.
+    [[nodiscard]] bool enableFileCache(const std::string &directory,
+                                       size_t maxSizeBytes = kDefaultMaxFileBlobCacheBytes);
+    bool isFileCacheEnabled() const { return mFileCache.isOpen(); }
+
     bool areBlobCacheFuncsSet() const;
 
     bool isCachingEnabled(const gl::Context *context) const;
@@ -149,6 +157,9 @@ class BlobCache final : angle::NonCopyable
 
     EGLSetBlobFuncANDROID mSetBlobFunc;
     EGLGetBlobFuncANDROID mGetBlobFunc;
+
+    // Has its own lock, and is used only if the application is not providing caching callbacks.
+    FileBlobCache mFileCache;
 };
 
 }  // namespace egl
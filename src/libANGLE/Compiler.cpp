@@ -14,6 +14,7 @@
 #include "libANGLE/State.h"
 #include "libANGLE/renderer/CompilerImpl.h"
 #include "libANGLE/renderer/GLImplFactory.h"
+#include "platform/PlatformMethods.h"
 
 namespace gl
 {
@@ -308,6 +309,7 @@ ShCompilerInstance Compiler::getInstance(ShaderType type)
     {
         ShHandle handle = sh::ConstructCompiler(ToGLenum(type), mSpec, mOutputType, &mResources);
         ASSERT(handle);
+        sh::SetPlatformMethods(handle, ANGLEPlatformCurrent());
         return ShCompilerInstance(handle, mOutputType, type);
     }
     else
@@ -1061,6 +1061,14 @@ Error Display::initialize()
         mBlobCache.resize(1024 * 1024);
     }
 
+    // Allow processes to share compiled shaders and programs through a directory on disk.  The
+    // application / system cache functions still take precedence.
+    std::string blobCacheDir = angle::GetEnvironmentVar("ANGLE_BLOB_CACHE_DIR");
+    if (!blobCacheDir.empty() && !mBlobCache.enableFileCache(blobCacheDir))
+    {
+        WARN() << "Failed to open the blob cache in " << blobCacheDir;
+    }
+
     setGlobalDebugAnnotator();
 
     gl::InitializeDebugMutexIfNeeded();
@@ -1143,7 +1151,10 @@ Error Display::initialize()
     }
 
     mState.singleThreadPool = angle::WorkerThreadPool::Create(1, ANGLEPlatformCurrent());
-    mState.multiThreadPool  = angle::WorkerThreadPool::Create(0, ANGLEPlatformCurrent());
+    mState.multiThreadPool = angle::WorkerThreadPool::Create(
+        0, ANGLEPlatformCurrent(),
+        mFrontendFeatures.useWorkStealingWorkerPool.enabled ? angle::WorkerTaskQueue::WorkStealing
+                                                            : angle::WorkerTaskQueue::Shared);
 
     if (kIsContextMutexEnabled)
     {
@@ -2379,6 +2390,12 @@ void Display::initializeFrontendFeatures()
     // Reject shaders with undefined behavior.  In the compiler, this only applies to WebGL.
     ANGLE_FEATURE_CONDITION(&mFrontendFeatures, rejectWebglShadersWithUndefinedBehavior, true);
 
+    // Opt-in until it has been evaluated on more workloads.
+    ANGLE_FEATURE_CONDITION(&mFrontendFeatures, useWorkStealingWorkerPool, false);
+
+    // Opt-in, as temporary variables are named differently than in a serial compilation.
+    ANGLE_FEATURE_CONDITION(&mFrontendFeatures, transformShaderFunctionsInParallel, false);
+
     mImplementation->initializeFrontendFeatures(&mFrontendFeatures);
 }
 
@@ -0,0 +1,682 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// FileBlobCache: A persistent store for BlobCache entries that is shared by all processes using
+//   the same directory.
+//
+// The data file starts with a FileHeader followed by records, each made of a RecordHeader and the
+// blob, padded to 8 bytes.  Records are only ever appended, by a process holding the lock on the
+// lock file.  A record is written completely before the committed size in the file
+// header is updated, so a process that dies mid-write leaves no trace.  Compaction writes a new
+// file, flags the old one as superseded and then renames the new one over it; processes that
+// still have the old file open switch to the new one the next time they look for new records.
+// The flag is written to disk before the rename, so if compaction is interrupted in between, the
+// old file is found superseded and replaced with an empty one rather than used again.  Other
+// processes only look at the flag while holding the lock, so it is cleared if the rename fails.
+// A single data file is used rather than a set of segments, so that publishing a record only
+// takes updating one header field and compaction replaces all records with one rename.
+
+#include "libANGLE/FileBlobCache.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include "common/debug.h"
+#include "common/hash_utils.h"
+#include "common/mathutil.h"
+#include "common/system_utils.h"
+
+#if defined(ANGLE_PLATFORM_POSIX)
+#    include <fcntl.h>
+#    include <sys/file.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#    include <cstdio>
+#endif  // defined(ANGLE_PLATFORM_POSIX)
+
+namespace egl
+{
+namespace
+{
+constexpr char kDataFileName[] = "angle_blob_cache";
+constexpr char kTempFileName[] = "angle_blob_cache.tmp";
+constexpr char kLockFileName[] = "angle_blob_cache.lock";
+
+constexpr uint32_t kFileMagic    = 0x43424741;  // "AGBC"
+constexpr uint32_t kFileVersion  = 1;
+constexpr uint32_t kRecordMagic  = 0x424F4C42;  // "BLOB"
+constexpr uint32_t kRecordRemove = 0x1;
+
+constexpr int kInvalidFd = -1;
+
+struct FileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    // Set once a compacted file has replaced this one.
+    uint32_t superseded;
+    uint32_t padding;
+    // The end of the last completely written record.
+    uint64_t committedSize;
+};
+static_assert(sizeof(FileHeader) % 8 == 0, "Records must be 8-byte aligned");
+
+struct RecordHeader
+{
+    uint32_t magic;
+    uint32_t flags;
+    uint64_t valueSize;
+    uint64_t checksum;
+    angle::BlobCacheKey key;
+    uint8_t padding[4];
+};
+static_assert(sizeof(RecordHeader) % 8 == 0, "Records must be 8-byte aligned");
+
+size_t GetRecordSize(size_t valueSize)
+{
+    return sizeof(RecordHeader) + rx::roundUpPow2<size_t>(valueSize, 8);
+}
+
+uint64_t ComputeChecksum(const angle::BlobCacheKey &key, const uint8_t *data, size_t size)
+{
+    const uint64_t keyHash = angle::ComputeChecksum64(key.data(), key.size());
+    return angle::ComputeChecksum64(data, size, keyHash);
+}
+
+#if defined(ANGLE_PLATFORM_POSIX)
+int OpenFile(const std::string &path, bool truncate)
+{
+    return ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC | (truncate ? O_TRUNC : 0), 0644);
+}
+
+void CloseFile(int fd)
+{
+    ::close(fd);
+}
+
+bool LockFile(int fd)
+{
+    return ::flock(fd, LOCK_EX) == 0;
+}
+
+void UnlockFile(int fd)
+{
+    ::flock(fd, LOCK_UN);
+}
+
+bool ReadAt(int fd, size_t offset, void *data, size_t size)
+{
+    return ::pread(fd, data, size, static_cast<off_t>(offset)) == static_cast<ssize_t>(size);
+}
+
+bool WriteAt(int fd, size_t offset, const void *data, size_t size)
+{
+    return ::pwrite(fd, data, size, static_cast<off_t>(offset)) == static_cast<ssize_t>(size);
+}
+
+uint8_t *MapFile(int fd, size_t size)
+{
+    void *mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    return mapping == MAP_FAILED ? nullptr : static_cast<uint8_t *>(mapping);
+}
+
+void UnmapFile(uint8_t *mapping, size_t size)
+{
+    ::munmap(mapping, size);
+}
+
+bool SyncFile(int fd)
+{
+    return ::fsync(fd) == 0;
+}
+
+bool ReplaceFile(const std::string &from, const std::string &to)
+{
+    return ::rename(from.c_str(), to.c_str()) == 0;
+}
+#else
+// Only POSIX platforms are currently supported; open() fails elsewhere.
+int OpenFile(const std::string &path, bool truncate)
+{
+    return kInvalidFd;
+}
+void CloseFile(int fd) {}
+bool LockFile(int fd)
+{
+    return false;
+}
+void UnlockFile(int fd) {}
+bool ReadAt(int fd, size_t offset, void *data, size_t size)
+{
+    return false;
+}
+bool WriteAt(int fd, size_t offset, const void *data, size_t size)
+{
+    return false;
+}
+uint8_t *MapFile(int fd, size_t size)
+{
+    return nullptr;
+}
+void UnmapFile(uint8_t *mapping, size_t size) {}
+bool SyncFile(int fd)
+{
+    return false;
+}
+bool ReplaceFile(const std::string &from, const std::string &to)
+{
+    return false;
+}
+#endif  // defined(ANGLE_PLATFORM_POSIX)
+
+class [[nodiscard]] ScopedFileLock : angle::NonCopyable
+{
+  public:
+    explicit ScopedFileLock(int fd) : mFd(fd), mLocked(LockFile(fd)) {}
+    ~ScopedFileLock()
+    {
+        if (mLocked)
+        {
+            UnlockFile(mFd);
+        }
+    }
+
+    bool isLocked() const { return mLocked; }
+
+  private:
+    int mFd;
+    bool mLocked;
+};
+
+bool WriteEmptyDataFile(int fd)
+{
+    FileHeader header    = {};
+    header.magic         = kFileMagic;
+    header.version       = kFileVersion;
+    header.committedSize = sizeof(FileHeader);
+    return WriteAt(fd, 0, &header, sizeof(header));
+}
+}  // anonymous namespace
+
+FileBlobCache::FileBlobCache()
+    : mMaxSize(0),
+      mLockFd(kInvalidFd),
+      mDataFd(kInvalidFd),
+      mMapping(nullptr),
+      mMappingSize(0),
+      mIndexedSize(0),
+      mUseCounter(0)
+{}
+
+FileBlobCache::~FileBlobCache()
+{
+    close();
+}
+
+bool FileBlobCache::open(const std::string &directory, size_t maxSizeBytes)
+{
+    std::lock_guard<angle::SimpleMutex> lock(mMutex);
+
+    ASSERT(mLockFd == kInvalidFd);
+
+    if (!angle::IsDirectory(directory.c_str()) && !angle::CreateDirectories(directory))
+    {
+        return false;
+    }
+
+    mDirectory = directory;
+    mMaxSize   = maxSizeBytes;
+
+    mLockFd = OpenFile(angle::ConcatenatePath(mDirectory, kLockFileName), false);
+    if (mLockFd == kInvalidFd)
+    {
+        return false;
+    }
+
+    ScopedFileLock fileLock(mLockFd);
+    if (!fileLock.isLocked() || !openDataFileLocked())
+    {
+        closeDataFile();
+        CloseFile(mLockFd);
+        mLockFd = kInvalidFd;
+        return false;
+    }
+
+    return true;
+}
+
+void FileBlobCache::close()
+{
+    std::lock_guard<angle::SimpleMutex> lock(mMutex);
+
+    closeDataFile();
+    if (mLockFd != kInvalidFd)
+    {
+        CloseFile(mLockFd);
+        mLockFd = kInvalidFd;
+    }
+}
+
+bool FileBlobCache::isOpen() const
+{
+    std::lock_guard<angle::SimpleMutex> lock(mMutex);
+    return mDataFd != kInvalidFd;
+}
+
+bool FileBlobCache::openDataFileLocked()
+{
+    ASSERT(mDataFd == kInvalidFd);
+
+    const std::string dataPath = angle::ConcatenatePath(mDirectory, kDataFileName);
+    mDataFd                    = OpenFile(dataPath, false);
+    if (mDataFd == kInvalidFd)
+    {
+        return false;
+    }
+
+    // Start over with an empty file if it's new or was written by an incompatible version.
+    // Other processes may still be using the existing file, so it's replaced rather than
+    // truncated.
+    FileHeader header = {};
+    if (!ReadAt(mDataFd, 0, &header, sizeof(header)) || header.magic != kFileMagic ||
+        header.version != kFileVersion || header.superseded != 0)
+    {
+        const std::string tempPath = angle::ConcatenatePath(mDirectory, kTempFileName);
+        int tempFd                 = OpenFile(tempPath, true);
+        if (tempFd == kInvalidFd)
+        {
+            return false;
+        }
+        if (!WriteEmptyDataFile(tempFd) || !ReplaceFile(tempPath, dataPath))
+        {
+            CloseFile(tempFd);
+            return false;
+        }
+
+        CloseFile(mDataFd);
+        mDataFd = tempFd;
+    }
+
+    mIndexedSize = sizeof(FileHeader);
+    return refreshLocked();
+}
+
+void FileBlobCache::closeDataFile()
+{
+    if (mMapping != nullptr)
+    {
+        UnmapFile(mMapping, mMappingSize);
+        mMapping     = nullptr;
+        mMappingSize = 0;
+    }
+    if (mDataFd != kInvalidFd)
+    {
+        CloseFile(mDataFd);
+        mDataFd = kInvalidFd;
+    }
+    mEntries.clear();
+    mIndexedSize = 0;
+}
+
+bool FileBlobCache::mapDataFile(size_t size)
+{
+    if (size <= mMappingSize)
+    {
+        return true;
+    }
+
+    if (mMapping != nullptr)
+    {
+        UnmapFile(mMapping, mMappingSize);
+        mMappingSize = 0;
+    }
+
+    mMapping = MapFile(mDataFd, size);
+    if (mMapping == nullptr)
+    {
+        return false;
+    }
+    mMappingSize = size;
+    return true;
+}
+
+bool FileBlobCache::refreshLocked()
+{
+    FileHeader header = {};
+    if (!ReadAt(mDataFd, 0, &header, sizeof(header)))
+    {
+        return false;
+    }
+
+    if (header.superseded != 0)
+    {
+        // Another process compacted the cache.  Switch to the new file, remembering which entries
+        // were recently used by this process.
+        std::vector<std::pair<angle::BlobCacheKey, uint64_t>> recentlyUsed;
+        for (const auto &entry : mEntries)
+        {
+            if (entry.second.lastUse != 0)
+            {
+                recentlyUsed.emplace_back(entry.first, entry.second.lastUse);
+            }
+        }
+
+        closeDataFile();
+        if (!openDataFileLocked())
+        {
+            return false;
+        }
+
+        for (const auto &keyAndUse : recentlyUsed)
+        {
+            auto iter = mEntries.find(keyAndUse.first);
+            if (iter != mEntries.end())
+            {
+                iter->second.lastUse = keyAndUse.second;
+            }
+        }
+        return true;
+    }
+
+    const size_t committedSize = static_cast<size_t>(header.committedSize);
+    if (committedSize <= mIndexedSize)
+    {
+        return true;
+    }
+    if (!mapDataFile(committedSize))
+    {
+        return false;
+    }
+
+    size_t offset = mIndexedSize;
+    while (offset + sizeof(RecordHeader) <= committedSize)
+    {
+        RecordHeader record;
+        memcpy(&record, mMapping + offset, sizeof(record));
+
+        const size_t recordSize = GetRecordSize(static_cast<size_t>(record.valueSize));
+        if (record.magic != kRecordMagic || recordSize > committedSize - offset)
+        {
+            // The file is corrupt; ignore the rest of it.  It will be dropped on the next
+            // compaction.
+            WARN() << "Corrupt record found in the blob cache file";
+            break;
+        }
+
+        if ((record.flags & kRecordRemove) != 0)
+        {
+            mEntries.erase(record.key);
+        }
+        else
+        {
+            // Keep the first copy if two processes raced to add the same blob.
+            mEntries.emplace(record.key, Entry{offset, static_cast<size_t>(record.valueSize), 0});
+        }
+
+        offset += recordSize;
+    }
+
+    mIndexedSize = committedSize;
+    return true;
+}
+
+bool FileBlobCache::appendRecordLocked(const angle::BlobCacheKey &key,
+                                       uint32_t flags,
+                                       const uint8_t *data,
+                                       size_t size)
+{
+    RecordHeader record = {};
+    record.magic        = kRecordMagic;
+    record.flags        = flags;
+    record.valueSize    = size;
+    record.checksum     = ComputeChecksum(key, data, size);
+    record.key          = key;
+
+    const size_t offset     = mIndexedSize;
+    const size_t recordSize = GetRecordSize(size);
+    const size_t padding    = recordSize - sizeof(RecordHeader) - size;
+
+    constexpr uint8_t kZeroPadding[8] = {};
+    if (!WriteAt(mDataFd, offset, &record, sizeof(record)) ||
+        !WriteAt(mDataFd, offset + sizeof(record), data, size) ||
+        !WriteAt(mDataFd, offset + sizeof(record) + size, kZeroPadding, padding))
+    {
+        return false;
+    }
+
+    // Commit the record.
+    const uint64_t committedSize = offset + recordSize;
+    if (!WriteAt(mDataFd, offsetof(FileHeader, committedSize), &committedSize,
+                 sizeof(committedSize)))
+    {
+        return false;
+    }
+
+    mIndexedSize = offset + recordSize;
+    return true;
+}
+
+void FileBlobCache::put(const angle::BlobCacheKey &key, const uint8_t *data, size_t size)
+{
+    std::lock_guard<angle::SimpleMutex> lock(mMutex);
+
+    if (mDataFd == kInvalidFd || GetRecordSize(size) + sizeof(FileHeader) > mMaxSize / 2)
+    {
+        return;
+    }
+
+    ScopedFileLock fileLock(mLockFd);
+    if (!fileLock.isLocked() || !refreshLocked())
+    {
+        return;
+    }
+
+    auto iter = mEntries.find(key);
+    if (iter != mEntries.end())
+    {
+        iter->second.lastUse = ++mUseCounter;
+        return;
+    }
+
+    const size_t offset = mIndexedSize;
+    if (!appendRecordLocked(key, 0, data, size))
+    {
+        return;
+    }
+    mEntries.emplace(key, Entry{offset, size, ++mUseCounter});
+
+    if (mIndexedSize > mMaxSize)
+    {
+        compactLocked();
+    }
+}
+
+bool FileBlobCache::get(const angle::BlobCacheKey &key,
+                        angle::ScratchBuffer *scratchBuffer,
+                        angle::BlobCacheValue *valueOut)
+{
+    std::lock_guard<angle::SimpleMutex> lock(mMutex);
+
+    if (mDataFd == kInvalidFd)
+    {
+        return false;
+    }
+
+    auto iter = mEntries.find(key);
+    if (iter == mEntries.end())
+    {
+        // Look for entries added by other processes.  If the data file was compacted, switching to
+        // the new one may rewrite it, so this takes the same lock as the writers.  Entries already
+        // indexed are found without taking the lock.
+        ScopedFileLock fileLock(mLockFd);
+        if (!fileLock.isLocked() || !refreshLocked())
+        {
+            return false;
+        }
+        iter = mEntries.find(key);
+        if (iter == mEntries.end())
+        {
+            return false;
+        }
+    }
+
+    Entry &entry                       = iter->second;
+    const size_t valueOffset           = entry.offset + sizeof(RecordHeader);
+    angle::MemoryBuffer *scratchMemory = nullptr;
+    if (!mapDataFile(valueOffset + entry.valueSize) ||
+        !scratchBuffer->get(entry.valueSize, &scratchMemory))
+    {
+        return false;
+    }
+
+    // Records below the committed size are never modified, so they can be read without holding
+    // the file lock.
+    RecordHeader record;
+    memcpy(&record, mMapping + entry.offset, sizeof(record));
+    memcpy(scratchMemory->data(), mMapping + valueOffset, entry.valueSize);
+
+    if (record.key != key ||
+        record.checksum != ComputeChecksum(key, scratchMemory->data(), entry.valueSize))
+    {
+        WARN() << "Corrupt blob found in the blob cache file";
+        mEntries.erase(iter);
+        return false;
+    }
+
+    entry.lastUse = ++mUseCounter;
+    *valueOut     = angle::BlobCacheValue(scratchMemory->data(), entry.valueSize);
+    return true;
+}
+
+void FileBlobCache::remove(const angle::BlobCacheKey &key)
+{
+    std::lock_guard<angle::SimpleMutex> lock(mMutex);
+
+    if (mDataFd == kInvalidFd)
+    {
+        return;
+    }
+
+    ScopedFileLock fileLock(mLockFd);
+    if (!fileLock.isLocked() || !refreshLocked() || mEntries.count(key) == 0)
+    {
+        return;
+    }
+
+    if (appendRecordLocked(key, kRecordRemove, nullptr, 0))
+    {
+        mEntries.erase(key);
+    }
+}
+
+void FileBlobCache::compact()
+{
+    std::lock_guard<angle::SimpleMutex> lock(mMutex);
+
+    if (mDataFd == kInvalidFd)
+    {
+        return;
+    }
+
+    ScopedFileLock fileLock(mLockFd);
+    if (fileLock.isLocked() && refreshLocked())
+    {
+        compactLocked();
+    }
+}
+
+void FileBlobCache::compactLocked()
+{
+    if (!mapDataFile(mIndexedSize))
+    {
+        return;
+    }
+
+    // Keep the most recently used entries, up to half the size limit so that compaction doesn't
+    // happen on every insertion.  Entries not used by this process are ordered by age.
+    std::vector<std::pair<angle::BlobCacheKey, Entry>> entries(mEntries.begin(), mEntries.end());
+    std::sort(entries.begin(), entries.end(), [](const auto &a, const auto &b) {
+        if (a.second.lastUse != b.second.lastUse)
+        {
+            return a.second.lastUse > b.second.lastUse;
+        }
+        return a.second.offset > b.second.offset;
+    });
+
+    const std::string tempPath = angle::ConcatenatePath(mDirectory, kTempFileName);
+    int tempFd                 = OpenFile(tempPath, true);
+    if (tempFd == kInvalidFd)
+    {
+        return;
+    }
+
+    std::unordered_map<angle::BlobCacheKey, Entry> keptEntries;
+    size_t newSize = sizeof(FileHeader);
+    bool success   = true;
+    for (const auto &keyAndEntry : entries)
+    {
+        const Entry &entry      = keyAndEntry.second;
+        const size_t recordSize = GetRecordSize(entry.valueSize);
+        if (newSize + recordSize > mMaxSize / 2)
+        {
+            continue;
+        }
+
+        if (!WriteAt(tempFd, newSize, mMapping + entry.offset, recordSize))
+        {
+            success = false;
+            break;
+        }
+        keptEntries.emplace(keyAndEntry.first, Entry{newSize, entry.valueSize, entry.lastUse});
+        newSize += recordSize;
+    }
+
+    FileHeader header    = {};
+    header.magic         = kFileMagic;
+    header.version       = kFileVersion;
+    header.committedSize = newSize;
+
+    if (!success || !WriteAt(tempFd, 0, &header, sizeof(header)) || !SyncFile(tempFd))
+    {
+        CloseFile(tempFd);
+        return;
+    }
+
+    // Let the other processes know they need to switch to the new file.  This is done before the
+    // rename, so that the old file is never left in place without the flag.
+    const std::string dataPath = angle::ConcatenatePath(mDirectory, kDataFileName);
+    uint32_t superseded        = 1;
+    if (!WriteAt(mDataFd, offsetof(FileHeader, superseded), &superseded, sizeof(superseded)) ||
+        !SyncFile(mDataFd) || !ReplaceFile(tempPath, dataPath))
+    {
+        // Other processes only read the flag while holding the lock, so none has seen it yet.
+        superseded = 0;
+        WriteAt(mDataFd, offsetof(FileHeader, superseded), &superseded, sizeof(superseded));
+        CloseFile(tempFd);
+        return;
+    }
+
+    closeDataFile();
+    mDataFd      = tempFd;
+    mEntries     = std::move(keptEntries);
+    mIndexedSize = newSize;
+}
+
+size_t FileBlobCache::entryCount() const
+{
+    std::lock_guard<angle::SimpleMutex> lock(mMutex);
+    return mEntries.size();
+}
+
+size_t FileBlobCache::size() const
+{
+    std::lock_guard<angle::SimpleMutex> lock(mMutex);
+    return mIndexedSize;
+}
+
+}  // namespace egl
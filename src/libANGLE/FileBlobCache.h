@@ -0,0 +1,104 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// FileBlobCache: A persistent store for BlobCache entries that is shared by all processes using
+//   the same directory.  Entries are appended to a memory-mapped data file that is only ever
+//   grown, and each process indexes the entries lazily, including those appended by other
+//   processes.  Once the file grows past its size limit, the most recently used entries are
+//   compacted into a new file which atomically replaces the old one.
+
+#ifndef LIBANGLE_FILE_BLOB_CACHE_H_
+#define LIBANGLE_FILE_BLOB_CACHE_H_
+
+#include <string>
+#include <unordered_map>
+
+#include "common/MemoryBuffer.h"
+#include "common/SimpleMutex.h"
+#include "libANGLE/angletypes.h"
+
+namespace egl
+{
+// Default size limit of the data file.
+constexpr size_t kDefaultMaxFileBlobCacheBytes = 64 * 1024 * 1024;
+
+class FileBlobCache final : angle::NonCopyable
+{
+  public:
+    FileBlobCache();
+    ~FileBlobCache();
+
+    // Opens the cache in |directory|, creating it if needed.  Returns false if the directory
+    // cannot be used, in which case the cache stays closed and all operations are no-ops.
+    [[nodiscard]] bool open(const std::string &directory, size_t maxSizeBytes);
+    void close();
+    bool isOpen() const;
+
+    // Appends a key-blob pair to the cache, unless the key is already present.  Since keys are
+    // hashes of the blob contents' inputs, an existing entry is never replaced.
+    void put(const angle::BlobCacheKey &key, const uint8_t *data, size_t size);
+
+    // Looks the key up, including entries recently added by other processes, and copies the blob
+    // to |scratchBuffer|.  |valueOut| points to the scratch memory.
+    [[nodiscard]] bool get(const angle::BlobCacheKey &key,
+                           angle::ScratchBuffer *scratchBuffer,
+                           angle::BlobCacheValue *valueOut);
+
+    // Marks an entry as removed, for example because it was found to be invalid.
+    void remove(const angle::BlobCacheKey &key);
+
+    // Rewrites the data file to only contain the most recently used entries, up to half the size
+    // limit.  This is done automatically when the limit is exceeded.
+    void compact();
+
+    // Returns the number of entries known to this process.
+    size_t entryCount() const;
+
+    // Returns the size of the data file in bytes.
+    size_t size() const;
+
+  private:
+    struct Entry
+    {
+        // Offset of the record header in the data file.
+        size_t offset;
+        size_t valueSize;
+        // Used to keep the most recently used entries on compaction.  Entries only known through
+        // other processes are ordered by their position in the file.
+        uint64_t lastUse;
+    };
+
+    bool openDataFileLocked();
+    void closeDataFile();
+    bool mapDataFile(size_t size);
+    // Indexes the records appended since the last refresh, switching to a new data file if the
+    // current one was replaced by a compaction.  The file lock must be held, as the new data file
+    // may be rewritten.
+    bool refreshLocked();
+    bool appendRecordLocked(const angle::BlobCacheKey &key,
+                            uint32_t flags,
+                            const uint8_t *data,
+                            size_t size);
+    void compactLocked();
+
+    mutable angle::SimpleMutex mMutex;
+
+    std::string mDirectory;
+    size_t mMaxSize;
+
+    int mLockFd;
+    int mDataFd;
+    uint8_t *mMapping;
+    size_t mMappingSize;
+    // The end of the last record that was indexed.
+    size_t mIndexedSize;
+
+    std::unordered_map<angle::BlobCacheKey, Entry> mEntries;
+    uint64_t mUseCounter;
+};
+
+}  // namespace egl
+
+#endif  // LIBANGLE_FILE_BLOB_CACHE_H_
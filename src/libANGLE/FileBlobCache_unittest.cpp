@@ -0,0 +1,316 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// FileBlobCache_unittest.cpp: Unit tests for the file-backed blob cache.
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+
+#include "common/platform.h"
+#include "common/system_utils.h"
+#include "libANGLE/BlobCache.h"
+#include "libANGLE/FileBlobCache.h"
+
+#if defined(ANGLE_PLATFORM_POSIX)
+
+namespace egl
+{
+namespace
+{
+using Blob = angle::MemoryBuffer;
+using Key  = angle::BlobCacheKey;
+
+template <typename T>
+void MakeSequence(T &seq, uint8_t start)
+{
+    for (size_t i = 0; i < seq.size(); ++i)
+    {
+        seq[i] = static_cast<uint8_t>(i + start);
+    }
+}
+
+Blob MakeBlob(size_t size, uint8_t start = 0)
+{
+    Blob blob;
+    EXPECT_TRUE(blob.resize(size));
+    MakeSequence(blob, start);
+    return blob;
+}
+
+Key MakeKey(uint8_t start = 0)
+{
+    Key key;
+    MakeSequence(key, start);
+    return key;
+}
+
+constexpr const char *kFileNames[] = {"angle_blob_cache", "angle_blob_cache.tmp",
+                                      "angle_blob_cache.lock"};
+
+class FileBlobCacheTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        Optional<std::string> tempFile = angle::CreateTemporaryFile();
+        ASSERT_TRUE(tempFile.valid());
+        std::remove(tempFile.value().c_str());
+        mDirectory = tempFile.value();
+    }
+
+    void TearDown() override
+    {
+        for (const char *fileName : kFileNames)
+        {
+            std::remove(angle::ConcatenatePath(mDirectory, fileName).c_str());
+        }
+        std::remove(mDirectory.c_str());
+    }
+
+    void put(FileBlobCache *cache, uint8_t keyStart, size_t size)
+    {
+        Blob blob = MakeBlob(size, keyStart);
+        cache->put(MakeKey(keyStart), blob.data(), blob.size());
+    }
+
+    // Checks that the blob with the given key is in the cache and has the expected contents.
+    bool hasBlob(FileBlobCache *cache, uint8_t keyStart, size_t size)
+    {
+        angle::ScratchBuffer scratchBuffer;
+        angle::BlobCacheValue value;
+        if (!cache->get(MakeKey(keyStart), &scratchBuffer, &value))
+        {
+            return false;
+        }
+        Blob expected = MakeBlob(size, keyStart);
+        return value.size() == size && memcmp(value.data(), expected.data(), size) == 0;
+    }
+
+    std::string mDirectory;
+};
+
+// Test that blobs can be stored and retrieved.
+TEST_F(FileBlobCacheTest, PutAndGet)
+{
+    FileBlobCache cache;
+    ASSERT_TRUE(cache.open(mDirectory, kDefaultMaxFileBlobCacheBytes));
+    EXPECT_EQ(0u, cache.entryCount());
+
+    put(&cache, 0, 100);
+    put(&cache, 1, 3);
+    put(&cache, 2, 1);
+    EXPECT_EQ(3u, cache.entryCount());
+
+    EXPECT_TRUE(hasBlob(&cache, 0, 100));
+    EXPECT_TRUE(hasBlob(&cache, 1, 3));
+    EXPECT_TRUE(hasBlob(&cache, 2, 1));
+    EXPECT_FALSE(hasBlob(&cache, 3, 100));
+
+    // Putting an existing key doesn't grow the file.
+    const size_t size = cache.size();
+    put(&cache, 0, 100);
+    EXPECT_EQ(size, cache.size());
+}
+
+// Test that blobs persist after the cache is closed, and are visible to other instances using the
+// same directory, as they would be across processes.
+TEST_F(FileBlobCacheTest, SharedBetweenInstances)
+{
+    FileBlobCache first;
+    ASSERT_TRUE(first.open(mDirectory, kDefaultMaxFileBlobCacheBytes));
+    put(&first, 0, 64);
+
+    FileBlobCache second;
+    ASSERT_TRUE(second.open(mDirectory, kDefaultMaxFileBlobCacheBytes));
+    EXPECT_TRUE(hasBlob(&second, 0, 64));
+
+    // Entries added after opening are found too.
+    put(&first, 1, 32);
+    EXPECT_TRUE(hasBlob(&second, 1, 32));
+    put(&second, 2, 16);
+    EXPECT_TRUE(hasBlob(&first, 2, 16));
+
+    first.close();
+    second.close();
+
+    FileBlobCache third;
+    ASSERT_TRUE(third.open(mDirectory, kDefaultMaxFileBlobCacheBytes));
+    EXPECT_EQ(3u, third.entryCount());
+    EXPECT_TRUE(hasBlob(&third, 0, 64));
+    EXPECT_TRUE(hasBlob(&third, 1, 32));
+    EXPECT_TRUE(hasBlob(&third, 2, 16));
+}
+
+// Test that removed blobs are not found by any instance.
+TEST_F(FileBlobCacheTest, Remove)
+{
+    FileBlobCache first;
+    ASSERT_TRUE(first.open(mDirectory, kDefaultMaxFileBlobCacheBytes));
+    FileBlobCache second;
+    ASSERT_TRUE(second.open(mDirectory, kDefaultMaxFileBlobCacheBytes));
+
+    put(&first, 0, 64);
+    put(&first, 1, 64);
+    EXPECT_TRUE(hasBlob(&second, 0, 64));
+
+    first.remove(MakeKey(0));
+    EXPECT_FALSE(hasBlob(&first, 0, 64));
+
+    // The second instance only notices the removal when it looks for new records.
+    EXPECT_TRUE(hasBlob(&second, 1, 64));
+    put(&second, 2, 64);
+    EXPECT_FALSE(hasBlob(&second, 0, 64));
+
+    // The blob can be added again.
+    put(&second, 0, 64);
+    EXPECT_TRUE(hasBlob(&first, 0, 64));
+}
+
+// Test that exceeding the size limit keeps the most recently used blobs, and that other instances
+// switch to the compacted file.
+TEST_F(FileBlobCacheTest, Compaction)
+{
+    constexpr size_t kMaxSize  = 16 * 1024;
+    constexpr size_t kBlobSize = 1000;
+
+    FileBlobCache first;
+    ASSERT_TRUE(first.open(mDirectory, kMaxSize));
+    FileBlobCache second;
+    ASSERT_TRUE(second.open(mDirectory, kMaxSize));
+
+    for (uint8_t i = 0; i < 12; ++i)
+    {
+        put(&first, i, kBlobSize);
+    }
+    // Make the oldest blob the most recently used one.
+    EXPECT_TRUE(hasBlob(&first, 0, kBlobSize));
+    EXPECT_EQ(12u, first.entryCount());
+
+    for (uint8_t i = 12; i < 20; ++i)
+    {
+        put(&first, i, kBlobSize);
+    }
+
+    EXPECT_LE(first.size(), kMaxSize);
+    EXPECT_LT(first.entryCount(), 20u);
+    EXPECT_TRUE(hasBlob(&first, 0, kBlobSize));
+    EXPECT_TRUE(hasBlob(&first, 19, kBlobSize));
+    EXPECT_FALSE(hasBlob(&first, 1, kBlobSize));
+
+    // The second instance finds the blobs in the new file.
+    EXPECT_TRUE(hasBlob(&second, 19, kBlobSize));
+    EXPECT_EQ(first.entryCount(), second.entryCount());
+    put(&second, 20, kBlobSize);
+    EXPECT_TRUE(hasBlob(&first, 20, kBlobSize));
+}
+
+// Test that a data file flagged as superseded, as left by a compaction that was interrupted before
+// renaming the new file over it, is not used again.
+TEST_F(FileBlobCacheTest, InterruptedCompaction)
+{
+    FileBlobCache cache;
+    ASSERT_TRUE(cache.open(mDirectory, kDefaultMaxFileBlobCacheBytes));
+    put(&cache, 0, 64);
+
+    // Set the superseded field, which follows the magic and version of the file header.
+    const std::string dataPath = angle::ConcatenatePath(mDirectory, kFileNames[0]);
+    FILE *file                 = fopen(dataPath.c_str(), "r+b");
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(0, fseek(file, 2 * sizeof(uint32_t), SEEK_SET));
+    const uint32_t superseded = 1;
+    fwrite(&superseded, sizeof(superseded), 1, file);
+    fclose(file);
+
+    FileBlobCache other;
+    ASSERT_TRUE(other.open(mDirectory, kDefaultMaxFileBlobCacheBytes));
+    EXPECT_EQ(0u, other.entryCount());
+    EXPECT_FALSE(hasBlob(&other, 0, 64));
+
+    // The instance that had the file open switches to the new one when it looks for new records.
+    put(&other, 1, 64);
+    EXPECT_TRUE(hasBlob(&cache, 1, 64));
+    EXPECT_EQ(1u, cache.entryCount());
+}
+
+// Test that a record that was not completely written, for example because the process was killed,
+// is ignored and overwritten.
+TEST_F(FileBlobCacheTest, IncompleteRecord)
+{
+    {
+        FileBlobCache cache;
+        ASSERT_TRUE(cache.open(mDirectory, kDefaultMaxFileBlobCacheBytes));
+        put(&cache, 0, 64);
+    }
+
+    // Append a partial record past the committed size.
+    const std::string dataPath = angle::ConcatenatePath(mDirectory, kFileNames[0]);
+    FILE *file                 = fopen(dataPath.c_str(), "ab");
+    ASSERT_NE(file, nullptr);
+    Blob garbage = MakeBlob(50, 0xAB);
+    fwrite(garbage.data(), 1, garbage.size(), file);
+    fclose(file);
+
+    FileBlobCache cache;
+    ASSERT_TRUE(cache.open(mDirectory, kDefaultMaxFileBlobCacheBytes));
+    EXPECT_EQ(1u, cache.entryCount());
+    EXPECT_TRUE(hasBlob(&cache, 0, 64));
+
+    put(&cache, 1, 64);
+    EXPECT_TRUE(hasBlob(&cache, 1, 64));
+
+    FileBlobCache other;
+    ASSERT_TRUE(other.open(mDirectory, kDefaultMaxFileBlobCacheBytes));
+    EXPECT_EQ(2u, other.entryCount());
+}
+
+// Test that a corrupt blob is detected and not returned.
+TEST_F(FileBlobCacheTest, CorruptBlob)
+{
+    FileBlobCache cache;
+    ASSERT_TRUE(cache.open(mDirectory, kDefaultMaxFileBlobCacheBytes));
+    put(&cache, 0, 64);
+
+    // Flip the last byte of the blob, which is at the end of the file.
+    const std::string dataPath = angle::ConcatenatePath(mDirectory, kFileNames[0]);
+    FILE *file                 = fopen(dataPath.c_str(), "r+b");
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(0, fseek(file, -1, SEEK_END));
+    const uint8_t corrupt = 0xFF;
+    fwrite(&corrupt, 1, 1, file);
+    fclose(file);
+
+    EXPECT_FALSE(hasBlob(&cache, 0, 64));
+}
+
+// Test that BlobCache keeps the blobs it finds in the file cache in memory.
+TEST_F(FileBlobCacheTest, BlobCacheKeepsFileHitsInMemory)
+{
+    {
+        FileBlobCache cache;
+        ASSERT_TRUE(cache.open(mDirectory, kDefaultMaxFileBlobCacheBytes));
+        put(&cache, 0, 64);
+    }
+
+    BlobCache blobCache(1024);
+    ASSERT_TRUE(blobCache.enableFileCache(mDirectory));
+    EXPECT_EQ(0u, blobCache.entryCount());
+
+    angle::ScratchBuffer scratchBuffer;
+    BlobCache::Value value;
+    ASSERT_TRUE(blobCache.get(nullptr, &scratchBuffer, MakeKey(0), &value));
+    EXPECT_EQ(64u, value.size());
+    EXPECT_EQ(1u, blobCache.entryCount());
+
+    // The blob is now found without a scratch buffer, which only the file cache needs.
+    ASSERT_TRUE(blobCache.get(nullptr, nullptr, MakeKey(0), &value));
+    Blob expected = MakeBlob(64, 0);
+    ASSERT_EQ(64u, value.size());
+    EXPECT_EQ(0, memcmp(value.data(), expected.data(), value.size()));
+}
+}  // anonymous namespace
+}  // namespace egl
+
+#endif  // defined(ANGLE_PLATFORM_POSIX)
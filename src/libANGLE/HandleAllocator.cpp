@@ -10,33 +10,40 @@
 #include "libANGLE/HandleAllocator.h"
 
 #include <algorithm>
-#include <functional>
 #include <limits>
 
 #include "common/debug.h"
+#include "common/mathutil.h"
 
 namespace gl
 {
 
-struct HandleAllocator::HandleRangeComparator
+namespace
 {
-    bool operator()(const HandleRange &range, GLuint handle) const { return (range.end < handle); }
-};
-
-HandleAllocator::HandleAllocator()
-    : mBaseValue(1),
-      mNextValue(1),
-      mMaxValue(std::numeric_limits<GLuint>::max()),
-      mLoggingEnabled(false)
+constexpr size_t kBitsPerWord = 64;
+// The bitmap grows by at least a full word of mFreeHandleWords at a time.
+constexpr size_t kMinBitmapCapacity = kBitsPerWord * kBitsPerWord;
+// Reserving a handle past the bitmap grows the bitmap up to this many handles.  Larger handles are
+// kept in a list instead of growing the bitmap to gigabytes.
+constexpr size_t kMaxBitmapCapacityForReserve = 1 << 22;
+
+constexpr uint64_t Bit(size_t index)
 {
-    mUnallocatedList.push_back(HandleRange(1, mMaxValue));
+    return uint64_t(1) << (index % kBitsPerWord);
 }
+}  // anonymous namespace
+
+HandleAllocator::HandleAllocator() : HandleAllocator(std::numeric_limits<GLuint>::max()) {}
 
 HandleAllocator::HandleAllocator(GLuint maximumHandleValue)
-    : mBaseValue(1), mNextValue(1), mMaxValue(maximumHandleValue), mLoggingEnabled(false)
-{
-    mUnallocatedList.push_back(HandleRange(1, mMaxValue));
-}
+    : mBaseValue(1),
+      mNextValue(1),
+      mMaxValue(maximumHandleValue),
+      mFirstFreeHandleWord(0),
+      mBitmapCapacity(0),
+      mAllocatedCount(0),
+      mLoggingEnabled(false)
+{}
 
 HandleAllocator::~HandleAllocator() {}
 
@@ -47,46 +54,107 @@ void HandleAllocator::setBaseHandle(GLuint value)
     mNextValue = value;
 }
 
-GLuint HandleAllocator::allocate()
+void HandleAllocator::growBitmap(size_t handle)
 {
-    ASSERT(!mUnallocatedList.empty() || !mReleasedList.empty());
+    ASSERT(handle > mBitmapCapacity && handle <= mMaxValue);
 
-    // Allocate from released list, logarithmic time for pop_heap.
-    if (!mReleasedList.empty())
+    size_t newCapacity = std::max(kMinBitmapCapacity, mBitmapCapacity * 2);
+    while (newCapacity < handle)
     {
-        std::pop_heap(mReleasedList.begin(), mReleasedList.end(), std::greater<GLuint>());
-        GLuint reusedHandle = mReleasedList.back();
-        mReleasedList.pop_back();
+        newCapacity *= 2;
+    }
+    newCapacity = std::min<size_t>(newCapacity, mMaxValue);
 
-        if (mLoggingEnabled)
+    const size_t wordCount = (newCapacity + kBitsPerWord - 1) / kBitsPerWord;
+    mFreeHandles.resize(wordCount, 0);
+    mFreeHandleWords.resize((wordCount + kBitsPerWord - 1) / kBitsPerWord, 0);
+
+    // Mark the new handles free, a word at a time.
+    size_t index = mBitmapCapacity;
+    mFirstFreeHandleWord = std::min(mFirstFreeHandleWord, index / kBitsPerWord / kBitsPerWord);
+    while (index < newCapacity)
+    {
+        const size_t word      = index / kBitsPerWord;
+        const size_t bit       = index % kBitsPerWord;
+        const size_t bitCount  = std::min(kBitsPerWord - bit, newCapacity - index);
+        const uint64_t allBits = std::numeric_limits<uint64_t>::max();
+        const uint64_t mask    = bitCount == kBitsPerWord ? allBits : (Bit(bitCount) - 1) << bit;
+
+        mFreeHandles[word] |= mask;
+        mFreeHandleWords[word / kBitsPerWord] |= Bit(word);
+        index += bitCount;
+    }
+    mBitmapCapacity = newCapacity;
+
+    // Move the reserved handles the bitmap now covers into it.
+    auto coveredEnd = std::upper_bound(mReservedPastBitmap.begin(), mReservedPastBitmap.end(),
+                                       static_cast<GLuint>(newCapacity));
+    for (auto handleIt = mReservedPastBitmap.begin(); handleIt != coveredEnd; ++handleIt)
+    {
+        markAllocated(*handleIt - 1);
+    }
+    mReservedPastBitmap.erase(mReservedPastBitmap.begin(), coveredEnd);
+}
+
+GLuint HandleAllocator::findLowestFreeHandle()
+{
+    for (; mFirstFreeHandleWord < mFreeHandleWords.size(); ++mFirstFreeHandleWord)
+    {
+        const uint64_t freeWords = mFreeHandleWords[mFirstFreeHandleWord];
+        if (freeWords != 0)
         {
-            WARN() << "HandleAllocator::allocate reusing " << reusedHandle << std::endl;
+            const size_t word = mFirstFreeHandleWord * kBitsPerWord + gl::ScanForward(freeWords);
+            ASSERT(mFreeHandles[word] != 0);
+            const size_t index = word * kBitsPerWord + gl::ScanForward(mFreeHandles[word]);
+            return static_cast<GLuint>(index + 1);
         }
-
-        return reusedHandle;
     }
+    return 0;
+}
 
-    // Allocate from unallocated list, constant time.
-    auto listIt = mUnallocatedList.begin();
+void HandleAllocator::markFree(size_t index)
+{
+    const size_t word = index / kBitsPerWord;
+    ASSERT((mFreeHandles[word] & Bit(index)) == 0);
 
-    GLuint freeListHandle = listIt->begin;
-    ASSERT(freeListHandle > 0);
+    mFreeHandles[word] |= Bit(index);
+    mFreeHandleWords[word / kBitsPerWord] |= Bit(word);
+    mFirstFreeHandleWord = std::min(mFirstFreeHandleWord, word / kBitsPerWord);
+}
 
-    if (listIt->begin == listIt->end)
+void HandleAllocator::markAllocated(size_t index)
+{
+    const size_t word = index / kBitsPerWord;
+    ASSERT((mFreeHandles[word] & Bit(index)) != 0);
+
+    mFreeHandles[word] &= ~Bit(index);
+    if (mFreeHandles[word] == 0)
     {
-        mUnallocatedList.erase(listIt);
+        mFreeHandleWords[word / kBitsPerWord] &= ~Bit(word);
     }
-    else
+}
+
+GLuint HandleAllocator::allocate()
+{
+    ASSERT(anyHandleAvailableForAllocation());
+
+    // The lowest free handle is in the bitmap, unless all of its handles are allocated.
+    GLuint handle = findLowestFreeHandle();
+    while (handle == 0)
     {
-        listIt->begin++;
+        growBitmap(mBitmapCapacity + 1);
+        handle = findLowestFreeHandle();
     }
 
+    markAllocated(handle - 1);
+    ++mAllocatedCount;
+
     if (mLoggingEnabled)
     {
-        WARN() << "HandleAllocator::allocate allocating " << freeListHandle << std::endl;
+        WARN() << "HandleAllocator::allocate allocating " << handle << std::endl;
     }
 
-    return freeListHandle;
+    return handle;
 }
 
 void HandleAllocator::release(GLuint handle)
@@ -96,25 +164,28 @@ void HandleAllocator::release(GLuint handle)
         WARN() << "HandleAllocator::release releasing " << handle << std::endl;
     }
 
-    // Try consolidating the ranges first.
-    for (HandleRange &handleRange : mUnallocatedList)
-    {
-        if (handleRange.begin - 1 == handle)
-        {
-            handleRange.begin--;
-            return;
-        }
+    ASSERT(handle > 0 && handle <= mMaxValue);
+    ASSERT(mAllocatedCount > 0);
 
-        if (handleRange.end == handle - 1)
+    if (handle > mBitmapCapacity)
+    {
+        auto handleIt =
+            std::lower_bound(mReservedPastBitmap.begin(), mReservedPastBitmap.end(), handle);
+        const bool found = handleIt != mReservedPastBitmap.end() && *handleIt == handle;
+        ASSERT(found);
+        // Don't erase another handle, or past the end, if the handle was not allocated.
+        if (!found)
         {
-            handleRange.end++;
             return;
         }
+        mReservedPastBitmap.erase(handleIt);
+    }
+    else
+    {
+        markFree(handle - 1);
     }
 
-    // Add to released list, logarithmic time for push_heap.
-    mReleasedList.push_back(handle);
-    std::push_heap(mReleasedList.begin(), mReleasedList.end(), std::greater<GLuint>());
+    --mAllocatedCount;
 }
 
 void HandleAllocator::reserve(GLuint handle)
@@ -124,65 +195,40 @@ void HandleAllocator::reserve(GLuint handle)
         WARN() << "HandleAllocator::reserve reserving " << handle << std::endl;
     }
 
-    // Clear from released list -- might be a slow operation.
-    if (!mReleasedList.empty())
-    {
-        auto releasedIt = std::find(mReleasedList.begin(), mReleasedList.end(), handle);
-        if (releasedIt != mReleasedList.end())
-        {
-            mReleasedList.erase(releasedIt);
-            std::make_heap(mReleasedList.begin(), mReleasedList.end(), std::greater<GLuint>());
-            return;
-        }
-    }
-
-    // Not in released list, reserve in the unallocated list.
-    auto boundIt = std::lower_bound(mUnallocatedList.begin(), mUnallocatedList.end(), handle,
-                                    HandleRangeComparator());
-
-    ASSERT(boundIt != mUnallocatedList.end());
+    ASSERT(handle > 0 && handle <= mMaxValue);
+    ++mAllocatedCount;
 
-    GLuint begin = boundIt->begin;
-    GLuint end   = boundIt->end;
-
-    if (handle == begin || handle == end)
+    if (handle > mBitmapCapacity)
     {
-        if (begin == end)
-        {
-            mUnallocatedList.erase(boundIt);
-        }
-        else if (handle == begin)
+        if (handle > kMaxBitmapCapacityForReserve)
         {
-            boundIt->begin++;
-        }
-        else
-        {
-            ASSERT(handle == end);
-            boundIt->end--;
+            auto handleIt =
+                std::lower_bound(mReservedPastBitmap.begin(), mReservedPastBitmap.end(), handle);
+            ASSERT(handleIt == mReservedPastBitmap.end() || *handleIt != handle);
+            mReservedPastBitmap.insert(handleIt, handle);
+            return;
         }
-        return;
+        growBitmap(handle);
     }
 
-    ASSERT(begin < handle && handle < end);
-
-    // need to split the range
-    auto placementIt = mUnallocatedList.erase(boundIt);
-    placementIt      = mUnallocatedList.insert(placementIt, HandleRange(handle + 1, end));
-    mUnallocatedList.insert(placementIt, HandleRange(begin, handle - 1));
+    markAllocated(handle - 1);
 }
 
 void HandleAllocator::reset()
 {
-    mUnallocatedList.clear();
-    mUnallocatedList.push_back(HandleRange(1, mMaxValue));
-    mReleasedList.clear();
-    mBaseValue = 1;
-    mNextValue = 1;
+    mFreeHandles.clear();
+    mFreeHandleWords.clear();
+    mReservedPastBitmap.clear();
+    mFirstFreeHandleWord = 0;
+    mBitmapCapacity      = 0;
+    mAllocatedCount      = 0;
+    mBaseValue           = 1;
+    mNextValue           = 1;
 }
 
 bool HandleAllocator::anyHandleAvailableForAllocation() const
 {
-    return !mUnallocatedList.empty() || !mReleasedList.empty();
+    return mAllocatedCount < mMaxValue;
 }
 
 void HandleAllocator::enableLogging(bool enabled)
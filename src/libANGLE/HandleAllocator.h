@@ -38,26 +38,32 @@ class HandleAllocator final : angle::NonCopyable
     void enableLogging(bool enabled);
 
   private:
+    // Makes the bitmap cover at least the handles up to |handle|.
+    void growBitmap(size_t handle);
+    // Returns the lowest free handle in the bitmap, or 0 if there is none.
+    GLuint findLowestFreeHandle();
+    void markFree(size_t index);
+    void markAllocated(size_t index);
+
     GLuint mBaseValue;
     GLuint mNextValue;
     const GLuint mMaxValue;
 
-    // Represents an inclusive range [begin, end]
-    struct HandleRange
-    {
-        HandleRange(GLuint beginIn, GLuint endIn) : begin(beginIn), end(endIn) {}
-
-        GLuint begin;
-        GLuint end;
-    };
-
-    struct HandleRangeComparator;
-
-    // The freelist consists of never-allocated handles, stored
-    // as ranges, and handles that were previously allocated and
-    // released, stored in a heap.
-    std::vector<HandleRange> mUnallocatedList;
-    std::vector<GLuint> mReleasedList;
+    // Free handles are tracked in a two-level bitmap.  Bit i of mFreeHandles is set if handle i + 1
+    // is free, and bit i of mFreeHandleWords is set if mFreeHandles[i] is not zero, so that the
+    // lowest free handle is found with two find-first-set operations.
+    std::vector<uint64_t> mFreeHandles;
+    std::vector<uint64_t> mFreeHandleWords;
+    // All words of mFreeHandleWords before this one are zero.
+    size_t mFirstFreeHandleWord;
+
+    // The bitmap covers handles up to mBitmapCapacity and grows on demand.  Handles past it are
+    // free, except for the ones in mReservedPastBitmap, a sorted list of reserved handles that were
+    // too large to grow the bitmap for.
+    size_t mBitmapCapacity;
+    std::vector<GLuint> mReservedPastBitmap;
+
+    size_t mAllocatedCount;
 
     bool mLoggingEnabled;
 };
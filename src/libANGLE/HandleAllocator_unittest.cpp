@@ -243,4 +243,75 @@ TEST(HandleAllocatorTest, ConsolidateRangeDuringRelease)
     EXPECT_NE(handle, static_cast<GLuint>(-1));
 }
 
+// Tests that the lowest free handle is always allocated first.
+TEST(HandleAllocatorTest, LowestHandleFirst)
+{
+    gl::HandleAllocator allocator;
+
+    constexpr GLuint kHandleCount = 10000;
+    for (GLuint handle = 1; handle <= kHandleCount; ++handle)
+    {
+        EXPECT_EQ(handle, allocator.allocate());
+    }
+
+    // Release handles in decreasing order, in different words of the bitmap.
+    allocator.release(9000);
+    allocator.release(5000);
+    allocator.release(70);
+    allocator.release(3);
+
+    EXPECT_EQ(3u, allocator.allocate());
+    EXPECT_EQ(70u, allocator.allocate());
+    EXPECT_EQ(5000u, allocator.allocate());
+    EXPECT_EQ(9000u, allocator.allocate());
+    EXPECT_EQ(kHandleCount + 1, allocator.allocate());
+}
+
+// Tests reserving handles far past the allocated ones, then allocating up to them.
+TEST(HandleAllocatorTest, ReserveLargeHandles)
+{
+    gl::HandleAllocator allocator;
+
+    constexpr GLuint kLargeHandle = 5000000;
+    allocator.reserve(kLargeHandle);
+    allocator.reserve(kLargeHandle + 2);
+    allocator.reserve(64);
+
+    EXPECT_EQ(1u, allocator.allocate());
+    allocator.release(kLargeHandle + 2);
+
+    // Handles around the reserved ones are still allocated in order once the allocations reach
+    // them.
+    GLuint handle = 0;
+    for (GLuint expected = 2; expected < kLargeHandle + 4; ++expected)
+    {
+        if (expected == 64 || expected == kLargeHandle)
+        {
+            continue;
+        }
+        handle = allocator.allocate();
+        ASSERT_EQ(expected, handle);
+    }
+}
+
+// Tests that handles are available until every handle up to the maximum is allocated.
+TEST(HandleAllocatorTest, AllocateAllHandles)
+{
+    constexpr GLuint kMaxHandle = 5000;
+    gl::HandleAllocator allocator(kMaxHandle);
+
+    allocator.reserve(kMaxHandle);
+    for (GLuint handle = 1; handle < kMaxHandle; ++handle)
+    {
+        ASSERT_TRUE(allocator.anyHandleAvailableForAllocation());
+        EXPECT_EQ(handle, allocator.allocate());
+    }
+    EXPECT_FALSE(allocator.anyHandleAvailableForAllocation());
+
+    allocator.release(4097);
+    EXPECT_TRUE(allocator.anyHandleAvailableForAllocation());
+    EXPECT_EQ(4097u, allocator.allocate());
+    EXPECT_FALSE(allocator.anyHandleAvailableForAllocation());
+}
+
 }  // anonymous namespace
@@ -531,6 +531,20 @@ void AppendWidgetDataHelper::AppendVulkanDescriptorCacheKeySize(const overlay::W
     AppendTextCommon(widget, imageExtent, text.str(), textWidget, widgetCounts);
 }
 
+void AppendWidgetDataHelper::AppendVulkanCommandMemorySize(const overlay::Widget *widget,
+                                                           const gl::Extents &imageExtent,
+                                                           TextWidgetData *textWidget,
+                                                           GraphWidgetData *graphWidget,
+                                                           OverlayWidgetCounts *widgetCounts)
+{
+    const overlay::Count *countWidget = static_cast<const overlay::Count *>(widget);
+    std::ostringstream text;
+    double kb = static_cast<double>(countWidget->count) / 1000.0;
+    text << "Command Memory: " << std::fixed << std::setprecision(1) << kb << " kb";
+
+    AppendTextCommon(widget, imageExtent, text.str(), textWidget, widgetCounts);
+}
+
 void AppendWidgetDataHelper::AppendVulkanAttemptedSubmissions(const overlay::Widget *widget,
                                                               const gl::Extents &imageExtent,
                                                               TextWidgetData *textWidget,
@@ -535,6 +535,30 @@ void Overlay::initOverlayWidgets()
         mState.mOverlayWidgets[WidgetId::VulkanDescriptorCacheKeySize].reset(widget);
     }
 
+    {
+        Count *widget = new Count;
+        {
+            const int32_t fontSize = GetFontSize(kFontMipSmall, kLargeFont);
+            const int32_t offsetX  = 10;
+            const int32_t offsetY  = 130;
+            const int32_t width    = 30 * (kFontGlyphWidth >> fontSize);
+            const int32_t height   = (kFontGlyphHeight >> fontSize);
+
+            widget->type          = WidgetType::Count;
+            widget->fontSize      = fontSize;
+            widget->coords[0]     = offsetX;
+            widget->coords[1]     = offsetY;
+            widget->coords[2]     = offsetX + width;
+            widget->coords[3]     = offsetY + height;
+            widget->color[0]      = 1.0f;
+            widget->color[1]      = 1.0f;
+            widget->color[2]      = 1.0f;
+            widget->color[3]      = 1.0f;
+            widget->matchToWidget = nullptr;
+        }
+        mState.mOverlayWidgets[WidgetId::VulkanCommandMemorySize].reset(widget);
+    }
+
     {
         RunningGraph *widget = new RunningGraph(60);
         {
@@ -38,6 +38,8 @@ enum class WidgetId
     VulkanUniformDescriptorCacheSize,
     // Total size of all keys in the descriptor set caches
     VulkanDescriptorCacheKeySize,
+    // Size of the command memory held by the context's command buffers
+    VulkanCommandMemorySize,
     // Number of times the Vulkan backend attempted to submit commands
     VulkanAttemptedSubmissions,
     // Number of times the Vulkan backend actually submitted commands
@@ -70,6 +72,7 @@ enum class WidgetId
     PROC(VulkanTextureDescriptorCacheSize)      \
     PROC(VulkanUniformDescriptorCacheSize)      \
     PROC(VulkanDescriptorCacheKeySize)          \
+    PROC(VulkanCommandMemorySize)               \
     PROC(VulkanAttemptedSubmissions)            \
     PROC(VulkanActualSubmissions)               \
     PROC(VulkanPipelineCacheLookups)            \
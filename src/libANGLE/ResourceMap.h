@@ -5,17 +5,21 @@
 //
 // ResourceMap:
 //   An optimized resource map which packs the first set of allocated objects into a
-//   flat array, and then falls back to an unordered map for the higher handle values.
+//   flat array, continues with lazily allocated pages for the next set, and then falls back to a
+//   hash map for the higher handle values.
 //
 
 #ifndef LIBANGLE_RESOURCE_MAP_H_
 #define LIBANGLE_RESOURCE_MAP_H_
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <mutex>
 #include <type_traits>
 
+#include "common/HandleHashMap.h"
 #include "common/SimpleMutex.h"
-#include "common/hash_containers.h"
 #include "libANGLE/angletypes.h"
 
 namespace gl
@@ -126,6 +130,12 @@ class ResourceMap final : angle::NonCopyable
             return (value == InvalidPointer() ? nullptr : value);
         }
 
+        if (handle < kPagedResourcesLimit)
+        {
+            ResourceType *value = findInPagedResources(handle);
+            return (value == InvalidPointer() ? nullptr : value);
+        }
+
         return findInHashedResources(handle);
     }
 
@@ -141,7 +151,7 @@ class ResourceMap final : angle::NonCopyable
     void clear();
 
     using IndexAndResource = std::pair<GLuint, ResourceType *>;
-    using HashMap          = angle::HashMap<GLuint, ResourceType *>;
+    using HashMap          = angle::HandleHashMap<ResourceType *>;
 
     class Iterator final
     {
@@ -200,25 +210,57 @@ class ResourceMap final : angle::NonCopyable
     static_assert(((kFlatResourcesLimit / kInitialFlatResourcesSize) &
                    (kFlatResourcesLimit / kInitialFlatResourcesSize - 1)) == 0);
 
+    // Past the flat map, handles up to |kPagedResourcesLimit| are stored in pages of
+    // |kResourcesPerPage| entries, which are allocated on first use and never move.  Applications
+    // that create many objects thus keep the lockless lookup of the flat map.
+    static constexpr size_t kResourcesPerPage    = 4096;
+    static constexpr size_t kResourcePageCount   =
+        ((1u << 20) - kFlatResourcesLimit + kResourcesPerPage - 1) / kResourcesPerPage;
+    static constexpr size_t kPagedResourcesLimit =
+        kFlatResourcesLimit + kResourcePageCount * kResourcesPerPage;
+    static_assert(gl::isPow2(kResourcesPerPage));
+
+    using ResourcePage = ResourceType *[kResourcesPerPage];
+    struct ResourcePageTable
+    {
+        std::array<std::atomic<ResourceType **>, kResourcePageCount> pages;
+    };
+
     bool containsInHashedResources(GLuint handle) const;
     ResourceType *findInHashedResources(GLuint handle) const;
     bool eraseFromHashedResources(GLuint handle, ResourceType **resourceOut);
     void assignAboveCurrentFlatSize(GLuint handle, ResourceType *resource);
     void assignInHashedResources(GLuint handle, ResourceType *resource);
 
+    // Returns the page entry of |handle| if its page is allocated, or InvalidPointer() otherwise.
+    ResourceType *findInPagedResources(GLuint handle) const;
+    ResourceType **getPagedResource(GLuint handle) const;
+    ResourceType **getOrAllocatePagedResource(GLuint handle);
+    void assignInPagedResources(GLuint handle, ResourceType *resource);
+    void releasePagedResources();
+
+    // Used by iterators, handles the flat and paged resources.
+    ResourceType *getDirectResource(GLuint handle) const;
+
     size_t mFlatResourcesSize;
     ResourceType **mFlatResources;
 
+    // The table of pages is allocated when the first page is.  Both the table and the pages are
+    // published with release semantics, so they can be read without holding |mMutex|.
+    std::atomic<ResourcePageTable *> mResourcePages;
+
     // A map of GL objects indexed by object ID.
     HashMap mHashedResources;
 
     // mFlatResources is allocated at object creation time, with a default size of
     // |kInitialFlatResourcesSize|.  This is thread safe, because the allocation is done by the
     // first context in the share group.  The flat map is allowed to grow up to
-    // |kFlatResourcesLimit|, but only for maps that don't need a lock (kNeedsLock == false).
+    // |kFlatResourcesLimit|, but only for maps that don't need a lock (kNeedsLock == false).  The
+    // paged resources that follow never move, so they don't need a lock to be read either.
     //
     // For maps that don't need a lock, this mutex is a no-op.  For those that do, the mutex is
-    // taken when allocating / deleting objects, as well as when accessing |mHashedResources|.
+    // taken when allocating / deleting objects, when allocating resource pages, as well as when
+    // accessing |mHashedResources|.
     // Otherwise, access to the flat map (which never gets reallocated due to
     // |kInitialFlatResourcesSize == kFlatResourcesLimit|) is lockless.  This latter is possible
     // because the application is not allowed to gen/delete and bind the same ID in different
@@ -258,7 +300,8 @@ class UnsafeResourceMapIter
 template <typename ResourceType, typename IDType>
 ResourceMap<ResourceType, IDType>::ResourceMap()
     : mFlatResourcesSize(kInitialFlatResourcesSize),
-      mFlatResources(new ResourceType *[kInitialFlatResourcesSize])
+      mFlatResources(new ResourceType *[kInitialFlatResourcesSize]),
+      mResourcePages(nullptr)
 {
     memset(mFlatResources, kInvalidPointer, mFlatResourcesSize * sizeof(mFlatResources[0]));
 }
@@ -268,6 +311,7 @@ ResourceMap<ResourceType, IDType>::~ResourceMap()
 {
     ASSERT(begin() == end());
     delete[] mFlatResources;
+    releasePagedResources();
 }
 
 template <typename ResourceType, typename IDType>
@@ -275,7 +319,7 @@ bool ResourceMap<ResourceType, IDType>::containsInHashedResources(GLuint handle)
 {
     std::lock_guard<Mutex> lock(mMutex);
 
-    return mHashedResources.find(handle) != mHashedResources.end();
+    return mHashedResources.contains(handle);
 }
 
 template <typename ResourceType, typename IDType>
@@ -283,9 +327,9 @@ ResourceType *ResourceMap<ResourceType, IDType>::findInHashedResources(GLuint ha
 {
     std::lock_guard<Mutex> lock(mMutex);
 
-    auto it = mHashedResources.find(handle);
-    // Note: it->second can also be nullptr, so nullptr check doesn't work for "contains"
-    return (it == mHashedResources.end() ? nullptr : it->second);
+    ResourceType *const *value = mHashedResources.find(handle);
+    // Note: the value can also be nullptr, so nullptr check doesn't work for "contains"
+    return (value == nullptr ? nullptr : *value);
 }
 
 template <typename ResourceType, typename IDType>
@@ -294,14 +338,91 @@ bool ResourceMap<ResourceType, IDType>::eraseFromHashedResources(GLuint handle,
 {
     std::lock_guard<Mutex> lock(mMutex);
 
-    auto it = mHashedResources.find(handle);
-    if (it == mHashedResources.end())
+    return mHashedResources.erase(handle, resourceOut);
+}
+
+template <typename ResourceType, typename IDType>
+ANGLE_INLINE ResourceType **ResourceMap<ResourceType, IDType>::getPagedResource(
+    GLuint handle) const
+{
+    ASSERT(handle < kPagedResourcesLimit);
+
+    // Handles past the current flat map size but before its limit are not assigned yet.
+    const ResourcePageTable *table = mResourcePages.load(std::memory_order_acquire);
+    if (handle < kFlatResourcesLimit || table == nullptr)
     {
-        return false;
+        return nullptr;
     }
-    *resourceOut = it->second;
-    mHashedResources.erase(it);
-    return true;
+
+    const size_t offset = handle - kFlatResourcesLimit;
+    ResourceType **page = table->pages[offset / kResourcesPerPage].load(std::memory_order_acquire);
+    return page == nullptr ? nullptr : &page[offset % kResourcesPerPage];
+}
+
+template <typename ResourceType, typename IDType>
+ResourceType *ResourceMap<ResourceType, IDType>::findInPagedResources(GLuint handle) const
+{
+    ResourceType **resource = getPagedResource(handle);
+    return resource == nullptr ? InvalidPointer() : *resource;
+}
+
+template <typename ResourceType, typename IDType>
+ResourceType **ResourceMap<ResourceType, IDType>::getOrAllocatePagedResource(GLuint handle)
+{
+    ResourceType **resource = getPagedResource(handle);
+    if (ANGLE_LIKELY(resource != nullptr))
+    {
+        return resource;
+    }
+
+    // Another thread may be allocating the same page, so check again under the lock.
+    std::lock_guard<Mutex> lock(mMutex);
+
+    ResourcePageTable *table = mResourcePages.load(std::memory_order_acquire);
+    if (table == nullptr)
+    {
+        table = new ResourcePageTable;
+        for (std::atomic<ResourceType **> &page : table->pages)
+        {
+            page.store(nullptr, std::memory_order_relaxed);
+        }
+        mResourcePages.store(table, std::memory_order_release);
+    }
+
+    const size_t offset = handle - kFlatResourcesLimit;
+    std::atomic<ResourceType **> &pageSlot = table->pages[offset / kResourcesPerPage];
+    ResourceType **page                    = pageSlot.load(std::memory_order_acquire);
+    if (page == nullptr)
+    {
+        page = new ResourcePage;
+        memset(page, kInvalidPointer, sizeof(ResourcePage));
+        pageSlot.store(page, std::memory_order_release);
+    }
+
+    return &page[offset % kResourcesPerPage];
+}
+
+template <typename ResourceType, typename IDType>
+void ResourceMap<ResourceType, IDType>::assignInPagedResources(GLuint handle,
+                                                               ResourceType *resource)
+{
+    *getOrAllocatePagedResource(handle) = resource;
+}
+
+template <typename ResourceType, typename IDType>
+void ResourceMap<ResourceType, IDType>::releasePagedResources()
+{
+    ResourcePageTable *table = mResourcePages.exchange(nullptr, std::memory_order_relaxed);
+    if (table == nullptr)
+    {
+        return;
+    }
+
+    for (std::atomic<ResourceType **> &page : table->pages)
+    {
+        delete[] page.load(std::memory_order_relaxed);
+    }
+    delete table;
 }
 
 template <typename ResourceType, typename IDType>
@@ -313,6 +434,11 @@ ANGLE_INLINE bool ResourceMap<ResourceType, IDType>::contains(IDType id) const
         return mFlatResources[handle] != InvalidPointer();
     }
 
+    if (handle < kPagedResourcesLimit)
+    {
+        return findInPagedResources(handle) != InvalidPointer();
+    }
+
     return containsInHashedResources(handle);
 }
 
@@ -332,6 +458,18 @@ bool ResourceMap<ResourceType, IDType>::erase(IDType id, ResourceType **resource
         return true;
     }
 
+    if (handle < kPagedResourcesLimit)
+    {
+        ResourceType **value = getPagedResource(handle);
+        if (value == nullptr || *value == InvalidPointer())
+        {
+            return false;
+        }
+        *resourceOut = *value;
+        *value       = InvalidPointer();
+        return true;
+    }
+
     return eraseFromHashedResources(handle, resourceOut);
 }
 
@@ -364,6 +502,10 @@ void ResourceMap<ResourceType, IDType>::assignAboveCurrentFlatSize(GLuint handle
         ASSERT(mFlatResourcesSize > handle);
         mFlatResources[handle] = resource;
     }
+    else if (handle < kPagedResourcesLimit)
+    {
+        assignInPagedResources(handle, resource);
+    }
     else
     {
         std::lock_guard<Mutex> lock(mMutex);
@@ -395,7 +537,7 @@ typename ResourceMap<ResourceType, IDType>::Iterator ResourceMap<ResourceType, I
 template <typename ResourceType, typename IDType>
 typename ResourceMap<ResourceType, IDType>::Iterator ResourceMap<ResourceType, IDType>::end() const
 {
-    return Iterator(*this, static_cast<GLuint>(mFlatResourcesSize), mHashedResources.end(), true);
+    return Iterator(*this, static_cast<GLuint>(kPagedResourcesLimit), mHashedResources.end(), true);
 }
 
 template <typename ResourceType, typename IDType>
@@ -409,7 +551,8 @@ template <typename ResourceType, typename IDType>
 typename ResourceMap<ResourceType, IDType>::Iterator
 ResourceMap<ResourceType, IDType>::endWithNull() const
 {
-    return Iterator(*this, static_cast<GLuint>(mFlatResourcesSize), mHashedResources.end(), false);
+    return Iterator(*this, static_cast<GLuint>(kPagedResourcesLimit), mHashedResources.end(),
+                    false);
 }
 
 template <typename ResourceType, typename IDType>
@@ -424,6 +567,7 @@ void ResourceMap<ResourceType, IDType>::clear()
     // No need for a lock as this is only called on destruction.
     memset(mFlatResources, kInvalidPointer, kInitialFlatResourcesSize * sizeof(mFlatResources[0]));
     mFlatResourcesSize = kInitialFlatResourcesSize;
+    releasePagedResources();
     mHashedResources.clear();
 }
 
@@ -440,7 +584,38 @@ GLuint ResourceMap<ResourceType, IDType>::nextResource(size_t flatIndex, bool sk
             return static_cast<GLuint>(index);
         }
     }
-    return static_cast<GLuint>(mFlatResourcesSize);
+
+    const ResourcePageTable *table = mResourcePages.load(std::memory_order_acquire);
+    if (table == nullptr)
+    {
+        return static_cast<GLuint>(kPagedResourcesLimit);
+    }
+
+    size_t offset = std::max(flatIndex, kFlatResourcesLimit) - kFlatResourcesLimit;
+    while (offset < kResourcePageCount * kResourcesPerPage)
+    {
+        const ResourceType *const *page =
+            table->pages[offset / kResourcesPerPage].load(std::memory_order_acquire);
+        if (page == nullptr)
+        {
+            offset = rx::roundUpPow2(offset + 1, kResourcesPerPage);
+            continue;
+        }
+
+        const ResourceType *value = page[offset % kResourcesPerPage];
+        if ((value != nullptr || !skipNulls) && value != InvalidPointer())
+        {
+            break;
+        }
+        ++offset;
+    }
+    return static_cast<GLuint>(kFlatResourcesLimit + offset);
+}
+
+template <typename ResourceType, typename IDType>
+ResourceType *ResourceMap<ResourceType, IDType>::getDirectResource(GLuint handle) const
+{
+    return handle < mFlatResourcesSize ? mFlatResources[handle] : findInPagedResources(handle);
 }
 
 template <typename ResourceType, typename IDType>
@@ -477,13 +652,13 @@ template <typename ResourceType, typename IDType>
 typename ResourceMap<ResourceType, IDType>::Iterator &
 ResourceMap<ResourceType, IDType>::Iterator::operator++()
 {
-    if (mFlatIndex < static_cast<GLuint>(mOrigin.mFlatResourcesSize))
+    if (mFlatIndex < static_cast<GLuint>(kPagedResourcesLimit))
     {
         mFlatIndex = mOrigin.nextResource(mFlatIndex + 1, mSkipNulls);
     }
     else
     {
-        mHashIndex++;
+        ++mHashIndex;
     }
     updateValue();
     return *this;
@@ -506,10 +681,10 @@ ResourceMap<ResourceType, IDType>::Iterator::operator*() const
 template <typename ResourceType, typename IDType>
 void ResourceMap<ResourceType, IDType>::Iterator::updateValue()
 {
-    if (mFlatIndex < static_cast<GLuint>(mOrigin.mFlatResourcesSize))
+    if (mFlatIndex < static_cast<GLuint>(kPagedResourcesLimit))
     {
         mValue.first  = mFlatIndex;
-        mValue.second = mOrigin.mFlatResources[mFlatIndex];
+        mValue.second = mOrigin.getDirectResource(mFlatIndex);
     }
     else if (mHashIndex != mOrigin.mHashedResources.end())
     {
@@ -8,6 +8,7 @@
 //
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <map>
 
 #include "libANGLE/ResourceMap.h"
@@ -200,6 +201,88 @@ TEST(ResourceMapTest, QueryUnassignedLocked)
     QueryUnassigned<LockedType>();
 }
 
+template <typename T>
+void SparseIds()
+{
+    // Ids in the flat map, in the paged range past it, and in the hashed range.
+    const std::vector<GLuint> kIds = {1,       100,     0x2FFF,     0x3000,     20'000,
+                                      300'000, 300'001, 0xFFFFF,    0x100000,   0x7FFFFFF0,
+                                      0xFFFFFFFE, 0xFFFFFFFF};
+    const std::vector<GLuint> kUnassignedIds = {2, 0x3001, 300'002, 0x100001, 0x7FFFFFF1};
+    constexpr GLuint kReservedId             = 500'000;
+
+    ResourceMap<size_t, T> resourceMap;
+    std::vector<size_t> objects(kIds.size());
+
+    for (size_t index = 0; index < kIds.size(); ++index)
+    {
+        ASSERT_FALSE(resourceMap.contains(static_cast<T>(kIds[index])));
+        resourceMap.assign(static_cast<T>(kIds[index]), &objects[index]);
+    }
+    resourceMap.assign(static_cast<T>(kReservedId), nullptr);
+
+    for (size_t index = 0; index < kIds.size(); ++index)
+    {
+        ASSERT_TRUE(resourceMap.contains(static_cast<T>(kIds[index])));
+        ASSERT_EQ(&objects[index], resourceMap.query(static_cast<T>(kIds[index])));
+    }
+    for (GLuint id : kUnassignedIds)
+    {
+        ASSERT_FALSE(resourceMap.contains(static_cast<T>(id)));
+        ASSERT_EQ(nullptr, resourceMap.query(static_cast<T>(id)));
+    }
+    ASSERT_TRUE(resourceMap.contains(static_cast<T>(kReservedId)));
+    ASSERT_EQ(nullptr, resourceMap.query(static_cast<T>(kReservedId)));
+
+    // Iteration skips the reserved id, unless nulls are requested.
+    std::vector<GLuint> iteratedIds;
+    for (const auto &idAndResource : UnsafeResourceMapIter(resourceMap))
+    {
+        iteratedIds.push_back(idAndResource.first);
+    }
+    std::sort(iteratedIds.begin(), iteratedIds.end());
+    EXPECT_EQ(kIds, iteratedIds);
+
+    size_t iteratedWithNullCount = 0;
+    UnsafeResourceMapIter iter(resourceMap);
+    for (auto it = iter.beginWithNull(); it != iter.endWithNull(); ++it)
+    {
+        ++iteratedWithNullCount;
+    }
+    EXPECT_EQ(kIds.size() + 1, iteratedWithNullCount);
+
+    for (size_t index = 0; index < kIds.size(); ++index)
+    {
+        size_t *found = nullptr;
+        ASSERT_TRUE(resourceMap.erase(static_cast<T>(kIds[index]), &found));
+        ASSERT_EQ(&objects[index], found);
+        ASSERT_FALSE(resourceMap.erase(static_cast<T>(kIds[index]), &found));
+        ASSERT_FALSE(resourceMap.contains(static_cast<T>(kIds[index])));
+    }
+    size_t *found = &objects[0];
+    ASSERT_TRUE(resourceMap.erase(static_cast<T>(kReservedId), &found));
+    ASSERT_EQ(nullptr, found);
+
+    ASSERT_TRUE(UnsafeResourceMapIter(resourceMap).empty());
+
+    // The map can be reused after being cleared.
+    resourceMap.assign(static_cast<T>(kIds[5]), &objects[5]);
+    resourceMap.clear();
+    ASSERT_FALSE(resourceMap.contains(static_cast<T>(kIds[5])));
+    ASSERT_TRUE(UnsafeResourceMapIter(resourceMap).empty());
+}
+
+// Tests assigning ids spread over the whole range of values.
+TEST(ResourceMapTest, SparseIdsLockless)
+{
+    SparseIds<LocklessType>();
+}
+// Tests assigning ids spread over the whole range of values.
+TEST(ResourceMapTest, SparseIdsLocked)
+{
+    SparseIds<LockedType>();
+}
+
 void ConcurrentAccess(size_t iterations, size_t idCycleSize)
 {
     if (std::is_same_v<ResourceMapMutex, angle::NoOpMutex>)
@@ -697,6 +697,20 @@ void Shader::compile(const Context *context, angle::JobResultExpectancy resultEx
     options.validateAST = true;
 #endif
 
+    // The GL backend relies on the driver's internal parallel compilation, and thus does not use a
+    // thread to compile.  A front-end feature selects whether the single-threaded pool must be
+    // used.
+    const angle::JobThreadSafety threadSafety =
+        context->getFrontendFeatures().compileJobIsThreadSafe.enabled
+            ? angle::JobThreadSafety::Safe
+            : angle::JobThreadSafety::Unsafe;
+
+    // Function bodies are only transformed on other threads if the compile job itself may run on
+    // one.
+    options.parallelFunctionTransformations =
+        threadSafety == angle::JobThreadSafety::Safe &&
+        context->getFrontendFeatures().transformShaderFunctionsInParallel.enabled;
+
     // Find a shader in Blob Cache
     Compiler *compiler = context->getCompiler();
     setShaderKey(context, options, compiler->getShaderOutputType(),
@@ -729,6 +743,11 @@ void Shader::compile(const Context *context, angle::JobResultExpectancy resultEx
     ShHandle compilerHandle             = compilerInstance.getHandle();
     ASSERT(compilerHandle);
 
+    // The instance may have been used with a different pool before, so the pool is always reset.
+    sh::SetWorkerThreadPool(compilerHandle, options.parallelFunctionTransformations
+                                                ? context->getShaderCompileThreadPool()
+                                                : nullptr);
+
     // Cache load failed, fall through normal compiling.
     mState.mCompileStatus = CompileStatus::COMPILE_REQUESTED;
 
@@ -747,13 +766,6 @@ void Shader::compile(const Context *context, angle::JobResultExpectancy resultEx
                         mState.mSourceHash, mState.mCompiledState, maxComputeWorkGroupInvocations,
                         maxComputeSharedMemory, std::move(translateTask)));
 
-    // The GL backend relies on the driver's internal parallel compilation, and thus does not use a
-    // thread to compile.  A front-end feature selects whether the single-threaded pool must be
-    // used.
-    const angle::JobThreadSafety threadSafety =
-        context->getFrontendFeatures().compileJobIsThreadSafe.enabled
-            ? angle::JobThreadSafety::Safe
-            : angle::JobThreadSafety::Unsafe;
     std::shared_ptr<angle::WaitableEvent> compileEvent =
         context->postCompileLinkTask(compileTask, threadSafety, resultExpectancy);
 
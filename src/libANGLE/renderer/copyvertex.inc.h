@@ -85,7 +85,19 @@ inline void CopyNativeVertexData(const uint8_t *input, size_t stride, size_t cou
     const T defaultAlphaValue                = gl::bitCast<T>(alphaDefaultValueBits);
     const size_t lastNonAlphaOutputComponent = std::min<size_t>(outputComponentCount, 3);
 
-    for (size_t i = 0; i < count; i++)
+    size_t firstVertex = 0;
+    if constexpr (inputComponentCount < 4 && outputComponentCount == 4 &&
+                  (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4))
+    {
+        // Pad most vertices with the vectorized kernel, and the last few below.
+        const priv::VertexPaddingFunction padTo4Components =
+            priv::GetVertexConversionFunctions()
+                .padTo4Components[priv::GetComponentSizeLog2(sizeof(T))];
+        firstVertex = padTo4Components(input, stride, count, inputComponentCount,
+                                       alphaDefaultValueBits, output);
+    }
+
+    for (size_t i = firstVertex; i < count; i++)
     {
         const T *offsetInput = reinterpret_cast<const T *>(input + (i * stride));
         T offsetInputAligned[inputComponentCount];
@@ -242,7 +254,20 @@ inline void CopyToFloatVertexData(const uint8_t *input,
     typedef std::numeric_limits<T> NL;
     typedef typename std::conditional<toHalf, GLhalf, float>::type outputType;
 
-    for (size_t i = 0; i < count; i++)
+    size_t firstVertex = 0;
+    constexpr priv::VertexComponentType kComponentType = priv::GetVertexComponentType<T>();
+    if constexpr (!toHalf && kComponentType != priv::VertexComponentType::InvalidEnum)
+    {
+        // Convert most vertices with the vectorized kernel, and the last few below.
+        const priv::VertexConversionFunctions &functions = priv::GetVertexConversionFunctions();
+        const priv::VertexConversionFunction toFloat =
+            (normalized ? functions.normalizedToFloat
+                        : functions.toFloat)[static_cast<size_t>(kComponentType)];
+        firstVertex =
+            toFloat(input, stride, count, inputComponentCount, outputComponentCount, output);
+    }
+
+    for (size_t i = firstVertex; i < count; i++)
     {
         const T *offsetInput = reinterpret_cast<const T *>(input + (stride * i));
         outputType *offsetOutput =
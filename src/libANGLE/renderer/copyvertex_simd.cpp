@@ -0,0 +1,491 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// copyvertex_simd.cpp: Implements the vertex conversion kernels with SSE2, SSE4.1 and NEON.
+
+#include "libANGLE/renderer/copyvertex_simd.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "common/cpu_features.h"
+#include "common/platform.h"
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define ANGLE_COPYVERTEX_USE_SSE2
+#    include <emmintrin.h>
+#    include <smmintrin.h>
+#    if defined(__clang__) || defined(__GNUC__)
+#        define ANGLE_SSE41_TARGET __attribute__((target("sse4.1")))
+#        define ANGLE_SSE41_FLATTEN __attribute__((target("sse4.1"), flatten))
+#    else
+#        define ANGLE_SSE41_TARGET
+#        define ANGLE_SSE41_FLATTEN
+#    endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+// The 32-bit NEON instruction set has no vector division, which the normalization needs to match
+// the scalar conversion bit for bit.
+#    define ANGLE_COPYVERTEX_USE_NEON
+#    include <arm_neon.h>
+#endif
+
+namespace rx
+{
+namespace priv
+{
+namespace
+{
+size_t ConvertNoVertices(const uint8_t *, size_t, size_t, size_t, size_t, uint8_t *)
+{
+    return 0;
+}
+
+size_t PadNoVertices(const uint8_t *, size_t, size_t, size_t, uint32_t, uint8_t *)
+{
+    return 0;
+}
+
+[[maybe_unused]] constexpr VertexConversionFunctions kScalarVertexConversionFunctions = {
+    {ConvertNoVertices, ConvertNoVertices, ConvertNoVertices, ConvertNoVertices},
+    {ConvertNoVertices, ConvertNoVertices, ConvertNoVertices, ConvertNoVertices},
+    {PadNoVertices, PadNoVertices, PadNoVertices},
+};
+
+#if defined(ANGLE_COPYVERTEX_USE_SSE2) || defined(ANGLE_COPYVERTEX_USE_NEON)
+// The kernels load a whole 4-component vertex at once, even if the input has fewer components.
+// Returns the number of vertices, from the first, for which that does not read past the
+// |attribSize| bytes of the last vertex.
+size_t GetVertexCountSafeToLoad(size_t stride, size_t count, size_t attribSize, size_t loadSize)
+{
+    if (count == 0 || stride == 0)
+    {
+        return 0;
+    }
+
+    const size_t dataSize = (count - 1) * stride + attribSize;
+    if (dataSize < loadSize)
+    {
+        return 0;
+    }
+    return std::min(count, (dataSize - loadSize) / stride + 1);
+}
+
+// Returns a byte mask selecting the first |componentCount| components of a vertex.
+std::array<uint8_t, 16> MakeComponentMask(size_t componentCount, size_t componentSize)
+{
+    std::array<uint8_t, 16> mask = {};
+    memset(mask.data(), 0xFF, componentCount * componentSize);
+    return mask;
+}
+
+// The vertices are converted one at a time with 4-lane vectors, whatever their number of
+// components.  The lanes past the input components are replaced with the padding, and only the
+// output components are stored.
+template <typename SIMD, typename T, bool normalized>
+size_t ConvertVerticesToFloat(const uint8_t *input,
+                              size_t stride,
+                              size_t count,
+                              size_t inputComponentCount,
+                              size_t outputComponentCount,
+                              uint8_t *output)
+{
+    using Bits  = typename SIMD::Bits;
+    using Float = typename SIMD::Float;
+
+    const size_t vertexCount = GetVertexCountSafeToLoad(
+        stride, count, inputComponentCount * sizeof(T), 4 * sizeof(T));
+    const size_t outputVertexSize = outputComponentCount * sizeof(float);
+
+    std::array<float, 4> padding = {};
+    if (inputComponentCount < 4 && outputComponentCount == 4)
+    {
+        padding[3] = 1.0f;
+    }
+
+    const Bits keepMask    = SIMD::LoadBits(MakeComponentMask(inputComponentCount, 4).data());
+    const Bits paddingBits = SIMD::LoadBits(reinterpret_cast<const uint8_t *>(padding.data()));
+    const Float scale      = SIMD::Splat(static_cast<float>(std::numeric_limits<T>::max()));
+    const Float minusOne   = SIMD::Splat(-1.0f);
+
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+        Float values = SIMD::template LoadAsFloat<T>(input + i * stride);
+        if (normalized)
+        {
+            // Divide rather than multiply by the reciprocal, to round the same as the scalar code.
+            values = SIMD::Divide(values, scale);
+            if (std::numeric_limits<T>::is_signed)
+            {
+                values = SIMD::Max(values, minusOne);
+            }
+        }
+
+        const Bits result = SIMD::Select(keepMask, SIMD::AsBits(values), paddingBits);
+        SIMD::StorePartial(output + i * outputVertexSize, result, outputVertexSize);
+    }
+
+    return vertexCount;
+}
+
+template <typename SIMD, size_t kComponentSize>
+size_t PadVerticesTo4Components(const uint8_t *input,
+                                size_t stride,
+                                size_t count,
+                                size_t inputComponentCount,
+                                uint32_t alphaBits,
+                                uint8_t *output)
+{
+    using Bits = typename SIMD::Bits;
+
+    constexpr size_t kVertexSize = 4 * kComponentSize;
+    const size_t vertexCount     = GetVertexCountSafeToLoad(
+        stride, count, inputComponentCount * kComponentSize, kVertexSize);
+
+    std::array<uint8_t, 16> padding = {};
+    memcpy(&padding[3 * kComponentSize], &alphaBits, kComponentSize);
+
+    const Bits keepMask =
+        SIMD::LoadBits(MakeComponentMask(inputComponentCount, kComponentSize).data());
+    const Bits paddingBits = SIMD::LoadBits(padding.data());
+
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+        const Bits vertex = SIMD::template Load<kVertexSize>(input + i * stride);
+        SIMD::template Store<kVertexSize>(output + i * kVertexSize,
+                                          SIMD::Select(keepMask, vertex, paddingBits));
+    }
+
+    return vertexCount;
+}
+
+template <typename SIMD>
+constexpr VertexConversionFunctions MakeVertexConversionFunctions()
+{
+    return {
+        {ConvertVerticesToFloat<SIMD, int8_t, false>, ConvertVerticesToFloat<SIMD, uint8_t, false>,
+         ConvertVerticesToFloat<SIMD, int16_t, false>,
+         ConvertVerticesToFloat<SIMD, uint16_t, false>},
+        {ConvertVerticesToFloat<SIMD, int8_t, true>, ConvertVerticesToFloat<SIMD, uint8_t, true>,
+         ConvertVerticesToFloat<SIMD, int16_t, true>, ConvertVerticesToFloat<SIMD, uint16_t, true>},
+        {PadVerticesTo4Components<SIMD, 1>, PadVerticesTo4Components<SIMD, 2>,
+         PadVerticesTo4Components<SIMD, 4>},
+    };
+}
+#endif  // defined(ANGLE_COPYVERTEX_USE_SSE2) || defined(ANGLE_COPYVERTEX_USE_NEON)
+
+#if defined(ANGLE_COPYVERTEX_USE_SSE2)
+struct SSE2
+{
+    using Bits  = __m128i;
+    using Float = __m128;
+
+    static Bits LoadBits(const uint8_t *source)
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i *>(source));
+    }
+
+    template <size_t kSize>
+    static Bits Load(const uint8_t *source)
+    {
+        if constexpr (kSize == 4)
+        {
+            int32_t bits;
+            memcpy(&bits, source, sizeof(bits));
+            return _mm_cvtsi32_si128(bits);
+        }
+        else if constexpr (kSize == 8)
+        {
+            return _mm_loadl_epi64(reinterpret_cast<const __m128i *>(source));
+        }
+        else
+        {
+            static_assert(kSize == 16, "Unexpected load size");
+            return LoadBits(source);
+        }
+    }
+
+    template <size_t kSize>
+    static void Store(uint8_t *dest, Bits value)
+    {
+        if constexpr (kSize == 4)
+        {
+            const int32_t bits = _mm_cvtsi128_si32(value);
+            memcpy(dest, &bits, sizeof(bits));
+        }
+        else if constexpr (kSize == 8)
+        {
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(dest), value);
+        }
+        else
+        {
+            static_assert(kSize == 16, "Unexpected store size");
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dest), value);
+        }
+    }
+
+    static void StorePartial(uint8_t *dest, Bits value, size_t size)
+    {
+        switch (size)
+        {
+            case 4:
+                Store<4>(dest, value);
+                break;
+            case 8:
+                Store<8>(dest, value);
+                break;
+            case 12:
+                Store<8>(dest, value);
+                Store<4>(dest + 8, _mm_srli_si128(value, 8));
+                break;
+            default:
+                Store<16>(dest, value);
+                break;
+        }
+    }
+
+    // Loads 4 components and converts them to float.
+    template <typename T>
+    static Float LoadAsFloat(const uint8_t *source)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i values;
+        if constexpr (std::is_same<T, int8_t>::value)
+        {
+            // Move each byte to the top of its 32-bit lane, then shift it back down with sign
+            // extension.
+            values = Load<4>(source);
+            values = _mm_unpacklo_epi8(values, values);
+            values = _mm_srai_epi32(_mm_unpacklo_epi16(values, values), 24);
+        }
+        else if constexpr (std::is_same<T, uint8_t>::value)
+        {
+            values = Load<4>(source);
+            values = _mm_unpacklo_epi16(_mm_unpacklo_epi8(values, zero), zero);
+        }
+        else if constexpr (std::is_same<T, int16_t>::value)
+        {
+            values = Load<8>(source);
+            values = _mm_srai_epi32(_mm_unpacklo_epi16(values, values), 16);
+        }
+        else
+        {
+            static_assert(std::is_same<T, uint16_t>::value, "Unexpected component type");
+            values = _mm_unpacklo_epi16(Load<8>(source), zero);
+        }
+        return _mm_cvtepi32_ps(values);
+    }
+
+    static Float Splat(float value) { return _mm_set1_ps(value); }
+    static Float Divide(Float a, Float b) { return _mm_div_ps(a, b); }
+    static Float Max(Float a, Float b) { return _mm_max_ps(a, b); }
+    static Bits AsBits(Float value) { return _mm_castps_si128(value); }
+
+    static Bits Select(Bits mask, Bits a, Bits b)
+    {
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    }
+};
+
+constexpr VertexConversionFunctions kSSE2VertexConversionFunctions =
+    MakeVertexConversionFunctions<SSE2>();
+
+// SSE4.1 widens the components in a single instruction and selects with a blend.
+struct SSE41 : SSE2
+{
+    template <typename T>
+    ANGLE_SSE41_TARGET static Float LoadAsFloat(const uint8_t *source)
+    {
+        __m128i values;
+        if constexpr (std::is_same<T, int8_t>::value)
+        {
+            values = _mm_cvtepi8_epi32(Load<4>(source));
+        }
+        else if constexpr (std::is_same<T, uint8_t>::value)
+        {
+            values = _mm_cvtepu8_epi32(Load<4>(source));
+        }
+        else if constexpr (std::is_same<T, int16_t>::value)
+        {
+            values = _mm_cvtepi16_epi32(Load<8>(source));
+        }
+        else
+        {
+            static_assert(std::is_same<T, uint16_t>::value, "Unexpected component type");
+            values = _mm_cvtepu16_epi32(Load<8>(source));
+        }
+        return _mm_cvtepi32_ps(values);
+    }
+
+    ANGLE_SSE41_TARGET static Bits Select(Bits mask, Bits a, Bits b)
+    {
+        return _mm_blendv_epi8(b, a, mask);
+    }
+};
+
+// These wrappers compile the generic kernels for SSE4.1.  They are flattened so the SSE4.1 helpers
+// are inlined into the kernels, which are compiled for the baseline instruction set on their own.
+template <typename T, bool normalized>
+ANGLE_SSE41_FLATTEN size_t ConvertVerticesToFloatSSE41(const uint8_t *input,
+                                                       size_t stride,
+                                                       size_t count,
+                                                       size_t inputComponentCount,
+                                                       size_t outputComponentCount,
+                                                       uint8_t *output)
+{
+    return ConvertVerticesToFloat<SSE41, T, normalized>(input, stride, count, inputComponentCount,
+                                                         outputComponentCount, output);
+}
+
+template <size_t kComponentSize>
+ANGLE_SSE41_FLATTEN size_t PadVerticesTo4ComponentsSSE41(const uint8_t *input,
+                                                         size_t stride,
+                                                         size_t count,
+                                                         size_t inputComponentCount,
+                                                         uint32_t alphaBits,
+                                                         uint8_t *output)
+{
+    return PadVerticesTo4Components<SSE41, kComponentSize>(input, stride, count,
+                                                           inputComponentCount, alphaBits, output);
+}
+
+constexpr VertexConversionFunctions kSSE41VertexConversionFunctions = {
+    {ConvertVerticesToFloatSSE41<int8_t, false>, ConvertVerticesToFloatSSE41<uint8_t, false>,
+     ConvertVerticesToFloatSSE41<int16_t, false>, ConvertVerticesToFloatSSE41<uint16_t, false>},
+    {ConvertVerticesToFloatSSE41<int8_t, true>, ConvertVerticesToFloatSSE41<uint8_t, true>,
+     ConvertVerticesToFloatSSE41<int16_t, true>, ConvertVerticesToFloatSSE41<uint16_t, true>},
+    {PadVerticesTo4ComponentsSSE41<1>, PadVerticesTo4ComponentsSSE41<2>,
+     PadVerticesTo4ComponentsSSE41<4>},
+};
+#endif  // defined(ANGLE_COPYVERTEX_USE_SSE2)
+
+#if defined(ANGLE_COPYVERTEX_USE_NEON)
+struct NEON
+{
+    using Bits  = uint8x16_t;
+    using Float = float32x4_t;
+
+    static Bits LoadBits(const uint8_t *source) { return vld1q_u8(source); }
+
+    template <size_t kSize>
+    static Bits Load(const uint8_t *source)
+    {
+        if constexpr (kSize == 4)
+        {
+            uint32_t bits;
+            memcpy(&bits, source, sizeof(bits));
+            return vreinterpretq_u8_u32(vsetq_lane_u32(bits, vdupq_n_u32(0), 0));
+        }
+        else if constexpr (kSize == 8)
+        {
+            return vcombine_u8(vld1_u8(source), vdup_n_u8(0));
+        }
+        else
+        {
+            static_assert(kSize == 16, "Unexpected load size");
+            return LoadBits(source);
+        }
+    }
+
+    template <size_t kSize>
+    static void Store(uint8_t *dest, Bits value)
+    {
+        if constexpr (kSize == 4)
+        {
+            const uint32_t bits = vgetq_lane_u32(vreinterpretq_u32_u8(value), 0);
+            memcpy(dest, &bits, sizeof(bits));
+        }
+        else if constexpr (kSize == 8)
+        {
+            vst1_u8(dest, vget_low_u8(value));
+        }
+        else
+        {
+            static_assert(kSize == 16, "Unexpected store size");
+            vst1q_u8(dest, value);
+        }
+    }
+
+    static void StorePartial(uint8_t *dest, Bits value, size_t size)
+    {
+        switch (size)
+        {
+            case 4:
+                Store<4>(dest, value);
+                break;
+            case 8:
+                Store<8>(dest, value);
+                break;
+            case 12:
+                Store<8>(dest, value);
+                Store<4>(dest + 8, vextq_u8(value, value, 8));
+                break;
+            default:
+                Store<16>(dest, value);
+                break;
+        }
+    }
+
+    // Loads 4 components and converts them to float.
+    template <typename T>
+    static Float LoadAsFloat(const uint8_t *source)
+    {
+        if constexpr (std::is_same<T, int8_t>::value)
+        {
+            const int16x8_t values = vmovl_s8(vreinterpret_s8_u8(vget_low_u8(Load<4>(source))));
+            return vcvtq_f32_s32(vmovl_s16(vget_low_s16(values)));
+        }
+        else if constexpr (std::is_same<T, uint8_t>::value)
+        {
+            const uint16x8_t values = vmovl_u8(vget_low_u8(Load<4>(source)));
+            return vcvtq_f32_u32(vmovl_u16(vget_low_u16(values)));
+        }
+        else if constexpr (std::is_same<T, int16_t>::value)
+        {
+            const int16x4_t values = vreinterpret_s16_u8(vget_low_u8(Load<8>(source)));
+            return vcvtq_f32_s32(vmovl_s16(values));
+        }
+        else
+        {
+            static_assert(std::is_same<T, uint16_t>::value, "Unexpected component type");
+            const uint16x4_t values = vreinterpret_u16_u8(vget_low_u8(Load<8>(source)));
+            return vcvtq_f32_u32(vmovl_u16(values));
+        }
+    }
+
+    static Float Splat(float value) { return vdupq_n_f32(value); }
+    static Float Divide(Float a, Float b) { return vdivq_f32(a, b); }
+    static Float Max(Float a, Float b) { return vmaxq_f32(a, b); }
+    static Bits AsBits(Float value) { return vreinterpretq_u8_f32(value); }
+    static Bits Select(Bits mask, Bits a, Bits b) { return vbslq_u8(mask, a, b); }
+};
+
+constexpr VertexConversionFunctions kNEONVertexConversionFunctions =
+    MakeVertexConversionFunctions<NEON>();
+#endif  // defined(ANGLE_COPYVERTEX_USE_NEON)
+
+const VertexConversionFunctions *SelectVertexConversionFunctions()
+{
+#if defined(ANGLE_COPYVERTEX_USE_SSE2)
+    return angle::SupportsSSE41() ? &kSSE41VertexConversionFunctions
+                                  : &kSSE2VertexConversionFunctions;
+#elif defined(ANGLE_COPYVERTEX_USE_NEON)
+    return &kNEONVertexConversionFunctions;
+#else
+    return &kScalarVertexConversionFunctions;
+#endif
+}
+}  // anonymous namespace
+
+const VertexConversionFunctions &GetVertexConversionFunctions()
+{
+    static const VertexConversionFunctions *sFunctions = SelectVertexConversionFunctions();
+    return *sFunctions;
+}
+}  // namespace priv
+}  // namespace rx
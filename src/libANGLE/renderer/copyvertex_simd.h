@@ -0,0 +1,84 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// copyvertex_simd.h: Vectorized kernels behind the most common vertex conversion functions of
+//   copyvertex.h, selected by the features of the CPU.
+
+#ifndef LIBANGLE_RENDERER_COPYVERTEX_SIMD_H_
+#define LIBANGLE_RENDERER_COPYVERTEX_SIMD_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <type_traits>
+
+namespace rx
+{
+namespace priv
+{
+// Converts the first vertices of |input| to floats in |output| and returns how many were converted,
+// which may be fewer than |count|.  The caller converts the rest.  The input vertices are |stride|
+// bytes apart, and the output vertices are tightly packed.  The output components past the input
+// components are zero, except for the alpha channel of 4-component outputs which is one.
+using VertexConversionFunction = size_t (*)(const uint8_t *input,
+                                            size_t stride,
+                                            size_t count,
+                                            size_t inputComponentCount,
+                                            size_t outputComponentCount,
+                                            uint8_t *output);
+
+// Like VertexConversionFunction, but copies the components unchanged and pads the output to 4
+// components, with zeros and the low bytes of |alphaBits| in the alpha channel.
+using VertexPaddingFunction = size_t (*)(const uint8_t *input,
+                                         size_t stride,
+                                         size_t count,
+                                         size_t inputComponentCount,
+                                         uint32_t alphaBits,
+                                         uint8_t *output);
+
+enum class VertexComponentType : uint8_t
+{
+    Byte,
+    UnsignedByte,
+    Short,
+    UnsignedShort,
+
+    InvalidEnum,
+    EnumCount = InvalidEnum,
+};
+
+template <typename T>
+constexpr VertexComponentType GetVertexComponentType()
+{
+    return std::is_same<T, int8_t>::value     ? VertexComponentType::Byte
+           : std::is_same<T, uint8_t>::value  ? VertexComponentType::UnsignedByte
+           : std::is_same<T, int16_t>::value  ? VertexComponentType::Short
+           : std::is_same<T, uint16_t>::value ? VertexComponentType::UnsignedShort
+                                              : VertexComponentType::InvalidEnum;
+}
+
+constexpr size_t GetComponentSizeLog2(size_t componentSize)
+{
+    return componentSize == 4 ? 2 : componentSize - 1;
+}
+
+struct VertexConversionFunctions
+{
+    // Indexed by VertexComponentType.
+    std::array<VertexConversionFunction, 4> toFloat;
+    std::array<VertexConversionFunction, 4> normalizedToFloat;
+    // Indexed by the log2 of the component size, for 1, 2 and 4-byte components.
+    std::array<VertexPaddingFunction, 3> padTo4Components;
+};
+
+// The fastest implementations the CPU supports, selected the first time this is called.  On x86,
+// the SSE4.1 kernels are used if the CPU has it, and the SSE2 ones otherwise.
+const VertexConversionFunctions &GetVertexConversionFunctions();
+}  // namespace priv
+}  // namespace rx
+
+#endif  // LIBANGLE_RENDERER_COPYVERTEX_SIMD_H_
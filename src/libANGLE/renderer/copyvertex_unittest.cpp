@@ -0,0 +1,180 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// copyvertex_unittest.cpp: Unit tests for the vertex conversion functions, checking that the
+// vectorized kernels convert the same as the scalar code.
+//
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+
+#include "libANGLE/renderer/copyvertex.h"
+
+namespace rx
+{
+namespace
+{
+constexpr size_t kMaxVertexCount = 37;
+
+// Returns the bytes of |count| vertices |stride| bytes apart, starting |offset| bytes into the
+// returned buffer.  The buffer ends right after the last vertex, so reads past it are caught by
+// ASan.
+template <typename T>
+std::vector<uint8_t> MakeInput(size_t offset, size_t stride, size_t count, size_t componentCount)
+{
+    std::vector<uint8_t> input(offset + (count - 1) * stride + componentCount * sizeof(T));
+    for (size_t index = 0; index < input.size(); ++index)
+    {
+        input[index] = static_cast<uint8_t>(index * 97 + 13);
+    }
+
+    // Include the extreme values, which are clamped or exactly one when normalized.
+    const T extremes[] = {std::numeric_limits<T>::min(), std::numeric_limits<T>::max()};
+    memcpy(input.data() + offset, extremes, std::min(sizeof(extremes), componentCount * sizeof(T)));
+    return input;
+}
+
+template <typename T>
+T ReadComponent(const uint8_t *input, size_t stride, size_t vertex, size_t component)
+{
+    T value;
+    memcpy(&value, input + vertex * stride + component * sizeof(T), sizeof(T));
+    return value;
+}
+
+template <typename T, size_t inputComponentCount, size_t outputComponentCount, bool normalized>
+void CheckToFloat()
+{
+    for (size_t count = 1; count <= kMaxVertexCount; ++count)
+    {
+        for (size_t stride : {inputComponentCount * sizeof(T), size_t(6), size_t(12), size_t(20)})
+        {
+            if (stride < inputComponentCount * sizeof(T))
+            {
+                continue;
+            }
+
+            for (size_t offset = 0; offset < 4; ++offset)
+            {
+                const std::vector<uint8_t> input =
+                    MakeInput<T>(offset, stride, count, inputComponentCount);
+                std::vector<float> output(count * outputComponentCount);
+                CopyToFloatVertexData<T, inputComponentCount, outputComponentCount, normalized,
+                                      false>(input.data() + offset, stride, count,
+                                             reinterpret_cast<uint8_t *>(output.data()));
+
+                for (size_t vertex = 0; vertex < count; ++vertex)
+                {
+                    for (size_t component = 0; component < outputComponentCount; ++component)
+                    {
+                        float expected = component == 3 ? 1.0f : 0.0f;
+                        if (component < inputComponentCount)
+                        {
+                            const T value = ReadComponent<T>(input.data() + offset, stride,
+                                                             vertex, component);
+                            expected      = static_cast<float>(value);
+                            if (normalized)
+                            {
+                                expected = std::max(
+                                    expected / static_cast<float>(std::numeric_limits<T>::max()),
+                                    -1.0f);
+                            }
+                        }
+
+                        ASSERT_EQ(expected, output[vertex * outputComponentCount + component])
+                            << "count " << count << " stride " << stride << " offset " << offset
+                            << " vertex " << vertex << " component " << component;
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <typename T, size_t inputComponentCount, uint32_t alphaDefaultValueBits>
+void CheckPadding()
+{
+    const T alpha = gl::bitCast<T>(alphaDefaultValueBits);
+
+    for (size_t count = 1; count <= kMaxVertexCount; ++count)
+    {
+        for (size_t stride : {inputComponentCount * sizeof(T), size_t(12), size_t(20)})
+        {
+            if (stride < inputComponentCount * sizeof(T))
+            {
+                continue;
+            }
+
+            for (size_t offset = 0; offset < 4; ++offset)
+            {
+                const std::vector<uint8_t> input =
+                    MakeInput<T>(offset, stride, count, inputComponentCount);
+                std::vector<T> output(count * 4);
+                CopyNativeVertexData<T, inputComponentCount, 4, alphaDefaultValueBits>(
+                    input.data() + offset, stride, count,
+                    reinterpret_cast<uint8_t *>(output.data()));
+
+                for (size_t vertex = 0; vertex < count; ++vertex)
+                {
+                    for (size_t component = 0; component < 4; ++component)
+                    {
+                        T expected = component == 3 ? alpha : 0;
+                        if (component < inputComponentCount)
+                        {
+                            expected = ReadComponent<T>(input.data() + offset, stride, vertex,
+                                                        component);
+                        }
+
+                        ASSERT_EQ(0, memcmp(&expected, &output[vertex * 4 + component], sizeof(T)))
+                            << "count " << count << " stride " << stride << " offset " << offset
+                            << " vertex " << vertex << " component " << component;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Test the conversion of normalized integers to float.
+TEST(CopyVertexTest, NormalizedToFloat)
+{
+    CheckToFloat<GLbyte, 1, 1, true>();
+    CheckToFloat<GLbyte, 3, 4, true>();
+    CheckToFloat<GLubyte, 2, 2, true>();
+    CheckToFloat<GLubyte, 4, 4, true>();
+    CheckToFloat<GLshort, 3, 3, true>();
+    CheckToFloat<GLshort, 4, 4, true>();
+    CheckToFloat<GLushort, 1, 4, true>();
+    CheckToFloat<GLushort, 3, 3, true>();
+}
+
+// Test the conversion of integers to float without normalization.
+TEST(CopyVertexTest, ScaledToFloat)
+{
+    CheckToFloat<GLbyte, 2, 2, false>();
+    CheckToFloat<GLubyte, 3, 4, false>();
+    CheckToFloat<GLshort, 1, 1, false>();
+    CheckToFloat<GLshort, 3, 4, false>();
+    CheckToFloat<GLushort, 2, 2, false>();
+    CheckToFloat<GLushort, 4, 4, false>();
+}
+
+// Test the padding of vertices to 4 components.
+TEST(CopyVertexTest, PadTo4Components)
+{
+    CheckPadding<GLubyte, 3, std::numeric_limits<GLubyte>::max()>();
+    CheckPadding<GLbyte, 3, 1>();
+    CheckPadding<GLshort, 3, std::numeric_limits<GLshort>::max()>();
+    CheckPadding<GLushort, 2, 1>();
+    CheckPadding<GLhalf, 3, gl::Float16One>();
+    CheckPadding<GLfloat, 3, gl::Float32One>();
+    CheckPadding<GLuint, 1, 1>();
+}
+}  // anonymous namespace
+}  // namespace rx
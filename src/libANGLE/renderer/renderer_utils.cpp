@@ -1036,12 +1036,64 @@ void GetMatrixUniform(GLenum type, NonFloatT *dataOut, const NonFloatT *source,
     UNREACHABLE();
 }
 
+void DirtyUniformRanges::add(size_t offset, size_t size)
+{
+    // glUniform* calls with a count of zero write nothing.
+    if (size == 0)
+    {
+        return;
+    }
+    gl::Range<size_t> range(offset, offset + size);
+
+    size_t index = 0;
+    while (index < mRanges.size())
+    {
+        // Absorb the ranges the new one overlaps or touches.  Since the new range grows, start over
+        // after each merge.
+        if (mRanges[index].intersectsOrContinuous(range))
+        {
+            range.merge(mRanges[index]);
+            mRanges[index] = mRanges.back();
+            mRanges.pop_back();
+            index = 0;
+            continue;
+        }
+        ++index;
+
+        // If the remaining ranges are disjoint but there is no room for another, merge with the
+        // closest one.
+        if (index == mRanges.size() && mRanges.full())
+        {
+            size_t closestIndex = 0;
+            size_t closestGap   = std::numeric_limits<size_t>::max();
+            for (size_t otherIndex = 0; otherIndex < mRanges.size(); ++otherIndex)
+            {
+                const gl::Range<size_t> &other = mRanges[otherIndex];
+                const size_t gap               = other.high() < range.low()
+                                                     ? range.low() - other.high()
+                                                     : other.low() - range.high();
+                if (gap < closestGap)
+                {
+                    closestIndex = otherIndex;
+                    closestGap   = gap;
+                }
+            }
+            range.merge(mRanges[closestIndex]);
+            mRanges[closestIndex] = mRanges.back();
+            mRanges.pop_back();
+            index = 0;
+        }
+    }
+
+    mRanges.push_back(range);
+}
+
 BufferAndLayout::BufferAndLayout() = default;
 
 BufferAndLayout::~BufferAndLayout() = default;
 
 template <typename T>
-ANGLE_NOINLINE void UpdateBufferWithLayoutStrided(GLsizei count,
+ANGLE_NOINLINE bool UpdateBufferWithLayoutStrided(GLsizei count,
                                                   uint32_t arrayIndex,
                                                   int componentCount,
                                                   const T *v,
@@ -1051,6 +1103,7 @@ ANGLE_NOINLINE void UpdateBufferWithLayoutStrided(GLsizei count,
     const int elementSize = sizeof(T) * componentCount;
     uint8_t *dst          = uniformData->data() + layoutInfo.offset;
     int maxIndex          = arrayIndex + count;
+    bool changed          = false;
     for (int writeIndex = arrayIndex, readIndex = 0; writeIndex < maxIndex;
          writeIndex++, readIndex++)
     {
@@ -1058,12 +1111,17 @@ ANGLE_NOINLINE void UpdateBufferWithLayoutStrided(GLsizei count,
         uint8_t *writePtr     = dst + arrayOffset;
         const T *readPtr      = v + (readIndex * componentCount);
         ASSERT(writePtr + elementSize <= uniformData->data() + uniformData->size());
-        memcpy(writePtr, readPtr, elementSize);
+        if (memcmp(writePtr, readPtr, elementSize) != 0)
+        {
+            memcpy(writePtr, readPtr, elementSize);
+            changed = true;
+        }
     }
+    return changed;
 }
 
 template <typename T>
-ANGLE_INLINE void UpdateBufferWithLayout(GLsizei count,
+ANGLE_INLINE bool UpdateBufferWithLayout(GLsizei count,
                                          uint32_t arrayIndex,
                                          int componentCount,
                                          const T *v,
@@ -1078,16 +1136,37 @@ ANGLE_INLINE void UpdateBufferWithLayout(GLsizei count,
         uint32_t arrayOffset = arrayIndex * layoutInfo.arrayStride;
         uint8_t *writePtr    = dst + arrayOffset;
         ASSERT(writePtr + (elementSize * count) <= uniformData->data() + uniformData->size());
+        // Applications often set uniforms to the values they already have.  Comparing is cheaper
+        // than uploading the block again.
+        if (memcmp(writePtr, v, elementSize * count) == 0)
+        {
+            return false;
+        }
         memcpy(writePtr, v, elementSize * count);
+        return true;
     }
     else
     {
         // Have to respect the arrayStride between each element of the array.
-        UpdateBufferWithLayoutStrided(count, arrayIndex, componentCount, v, layoutInfo,
-                                      uniformData);
+        return UpdateBufferWithLayoutStrided(count, arrayIndex, componentCount, v, layoutInfo,
+                                             uniformData);
     }
 }
 
+namespace
+{
+// Returns the number of bytes from the start of the first written array element to the end of the
+// last one.
+size_t GetUniformWriteSize(GLsizei count, size_t elementSize, const sh::BlockMemberInfo &layoutInfo)
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+    return static_cast<size_t>(count - 1) * layoutInfo.arrayStride + elementSize;
+}
+}  // anonymous namespace
+
 template <typename T>
 void ReadFromBufferWithLayout(int componentCount,
                               uint32_t arrayIndex,
@@ -1155,6 +1234,9 @@ ANGLE_NOINLINE void SetUniformAsBool(const gl::ProgramExecutable *executable,
             }
         }
 
+        uniformBlock.dirtyRanges.add(
+            initialArrayOffset,
+            GetUniformWriteSize(count, sizeof(GLint) * componentCount, layoutInfo));
         defaultUniformBlocksDirty->set(shaderType);
     }
 }
@@ -1187,8 +1269,15 @@ void SetUniform(const gl::ProgramExecutable *executable,
             }
 
             const GLint componentCount = linkedUniform.getElementComponents();
-            UpdateBufferWithLayout(count, locationInfo.arrayIndex, componentCount, v, layoutInfo,
-                                   &uniformBlock.uniformData);
+            if (!UpdateBufferWithLayout(count, locationInfo.arrayIndex, componentCount, v,
+                                        layoutInfo, &uniformBlock.uniformData))
+            {
+                continue;
+            }
+
+            uniformBlock.dirtyRanges.add(
+                layoutInfo.offset + locationInfo.arrayIndex * layoutInfo.arrayStride,
+                GetUniformWriteSize(count, sizeof(T) * componentCount, layoutInfo));
             defaultUniformBlocksDirty->set(shaderType);
         }
     }
@@ -1243,10 +1332,20 @@ void SetUniformMatrixfv(const gl::ProgramExecutable *executable,
             continue;
         }
 
+        const unsigned int elementCount = linkedUniform.getBasicTypeElementCount();
         SetFloatUniformMatrixGLSL<cols, rows>::Run(
-            locationInfo.arrayIndex, linkedUniform.getBasicTypeElementCount(), count, transpose,
-            value, uniformBlock.uniformData.data() + layoutInfo.offset);
-
+            locationInfo.arrayIndex, elementCount, count, transpose, value,
+            uniformBlock.uniformData.data() + layoutInfo.offset);
+
+        // The matrices are written tightly packed, with each column padded to 4 rows.  Elements
+        // past the end of the array are not written.
+        constexpr size_t kMatrixSize = cols * 4 * sizeof(GLfloat);
+        ASSERT(layoutInfo.arrayStride == 0 ||
+               static_cast<size_t>(layoutInfo.arrayStride) == kMatrixSize);
+        const size_t writtenCount =
+            std::min<size_t>(elementCount - locationInfo.arrayIndex, static_cast<size_t>(count));
+        uniformBlock.dirtyRanges.add(layoutInfo.offset + locationInfo.arrayIndex * kMatrixSize,
+                                     writtenCount * kMatrixSize);
         defaultUniformBlocksDirty->set(shaderType);
     }
 }
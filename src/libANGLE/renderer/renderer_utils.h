@@ -273,6 +273,25 @@ void GetMatrixUniform(GLenum type, GLfloat *dataOut, const GLfloat *source, bool
 template <typename NonFloatT>
 void GetMatrixUniform(GLenum type, NonFloatT *dataOut, const NonFloatT *source, bool transpose);
 
+// The byte ranges of a default uniform block's shadow buffer that were modified since the backend
+// last uploaded it.  At most kMaxRanges disjoint ranges are kept; when another one is added, it is
+// merged with the closest one.
+class DirtyUniformRanges final
+{
+  public:
+    static constexpr size_t kMaxRanges = 4;
+    using Ranges                       = angle::FixedVector<gl::Range<size_t>, kMaxRanges>;
+
+    void add(size_t offset, size_t size);
+    void reset() { mRanges.clear(); }
+
+    bool empty() const { return mRanges.empty(); }
+    const Ranges &getRanges() const { return mRanges; }
+
+  private:
+    Ranges mRanges;
+};
+
 // Contains a CPU-side buffer and its data layout, used as a shadow buffer for default uniform
 // blocks in VK and WGPU backends.
 struct BufferAndLayout final : private angle::NonCopyable
@@ -286,10 +305,14 @@ struct BufferAndLayout final : private angle::NonCopyable
     // Tells us where to write on a call to a setUniform method. They are arranged in uniform
     // location order.
     std::vector<sh::BlockMemberInfo> uniformLayout;
+
+    // The parts of uniformData that setUniform methods changed since the last upload.
+    DirtyUniformRanges dirtyRanges;
 };
 
+// Returns false if the buffer already contained the values.
 template <typename T>
-void UpdateBufferWithLayout(GLsizei count,
+bool UpdateBufferWithLayout(GLsizei count,
                             uint32_t arrayIndex,
                             int componentCount,
                             const T *v,
@@ -4,21 +4,217 @@
 // found in the LICENSE file.
 //
 // AllocatorHelperPool:
-//    Implements the pool allocator helpers used in the command buffers.
+//    Implements the slab allocator helpers used in the command buffers.
 //
 
 #include "libANGLE/renderer/vulkan/AllocatorHelperPool.h"
+
+#include "common/system_utils.h"
 #include "libANGLE/renderer/vulkan/SecondaryCommandBuffer.h"
 
 namespace rx
 {
 namespace vk
 {
+namespace
+{
+// Slabs that are not reused for this long (in seconds) are freed.
+constexpr double kIdleSlabTime = 2.0;
+}  // anonymous namespace
+
+// CommandMemorySlabPool implementation.
+CommandMemorySlabPool::CommandMemorySlabPool() : mLastTrimTime(0), mStatistics{} {}
+
+CommandMemorySlabPool::~CommandMemorySlabPool()
+{
+    destroy();
+}
+
+// static
+size_t CommandMemorySlabPool::GetSizeClass(size_t size)
+{
+    ASSERT(size <= kMaxSlabSize);
+
+    size_t sizeClass = 0;
+    while (GetSlabSize(sizeClass) < size)
+    {
+        ++sizeClass;
+    }
+    return sizeClass;
+}
+
+CommandMemorySlab CommandMemorySlabPool::acquireSlab(size_t size)
+{
+    if (size > kMaxSlabSize)
+    {
+        // Larger than any size class, so the slab is not kept for reuse once released.
+        std::unique_lock<angle::SimpleMutex> lock(mMutex);
+        mStatistics.slabBytes += size;
+        ++mStatistics.allocatedSlabCount;
+        lock.unlock();
+
+        return {new uint8_t[size], size};
+    }
+
+    const size_t sizeClass = GetSizeClass(size);
+    const size_t slabSize  = GetSlabSize(sizeClass);
+
+    {
+        std::unique_lock<angle::SimpleMutex> lock(mMutex);
+
+        // Reuse the most recently released slab, which is the most likely to be in the caches.
+        std::vector<FreeSlab> &freeSlabs = mFreeSlabs[sizeClass];
+        if (!freeSlabs.empty())
+        {
+            uint8_t *memory = freeSlabs.back().memory;
+            freeSlabs.pop_back();
+            mStatistics.freeSlabBytes -= slabSize;
+            ++mStatistics.reusedSlabCount;
+            return {memory, slabSize};
+        }
+
+        mStatistics.slabBytes += slabSize;
+        ++mStatistics.allocatedSlabCount;
+    }
+
+    return {new uint8_t[slabSize], slabSize};
+}
+
+void CommandMemorySlabPool::releaseSlabs(const std::vector<CommandMemorySlab> &slabs)
+{
+    if (slabs.empty())
+    {
+        return;
+    }
+
+    const double releaseTime = angle::GetCurrentSystemTime();
+
+    std::unique_lock<angle::SimpleMutex> lock(mMutex);
+    for (const CommandMemorySlab &slab : slabs)
+    {
+        if (slab.size > kMaxSlabSize)
+        {
+            delete[] slab.memory;
+            mStatistics.slabBytes -= slab.size;
+            continue;
+        }
+
+        mFreeSlabs[GetSizeClass(slab.size)].push_back({slab.memory, releaseTime});
+        mStatistics.freeSlabBytes += slab.size;
+    }
+}
+
+void CommandMemorySlabPool::trimIdleSlabs(double currentTime)
+{
+    std::unique_lock<angle::SimpleMutex> lock(mMutex);
+
+    if (currentTime - mLastTrimTime < kTrimPeriodMs / 1000.0)
+    {
+        return;
+    }
+    mLastTrimTime = currentTime;
+
+    for (size_t sizeClass = 0; sizeClass < kSizeClassCount; ++sizeClass)
+    {
+        // The slabs are released in time order, so the idle ones are at the front.
+        std::vector<FreeSlab> &freeSlabs = mFreeSlabs[sizeClass];
+        size_t idleCount                 = 0;
+        while (idleCount < freeSlabs.size() &&
+               currentTime - freeSlabs[idleCount].releaseTime > kIdleSlabTime)
+        {
+            delete[] freeSlabs[idleCount].memory;
+            ++idleCount;
+        }
+
+        if (idleCount > 0)
+        {
+            freeSlabs.erase(freeSlabs.begin(), freeSlabs.begin() + idleCount);
+
+            const size_t idleBytes = idleCount * GetSlabSize(sizeClass);
+            mStatistics.slabBytes -= idleBytes;
+            mStatistics.freeSlabBytes -= idleBytes;
+            mStatistics.trimmedSlabCount += static_cast<uint32_t>(idleCount);
+        }
+    }
+}
+
+void CommandMemorySlabPool::destroy()
+{
+    std::unique_lock<angle::SimpleMutex> lock(mMutex);
+
+    for (std::vector<FreeSlab> &freeSlabs : mFreeSlabs)
+    {
+        for (const FreeSlab &freeSlab : freeSlabs)
+        {
+            delete[] freeSlab.memory;
+        }
+        freeSlabs.clear();
+    }
+
+    mStatistics.slabBytes -= mStatistics.freeSlabBytes;
+    mStatistics.freeSlabBytes = 0;
+}
+
+CommandMemorySlabPool::Statistics CommandMemorySlabPool::getStatistics() const
+{
+    std::unique_lock<angle::SimpleMutex> lock(mMutex);
+    return mStatistics;
+}
+
+CommandMemorySlabPool::Statistics CommandMemorySlabPool::getAndResetSlabCounts()
+{
+    std::unique_lock<angle::SimpleMutex> lock(mMutex);
+    const Statistics statistics    = mStatistics;
+    mStatistics.reusedSlabCount    = 0;
+    mStatistics.allocatedSlabCount = 0;
+    mStatistics.trimmedSlabCount   = 0;
+    return statistics;
+}
+
+// DedicatedCommandMemoryAllocator implementation.
+DedicatedCommandMemoryAllocator::DedicatedCommandMemoryAllocator()
+    : mSlabPool(nullptr), mWritePointer(nullptr), mBytesRemaining(0), mSlabBytes(0)
+{}
+
+DedicatedCommandMemoryAllocator::~DedicatedCommandMemoryAllocator()
+{
+    releaseSlabs();
+}
+
+void DedicatedCommandMemoryAllocator::acquireSlab(size_t size)
+{
+    ASSERT(mSlabPool != nullptr);
+
+    // The rest of the current slab is wasted, which is at most a command block for the common
+    // case of blocks of DedicatedCommandBlockPool::kBlockSize.
+    const CommandMemorySlab slab =
+        mSlabPool->acquireSlab(std::max(size, CommandMemorySlabPool::kMinSlabSize));
+    mSlabs.push_back(slab);
+
+    mWritePointer   = slab.memory;
+    mBytesRemaining = slab.size;
+    mSlabBytes += slab.size;
+}
+
+void DedicatedCommandMemoryAllocator::releaseSlabs()
+{
+    if (mSlabs.empty())
+    {
+        return;
+    }
+
+    mSlabPool->releaseSlabs(mSlabs);
+    mSlabs.clear();
+
+    mWritePointer   = nullptr;
+    mBytesRemaining = 0;
+    mSlabBytes      = 0;
+}
 
+// DedicatedCommandBlockAllocator implementation.
 void DedicatedCommandBlockAllocator::resetAllocator()
 {
-    mAllocator.pop();
-    mAllocator.push();
+    mAllocator.releaseSlabs();
 }
 
 void DedicatedCommandBlockPool::reset(CommandBufferCommandTracker *commandBufferTracker)
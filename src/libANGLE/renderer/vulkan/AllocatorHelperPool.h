@@ -4,13 +4,17 @@
 // found in the LICENSE file.
 //
 // AllocatorHelperPool:
-//    Manages the pool allocators used in the command buffers.
+//    Manages the slab allocators used in the command buffers.
 //
 
 #ifndef LIBANGLE_RENDERER_VULKAN_ALLOCATORHELPERPOOL_H_
 #define LIBANGLE_RENDERER_VULKAN_ALLOCATORHELPERPOOL_H_
 
-#include "common/PoolAlloc.h"
+#include <array>
+#include <vector>
+
+#include "common/SimpleMutex.h"
+#include "common/mathutil.h"
 #include "common/vulkan/vk_headers.h"
 #include "libANGLE/renderer/vulkan/vk_command_buffer_utils.h"
 #include "libANGLE/renderer/vulkan/vk_wrapper.h"
@@ -24,7 +28,113 @@ namespace priv
 class SecondaryCommandBuffer;
 }  // namespace priv
 
-using DedicatedCommandMemoryAllocator = angle::PoolAllocator;
+struct CommandMemorySlab
+{
+    uint8_t *memory;
+    size_t size;
+};
+
+// The memory that the command buffers of all contexts allocate their command blocks from, in
+// slabs of a few size classes.  The smallest slabs hold a dozen command blocks, and the largest fit
+// the largest command.  Slabs released by the command buffers are kept in per-size-class free
+// lists, and the ones that stay unused for a while are freed by trimIdleSlabs().  Requests larger
+// than the largest size class get a slab of their own, which is freed as soon as it is released.
+// Thread-safe.
+class CommandMemorySlabPool final : angle::NonCopyable
+{
+  public:
+    static constexpr size_t kMinSlabSize    = 16 * 1024;
+    static constexpr size_t kSizeClassCount = 4;
+    static constexpr size_t kMaxSlabSize    = kMinSlabSize << (kSizeClassCount - 1);
+    // How often the idle slabs are looked for.
+    static constexpr uint32_t kTrimPeriodMs = 500;
+
+    struct Statistics
+    {
+        // Size of all slabs, and of the ones in the free lists.
+        size_t slabBytes;
+        size_t freeSlabBytes;
+        // Number of slabs taken from the free lists, allocated and trimmed since the last call
+        // to getAndResetSlabCounts().
+        uint32_t reusedSlabCount;
+        uint32_t allocatedSlabCount;
+        uint32_t trimmedSlabCount;
+    };
+
+    CommandMemorySlabPool();
+    ~CommandMemorySlabPool();
+
+    // Returns a slab of at least |size| bytes.
+    CommandMemorySlab acquireSlab(size_t size);
+    void releaseSlabs(const std::vector<CommandMemorySlab> &slabs);
+
+    // Frees the slabs that were not reused in the last kIdleSlabTime seconds.  Only does so every
+    // kTrimPeriodMs, so it can be called often.
+    void trimIdleSlabs(double currentTime);
+    // Frees all slabs in the free lists.
+    void destroy();
+
+    Statistics getStatistics() const;
+    // Returns the statistics and resets the slab counts at once, so no count is lost to a slab
+    // acquired or released in between.
+    Statistics getAndResetSlabCounts();
+
+  private:
+    struct FreeSlab
+    {
+        uint8_t *memory;
+        // The time the slab was released, which is increasing in each free list.
+        double releaseTime;
+    };
+
+    static size_t GetSizeClass(size_t size);
+    static size_t GetSlabSize(size_t sizeClass) { return kMinSlabSize << sizeClass; }
+
+    mutable angle::SimpleMutex mMutex;
+    std::array<std::vector<FreeSlab>, kSizeClassCount> mFreeSlabs;
+    double mLastTrimTime;
+    Statistics mStatistics;
+};
+
+// Allocates the command blocks of a command buffer helper from the slabs of the shared
+// CommandMemorySlabPool.  Blocks are carved from the last acquired slab, and all slabs are
+// returned to the pool when the helper is reset.  Not thread-safe.
+class DedicatedCommandMemoryAllocator final : angle::NonCopyable
+{
+  public:
+    DedicatedCommandMemoryAllocator();
+    ~DedicatedCommandMemoryAllocator();
+
+    void init(CommandMemorySlabPool *slabPool) { mSlabPool = slabPool; }
+    void releaseSlabs();
+
+    uint8_t *fastAllocate(size_t size)
+    {
+        // Keep the blocks 8-byte aligned for the 64-bit members of the commands.
+        size = roundUpPow2<size_t>(size, 8);
+        if (size > mBytesRemaining)
+        {
+            acquireSlab(size);
+        }
+
+        uint8_t *memory = mWritePointer;
+        mWritePointer += size;
+        mBytesRemaining -= size;
+        return memory;
+    }
+
+    // Size of the slabs currently held by this allocator.
+    size_t getSlabBytes() const { return mSlabBytes; }
+
+  private:
+    void acquireSlab(size_t size);
+
+    CommandMemorySlabPool *mSlabPool;
+    std::vector<CommandMemorySlab> mSlabs;
+    uint8_t *mWritePointer;
+    size_t mBytesRemaining;
+    size_t mSlabBytes;
+};
 
 // Used in CommandBufferHelperCommon
 class DedicatedCommandBlockAllocator
@@ -33,19 +143,14 @@ class DedicatedCommandBlockAllocator
     DedicatedCommandBlockAllocator() = default;
     void resetAllocator();
 
-    static constexpr size_t kDefaultPoolAllocatorPageSize = 16 * 1024;
-    void init()
-    {
-        mAllocator.initialize(kDefaultPoolAllocatorPageSize, 1);
-        // Push a scope into the pool allocator so we can easily free and re-init on reset()
-        mAllocator.push();
-    }
+    void init(CommandMemorySlabPool *slabPool) { mAllocator.init(slabPool); }
 
     DedicatedCommandMemoryAllocator *getAllocator() { return &mAllocator; }
+    size_t getMemorySize() const { return mAllocator.getSlabBytes(); }
 
   private:
-    // Using a pool allocator per CBH to avoid threading issues that occur w/ shared allocator
-    // between multiple CBHs.
+    // Using an allocator per CBH keeps the slab pool's lock out of command recording; it is only
+    // taken to acquire and release whole slabs.
     DedicatedCommandMemoryAllocator mAllocator;
 };
 
@@ -64,9 +169,10 @@ class DedicatedCommandBlockPool final
     using CommandHeaderIDType                  = uint16_t;
     // Make sure the size of command header ID type is less than total command header size.
     static_assert(sizeof(CommandHeaderIDType) < kCommandHeaderSize, "Check size of CommandHeader");
-    // Pool Alloc uses 16kB pages w/ 16byte header = 16368bytes. To minimize waste
-    //  using a 16368/12 = 1364. Also better perf than 1024 due to fewer block allocations
+    // The smallest slabs are 16kB.  To minimize waste, a slab holds 12 blocks of 1360 bytes (16320
+    // bytes).  Also better perf than 1024 due to fewer block allocations
     static constexpr size_t kBlockSize = 1360;
+    static_assert(CommandMemorySlabPool::kMinSlabSize / kBlockSize == 12, "Check kBlockSize");
     // Make sure block size is 8-byte aligned to avoid ASAN errors.
     static_assert((kBlockSize % 8) == 0, "Check kBlockSize alignment");
 
@@ -134,8 +240,6 @@ class DedicatedCommandBlockPool final
         return headerPointer;
     }
 
-    // Using a pool allocator per CBH to avoid threading issues that occur w/ shared allocator
-    // between multiple CBHs.
     DedicatedCommandMemoryAllocator *mAllocator;
     uint8_t *mCurrentWritePointer;
     size_t mCurrentBytesRemaining;
@@ -0,0 +1,123 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// AllocatorHelperPool_unittest.cpp: Unit tests for the slab allocator of the command buffers'
+// memory.
+//
+
+#include "gtest/gtest.h"
+
+#include "common/system_utils.h"
+#include "libANGLE/renderer/vulkan/AllocatorHelperPool.h"
+
+namespace rx
+{
+namespace vk
+{
+namespace
+{
+constexpr size_t kSmallAllocation = DedicatedCommandBlockPool::kBlockSize;
+
+// Test that the slabs released by an allocator are reused by the next one.
+TEST(CommandMemorySlabPoolTest, SlabsAreReused)
+{
+    CommandMemorySlabPool slabPool;
+    DedicatedCommandMemoryAllocator allocatorA;
+    DedicatedCommandMemoryAllocator allocatorB;
+    allocatorA.init(&slabPool);
+    allocatorB.init(&slabPool);
+
+    uint8_t *memory = allocatorA.fastAllocate(kSmallAllocation);
+    EXPECT_EQ(CommandMemorySlabPool::kMinSlabSize, allocatorA.getSlabBytes());
+    allocatorA.releaseSlabs();
+    EXPECT_EQ(0u, allocatorA.getSlabBytes());
+
+    EXPECT_EQ(memory, allocatorB.fastAllocate(kSmallAllocation));
+    allocatorB.releaseSlabs();
+
+    CommandMemorySlabPool::Statistics stats = slabPool.getStatistics();
+    EXPECT_EQ(1u, stats.allocatedSlabCount);
+    EXPECT_EQ(1u, stats.reusedSlabCount);
+    EXPECT_EQ(CommandMemorySlabPool::kMinSlabSize, stats.slabBytes);
+    EXPECT_EQ(CommandMemorySlabPool::kMinSlabSize, stats.freeSlabBytes);
+}
+
+// Test that consecutive allocations are carved from the same slab until it is full, and that large
+// allocations take a slab of a larger size class.
+TEST(CommandMemorySlabPoolTest, AllocationsShareSlabs)
+{
+    CommandMemorySlabPool slabPool;
+    DedicatedCommandMemoryAllocator allocator;
+    allocator.init(&slabPool);
+
+    const size_t allocationsPerSlab = CommandMemorySlabPool::kMinSlabSize / kSmallAllocation;
+    uint8_t *first                  = allocator.fastAllocate(kSmallAllocation);
+    for (size_t index = 1; index < allocationsPerSlab; ++index)
+    {
+        EXPECT_EQ(first + index * kSmallAllocation, allocator.fastAllocate(kSmallAllocation));
+    }
+    EXPECT_EQ(CommandMemorySlabPool::kMinSlabSize, allocator.getSlabBytes());
+
+    allocator.fastAllocate(kSmallAllocation);
+    EXPECT_EQ(CommandMemorySlabPool::kMinSlabSize * 2, allocator.getSlabBytes());
+
+    allocator.fastAllocate(CommandMemorySlabPool::kMinSlabSize + 1);
+    EXPECT_EQ(CommandMemorySlabPool::kMinSlabSize * 4, allocator.getSlabBytes());
+
+    allocator.releaseSlabs();
+    EXPECT_EQ(3u, slabPool.getStatistics().allocatedSlabCount);
+}
+
+// Test that allocations larger than the largest size class get a slab of their own, which is freed
+// instead of being kept for reuse when released.
+TEST(CommandMemorySlabPoolTest, OversizeSlabsAreFreed)
+{
+    CommandMemorySlabPool slabPool;
+    DedicatedCommandMemoryAllocator allocator;
+    allocator.init(&slabPool);
+
+    const size_t oversize = CommandMemorySlabPool::kMaxSlabSize * 3;
+    uint8_t *memory       = allocator.fastAllocate(oversize);
+    memset(memory, 0xAB, oversize);
+    EXPECT_EQ(oversize, allocator.getSlabBytes());
+    EXPECT_EQ(oversize, slabPool.getStatistics().slabBytes);
+
+    allocator.releaseSlabs();
+    CommandMemorySlabPool::Statistics stats = slabPool.getStatistics();
+    EXPECT_EQ(1u, stats.allocatedSlabCount);
+    EXPECT_EQ(0u, stats.slabBytes);
+    EXPECT_EQ(0u, stats.freeSlabBytes);
+}
+
+// Test that only the slabs that were idle for long enough are trimmed.
+TEST(CommandMemorySlabPoolTest, IdleSlabsAreTrimmed)
+{
+    CommandMemorySlabPool slabPool;
+    DedicatedCommandMemoryAllocator allocator;
+    allocator.init(&slabPool);
+
+    allocator.fastAllocate(kSmallAllocation);
+    allocator.releaseSlabs();
+
+    const double releaseTime = angle::GetCurrentSystemTime();
+    slabPool.trimIdleSlabs(releaseTime);
+    EXPECT_EQ(0u, slabPool.getStatistics().trimmedSlabCount);
+    EXPECT_EQ(CommandMemorySlabPool::kMinSlabSize, slabPool.getStatistics().freeSlabBytes);
+
+    slabPool.trimIdleSlabs(releaseTime + 60.0);
+    CommandMemorySlabPool::Statistics stats = slabPool.getAndResetSlabCounts();
+    EXPECT_EQ(1u, stats.trimmedSlabCount);
+    EXPECT_EQ(1u, stats.allocatedSlabCount);
+    EXPECT_EQ(0u, stats.slabBytes);
+    EXPECT_EQ(0u, stats.freeSlabBytes);
+
+    // The counts are reset, but not the sizes.
+    stats = slabPool.getStatistics();
+    EXPECT_EQ(0u, stats.trimmedSlabCount);
+    EXPECT_EQ(0u, stats.allocatedSlabCount);
+}
+}  // anonymous namespace
+}  // namespace vk
+}  // namespace rx
@@ -9,6 +9,7 @@
 
 #include "libANGLE/renderer/vulkan/CommandQueue.h"
 #include <algorithm>
+#include <chrono>
 #include "common/system_utils.h"
 #include "libANGLE/renderer/vulkan/SyncVk.h"
 #include "libANGLE/renderer/vulkan/vk_renderer.h"
@@ -401,8 +402,18 @@ angle::Result CleanUpThread::processTasksImpl(bool *exitThread)
     while (true)
     {
         std::unique_lock<std::mutex> lock(mMutex);
-        mWorkAvailableCondition.wait(lock,
-                                     [this] { return mTaskThreadShouldExit || mNeedCleanUp; });
+        auto hasWork = [this] { return mTaskThreadShouldExit || mNeedCleanUp; };
+        if (mRenderer->getCommandMemorySlabPool()->getStatistics().freeSlabBytes > 0)
+        {
+            // Wake up periodically while there is command memory to trim, so that it is freed even
+            // if the application stops submitting.
+            mWorkAvailableCondition.wait_for(
+                lock, std::chrono::milliseconds(CommandMemorySlabPool::kTrimPeriodMs), hasWork);
+        }
+        else
+        {
+            mWorkAvailableCondition.wait(lock, hasWork);
+        }
 
         if (mTaskThreadShouldExit)
         {
@@ -423,6 +434,9 @@ angle::Result CleanUpThread::processTasksImpl(bool *exitThread)
             }
             mRenderer->cleanupGarbage(nullptr);
         }
+
+        // Free the command memory that no context used lately.
+        mRenderer->trimCommandMemory();
     }
     *exitThread = true;
     return angle::Result::Continue;
@@ -2117,6 +2117,10 @@ angle::Result ContextVk::createGraphicsPipeline()
     ProgramExecutableVk *executableVk = vk::GetImpl(mState.getProgramExecutable());
     ASSERT(executableVk);
 
+    // Hash the chunks of the desc modified by the state changes since the last lookup once, instead
+    // of in every lookup below.
+    mGraphicsPipelineDesc->updateDirtyHashChunks();
+
     // Wait for any warm up task if necessary
     executableVk->waitForGraphicsPostLinkTasks(this, *mGraphicsPipelineDesc);
 
@@ -2210,6 +2214,19 @@ angle::Result ContextVk::createGraphicsPipeline()
                                            mCurrentGraphicsPipeline);
     }
 
+    // If the pipeline caches are bounded, evict the least recently used pipelines of the program.
+    // The pipelines currently bound by the contexts of the share group are kept, as the contexts
+    // reference them directly.
+    if (mRenderer->getGraphicsPipelineCacheMaxSize() > 0)
+    {
+        std::vector<const vk::PipelineHelper *> boundPipelines;
+        for (auto context : mShareGroupVk->getContexts())
+        {
+            boundPipelines.push_back(vk::GetImpl(context.second)->mCurrentGraphicsPipeline);
+        }
+        executableVk->evictGraphicsPipelines(this, boundPipelines);
+    }
+
     return angle::Result::Continue;
 }
 
@@ -2484,6 +2501,7 @@ angle::Result ContextVk::handleDirtyGraphicsPipelineBinding(DirtyBits::Iterator
     ANGLE_TRY(mCurrentGraphicsPipeline->getPreferredPipeline(this, &pipeline));
 
     mRenderPassCommandBuffer->bindGraphicsPipeline(*pipeline);
+    mCurrentGraphicsPipeline->setLastUseSerial(mShareGroupVk->generateGraphicsPipelineUseSerial());
 
     return angle::Result::Continue;
 }
@@ -3525,6 +3543,12 @@ void ContextVk::syncObjectPerfCounters(const angle::VulkanPerfCounters &commandQ
 
     mPerfCounters.pendingSubmissionGarbageObjects =
         static_cast<uint64_t>(mRenderer->getPendingSubmissionGarbageSize());
+
+    // Command memory held by this context's command buffers, and kept for reuse by all contexts.
+    mPerfCounters.commandMemorySizeBytes = mOutsideRenderPassCommands->getCommandMemorySize() +
+                                           mRenderPassCommands->getCommandMemorySize();
+    mPerfCounters.commandMemoryPoolFreeBytes =
+        mRenderer->getCommandMemorySlabPool()->getStatistics().freeSlabBytes;
 }
 
 void ContextVk::updateOverlayOnPresent()
@@ -3586,6 +3610,13 @@ void ContextVk::updateOverlayOnPresent()
         cacheKeySize->add(mPerfCounters.descriptorSetCacheKeySizeBytes);
     }
 
+    {
+        gl::CountWidget *commandMemorySize =
+            overlay->getCountWidget(gl::WidgetId::VulkanCommandMemorySize);
+        commandMemorySize->reset();
+        commandMemorySize->add(mPerfCounters.commandMemorySizeBytes);
+    }
+
     {
         gl::RunningGraphWidget *dynamicBufferAllocations =
             overlay->getRunningGraphWidget(gl::WidgetId::VulkanDynamicBufferAllocations);
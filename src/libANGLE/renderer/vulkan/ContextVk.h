@@ -739,6 +739,10 @@ class ContextVk : public ContextImpl, public vk::Context, public MultisampleText
 
     // For testing only.
     void setDefaultUniformBlocksMinSizeForTesting(size_t minSize);
+    const vk::PipelineHelper *getCurrentGraphicsPipelineForTesting() const
+    {
+        return mCurrentGraphicsPipeline;
+    }
 
     vk::BufferHelper &getEmptyBuffer() { return mEmptyBuffer; }
 
@@ -27,6 +27,9 @@ namespace
 // Limit decompressed vulkan pipelines to 10MB per program.
 static constexpr size_t kMaxLocalPipelineCacheSize = 10 * 1024 * 1024;
 
+// Limit the transformed SPIR-V kept around for reuse by other permutations to 512KB per program.
+static constexpr size_t kMaxSpirvTransformCacheSize = 512 * 1024;
+
 bool ValidateTransformedSpirV(vk::ErrorContext *context,
                               const gl::ShaderBitSet &linkedShaderStages,
                               const ShaderInterfaceVariableInfoMap &variableInfoMap,
@@ -510,6 +513,101 @@ class ProgramExecutableVk::WarmUpGraphicsTask : public WarmUpTaskCommon
     SharedRenderPass *mCompatibleRenderPass;
 };
 
+// Transforms the SPIR-V of one stage of a graphics program and creates its shader module, so that
+// the stages can be initialized in parallel.  Whichever of the worker thread and the thread waiting
+// for the task gets to it first runs it, and the other one returns immediately.
+class ProgramExecutableVk::InitShaderProgramTask final : public vk::ErrorContext,
+                                                         public angle::Closure
+{
+  public:
+    InitShaderProgramTask(vk::Renderer *renderer,
+                          ProgramExecutableVk *executableVk,
+                          gl::ShaderType shaderType,
+                          bool isLastPreFragmentStage,
+                          bool isTransformFeedbackProgram,
+                          ProgramTransformOptions transformOptions)
+        : vk::ErrorContext(renderer),
+          mExecutableVk(executableVk),
+          mShaderType(shaderType),
+          mIsLastPreFragmentStage(isLastPreFragmentStage),
+          mIsTransformFeedbackProgram(isTransformFeedbackProgram),
+          mTransformOptions(transformOptions)
+    {}
+    ~InitShaderProgramTask() override = default;
+
+    void operator()() override
+    {
+        if (mStarted.exchange(true))
+        {
+            return;
+        }
+
+        // Each task only initializes its own stage of the program info.
+        ProgramInfo *programInfo =
+            &mExecutableVk->mGraphicsProgramInfos[mTransformOptions.permutationIndex];
+        mResult = mExecutableVk->initProgram(this, mShaderType, mIsLastPreFragmentStage,
+                                             mIsTransformFeedbackProgram, mTransformOptions,
+                                             programInfo, mExecutableVk->mVariableInfoMap);
+        ASSERT((mResult == angle::Result::Continue) == (mErrorCode == VK_SUCCESS));
+
+        {
+            std::lock_guard<std::mutex> lock(mFinishedMutex);
+            mFinished = true;
+        }
+        mFinishedCondition.notify_all();
+    }
+
+    // Waits until the task has run.  The task must have been started, either by this thread or by
+    // a worker that is running it, so this never waits on a task still queued in the pool.
+    void waitFinished()
+    {
+        ASSERT(mStarted);
+        std::unique_lock<std::mutex> lock(mFinishedMutex);
+        mFinishedCondition.wait(lock, [this] { return mFinished; });
+    }
+
+    void handleError(VkResult result,
+                     const char *file,
+                     const char *function,
+                     unsigned int line) override
+    {
+        mErrorCode     = result;
+        mErrorFile     = file;
+        mErrorFunction = function;
+        mErrorLine     = line;
+    }
+
+    angle::Result getResult(vk::ErrorContext *context)
+    {
+        // Forward any errors
+        if (mErrorCode != VK_SUCCESS)
+        {
+            context->handleError(mErrorCode, mErrorFile, mErrorFunction, mErrorLine);
+        }
+        return mResult;
+    }
+
+  private:
+    ProgramExecutableVk *mExecutableVk;
+    const gl::ShaderType mShaderType;
+    const bool mIsLastPreFragmentStage;
+    const bool mIsTransformFeedbackProgram;
+    const ProgramTransformOptions mTransformOptions;
+
+    std::atomic<bool> mStarted{false};
+    angle::Result mResult = angle::Result::Continue;
+
+    std::mutex mFinishedMutex;
+    std::condition_variable mFinishedCondition;
+    bool mFinished = false;
+
+    // Error handling
+    VkResult mErrorCode        = VK_SUCCESS;
+    const char *mErrorFile     = nullptr;
+    const char *mErrorFunction = nullptr;
+    unsigned int mErrorLine    = 0;
+};
+
 // ShaderInfo implementation.
 ShaderInfo::ShaderInfo() {}
 
@@ -583,6 +681,90 @@ void ShaderInfo::save(gl::BinaryOutputStream *stream)
     }
 }
 
+// SpirvTransformCache implementation.
+SpirvTransformCache::SpirvTransformCache() : SpirvTransformCache(kMaxSpirvTransformCacheSize) {}
+
+SpirvTransformCache::SpirvTransformCache(size_t maxSize) : mCache(maxSize) {}
+
+SpirvTransformCache::~SpirvTransformCache() = default;
+
+// static
+uint32_t SpirvTransformCache::GetKey(const SpvTransformOptions &options)
+{
+    static_assert(static_cast<uint32_t>(gl::ShaderType::EnumCount) <= 0xFF,
+                  "Shader type doesn't fit in the key");
+
+    return static_cast<uint32_t>(options.shaderType) | options.isLastPreFragmentStage << 8 |
+           options.isTransformFeedbackStage << 9 | options.isTransformFeedbackEmulated << 10 |
+           options.isMultisampledFramebufferFetch << 11 | options.enableSampleShading << 12 |
+           options.validate << 13 | options.useSpirvVaryingPrecisionFixer << 14 |
+           options.removeDepthStencilInput << 15;
+}
+
+angle::Result SpirvTransformCache::getOrTransform(
+    const SpvTransformOptions &options,
+    const ShaderInterfaceVariableInfoMap &variableInfoMap,
+    const angle::spirv::Blob &originalSpirvBlob,
+    std::shared_ptr<const angle::spirv::Blob> *transformedSpirvBlobOut)
+{
+    if (get(options, transformedSpirvBlobOut))
+    {
+        return angle::Result::Continue;
+    }
+
+    // The key includes the shader stage, so concurrent transformations never race on the same key.
+    angle::spirv::Blob transformedSpirvBlob;
+    ANGLE_TRY(
+        SpvTransformSpirvCode(options, variableInfoMap, originalSpirvBlob, &transformedSpirvBlob));
+
+    *transformedSpirvBlobOut =
+        std::make_shared<const angle::spirv::Blob>(std::move(transformedSpirvBlob));
+    put(options, *transformedSpirvBlobOut);
+
+    return angle::Result::Continue;
+}
+
+bool SpirvTransformCache::get(const SpvTransformOptions &options,
+                              std::shared_ptr<const angle::spirv::Blob> *transformedSpirvBlobOut)
+{
+    std::lock_guard<angle::SimpleMutex> lock(mMutex);
+    const std::shared_ptr<const angle::spirv::Blob> *cachedSpirvBlob = nullptr;
+    if (mCache.get(GetKey(options), &cachedSpirvBlob))
+    {
+        *transformedSpirvBlobOut = *cachedSpirvBlob;
+        mCacheStats.hit();
+        return true;
+    }
+
+    mCacheStats.miss();
+    return false;
+}
+
+void SpirvTransformCache::put(const SpvTransformOptions &options,
+                              const std::shared_ptr<const angle::spirv::Blob> &transformedSpirvBlob)
+{
+    const size_t blobSize = transformedSpirvBlob->size() * sizeof(uint32_t);
+
+    std::lock_guard<angle::SimpleMutex> lock(mMutex);
+    mCache.eraseByKey(GetKey(options));
+    const size_t entryCount = mCache.entryCount();
+
+    // If the blob doesn't fit in the cache, it is simply not cached.
+    if (mCache.put(GetKey(options), std::shared_ptr<const angle::spirv::Blob>(transformedSpirvBlob),
+                   blobSize) != nullptr)
+    {
+        mCacheStats.addEvictions(static_cast<uint32_t>(entryCount + 1 - mCache.entryCount()));
+    }
+    mCacheStats.setSize(static_cast<uint32_t>(mCache.entryCount()));
+}
+
+void SpirvTransformCache::clear()
+{
+    std::lock_guard<angle::SimpleMutex> lock(mMutex);
+    mCache.clear();
+    mCacheStats.setSize(0);
+}
+
 // ProgramInfo implementation.
 ProgramInfo::ProgramInfo() {}
 
@@ -594,12 +776,12 @@ angle::Result ProgramInfo::initProgram(vk::ErrorContext *context,
                                        bool isTransformFeedbackProgram,
                                        const ShaderInfo &shaderInfo,
                                        ProgramTransformOptions optionBits,
-                                       const ShaderInterfaceVariableInfoMap &variableInfoMap)
+                                       const ShaderInterfaceVariableInfoMap &variableInfoMap,
+                                       SpirvTransformCache *spirvTransformCache)
 {
     const gl::ShaderMap<angle::spirv::Blob> &originalSpirvBlobs = shaderInfo.getSpirvBlobs();
     const angle::spirv::Blob &originalSpirvBlob                 = originalSpirvBlobs[shaderType];
-    gl::ShaderMap<angle::spirv::Blob> transformedSpirvBlobs;
-    angle::spirv::Blob &transformedSpirvBlob = transformedSpirvBlobs[shaderType];
+    std::shared_ptr<const angle::spirv::Blob> transformedSpirvBlob;
 
     SpvTransformOptions options;
     options.shaderType               = shaderType;
@@ -616,10 +798,10 @@ angle::Result ProgramInfo::initProgram(vk::ErrorContext *context,
     options.useSpirvVaryingPrecisionFixer =
         context->getFeatures().varyingsRequireMatchingPrecisionInSpirv.enabled;
 
-    ANGLE_TRY(
-        SpvTransformSpirvCode(options, variableInfoMap, originalSpirvBlob, &transformedSpirvBlob));
-    ANGLE_TRY(vk::InitShaderModule(context, &mShaders[shaderType], transformedSpirvBlob.data(),
-                                   transformedSpirvBlob.size() * sizeof(uint32_t)));
+    ANGLE_TRY(spirvTransformCache->getOrTransform(options, variableInfoMap, originalSpirvBlob,
+                                                  &transformedSpirvBlob));
+    ANGLE_TRY(vk::InitShaderModule(context, &mShaders[shaderType], transformedSpirvBlob->data(),
+                                   transformedSpirvBlob->size() * sizeof(uint32_t)));
 
     mProgramHelper.setShader(shaderType, mShaders[shaderType]);
 
@@ -636,8 +818,19 @@ void ProgramInfo::release(ContextVk *contextVk)
     }
 }
 
+void ProgramInfo::destroy(vk::Renderer *renderer)
+{
+    mProgramHelper.destroy(renderer);
+
+    for (vk::ShaderModulePtr &shader : mShaders)
+    {
+        shader.reset();
+    }
+}
+
 ProgramExecutableVk::ProgramExecutableVk(const gl::ProgramExecutable *executable)
     : ProgramExecutableImpl(executable),
+      mDefaultUniformUploadBufferGeneration(0),
       mImmutableSamplersMaxDescriptorCount(1),
       mUniformBufferDescriptorType(VK_DESCRIPTOR_TYPE_MAX_ENUM),
       mDynamicUniformDescriptorOffsets{},
@@ -690,6 +883,7 @@ void ProgramExecutableVk::resetLayout(ContextVk *contextVk)
 
     // Initialize with an invalid BufferSerial
     mCurrentDefaultUniformBufferSerial = vk::BufferSerial();
+    mDefaultUniformUploadBufferSerial  = vk::BufferSerial();
 
     for (size_t index : mValidGraphicsPermutations)
     {
@@ -706,6 +900,10 @@ void ProgramExecutableVk::resetLayout(ContextVk *contextVk)
     mComputeProgramInfo.release(contextVk);
     mValidComputePermutations.reset();
 
+    // The transformed SPIR-V is specific to the shaders and interface variables being replaced.
+    mSpirvTransformCache.accumulateCacheStats(contextVk->getRenderer());
+    mSpirvTransformCache.clear();
+
     mPipelineLayout.reset();
 
     contextVk->onProgramExecutableReset(this);
@@ -870,6 +1068,7 @@ angle::Result ProgramExecutableVk::getPipelineCacheWarmUpTasks(
     vk::Renderer *renderer,
     vk::PipelineRobustness pipelineRobustness,
     vk::PipelineProtectedAccess pipelineProtectedAccess,
+    angle::WorkerThreadPool *shaderWorkerPool,
     std::vector<std::shared_ptr<LinkSubTask>> *postLinkSubTasksOut)
 {
     ASSERT(!postLinkSubTasksOut || postLinkSubTasksOut->empty());
@@ -882,8 +1081,9 @@ angle::Result ProgramExecutableVk::getPipelineCacheWarmUpTasks(
 
     WarmUpTaskCommon prepForWarmUpContext(renderer);
     ANGLE_TRY(prepareForWarmUpPipelineCache(&prepForWarmUpContext, pipelineRobustness,
-                                            pipelineProtectedAccess, subset, &isCompute,
-                                            &graphicsPipelineDesc, &compatibleRenderPass));
+                                            pipelineProtectedAccess, subset, shaderWorkerPool,
+                                            &isCompute, &graphicsPipelineDesc,
+                                            &compatibleRenderPass));
 
     std::vector<std::shared_ptr<rx::LinkSubTask>> warmUpSubTasks;
     if (isCompute)
@@ -942,6 +1142,7 @@ angle::Result ProgramExecutableVk::prepareForWarmUpPipelineCache(
     vk::PipelineRobustness pipelineRobustness,
     vk::PipelineProtectedAccess pipelineProtectedAccess,
     vk::GraphicsPipelineSubset subset,
+    angle::WorkerThreadPool *shaderWorkerPool,
     bool *isComputeOut,
     vk::GraphicsPipelineDesc **graphicsPipelineDescOut,
     vk::RenderPass *renderPassOut)
@@ -995,6 +1196,10 @@ angle::Result ProgramExecutableVk::prepareForWarmUpPipelineCache(
     // by most applications, but variations can be added here for certain apps that are known to
     // benefit from it.
     ProgramTransformOptions transformOptions = {};
+    if (shaderWorkerPool != nullptr && shaderWorkerPool->isAsync())
+    {
+        return initGraphicsShaderProgramsInParallel(context, shaderWorkerPool, transformOptions);
+    }
     return initGraphicsShaderPrograms(context, transformOptions);
 }
 
@@ -1480,6 +1685,68 @@ angle::Result ProgramExecutableVk::initGraphicsShaderPrograms(
     return angle::Result::Continue;
 }
 
+angle::Result ProgramExecutableVk::initGraphicsShaderProgramsInParallel(
+    vk::ErrorContext *context,
+    angle::WorkerThreadPool *shaderWorkerPool,
+    ProgramTransformOptions transformOptions)
+{
+    ASSERT(mExecutable->hasLinkedShaderStage(gl::ShaderType::Vertex));
+
+    const uint8_t programIndex                = transformOptions.permutationIndex;
+    const gl::ShaderBitSet linkedShaderStages = mExecutable->getLinkedShaderStages();
+    gl::ShaderType lastPreFragmentStage       = gl::GetLastPreFragmentStage(linkedShaderStages);
+
+    const bool isTransformFeedbackProgram =
+        !mExecutable->getLinkedTransformFeedbackVaryings().empty();
+
+    std::vector<std::shared_ptr<InitShaderProgramTask>> tasks;
+    for (gl::ShaderType shaderType : linkedShaderStages)
+    {
+        tasks.push_back(std::make_shared<InitShaderProgramTask>(
+            context->getRenderer(), this, shaderType, shaderType == lastPreFragmentStage,
+            isTransformFeedbackProgram, transformOptions));
+    }
+
+    // The first stage is left to this thread.  The events returned by the pool are not waited on;
+    // they only signal once a worker dequeues the task, which may never happen if all workers are
+    // themselves linking and waiting here.
+    for (size_t taskIndex = 1; taskIndex < tasks.size(); ++taskIndex)
+    {
+        shaderWorkerPool->postWorkerTask(tasks[taskIndex]);
+    }
+
+    // Run the stages that no worker has picked up yet on this thread too, then wait only for the
+    // ones that workers are already running.
+    for (std::shared_ptr<InitShaderProgramTask> &task : tasks)
+    {
+        (*task)();
+    }
+    for (std::shared_ptr<InitShaderProgramTask> &task : tasks)
+    {
+        task->waitFinished();
+    }
+
+    angle::Result result = angle::Result::Continue;
+    for (std::shared_ptr<InitShaderProgramTask> &task : tasks)
+    {
+        if (task->getResult(context) != angle::Result::Continue)
+        {
+            result = angle::Result::Stop;
+        }
+    }
+
+    if (result != angle::Result::Continue)
+    {
+        // Drop the stages that did succeed, so that the permutation is fully initialized again if
+        // it is used later.
+        mGraphicsProgramInfos[programIndex].destroy(context->getRenderer());
+        return result;
+    }
+
+    mValidGraphicsPermutations.set(programIndex);
+    return angle::Result::Continue;
+}
+
 angle::Result ProgramExecutableVk::initProgramThenCreateGraphicsPipeline(
     vk::ErrorContext *context,
     ProgramTransformOptions transformOptions,
@@ -1665,6 +1932,39 @@ angle::Result ProgramExecutableVk::createLinkedGraphicsPipeline(
     return angle::Result::Continue;
 }
 
+void ProgramExecutableVk::evictGraphicsPipelines(
+    ContextVk *contextVk,
+    const std::vector<const vk::PipelineHelper *> &boundPipelines)
+{
+    const size_t maxSize = contextVk->getRenderer()->getGraphicsPipelineCacheMaxSize();
+    ASSERT(maxSize > 0);
+
+    // Warm up tasks may still be filling in their placeholder pipelines.
+    if (!mExecutable->getPostLinkSubTasks().empty())
+    {
+        return;
+    }
+
+    angle::HashSet<vk::PipelineHelper *> evictedPipelines;
+    for (size_t index : mValidGraphicsPermutations)
+    {
+        mCompleteGraphicsPipelines[index].evictLeastRecentlyUsed(contextVk, maxSize, boundPipelines,
+                                                                 &evictedPipelines);
+    }
+
+    if (evictedPipelines.empty())
+    {
+        return;
+    }
+
+    // The evicted pipelines are already freed, and are only compared against the targets of the
+    // transitions.  Transitions may cross permutations, so all caches are cleaned up.
+    for (size_t index : mValidGraphicsPermutations)
+    {
+        mCompleteGraphicsPipelines[index].removeTransitionsTo(evictedPipelines);
+    }
+}
+
 angle::Result ProgramExecutableVk::getOrCreateComputePipeline(
     vk::ErrorContext *context,
     vk::PipelineCacheAccess *pipelineCache,
@@ -2061,6 +2361,7 @@ angle::Result ProgramExecutableVk::bindDescriptorSets(
                 getPipelineLayout(), pipelineBindPoint, descriptorSetIndex, 1, &descSet,
                 static_cast<uint32_t>(mDynamicUniformDescriptorOffsets.size()),
                 mDynamicUniformDescriptorOffsets.data());
+            mDefaultUniformBlocksLastUseSerial = commandBufferHelper->getQueueSerial();
         }
         else if (descriptorSetIndex == DescriptorSetIndex::ShaderResource)
         {
@@ -2117,6 +2418,14 @@ angle::Result ProgramExecutableVk::updateUniforms(vk::Context *context,
 {
     ASSERT(mDefaultUniformBlocksDirty.any());
 
+    // If the GPU is done with the regions the blocks were last uploaded to, write only what changed
+    // since then in place.  The descriptor set and the dynamic offsets stay the same.
+    if (canUpdateDefaultUniformsInPlace(context, *defaultUniformStorage))
+    {
+        updateDefaultUniformsInPlace(defaultUniformStorage->getCurrentBuffer());
+        return angle::Result::Continue;
+    }
+
     vk::BufferHelper *defaultUniformBuffer;
     bool anyNewBufferAllocated          = false;
     gl::ShaderMap<VkDeviceSize> offsets = {};  // offset to the beginning of bufferData
@@ -2149,16 +2458,27 @@ angle::Result ProgramExecutableVk::updateUniforms(vk::Context *context,
     {
         if (mDefaultUniformBlocksDirty[shaderType])
         {
-            const angle::MemoryBuffer &uniformData = mDefaultUniformBlocks[shaderType]->uniformData;
+            BufferAndLayout &uniformBlock          = *mDefaultUniformBlocks[shaderType];
+            const angle::MemoryBuffer &uniformData = uniformBlock.uniformData;
             memcpy(&bufferData[offsets[shaderType]], uniformData.data(), uniformData.size());
             mDynamicUniformDescriptorOffsets[offsetIndex] =
                 static_cast<uint32_t>(bufferOffset + offsets[shaderType]);
             mDefaultUniformBlocksDirty.reset(shaderType);
+
+            // The blocks of a program pipeline are shared with the programs, whose dirty ranges are
+            // relative to their own uploads.
+            if (!mExecutable->IsPPO())
+            {
+                uniformBlock.dirtyRanges.reset();
+            }
         }
         ++offsetIndex;
     }
     ANGLE_TRY(defaultUniformBuffer->flush(context->getRenderer()));
 
+    mDefaultUniformUploadBufferSerial     = defaultUniformBuffer->getBufferSerial();
+    mDefaultUniformUploadBufferGeneration = defaultUniformStorage->getCurrentBufferGeneration();
+
     // Because the uniform buffers are per context, we can't rely on dynamicBuffer's allocate
     // function to tell us if you have got a new buffer or not. Other program's use of the buffer
     // might already pushed dynamicBuffer to a new buffer. We record which buffer (represented by
@@ -2213,6 +2533,61 @@ size_t ProgramExecutableVk::calcUniformUpdateRequiredSpace(
     return requiredSpace;
 }
 
+bool ProgramExecutableVk::canUpdateDefaultUniformsInPlace(
+    vk::ErrorContext *context,
+    const vk::DynamicBuffer &defaultUniformStorage) const
+{
+    // Program pipelines don't own the dirty ranges of their blocks.
+    if (mExecutable->IsPPO())
+    {
+        return false;
+    }
+
+    // The regions must still be allocated to this program, which is not the case if the buffer has
+    // been replaced since, even if it was recycled as the current buffer afterwards.  In-place
+    // writes are not flushed, so the memory must be coherent.
+    const vk::BufferHelper *currentBuffer = defaultUniformStorage.getCurrentBuffer();
+    if (currentBuffer == nullptr ||
+        currentBuffer->getBufferSerial() != mDefaultUniformUploadBufferSerial ||
+        currentBuffer->getBufferSerial() != mCurrentDefaultUniformBufferSerial ||
+        defaultUniformStorage.getCurrentBufferGeneration() !=
+            mDefaultUniformUploadBufferGeneration ||
+        !currentBuffer->isCoherent())
+    {
+        return false;
+    }
+
+    // The GPU must be done with every command that read the regions.  Commands that are recorded
+    // but not yet submitted are not finished either.
+    return mDefaultUniformBlocksLastUseSerial.valid() &&
+           context->getRenderer()->hasQueueSerialFinished(mDefaultUniformBlocksLastUseSerial);
+}
+
+void ProgramExecutableVk::updateDefaultUniformsInPlace(vk::BufferHelper *defaultUniformBuffer)
+{
+    // The dynamic offsets are relative to the start of the buffer block.
+    uint8_t *blockData   = defaultUniformBuffer->getBlockMemory();
+    uint32_t offsetIndex = 0;
+    for (gl::ShaderType shaderType : mExecutable->getLinkedShaderStages())
+    {
+        if (mDefaultUniformBlocksDirty[shaderType])
+        {
+            BufferAndLayout &uniformBlock = *mDefaultUniformBlocks[shaderType];
+            const uint8_t *uniformData    = uniformBlock.uniformData.data();
+            const uint32_t regionOffset   = mDynamicUniformDescriptorOffsets[offsetIndex];
+            uint8_t *regionData           = blockData + regionOffset;
+            for (const gl::Range<size_t> &range : uniformBlock.dirtyRanges.getRanges())
+            {
+                ASSERT(range.high() <= uniformBlock.uniformData.size());
+                memcpy(regionData + range.low(), uniformData + range.low(), range.length());
+            }
+            uniformBlock.dirtyRanges.reset();
+            mDefaultUniformBlocksDirty.reset(shaderType);
+        }
+        ++offsetIndex;
+    }
+}
+
 void ProgramExecutableVk::onProgramBind()
 {
     // Because all programs share default uniform buffers, when we switch programs, we have to
@@ -2241,7 +2616,9 @@ angle::Result ProgramExecutableVk::resizeUniformBlockMemory(
 
             // Initialize uniform buffer memory to zero by default.
             mDefaultUniformBlocks[shaderType]->uniformData.fill(0);
+            mDefaultUniformBlocks[shaderType]->dirtyRanges.reset();
             mDefaultUniformBlocksDirty.set(shaderType);
+            mDefaultUniformUploadBufferSerial = vk::BufferSerial();
         }
     }
 
@@ -10,12 +10,14 @@
 #ifndef LIBANGLE_RENDERER_VULKAN_PROGRAMEXECUTABLEVK_H_
 #define LIBANGLE_RENDERER_VULKAN_PROGRAMEXECUTABLEVK_H_
 
+#include "common/SimpleMutex.h"
 #include "common/bitset_utils.h"
 #include "common/mathutil.h"
 #include "common/utilities.h"
 #include "libANGLE/Context.h"
 #include "libANGLE/InfoLog.h"
 #include "libANGLE/ProgramExecutable.h"
+#include "libANGLE/SizedMRUCache.h"
 #include "libANGLE/renderer/ProgramExecutableImpl.h"
 #include "libANGLE/renderer/vulkan/ContextVk.h"
 #include "libANGLE/renderer/vulkan/ShaderInterfaceVariableInfoMap.h"
@@ -69,6 +71,44 @@ union ProgramTransformOptions final
 static_assert(sizeof(ProgramTransformOptions) == 1, "Size check failed");
 static_assert(static_cast<int>(SurfaceRotation::EnumCount) <= 8, "Size check failed");
 
+// Memoizes the SPIR-V transformations of a program's shaders.  Permutations of the program that
+// differ only in options that don't affect a stage transform that stage's SPIR-V identically, so
+// the result is shared instead of being recomputed.  The stages of a program may be transformed in
+// parallel, so access to the cache is synchronized.
+class SpirvTransformCache final : public HasCacheStats<VulkanCacheType::SpirvTransform>
+{
+  public:
+    SpirvTransformCache();
+    // |maxSize| is the total size in bytes of the transformed SPIR-V kept in the cache.
+    explicit SpirvTransformCache(size_t maxSize);
+    ~SpirvTransformCache() override;
+
+    // The key of the transformations done with |options|.  Options that may transform the SPIR-V
+    // differently have different keys.
+    static uint32_t GetKey(const SpvTransformOptions &options);
+
+    // Transforms |originalSpirvBlob| according to |options|, unless it was already.  The result is
+    // shared with the cache, so it stays valid if another thread evicts it.
+    angle::Result getOrTransform(
+        const SpvTransformOptions &options,
+        const ShaderInterfaceVariableInfoMap &variableInfoMap,
+        const angle::spirv::Blob &originalSpirvBlob,
+        std::shared_ptr<const angle::spirv::Blob> *transformedSpirvBlobOut);
+
+    // The lookup and insertion done by getOrTransform(), which transforms the SPIR-V in between
+    // without holding the lock.  The least recently used blobs are evicted to make room.
+    bool get(const SpvTransformOptions &options,
+             std::shared_ptr<const angle::spirv::Blob> *transformedSpirvBlobOut);
+    void put(const SpvTransformOptions &options,
+             const std::shared_ptr<const angle::spirv::Blob> &transformedSpirvBlob);
+
+    void clear();
+
+  private:
+    angle::SimpleMutex mMutex;
+    angle::SizedMRUCache<uint32_t, std::shared_ptr<const angle::spirv::Blob>> mCache;
+};
+
 class ProgramInfo final : angle::NonCopyable
 {
   public:
@@ -81,8 +121,10 @@ class ProgramInfo final : angle::NonCopyable
                               bool isTransformFeedbackProgram,
                               const ShaderInfo &shaderInfo,
                               ProgramTransformOptions optionBits,
-                              const ShaderInterfaceVariableInfoMap &variableInfoMap);
+                              const ShaderInterfaceVariableInfoMap &variableInfoMap,
+                              SpirvTransformCache *spirvTransformCache);
     void release(ContextVk *contextVk);
+    void destroy(vk::Renderer *renderer);
 
     ANGLE_INLINE bool valid(gl::ShaderType shaderType) const
     {
@@ -194,6 +236,24 @@ class ProgramExecutableVk : public ProgramExecutableImpl
                                                const vk::GraphicsPipelineDesc **descPtrOut,
                                                vk::PipelineHelper **pipelineOut);
 
+    // Evicts the least recently used complete pipelines of each permutation past the renderer's
+    // graphics pipeline cache budget, except for |boundPipelines|.  The pipeline libraries of the
+    // shaders subset are not evicted, as the linked pipelines reference them.
+    void evictGraphicsPipelines(ContextVk *contextVk,
+                                const std::vector<const vk::PipelineHelper *> &boundPipelines);
+
+    // For testing only.
+    angle::BitSet32<ProgramTransformOptions::kPermutationCount>
+    getValidGraphicsPermutationsForTesting() const
+    {
+        return mValidGraphicsPermutations;
+    }
+    const CompleteGraphicsPipelineCache &getCompleteGraphicsPipelineCacheForTesting(
+        size_t permutationIndex) const
+    {
+        return mCompleteGraphicsPipelines[permutationIndex];
+    }
+
     angle::Result getOrCreateComputePipeline(vk::ErrorContext *context,
                                              vk::PipelineCacheAccess *pipelineCache,
                                              PipelineSource source,
@@ -317,12 +377,13 @@ class ProgramExecutableVk : public ProgramExecutableImpl
                                       vk::PipelineProtectedAccess pipelineProtectedAccess)
     {
         return getPipelineCacheWarmUpTasks(renderer, pipelineRobustness, pipelineProtectedAccess,
-                                           nullptr);
+                                           nullptr, nullptr);
     }
     angle::Result getPipelineCacheWarmUpTasks(
         vk::Renderer *renderer,
         vk::PipelineRobustness pipelineRobustness,
         vk::PipelineProtectedAccess pipelineProtectedAccess,
+        angle::WorkerThreadPool *shaderWorkerPool,
         std::vector<std::shared_ptr<LinkSubTask>> *postLinkSubTasksOut);
 
     void waitForPostLinkTasks(const gl::Context *context) override
@@ -380,6 +441,7 @@ class ProgramExecutableVk : public ProgramExecutableImpl
     class WarmUpTaskCommon;
     class WarmUpComputeTask;
     class WarmUpGraphicsTask;
+    class InitShaderProgramTask;
 
     friend class ProgramVk;
     friend class ProgramPipelineVk;
@@ -403,6 +465,9 @@ class ProgramExecutableVk : public ProgramExecutableImpl
 
     size_t calcUniformUpdateRequiredSpace(vk::ErrorContext *context,
                                           gl::ShaderMap<VkDeviceSize> *uniformOffsets) const;
+    bool canUpdateDefaultUniformsInPlace(vk::ErrorContext *context,
+                                         const vk::DynamicBuffer &defaultUniformStorage) const;
+    void updateDefaultUniformsInPlace(vk::BufferHelper *defaultUniformBuffer);
 
     ANGLE_INLINE angle::Result initProgram(vk::ErrorContext *context,
                                            gl::ShaderType shaderType,
@@ -420,7 +485,7 @@ class ProgramExecutableVk : public ProgramExecutableImpl
         {
             ANGLE_TRY(programInfo->initProgram(context, shaderType, isLastPreFragmentStage,
                                                isTransformFeedbackProgram, mOriginalShaderInfo,
-                                               optionBits, variableInfoMap));
+                                               optionBits, variableInfoMap, &mSpirvTransformCache));
         }
         ASSERT(programInfo->valid(shaderType));
 
@@ -457,6 +522,9 @@ class ProgramExecutableVk : public ProgramExecutableImpl
                                                 const vk::GraphicsPipelineDesc &desc);
     angle::Result initGraphicsShaderPrograms(vk::ErrorContext *context,
                                              ProgramTransformOptions transformOptions);
+    angle::Result initGraphicsShaderProgramsInParallel(vk::ErrorContext *context,
+                                                       angle::WorkerThreadPool *shaderWorkerPool,
+                                                       ProgramTransformOptions transformOptions);
     angle::Result initProgramThenCreateGraphicsPipeline(vk::ErrorContext *context,
                                                         ProgramTransformOptions transformOptions,
                                                         vk::GraphicsPipelineSubset pipelineSubset,
@@ -480,6 +548,7 @@ class ProgramExecutableVk : public ProgramExecutableImpl
         vk::PipelineRobustness pipelineRobustness,
         vk::PipelineProtectedAccess pipelineProtectedAccess,
         vk::GraphicsPipelineSubset subset,
+        angle::WorkerThreadPool *shaderWorkerPool,
         bool *isComputeOut,
         vk::GraphicsPipelineDesc **graphicsPipelineDescOut,
         vk::RenderPass *renderPassOut);
@@ -517,6 +586,15 @@ class ProgramExecutableVk : public ProgramExecutableImpl
     vk::DescriptorSetArray<vk::DynamicDescriptorPoolPointer> mDynamicDescriptorPools;
     vk::BufferSerial mCurrentDefaultUniformBufferSerial;
 
+    // The default uniform blocks are streamed to new regions of the context's uniform buffer when
+    // they change.  Once the GPU is done with the regions they were last uploaded to, only their
+    // dirty ranges are written in place instead.  The buffer and its generation tell whether the
+    // regions are still allocated, and the queue serial of the last command buffer that bound them
+    // tells when the GPU is done with them.
+    vk::BufferSerial mDefaultUniformUploadBufferSerial;
+    uint64_t mDefaultUniformUploadBufferGeneration;
+    QueueSerial mDefaultUniformBlocksLastUseSerial;
+
     // We keep a reference to the pipeline and descriptor set layouts. This ensures they don't get
     // deleted while this program is in use.
     uint32_t mImmutableSamplersMaxDescriptorCount;
@@ -559,6 +637,7 @@ class ProgramExecutableVk : public ProgramExecutableImpl
     gl::ShaderBitSet mDefaultUniformBlocksDirty;
 
     ShaderInfo mOriginalShaderInfo;
+    SpirvTransformCache mSpirvTransformCache;
 
     // The pipeline cache specific to this program executable.  Currently:
     //
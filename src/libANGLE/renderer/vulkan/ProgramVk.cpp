@@ -57,13 +57,15 @@ class LinkTaskVk final : public vk::ErrorContext, public LinkTask
                const gl::ProgramState &state,
                bool isGLES1,
                vk::PipelineRobustness pipelineRobustness,
-               vk::PipelineProtectedAccess pipelineProtectedAccess)
+               vk::PipelineProtectedAccess pipelineProtectedAccess,
+               const std::shared_ptr<angle::WorkerThreadPool> &shaderWorkerPool)
         : vk::ErrorContext(renderer),
           mState(state),
           mExecutable(&mState.getExecutable()),
           mIsGLES1(isGLES1),
           mPipelineRobustness(pipelineRobustness),
           mPipelineProtectedAccess(pipelineProtectedAccess),
+          mShaderWorkerPool(shaderWorkerPool),
           mPipelineLayoutCache(pipelineLayoutCache),
           mDescriptorSetLayoutCache(descriptorSetLayoutCache)
     {}
@@ -150,6 +152,9 @@ class LinkTaskVk final : public vk::ErrorContext, public LinkTask
     const vk::PipelineRobustness mPipelineRobustness;
     const vk::PipelineProtectedAccess mPipelineProtectedAccess;
 
+    // Used to transform the SPIR-V of the shader stages in parallel when parallel link is enabled.
+    std::shared_ptr<angle::WorkerThreadPool> mShaderWorkerPool;
+
     // Helpers that are interally thread-safe
     PipelineLayoutCache &mPipelineLayoutCache;
     DescriptorSetLayoutCache &mDescriptorSetLayoutCache;
@@ -208,7 +213,8 @@ angle::Result LinkTaskVk::linkImpl(const gl::ProgramLinkedResources &resources,
     if (!mState.isSeparable() && !mIsGLES1 && getFeatures().warmUpPipelineCacheAtLink.enabled)
     {
         ANGLE_TRY(executableVk->getPipelineCacheWarmUpTasks(
-            mRenderer, mPipelineRobustness, mPipelineProtectedAccess, postLinkSubTasksOut));
+            mRenderer, mPipelineRobustness, mPipelineProtectedAccess, mShaderWorkerPool.get(),
+            postLinkSubTasksOut));
     }
 
     return angle::Result::Continue;
@@ -374,7 +380,8 @@ angle::Result ProgramVk::link(const gl::Context *context, std::shared_ptr<LinkTa
     *linkTaskOut = std::shared_ptr<LinkTask>(new LinkTaskVk(
         contextVk->getRenderer(), contextVk->getPipelineLayoutCache(),
         contextVk->getDescriptorSetLayoutCache(), mState, context->getState().isGLES1(),
-        contextVk->pipelineRobustness(), contextVk->pipelineProtectedAccess()));
+        contextVk->pipelineRobustness(), contextVk->pipelineProtectedAccess(),
+        context->getLinkSubTaskThreadPool()));
 
     return angle::Result::Continue;
 }
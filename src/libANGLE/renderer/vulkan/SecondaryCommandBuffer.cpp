@@ -12,6 +12,8 @@
 #include "libANGLE/renderer/vulkan/vk_utils.h"
 #include "libANGLE/trace.h"
 
+#include <array>
+
 namespace rx
 {
 namespace vk
@@ -74,6 +76,8 @@ const char *GetCommandString(CommandID id)
             return "DrawIndexed";
         case CommandID::DrawIndexedBaseVertex:
             return "DrawIndexedBaseVertex";
+        case CommandID::DrawIndexedBaseVertexPacked:
+            return "DrawIndexedBaseVertexPacked";
         case CommandID::DrawIndexedIndirect:
             return "DrawIndexedIndirect";
         case CommandID::DrawIndexedInstanced:
@@ -82,12 +86,18 @@ const char *GetCommandString(CommandID id)
             return "DrawIndexedInstancedBaseVertex";
         case CommandID::DrawIndexedInstancedBaseVertexBaseInstance:
             return "DrawIndexedInstancedBaseVertexBaseInstance";
+        case CommandID::DrawIndexedInstancedPacked:
+            return "DrawIndexedInstancedPacked";
         case CommandID::DrawIndirect:
             return "DrawIndirect";
         case CommandID::DrawInstanced:
             return "DrawInstanced";
         case CommandID::DrawInstancedBaseInstance:
             return "DrawInstancedBaseInstance";
+        case CommandID::DrawPacked:
+            return "DrawPacked";
+        case CommandID::Elided:
+            return "Elided";
         case CommandID::EndDebugUtilsLabel:
             return "EndDebugUtilsLabel";
         case CommandID::EndQuery:
@@ -146,6 +156,8 @@ const char *GetCommandString(CommandID id)
             return "SetRasterizerDiscardEnable";
         case CommandID::SetScissor:
             return "SetScissor";
+        case CommandID::SetScissorPacked:
+            return "SetScissorPacked";
         case CommandID::SetStencilCompareMask:
             return "SetStencilCompareMask";
         case CommandID::SetStencilOp:
@@ -160,6 +172,8 @@ const char *GetCommandString(CommandID id)
             return "SetVertexInput";
         case CommandID::SetViewport:
             return "SetViewport";
+        case CommandID::SetViewportPacked:
+            return "SetViewportPacked";
         case CommandID::WaitEvents:
             return "WaitEvents";
         case CommandID::WriteTimestamp:
@@ -187,6 +201,203 @@ ANGLE_INLINE const NextT *GetNextArrayParameter(const PrevT *array, size_t array
     const size_t arrayAllocateBytes = roundUpPow2<size_t>(sizeof(*array) * arrayLen, 8u);
     return Offset<NextT>(array, arrayAllocateBytes);
 }
+
+template <typename StructType>
+ANGLE_INLINE const StructType *GetParams(const CommandHeader *header)
+{
+    return reinterpret_cast<const StructType *>(header);
+}
+
+template <typename T>
+bool AreArraysEqual(const T *array, const T *otherArray, size_t arrayLen)
+{
+    return memcmp(array, otherArray, sizeof(*array) * arrayLen) == 0;
+}
+
+// Whether |command| sets the same state as |previous|, the previous command with the same ID.
+// Only commands that fully replace the state they set are considered; the ones that set part of
+// the state (like push constants), or state that other commands also set (like vertex buffers),
+// are never redundant.  Floats are compared bitwise.
+bool IsRedundantStateCommand(const CommandHeader *previous, const CommandHeader *command)
+{
+    ASSERT(previous->id == command->id);
+
+    switch (command->id)
+    {
+        case CommandID::BindComputePipeline:
+        case CommandID::BindGraphicsPipeline:
+            return GetParams<BindPipelineParams>(previous)->pipeline ==
+                   GetParams<BindPipelineParams>(command)->pipeline;
+        case CommandID::BindDescriptorSets:
+        {
+            const BindDescriptorSetParams *a = GetParams<BindDescriptorSetParams>(previous);
+            const BindDescriptorSetParams *b = GetParams<BindDescriptorSetParams>(command);
+            if (a->pipelineBindPoint != b->pipelineBindPoint || a->firstSet != b->firstSet ||
+                a->descriptorSetCount != b->descriptorSetCount ||
+                a->dynamicOffsetCount != b->dynamicOffsetCount || a->layout != b->layout)
+            {
+                return false;
+            }
+            const VkDescriptorSet *setsA = GetFirstArrayParameter<VkDescriptorSet>(a);
+            const VkDescriptorSet *setsB = GetFirstArrayParameter<VkDescriptorSet>(b);
+            return AreArraysEqual(setsA, setsB, a->descriptorSetCount) &&
+                   AreArraysEqual(GetNextArrayParameter<uint32_t>(setsA, a->descriptorSetCount),
+                                  GetNextArrayParameter<uint32_t>(setsB, b->descriptorSetCount),
+                                  a->dynamicOffsetCount);
+        }
+        case CommandID::BindIndexBuffer:
+        {
+            const BindIndexBufferParams *a = GetParams<BindIndexBufferParams>(previous);
+            const BindIndexBufferParams *b = GetParams<BindIndexBufferParams>(command);
+            return a->buffer == b->buffer && a->offset == b->offset &&
+                   a->indexType == b->indexType;
+        }
+        case CommandID::SetBlendConstants:
+            return AreArraysEqual(GetParams<SetBlendConstantsParams>(previous)->blendConstants,
+                                  GetParams<SetBlendConstantsParams>(command)->blendConstants, 4);
+        case CommandID::SetCullMode:
+            return GetParams<SetCullModeParams>(previous)->cullMode ==
+                   GetParams<SetCullModeParams>(command)->cullMode;
+        case CommandID::SetDepthBias:
+        {
+            const SetDepthBiasParams *a = GetParams<SetDepthBiasParams>(previous);
+            const SetDepthBiasParams *b = GetParams<SetDepthBiasParams>(command);
+            return AreArraysEqual(&a->depthBiasConstantFactor, &b->depthBiasConstantFactor, 1) &&
+                   AreArraysEqual(&a->depthBiasClamp, &b->depthBiasClamp, 1) &&
+                   AreArraysEqual(&a->depthBiasSlopeFactor, &b->depthBiasSlopeFactor, 1);
+        }
+        case CommandID::SetDepthBiasEnable:
+            return GetParams<SetDepthBiasEnableParams>(previous)->depthBiasEnable ==
+                   GetParams<SetDepthBiasEnableParams>(command)->depthBiasEnable;
+        case CommandID::SetDepthCompareOp:
+            return GetParams<SetDepthCompareOpParams>(previous)->depthCompareOp ==
+                   GetParams<SetDepthCompareOpParams>(command)->depthCompareOp;
+        case CommandID::SetDepthTestEnable:
+            return GetParams<SetDepthTestEnableParams>(previous)->depthTestEnable ==
+                   GetParams<SetDepthTestEnableParams>(command)->depthTestEnable;
+        case CommandID::SetDepthWriteEnable:
+            return GetParams<SetDepthWriteEnableParams>(previous)->depthWriteEnable ==
+                   GetParams<SetDepthWriteEnableParams>(command)->depthWriteEnable;
+        case CommandID::SetFrontFace:
+            return GetParams<SetFrontFaceParams>(previous)->frontFace ==
+                   GetParams<SetFrontFaceParams>(command)->frontFace;
+        case CommandID::SetLineWidth:
+            return AreArraysEqual(&GetParams<SetLineWidthParams>(previous)->lineWidth,
+                                  &GetParams<SetLineWidthParams>(command)->lineWidth, 1);
+        case CommandID::SetLogicOp:
+            return GetParams<SetLogicOpParams>(previous)->logicOp ==
+                   GetParams<SetLogicOpParams>(command)->logicOp;
+        case CommandID::SetPrimitiveRestartEnable:
+            return GetParams<SetPrimitiveRestartEnableParams>(previous)->primitiveRestartEnable ==
+                   GetParams<SetPrimitiveRestartEnableParams>(command)->primitiveRestartEnable;
+        case CommandID::SetRasterizerDiscardEnable:
+            return GetParams<SetRasterizerDiscardEnableParams>(previous)
+                       ->rasterizerDiscardEnable ==
+                   GetParams<SetRasterizerDiscardEnableParams>(command)->rasterizerDiscardEnable;
+        case CommandID::SetScissor:
+            return AreArraysEqual(&GetParams<SetScissorParams>(previous)->scissor,
+                                  &GetParams<SetScissorParams>(command)->scissor, 1);
+        case CommandID::SetScissorPacked:
+        {
+            const SetScissorPackedParams *a = GetParams<SetScissorPackedParams>(previous);
+            const SetScissorPackedParams *b = GetParams<SetScissorPackedParams>(command);
+            return a->x == b->x && a->y == b->y && a->width == b->width && a->height == b->height;
+        }
+        case CommandID::SetStencilCompareMask:
+        {
+            const SetStencilCompareMaskParams *a = GetParams<SetStencilCompareMaskParams>(previous);
+            const SetStencilCompareMaskParams *b = GetParams<SetStencilCompareMaskParams>(command);
+            return a->compareFrontMask == b->compareFrontMask &&
+                   a->compareBackMask == b->compareBackMask;
+        }
+        case CommandID::SetStencilOp:
+        {
+            const SetStencilOpParams *a = GetParams<SetStencilOpParams>(previous);
+            const SetStencilOpParams *b = GetParams<SetStencilOpParams>(command);
+            return a->faceMask == b->faceMask && a->failOp == b->failOp &&
+                   a->passOp == b->passOp && a->depthFailOp == b->depthFailOp &&
+                   a->compareOp == b->compareOp;
+        }
+        case CommandID::SetStencilReference:
+        {
+            const SetStencilReferenceParams *a = GetParams<SetStencilReferenceParams>(previous);
+            const SetStencilReferenceParams *b = GetParams<SetStencilReferenceParams>(command);
+            return a->frontReference == b->frontReference && a->backReference == b->backReference;
+        }
+        case CommandID::SetStencilTestEnable:
+            return GetParams<SetStencilTestEnableParams>(previous)->stencilTestEnable ==
+                   GetParams<SetStencilTestEnableParams>(command)->stencilTestEnable;
+        case CommandID::SetStencilWriteMask:
+        {
+            const SetStencilWriteMaskParams *a = GetParams<SetStencilWriteMaskParams>(previous);
+            const SetStencilWriteMaskParams *b = GetParams<SetStencilWriteMaskParams>(command);
+            return a->writeFrontMask == b->writeFrontMask && a->writeBackMask == b->writeBackMask;
+        }
+        case CommandID::SetViewport:
+            return AreArraysEqual(&GetParams<SetViewportParams>(previous)->viewport,
+                                  &GetParams<SetViewportParams>(command)->viewport, 1);
+        case CommandID::SetViewportPacked:
+        {
+            const SetViewportPackedParams *a = GetParams<SetViewportPackedParams>(previous);
+            const SetViewportPackedParams *b = GetParams<SetViewportPackedParams>(command);
+            return a->x == b->x && a->y == b->y && a->width == b->width && a->height == b->height;
+        }
+        default:
+            return false;
+    }
+}
+
+// Returns the ID of the other encoding of the state command |id|, or Invalid if it has none.
+CommandID GetOtherStateCommandEncoding(CommandID id)
+{
+    switch (id)
+    {
+        case CommandID::SetScissor:
+            return CommandID::SetScissorPacked;
+        case CommandID::SetScissorPacked:
+            return CommandID::SetScissor;
+        case CommandID::SetViewport:
+            return CommandID::SetViewportPacked;
+        case CommandID::SetViewportPacked:
+            return CommandID::SetViewport;
+        default:
+            return CommandID::Invalid;
+    }
+}
+
+// Merges the memory barrier of |command| into the one of |previous|, which is recorded right
+// before it.  The merged barrier waits for everything either barrier waits for, and blocks
+// everything either barrier blocks, so it is at least as strong as the two barriers in sequence.
+void MergeMemoryBarrier(CommandHeader *previous, const CommandHeader *command)
+{
+    ASSERT(previous->id == command->id);
+
+    if (command->id == CommandID::MemoryBarrier)
+    {
+        MemoryBarrierParams *a          = reinterpret_cast<MemoryBarrierParams *>(previous);
+        const MemoryBarrierParams *b    = GetParams<MemoryBarrierParams>(command);
+        VkMemoryBarrier *barrierA       = Offset<VkMemoryBarrier>(a, sizeof(*a));
+        const VkMemoryBarrier *barrierB = GetFirstArrayParameter<VkMemoryBarrier>(b);
+
+        a->srcStageMask |= b->srcStageMask;
+        a->dstStageMask |= b->dstStageMask;
+        barrierA->srcAccessMask |= barrierB->srcAccessMask;
+        barrierA->dstAccessMask |= barrierB->dstAccessMask;
+    }
+    else
+    {
+        ASSERT(command->id == CommandID::MemoryBarrier2);
+        MemoryBarrier2Params *a          = reinterpret_cast<MemoryBarrier2Params *>(previous);
+        VkMemoryBarrier2 *barrierA       = Offset<VkMemoryBarrier2>(a, sizeof(*a));
+        const VkMemoryBarrier2 *barrierB = GetFirstArrayParameter<VkMemoryBarrier2>(
+            GetParams<MemoryBarrier2Params>(command));
+
+        barrierA->srcStageMask |= barrierB->srcStageMask;
+        barrierA->srcAccessMask |= barrierB->srcAccessMask;
+        barrierA->dstStageMask |= barrierB->dstStageMask;
+        barrierA->dstAccessMask |= barrierB->dstAccessMask;
+    }
+}
 }  // namespace
 
 ANGLE_INLINE const CommandHeader *NextCommand(const CommandHeader *command)
@@ -195,6 +406,79 @@ ANGLE_INLINE const CommandHeader *NextCommand(const CommandHeader *command)
                                                    command->size);
 }
 
+ANGLE_INLINE CommandHeader *NextCommand(CommandHeader *command)
+{
+    return reinterpret_cast<CommandHeader *>(reinterpret_cast<uint8_t *>(command) +
+                                             command->size);
+}
+
+uint32_t SecondaryCommandBuffer::elideRedundantCommands()
+{
+    ANGLE_TRACE_EVENT0("gpu.angle", "SecondaryCommandBuffer::elideRedundantCommands");
+
+    // The last command of each ID that is not elided.
+    constexpr size_t kCommandIDCount = ToUnderlying(CommandID::EnumCount);
+    std::array<const CommandHeader *, kCommandIDCount> lastCommands = {};
+    // The last command that is not elided, to find adjacent barriers.
+    CommandHeader *previousCommand = nullptr;
+    uint32_t elidedCount           = 0;
+
+    for (CommandHeader *command : mCommands)
+    {
+        for (CommandHeader *currentCommand                            = command;
+             currentCommand->id != CommandID::Invalid; currentCommand = NextCommand(currentCommand))
+        {
+            const CommandID id = currentCommand->id;
+            if (id == CommandID::Elided)
+            {
+                continue;
+            }
+
+            bool elide = false;
+            if (id == CommandID::MemoryBarrier || id == CommandID::MemoryBarrier2)
+            {
+                if (previousCommand != nullptr && previousCommand->id == id)
+                {
+                    MergeMemoryBarrier(previousCommand, currentCommand);
+                    elide = true;
+                }
+            }
+            else if (id == CommandID::NextSubpass)
+            {
+                // Be conservative and don't carry the state over to the next subpass.
+                lastCommands.fill(nullptr);
+            }
+            else
+            {
+                const CommandHeader *&lastCommand = lastCommands[ToUnderlying(id)];
+                if (lastCommand != nullptr && IsRedundantStateCommand(lastCommand, currentCommand))
+                {
+                    elide = true;
+                }
+                else
+                {
+                    lastCommand = currentCommand;
+                    // The state is no longer the one set by the last command of the other
+                    // encoding.
+                    lastCommands[ToUnderlying(GetOtherStateCommandEncoding(id))] = nullptr;
+                }
+            }
+
+            if (elide)
+            {
+                currentCommand->id = CommandID::Elided;
+                ++elidedCount;
+            }
+            else
+            {
+                previousCommand = currentCommand;
+            }
+        }
+    }
+
+    return elidedCount;
+}
+
 // Parse the cmds in this cmd buffer into given primary cmd buffer
 void SecondaryCommandBuffer::executeCommands(PrimaryCommandBuffer *primary)
 {
@@ -381,8 +665,10 @@ void SecondaryCommandBuffer::executeCommands(PrimaryCommandBuffer *primary)
                 {
                     const CopyBufferToImageParams *params =
                         getParamPtr<CopyBufferToImageParams>(currentCommand);
+                    const VkBufferImageCopy *regions =
+                        GetFirstArrayParameter<VkBufferImageCopy>(params);
                     vkCmdCopyBufferToImage(cmdBuffer, params->srcBuffer, params->dstImage,
-                                           params->dstImageLayout, 1, &params->region);
+                                           params->dstImageLayout, params->regionCount, regions);
                     break;
                 }
                 case CommandID::CopyImage:
@@ -434,6 +720,13 @@ void SecondaryCommandBuffer::executeCommands(PrimaryCommandBuffer *primary)
                     vkCmdDrawIndexed(cmdBuffer, params->indexCount, 1, 0, params->vertexOffset, 0);
                     break;
                 }
+                case CommandID::DrawIndexedBaseVertexPacked:
+                {
+                    const DrawIndexedBaseVertexPackedParams *params =
+                        getParamPtr<DrawIndexedBaseVertexPackedParams>(currentCommand);
+                    vkCmdDrawIndexed(cmdBuffer, params->indexCount, 1, 0, params->vertexOffset, 0);
+                    break;
+                }
                 case CommandID::DrawIndexedIndirect:
                 {
                     const DrawIndexedIndirectParams *params =
@@ -467,6 +760,13 @@ void SecondaryCommandBuffer::executeCommands(PrimaryCommandBuffer *primary)
                                      params->firstInstance);
                     break;
                 }
+                case CommandID::DrawIndexedInstancedPacked:
+                {
+                    const DrawIndexedInstancedPackedParams *params =
+                        getParamPtr<DrawIndexedInstancedPackedParams>(currentCommand);
+                    vkCmdDrawIndexed(cmdBuffer, params->indexCount, params->instanceCount, 0, 0, 0);
+                    break;
+                }
                 case CommandID::DrawIndirect:
                 {
                     const DrawIndirectParams *params =
@@ -491,6 +791,16 @@ void SecondaryCommandBuffer::executeCommands(PrimaryCommandBuffer *primary)
                               params->firstVertex, params->firstInstance);
                     break;
                 }
+                case CommandID::DrawPacked:
+                {
+                    const DrawPackedParams *params = getParamPtr<DrawPackedParams>(currentCommand);
+                    vkCmdDraw(cmdBuffer, params->vertexCount, 1, params->firstVertex, 0);
+                    break;
+                }
+                case CommandID::Elided:
+                {
+                    break;
+                }
                 case CommandID::EndDebugUtilsLabel:
                 {
                     ASSERT(vkCmdEndDebugUtilsLabelEXT);
@@ -785,6 +1095,15 @@ void SecondaryCommandBuffer::executeCommands(PrimaryCommandBuffer *primary)
                     vkCmdSetScissor(cmdBuffer, 0, 1, &params->scissor);
                     break;
                 }
+                case CommandID::SetScissorPacked:
+                {
+                    const SetScissorPackedParams *params =
+                        getParamPtr<SetScissorPackedParams>(currentCommand);
+                    const VkRect2D scissor = {{params->x, params->y},
+                                              {params->width, params->height}};
+                    vkCmdSetScissor(cmdBuffer, 0, 1, &scissor);
+                    break;
+                }
                 case CommandID::SetStencilCompareMask:
                 {
                     const SetStencilCompareMaskParams *params =
@@ -857,6 +1176,20 @@ void SecondaryCommandBuffer::executeCommands(PrimaryCommandBuffer *primary)
                     vkCmdSetViewport(cmdBuffer, 0, 1, &params->viewport);
                     break;
                 }
+                case CommandID::SetViewportPacked:
+                {
+                    const SetViewportPackedParams *params =
+                        getParamPtr<SetViewportPackedParams>(currentCommand);
+                    VkViewport viewport;
+                    viewport.x        = params->x;
+                    viewport.y        = params->y;
+                    viewport.width    = params->width;
+                    viewport.height   = params->height;
+                    viewport.minDepth = 0.0f;
+                    viewport.maxDepth = 1.0f;
+                    vkCmdSetViewport(cmdBuffer, 0, 1, &viewport);
+                    break;
+                }
                 case CommandID::WaitEvents:
                 {
                     const WaitEventsParams *params = getParamPtr<WaitEventsParams>(currentCommand);
@@ -65,13 +65,18 @@ enum class CommandID : uint16_t
     Draw,
     DrawIndexed,
     DrawIndexedBaseVertex,
+    DrawIndexedBaseVertexPacked,
     DrawIndexedIndirect,
     DrawIndexedInstanced,
     DrawIndexedInstancedBaseVertex,
     DrawIndexedInstancedBaseVertexBaseInstance,
+    DrawIndexedInstancedPacked,
     DrawIndirect,
     DrawInstanced,
     DrawInstancedBaseInstance,
+    DrawPacked,
+    // A command dropped by elideRedundantCommands(), skipped when replaying
+    Elided,
     EndDebugUtilsLabel,
     EndQuery,
     EndTransformFeedback,
@@ -104,6 +109,7 @@ enum class CommandID : uint16_t
     SetPrimitiveRestartEnable,
     SetRasterizerDiscardEnable,
     SetScissor,
+    SetScissorPacked,
     SetStencilCompareMask,
     SetStencilOp,
     SetStencilReference,
@@ -111,9 +117,13 @@ enum class CommandID : uint16_t
     SetStencilWriteMask,
     SetVertexInput,
     SetViewport,
+    SetViewportPacked,
     WaitEvents,
     WriteTimestamp,
     WriteTimestamp2,
+
+    // Not a command; the number of command IDs.
+    EnumCount,
 };
 
 // Header for every cmd in custom cmd buffer
@@ -271,7 +281,8 @@ struct CopyBufferToImageParams
     VkImageLayout dstImageLayout;
     VkBuffer srcBuffer;
     VkImage dstImage;
-    VkBufferImageCopy region;
+    uint32_t regionCount;
+    uint32_t padding;
 };
 VERIFY_8_BYTE_ALIGNMENT(CopyBufferToImageParams)
 
@@ -356,6 +367,23 @@ struct DrawIndexedBaseVertexParams
 };
 VERIFY_8_BYTE_ALIGNMENT(DrawIndexedBaseVertexParams)
 
+// The *PackedParams structs are used instead of their full-sized counterparts when the parameters
+// fit in 16 bits, which is the common case.  They halve the size of the most frequent commands of
+// draw-heavy render passes.
+//
+// Dynamic state is not delta-encoded against the previous command.  With the 4-byte header and
+// 8-byte alignment of every command, a delta could only shrink the packed viewport and scissor from
+// 16 to 8 bytes, while replay would have to carry the previous state from command to command.
+// Repeated state is already elided, so these commands are much rarer than draws.
+struct DrawIndexedBaseVertexPackedParams
+{
+    CommandHeader header;
+
+    uint16_t indexCount;
+    uint16_t vertexOffset;
+};
+VERIFY_8_BYTE_ALIGNMENT(DrawIndexedBaseVertexPackedParams)
+
 struct DrawIndexedIndirectParams
 {
     CommandHeader header;
@@ -400,6 +428,15 @@ struct DrawIndexedInstancedBaseVertexBaseInstanceParams
 };
 VERIFY_8_BYTE_ALIGNMENT(DrawIndexedInstancedBaseVertexBaseInstanceParams)
 
+struct DrawIndexedInstancedPackedParams
+{
+    CommandHeader header;
+
+    uint16_t indexCount;
+    uint16_t instanceCount;
+};
+VERIFY_8_BYTE_ALIGNMENT(DrawIndexedInstancedPackedParams)
+
 struct DrawIndirectParams
 {
     CommandHeader header;
@@ -434,6 +471,15 @@ struct DrawInstancedBaseInstanceParams
 };
 VERIFY_8_BYTE_ALIGNMENT(DrawInstancedBaseInstanceParams)
 
+struct DrawPackedParams
+{
+    CommandHeader header;
+
+    uint16_t vertexCount;
+    uint16_t firstVertex;
+};
+VERIFY_8_BYTE_ALIGNMENT(DrawPackedParams)
+
 // A special struct used with commands that don't have params
 struct EmptyParams
 {
@@ -705,6 +751,18 @@ struct SetScissorParams
 };
 VERIFY_8_BYTE_ALIGNMENT(SetScissorParams)
 
+struct SetScissorPackedParams
+{
+    CommandHeader header;
+
+    uint16_t x;
+    uint16_t y;
+    uint16_t width;
+    uint16_t height;
+    uint32_t padding;
+};
+VERIFY_8_BYTE_ALIGNMENT(SetScissorPackedParams)
+
 struct SetStencilCompareMaskParams
 {
     CommandHeader header;
@@ -771,6 +829,20 @@ struct SetViewportParams
 };
 VERIFY_8_BYTE_ALIGNMENT(SetViewportParams)
 
+// Only used for viewports with integer coordinates and the default [0, 1] depth range.  The height
+// may be negative when the viewport is flipped.
+struct SetViewportPackedParams
+{
+    CommandHeader header;
+
+    int16_t x;
+    int16_t y;
+    int16_t width;
+    int16_t height;
+    uint32_t padding;
+};
+VERIFY_8_BYTE_ALIGNMENT(SetViewportPackedParams)
+
 struct WaitEventsParams
 {
     CommandHeader header;
@@ -1098,6 +1170,11 @@ class SecondaryCommandBuffer final : angle::NonCopyable
     // Parse the cmds in this cmd buffer into given primary cmd buffer for execution
     void executeCommands(PrimaryCommandBuffer *primary);
 
+    // Before executeCommands(), drops the state commands that set what the previous command of the
+    // same kind already set, and merges adjacent memory barriers into the first one.  Dropped
+    // commands are marked Elided in place.  Returns the number of dropped commands.
+    uint32_t elideRedundantCommands();
+
     // Calculate memory usage of this command buffer for diagnostics.
     void getMemoryUsageStats(size_t *usedMemoryOut, size_t *allocatedMemoryOut) const;
     void getMemoryUsageStatsForPoolAlloc(size_t blockSize,
@@ -1546,13 +1623,17 @@ ANGLE_INLINE void SecondaryCommandBuffer::copyBufferToImage(VkBuffer srcBuffer,
                                                             uint32_t regionCount,
                                                             const VkBufferImageCopy *regions)
 {
-    ASSERT(regionCount == 1);
-    CopyBufferToImageParams *paramStruct =
-        initCommand<CopyBufferToImageParams>(CommandID::CopyBufferToImage);
+    uint8_t *writePtr;
+    const ArrayParamSize regionSize = calculateArrayParameterSize<VkBufferImageCopy>(regionCount);
+    CopyBufferToImageParams *paramStruct = initCommand<CopyBufferToImageParams>(
+        CommandID::CopyBufferToImage, regionSize.allocateBytes, &writePtr);
     paramStruct->srcBuffer      = srcBuffer;
     paramStruct->dstImage       = dstImage.getHandle();
     paramStruct->dstImageLayout = dstImageLayout;
-    paramStruct->region         = regions[0];
+    paramStruct->regionCount    = regionCount;
+    paramStruct->padding        = 0;
+    // Copy variable sized data
+    storeArrayParameter(writePtr, regions, regionSize);
 }
 
 ANGLE_INLINE void SecondaryCommandBuffer::copyImage(const Image &srcImage,
@@ -1607,9 +1688,18 @@ ANGLE_INLINE void SecondaryCommandBuffer::dispatchIndirect(const Buffer &buffer,
 
 ANGLE_INLINE void SecondaryCommandBuffer::draw(uint32_t vertexCount, uint32_t firstVertex)
 {
-    DrawParams *paramStruct  = initCommand<DrawParams>(CommandID::Draw);
-    paramStruct->vertexCount = vertexCount;
-    paramStruct->firstVertex = firstVertex;
+    if ((vertexCount | firstVertex) <= std::numeric_limits<uint16_t>::max())
+    {
+        DrawPackedParams *paramStruct = initCommand<DrawPackedParams>(CommandID::DrawPacked);
+        paramStruct->vertexCount      = static_cast<uint16_t>(vertexCount);
+        paramStruct->firstVertex      = static_cast<uint16_t>(firstVertex);
+    }
+    else
+    {
+        DrawParams *paramStruct  = initCommand<DrawParams>(CommandID::Draw);
+        paramStruct->vertexCount = vertexCount;
+        paramStruct->firstVertex = firstVertex;
+    }
 
     mCommandTracker.onDraw();
 }
@@ -1625,10 +1715,20 @@ ANGLE_INLINE void SecondaryCommandBuffer::drawIndexed(uint32_t indexCount)
 ANGLE_INLINE void SecondaryCommandBuffer::drawIndexedBaseVertex(uint32_t indexCount,
                                                                 uint32_t vertexOffset)
 {
-    DrawIndexedBaseVertexParams *paramStruct =
-        initCommand<DrawIndexedBaseVertexParams>(CommandID::DrawIndexedBaseVertex);
-    paramStruct->indexCount   = indexCount;
-    paramStruct->vertexOffset = vertexOffset;
+    if ((indexCount | vertexOffset) <= std::numeric_limits<uint16_t>::max())
+    {
+        DrawIndexedBaseVertexPackedParams *paramStruct =
+            initCommand<DrawIndexedBaseVertexPackedParams>(CommandID::DrawIndexedBaseVertexPacked);
+        paramStruct->indexCount   = static_cast<uint16_t>(indexCount);
+        paramStruct->vertexOffset = static_cast<uint16_t>(vertexOffset);
+    }
+    else
+    {
+        DrawIndexedBaseVertexParams *paramStruct =
+            initCommand<DrawIndexedBaseVertexParams>(CommandID::DrawIndexedBaseVertex);
+        paramStruct->indexCount   = indexCount;
+        paramStruct->vertexOffset = vertexOffset;
+    }
 
     mCommandTracker.onDraw();
 }
@@ -1651,10 +1751,20 @@ ANGLE_INLINE void SecondaryCommandBuffer::drawIndexedIndirect(const Buffer &buff
 ANGLE_INLINE void SecondaryCommandBuffer::drawIndexedInstanced(uint32_t indexCount,
                                                                uint32_t instanceCount)
 {
-    DrawIndexedInstancedParams *paramStruct =
-        initCommand<DrawIndexedInstancedParams>(CommandID::DrawIndexedInstanced);
-    paramStruct->indexCount    = indexCount;
-    paramStruct->instanceCount = instanceCount;
+    if ((indexCount | instanceCount) <= std::numeric_limits<uint16_t>::max())
+    {
+        DrawIndexedInstancedPackedParams *paramStruct =
+            initCommand<DrawIndexedInstancedPackedParams>(CommandID::DrawIndexedInstancedPacked);
+        paramStruct->indexCount    = static_cast<uint16_t>(indexCount);
+        paramStruct->instanceCount = static_cast<uint16_t>(instanceCount);
+    }
+    else
+    {
+        DrawIndexedInstancedParams *paramStruct =
+            initCommand<DrawIndexedInstancedParams>(CommandID::DrawIndexedInstanced);
+        paramStruct->indexCount    = indexCount;
+        paramStruct->instanceCount = instanceCount;
+    }
 
     mCommandTracker.onDraw();
 }
@@ -2115,8 +2225,25 @@ ANGLE_INLINE void SecondaryCommandBuffer::setScissor(uint32_t firstScissor,
     ASSERT(firstScissor == 0);
     ASSERT(scissorCount == 1);
     ASSERT(scissors != nullptr);
-    SetScissorParams *paramStruct = initCommand<SetScissorParams>(CommandID::SetScissor);
-    paramStruct->scissor          = scissors[0];
+
+    // Scissor offsets are never negative.
+    const VkRect2D &scissor = scissors[0];
+    if ((static_cast<uint32_t>(scissor.offset.x) | static_cast<uint32_t>(scissor.offset.y) |
+         scissor.extent.width | scissor.extent.height) <= std::numeric_limits<uint16_t>::max())
+    {
+        SetScissorPackedParams *paramStruct =
+            initCommand<SetScissorPackedParams>(CommandID::SetScissorPacked);
+        paramStruct->x       = static_cast<uint16_t>(scissor.offset.x);
+        paramStruct->y       = static_cast<uint16_t>(scissor.offset.y);
+        paramStruct->width   = static_cast<uint16_t>(scissor.extent.width);
+        paramStruct->height  = static_cast<uint16_t>(scissor.extent.height);
+        paramStruct->padding = 0;
+    }
+    else
+    {
+        SetScissorParams *paramStruct = initCommand<SetScissorParams>(CommandID::SetScissor);
+        paramStruct->scissor          = scissor;
+    }
 }
 
 ANGLE_INLINE void SecondaryCommandBuffer::setStencilCompareMask(uint32_t compareFrontMask,
@@ -2201,6 +2328,14 @@ ANGLE_INLINE void SecondaryCommandBuffer::setVertexInput(
     }
 }
 
+// Whether |value| is an integer that fits in SetViewportPackedParams.  False for NaN.
+ANGLE_INLINE bool IsPackableViewportCoordinate(float value)
+{
+    return value >= std::numeric_limits<int16_t>::min() &&
+           value <= std::numeric_limits<int16_t>::max() &&
+           static_cast<float>(static_cast<int16_t>(value)) == value;
+}
+
 ANGLE_INLINE void SecondaryCommandBuffer::setViewport(uint32_t firstViewport,
                                                       uint32_t viewportCount,
                                                       const VkViewport *viewports)
@@ -2208,8 +2343,26 @@ ANGLE_INLINE void SecondaryCommandBuffer::setViewport(uint32_t firstViewport,
     ASSERT(firstViewport == 0);
     ASSERT(viewportCount == 1);
     ASSERT(viewports != nullptr);
-    SetViewportParams *paramStruct = initCommand<SetViewportParams>(CommandID::SetViewport);
-    paramStruct->viewport          = viewports[0];
+
+    const VkViewport &viewport = viewports[0];
+    if (IsPackableViewportCoordinate(viewport.x) && IsPackableViewportCoordinate(viewport.y) &&
+        IsPackableViewportCoordinate(viewport.width) &&
+        IsPackableViewportCoordinate(viewport.height) && viewport.minDepth == 0.0f &&
+        viewport.maxDepth == 1.0f)
+    {
+        SetViewportPackedParams *paramStruct =
+            initCommand<SetViewportPackedParams>(CommandID::SetViewportPacked);
+        paramStruct->x       = static_cast<int16_t>(viewport.x);
+        paramStruct->y       = static_cast<int16_t>(viewport.y);
+        paramStruct->width   = static_cast<int16_t>(viewport.width);
+        paramStruct->height  = static_cast<int16_t>(viewport.height);
+        paramStruct->padding = 0;
+    }
+    else
+    {
+        SetViewportParams *paramStruct = initCommand<SetViewportParams>(CommandID::SetViewport);
+        paramStruct->viewport          = viewport;
+    }
 }
 
 ANGLE_INLINE void SecondaryCommandBuffer::waitEvents(
@@ -0,0 +1,32 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// SecondaryCommandBufferTestUtils.h: Utility functions for the tests and benchmarks of ANGLE's
+// secondary command buffers.
+
+#ifndef LIBANGLE_RENDERER_VULKAN_SECONDARYCOMMANDBUFFERTESTUTILS_H_
+#define LIBANGLE_RENDERER_VULKAN_SECONDARYCOMMANDBUFFERTESTUTILS_H_
+
+#include <cstdint>
+#include <cstring>
+
+namespace rx
+{
+namespace vk
+{
+// Makes a fake non-dispatchable handle.  The commands are never executed, so the handles are only
+// compared.
+template <typename HandleT>
+HandleT MakeHandle(uint64_t value)
+{
+    HandleT handle;
+    static_assert(sizeof(handle) == sizeof(value), "Unexpected handle size");
+    memcpy(&handle, &value, sizeof(handle));
+    return handle;
+}
+}  // namespace vk
+}  // namespace rx
+
+#endif  // LIBANGLE_RENDERER_VULKAN_SECONDARYCOMMANDBUFFERTESTUTILS_H_
@@ -0,0 +1,227 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// SecondaryCommandBuffer_unittest.cpp: Unit tests for the command encoding and the redundant
+// command elision of ANGLE's secondary command buffers.
+//
+
+#include "gtest/gtest.h"
+
+#include "libANGLE/renderer/vulkan/SecondaryCommandBuffer.h"
+#include "libANGLE/renderer/vulkan/SecondaryCommandBufferTestUtils.h"
+
+namespace rx
+{
+namespace vk
+{
+namespace
+{
+VkViewport MakeViewport(float width)
+{
+    return {0.0f, 0.0f, width, 64.0f, 0.0f, 1.0f};
+}
+
+VkMemoryBarrier MakeMemoryBarrier(VkAccessFlags srcAccessMask, VkAccessFlags dstAccessMask)
+{
+    VkMemoryBarrier memoryBarrier = {};
+    memoryBarrier.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    memoryBarrier.srcAccessMask   = srcAccessMask;
+    memoryBarrier.dstAccessMask   = dstAccessMask;
+    return memoryBarrier;
+}
+
+class SecondaryCommandBufferTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        mAllocator.init(&mSlabPool);
+        ASSERT_EQ(angle::Result::Continue,
+                  mCommandBuffer.initialize(nullptr, nullptr, true, mAllocator.getAllocator()));
+    }
+
+    void TearDown() override
+    {
+        // The wrappers assert that their handles have been released.
+        mPipelineA.setHandle(VK_NULL_HANDLE);
+        mPipelineB.setHandle(VK_NULL_HANDLE);
+        mPipelineLayout.setHandle(VK_NULL_HANDLE);
+    }
+
+    CommandMemorySlabPool mSlabPool;
+    DedicatedCommandBlockAllocator mAllocator;
+    priv::SecondaryCommandBuffer mCommandBuffer;
+
+    Pipeline mPipelineA;
+    Pipeline mPipelineB;
+    PipelineLayout mPipelineLayout;
+};
+
+// Test that commands whose parameters fit in 16 bits use the packed encoding.
+TEST_F(SecondaryCommandBufferTest, SmallParametersArePacked)
+{
+    mCommandBuffer.draw(65535, 0);
+    mCommandBuffer.draw(65536, 0);
+    mCommandBuffer.drawIndexedBaseVertex(6, 100);
+    mCommandBuffer.drawIndexedBaseVertex(6, static_cast<uint32_t>(-1));
+    mCommandBuffer.drawIndexedInstanced(6, 2);
+    mCommandBuffer.drawIndexedInstanced(6, 100000);
+
+    EXPECT_EQ(
+        "DrawPacked Draw "
+        "DrawIndexedBaseVertexPacked DrawIndexedBaseVertex "
+        "DrawIndexedInstancedPacked DrawIndexedInstanced ",
+        mCommandBuffer.dumpCommands(" "));
+}
+
+// Test that only integer viewports with the default depth range and scissors with small offsets
+// and extents use the packed encoding.
+TEST_F(SecondaryCommandBufferTest, SmallDynamicStateIsPacked)
+{
+    const VkViewport flippedViewport    = {0.0f, 64.0f, 64.0f, -64.0f, 0.0f, 1.0f};
+    const VkViewport depthRangeViewport = {0.0f, 0.0f, 64.0f, 64.0f, 0.25f, 1.0f};
+    const VkViewport largeViewport      = {0.0f, 0.0f, 65536.0f, 64.0f, 0.0f, 1.0f};
+    const VkRect2D smallScissor         = {{16, 16}, {65535, 64}};
+    const VkRect2D largeScissor         = {{0, 0}, {65536, 64}};
+
+    mCommandBuffer.setViewport(0, 1, &flippedViewport);
+    mCommandBuffer.setViewport(0, 1, &depthRangeViewport);
+    mCommandBuffer.setViewport(0, 1, &largeViewport);
+    mCommandBuffer.setScissor(0, 1, &smallScissor);
+    mCommandBuffer.setScissor(0, 1, &largeScissor);
+
+    EXPECT_EQ("SetViewportPacked SetViewport SetViewport SetScissorPacked SetScissor ",
+              mCommandBuffer.dumpCommands(" "));
+}
+
+// Test that state commands that set the state to its current value are elided, and that the ones
+// that change it are kept.
+TEST_F(SecondaryCommandBufferTest, RedundantStateIsElided)
+{
+    mPipelineA.setHandle(MakeHandle<VkPipeline>(1));
+    mPipelineB.setHandle(MakeHandle<VkPipeline>(2));
+
+    const VkViewport viewportA = MakeViewport(64.0f);
+    const VkViewport viewportB = MakeViewport(32.0f);
+    const VkRect2D scissor     = {{0, 0}, {64, 64}};
+
+    mCommandBuffer.bindGraphicsPipeline(mPipelineA);
+    mCommandBuffer.setViewport(0, 1, &viewportA);
+    mCommandBuffer.setScissor(0, 1, &scissor);
+    mCommandBuffer.draw(3, 0);
+
+    mCommandBuffer.bindGraphicsPipeline(mPipelineA);
+    mCommandBuffer.setViewport(0, 1, &viewportA);
+    mCommandBuffer.setScissor(0, 1, &scissor);
+    mCommandBuffer.draw(3, 0);
+
+    mCommandBuffer.bindGraphicsPipeline(mPipelineB);
+    mCommandBuffer.setViewport(0, 1, &viewportB);
+    mCommandBuffer.draw(3, 0);
+
+    mCommandBuffer.setViewport(0, 1, &viewportA);
+    mCommandBuffer.draw(3, 0);
+
+    EXPECT_EQ(3u, mCommandBuffer.elideRedundantCommands());
+    EXPECT_EQ(
+        "BindGraphicsPipeline SetViewportPacked SetScissorPacked DrawPacked "
+        "Elided Elided Elided DrawPacked "
+        "BindGraphicsPipeline SetViewportPacked DrawPacked "
+        "SetViewportPacked DrawPacked ",
+        mCommandBuffer.dumpCommands(" "));
+
+    // Elided commands are not considered again.
+    EXPECT_EQ(0u, mCommandBuffer.elideRedundantCommands());
+}
+
+// Test that descriptor set binds are only elided if the sets and their dynamic offsets match.
+TEST_F(SecondaryCommandBufferTest, DescriptorSetsWithDifferentOffsetsAreKept)
+{
+    mPipelineLayout.setHandle(MakeHandle<VkPipelineLayout>(1));
+
+    const VkDescriptorSet descriptorSet = MakeHandle<VkDescriptorSet>(2);
+    const uint32_t offsetA              = 0;
+    const uint32_t offsetB              = 256;
+
+    for (uint32_t offset : {offsetA, offsetA, offsetB})
+    {
+        mCommandBuffer.bindDescriptorSets(mPipelineLayout, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                          DescriptorSetIndex::UniformsAndXfb, 1, &descriptorSet, 1,
+                                          &offset);
+        mCommandBuffer.draw(3, 0);
+    }
+
+    EXPECT_EQ(1u, mCommandBuffer.elideRedundantCommands());
+    EXPECT_EQ("BindDescriptorSets DrawPacked Elided DrawPacked BindDescriptorSets DrawPacked ",
+              mCommandBuffer.dumpCommands(" "));
+}
+
+// Test that adjacent memory barriers are merged into one, but not across other commands.
+TEST_F(SecondaryCommandBufferTest, AdjacentMemoryBarriersAreMerged)
+{
+    mCommandBuffer.memoryBarrier(
+        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+        MakeMemoryBarrier(VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT));
+    mCommandBuffer.memoryBarrier(
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+        MakeMemoryBarrier(VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_INDEX_READ_BIT));
+    mCommandBuffer.dispatch(1, 1, 1);
+    mCommandBuffer.memoryBarrier(
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+        MakeMemoryBarrier(VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_INDEX_READ_BIT));
+
+    EXPECT_EQ(1u, mCommandBuffer.elideRedundantCommands());
+    EXPECT_EQ("MemoryBarrier Elided Dispatch MemoryBarrier ", mCommandBuffer.dumpCommands(" "));
+}
+
+// Test that a state command is not elided if the state was changed by the other encoding of the
+// command in between.
+TEST_F(SecondaryCommandBufferTest, ElisionTracksBothEncodings)
+{
+    const VkViewport viewportA = MakeViewport(64.0f);
+    const VkViewport viewportB = MakeViewport(32.5f);
+
+    for (const VkViewport &viewport : {viewportA, viewportB, viewportA})
+    {
+        mCommandBuffer.setViewport(0, 1, &viewport);
+        mCommandBuffer.draw(3, 0);
+    }
+
+    EXPECT_EQ(0u, mCommandBuffer.elideRedundantCommands());
+    EXPECT_EQ("SetViewportPacked DrawPacked SetViewport DrawPacked SetViewportPacked DrawPacked ",
+              mCommandBuffer.dumpCommands(" "));
+}
+
+// Test that state is not assumed to carry over to the next subpass.
+TEST_F(SecondaryCommandBufferTest, NextSubpassResetsState)
+{
+    const VkViewport viewport = MakeViewport(64.0f);
+
+    mCommandBuffer.setViewport(0, 1, &viewport);
+    mCommandBuffer.draw(3, 0);
+    mCommandBuffer.nextSubpass(VK_SUBPASS_CONTENTS_INLINE);
+    mCommandBuffer.setViewport(0, 1, &viewport);
+    mCommandBuffer.draw(3, 0);
+
+    EXPECT_EQ(0u, mCommandBuffer.elideRedundantCommands());
+}
+
+// Test that redundant commands are found across command blocks.
+TEST_F(SecondaryCommandBufferTest, ElisionSpansCommandBlocks)
+{
+    constexpr uint32_t kDrawCount = 200;
+    const VkViewport viewport     = MakeViewport(64.0f);
+
+    for (uint32_t draw = 0; draw < kDrawCount; ++draw)
+    {
+        mCommandBuffer.setViewport(0, 1, &viewport);
+        mCommandBuffer.draw(3, 0);
+    }
+
+    EXPECT_EQ(kDrawCount - 1, mCommandBuffer.elideRedundantCommands());
+}
+}  // anonymous namespace
+}  // namespace vk
+}  // namespace rx
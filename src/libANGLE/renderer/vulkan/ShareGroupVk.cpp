@@ -64,6 +64,7 @@ ShareGroupVk::ShareGroupVk(const egl::ShareGroupState &state, vk::Renderer *rend
     : ShareGroupImpl(state),
       mRenderer(renderer),
       mCurrentFrameCount(0),
+      mGraphicsPipelineUseSerial(0),
       mContextsPriority(egl::ContextPriority::InvalidEnum),
       mIsContextsPriorityLocked(false),
       mLastMonolithicPipelineJobTime(0)
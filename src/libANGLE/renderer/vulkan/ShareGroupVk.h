@@ -104,6 +104,10 @@ class ShareGroupVk : public ShareGroupImpl
     void onFramebufferBoundary();
     uint32_t getCurrentFrameCount() const { return mCurrentFrameCount; }
 
+    // Orders the binds of graphics pipelines for the LRU eviction of the pipeline caches, which
+    // program executables share between the contexts of the share group.
+    uint64_t generateGraphicsPipelineUseSerial() { return ++mGraphicsPipelineUseSerial; }
+
   private:
     angle::Result updateContextsPriority(ContextVk *contextVk, egl::ContextPriority newPriority);
 
@@ -114,6 +118,8 @@ class ShareGroupVk : public ShareGroupImpl
     // Tracks the total number of frames rendered.
     uint32_t mCurrentFrameCount;
 
+    uint64_t mGraphicsPipelineUseSerial;
+
     // VkFramebuffer caches
     FramebufferCache mFramebufferCache;
 
@@ -0,0 +1,188 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// SpirvTransformCache_unittest.cpp: Unit tests for the cache of the SPIR-V transformations of a
+// program's shaders.
+//
+
+#include "gtest/gtest.h"
+
+#include <set>
+
+#include "libANGLE/renderer/vulkan/ProgramExecutableVk.h"
+
+namespace rx
+{
+namespace
+{
+using BlobPointer = std::shared_ptr<const angle::spirv::Blob>;
+
+constexpr size_t kBlobWordCount = 64;
+constexpr size_t kBlobSize      = kBlobWordCount * sizeof(uint32_t);
+
+BlobPointer MakeBlob(uint32_t fill)
+{
+    return std::make_shared<const angle::spirv::Blob>(kBlobWordCount, fill);
+}
+
+SpvTransformOptions MakeOptions(gl::ShaderType shaderType)
+{
+    SpvTransformOptions options;
+    options.shaderType = shaderType;
+    return options;
+}
+
+CacheStats GetStats(const SpirvTransformCache &cache)
+{
+    CacheStats stats;
+    cache.getCacheStats(&stats);
+    return stats;
+}
+
+// Test that every combination of shader type and flags has its own key.
+TEST(SpirvTransformCacheTest, KeysAreUnique)
+{
+    std::set<uint32_t> keys;
+    size_t optionCount = 0;
+    for (gl::ShaderType shaderType : gl::AllShaderTypes())
+    {
+        for (uint32_t flags = 0; flags < 256; ++flags)
+        {
+            SpvTransformOptions options            = MakeOptions(shaderType);
+            options.isLastPreFragmentStage         = (flags & 0x01) != 0;
+            options.isTransformFeedbackStage       = (flags & 0x02) != 0;
+            options.isTransformFeedbackEmulated    = (flags & 0x04) != 0;
+            options.isMultisampledFramebufferFetch = (flags & 0x08) != 0;
+            options.enableSampleShading            = (flags & 0x10) != 0;
+            options.validate                       = (flags & 0x20) != 0;
+            options.useSpirvVaryingPrecisionFixer  = (flags & 0x40) != 0;
+            options.removeDepthStencilInput        = (flags & 0x80) != 0;
+
+            keys.insert(SpirvTransformCache::GetKey(options));
+            ++optionCount;
+        }
+    }
+
+    EXPECT_EQ(optionCount, keys.size());
+}
+
+// Test that a blob is only found with the options it was transformed with.
+TEST(SpirvTransformCacheTest, DifferentOptionsDontCollide)
+{
+    SpirvTransformCache cache;
+
+    const SpvTransformOptions vertexOptions   = MakeOptions(gl::ShaderType::Vertex);
+    const SpvTransformOptions fragmentOptions = MakeOptions(gl::ShaderType::Fragment);
+
+    // Options that differ from the above by a single flag.
+    SpvTransformOptions lastStageOptions     = vertexOptions;
+    lastStageOptions.isLastPreFragmentStage  = true;
+    SpvTransformOptions sampleShadingOptions = fragmentOptions;
+    sampleShadingOptions.enableSampleShading = true;
+
+    const BlobPointer vertexBlob   = MakeBlob(1);
+    const BlobPointer fragmentBlob = MakeBlob(2);
+    cache.put(vertexOptions, vertexBlob);
+    cache.put(fragmentOptions, fragmentBlob);
+
+    BlobPointer blob;
+    EXPECT_FALSE(cache.get(lastStageOptions, &blob));
+    EXPECT_FALSE(cache.get(sampleShadingOptions, &blob));
+    EXPECT_EQ(nullptr, blob);
+
+    // The same options find the same blob, which is shared instead of copied.
+    ASSERT_TRUE(cache.get(vertexOptions, &blob));
+    EXPECT_EQ(vertexBlob, blob);
+    ASSERT_TRUE(cache.get(fragmentOptions, &blob));
+    EXPECT_EQ(fragmentBlob, blob);
+}
+
+// Test that the least recently used blob is evicted once the cache is full.
+TEST(SpirvTransformCacheTest, EvictsLeastRecentlyUsed)
+{
+    constexpr size_t kCapacity = 4;
+    SpirvTransformCache cache(kBlobSize * kCapacity);
+
+    const SpvTransformOptions options[] = {
+        MakeOptions(gl::ShaderType::Vertex),         MakeOptions(gl::ShaderType::TessControl),
+        MakeOptions(gl::ShaderType::TessEvaluation), MakeOptions(gl::ShaderType::Geometry),
+        MakeOptions(gl::ShaderType::Fragment),
+    };
+    for (size_t index = 0; index < kCapacity; ++index)
+    {
+        cache.put(options[index], MakeBlob(static_cast<uint32_t>(index)));
+    }
+    EXPECT_EQ(0u, GetStats(cache).getEvictionCount());
+    EXPECT_EQ(kCapacity, GetStats(cache).getSize());
+
+    // Use the first blob, so the second one becomes the least recently used.
+    BlobPointer firstBlob;
+    ASSERT_TRUE(cache.get(options[0], &firstBlob));
+
+    cache.put(options[kCapacity], MakeBlob(static_cast<uint32_t>(kCapacity)));
+    EXPECT_EQ(1u, GetStats(cache).getEvictionCount());
+    EXPECT_EQ(kCapacity, GetStats(cache).getSize());
+
+    BlobPointer blob;
+    EXPECT_FALSE(cache.get(options[1], &blob));
+    for (size_t index : {2, 3, 4})
+    {
+        EXPECT_TRUE(cache.get(options[index], &blob));
+    }
+    ASSERT_TRUE(cache.get(options[0], &blob));
+    EXPECT_EQ(firstBlob, blob);
+
+    // Replacing a blob is not an eviction.
+    cache.put(options[0], MakeBlob(5));
+    EXPECT_EQ(1u, GetStats(cache).getEvictionCount());
+    EXPECT_EQ(kCapacity, GetStats(cache).getSize());
+}
+
+// Test that a blob larger than the cache is not cached, and evicts nothing.
+TEST(SpirvTransformCacheTest, LargeBlobIsNotCached)
+{
+    SpirvTransformCache cache(kBlobSize);
+
+    const SpvTransformOptions vertexOptions   = MakeOptions(gl::ShaderType::Vertex);
+    const SpvTransformOptions fragmentOptions = MakeOptions(gl::ShaderType::Fragment);
+    cache.put(vertexOptions, MakeBlob(1));
+    cache.put(fragmentOptions, std::make_shared<const angle::spirv::Blob>(kBlobWordCount + 1, 2));
+
+    BlobPointer blob;
+    EXPECT_TRUE(cache.get(vertexOptions, &blob));
+    EXPECT_FALSE(cache.get(fragmentOptions, &blob));
+    EXPECT_EQ(0u, GetStats(cache).getEvictionCount());
+    EXPECT_EQ(1u, GetStats(cache).getSize());
+}
+
+// Test that lookups are counted as hits and misses, and that clearing the cache empties it.
+TEST(SpirvTransformCacheTest, HitAndMissStats)
+{
+    SpirvTransformCache cache;
+
+    const SpvTransformOptions vertexOptions   = MakeOptions(gl::ShaderType::Vertex);
+    const SpvTransformOptions fragmentOptions = MakeOptions(gl::ShaderType::Fragment);
+
+    BlobPointer blob;
+    EXPECT_FALSE(cache.get(vertexOptions, &blob));
+    cache.put(vertexOptions, MakeBlob(1));
+    EXPECT_TRUE(cache.get(vertexOptions, &blob));
+    EXPECT_TRUE(cache.get(vertexOptions, &blob));
+    EXPECT_FALSE(cache.get(fragmentOptions, &blob));
+    cache.put(fragmentOptions, MakeBlob(2));
+    EXPECT_TRUE(cache.get(fragmentOptions, &blob));
+
+    CacheStats stats = GetStats(cache);
+    EXPECT_EQ(3u, stats.getHitCount());
+    EXPECT_EQ(2u, stats.getMissCount());
+    EXPECT_EQ(2u, stats.getSize());
+
+    cache.clear();
+    EXPECT_FALSE(cache.get(vertexOptions, &blob));
+    EXPECT_EQ(0u, GetStats(cache).getSize());
+    EXPECT_EQ(3u, GetStats(cache).getMissCount());
+}
+}  // anonymous namespace
+}  // namespace rx
@@ -16,11 +16,18 @@
 
 namespace angle
 {
-class PoolAllocator;
 class SharedRingBufferAllocator;
 }  // namespace angle
 
-using SecondaryCommandMemoryAllocator = angle::PoolAllocator;
+namespace rx
+{
+namespace vk
+{
+class DedicatedCommandMemoryAllocator;
+}  // namespace vk
+}  // namespace rx
+
+using SecondaryCommandMemoryAllocator = rx::vk::DedicatedCommandMemoryAllocator;
 
 namespace rx
 {
@@ -63,6 +70,9 @@ class VulkanSecondaryCommandBuffer : public priv::CommandBuffer
 
     void executeCommands(PrimaryCommandBuffer *primary) { primary->executeCommands(1, this); }
 
+    // The commands are recorded by the driver, so there is nothing to elide.
+    uint32_t elideRedundantCommands() { return 0; }
+
     void beginQuery(const QueryPool &queryPool, uint32_t query, VkQueryControlFlags flags);
 
     void blitImage(const Image &srcImage,
@@ -23,6 +23,7 @@
 #include "libANGLE/renderer/vulkan/vk_helpers.h"
 #include "libANGLE/renderer/vulkan/vk_renderer.h"
 
+#include <algorithm>
 #include <type_traits>
 
 namespace rx
@@ -33,6 +34,23 @@ constexpr bool kDumpPipelineCacheGraph = true;
 constexpr bool kDumpPipelineCacheGraph = false;
 #endif  // ANGLE_DUMP_PIPELINE_CACHE_GRAPH
 
+namespace
+{
+// Takes the lock that serializes the insertions into a cache whose lookups don't take a lock, and
+// records whether another thread was holding it.
+std::unique_lock<angle::SimpleMutex> LockCacheForInsert(angle::SimpleMutex *mutex,
+                                                        CacheStats *cacheStats)
+{
+    std::unique_lock<angle::SimpleMutex> lock(*mutex, std::try_to_lock);
+    if (!lock.owns_lock())
+    {
+        lock.lock();
+        cacheStats->lockContended();
+    }
+    return lock;
+}
+}  // anonymous namespace
+
 template <typename T>
 bool AllCacheEntriesHaveUniqueReference(const T &payload)
 {
@@ -3217,10 +3235,11 @@ bool ComputePipelineDesc::keyEqual(const ComputePipelineDesc &other) const
 }
 
 // GraphicsPipelineDesc implementation.
-// Use aligned allocation and free so we can use the alignas keyword.
+// Use aligned allocation and free so we can use the alignas keyword.  The desc is aligned to the
+// hash chunk size, so that each chunk is a single cache line.
 void *GraphicsPipelineDesc::operator new(std::size_t size)
 {
-    return angle::AlignedAlloc(size, 32);
+    return angle::AlignedAlloc(size, kGraphicsPipelineDescHashChunkSize);
 }
 
 void GraphicsPipelineDesc::operator delete(void *ptr)
@@ -3231,6 +3250,8 @@ void GraphicsPipelineDesc::operator delete(void *ptr)
 GraphicsPipelineDesc::GraphicsPipelineDesc()
 {
     memset(this, 0, sizeof(GraphicsPipelineDesc));
+    mDirtyHashChunks.set();
+    updateDirtyHashChunks();
 }
 
 GraphicsPipelineDesc::~GraphicsPipelineDesc() = default;
@@ -3243,6 +3264,9 @@ GraphicsPipelineDesc::GraphicsPipelineDesc(const GraphicsPipelineDesc &other)
 GraphicsPipelineDesc &GraphicsPipelineDesc::operator=(const GraphicsPipelineDesc &other)
 {
     memcpy(this, &other, sizeof(*this));
+    // Copies are typically stored as cache keys, so have them hash their dirty chunks once instead
+    // of on every lookup.
+    updateDirtyHashChunks();
     return *this;
 }
 
@@ -3273,10 +3297,13 @@ const void *GraphicsPipelineDesc::getPipelineSubsetMemory(GraphicsPipelineSubset
     // so it would be easy to exclude it from hash.
     static_assert(offsetof(GraphicsPipelineDesc, mVertexInput.vertex.strides) +
                       sizeof(PackedVertexInputAttributes::strides) ==
-                  sizeof(GraphicsPipelineDesc));
+                  kGraphicsPipelineDescSumOfSizes);
     static_assert(offsetof(GraphicsPipelineDesc, mVertexInput.vertex) +
                       sizeof(PackedVertexInputAttributes) ==
-                  sizeof(GraphicsPipelineDesc));
+                  kGraphicsPipelineDescSumOfSizes);
+    static_assert(offsetof(GraphicsPipelineDesc, mHashChunks) == kGraphicsPipelineDescSumOfSizes);
+    static_assert(offsetof(GraphicsPipelineDesc, mDirtyHashChunks) ==
+                  kGraphicsPipelineDescSumOfSizes + sizeof(mHashChunks));
 
     size_t vertexInputReduceSize = 0;
     if (mVertexInput.inputAssembly.bits.useVertexInputBindingStrideDynamicState)
@@ -3296,17 +3323,56 @@ const void *GraphicsPipelineDesc::getPipelineSubsetMemory(GraphicsPipelineSubset
 
         case GraphicsPipelineSubset::Complete:
         default:
-            *sizeOut = sizeof(*this) - vertexInputReduceSize;
+            *sizeOut = kGraphicsPipelineDescSumOfSizes - vertexInputReduceSize;
             return this;
     }
 }
 
+size_t GraphicsPipelineDesc::computeHashChunk(size_t chunk) const
+{
+    return angle::ComputeGenericHash(getPtr<uint8_t>() + chunk * kGraphicsPipelineDescHashChunkSize,
+                                     kGraphicsPipelineDescHashChunkSize);
+}
+
+void GraphicsPipelineDesc::updateDirtyHashChunks()
+{
+    for (size_t chunk : mDirtyHashChunks)
+    {
+        mHashChunks[chunk] = computeHashChunk(chunk);
+    }
+    mDirtyHashChunks.reset();
+}
+
 size_t GraphicsPipelineDesc::hash(GraphicsPipelineSubset subset) const
 {
     size_t keySize  = 0;
     const void *key = getPipelineSubsetMemory(subset, &keySize);
 
-    return angle::ComputeGenericHash(key, keySize);
+    // Every subset starts at the beginning of the desc, so the chunks of the subset are the chunks
+    // of the desc.  The cached hashes of the clean chunks are reused, while the dirty chunks and the
+    // remaining bytes of the subset are hashed directly.
+    static_assert(kPipelineShadersDescOffset == 0);
+    ASSERT(key == this);
+
+    const size_t chunkCount     = keySize / kGraphicsPipelineDescHashChunkSize;
+    const size_t chunksSize     = chunkCount * kGraphicsPipelineDescHashChunkSize;
+    const uint8_t *remainingKey = getPtr<uint8_t>() + chunksSize;
+
+    size_t hash = angle::ComputeGenericHash(remainingKey, keySize - chunksSize);
+    for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+    {
+        if (mDirtyHashChunks.test(chunk))
+        {
+            angle::HashCombine(hash, computeHashChunk(chunk));
+            continue;
+        }
+
+        // If a mutator fails to mark the chunk it modifies dirty, the cached hash is stale.
+        ASSERT(mHashChunks[chunk] == computeHashChunk(chunk));
+        angle::HashCombine(hash, mHashChunks[chunk]);
+    }
+
+    return hash;
 }
 
 bool GraphicsPipelineDesc::keyEqual(const GraphicsPipelineDesc &other,
@@ -3438,6 +3504,8 @@ void GraphicsPipelineDesc::initDefaults(const ErrorContext *context,
     mVertexInput.inputAssembly.bits.isProtectedContext = mShaders.shaders.bits.isProtectedContext =
         mFragmentOutput.blendMaskAndLogic.bits.isProtectedContext =
             pipelineProtectedAccess == PipelineProtectedAccess::Protected;
+
+    mDirtyHashChunks.set();
 }
 
 VkResult GraphicsPipelineDesc::initializePipeline(ErrorContext *context,
@@ -4254,14 +4322,14 @@ void GraphicsPipelineDesc::updateVertexInput(ContextVk *contextVk,
     // Each attribute is 4 bytes, so only one transition bit needs to be set.
     static_assert(kPackedAttribDescSize == kGraphicsPipelineDirtyBitBytes,
                   "Adjust transition bits");
-    transition->set(kBit);
+    setTransitionBit(transition, kBit);
 
     if (!contextVk->getFeatures().useVertexInputBindingStrideDynamicState.enabled)
     {
         SetBitField(mVertexInput.vertex.strides[attribIndex], stride);
-        transition->set(ANGLE_GET_INDEXED_TRANSITION_BIT(
-            mVertexInput.vertex.strides, attribIndex,
-            sizeof(mVertexInput.vertex.strides[0]) * kBitsPerByte));
+        setTransitionBit(transition, ANGLE_GET_INDEXED_TRANSITION_BIT(
+                                         mVertexInput.vertex.strides, attribIndex,
+                                         sizeof(mVertexInput.vertex.strides[0]) * kBitsPerByte));
     }
 }
 
@@ -4275,6 +4343,10 @@ void GraphicsPipelineDesc::setVertexShaderComponentTypes(gl::AttributesMask acti
         componentTypeMask & gl::GetActiveComponentTypeMask(activeAttribLocations);
 
     SetBitField(mVertexInput.vertex.shaderAttribComponentType, activeComponentTypeMask.bits());
+
+    markHashChunksDirty(ANGLE_GET_TRANSITION_BIT(mVertexInput.inputAssembly.bits), 1);
+    markHashChunksDirty(
+        ANGLE_GET_TRANSITION_BIT(mVertexInput.vertex.shaderAttribComponentType), 1);
 }
 
 void GraphicsPipelineDesc::updateVertexShaderComponentTypes(
@@ -4287,7 +4359,7 @@ void GraphicsPipelineDesc::updateVertexShaderComponentTypes(
     {
         SetBitField(mVertexInput.inputAssembly.bits.programActiveAttributeLocations,
                     activeAttribLocations.bits());
-        transition->set(ANGLE_GET_TRANSITION_BIT(mVertexInput.inputAssembly.bits));
+        setTransitionBit(transition, ANGLE_GET_TRANSITION_BIT(mVertexInput.inputAssembly.bits));
     }
 
     const gl::ComponentTypeMask activeComponentTypeMask =
@@ -4296,7 +4368,8 @@ void GraphicsPipelineDesc::updateVertexShaderComponentTypes(
     if (mVertexInput.vertex.shaderAttribComponentType != activeComponentTypeMask.bits())
     {
         SetBitField(mVertexInput.vertex.shaderAttribComponentType, activeComponentTypeMask.bits());
-        transition->set(ANGLE_GET_TRANSITION_BIT(mVertexInput.vertex.shaderAttribComponentType));
+        setTransitionBit(transition,
+                         ANGLE_GET_TRANSITION_BIT(mVertexInput.vertex.shaderAttribComponentType));
     }
 }
 
@@ -4304,6 +4377,7 @@ void GraphicsPipelineDesc::setTopology(gl::PrimitiveMode drawMode)
 {
     VkPrimitiveTopology vkTopology = gl_vk::GetPrimitiveTopology(drawMode);
     SetBitField(mVertexInput.inputAssembly.bits.topology, vkTopology);
+    markHashChunksDirty(ANGLE_GET_TRANSITION_BIT(mVertexInput.inputAssembly.bits), 1);
 }
 
 void GraphicsPipelineDesc::updateTopology(GraphicsPipelineTransitionBits *transition,
@@ -4317,7 +4391,7 @@ void GraphicsPipelineDesc::updateDepthClipControl(GraphicsPipelineTransitionBits
                                                   bool negativeOneToOne)
 {
     SetBitField(mShaders.shaders.bits.viewportNegativeOneToOne, negativeOneToOne);
-    transition->set(ANGLE_GET_TRANSITION_BIT(mShaders.shaders.bits));
+    setTransitionBit(transition, ANGLE_GET_TRANSITION_BIT(mShaders.shaders.bits));
 }
 
 void GraphicsPipelineDesc::updatePrimitiveRestartEnabled(GraphicsPipelineTransitionBits *transition,
@@ -4325,21 +4399,21 @@ void GraphicsPipelineDesc::updatePrimitiveRestartEnabled(GraphicsPipelineTransit
 {
     mVertexInput.inputAssembly.bits.primitiveRestartEnable =
         static_cast<uint16_t>(primitiveRestartEnabled);
-    transition->set(ANGLE_GET_TRANSITION_BIT(mVertexInput.inputAssembly.bits));
+    setTransitionBit(transition, ANGLE_GET_TRANSITION_BIT(mVertexInput.inputAssembly.bits));
 }
 
 void GraphicsPipelineDesc::updatePolygonMode(GraphicsPipelineTransitionBits *transition,
                                              gl::PolygonMode polygonMode)
 {
     mShaders.shaders.bits.polygonMode = gl_vk::GetPolygonMode(polygonMode);
-    transition->set(ANGLE_GET_TRANSITION_BIT(mShaders.shaders.bits));
+    setTransitionBit(transition, ANGLE_GET_TRANSITION_BIT(mShaders.shaders.bits));
 }
 
 void GraphicsPipelineDesc::updateCullMode(GraphicsPipelineTransitionBits *transition,
                                           const gl::RasterizerState &rasterState)
 {
     SetBitField(mShaders.shaders.bits.cullMode, gl_vk::GetCullMode(rasterState));
-    transition->set(ANGLE_GET_TRANSITION_BIT(mShaders.shaders.bits));
+    setTransitionBit(transition, ANGLE_GET_TRANSITION_BIT(mShaders.shaders.bits));
 }
 
 void GraphicsPipelineDesc::updateFrontFace(GraphicsPipelineTransitionBits *transition,
@@ -4348,7 +4422,7 @@ void GraphicsPipelineDesc::updateFrontFace(GraphicsPipelineTransitionBits *trans
 {
     SetBitField(mShaders.shaders.bits.frontFace,
                 gl_vk::GetFrontFace(rasterState.frontFace, invertFrontFace));
-    transition->set(ANGLE_GET_TRANSITION_BIT(mShaders.shaders.bits));
+    setTransitionBit(transition, ANGLE_GET_TRANSITION_BIT(mShaders.shaders.bits));
 }
 
 void GraphicsPipelineDesc::updateRasterizerDiscardEnabled(
@@ -4356,7 +4430,7 @@ void GraphicsPipelineDesc::updateRasterizerDiscardEnabled(
     bool rasterizerDiscardEnabled)
 {
     mShaders.shaders.bits.rasterizerDiscardEnable = static_cast<uint32_t>(rasterizerDiscardEnabled);
-    transition->set(ANGLE_GET_TRANSITION_BIT(mShaders.shaders.bits));
+    setTransitionBit(transition, ANGLE_GET_TRANSITION_BIT(mShaders.shaders.bits));
 }
 
 uint32_t GraphicsPipelineDesc::getRasterizationSamples() const
@@ -4368,6 +4442,7 @@ void GraphicsPipelineDesc::setRasterizationSamples(uint32_t rasterizationSamples
 {
     ASSERT(rasterizationSamples > 0);
     mSharedNonVertexInput.multisample.bits.rasterizationSamplesMinusOne = rasterizationSamples - 1;
+    markHashChunksDirty(ANGLE_GET_TRANSITION_BIT(mSharedNonVertexInput.multisample.bits), 1);
 }
 
 void GraphicsPipelineDesc::updateRasterizationSamples(GraphicsPipelineTransitionBits *transition,
@@ -4381,14 +4456,14 @@ void GraphicsPipelineDesc::updateAlphaToCoverageEnable(GraphicsPipelineTransitio
                                                        bool enable)
 {
     mSharedNonVertexInput.multisample.bits.alphaToCoverageEnable = enable;
-    transition->set(ANGLE_GET_TRANSITION_BIT(mSharedNonVertexInput.multisample.bits));
+    setTransitionBit(transition, ANGLE_GET_TRANSITION_BIT(mSharedNonVertexInput.multisample.bits));
 }
 
 void GraphicsPipelineDesc::updateAlphaToOneEnable(GraphicsPipelineTransitionBits *transition,
                                                   bool enable)
 {
     mSharedNonVertexInput.multisample.bits.alphaToOneEnable = enable;
-    transition->set(ANGLE_GET_TRANSITION_BIT(mSharedNonVertexInput.multisample.bits));
+    setTransitionBit(transition, ANGLE_GET_TRANSITION_BIT(mSharedNonVertexInput.multisample.bits));
 }
 
 void GraphicsPipelineDesc::updateSampleMask(GraphicsPipelineTransitionBits *transition,
@@ -4398,7 +4473,7 @@ void GraphicsPipelineDesc::updateSampleMask(GraphicsPipelineTransitionBits *tran
     ASSERT(maskNumber == 0);
     SetBitField(mSharedNonVertexInput.multisample.bits.sampleMask, mask);
 
-    transition->set(ANGLE_GET_TRANSITION_BIT(mSharedNonVertexInput.multisample.bits));
+    setTransitionBit(transition, ANGLE_GET_TRANSITION_BIT(mSharedNonVertexInput.multisample.bits));
 }
 
 void GraphicsPipelineDesc::updateSampleShading(GraphicsPipelineTransitionBits *transition,
@@ -4416,7 +4491,7 @@ void GraphicsPipelineDesc::updateSampleShading(GraphicsPipelineTransitionBits *t
         mSharedNonVertexInput.multisample.bits.minSampleShading = kMinSampleShadingScale;
     }
 
-    transition->set(ANGLE_GET_TRANSITION_BIT(mSharedNonVertexInput.multisample.bits));
+    setTransitionBit(transition, ANGLE_GET_TRANSITION_BIT(mSharedNonVertexInput.multisample.bits));
 }
 
 void GraphicsPipelineDesc::setSingleBlend(uint32_t colorIndexGL,
@@ -4438,13 +4513,19 @@ void GraphicsPipelineDesc::setSingleBlend(uint32_t colorIndexGL,
     SetBitField(blendAttachmentState.dstColorBlendFactor, dstFactor);
     SetBitField(blendAttachmentState.srcAlphaBlendFactor, VK_BLEND_FACTOR_ZERO);
     SetBitField(blendAttachmentState.dstAlphaBlendFactor, VK_BLEND_FACTOR_ONE);
+
+    markHashChunksDirty(ANGLE_GET_TRANSITION_BIT(mFragmentOutput.blendMaskAndLogic.bits), 1);
+    markHashChunksDirty(
+        ANGLE_GET_INDEXED_TRANSITION_BIT(mFragmentOutput.blend.attachments, colorIndexGL,
+                                         sizeof(PackedColorBlendAttachmentState) * kBitsPerByte),
+        1);
 }
 
 void GraphicsPipelineDesc::updateBlendEnabled(GraphicsPipelineTransitionBits *transition,
                                               gl::DrawBufferMask blendEnabledMask)
 {
     SetBitField(mFragmentOutput.blendMaskAndLogic.bits.blendEnableMask, blendEnabledMask.bits());
-    transition->set(ANGLE_GET_TRANSITION_BIT(mFragmentOutput.blendMaskAndLogic.bits));
+    setTransitionBit(transition, ANGLE_GET_TRANSITION_BIT(mFragmentOutput.blendMaskAndLogic.bits));
 }
 
 void GraphicsPipelineDesc::updateBlendEquations(GraphicsPipelineTransitionBits *transition,
@@ -4461,8 +4542,9 @@ void GraphicsPipelineDesc::updateBlendEquations(GraphicsPipelineTransitionBits *
             PackGLBlendOp(blendStateExt.getEquationColorIndexed(attachmentIndex));
         blendAttachmentState.alphaBlendOp =
             PackGLBlendOp(blendStateExt.getEquationAlphaIndexed(attachmentIndex));
-        transition->set(ANGLE_GET_INDEXED_TRANSITION_BIT(mFragmentOutput.blend.attachments,
-                                                         attachmentIndex, kSizeBits));
+        setTransitionBit(transition,
+                         ANGLE_GET_INDEXED_TRANSITION_BIT(mFragmentOutput.blend.attachments,
+                                                          attachmentIndex, kSizeBits));
     }
 }
 
@@ -4483,8 +4565,9 @@ void GraphicsPipelineDesc::updateBlendFuncs(GraphicsPipelineTransitionBits *tran
             PackGLBlendFactor(blendStateExt.getSrcAlphaIndexed(attachmentIndex));
         blendAttachmentState.dstAlphaBlendFactor =
             PackGLBlendFactor(blendStateExt.getDstAlphaIndexed(attachmentIndex));
-        transition->set(ANGLE_GET_INDEXED_TRANSITION_BIT(mFragmentOutput.blend.attachments,
-                                                         attachmentIndex, kSizeBits));
+        setTransitionBit(transition,
+                         ANGLE_GET_INDEXED_TRANSITION_BIT(mFragmentOutput.blend.attachments,
+                                                          attachmentIndex, kSizeBits));
     }
 }
 
@@ -4513,8 +4596,9 @@ void GraphicsPipelineDesc::resetBlendFuncsAndEquations(GraphicsPipelineTransitio
         blendAttachmentState.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
         blendAttachmentState.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
 
-        transition->set(ANGLE_GET_INDEXED_TRANSITION_BIT(mFragmentOutput.blend.attachments,
-                                                         attachmentIndex, kSizeBits));
+        setTransitionBit(transition,
+                         ANGLE_GET_INDEXED_TRANSITION_BIT(mFragmentOutput.blend.attachments,
+                                                          attachmentIndex, kSizeBits));
     }
 
     if (attachmentsToAdd.any())
@@ -4541,6 +4625,8 @@ void GraphicsPipelineDesc::setColorWriteMasks(gl::BlendStateExt::ColorMaskStorag
         }
         Int4Array_Set(mFragmentOutput.blend.colorWriteMaskBits, colorIndexGL, mask);
     }
+
+    markHashChunksDirty(ANGLE_GET_TRANSITION_BIT(mFragmentOutput.blend.colorWriteMaskBits), 1);
 }
 
 void GraphicsPipelineDesc::setSingleColorWriteMask(uint32_t colorIndexGL,
@@ -4548,6 +4634,7 @@ void GraphicsPipelineDesc::setSingleColorWriteMask(uint32_t colorIndexGL,
 {
     uint8_t colorMask = static_cast<uint8_t>(colorComponentFlags);
     Int4Array_Set(mFragmentOutput.blend.colorWriteMaskBits, colorIndexGL, colorMask);
+    markHashChunksDirty(ANGLE_GET_TRANSITION_BIT(mFragmentOutput.blend.colorWriteMaskBits), 1);
 }
 
 void GraphicsPipelineDesc::updateColorWriteMasks(
@@ -4573,7 +4660,8 @@ void GraphicsPipelineDesc::updateMissingOutputsMask(GraphicsPipelineTransitionBi
     {
         SetBitField(mFragmentOutput.blendMaskAndLogic.bits.missingOutputsMask,
                     missingOutputsMask.bits());
-        transition->set(ANGLE_GET_TRANSITION_BIT(mFragmentOutput.blendMaskAndLogic.bits));
+        setTransitionBit(transition,
+                         ANGLE_GET_TRANSITION_BIT(mFragmentOutput.blendMaskAndLogic.bits));
     }
 }
 
@@ -4581,49 +4669,56 @@ void GraphicsPipelineDesc::updateLogicOpEnabled(GraphicsPipelineTransitionBits *
                                                 bool enable)
 {
     mFragmentOutput.blendMaskAndLogic.bits.logicOpEnable = enable;
-    transition->set(ANGLE_GET_TRANSITION_BIT(mFragmentOutput.blendMaskAndLogic.bits));
+    setTransitionBit(transition, ANGLE_GET_TRANSITION_BIT(mFragmentOutput.blendMaskAndLogic.bits));
 }
 
 void GraphicsPipelineDesc::updateLogicOp(GraphicsPipelineTransitionBits *transition,
                                          VkLogicOp logicOp)
 {
     SetBitField(mFragmentOutput.blendMaskAndLogic.bits.logicOp, logicOp);
-    transition->set(ANGLE_GET_TRANSITION_BIT(mFragmentOutput.blendMaskAndLogic.bits));
+    setTransitionBit(transition, ANGLE_GET_TRANSITION_BIT(mFragmentOutput.blendMaskAndLogic.bits));
 }
 
 void GraphicsPipelineDesc::setDepthTestEnabled(bool enabled)
 {
     mShaders.shaders.bits.depthTest = enabled;
+    markHashChunksDirty(ANGLE_GET_TRANSITION_BIT(mShaders.shaders.bits), 1);
 }
 
 void GraphicsPipelineDesc::setDepthWriteEnabled(bool enabled)
 {
     mShaders.shaders.bits.depthWrite = enabled;
+    markHashChunksDirty(ANGLE_GET_TRANSITION_BIT(mShaders.shaders.bits), 1);
 }
 
 void GraphicsPipelineDesc::setDepthFunc(VkCompareOp op)
 {
     SetBitField(mShaders.shaders.bits.depthCompareOp, op);
+    markHashChunksDirty(ANGLE_GET_TRANSITION_BIT(mShaders.shaders.bits), 1);
 }
 
 void GraphicsPipelineDesc::setDepthClampEnabled(bool enabled)
 {
     mShaders.shaders.bits.depthClampEnable = enabled;
+    markHashChunksDirty(ANGLE_GET_TRANSITION_BIT(mShaders.shaders.bits), 1);
 }
 
 void GraphicsPipelineDesc::setStencilTestEnabled(bool enabled)
 {
     mShaders.shaders.bits.stencilTest = enabled;
+    markHashChunksDirty(ANGLE_GET_TRANSITION_BIT(mShaders.shaders.bits), 1);
 }
 
 void GraphicsPipelineDesc::setStencilFrontFuncs(VkCompareOp compareOp)
 {
     SetBitField(mShaders.shaders.front.compare, compareOp);
+    markHashChunksDirty(ANGLE_GET_TRANSITION_BIT(mShaders.shaders.front), 1);
 }
 
 void GraphicsPipelineDesc::setStencilBackFuncs(VkCompareOp compareOp)
 {
     SetBitField(mShaders.shaders.back.compare, compareOp);
+    markHashChunksDirty(ANGLE_GET_TRANSITION_BIT(mShaders.shaders.back), 1);
 }
 
 void GraphicsPipelineDesc::setStencilFrontOps(VkStencilOp failOp,
@@ -4633,6 +4728,8 @@ void GraphicsPipelineDesc::setStencilFrontOps(VkStencilOp failOp,
     SetBitField(mShaders.shaders.front.fail, failOp);
     SetBitField(mShaders.shaders.front.pass, passOp);
     SetBitField(mShaders.shaders.front.depthFail, depthFailOp);
+
+    markHashChunksDirty(ANGLE_GET_TRANSITION_BIT(mShaders.shaders.front), 1);
 }
 
 void GraphicsPipelineDesc::setStencilBackOps(VkStencilOp failOp,
@@ -4642,6 +4739,8 @@ void GraphicsPipelineDesc::setStencilBackOps(VkStencilOp failOp,
     SetBitField(mShaders.shaders.back.fail, failOp);
     SetBitField(mShaders.shaders.back.pass, passOp);
     SetBitField(mShaders.shaders.back.depthFail, depthFailOp);
+
+    markHashChunksDirty(ANGLE_GET_TRANSITION_BIT(mShaders.shaders.back), 1);
 }
 
 void GraphicsPipelineDesc::updateDepthTestEnabled(GraphicsPipelineTransitionBits *transition,
@@ -4728,12 +4827,14 @@ void GraphicsPipelineDesc::updatePolygonOffsetEnabled(GraphicsPipelineTransition
                                                       bool enabled)
 {
     mShaders.shaders.bits.depthBiasEnable = enabled;
-    transition->set(ANGLE_GET_TRANSITION_BIT(mShaders.shaders.bits));
+    setTransitionBit(transition, ANGLE_GET_TRANSITION_BIT(mShaders.shaders.bits));
 }
 
 void GraphicsPipelineDesc::setRenderPassDesc(const RenderPassDesc &renderPassDesc)
 {
     mSharedNonVertexInput.renderPass = renderPassDesc;
+    markHashChunksDirty(ANGLE_GET_TRANSITION_BIT(mSharedNonVertexInput.renderPass),
+                        kRenderPassDescSize >> kTransitionByteShift);
 }
 
 void GraphicsPipelineDesc::updateSubpass(GraphicsPipelineTransitionBits *transition,
@@ -4742,7 +4843,8 @@ void GraphicsPipelineDesc::updateSubpass(GraphicsPipelineTransitionBits *transit
     if (mSharedNonVertexInput.multisample.bits.subpass != subpass)
     {
         SetBitField(mSharedNonVertexInput.multisample.bits.subpass, subpass);
-        transition->set(ANGLE_GET_TRANSITION_BIT(mSharedNonVertexInput.multisample.bits));
+        setTransitionBit(transition,
+                         ANGLE_GET_TRANSITION_BIT(mSharedNonVertexInput.multisample.bits));
     }
 }
 
@@ -4750,7 +4852,7 @@ void GraphicsPipelineDesc::updatePatchVertices(GraphicsPipelineTransitionBits *t
                                                GLuint value)
 {
     SetBitField(mShaders.shaders.bits.patchVertices, value);
-    transition->set(ANGLE_GET_TRANSITION_BIT(mShaders.shaders.bits));
+    setTransitionBit(transition, ANGLE_GET_TRANSITION_BIT(mShaders.shaders.bits));
 }
 
 void GraphicsPipelineDesc::resetSubpass(GraphicsPipelineTransitionBits *transition)
@@ -4766,6 +4868,7 @@ void GraphicsPipelineDesc::nextSubpass(GraphicsPipelineTransitionBits *transitio
 void GraphicsPipelineDesc::setSubpass(uint32_t subpass)
 {
     SetBitField(mSharedNonVertexInput.multisample.bits.subpass, subpass);
+    markHashChunksDirty(ANGLE_GET_TRANSITION_BIT(mSharedNonVertexInput.multisample.bits), 1);
 }
 
 uint32_t GraphicsPipelineDesc::getSubpass() const
@@ -4780,7 +4883,7 @@ void GraphicsPipelineDesc::updateEmulatedDitherControl(GraphicsPipelineTransitio
     ASSERT(value != 0 || mShaders.shaders.emulatedDitherControl != 0);
 
     mShaders.shaders.emulatedDitherControl = value;
-    transition->set(ANGLE_GET_TRANSITION_BIT(mShaders.shaders.emulatedDitherControl));
+    setTransitionBit(transition, ANGLE_GET_TRANSITION_BIT(mShaders.shaders.emulatedDitherControl));
 }
 
 void GraphicsPipelineDesc::updateNonZeroStencilWriteMaskWorkaround(
@@ -4788,7 +4891,7 @@ void GraphicsPipelineDesc::updateNonZeroStencilWriteMaskWorkaround(
     bool enabled)
 {
     mShaders.shaders.bits.nonZeroStencilWriteMaskWorkaround = enabled;
-    transition->set(ANGLE_GET_TRANSITION_BIT(mShaders.shaders.bits));
+    setTransitionBit(transition, ANGLE_GET_TRANSITION_BIT(mShaders.shaders.bits));
 }
 
 void GraphicsPipelineDesc::updateRenderPassDesc(GraphicsPipelineTransitionBits *transition,
@@ -4806,7 +4909,8 @@ void GraphicsPipelineDesc::updateRenderPassDesc(GraphicsPipelineTransitionBits *
         setRenderPassFramebufferFetchMode(framebufferFetchMode);
     }
 
-    // The RenderPass is a special case where it spans multiple bits but has no member.
+    // The RenderPass is a special case where it spans multiple bits but has no member.  Its hash
+    // chunks are already updated by setRenderPassDesc().
     constexpr size_t kFirstBit =
         offsetof(GraphicsPipelineDesc, mSharedNonVertexInput.renderPass) >> kTransitionByteShift;
     constexpr size_t kBitCount = kRenderPassDescSize >> kTransitionByteShift;
@@ -4819,23 +4923,31 @@ void GraphicsPipelineDesc::updateRenderPassDesc(GraphicsPipelineTransitionBits *
 void GraphicsPipelineDesc::setRenderPassSampleCount(GLint samples)
 {
     mSharedNonVertexInput.renderPass.setSamples(samples);
+    markHashChunksDirty(ANGLE_GET_TRANSITION_BIT(mSharedNonVertexInput.renderPass),
+                        kRenderPassDescSize >> kTransitionByteShift);
 }
 
 void GraphicsPipelineDesc::setRenderPassFramebufferFetchMode(
     FramebufferFetchMode framebufferFetchMode)
 {
     mSharedNonVertexInput.renderPass.setFramebufferFetchMode(framebufferFetchMode);
+    markHashChunksDirty(ANGLE_GET_TRANSITION_BIT(mSharedNonVertexInput.renderPass),
+                        kRenderPassDescSize >> kTransitionByteShift);
 }
 
 void GraphicsPipelineDesc::setRenderPassColorAttachmentFormat(size_t colorIndexGL,
                                                               angle::FormatID formatID)
 {
     mSharedNonVertexInput.renderPass.packColorAttachment(colorIndexGL, formatID);
+    markHashChunksDirty(ANGLE_GET_TRANSITION_BIT(mSharedNonVertexInput.renderPass),
+                        kRenderPassDescSize >> kTransitionByteShift);
 }
 
 void GraphicsPipelineDesc::setRenderPassFoveation(bool isFoveated)
 {
     mSharedNonVertexInput.renderPass.setFragmentShadingAttachment(isFoveated);
+    markHashChunksDirty(ANGLE_GET_TRANSITION_BIT(mSharedNonVertexInput.renderPass),
+                        kRenderPassDescSize >> kTransitionByteShift);
 }
 
 // AttachmentOpsArray implementation.
@@ -5241,6 +5353,15 @@ void PipelineHelper::addTransition(GraphicsPipelineTransitionBits bits,
     mTransitions.emplace_back(bits, desc, pipeline);
 }
 
+void PipelineHelper::removeTransitionsTo(const angle::HashSet<PipelineHelper *> &pipelines)
+{
+    mTransitions.erase(std::remove_if(mTransitions.begin(), mTransitions.end(),
+                                      [&pipelines](const GraphicsPipelineTransition &transition) {
+                                          return pipelines.count(transition.target) != 0;
+                                      }),
+                       mTransitions.end());
+}
+
 void PipelineHelper::setLinkedLibraryReferences(vk::PipelineHelper *shadersPipeline)
 {
     mLinkedShaders = shadersPipeline;
@@ -5301,8 +5422,23 @@ size_t DescriptorSetDesc::hash() const
         return 0;
     }
 
-    return angle::ComputeGenericHash(mDescriptorInfos.data(),
-                                     sizeof(mDescriptorInfos[0]) * mDescriptorInfos.size());
+    // The desc is hashed on every descriptor set cache lookup, so this folds each 64-bit word with
+    // a multiply instead of going through the generic hash.  The keys are small and mostly made of
+    // serials, which this mixes well enough for the hash map.
+    static_assert(sizeof(DescriptorInfoDesc) % sizeof(uint64_t) == 0, "Size mismatch");
+    constexpr uint64_t kMultiplier = 0x9E3779B97F4A7C15ull;
+
+    uint64_t hash          = mDescriptorInfos.size();
+    const uint8_t *words   = reinterpret_cast<const uint8_t *>(mDescriptorInfos.data());
+    const size_t wordCount = mDescriptorInfos.size() * sizeof(DescriptorInfoDesc) / sizeof(hash);
+    for (size_t wordIndex = 0; wordIndex < wordCount; ++wordIndex)
+    {
+        uint64_t word;
+        memcpy(&word, words + wordIndex * sizeof(word), sizeof(word));
+        hash = (hash ^ word) * kMultiplier;
+        hash ^= hash >> 32;
+    }
+    return static_cast<size_t>(hash);
 }
 
 // FramebufferDesc implementation.
@@ -8192,6 +8328,8 @@ void GraphicsPipelineCache<Hash>::release(vk::ErrorContext *context)
         vk::DumpPipelineCacheGraph<Hash>(context, mPayload);
     }
 
+    accumulateCacheStats(context->getRenderer());
+
     for (auto &item : mPayload)
     {
         vk::PipelineHelper &pipeline = item.second;
@@ -8311,6 +8449,70 @@ void GraphicsPipelineCache<Hash>::populate(const vk::GraphicsPipelineDesc &desc,
     }
 }
 
+template <typename Hash>
+void GraphicsPipelineCache<Hash>::evictLeastRecentlyUsed(
+    vk::ErrorContext *context,
+    size_t maxSize,
+    const std::vector<const vk::PipelineHelper *> &pinnedPipelines,
+    angle::HashSet<vk::PipelineHelper *> *evictedOut)
+{
+    if (mPayload.size() <= maxSize)
+    {
+        return;
+    }
+
+    vk::Renderer *renderer = context->getRenderer();
+
+    using Iterator = typename decltype(mPayload)::iterator;
+    std::vector<std::pair<uint64_t, Iterator>> candidates;
+    candidates.reserve(mPayload.size());
+    for (auto iter = mPayload.begin(); iter != mPayload.end(); ++iter)
+    {
+        const vk::PipelineHelper &pipeline = iter->second;
+        if (!pipeline.valid() || !renderer->hasResourceUseFinished(pipeline.getResourceUse()) ||
+            std::find(pinnedPipelines.begin(), pinnedPipelines.end(), &pipeline) !=
+                pinnedPipelines.end())
+        {
+            continue;
+        }
+        candidates.emplace_back(pipeline.getLastUseSerial(), iter);
+    }
+
+    const size_t targetSize = maxSize - maxSize / 4;
+    const size_t evictCount = std::min(mPayload.size() - targetSize, candidates.size());
+    if (evictCount == 0)
+    {
+        return;
+    }
+
+    auto lessRecentlyUsed = [](const std::pair<uint64_t, Iterator> &a,
+                               const std::pair<uint64_t, Iterator> &b) {
+        return a.first < b.first;
+    };
+    std::nth_element(candidates.begin(), candidates.begin() + (evictCount - 1), candidates.end(),
+                     lessRecentlyUsed);
+
+    for (size_t index = 0; index < evictCount; ++index)
+    {
+        Iterator iter = candidates[index].second;
+        evictedOut->insert(&iter->second);
+
+        iter->second.release(context);
+        mPayload.erase(iter);
+        mCacheStats.evictAndDecrementSize();
+    }
+}
+
+template <typename Hash>
+void GraphicsPipelineCache<Hash>::removeTransitionsTo(
+    const angle::HashSet<vk::PipelineHelper *> &pipelines)
+{
+    for (auto &item : mPayload)
+    {
+        item.second.removeTransitionsTo(pipelines);
+    }
+}
+
 // Instantiate the pipeline cache functions
 template void GraphicsPipelineCache<GraphicsPipelineDescCompleteHash>::destroy(
     vk::ErrorContext *context);
@@ -8330,6 +8532,13 @@ template void GraphicsPipelineCache<GraphicsPipelineDescCompleteHash>::populate(
     const vk::GraphicsPipelineDesc &desc,
     vk::Pipeline &&pipeline,
     vk::PipelineHelper **pipelineHelperOut);
+template void GraphicsPipelineCache<GraphicsPipelineDescCompleteHash>::evictLeastRecentlyUsed(
+    vk::ErrorContext *context,
+    size_t maxSize,
+    const std::vector<const vk::PipelineHelper *> &pinnedPipelines,
+    angle::HashSet<vk::PipelineHelper *> *evictedOut);
+template void GraphicsPipelineCache<GraphicsPipelineDescCompleteHash>::removeTransitionsTo(
+    const angle::HashSet<vk::PipelineHelper *> &pipelines);
 
 template void GraphicsPipelineCache<GraphicsPipelineDescShadersHash>::destroy(
     vk::ErrorContext *context);
@@ -8360,7 +8569,7 @@ DescriptorSetLayoutCache::~DescriptorSetLayoutCache()
 
 void DescriptorSetLayoutCache::destroy(vk::Renderer *renderer)
 {
-    renderer->accumulateCacheStats(VulkanCacheType::DescriptorSetLayout, mCacheStats);
+    accumulateCacheStats(renderer);
     ASSERT(AllCacheEntriesHaveUniqueReference(mPayload));
     mPayload.clear();
 }
@@ -8371,13 +8580,11 @@ angle::Result DescriptorSetLayoutCache::getDescriptorSetLayout(
     vk::DescriptorSetLayoutPtr *descriptorSetLayoutOut)
 {
     // Note: this function may be called without holding the share group lock.
-    std::unique_lock<angle::SimpleMutex> lock(mMutex);
-
-    auto iter = mPayload.find(desc);
-    if (iter != mPayload.end())
+    const vk::DescriptorSetLayoutPtr *cachedLayout = mPayload.find(desc);
+    if (cachedLayout != nullptr)
     {
-        *descriptorSetLayoutOut = iter->second;
-        mCacheStats.hit();
+        *descriptorSetLayoutOut = *cachedLayout;
+        concurrentHit();
         return angle::Result::Continue;
     }
 
@@ -8388,6 +8595,17 @@ angle::Result DescriptorSetLayoutCache::getDescriptorSetLayout(
         return angle::Result::Continue;
     }
 
+    std::unique_lock<angle::SimpleMutex> lock = LockCacheForInsert(&mMutex, &mCacheStats);
+
+    // Another thread may have created the layout while waiting for the lock.
+    cachedLayout = mPayload.find(desc);
+    if (cachedLayout != nullptr)
+    {
+        *descriptorSetLayoutOut = *cachedLayout;
+        mCacheStats.hit();
+        return angle::Result::Continue;
+    }
+
     mCacheStats.missAndIncrementSize();
     // We must unpack the descriptor set layout description.
     vk::DescriptorSetLayoutBindingVector bindingVector;
@@ -8404,7 +8622,7 @@ angle::Result DescriptorSetLayoutCache::getDescriptorSetLayout(
     ANGLE_VK_TRY(context, newLayout->init(context->getDevice(), createInfo));
 
     *descriptorSetLayoutOut = newLayout;
-    mPayload.emplace(desc, std::move(newLayout));
+    mPayload.insert(desc, std::move(newLayout));
 
     return angle::Result::Continue;
 }
@@ -8431,12 +8649,21 @@ angle::Result PipelineLayoutCache::getPipelineLayout(
     vk::PipelineLayoutPtr *pipelineLayoutOut)
 {
     // Note: this function may be called without holding the share group lock.
-    std::unique_lock<angle::SimpleMutex> lock(mMutex);
+    const vk::PipelineLayoutPtr *cachedLayout = mPayload.find(desc);
+    if (cachedLayout != nullptr)
+    {
+        *pipelineLayoutOut = *cachedLayout;
+        concurrentHit();
+        return angle::Result::Continue;
+    }
 
-    auto iter = mPayload.find(desc);
-    if (iter != mPayload.end())
+    std::unique_lock<angle::SimpleMutex> lock = LockCacheForInsert(&mMutex, &mCacheStats);
+
+    // Another thread may have created the layout while waiting for the lock.
+    cachedLayout = mPayload.find(desc);
+    if (cachedLayout != nullptr)
     {
-        *pipelineLayoutOut = iter->second;
+        *pipelineLayoutOut = *cachedLayout;
         mCacheStats.hit();
         return angle::Result::Continue;
     }
@@ -8476,7 +8703,7 @@ angle::Result PipelineLayoutCache::getPipelineLayout(
     ANGLE_VK_TRY(context, newLayout->init(context->getDevice(), createInfo));
 
     *pipelineLayoutOut = newLayout;
-    mPayload.emplace(desc, std::move(newLayout));
+    mPayload.insert(desc, std::move(newLayout));
 
     return angle::Result::Continue;
 }
@@ -14,9 +14,11 @@
 #include <deque>
 
 #include "common/Color.h"
+#include "common/ConcurrentReadMap.h"
 #include "common/FixedVector.h"
 #include "common/SimpleMutex.h"
 #include "common/WorkerThread.h"
+#include "common/hash_containers.h"
 #include "libANGLE/Uniform.h"
 #include "libANGLE/renderer/vulkan/ShaderInterfaceVariableInfoMap.h"
 #include "libANGLE/renderer/vulkan/vk_resource.h"
@@ -744,6 +746,19 @@ using GraphicsPipelineTransitionBits = angle::BitSet<kNumGraphicsPipelineDirtyBi
 
 GraphicsPipelineTransitionBits GetGraphicsPipelineTransitionBitsMask(GraphicsPipelineSubset subset);
 
+// The hash of the desc is kept per cache-line sized chunk.  A state change only marks the chunk
+// holding the changed transition bits dirty, and dirty chunks are hashed again on lookup.  Bytes
+// past the last full chunk are hashed directly on lookup.
+constexpr size_t kGraphicsPipelineDescHashChunkSize = 64;
+constexpr size_t kGraphicsPipelineDescHashChunkCount =
+    kGraphicsPipelineDescSumOfSizes / kGraphicsPipelineDescHashChunkSize;
+constexpr size_t kGraphicsPipelineDirtyBitsPerHashChunk =
+    kGraphicsPipelineDescHashChunkSize / kGraphicsPipelineDirtyBitBytes;
+using GraphicsPipelineDescHashChunkBits = angle::BitSet64<kGraphicsPipelineDescHashChunkCount>;
+constexpr size_t kGraphicsPipelineDescHashCacheSize =
+    sizeof(size_t) * kGraphicsPipelineDescHashChunkCount +
+    sizeof(GraphicsPipelineDescHashChunkBits);
+
 // Disable padding warnings for a few helper structs that aggregate Vulkan state objects.  These are
 // not used as hash keys, they just simplify passing them around to functions.
 ANGLE_DISABLE_STRUCT_PADDING_WARNINGS
@@ -1102,6 +1117,7 @@ class GraphicsPipelineDesc final
     {
         mVertexInput.inputAssembly.bits.useVertexInputBindingStrideDynamicState = supports;
         mShaders.shaders.bits.nonZeroStencilWriteMaskWorkaround                 = false;
+        mDirtyHashChunks.set();
     }
 
     static VkFormat getPipelineVertexInputStateFormat(ErrorContext *context,
@@ -1122,6 +1138,10 @@ class GraphicsPipelineDesc final
         return mFragmentOutput;
     }
 
+    // Hashes the chunks modified since the last call again, so that hash() no longer has to.  Only
+    // the owner of the desc may call this, as the cached hashes are written.
+    void updateDirtyHashChunks();
+
     bool hasPipelineProtectedAccess() const
     {
         ASSERT(mShaders.shaders.bits.isProtectedContext ==
@@ -1137,6 +1157,32 @@ class GraphicsPipelineDesc final
 
     const void *getPipelineSubsetMemory(GraphicsPipelineSubset subset, size_t *sizeOut) const;
 
+    size_t computeHashChunk(size_t chunk) const;
+
+    // Marks the cached hashes of the chunks that hold the given transition bits dirty.  Must be
+    // called when the state they cover is modified.
+    void markHashChunksDirty(size_t firstBit, size_t bitCount)
+    {
+        // Bits past the last full chunk have no cached hash.
+        const size_t endChunk =
+            std::min((firstBit + bitCount - 1) / kGraphicsPipelineDirtyBitsPerHashChunk + 1,
+                     kGraphicsPipelineDescHashChunkCount);
+        for (size_t chunk = firstBit / kGraphicsPipelineDirtyBitsPerHashChunk; chunk < endChunk;
+             ++chunk)
+        {
+            mDirtyHashChunks.set(chunk);
+        }
+    }
+
+    // Marks a state transition, and the cached hash of the chunk the modified state belongs to
+    // dirty.  The update*() functions that modify the state through a set*() function, which
+    // already marks the chunk dirty, set the transition bit directly instead.
+    void setTransitionBit(GraphicsPipelineTransitionBits *transition, size_t bit)
+    {
+        transition->set(bit);
+        markHashChunksDirty(bit, 1);
+    }
+
     void initializePipelineVertexInputState(
         ErrorContext *context,
         GraphicsPipelineVertexInputVulkanStructs *stateOut,
@@ -1163,6 +1209,12 @@ class GraphicsPipelineDesc final
     PipelineSharedNonVertexInputState mSharedNonVertexInput;
     PipelineFragmentOutputState mFragmentOutput;
     PipelineVertexInputState mVertexInput;
+
+    // Not part of the key.  The hashes of the full chunks of the above state, which are stale for
+    // the chunks set in mDirtyHashChunks.  hash() never writes them, so it can be called from any
+    // thread; dirty chunks are hashed on the fly until updateDirtyHashChunks() is called.
+    std::array<size_t, kGraphicsPipelineDescHashChunkCount> mHashChunks;
+    GraphicsPipelineDescHashChunkBits mDirtyHashChunks;
 };
 
 // Verify the packed pipeline description has no gaps in the packing.
@@ -1170,7 +1222,9 @@ class GraphicsPipelineDesc final
 // No gaps or padding at the end ensures that hashing and memcmp checks will not run
 // into uninitialized memory regions.
 constexpr size_t kGraphicsPipelineDescSize = sizeof(GraphicsPipelineDesc);
-static_assert(kGraphicsPipelineDescSize == kGraphicsPipelineDescSumOfSizes, "Size mismatch");
+static_assert(kGraphicsPipelineDescSize ==
+                  kGraphicsPipelineDescSumOfSizes + kGraphicsPipelineDescHashCacheSize,
+              "Size mismatch");
 
 // Values are based on data recorded here -> https://anglebug.com/42267114#comment5
 constexpr size_t kDefaultDescriptorSetLayoutBindingsCount = 8;
@@ -1643,6 +1697,12 @@ class PipelineHelper final : public Resource
                        PipelineHelper *pipeline);
 
     const std::vector<GraphicsPipelineTransition> &getTransitions() const { return mTransitions; }
+    // Used when |pipelines| are evicted from the cache.
+    void removeTransitionsTo(const angle::HashSet<PipelineHelper *> &pipelines);
+
+    // Orders the pipelines of a cache by when they were last bound, for LRU eviction.
+    void setLastUseSerial(uint64_t serial) { mLastUseSerial = serial; }
+    uint64_t getLastUseSerial() const { return mLastUseSerial; }
 
     void setComputePipeline(Pipeline &&pipeline, CacheLookUpFeedback feedback)
     {
@@ -1670,6 +1730,7 @@ class PipelineHelper final : public Resource
     Pipeline mPipeline;
     CacheLookUpFeedback mCacheLookUpFeedback           = CacheLookUpFeedback::None;
     CacheLookUpFeedback mMonolithicCacheLookUpFeedback = CacheLookUpFeedback::None;
+    uint64_t mLastUseSerial                            = 0;
 
     // The list of pipeline helpers that were referenced when creating a linked pipeline.  These
     // pipelines must be kept alive, so their serial is updated at the same time as this object.
@@ -2432,6 +2493,8 @@ enum class VulkanCacheType
     ShaderResourcesDescriptors,
     Framebuffer,
     DescriptorMetaCache,
+    SpirvTransform,
+    CommandMemorySlabs,
     EnumCount
 };
 
@@ -2443,19 +2506,27 @@ class CacheStats final : angle::NonCopyable
     ~CacheStats() {}
 
     CacheStats(const CacheStats &rhs)
-        : mHitCount(rhs.mHitCount), mMissCount(rhs.mMissCount), mSize(rhs.mSize)
+        : mHitCount(rhs.mHitCount),
+          mMissCount(rhs.mMissCount),
+          mSize(rhs.mSize),
+          mEvictionCount(rhs.mEvictionCount),
+          mLockContentionCount(rhs.mLockContentionCount)
     {}
 
     CacheStats &operator=(const CacheStats &rhs)
     {
-        mHitCount  = rhs.mHitCount;
-        mMissCount = rhs.mMissCount;
-        mSize      = rhs.mSize;
+        mHitCount            = rhs.mHitCount;
+        mMissCount           = rhs.mMissCount;
+        mSize                = rhs.mSize;
+        mEvictionCount       = rhs.mEvictionCount;
+        mLockContentionCount = rhs.mLockContentionCount;
         return *this;
     }
 
     ANGLE_INLINE void hit() { mHitCount++; }
+    ANGLE_INLINE void addHits(uint32_t hitCount) { mHitCount += hitCount; }
     ANGLE_INLINE void miss() { mMissCount++; }
+    ANGLE_INLINE void addMisses(uint32_t missCount) { mMissCount += missCount; }
     ANGLE_INLINE void incrementSize() { mSize++; }
     ANGLE_INLINE void decrementSize() { mSize--; }
     ANGLE_INLINE void missAndIncrementSize()
@@ -2463,15 +2534,27 @@ class CacheStats final : angle::NonCopyable
         mMissCount++;
         mSize++;
     }
+    ANGLE_INLINE void evictAndDecrementSize()
+    {
+        mEvictionCount++;
+        mSize--;
+    }
+    ANGLE_INLINE void addEvictions(uint32_t evictionCount) { mEvictionCount += evictionCount; }
+    // Counts the times the cache's lock was held by another thread when it was needed.
+    ANGLE_INLINE void lockContended() { mLockContentionCount++; }
     ANGLE_INLINE void accumulate(const CacheStats &stats)
     {
         mHitCount += stats.mHitCount;
         mMissCount += stats.mMissCount;
         mSize += stats.mSize;
+        mEvictionCount += stats.mEvictionCount;
+        mLockContentionCount += stats.mLockContentionCount;
     }
 
     uint32_t getHitCount() const { return mHitCount; }
     uint32_t getMissCount() const { return mMissCount; }
+    uint32_t getEvictionCount() const { return mEvictionCount; }
+    uint32_t getLockContentionCount() const { return mLockContentionCount; }
 
     ANGLE_INLINE double getHitRatio() const
     {
@@ -2490,9 +2573,11 @@ class CacheStats final : angle::NonCopyable
 
     void reset()
     {
-        mHitCount  = 0;
-        mMissCount = 0;
-        mSize      = 0;
+        mHitCount            = 0;
+        mMissCount           = 0;
+        mSize                = 0;
+        mEvictionCount       = 0;
+        mLockContentionCount = 0;
     }
 
     void resetHitAndMissCount()
@@ -2505,12 +2590,16 @@ class CacheStats final : angle::NonCopyable
     {
         mHitCount += cacheStats.getHitCount();
         mMissCount += cacheStats.getMissCount();
+        mEvictionCount += cacheStats.getEvictionCount();
+        mLockContentionCount += cacheStats.getLockContentionCount();
     }
 
   private:
     uint32_t mHitCount;
     uint32_t mMissCount;
     uint32_t mSize;
+    uint32_t mEvictionCount;
+    uint32_t mLockContentionCount;
 };
 
 template <VulkanCacheType CacheType>
@@ -2533,6 +2622,44 @@ class HasCacheStats : angle::NonCopyable
     CacheStats mCacheStats;
 };
 
+// For caches whose lookups don't take a lock.  The hits are counted atomically, and added to the
+// stats when they are accumulated.  The rest of the stats are updated while holding the cache's
+// lock.
+template <VulkanCacheType CacheType>
+class HasConcurrentCacheStats : public HasCacheStats<CacheType>
+{
+  public:
+    template <typename Accumulator>
+    void accumulateCacheStats(Accumulator *accum)
+    {
+        this->mCacheStats.addHits(mConcurrentHitCount.exchange(0, std::memory_order_relaxed));
+        HasCacheStats<CacheType>::accumulateCacheStats(accum);
+    }
+
+    void getCacheStats(CacheStats *accum) const
+    {
+        HasCacheStats<CacheType>::getCacheStats(accum);
+        accum->addHits(mConcurrentHitCount.load(std::memory_order_relaxed));
+    }
+
+    // Helpers for white box tests
+    size_t getCacheHitCount() const
+    {
+        return this->mCacheStats.getHitCount() +
+               mConcurrentHitCount.load(std::memory_order_relaxed);
+    }
+    size_t getCacheMissCount() const { return this->mCacheStats.getMissCount(); }
+
+  protected:
+    HasConcurrentCacheStats() : mConcurrentHitCount(0) {}
+    ~HasConcurrentCacheStats() override = default;
+
+    void concurrentHit() { mConcurrentHitCount.fetch_add(1, std::memory_order_relaxed); }
+
+  private:
+    std::atomic<uint32_t> mConcurrentHitCount;
+};
+
 using VulkanCacheStats = angle::PackedEnumMap<VulkanCacheType, CacheStats>;
 
 // FramebufferVk Cache
@@ -2737,7 +2864,6 @@ class ComputePipelineCache final : HasCacheStats<rx::VulkanCacheType::ComputePip
         mPayload;
 };
 
-// TODO(jmadill): Add cache trimming/eviction.
 template <typename Hash>
 class GraphicsPipelineCache final : public HasCacheStats<VulkanCacheType::GraphicsPipeline>
 {
@@ -2784,6 +2910,29 @@ class GraphicsPipelineCache final : public HasCacheStats<VulkanCacheType::Graphi
     // Helper for VulkanPipelineCachePerf that resets the object without destroying any object.
     void reset() { mPayload.clear(); }
 
+    size_t size() const { return mPayload.size(); }
+
+    // Helper for tests that inspect the cached pipelines.
+    template <typename Callback>
+    void forEachPipelineForTesting(Callback &&callback) const
+    {
+        for (const auto &item : mPayload)
+        {
+            callback(item.second);
+        }
+    }
+
+    // Once the cache holds more than |maxSize| pipelines, releases the least recently used ones
+    // until about three quarters of |maxSize| remain, so that eviction is amortized over many
+    // insertions.  Pipelines that the GPU may still be using and |pinnedPipelines| (the ones bound
+    // by the contexts) are kept.  The evicted pipelines are added to |evictedOut|; the transitions
+    // to them must be removed from every cache they may be linked from, with removeTransitionsTo().
+    void evictLeastRecentlyUsed(vk::ErrorContext *context,
+                                size_t maxSize,
+                                const std::vector<const vk::PipelineHelper *> &pinnedPipelines,
+                                angle::HashSet<vk::PipelineHelper *> *evictedOut);
+    void removeTransitionsTo(const angle::HashSet<vk::PipelineHelper *> &pipelines);
+
   private:
     void addToCache(PipelineSource source,
                     const vk::GraphicsPipelineDesc &desc,
@@ -2799,11 +2948,14 @@ class GraphicsPipelineCache final : public HasCacheStats<VulkanCacheType::Graphi
 using CompleteGraphicsPipelineCache    = GraphicsPipelineCache<GraphicsPipelineDescCompleteHash>;
 using ShadersGraphicsPipelineCache     = GraphicsPipelineCache<GraphicsPipelineDescShadersHash>;
 
-class DescriptorSetLayoutCache final : angle::NonCopyable
+// The descriptor set layout and pipeline layout caches are looked up by link jobs without holding
+// the share group lock.  Lookups don't take a lock; mMutex is only taken to create a new layout.
+class DescriptorSetLayoutCache final
+    : public HasConcurrentCacheStats<VulkanCacheType::DescriptorSetLayout>
 {
   public:
     DescriptorSetLayoutCache();
-    ~DescriptorSetLayoutCache();
+    ~DescriptorSetLayoutCache() override;
 
     void destroy(vk::Renderer *renderer);
 
@@ -2811,17 +2963,12 @@ class DescriptorSetLayoutCache final : angle::NonCopyable
                                          const vk::DescriptorSetLayoutDesc &desc,
                                          vk::DescriptorSetLayoutPtr *descriptorSetLayoutOut);
 
-    // Helpers for white box tests
-    size_t getCacheHitCount() const { return mCacheStats.getHitCount(); }
-    size_t getCacheMissCount() const { return mCacheStats.getMissCount(); }
-
   private:
     mutable angle::SimpleMutex mMutex;
-    std::unordered_map<vk::DescriptorSetLayoutDesc, vk::DescriptorSetLayoutPtr> mPayload;
-    CacheStats mCacheStats;
+    angle::ConcurrentReadMap<vk::DescriptorSetLayoutDesc, vk::DescriptorSetLayoutPtr> mPayload;
 };
 
-class PipelineLayoutCache final : public HasCacheStats<VulkanCacheType::PipelineLayout>
+class PipelineLayoutCache final : public HasConcurrentCacheStats<VulkanCacheType::PipelineLayout>
 {
   public:
     PipelineLayoutCache();
@@ -2836,7 +2983,7 @@ class PipelineLayoutCache final : public HasCacheStats<VulkanCacheType::Pipeline
 
   private:
     mutable angle::SimpleMutex mMutex;
-    std::unordered_map<vk::PipelineLayoutDesc, vk::PipelineLayoutPtr> mPayload;
+    angle::ConcurrentReadMap<vk::PipelineLayoutDesc, vk::PipelineLayoutPtr> mPayload;
 };
 
 class SamplerCache final : public HasCacheStats<VulkanCacheType::Sampler>
@@ -2897,15 +3044,12 @@ class DescriptorSetCache final : angle::NonCopyable
 
     void clear() { mPayload.clear(); }
 
-    bool getDescriptorSet(const vk::DescriptorSetDesc &desc, T *descriptorSetOut) const
+    // Returns nullptr if desc is not in the cache.  The returned pointer is invalidated by the next
+    // insertion or erasure.
+    const T *getDescriptorSet(const vk::DescriptorSetDesc &desc) const
     {
         auto iter = mPayload.find(desc);
-        if (iter != mPayload.end())
-        {
-            *descriptorSetOut = iter->second;
-            return true;
-        }
-        return false;
+        return iter != mPayload.end() ? &iter->second : nullptr;
     }
 
     void insertDescriptorSet(const vk::DescriptorSetDesc &desc, const T &descriptorSetHelper)
@@ -2936,6 +3080,28 @@ class DescriptorSetCache final : angle::NonCopyable
         return false;
     }
 
+    // Erases every entry for which predicate(T &) returns true, in a single pass over the cache.
+    // The predicate may release what the entry holds before returning true.  Returns the number of
+    // erased entries.
+    template <typename Predicate>
+    size_t eraseDescriptorSetsIf(Predicate predicate)
+    {
+        size_t erasedCount = 0;
+        for (auto iter = mPayload.begin(); iter != mPayload.end();)
+        {
+            if (predicate(iter->second))
+            {
+                mPayload.erase(iter++);
+                ++erasedCount;
+            }
+            else
+            {
+                ++iter;
+            }
+        }
+        return erasedCount;
+    }
+
     size_t getTotalCacheSize() const { return mPayload.size(); }
 
     size_t getTotalCacheKeySizeBytes() const
@@ -1174,6 +1174,27 @@ gl::Box MakeUpdateBoundingBox(const Offset &offset,
     return updateBoundingBox;
 }
 
+// Whether two buffer to image copy regions write to a common part of the image.
+bool DoBufferImageCopyRegionsOverlap(const VkBufferImageCopy &region,
+                                     const VkBufferImageCopy &otherRegion)
+{
+    if ((region.imageSubresource.aspectMask & otherRegion.imageSubresource.aspectMask) == 0)
+    {
+        return false;
+    }
+
+    const gl::Box box      = MakeUpdateBoundingBox(region.imageOffset, region.imageExtent,
+                                                   region.imageSubresource.baseArrayLayer,
+                                                   region.imageSubresource.layerCount);
+    const gl::Box otherBox = MakeUpdateBoundingBox(otherRegion.imageOffset, otherRegion.imageExtent,
+                                                   otherRegion.imageSubresource.baseArrayLayer,
+                                                   otherRegion.imageSubresource.layerCount);
+
+    return box.x < otherBox.x + otherBox.width && otherBox.x < box.x + box.width &&
+           box.y < otherBox.y + otherBox.height && otherBox.y < box.y + box.height &&
+           box.z < otherBox.z + otherBox.depth && otherBox.z < box.z + box.depth;
+}
+
 angle::Result InitDynamicDescriptorPool(ErrorContext *context,
                                         const DescriptorSetLayoutDesc &descriptorSetLayoutDesc,
                                         const DescriptorSetLayout &descriptorSetLayout,
@@ -1808,9 +1829,9 @@ CommandBufferHelperCommon::CommandBufferHelperCommon()
 
 CommandBufferHelperCommon::~CommandBufferHelperCommon() {}
 
-void CommandBufferHelperCommon::initializeImpl()
+void CommandBufferHelperCommon::initializeImpl(ErrorContext *context)
 {
-    mCommandAllocator.init();
+    mCommandAllocator.init(context->getRenderer()->getCommandMemorySlabPool());
 }
 
 void CommandBufferHelperCommon::resetImpl(ErrorContext *context)
@@ -2082,7 +2103,7 @@ OutsideRenderPassCommandBufferHelper::~OutsideRenderPassCommandBufferHelper() {}
 
 angle::Result OutsideRenderPassCommandBufferHelper::initialize(ErrorContext *context)
 {
-    initializeImpl();
+    initializeImpl(context);
     return initializeCommandBuffer(context);
 }
 angle::Result OutsideRenderPassCommandBufferHelper::initializeCommandBuffer(ErrorContext *context)
@@ -2184,6 +2205,11 @@ angle::Result OutsideRenderPassCommandBufferHelper::flushToPrimary(Context *cont
 
     ANGLE_TRY(endCommandBuffer(context));
     ASSERT(mIsCommandBufferEnded);
+    if (renderer->getFeatures().elideRedundantSecondaryCommands.enabled)
+    {
+        context->getPerfCounters().elidedSecondaryCommands +=
+            mCommandBuffer.elideRedundantCommands();
+    }
     mCommandBuffer.executeCommands(&commandsState->primaryCommands);
 
     // Call VkCmdSetEvent to track the completion of this renderPass.
@@ -2347,7 +2373,7 @@ RenderPassCommandBufferHelper::~RenderPassCommandBufferHelper() {}
 
 angle::Result RenderPassCommandBufferHelper::initialize(ErrorContext *context)
 {
-    initializeImpl();
+    initializeImpl(context);
     return initializeCommandBuffer(context);
 }
 angle::Result RenderPassCommandBufferHelper::initializeCommandBuffer(ErrorContext *context)
@@ -3300,6 +3326,11 @@ angle::Result RenderPassCommandBufferHelper::flushToPrimary(Context *context,
             ASSERT(!context->getFeatures().preferDynamicRendering.enabled);
             primary.nextSubpass(kSubpassContents);
         }
+        if (renderer->getFeatures().elideRedundantSecondaryCommands.enabled)
+        {
+            context->getPerfCounters().elidedSecondaryCommands +=
+                mCommandBuffers[subpass].elideRedundantCommands();
+        }
         mCommandBuffers[subpass].executeCommands(&primary);
     }
 
@@ -3645,7 +3676,8 @@ DynamicBuffer::DynamicBuffer()
       mSize(0),
       mSizeInRecentHistory(0),
       mAlignment(0),
-      mMemoryPropertyFlags(0)
+      mMemoryPropertyFlags(0),
+      mCurrentBufferGeneration(0)
 {}
 
 DynamicBuffer::DynamicBuffer(DynamicBuffer &&other)
@@ -3658,6 +3690,7 @@ DynamicBuffer::DynamicBuffer(DynamicBuffer &&other)
       mSizeInRecentHistory(other.mSizeInRecentHistory),
       mAlignment(other.mAlignment),
       mMemoryPropertyFlags(other.mMemoryPropertyFlags),
+      mCurrentBufferGeneration(other.mCurrentBufferGeneration),
       mInFlightBuffers(std::move(other.mInFlightBuffers)),
       mBufferFreeList(std::move(other.mBufferFreeList))
 {}
@@ -3809,6 +3842,7 @@ angle::Result DynamicBuffer::allocate(Context *context,
     ASSERT(mBuffer->getBlockMemorySize() == mSize);
 
     mNextAllocationOffset = 0;
+    ++mCurrentBufferGeneration;
 
     ASSERT(mBuffer != nullptr);
     mBuffer->setSuballocationOffsetAndSize(mNextAllocationOffset, sizeToAllocate);
@@ -4451,14 +4485,14 @@ void DescriptorPoolHelper::destroyGarbage()
 }
 
 // DynamicDescriptorPool implementation.
-DynamicDescriptorPool::DynamicDescriptorPool() : mCachedDescriptorSetLayout(VK_NULL_HANDLE)
+DynamicDescriptorPool::DynamicDescriptorPool()
+    : mCachedDescriptorSetLayout(VK_NULL_HANDLE), mLastEvictionFrame(0)
 {
     mDescriptorPools.reserve(32);
 }
 
 DynamicDescriptorPool::~DynamicDescriptorPool()
 {
-    ASSERT(mLRUList.empty());
     ASSERT(mDescriptorSetCache.empty());
     ASSERT(mDescriptorPools.empty());
 }
@@ -4474,8 +4508,8 @@ DynamicDescriptorPool &DynamicDescriptorPool::operator=(DynamicDescriptorPool &&
     std::swap(mDescriptorPools, other.mDescriptorPools);
     std::swap(mPoolSizes, other.mPoolSizes);
     std::swap(mCachedDescriptorSetLayout, other.mCachedDescriptorSetLayout);
-    std::swap(mLRUList, other.mLRUList);
     std::swap(mDescriptorSetCache, other.mDescriptorSetCache);
+    std::swap(mLastEvictionFrame, other.mLastEvictionFrame);
     return *this;
 }
 
@@ -4502,16 +4536,12 @@ angle::Result DynamicDescriptorPool::init(ErrorContext *context,
 
 void DynamicDescriptorPool::destroy(VkDevice device)
 {
-    // Destroy cache
-    mDescriptorSetCache.clear();
-
-    // Destroy LRU list and SharedDescriptorSetCacheKey.
-    for (auto it = mLRUList.begin(); it != mLRUList.end();)
-    {
-        (it->sharedCacheKey)->destroy(device);
-        it = mLRUList.erase(it);
-    }
-    ASSERT(mLRUList.empty());
+    // Destroy cache and SharedDescriptorSetCacheKey.
+    mDescriptorSetCache.eraseDescriptorSetsIf([device](DescriptorSetCacheEntry &entry) {
+        entry.sharedCacheKey->destroy(device);
+        return true;
+    });
+    ASSERT(mDescriptorSetCache.empty());
 
     for (DescriptorPoolPointer &pool : mDescriptorPools)
     {
@@ -4561,54 +4591,36 @@ bool DynamicDescriptorPool::evictStaleDescriptorSets(Renderer *renderer,
                                                      uint32_t currentFrame)
 {
     ASSERT(oldestFrameToKeep < currentFrame);
-    size_t descriptorSetEvicted = 0;
-    // Walk LRU list backwards from oldest to most recent, evict anything that earlier than
-    // oldestFrameIDToKeep.
-    auto it = mLRUList.rbegin();
-    while (it != mLRUList.rend())
+    if (mLastEvictionFrame == currentFrame)
     {
-        DescriptorSetPointer &descriptorSet = it->descriptorSet;
-        if (descriptorSet.unique())
-        {
-            // Stop if it is recently being used.
-            if (descriptorSet->getLastUsedFrame() > oldestFrameToKeep)
-            {
-                break;
-            }
-            // Stop if GPU is still busy
-            if (!renderer->hasResourceUseFinished(descriptorSet->getResourceUse()))
+        return false;
+    }
+    mLastEvictionFrame = currentFrame;
+
+    // Evict every descriptorSet that is not bound to any program, has not been used since
+    // oldestFrameToKeep and is GPU completed, in one pass over the cache.
+    VkDevice device                   = renderer->getDevice();
+    const size_t descriptorSetEvicted = mDescriptorSetCache.eraseDescriptorSetsIf(
+        [this, renderer, device, oldestFrameToKeep](DescriptorSetCacheEntry &entry) {
+            DescriptorSetPointer &descriptorSet = entry.descriptorSet;
+            if (!descriptorSet.unique() ||
+                descriptorSet->getLastUsedFrame() > oldestFrameToKeep ||
+                !renderer->hasResourceUseFinished(descriptorSet->getResourceUse()))
             {
-                break;
+                return false;
             }
-            // Evict it from the cache and remove it from LRU list.
-            bool removed = mDescriptorSetCache.eraseDescriptorSet(it->sharedCacheKey->getDesc());
-            ASSERT(removed);
+
             // Invalidate the sharedCacheKey so that they could be reused.
-            it->sharedCacheKey->destroy(renderer->getDevice());
-            ASSERT(!it->sharedCacheKey->valid());
+            entry.sharedCacheKey->destroy(device);
+            ASSERT(!entry.sharedCacheKey->valid());
 
-            // Note that erase it from LRU list will "destroy" descriptorSet. Since we
-            // never actually destroy descriptorSet, it will just add to the garbage list. Here we
-            // want more explicit control to add it to the front of list (because we know it is
-            // already GPU completed) instead to the end of the list, so we do it explicitly.
+            // Since the descriptorSet is already GPU completed, add it to the finished garbage
+            // list directly so it can be recycled right away.
             DescriptorPoolWeakPointer pool = descriptorSet->getPool();
             pool->addFinishedGarbage(std::move(descriptorSet));
-            descriptorSetEvicted++;
-
-            // This should destroy descriptorSet, which is already invalid;
-            it = decltype(it)(mLRUList.erase(std::next(it).base()));
             mCacheStats.decrementSize();
-        }
-        else
-        {
-            // It means it is still bound to one of the programs. Move it to the front of the LRU
-            // list to avoid repeatedly hitting it for every eviction.
-            mLRUList.splice(mLRUList.begin(), mLRUList, std::next(it).base());
-            ++it;
-            // Update to currentFrame to maintain LRU order
-            descriptorSet->updateLastUsedFrame(currentFrame);
-        }
-    }
+            return true;
+        });
 
     if (descriptorSetEvicted > 0)
     {
@@ -4661,13 +4673,12 @@ angle::Result DynamicDescriptorPool::getOrAllocateDescriptorSet(
     bool success;
 
     // First scan the descriptorSet cache.
-    DescriptorSetLRUListIterator listIterator;
-    if (mDescriptorSetCache.getDescriptorSet(desc, &listIterator))
+    const DescriptorSetCacheEntry *cacheEntry = mDescriptorSetCache.getDescriptorSet(desc);
+    if (cacheEntry != nullptr)
     {
-        *descriptorSetOut = listIterator->descriptorSet;
+        // The frame it is used in is recorded when it is bound.
+        *descriptorSetOut = cacheEntry->descriptorSet;
         (*newSharedCacheKeyOut).reset();
-        // Move it to the front of the LRU list.
-        mLRUList.splice(mLRUList.begin(), mLRUList, listIterator);
         mCacheStats.hit();
         return angle::Result::Continue;
     }
@@ -4708,9 +4719,7 @@ angle::Result DynamicDescriptorPool::getOrAllocateDescriptorSet(
     // when it destroys the pool.
     SharedDescriptorSetCacheKey sharedCacheKey = CreateSharedDescriptorSetCacheKey(desc, this);
 
-    // Add to the front of the LRU list and add list iterator to the cache
-    mLRUList.push_front({sharedCacheKey, *descriptorSetOut});
-    mDescriptorSetCache.insertDescriptorSet(desc, mLRUList.begin());
+    mDescriptorSetCache.insertDescriptorSet(desc, {sharedCacheKey, *descriptorSetOut});
     mCacheStats.missAndIncrementSize();
 
     *newSharedCacheKeyOut = sharedCacheKey;
@@ -4738,13 +4747,12 @@ void DynamicDescriptorPool::releaseCachedDescriptorSet(Renderer *renderer,
                                                        const DescriptorSetDesc &desc)
 {
     ASSERT(renderer->getFeatures().descriptorSetCache.enabled);
-    DescriptorSetLRUListIterator listIter;
+    DescriptorSetCacheEntry cacheEntry;
     // Remove from the cache hash map. Note that we can't delete it until refcount goes to 0
-    if (mDescriptorSetCache.eraseDescriptorSet(desc, &listIter))
+    if (mDescriptorSetCache.eraseDescriptorSet(desc, &cacheEntry))
     {
-        DescriptorSetPointer descriptorSet = std::move(listIter->descriptorSet);
+        DescriptorSetPointer descriptorSet = std::move(cacheEntry.descriptorSet);
         mCacheStats.decrementSize();
-        mLRUList.erase(listIter);
 
         if (descriptorSet.unique())
         {
@@ -4758,13 +4766,12 @@ void DynamicDescriptorPool::destroyCachedDescriptorSet(Renderer *renderer,
                                                        const DescriptorSetDesc &desc)
 {
     ASSERT(renderer->getFeatures().descriptorSetCache.enabled);
-    DescriptorSetLRUListIterator listIter;
+    DescriptorSetCacheEntry cacheEntry;
     // Remove from the cache hash map. Note that we can't delete it until refcount goes to 0
-    if (mDescriptorSetCache.eraseDescriptorSet(desc, &listIter))
+    if (mDescriptorSetCache.eraseDescriptorSet(desc, &cacheEntry))
     {
-        DescriptorSetPointer descriptorSet = std::move(listIter->descriptorSet);
+        DescriptorSetPointer descriptorSet = std::move(cacheEntry.descriptorSet);
         mCacheStats.decrementSize();
-        mLRUList.erase(listIter);
 
         if (descriptorSet.unique())
         {
@@ -4837,8 +4844,7 @@ void DynamicDescriptorPool::checkAndDestroyUnusedPool(Renderer *renderer)
 // For ASSERT only
 bool DynamicDescriptorPool::hasCachedDescriptorSet(const DescriptorSetDesc &desc) const
 {
-    DescriptorSetLRUListIterator listIterator;
-    return mDescriptorSetCache.getDescriptorSet(desc, &listIterator);
+    return mDescriptorSetCache.getDescriptorSet(desc) != nullptr;
 }
 
 // For testing only!
@@ -9013,6 +9019,13 @@ angle::Result ImageHelper::stageSubresourceUpdateImpl(ContextVk *contextVk,
         }
     }
 
+    // Depth and stencil updates may only overwrite one aspect, so only color updates are used to
+    // drop the updates they supersede.
+    if (!storageFormat.hasDepthOrStencilBits())
+    {
+        pruneUpdatesSupersededByUpcomingUpdate(contextVk, index, offset, glExtents);
+    }
+
     std::unique_ptr<RefCounted<BufferHelper>> stagingBuffer =
         std::make_unique<RefCounted<BufferHelper>>();
     BufferHelper *currentBuffer = &stagingBuffer->get();
@@ -9022,6 +9035,7 @@ angle::Result ImageHelper::stageSubresourceUpdateImpl(ContextVk *contextVk,
     ANGLE_TRY(contextVk->initBufferForImageCopy(currentBuffer, allocationSize,
                                                 MemoryCoherency::CachedNonCoherent,
                                                 storageFormat.id, &stagingOffset, &stagingPointer));
+    contextVk->getPerfCounters().imageUpdateStagingBytes += allocationSize;
 
     loadFunctionInfo.loadFunction(
         contextVk->getImageLoadContext(), glExtents.width, glExtents.height, glExtents.depth,
@@ -10474,8 +10488,9 @@ angle::Result ImageHelper::flushStagedUpdatesImpl(ContextVk *contextVk,
             adjustLayerRange(*levelUpdates, &adjustedLayerStart, &adjustedLayerEnd);
         }
 
-        for (SubresourceUpdate &update : *levelUpdates)
+        for (size_t updateIndex = 0; updateIndex < levelUpdates->size(); ++updateIndex)
         {
+            SubresourceUpdate &update = (*levelUpdates)[updateIndex];
             ASSERT(IsClearOfAllChannels(update.updateSource) ||
                    (update.updateSource == UpdateSource::ClearPartial) ||
                    (update.updateSource == UpdateSource::Buffer &&
@@ -10550,6 +10565,34 @@ angle::Result ImageHelper::flushStagedUpdatesImpl(ContextVk *contextVk,
                 }
             }
 
+            // Consecutive buffer updates that don't overlap are applied with a single copy command,
+            // such as when the tiles of a texture are streamed.  The barrier is then checked for
+            // the union of their layers.
+            size_t coalescedUpdateCount = 0;
+            uint32_t barrierBaseLayer   = updateBaseLayer;
+            uint32_t barrierLayerEnd    = updateBaseLayer + updateLayerCount;
+            if (update.updateSource == UpdateSource::Buffer && !transCoding)
+            {
+                coalescedUpdateCount = getCoalescableBufferUpdateCount(
+                    *levelUpdates, updateIndex, adjustedLayerStart, adjustedLayerEnd);
+                for (size_t coalescedIndex = 1; coalescedIndex <= coalescedUpdateCount;
+                     ++coalescedIndex)
+                {
+                    SubresourceUpdate &coalescedUpdate =
+                        (*levelUpdates)[updateIndex + coalescedIndex];
+                    coalescedUpdate.data.buffer.copyRegion.imageSubresource.mipLevel =
+                        updateMipLevelVk.get();
+
+                    uint32_t coalescedBaseLayer, coalescedLayerCount;
+                    coalescedUpdate.getDestSubresource(mLayerCount, &coalescedBaseLayer,
+                                                       &coalescedLayerCount);
+                    barrierBaseLayer = std::min(barrierBaseLayer, coalescedBaseLayer);
+                    barrierLayerEnd =
+                        std::max(barrierLayerEnd, coalescedBaseLayer + coalescedLayerCount);
+                }
+            }
+            const uint32_t barrierLayerCount = barrierLayerEnd - barrierBaseLayer;
+
             // When a barrier is necessary when uploading updates to a level, we could instead move
             // to the next level and continue uploads in parallel.  Once all levels need a barrier,
             // a single barrier can be issued and we could continue with the rest of the updates
@@ -10557,24 +10600,24 @@ angle::Result ImageHelper::flushStagedUpdatesImpl(ContextVk *contextVk,
             // barrier might be needed if there are multiple updates in the same parts of the image.
             ImageLayout barrierLayout =
                 transCoding ? ImageLayout::TransferDstAndComputeWrite : ImageLayout::TransferDst;
-            if (updateLayerCount >= kMaxParallelLayerWrites)
+            if (barrierLayerCount >= kMaxParallelLayerWrites)
             {
                 // If there are more subresources than bits we can track, always insert a barrier.
                 recordWriteBarrier(contextVk, aspectFlags, barrierLayout, updateMipLevelGL, 1,
-                                   updateBaseLayer, updateLayerCount, commandBuffer);
+                                   barrierBaseLayer, barrierLayerCount, commandBuffer);
                 mSubresourcesWrittenSinceBarrier[updateMipLevelGL.get()].set();
             }
             else
             {
                 ImageLayerWriteMask subresourceHash =
-                    GetImageLayerWriteMask(updateBaseLayer, updateLayerCount);
+                    GetImageLayerWriteMask(barrierBaseLayer, barrierLayerCount);
 
                 if (areLevelSubresourcesWrittenWithinMaskRange(updateMipLevelGL.get(),
                                                                subresourceHash))
                 {
                     // If there's overlap in subresource upload, issue a barrier.
                     recordWriteBarrier(contextVk, aspectFlags, barrierLayout, updateMipLevelGL, 1,
-                                       updateBaseLayer, updateLayerCount, commandBuffer);
+                                       barrierBaseLayer, barrierLayerCount, commandBuffer);
                     mSubresourcesWrittenSinceBarrier[updateMipLevelGL.get()].reset();
                 }
                 mSubresourcesWrittenSinceBarrier[updateMipLevelGL.get()] |= subresourceHash;
@@ -10647,6 +10690,7 @@ angle::Result ImageHelper::flushStagedUpdatesImpl(ContextVk *contextVk,
 
                     CommandBufferAccess bufferAccess;
                     VkBufferImageCopy *copyRegion = &update.data.buffer.copyRegion;
+                    VkDeviceSize copySize         = currentBuffer->getSize();
 
                     if (transCoding && update.data.buffer.formatID != actualformat)
                     {
@@ -10661,19 +10705,61 @@ angle::Result ImageHelper::flushStagedUpdatesImpl(ContextVk *contextVk,
                         bufferAccess.onBufferTransferRead(currentBuffer);
                         ANGLE_TRY(contextVk->getOutsideRenderPassCommandBufferHelper(
                             bufferAccess, &commandBuffer));
+
+                        // The coalesced updates are suballocated from the same staging buffer,
+                        // which the command buffer acquired above can read without being flushed.
+                        // Their reads are recorded directly, so each suballocation is kept alive
+                        // until the copy is done.
+                        angle::FastVector<VkBufferImageCopy, 4> copyRegions;
+                        copyRegions.push_back(*copyRegion);
+                        for (size_t coalescedIndex = 1; coalescedIndex <= coalescedUpdateCount;
+                             ++coalescedIndex)
+                        {
+                            BufferHelper *coalescedBuffer =
+                                (*levelUpdates)[updateIndex + coalescedIndex]
+                                    .data.buffer.bufferHelper;
+                            ASSERT(coalescedBuffer->getBuffer().getHandle() ==
+                                   currentBuffer->getBuffer().getHandle());
+                            ANGLE_TRY(coalescedBuffer->flush(renderer));
+                            commandBuffer->bufferRead(contextVk, VK_ACCESS_TRANSFER_READ_BIT,
+                                                      PipelineStage::Transfer, coalescedBuffer);
+
+                            copyRegions.push_back(
+                                (*levelUpdates)[updateIndex + coalescedIndex]
+                                    .data.buffer.copyRegion);
+                            copySize += coalescedBuffer->getSize();
+                        }
+
                         commandBuffer->getCommandBuffer().copyBufferToImage(
-                            currentBuffer->getBuffer().getHandle(), mImage, getCurrentLayout(), 1,
-                            copyRegion);
+                            currentBuffer->getBuffer().getHandle(), mImage, getCurrentLayout(),
+                            static_cast<uint32_t>(copyRegions.size()), copyRegions.data());
+                        contextVk->getPerfCounters().coalescedBufferUpdates += coalescedUpdateCount;
                     }
                     bool commandBufferWasFlushed = false;
-                    ANGLE_TRY(contextVk->onCopyUpdate(currentBuffer->getSize(),
-                                                      &commandBufferWasFlushed));
+                    ANGLE_TRY(contextVk->onCopyUpdate(copySize, &commandBufferWasFlushed));
                     onWrite(updateMipLevelGL, 1, updateBaseLayer, updateLayerCount,
                             copyRegion->imageSubresource.aspectMask);
 
                     // Update total staging buffer size.
                     mTotalStagedBufferUpdateSize -= bufferUpdate.bufferHelper->getSize();
 
+                    for (size_t coalescedIndex = 1; coalescedIndex <= coalescedUpdateCount;
+                         ++coalescedIndex)
+                    {
+                        SubresourceUpdate &coalescedUpdate =
+                            (*levelUpdates)[updateIndex + coalescedIndex];
+
+                        uint32_t coalescedBaseLayer, coalescedLayerCount;
+                        coalescedUpdate.getDestSubresource(mLayerCount, &coalescedBaseLayer,
+                                                           &coalescedLayerCount);
+                        onWrite(updateMipLevelGL, 1, coalescedBaseLayer, coalescedLayerCount,
+                                coalescedUpdate.data.buffer.copyRegion.imageSubresource.aspectMask);
+
+                        mTotalStagedBufferUpdateSize -=
+                            coalescedUpdate.data.buffer.bufferHelper->getSize();
+                        coalescedUpdate.release(renderer);
+                    }
+
                     if (commandBufferWasFlushed)
                     {
                         ANGLE_TRY(
@@ -10705,6 +10791,9 @@ angle::Result ImageHelper::flushStagedUpdatesImpl(ContextVk *contextVk,
             }
 
             update.release(renderer);
+
+            // Skip over the updates that were applied along with this one.
+            updateIndex += coalescedUpdateCount;
         }
 
         // Only remove the updates that were actually applied to the image.
@@ -10893,6 +10982,59 @@ void ImageHelper::adjustLayerRange(const SubresourceUpdates &levelUpdates,
     }
 }
 
+size_t ImageHelper::getCoalescableBufferUpdateCount(const SubresourceUpdates &levelUpdates,
+                                                    size_t firstUpdateIndex,
+                                                    uint32_t layerStart,
+                                                    uint32_t layerEnd) const
+{
+    // Keeps the copy command within a few command blocks, and the overlap checks cheap.
+    constexpr size_t kMaxCoalescedUpdateCount = 64;
+
+    const SubresourceUpdate &firstUpdate = levelUpdates[firstUpdateIndex];
+    ASSERT(firstUpdate.updateSource == UpdateSource::Buffer);
+    const VkBuffer srcBuffer = firstUpdate.data.buffer.bufferHelper->getBuffer().getHandle();
+
+    size_t coalescedUpdateCount = 0;
+    for (size_t updateIndex = firstUpdateIndex + 1;
+         updateIndex < levelUpdates.size() && coalescedUpdateCount < kMaxCoalescedUpdateCount;
+         ++updateIndex)
+    {
+        // Only updates from ANGLE's own staging buffers are coalesced, and only when they are
+        // suballocated from the same VkBuffer as the first update.  These are only written by the
+        // host, so reading them never requires the command buffer they are copied in to be
+        // flushed, and the caller records their reads without going through the context.
+        const SubresourceUpdate &update = levelUpdates[updateIndex];
+        if (update.updateSource != UpdateSource::Buffer || update.refCounted.buffer == nullptr ||
+            update.data.buffer.bufferHelper->getBuffer().getHandle() != srcBuffer ||
+            !isDataFormatMatchForCopy(update.data.buffer.formatID))
+        {
+            break;
+        }
+
+        uint32_t updateBaseLayer, updateLayerCount;
+        update.getDestSubresource(mLayerCount, &updateBaseLayer, &updateLayerCount);
+        if (updateBaseLayer + updateLayerCount <= layerStart || updateBaseLayer >= layerEnd)
+        {
+            break;
+        }
+
+        // The regions of a copy command must not overlap.  Overlapping updates are applied in
+        // order, separated by a barrier, unless the later one is found to supersede the other.
+        for (size_t previousIndex = firstUpdateIndex; previousIndex < updateIndex; ++previousIndex)
+        {
+            if (DoBufferImageCopyRegionsOverlap(levelUpdates[previousIndex].data.buffer.copyRegion,
+                                                update.data.buffer.copyRegion))
+            {
+                return coalescedUpdateCount;
+            }
+        }
+
+        ++coalescedUpdateCount;
+    }
+
+    return coalescedUpdateCount;
+}
+
 gl::LevelIndex ImageHelper::getLastAllocatedLevel() const
 {
     return mFirstAllocatedLevel + mLevelCount - 1;
@@ -11181,6 +11323,48 @@ void ImageHelper::pruneSupersededUpdatesForLevelImpl(ContextVk *contextVk,
     ASSERT(validateSubresourceUpdateRefCountsConsistent());
 }
 
+void ImageHelper::pruneUpdatesSupersededByUpcomingUpdate(ContextVk *contextVk,
+                                                         const gl::ImageIndex &index,
+                                                         const gl::Offset &offset,
+                                                         const gl::Extents &glExtents)
+{
+    // The extents of the staged clears are not known until the image is created.
+    const gl::LevelIndex updateLevelGL(index.getLevelIndex());
+    SubresourceUpdates *levelUpdates = getLevelUpdates(updateLevelGL);
+    if (!valid() || levelUpdates == nullptr || levelUpdates->empty())
+    {
+        return;
+    }
+
+    const uint32_t layerIndex     = index.hasLayer() ? index.getLayerIndex() : 0;
+    const uint32_t layerCount     = index.getLayerCount();
+    const bool isArray            = gl::IsArrayTextureType(index.getType());
+    const uint32_t baseArrayLayer = isArray ? offset.z : layerIndex;
+    const gl::Box updateBoundingBox =
+        MakeUpdateBoundingBox(offset, glExtents, baseArrayLayer, layerCount);
+
+    // Going through all staged updates is only worth it if the most recent one is overwritten,
+    // which is the case when the same tile, or the whole level, is repeatedly updated.
+    const SubresourceUpdate &lastUpdate = levelUpdates->back();
+    if (lastUpdate.updateSource != UpdateSource::Buffer)
+    {
+        return;
+    }
+
+    uint32_t lastUpdateBaseLayer, lastUpdateLayerCount;
+    lastUpdate.getDestSubresource(mLayerCount, &lastUpdateBaseLayer, &lastUpdateLayerCount);
+    const VkBufferImageCopy &lastCopyRegion = lastUpdate.data.buffer.copyRegion;
+    const gl::Box lastUpdateBoundingBox =
+        MakeUpdateBoundingBox(lastCopyRegion.imageOffset, lastCopyRegion.imageExtent,
+                              lastUpdateBaseLayer, lastUpdateLayerCount);
+    if (!updateBoundingBox.contains(lastUpdateBoundingBox))
+    {
+        return;
+    }
+
+    pruneSupersededUpdatesForLevelImpl(contextVk, updateLevelGL, updateBoundingBox);
+}
+
 void ImageHelper::removeSupersededUpdates(ContextVk *contextVk,
                                           const gl::TexLevelMask skipLevelsAllFaces)
 {
@@ -271,6 +271,11 @@ class DynamicBuffer : angle::NonCopyable
 
     BufferHelper *getCurrentBuffer() const { return mBuffer.get(); }
 
+    // Incremented every time the current buffer is replaced.  A region allocated from the current
+    // buffer is not handed out again as long as this does not change, even if the same buffer is
+    // later recycled.
+    uint64_t getCurrentBufferGeneration() const { return mCurrentBufferGeneration; }
+
     // **Accumulate** an alignment requirement.  A dynamic buffer is used as the staging buffer for
     // image uploads, which can contain updates to unrelated mips, possibly with different formats.
     // The staging buffer should have an alignment that can satisfy all those formats, i.e. it's the
@@ -301,6 +306,7 @@ class DynamicBuffer : angle::NonCopyable
     size_t mSizeInRecentHistory;
     size_t mAlignment;
     VkMemoryPropertyFlags mMemoryPropertyFlags;
+    uint64_t mCurrentBufferGeneration;
 
     BufferHelperQueue mInFlightBuffers;
     BufferHelperQueue mBufferFreeList;
@@ -513,18 +519,20 @@ class DynamicDescriptorPool final : angle::NonCopyable
     // descriptor count is accurate and new pools are created appropriately.
     VkDescriptorSetLayout mCachedDescriptorSetLayout;
 
-    // LRU list for cache eviction: most recent used at front, least used at back.
-    struct DescriptorSetLRUEntry
+    // Cache entries don't keep an LRU order.  The frame a descriptorSet was last bound in is
+    // recorded in the descriptorSet itself, and eviction sweeps all the entries of past frames at
+    // once.
+    struct DescriptorSetCacheEntry
     {
         SharedDescriptorSetCacheKey sharedCacheKey;
         DescriptorSetPointer descriptorSet;
     };
-    using DescriptorSetLRUList         = std::list<DescriptorSetLRUEntry>;
-    using DescriptorSetLRUListIterator = DescriptorSetLRUList::iterator;
-    DescriptorSetLRUList mLRUList;
     // Tracks cache for descriptorSet. Note that cached DescriptorSet can be reuse even if it is GPU
     // busy.
-    DescriptorSetCache<DescriptorSetLRUListIterator> mDescriptorSetCache;
+    DescriptorSetCache<DescriptorSetCacheEntry> mDescriptorSetCache;
+    // The frame of the last eviction sweep.  The cache is swept at most once per frame, as the
+    // descriptorSets a sweep keeps are unlikely to become evictable before the next frame.
+    uint32_t mLastEvictionFrame;
     // Statistics for the cache.
     CacheStats mCacheStats;
 };
@@ -1563,11 +1571,14 @@ class CommandBufferHelperCommon : angle::NonCopyable
         mAcquireNextImageSemaphore.setHandle(semaphore);
     }
 
+    // Size of the command memory held by this command buffer.
+    size_t getCommandMemorySize() const { return mCommandAllocator.getMemorySize(); }
+
   protected:
     CommandBufferHelperCommon();
     ~CommandBufferHelperCommon();
 
-    void initializeImpl();
+    void initializeImpl(ErrorContext *context);
 
     void resetImpl(ErrorContext *context);
 
@@ -3280,6 +3291,12 @@ class ImageHelper final : public Resource, public angle::Subject
     void pruneSupersededUpdatesForLevelImpl(ContextVk *contextVk,
                                             const gl::LevelIndex level,
                                             const gl::Box &upcomingUpdateBoundingBox);
+    // Called before staging an update, drops the staged updates that it completely overwrites so
+    // that their staging memory can be reused for it.
+    void pruneUpdatesSupersededByUpcomingUpdate(ContextVk *contextVk,
+                                                const gl::ImageIndex &index,
+                                                const gl::Offset &offset,
+                                                const gl::Extents &glExtents);
 
     // Whether there are any updates in [start, end).
     bool hasStagedUpdatesInLevels(gl::LevelIndex levelStart, gl::LevelIndex levelEnd) const;
@@ -3386,6 +3403,14 @@ class ImageHelper final : public Resource, public angle::Subject
                           uint32_t *layerStart,
                           uint32_t *layerEnd);
 
+    // Returns the number of buffer updates following |firstUpdateIndex| in |levelUpdates| that can
+    // be applied with the same copy command.  They must be copied from the same buffer to regions
+    // that don't overlap, and be in the [layerStart, layerEnd) range.
+    size_t getCoalescableBufferUpdateCount(const SubresourceUpdates &levelUpdates,
+                                           size_t firstUpdateIndex,
+                                           uint32_t layerStart,
+                                           uint32_t layerEnd) const;
+
     // Vulkan objects.
     Image mImage;
     DeviceMemory mDeviceMemory;
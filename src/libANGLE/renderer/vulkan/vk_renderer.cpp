@@ -14,6 +14,7 @@
 #include "libANGLE/renderer/vulkan/vk_utils.h"
 
 #include <EGL/eglext.h>
+#include <cstdlib>
 #include <fstream>
 
 #include "common/debug.h"
@@ -2018,6 +2019,11 @@ Renderer::Renderer()
     {
         mPipelineCacheGraphDumpPath = kDefaultPipelineCacheGraphDumpPath;
     }
+
+    const std::string graphicsPipelineCacheMaxSize = angle::GetEnvironmentVarOrAndroidProperty(
+        "ANGLE_GRAPHICS_PIPELINE_CACHE_MAX_SIZE", "angle.graphics_pipeline_cache_max_size");
+    mGraphicsPipelineCacheMaxSize =
+        static_cast<uint32_t>(std::strtoul(graphicsPipelineCacheMaxSize.c_str(), nullptr, 10));
 }
 
 Renderer::~Renderer() {}
@@ -2067,6 +2073,9 @@ void Renderer::onDestroy(vk::ErrorContext *context)
     mOutsideRenderPassCommandBufferRecycler.onDestroy();
     mRenderPassCommandBufferRecycler.onDestroy();
 
+    trimCommandMemory();
+    mCommandMemorySlabPool.destroy();
+
     mImageMemorySuballocator.destroy(this);
     mAllocator.destroy();
 
@@ -6300,6 +6309,10 @@ void Renderer::initFeatures(const vk::ExtensionNameList &deviceExtensionNames,
 
     // Force enable sample usage for AHB images for Samsung
     ANGLE_FEATURE_CONDITION(&mFeatures, forceSampleUsageForAhbBackedImages, isSamsung);
+
+    // The extra pass over the CPU-side secondary command buffers only pays off when they contain
+    // redundant state, which drivers may already filter, so it is opt-in.
+    ANGLE_FEATURE_CONDITION(&mFeatures, elideRedundantSecondaryCommands, false);
 }
 
 void Renderer::appBasedFeatureOverrides(const vk::ExtensionNameList &extensions) {}
@@ -7075,6 +7088,21 @@ void Renderer::recycleRenderPassCommandBufferHelper(
     mRenderPassCommandBufferRecycler.recycleCommandBufferHelper(commandBuffer);
 }
 
+void Renderer::trimCommandMemory()
+{
+    mCommandMemorySlabPool.trimIdleSlabs(angle::GetCurrentSystemTime());
+
+    const vk::CommandMemorySlabPool::Statistics slabStats =
+        mCommandMemorySlabPool.getAndResetSlabCounts();
+
+    // Slabs reused from the free lists are hits, newly allocated ones are misses.
+    CacheStats stats;
+    stats.addHits(slabStats.reusedSlabCount);
+    stats.addMisses(slabStats.allocatedSlabCount);
+    stats.addEvictions(slabStats.trimmedSlabCount);
+    accumulateCacheStats(VulkanCacheType::CommandMemorySlabs, stats);
+}
+
 void Renderer::logCacheStats() const
 {
     if (!vk::kOutputCumulativePerfCounters)
@@ -7088,7 +7116,9 @@ void Renderer::logCacheStats() const
     INFO() << "Vulkan object cache hit ratios: ";
     for (const CacheStats &stats : mVulkanCacheStats)
     {
-        INFO() << "    CacheType " << cacheType++ << ": " << stats.getHitRatio();
+        INFO() << "    CacheType " << cacheType++ << ": " << stats.getHitRatio()
+               << " (lock contended " << stats.getLockContentionCount() << " times, "
+               << stats.getEvictionCount() << " evictions)";
     }
 }
 
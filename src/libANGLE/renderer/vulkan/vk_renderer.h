@@ -499,6 +499,11 @@ class Renderer : angle::NonCopyable
     // Log cache stats for all caches
     void logCacheStats() const;
 
+    vk::CommandMemorySlabPool *getCommandMemorySlabPool() { return &mCommandMemorySlabPool; }
+    // Frees the command memory that has not been used for a while, and accumulates the stats of
+    // the command memory slabs.
+    void trimCommandMemory();
+
     VkPipelineStageFlags getSupportedBufferWritePipelineStageMask() const
     {
         return mSupportedBufferWritePipelineStageMask;
@@ -680,6 +685,10 @@ class Renderer : angle::NonCopyable
         return mPipelineCacheGraphDumpPath.c_str();
     }
 
+    // The number of complete graphics pipelines each program may keep in its caches, or 0 if the
+    // caches are not bounded.
+    uint32_t getGraphicsPipelineCacheMaxSize() const { return mGraphicsPipelineCacheMaxSize; }
+
     vk::RefCountedEventRecycler *getRefCountedEventRecycler() { return &mRefCountedEventRecycler; }
 
     std::thread::id getCleanUpThreadId() const { return mCleanUpThread.getThreadId(); }
@@ -1002,6 +1011,10 @@ class Renderer : angle::NonCopyable
     // Async cleanup thread
     vk::CleanUpThread mCleanUpThread;
 
+    // Memory of the command buffers, shared by all contexts.  Declared before the recyclers, as
+    // the command buffer helpers return their memory to it when destroyed.
+    vk::CommandMemorySlabPool mCommandMemorySlabPool;
+
     // Command buffer pool management.
     vk::CommandBufferRecycler<vk::OutsideRenderPassCommandBufferHelper>
         mOutsideRenderPassCommandBufferRecycler;
@@ -1066,6 +1079,10 @@ class Renderer : angle::NonCopyable
     bool mDumpPipelineCacheGraph;
     std::string mPipelineCacheGraphDumpPath;
 
+    // Set through ANGLE_GRAPHICS_PIPELINE_CACHE_MAX_SIZE.  Least recently used pipelines are
+    // evicted past this many.
+    uint32_t mGraphicsPipelineCacheMaxSize;
+
     // A placeholder descriptor set layout handle for layouts with no bindings.
     vk::DescriptorSetLayoutPtr mPlaceHolderDescriptorSetLayout;
 
@@ -73,8 +73,11 @@ angle::Result ProgramExecutableWgpu::updateUniformsAndGetBindGroup(ContextWgpu *
         uint8_t *bufferData = defaultUniformBuffer.getMapWritePointer(0, requiredSpace);
         for (gl::ShaderType shaderType : mExecutable->getLinkedShaderStages())
         {
-            const angle::MemoryBuffer &uniformData = mDefaultUniformBlocks[shaderType]->uniformData;
+            // A new buffer is created for every update, so the whole block is copied.
+            BufferAndLayout &uniformBlock          = *mDefaultUniformBlocks[shaderType];
+            const angle::MemoryBuffer &uniformData = uniformBlock.uniformData;
             memcpy(&bufferData[offsets[shaderType]], uniformData.data(), uniformData.size());
+            uniformBlock.dirtyRanges.reset();
             mDefaultUniformBlocksDirty.reset(shaderType);
         }
         ANGLE_TRY(defaultUniformBuffer.unmap());
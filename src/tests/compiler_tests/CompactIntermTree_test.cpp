@@ -0,0 +1,241 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// CompactIntermTree_test.cpp:
+//   Tests that the compact tree mirrors the structure of the AST it is built from.
+//
+
+#include "compiler/translator/tree_util/CompactIntermTree.h"
+
+#include "angle_gl.h"
+#include "compiler/translator/Symbol.h"
+#include "compiler/translator/tree_util/IntermTraverse.h"
+#include "gtest/gtest.h"
+#include "tests/test_utils/ShaderCompileTreeTest.h"
+
+using namespace sh;
+
+namespace
+{
+
+// Records the nodes in the order in which a traverser visits them before their children.
+class NodeOrderTraverser : public TIntermTraverser
+{
+  public:
+    NodeOrderTraverser() : TIntermTraverser(true, false, false) {}
+
+    void visitSymbol(TIntermSymbol *node) override { mNodes.push_back(node); }
+    void visitConstantUnion(TIntermConstantUnion *node) override { mNodes.push_back(node); }
+    void visitFunctionPrototype(TIntermFunctionPrototype *node) override
+    {
+        mNodes.push_back(node);
+    }
+    void visitPreprocessorDirective(TIntermPreprocessorDirective *node) override
+    {
+        mNodes.push_back(node);
+    }
+    bool visitSwizzle(Visit visit, TIntermSwizzle *node) override { return record(node); }
+    bool visitBinary(Visit visit, TIntermBinary *node) override { return record(node); }
+    bool visitUnary(Visit visit, TIntermUnary *node) override { return record(node); }
+    bool visitTernary(Visit visit, TIntermTernary *node) override { return record(node); }
+    bool visitIfElse(Visit visit, TIntermIfElse *node) override { return record(node); }
+    bool visitSwitch(Visit visit, TIntermSwitch *node) override { return record(node); }
+    bool visitCase(Visit visit, TIntermCase *node) override { return record(node); }
+    bool visitFunctionDefinition(Visit visit, TIntermFunctionDefinition *node) override
+    {
+        return record(node);
+    }
+    bool visitAggregate(Visit visit, TIntermAggregate *node) override { return record(node); }
+    bool visitBlock(Visit visit, TIntermBlock *node) override { return record(node); }
+    bool visitGlobalQualifierDeclaration(Visit visit,
+                                         TIntermGlobalQualifierDeclaration *node) override
+    {
+        return record(node);
+    }
+    bool visitDeclaration(Visit visit, TIntermDeclaration *node) override { return record(node); }
+    bool visitLoop(Visit visit, TIntermLoop *node) override { return record(node); }
+    bool visitBranch(Visit visit, TIntermBranch *node) override { return record(node); }
+
+    const std::vector<TIntermNode *> &getNodes() const { return mNodes; }
+
+  private:
+    bool record(TIntermNode *node)
+    {
+        mNodes.push_back(node);
+        return true;
+    }
+
+    std::vector<TIntermNode *> mNodes;
+};
+
+class CompactIntermTreeTest : public ShaderCompileTreeTest
+{
+  public:
+    CompactIntermTreeTest() {}
+
+  protected:
+    ::GLenum getShaderType() const override { return GL_FRAGMENT_SHADER; }
+    ShShaderSpec getShaderSpec() const override { return SH_GLES3_1_SPEC; }
+
+    // Checks the links of every node of the compact tree against the AST.
+    void checkStructure(const CompactIntermTree &tree)
+    {
+        NodeOrderTraverser traverser;
+        mASTRoot->traverse(&traverser);
+
+        const std::vector<TIntermNode *> &expectedNodes = traverser.getNodes();
+        ASSERT_EQ(expectedNodes.size(), tree.size());
+        EXPECT_EQ(mASTRoot, tree.getNode(CompactIntermTree::kRootIndex));
+        EXPECT_EQ(CompactIntermTree::kInvalidIndex, tree.getParent(CompactIntermTree::kRootIndex));
+        EXPECT_EQ(tree.size(), tree.getSubtreeEnd(CompactIntermTree::kRootIndex));
+
+        for (CompactIntermTree::NodeIndex index = 0; index < tree.size(); ++index)
+        {
+            TIntermNode *node = tree.getNode(index);
+            ASSERT_EQ(expectedNodes[index], node);
+
+            size_t childIndex = 0;
+            for (CompactIntermTree::NodeIndex child = tree.getFirstChild(index);
+                 child != CompactIntermTree::kInvalidIndex; child = tree.getNextSibling(child))
+            {
+                ASSERT_LT(childIndex, node->getChildCount());
+                EXPECT_EQ(node->getChildNode(childIndex), tree.getNode(child));
+                EXPECT_EQ(index, tree.getParent(child));
+                ++childIndex;
+            }
+            EXPECT_EQ(node->getChildCount(), childIndex);
+            EXPECT_EQ(node->getChildCount(), tree.getChildCount(index));
+        }
+    }
+};
+
+// Test that the compact tree lists the nodes in traversal order, with the same children as the
+// AST.
+TEST_F(CompactIntermTreeTest, MatchesTraversal)
+{
+    const std::string &shaderString =
+        R"(#version 310 es
+        precision highp float;
+        uniform int u;
+        out vec4 color;
+        float f(float x)
+        {
+            return x > 0.5 ? x * 2.0 : -x;
+        }
+        void main()
+        {
+            vec4 result = vec4(0);
+            for (int i = 0; i < u; ++i)
+            {
+                switch (i)
+                {
+                    case 0:
+                        result.x += f(float(i));
+                        break;
+                    default:
+                        result.yz = vec2(1.0, 2.0);
+                }
+                if (result.w > 1.0)
+                {
+                    continue;
+                }
+                else
+                {
+                    result.w++;
+                }
+            }
+            color = result;
+        })";
+    if (!compile(shaderString))
+    {
+        FAIL() << "Shader compilation failed " << mInfoLog;
+    }
+
+    CompactIntermTree tree;
+    tree.build(mASTRoot);
+    checkStructure(tree);
+
+    // Every kind of node in the shader is found.
+    for (CompactNodeKind kind :
+         {CompactNodeKind::Symbol, CompactNodeKind::ConstantUnion, CompactNodeKind::Swizzle,
+          CompactNodeKind::Binary, CompactNodeKind::Unary, CompactNodeKind::Ternary,
+          CompactNodeKind::IfElse, CompactNodeKind::Switch, CompactNodeKind::Case,
+          CompactNodeKind::FunctionDefinition, CompactNodeKind::FunctionPrototype,
+          CompactNodeKind::Aggregate, CompactNodeKind::Block, CompactNodeKind::Declaration,
+          CompactNodeKind::Loop, CompactNodeKind::Branch})
+    {
+        EXPECT_FALSE(tree.getNodesOfKind(kind).empty()) << static_cast<int>(kind);
+        for (CompactIntermTree::NodeIndex index : tree.getNodesOfKind(kind))
+        {
+            EXPECT_EQ(kind, tree.getKind(index));
+        }
+    }
+
+    // The operators and the variables match the AST.
+    for (CompactIntermTree::NodeIndex index : tree.getNodesOfKind(CompactNodeKind::Binary))
+    {
+        EXPECT_EQ(tree.getNode(index)->getAsBinaryNode()->getOp(), tree.getOp(index));
+    }
+    for (CompactIntermTree::NodeIndex index : tree.getNodesOfKind(CompactNodeKind::Loop))
+    {
+        EXPECT_EQ(EOpNull, tree.getOp(index));
+    }
+
+    const std::vector<CompactIntermTree::NodeIndex> &symbols =
+        tree.getNodesOfKind(CompactNodeKind::Symbol);
+    ASSERT_EQ(symbols.size(), tree.getSymbolVariables().size());
+    for (size_t symbol = 0; symbol < symbols.size(); ++symbol)
+    {
+        EXPECT_EQ(&tree.getNode(symbols[symbol])->getAsSymbolNode()->variable(),
+                  tree.getSymbolVariables()[symbol]);
+    }
+}
+
+// Test that building the tree again replaces the previous contents, as is needed after a pass
+// modifies the AST.
+TEST_F(CompactIntermTreeTest, Rebuild)
+{
+    const std::string &shaderString =
+        R"(#version 310 es
+        precision highp float;
+        out vec4 color;
+        void main()
+        {
+            color = vec4(1.0);
+        })";
+    if (!compile(shaderString))
+    {
+        FAIL() << "Shader compilation failed " << mInfoLog;
+    }
+
+    CompactIntermTree tree;
+    tree.build(mASTRoot);
+    const size_t size = tree.size();
+
+    // Duplicate the statements of main.
+    TIntermBlock *mainBody = nullptr;
+    for (CompactIntermTree::NodeIndex index :
+         tree.getNodesOfKind(CompactNodeKind::FunctionDefinition))
+    {
+        mainBody = tree.getNode(index)->getAsFunctionDefinition()->getBody();
+    }
+    ASSERT_NE(nullptr, mainBody);
+    const size_t statementCount = mainBody->getChildCount();
+    for (size_t statement = 0; statement < statementCount; ++statement)
+    {
+        mainBody->appendStatement(mainBody->getChildNode(statement)->getAsTyped()->deepCopy());
+    }
+
+    tree.build(mASTRoot);
+    EXPECT_GT(tree.size(), size);
+    checkStructure(tree);
+
+    tree.clear();
+    EXPECT_TRUE(tree.empty());
+    EXPECT_TRUE(tree.getNodesOfKind(CompactNodeKind::Symbol).empty());
+    EXPECT_TRUE(tree.getSymbolVariables().empty());
+}
+
+}  // anonymous namespace
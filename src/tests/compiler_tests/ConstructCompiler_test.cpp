@@ -44,3 +44,45 @@ TEST(ConstructCompilerTest, InvalidMaxDualSourceDrawBuffers)
                                               SH_GLSL_COMPATIBILITY_OUTPUT, &resources);
     ASSERT_EQ(nullptr, compiler);
 }
+
+// Test that compilers see the built-in constants of their own resources, including while compilers
+// with other resources exist.
+TEST(ConstructCompilerTest, BuiltInConstantsMatchResources)
+{
+    constexpr char kShader[] = R"(precision mediump float;
+void main()
+{
+    float a[gl_MaxDrawBuffers - 4];
+    a[0] = 0.0;
+    gl_FragColor = vec4(a[0]);
+})";
+    const char *shaderStrings[] = {kShader};
+
+    ShBuiltInResources resources;
+    sh::InitBuiltInResources(&resources);
+    resources.MaxDrawBuffers = 8;
+    ShHandle compiler8       = sh::ConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC,
+                                                     SH_ESSL_OUTPUT, &resources);
+    ASSERT_NE(nullptr, compiler8);
+
+    resources.MaxDrawBuffers = 4;
+    ShHandle compiler4       = sh::ConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC,
+                                                     SH_ESSL_OUTPUT, &resources);
+    ASSERT_NE(nullptr, compiler4);
+
+    ShCompileOptions compileOptions = {};
+    EXPECT_TRUE(sh::Compile(compiler8, shaderStrings, 1, compileOptions));
+    EXPECT_FALSE(sh::Compile(compiler4, shaderStrings, 1, compileOptions));
+    sh::Destruct(compiler4);
+
+    // A compiler created again with the same resources gets the same constants.
+    resources.MaxDrawBuffers = 8;
+    ShHandle otherCompiler8  = sh::ConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC,
+                                                     SH_ESSL_OUTPUT, &resources);
+    ASSERT_NE(nullptr, otherCompiler8);
+    EXPECT_TRUE(sh::Compile(otherCompiler8, shaderStrings, 1, compileOptions));
+    EXPECT_TRUE(sh::Compile(compiler8, shaderStrings, 1, compileOptions));
+
+    sh::Destruct(otherCompiler8);
+    sh::Destruct(compiler8);
+}
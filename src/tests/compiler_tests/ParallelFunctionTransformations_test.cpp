@@ -0,0 +1,246 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ParallelFunctionTransformations_test.cpp:
+//   Tests that transforming function bodies on a worker pool gives the same result as
+//   transforming them on the compiling thread.
+//
+
+#include <atomic>
+#include <map>
+#include <regex>
+#include <sstream>
+
+#include "GLSLANG/ShaderLang.h"
+#include "angle_gl.h"
+#include "common/WorkerThread.h"
+#include "gtest/gtest.h"
+
+namespace sh
+{
+namespace
+{
+// Symbols created by the transformations are named after their unique id (e.g. "s1a2"), which
+// differs when the functions are transformed in parallel, as each function takes its ids from its
+// own range.  Renames them in order of appearance so the outputs can be compared.  User-defined
+// names are prefixed with "_u" in the output, so they don't match.
+std::string NormalizeInternalNames(const std::string &code)
+{
+    static const std::regex kInternalName("\\bs[0-9a-f]+\\b");
+
+    std::map<std::string, size_t> names;
+    std::string normalized;
+    size_t last = 0;
+    for (auto match = std::sregex_iterator(code.begin(), code.end(), kInternalName);
+         match != std::sregex_iterator(); ++match)
+    {
+        const size_t index = names.emplace(match->str(), names.size()).first->second;
+        normalized += code.substr(last, match->position() - last);
+        normalized += "internal" + std::to_string(index);
+        last = match->position() + match->length();
+    }
+    normalized += code.substr(last);
+    return normalized;
+}
+
+// Forwards tasks to a real pool, counting them.
+class CountingWorkerThreadPool final : public angle::WorkerThreadPool
+{
+  public:
+    CountingWorkerThreadPool(size_t threadCount)
+        : mPool(angle::WorkerThreadPool::Create(threadCount, ANGLEPlatformCurrent()))
+    {}
+
+    std::shared_ptr<angle::WaitableEvent> postWorkerTask(
+        const std::shared_ptr<angle::Closure> &task) override
+    {
+        mPostedTaskCount.fetch_add(1, std::memory_order_relaxed);
+        return mPool->postWorkerTask(task);
+    }
+
+    bool isAsync() override { return mPool->isAsync(); }
+
+    size_t getPostedTaskCount() const { return mPostedTaskCount.load(); }
+
+  private:
+    std::shared_ptr<angle::WorkerThreadPool> mPool;
+    std::atomic<size_t> mPostedTaskCount{0};
+};
+
+class ParallelFunctionTransformationsTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        sh::InitBuiltInResources(&mResources);
+        mResources.FragmentPrecisionHigh = 1;
+    }
+
+    // Compiles |shaderString| through the public API, optionally with
+    // ShCompileOptions::parallelFunctionTransformations and |workerPool|.  Returns the normalized
+    // object code.
+    bool compile(const std::string &shaderString,
+                 bool parallel,
+                 const std::shared_ptr<angle::WorkerThreadPool> &workerPool,
+                 std::string *objectCodeOut,
+                 std::string *infoLogOut)
+    {
+        ShHandle compiler = sh::ConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES3_1_SPEC,
+                                                  SH_ESSL_OUTPUT, &mResources);
+        if (compiler == nullptr)
+        {
+            return false;
+        }
+        sh::SetWorkerThreadPool(compiler, workerPool);
+
+        ShCompileOptions compileOptions                = {};
+        compileOptions.objectCode                      = true;
+        compileOptions.validateAST                     = true;
+        compileOptions.simplifyLoopConditions          = true;
+        compileOptions.initializeUninitializedLocals   = true;
+        compileOptions.parallelFunctionTransformations = parallel;
+
+        const char *shaderStrings[] = {shaderString.c_str()};
+        const bool success          = sh::Compile(compiler, shaderStrings, 1, compileOptions);
+        *objectCodeOut              = NormalizeInternalNames(sh::GetObjectCode(compiler));
+        *infoLogOut                 = sh::GetInfoLog(compiler);
+        sh::Destruct(compiler);
+        return success;
+    }
+
+    // Checks that the parallel compilation of |shaderString| matches the serial one, with several
+    // thread counts.  Returns the number of tasks posted to the pools.
+    size_t testMatchesSerial(const std::string &shaderString)
+    {
+        std::string expectedCode;
+        std::string expectedInfoLog;
+        EXPECT_TRUE(compile(shaderString, false, nullptr, &expectedCode, &expectedInfoLog))
+            << expectedInfoLog;
+
+        size_t postedTaskCount = 0;
+        for (size_t threadCount : {1, 2, 4, 8})
+        {
+            auto workerPool = std::make_shared<CountingWorkerThreadPool>(threadCount);
+
+            std::string code;
+            std::string infoLog;
+            EXPECT_TRUE(compile(shaderString, true, workerPool, &code, &infoLog))
+                << threadCount << " threads";
+            EXPECT_EQ(expectedCode, code) << threadCount << " threads";
+            EXPECT_EQ(expectedInfoLog, infoLog) << threadCount << " threads";
+
+            postedTaskCount += workerPool->getPostedTaskCount();
+        }
+        return postedTaskCount;
+    }
+
+    // Returns a shader with |functionCount| functions with loops whose conditions are simplified,
+    // switches whose empty cases are pruned and uninitialized locals.
+    static std::string MakeShader(int functionCount)
+    {
+        std::stringstream shader;
+        shader << R"(#version 310 es
+precision highp float;
+uniform vec4 u[8];
+uniform int n;
+out vec4 color;
+)";
+        for (int index = 0; index < functionCount; ++index)
+        {
+            shader << "float f" << index << R"((float x)
+{
+    float r;
+    float unused;
+    r = x;
+    for (int i = 0, k = 1; i < n && r < u[i % 8].w; ++i, k *= 2)
+    {
+        r = r * 1.5 + u[i % 8].x * float(k);
+    }
+    int j = 0;
+    do
+    {
+        r -= u[j].y;
+    } while (++j < 4 && r > 0.5);
+    while (r > 10.0 && j++ < n)
+    {
+        r *= 0.5;
+    }
+    switch (j)
+    {
+        case 0:
+            r += 1.0;
+            break;
+        default:
+            r -= 1.0;
+        case 7:
+            ;
+    }
+    return r;
+}
+)";
+        }
+
+        shader << R"(void main()
+{
+    float a = 0.0;
+)";
+        for (int index = 0; index < functionCount; ++index)
+        {
+            shader << "    a += f" << index << "(u[" << index % 8 << "].z);\n";
+        }
+        shader << R"(    color = vec4(a);
+})";
+        return shader.str();
+    }
+
+    ShBuiltInResources mResources;
+};
+
+// Test that a shader with a few functions is transformed the same in parallel as serially.
+TEST_F(ParallelFunctionTransformationsTest, FewFunctions)
+{
+    testMatchesSerial(MakeShader(3));
+}
+
+// Test that a shader with more functions than threads is transformed the same in parallel as
+// serially.
+TEST_F(ParallelFunctionTransformationsTest, ManyFunctions)
+{
+    EXPECT_GT(testMatchesSerial(MakeShader(40)), 0u);
+}
+
+// Test that a shader with a single function, which is not worth distributing, is transformed the
+// same with the option as without it, and without using the pool.
+TEST_F(ParallelFunctionTransformationsTest, MainOnly)
+{
+    EXPECT_EQ(0u, testMatchesSerial(MakeShader(0)));
+}
+
+// Test that the function bodies of a multi-function shader are handed to the pool when the option
+// is set, and that the option has no effect without a pool.
+TEST_F(ParallelFunctionTransformationsTest, UsesWorkerPool)
+{
+    const std::string shader = MakeShader(16);
+
+    auto workerPool = std::make_shared<CountingWorkerThreadPool>(4);
+    std::string code;
+    std::string infoLog;
+    ASSERT_TRUE(compile(shader, true, workerPool, &code, &infoLog)) << infoLog;
+    const size_t postedTaskCount = workerPool->getPostedTaskCount();
+    EXPECT_GT(postedTaskCount, 0u);
+
+    std::string serialCode;
+    std::string serialInfoLog;
+    ASSERT_TRUE(compile(shader, false, workerPool, &serialCode, &serialInfoLog)) << serialInfoLog;
+    EXPECT_EQ(postedTaskCount, workerPool->getPostedTaskCount());
+    EXPECT_EQ(serialCode, code);
+
+    std::string noPoolCode;
+    std::string noPoolInfoLog;
+    ASSERT_TRUE(compile(shader, true, nullptr, &noPoolCode, &noPoolInfoLog)) << noPoolInfoLog;
+    EXPECT_EQ(serialCode, noPoolCode);
+}
+}  // anonymous namespace
+}  // namespace sh
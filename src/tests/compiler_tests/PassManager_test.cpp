@@ -0,0 +1,297 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PassManager_test.cpp:
+//   Tests that analyses sharing a traversal behave as if they traversed the tree one after the
+//   other, and that passes are reported through trace events.
+//
+
+#include "compiler/translator/tree_util/PassManager.h"
+
+#include "angle_gl.h"
+#include "compiler/translator/tree_util/IntermTraverse.h"
+#include "gtest/gtest.h"
+#include "platform/PlatformMethods.h"
+#include "tests/test_utils/ShaderCompileTreeTest.h"
+
+using namespace sh;
+
+namespace
+{
+
+struct VisitRecord
+{
+    Visit visit;
+    TIntermNode *node;
+    TIntermNode *parent;
+    int depth;
+    size_t childIndex;
+    bool inGlobalScope;
+
+    bool operator==(const VisitRecord &other) const
+    {
+        return visit == other.visit && node == other.node && parent == other.parent &&
+               depth == other.depth && childIndex == other.childIndex &&
+               inGlobalScope == other.inGlobalScope;
+    }
+};
+
+enum class SkipMode
+{
+    // Visits the whole tree.
+    None,
+    // Returns false when pre-visiting loops.
+    LoopPreVisit,
+    // Returns false after visiting the first operand of binary nodes.
+    BinaryInVisit,
+};
+
+// Records every visit, along with the traversal state seen by the traverser.
+class RecordingTraverser : public TIntermTraverser
+{
+  public:
+    RecordingTraverser(bool preVisit, bool inVisit, bool postVisit, SkipMode skipMode)
+        : TIntermTraverser(preVisit, inVisit, postVisit), mSkipMode(skipMode)
+    {}
+
+    void visitSymbol(TIntermSymbol *node) override { record(PreVisit, node); }
+    void visitConstantUnion(TIntermConstantUnion *node) override { record(PreVisit, node); }
+    void visitFunctionPrototype(TIntermFunctionPrototype *node) override
+    {
+        record(PreVisit, node);
+    }
+    bool visitSwizzle(Visit visit, TIntermSwizzle *node) override { return record(visit, node); }
+    bool visitBinary(Visit visit, TIntermBinary *node) override
+    {
+        record(visit, node);
+        return !(mSkipMode == SkipMode::BinaryInVisit && visit == InVisit);
+    }
+    bool visitUnary(Visit visit, TIntermUnary *node) override { return record(visit, node); }
+    bool visitTernary(Visit visit, TIntermTernary *node) override { return record(visit, node); }
+    bool visitIfElse(Visit visit, TIntermIfElse *node) override { return record(visit, node); }
+    bool visitFunctionDefinition(Visit visit, TIntermFunctionDefinition *node) override
+    {
+        return record(visit, node);
+    }
+    bool visitAggregate(Visit visit, TIntermAggregate *node) override
+    {
+        return record(visit, node);
+    }
+    bool visitBlock(Visit visit, TIntermBlock *node) override { return record(visit, node); }
+    bool visitDeclaration(Visit visit, TIntermDeclaration *node) override
+    {
+        return record(visit, node);
+    }
+    bool visitLoop(Visit visit, TIntermLoop *node) override
+    {
+        record(visit, node);
+        return !(mSkipMode == SkipMode::LoopPreVisit && visit == PreVisit);
+    }
+    bool visitBranch(Visit visit, TIntermBranch *node) override { return record(visit, node); }
+
+    const std::vector<VisitRecord> &getRecords() const { return mRecords; }
+
+  private:
+    bool record(Visit visit, TIntermNode *node)
+    {
+        const size_t childIndex = visit == PreVisit ? getParentChildIndex(visit)
+                                                    : getLastTraversedChildIndex(visit);
+        mRecords.push_back({visit, node, getParentNode(), getCurrentTraversalDepth(), childIndex,
+                            mInGlobalScope});
+        return true;
+    }
+
+    SkipMode mSkipMode;
+    std::vector<VisitRecord> mRecords;
+};
+
+struct TraceEvent
+{
+    char phase;
+    std::string name;
+
+    bool operator==(const TraceEvent &other) const
+    {
+        return phase == other.phase && name == other.name;
+    }
+};
+
+const unsigned char *GetTraceCategoryEnabledFlag(angle::PlatformMethods *platform,
+                                                 const char *categoryName)
+{
+    static unsigned char enabled = 1;
+    return &enabled;
+}
+
+double MonotonicallyIncreasingTime(angle::PlatformMethods *platform)
+{
+    return 1.0;
+}
+
+angle::TraceEventHandle AddTraceEvent(angle::PlatformMethods *platform,
+                                      char phase,
+                                      const unsigned char *categoryEnabledFlag,
+                                      const char *name,
+                                      unsigned long long id,
+                                      double timestamp,
+                                      int numArgs,
+                                      const char **argNames,
+                                      const unsigned char *argTypes,
+                                      const unsigned long long *argValues,
+                                      unsigned char flags)
+{
+    static_cast<std::vector<TraceEvent> *>(platform->context)->push_back({phase, name});
+    return 0;
+}
+
+class PassManagerTest : public ShaderCompileTreeTest
+{
+  public:
+    PassManagerTest() {}
+
+  protected:
+    ::GLenum getShaderType() const override { return GL_FRAGMENT_SHADER; }
+    ShShaderSpec getShaderSpec() const override { return SH_GLES3_SPEC; }
+
+    void compileShader()
+    {
+        const std::string &shaderString =
+            R"(#version 300 es
+            precision highp float;
+            uniform int u;
+            out vec4 color;
+            float f(float x)
+            {
+                return x > 0.5 ? x * 2.0 : -x;
+            }
+            void main()
+            {
+                vec4 result = vec4(0);
+                for (int i = 0; i < u; ++i)
+                {
+                    if (result.w > 1.0)
+                    {
+                        result.x += f(float(i));
+                    }
+                }
+                color = result + vec4(u);
+            })";
+        if (!compile(shaderString))
+        {
+            FAIL() << "Shader compilation failed " << mInfoLog;
+        }
+    }
+};
+
+// Test that traversers sharing a traversal see the same visits as when traversing the tree by
+// themselves, including when skipping parts of the tree.
+TEST_F(PassManagerTest, FusedVisitsMatchSeparateTraversals)
+{
+    compileShader();
+
+    struct Config
+    {
+        bool preVisit;
+        bool inVisit;
+        bool postVisit;
+        SkipMode skipMode;
+    };
+    const Config configs[] = {
+        {true, false, false, SkipMode::None},        {true, true, true, SkipMode::None},
+        {true, false, true, SkipMode::LoopPreVisit}, {false, false, true, SkipMode::None},
+        {true, true, true, SkipMode::BinaryInVisit}, {true, true, false, SkipMode::LoopPreVisit},
+    };
+
+    std::vector<std::vector<VisitRecord>> expectedRecords;
+    for (const Config &config : configs)
+    {
+        RecordingTraverser traverser(config.preVisit, config.inVisit, config.postVisit,
+                                     config.skipMode);
+        mASTRoot->traverse(&traverser);
+        expectedRecords.push_back(traverser.getRecords());
+    }
+
+    PassManager passManager(mASTRoot, nullptr);
+    std::vector<RecordingTraverser *> traversers;
+    for (const Config &config : configs)
+    {
+        auto traverser = std::make_unique<RecordingTraverser>(config.preVisit, config.inVisit,
+                                                              config.postVisit, config.skipMode);
+        traversers.push_back(traverser.get());
+        passManager.queueAnalysis(
+            {"Recording", std::move(traverser), AnalysisEffects::None,
+             [&expectedRecords, &traversers, index = traversers.size() - 1]() {
+                 EXPECT_EQ(expectedRecords[index], traversers[index]->getRecords());
+                 return true;
+             }});
+    }
+    EXPECT_TRUE(passManager.runAnalyses());
+}
+
+// Test that a failing analysis stops the analyses queued after it.
+TEST_F(PassManagerTest, FailingAnalysisStopsLaterAnalyses)
+{
+    compileShader();
+
+    std::vector<std::string> finished;
+    auto queueAnalysis = [&](PassManager *passManager, const char *name, AnalysisEffects effects,
+                             bool succeed) {
+        passManager->queueAnalysis(
+            {name, std::make_unique<RecordingTraverser>(true, false, false, SkipMode::None),
+             effects, [&finished, name, succeed]() {
+                 finished.push_back(name);
+                 return succeed;
+             }});
+    };
+
+    PassManager passManager(mASTRoot, nullptr);
+    queueAnalysis(&passManager, "First", AnalysisEffects::None, true);
+    queueAnalysis(&passManager, "Failing", AnalysisEffects::None, false);
+    queueAnalysis(&passManager, "Skipped", AnalysisEffects::None, true);
+    queueAnalysis(&passManager, "NotStarted", AnalysisEffects::Results, true);
+    EXPECT_FALSE(passManager.runAnalyses());
+    EXPECT_EQ((std::vector<std::string>{"First", "Failing"}), finished);
+
+    // The remaining analyses are dropped.
+    bool passRan = false;
+    EXPECT_TRUE(passManager.runPass("Pass", [&passRan]() { return passRan = true; }));
+    EXPECT_TRUE(passRan);
+    EXPECT_EQ(2u, finished.size());
+}
+
+// Test that the passes, the shared traversals and the analyses are reported through trace events.
+TEST_F(PassManagerTest, TraceEvents)
+{
+    compileShader();
+
+    std::vector<TraceEvent> events;
+    angle::PlatformMethods platform;
+    platform.context                     = &events;
+    platform.getTraceCategoryEnabledFlag = GetTraceCategoryEnabledFlag;
+    platform.monotonicallyIncreasingTime = MonotonicallyIncreasingTime;
+    platform.addTraceEvent               = AddTraceEvent;
+
+    PassManager passManager(mASTRoot, &platform);
+    auto queueAnalysis = [&passManager](const char *name) {
+        passManager.queueAnalysis(
+            {name, std::make_unique<RecordingTraverser>(true, false, false, SkipMode::None),
+             AnalysisEffects::Results, nullptr});
+    };
+
+    queueAnalysis("Single");
+    EXPECT_TRUE(passManager.runPass("Pass", []() { return true; }));
+    queueAnalysis("First");
+    queueAnalysis("Second");
+    EXPECT_TRUE(passManager.runAnalyses());
+
+    const std::vector<TraceEvent> expectedEvents = {
+        {'B', "Single"},        {'E', "Single"},        {'B', "Pass"},   {'E', "Pass"},
+        {'B', "FusedAnalyses"}, {'E', "FusedAnalyses"}, {'B', "First"},  {'E', "First"},
+        {'B', "Second"},        {'E', "Second"},
+    };
+    EXPECT_EQ(expectedEvents, events);
+}
+
+}  // anonymous namespace
@@ -7465,6 +7465,209 @@ TEST_P(Texture2DArrayTestES3, ClearThenTexSubImageWithOverlappingLayersThenDrawA
     ASSERT_GL_NO_ERROR();
 }
 
+// Test that adjacent tiles uploaded with glTexSubImage2D, which the Vulkan backend copies to the
+// image with a single copy command, all end up in the texture.
+TEST_P(Texture2DTestES3, TexSubImageAdjacentTilesThenRead)
+{
+    constexpr GLsizei kTileSize     = 16;
+    constexpr GLsizei kTilesPerSide = 4;
+    constexpr GLsizei kTexSize      = kTileSize * kTilesPerSide;
+
+    GLTexture tex;
+    glBindTexture(GL_TEXTURE_2D, tex);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, kTexSize, kTexSize);
+
+    auto tileColor = [](GLsizei tileX, GLsizei tileY) {
+        return GLColor(static_cast<GLubyte>(tileX * 64), static_cast<GLubyte>(tileY * 64),
+                       static_cast<GLubyte>(255 - (tileX + tileY) * 16), 255);
+    };
+
+    for (GLsizei tileY = 0; tileY < kTilesPerSide; ++tileY)
+    {
+        for (GLsizei tileX = 0; tileX < kTilesPerSide; ++tileX)
+        {
+            std::vector<GLColor> tileData(kTileSize * kTileSize, tileColor(tileX, tileY));
+            glTexSubImage2D(GL_TEXTURE_2D, 0, tileX * kTileSize, tileY * kTileSize, kTileSize,
+                            kTileSize, GL_RGBA, GL_UNSIGNED_BYTE, tileData.data());
+        }
+    }
+
+    GLFramebuffer fbo;
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, tex, 0);
+    ASSERT_GL_FRAMEBUFFER_COMPLETE(GL_FRAMEBUFFER);
+
+    for (GLsizei tileY = 0; tileY < kTilesPerSide; ++tileY)
+    {
+        for (GLsizei tileX = 0; tileX < kTilesPerSide; ++tileX)
+        {
+            EXPECT_PIXEL_RECT_EQ(tileX * kTileSize, tileY * kTileSize, kTileSize, kTileSize,
+                                 tileColor(tileX, tileY));
+        }
+    }
+    ASSERT_GL_NO_ERROR();
+}
+
+// Test that partially overlapping glTexSubImage2D updates, which can't be copied to the image with
+// a single copy command, are applied in order.
+TEST_P(Texture2DTestES3, TexSubImageOverlappingPartialUpdatesThenRead)
+{
+    constexpr GLsizei kTexSize    = 32;
+    constexpr GLsizei kUpdateSize = 24;
+    constexpr GLint kSecondOffset = kTexSize - kUpdateSize;
+
+    GLTexture tex;
+    glBindTexture(GL_TEXTURE_2D, tex);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, kTexSize, kTexSize);
+
+    std::vector<GLColor> redData(kTexSize * kTexSize, GLColor::red);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, kTexSize, kTexSize, GL_RGBA, GL_UNSIGNED_BYTE,
+                    redData.data());
+
+    // The second update overlaps the first one, and the two leave two opposite corners of the
+    // texture red.
+    std::vector<GLColor> greenData(kUpdateSize * kUpdateSize, GLColor::green);
+    std::vector<GLColor> blueData(kUpdateSize * kUpdateSize, GLColor::blue);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, kUpdateSize, kUpdateSize, GL_RGBA, GL_UNSIGNED_BYTE,
+                    greenData.data());
+    glTexSubImage2D(GL_TEXTURE_2D, 0, kSecondOffset, kSecondOffset, kUpdateSize, kUpdateSize,
+                    GL_RGBA, GL_UNSIGNED_BYTE, blueData.data());
+
+    GLFramebuffer fbo;
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, tex, 0);
+    ASSERT_GL_FRAMEBUFFER_COMPLETE(GL_FRAMEBUFFER);
+
+    EXPECT_PIXEL_RECT_EQ(0, 0, kSecondOffset, kUpdateSize, GLColor::green);
+    EXPECT_PIXEL_RECT_EQ(0, 0, kUpdateSize, kSecondOffset, GLColor::green);
+    EXPECT_PIXEL_RECT_EQ(kSecondOffset, kSecondOffset, kUpdateSize, kUpdateSize, GLColor::blue);
+    EXPECT_PIXEL_RECT_EQ(kUpdateSize, 0, kTexSize - kUpdateSize, kSecondOffset, GLColor::red);
+    EXPECT_PIXEL_RECT_EQ(0, kUpdateSize, kSecondOffset, kTexSize - kUpdateSize, GLColor::red);
+    ASSERT_GL_NO_ERROR();
+}
+
+// Test that glTexSubImage2D updates that fully cover earlier staged updates, which the Vulkan
+// backend drops, leave the uncovered parts of the earlier updates intact.
+TEST_P(Texture2DTestES3, TexSubImageSupersedingUpdatesThenRead)
+{
+    constexpr GLsizei kTexSize      = 32;
+    constexpr GLint kTileOffset     = 8;
+    constexpr GLsizei kTileSize     = 16;
+    constexpr GLint kCoveringOffset = 4;
+    constexpr GLsizei kCoveringSize = 24;
+
+    GLTexture tex;
+    glBindTexture(GL_TEXTURE_2D, tex);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, kTexSize, kTexSize);
+
+    std::vector<GLColor> yellowData(kTexSize * kTexSize, GLColor::yellow);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, kTexSize, kTexSize, GL_RGBA, GL_UNSIGNED_BYTE,
+                    yellowData.data());
+
+    // Re-upload the same tile, then upload a larger region covering it.
+    std::vector<GLColor> redData(kTileSize * kTileSize, GLColor::red);
+    std::vector<GLColor> greenData(kTileSize * kTileSize, GLColor::green);
+    std::vector<GLColor> blueData(kCoveringSize * kCoveringSize, GLColor::blue);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, kTileOffset, kTileOffset, kTileSize, kTileSize, GL_RGBA,
+                    GL_UNSIGNED_BYTE, redData.data());
+    glTexSubImage2D(GL_TEXTURE_2D, 0, kTileOffset, kTileOffset, kTileSize, kTileSize, GL_RGBA,
+                    GL_UNSIGNED_BYTE, greenData.data());
+    glTexSubImage2D(GL_TEXTURE_2D, 0, kCoveringOffset, kCoveringOffset, kCoveringSize,
+                    kCoveringSize, GL_RGBA, GL_UNSIGNED_BYTE, blueData.data());
+
+    GLFramebuffer fbo;
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, tex, 0);
+    ASSERT_GL_FRAMEBUFFER_COMPLETE(GL_FRAMEBUFFER);
+
+    constexpr GLint kCoveringEnd = kCoveringOffset + kCoveringSize;
+    EXPECT_PIXEL_RECT_EQ(kCoveringOffset, kCoveringOffset, kCoveringSize, kCoveringSize,
+                         GLColor::blue);
+    EXPECT_PIXEL_RECT_EQ(0, 0, kTexSize, kCoveringOffset, GLColor::yellow);
+    EXPECT_PIXEL_RECT_EQ(0, kCoveringEnd, kTexSize, kTexSize - kCoveringEnd, GLColor::yellow);
+    EXPECT_PIXEL_RECT_EQ(0, 0, kCoveringOffset, kTexSize, GLColor::yellow);
+    EXPECT_PIXEL_RECT_EQ(kCoveringEnd, 0, kTexSize - kCoveringEnd, kTexSize, GLColor::yellow);
+    ASSERT_GL_NO_ERROR();
+
+    // Upload the tile again after the texture is used, and check it is not dropped with the
+    // updates that were already applied.
+    glTexSubImage2D(GL_TEXTURE_2D, 0, kTileOffset, kTileOffset, kTileSize, kTileSize, GL_RGBA,
+                    GL_UNSIGNED_BYTE, redData.data());
+    EXPECT_PIXEL_RECT_EQ(kTileOffset, kTileOffset, kTileSize, kTileSize, GLColor::red);
+    EXPECT_PIXEL_COLOR_EQ(kCoveringOffset, kCoveringOffset, GLColor::blue);
+    EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::yellow);
+    ASSERT_GL_NO_ERROR();
+}
+
+// Test that tiles uploaded to the layers of a 2D array texture, both one layer at a time and to
+// several layers at once, all end up in the texture.
+TEST_P(Texture2DArrayTestES3, TexSubImageTilesOnMultipleLayersThenRead)
+{
+    constexpr GLsizei kTileSize     = 16;
+    constexpr GLsizei kTilesPerSide = 2;
+    constexpr GLsizei kTexSize      = kTileSize * kTilesPerSide;
+    constexpr GLsizei kTexDepth     = 4;
+
+    GLTexture tex;
+    glBindTexture(GL_TEXTURE_2D_ARRAY, tex);
+    glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_RGBA8, kTexSize, kTexSize, kTexDepth);
+
+    auto tileColor = [](GLsizei tileX, GLsizei tileY, GLsizei layer) {
+        return GLColor(static_cast<GLubyte>(tileX * 128), static_cast<GLubyte>(tileY * 128),
+                       static_cast<GLubyte>(layer * 64), 255);
+    };
+
+    // Upload the tiles of every layer, going through the layers for each tile, so that consecutive
+    // updates are to different layers.
+    for (GLsizei tileY = 0; tileY < kTilesPerSide; ++tileY)
+    {
+        for (GLsizei tileX = 0; tileX < kTilesPerSide; ++tileX)
+        {
+            for (GLsizei layer = 0; layer < kTexDepth; ++layer)
+            {
+                std::vector<GLColor> tileData(kTileSize * kTileSize,
+                                              tileColor(tileX, tileY, layer));
+                glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, tileX * kTileSize, tileY * kTileSize,
+                                layer, kTileSize, kTileSize, 1, GL_RGBA, GL_UNSIGNED_BYTE,
+                                tileData.data());
+            }
+        }
+    }
+
+    // Then overwrite the last tile of the middle layers with a single update.
+    constexpr GLsizei kMultiLayerStart = 1;
+    constexpr GLsizei kMultiLayerCount = 2;
+    constexpr GLint kLastTileOffset    = kTexSize - kTileSize;
+    std::vector<GLColor> multiLayerData(kTileSize * kTileSize * kMultiLayerCount,
+                                        GLColor::magenta);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, kLastTileOffset, kLastTileOffset, kMultiLayerStart,
+                    kTileSize, kTileSize, kMultiLayerCount, GL_RGBA, GL_UNSIGNED_BYTE,
+                    multiLayerData.data());
+
+    GLFramebuffer fbo;
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    for (GLsizei layer = 0; layer < kTexDepth; ++layer)
+    {
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, tex, 0, layer);
+        ASSERT_GL_FRAMEBUFFER_COMPLETE(GL_FRAMEBUFFER);
+
+        for (GLsizei tileY = 0; tileY < kTilesPerSide; ++tileY)
+        {
+            for (GLsizei tileX = 0; tileX < kTilesPerSide; ++tileX)
+            {
+                const bool isOverwritten = tileX * kTileSize == kLastTileOffset &&
+                                           tileY * kTileSize == kLastTileOffset &&
+                                           layer >= kMultiLayerStart &&
+                                           layer < kMultiLayerStart + kMultiLayerCount;
+                EXPECT_PIXEL_RECT_EQ(tileX * kTileSize, tileY * kTileSize, kTileSize, kTileSize,
+                                     isOverwritten ? GLColor::magenta
+                                                   : tileColor(tileX, tileY, layer));
+            }
+        }
+    }
+    ASSERT_GL_NO_ERROR();
+}
+
 // Test that compressed textures ignore the pixel unpack state.
 // (https://crbug.org/1267496)
 TEST_P(Texture3DTestES3, PixelUnpackStateTexImage)
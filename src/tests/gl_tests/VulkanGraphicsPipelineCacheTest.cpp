@@ -0,0 +1,284 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// VulkanGraphicsPipelineCacheTest.cpp:
+//   Tests of the least recently used eviction of the Vulkan back end's graphics pipeline caches,
+//   enabled with ANGLE_GRAPHICS_PIPELINE_CACHE_MAX_SIZE.
+//
+
+#include "test_utils/ANGLETest.h"
+#include "test_utils/gl_raii.h"
+#include "util/EGLWindow.h"
+
+#include <set>
+
+#include "common/system_utils.h"
+#include "libANGLE/Context.h"
+#include "libANGLE/Display.h"
+#include "libANGLE/renderer/vulkan/ContextVk.h"
+#include "libANGLE/renderer/vulkan/ProgramVk.h"
+
+using namespace angle;
+
+namespace
+{
+constexpr char kMaxSizeEnvVar[] = "ANGLE_GRAPHICS_PIPELINE_CACHE_MAX_SIZE";
+constexpr char kMaxSizeValue[]  = "8";
+constexpr size_t kMaxSize       = 8;
+
+// Each pair of blend factors needs a different pipeline.
+constexpr GLenum kBlendFactors[]   = {GL_ZERO,      GL_ONE,
+                                      GL_SRC_COLOR, GL_ONE_MINUS_SRC_COLOR,
+                                      GL_DST_COLOR, GL_ONE_MINUS_DST_COLOR};
+constexpr size_t kBlendFactorCount = ArraySize(kBlendFactors);
+constexpr size_t kStateCount       = kBlendFactorCount * kBlendFactorCount;
+
+// GL_ONE, GL_ONE, with which a red quad drawn over black stays red.
+constexpr size_t kAdditiveStateIndex = kBlendFactorCount + 1;
+
+struct PipelineCacheState
+{
+    size_t pipelineCount   = 0;
+    size_t evictionCount   = 0;
+    size_t transitionCount = 0;
+    std::set<const rx::vk::PipelineHelper *> pipelines;
+};
+
+class VulkanGraphicsPipelineCacheTest : public ANGLETest<>
+{
+  protected:
+    VulkanGraphicsPipelineCacheTest()
+    {
+        setWindowWidth(16);
+        setWindowHeight(16);
+        setConfigRedBits(8);
+        setConfigGreenBits(8);
+        setConfigBlueBits(8);
+        setConfigAlphaBits(8);
+
+        // The budget is read when the renderer is created, so a display is created for the test,
+        // and destroyed after it.
+        SetEnvironmentVar(kMaxSizeEnvVar, kMaxSizeValue);
+        forceNewDisplay();
+    }
+
+    ~VulkanGraphicsPipelineCacheTest() override { UnsetEnvironmentVar(kMaxSizeEnvVar); }
+
+    gl::Context *hackContext(EGLContext context) const
+    {
+        egl::Display *display   = static_cast<egl::Display *>(getEGLWindow()->getDisplay());
+        gl::ContextID contextID = {static_cast<GLuint>(reinterpret_cast<uintptr_t>(context))};
+        return display->getContext(contextID);
+    }
+
+    rx::ContextVk *hackANGLE(EGLContext context) const
+    {
+        // Hack the angle!
+        return rx::GetImplAs<rx::ContextVk>(hackContext(context));
+    }
+
+    const rx::ProgramExecutableVk *hackExecutable(GLuint program) const
+    {
+        const gl::Context *context = hackContext(getEGLWindow()->getContext());
+        return rx::vk::GetImpl(context->getProgramResolveLink({program}))->getExecutable();
+    }
+
+    // Sets up a quad covering the viewport in the current context.
+    void setUpQuad(GLuint program, GLuint buffer)
+    {
+        const std::array<Vector3, 6> positions = GetQuadVertices();
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(positions), positions.data(), GL_STATIC_DRAW);
+
+        const GLint positionLocation =
+            glGetAttribLocation(program, essl1_shaders::PositionAttrib());
+        ASSERT_NE(-1, positionLocation);
+        glVertexAttribPointer(positionLocation, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+        glEnableVertexAttribArray(positionLocation);
+
+        glUseProgram(program);
+        glEnable(GL_BLEND);
+    }
+
+    // Draws with the |stateIndex|th blend state, which creates or looks up its own pipeline.
+    void drawWithState(size_t stateIndex)
+    {
+        glBlendFunc(kBlendFactors[stateIndex / kBlendFactorCount],
+                    kBlendFactors[stateIndex % kBlendFactorCount]);
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+    }
+
+    // Gathers the pipelines and stats of the complete pipeline caches of every permutation, and
+    // checks that no transition leads to a pipeline that is not in the caches.
+    PipelineCacheState getPipelineCacheState(GLuint program) const
+    {
+        const rx::ProgramExecutableVk *executableVk = hackExecutable(program);
+
+        PipelineCacheState state;
+        rx::CacheStats stats;
+        for (size_t index : executableVk->getValidGraphicsPermutationsForTesting())
+        {
+            const rx::CompleteGraphicsPipelineCache &cache =
+                executableVk->getCompleteGraphicsPipelineCacheForTesting(index);
+            cache.getCacheStats(&stats);
+            cache.forEachPipelineForTesting([&state](const rx::vk::PipelineHelper &pipeline) {
+                state.pipelines.insert(&pipeline);
+            });
+            state.pipelineCount += cache.size();
+        }
+        state.evictionCount = stats.getEvictionCount();
+
+        for (const rx::vk::PipelineHelper *pipeline : state.pipelines)
+        {
+            for (const rx::vk::GraphicsPipelineTransition &transition : pipeline->getTransitions())
+            {
+                EXPECT_EQ(1u, state.pipelines.count(transition.target))
+                    << "Transition to an evicted pipeline";
+                ++state.transitionCount;
+            }
+        }
+
+        return state;
+    }
+};
+
+// Test that cycling through more pipelines than the budget evicts the least recently used ones,
+// and removes the transitions to them.
+TEST_P(VulkanGraphicsPipelineCacheTest, EvictsLeastRecentlyUsed)
+{
+    ANGLE_GL_PROGRAM(program, essl1_shaders::vs::Simple(), essl1_shaders::fs::Red());
+    GLBuffer buffer;
+    setUpQuad(program, buffer);
+
+    // Wait for the GPU after each draw, so that every pipeline but the bound one may be evicted.
+    for (size_t stateIndex = 0; stateIndex < kStateCount; ++stateIndex)
+    {
+        drawWithState(stateIndex);
+        glFinish();
+    }
+    ASSERT_GL_NO_ERROR();
+
+    const PipelineCacheState state = getPipelineCacheState(program);
+    EXPECT_LE(state.pipelineCount, kMaxSize);
+    EXPECT_GE(state.evictionCount, kStateCount - kMaxSize);
+    EXPECT_GE(state.pipelineCount + state.evictionCount, kStateCount);
+    EXPECT_GT(state.transitionCount, 0u);
+
+    // Going back to evicted states recreates their pipelines.
+    for (size_t stateIndex = 0; stateIndex < kMaxSize; ++stateIndex)
+    {
+        drawWithState(stateIndex);
+        glFinish();
+    }
+    glClearColor(0, 0, 0, 0);
+    glClear(GL_COLOR_BUFFER_BIT);
+    drawWithState(kAdditiveStateIndex);
+    EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::red);
+    ASSERT_GL_NO_ERROR();
+
+    const PipelineCacheState stateAfterReuse = getPipelineCacheState(program);
+    EXPECT_LE(stateAfterReuse.pipelineCount, kMaxSize);
+    EXPECT_GT(stateAfterReuse.evictionCount, state.evictionCount);
+}
+
+// Test that pipelines the GPU may still be using are not evicted.
+TEST_P(VulkanGraphicsPipelineCacheTest, KeepsPipelinesInUse)
+{
+    ANGLE_GL_PROGRAM(program, essl1_shaders::vs::Simple(), essl1_shaders::fs::Red());
+    GLBuffer buffer;
+    setUpQuad(program, buffer);
+    glFinish();
+
+    // The draws are all recorded in the same render pass, which is not submitted.
+    rx::ContextVk *contextVk          = hackANGLE(getEGLWindow()->getContext());
+    constexpr size_t kInUseStateCount = kMaxSize * 2;
+    std::set<const rx::vk::PipelineHelper *> inUsePipelines;
+    for (size_t stateIndex = 0; stateIndex < kInUseStateCount; ++stateIndex)
+    {
+        drawWithState(stateIndex);
+        inUsePipelines.insert(contextVk->getCurrentGraphicsPipelineForTesting());
+    }
+    ASSERT_GL_NO_ERROR();
+    ASSERT_EQ(kInUseStateCount, inUsePipelines.size());
+
+    // Only pipelines that were never used, such as the one created when warming up the program,
+    // may have been evicted.
+    const PipelineCacheState inUseState = getPipelineCacheState(program);
+    EXPECT_GE(inUseState.pipelineCount, kInUseStateCount);
+    for (const rx::vk::PipelineHelper *pipeline : inUsePipelines)
+    {
+        EXPECT_EQ(1u, inUseState.pipelines.count(pipeline));
+    }
+
+    // Once the GPU is done, the next pipeline lookup evicts them.
+    glFinish();
+    drawWithState(kInUseStateCount);
+    glFinish();
+    ASSERT_GL_NO_ERROR();
+
+    const PipelineCacheState finishedState = getPipelineCacheState(program);
+    EXPECT_GT(finishedState.evictionCount, inUseState.evictionCount);
+    EXPECT_LE(finishedState.pipelineCount, kMaxSize);
+}
+
+// Test that the pipeline bound by another context of the share group is not evicted, even though
+// it is the least recently used one.
+TEST_P(VulkanGraphicsPipelineCacheTest, KeepsPipelinesBoundInShareGroup)
+{
+    EGLWindow *window   = getEGLWindow();
+    EGLDisplay display  = window->getDisplay();
+    EGLSurface surface  = window->getSurface();
+    EGLContext context  = window->getContext();
+    EGLContext context2 = window->createContext(context, nullptr);
+    ASSERT_NE(EGL_NO_CONTEXT, context2);
+
+    ANGLE_GL_PROGRAM(program, essl1_shaders::vs::Simple(), essl1_shaders::fs::Red());
+    GLBuffer buffer;
+
+    // Bind a pipeline in the second context.
+    EXPECT_EGL_TRUE(eglMakeCurrent(display, surface, surface, context2));
+    setUpQuad(program, buffer);
+    drawWithState(kAdditiveStateIndex);
+    glFinish();
+    ASSERT_GL_NO_ERROR();
+
+    const rx::vk::PipelineHelper *boundPipeline =
+        hackANGLE(context2)->getCurrentGraphicsPipelineForTesting();
+    ASSERT_NE(nullptr, boundPipeline);
+    const VkPipeline boundPipelineHandle = boundPipeline->getPipeline().getHandle();
+
+    // Cycle through the other states in the first context.
+    EXPECT_EGL_TRUE(eglMakeCurrent(display, surface, surface, context));
+    setUpQuad(program, buffer);
+    for (size_t stateIndex = 0; stateIndex < kStateCount; ++stateIndex)
+    {
+        if (stateIndex != kAdditiveStateIndex)
+        {
+            drawWithState(stateIndex);
+            glFinish();
+        }
+    }
+    ASSERT_GL_NO_ERROR();
+
+    const PipelineCacheState state = getPipelineCacheState(program);
+    EXPECT_GT(state.evictionCount, 0u);
+    ASSERT_EQ(1u, state.pipelines.count(boundPipeline));
+    EXPECT_EQ(boundPipelineHandle, boundPipeline->getPipeline().getHandle());
+
+    // The second context can still draw with its pipeline.
+    EXPECT_EGL_TRUE(eglMakeCurrent(display, surface, surface, context2));
+    glClearColor(0, 0, 0, 0);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+    EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::red);
+    ASSERT_GL_NO_ERROR();
+
+    EXPECT_EGL_TRUE(eglMakeCurrent(display, surface, surface, context));
+    EXPECT_EGL_TRUE(eglDestroyContext(display, context2));
+}
+
+}  // anonymous namespace
+
+ANGLE_INSTANTIATE_TEST(VulkanGraphicsPipelineCacheTest, ES2_VULKAN(), ES3_VULKAN());
@@ -916,6 +916,56 @@ TEST_P(VulkanPerformanceCounterTest, ClearTextureEXTFullColorImageClear3D)
     EXPECT_EQ(getPerfCounters().fullImageClears, expectedFullImageClears);
 }
 
+// Tests that the staged updates of adjacent tiles are copied to the image with a single copy, and
+// that a tile uploaded twice is only copied once.
+TEST_P(VulkanPerformanceCounterTest, TexSubImageAdjacentTilesAreCoalesced)
+{
+    // Uploads to images that support host image copy are not staged.
+    ANGLE_SKIP_TEST_IF(isFeatureEnabled(Feature::SupportsHostImageCopy));
+
+    constexpr GLsizei kTileSize  = 8;
+    constexpr GLsizei kTileCount = 4;
+    const GLColor kTileColors[kTileCount] = {GLColor::red, GLColor::green, GLColor::blue,
+                                             GLColor::yellow};
+
+    GLTexture tex;
+    glBindTexture(GL_TEXTURE_2D, tex);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, kTileSize * kTileCount, kTileSize);
+
+    GLFramebuffer fbo;
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, tex, 0);
+    ASSERT_GL_FRAMEBUFFER_COMPLETE(GL_FRAMEBUFFER);
+    glFinish();
+
+    // The first tile is uploaded twice, and the first upload is dropped.  The other tiles are
+    // copied along with the second upload of the first tile.
+    const uint64_t expectedCoalescedBufferUpdates =
+        getPerfCounters().coalescedBufferUpdates + kTileCount - 1;
+    const uint64_t expectedImageUpdateStagingBytes =
+        getPerfCounters().imageUpdateStagingBytes +
+        (kTileCount + 1) * kTileSize * kTileSize * sizeof(GLColor);
+
+    std::vector<GLColor> magentaData(kTileSize * kTileSize, GLColor::magenta);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, kTileSize, kTileSize, GL_RGBA, GL_UNSIGNED_BYTE,
+                    magentaData.data());
+    for (GLsizei tile = 0; tile < kTileCount; ++tile)
+    {
+        std::vector<GLColor> tileData(kTileSize * kTileSize, kTileColors[tile]);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, tile * kTileSize, 0, kTileSize, kTileSize, GL_RGBA,
+                        GL_UNSIGNED_BYTE, tileData.data());
+    }
+
+    for (GLsizei tile = 0; tile < kTileCount; ++tile)
+    {
+        EXPECT_PIXEL_RECT_EQ(tile * kTileSize, 0, kTileSize, kTileSize, kTileColors[tile]);
+    }
+    ASSERT_GL_NO_ERROR();
+
+    EXPECT_EQ(getPerfCounters().coalescedBufferUpdates, expectedCoalescedBufferUpdates);
+    EXPECT_EQ(getPerfCounters().imageUpdateStagingBytes, expectedImageUpdateStagingBytes);
+}
+
 // Tests that mutable texture is uploaded with appropriate mip level attributes.
 TEST_P(VulkanPerformanceCounterTest, MutableTextureCompatibleMipLevelsInit)
 {
@@ -58,8 +58,10 @@ constexpr double kMilliSecondsPerSecond                  = 1e3;
 constexpr double kMicroSecondsPerSecond                  = 1e6;
 constexpr double kNanoSecondsPerSecond                   = 1e9;
 constexpr size_t kNumberOfStepsPerformedToComputeGPUTime = 16;
+constexpr double kBytesPerMegaByte                       = 1024.0 * 1024.0;
 constexpr char kPeakMemoryMetric[]                       = ".memory_max";
 constexpr char kMedianMemoryMetric[]                     = ".memory_median";
+constexpr char kThroughputMetric[]                       = ".throughput";
 
 struct TraceCategory
 {
@@ -311,6 +313,7 @@ ANGLEPerfTest::ANGLEPerfTest(const std::string &name,
       mTrialNumStepsPerformed(0),
       mTotalNumStepsPerformed(0),
       mIterationsPerStep(iterationsPerStep),
+      mBytesPerIteration(0),
       mRunning(true),
       mPerfMonitor(0)
 {
@@ -600,6 +603,21 @@ void ANGLEPerfTest::processResults()
     mReporter->AddResult(".trial_steps", static_cast<size_t>(mTrialNumStepsPerformed));
     mReporter->AddResult(".total_steps", static_cast<size_t>(mTotalNumStepsPerformed));
 
+    if (mBytesPerIteration > 0)
+    {
+        perf_test::MetricInfo metricInfo;
+        if (!mReporter->GetMetricInfo(kThroughputMetric, &metricInfo))
+        {
+            mReporter->RegisterImportantMetric(kThroughputMetric, "MB/s");
+        }
+
+        double megaBytes = static_cast<double>(mBytesPerIteration) *
+                           static_cast<double>(mTrialNumStepsPerformed * mIterationsPerStep) /
+                           kBytesPerMegaByte;
+        recordDoubleMetric(kThroughputMetric, megaBytes / mTrialTimer.getElapsedWallClockTime(),
+                           "MB/s");
+    }
+
     if (!mProcessMemoryUsageKBSamples.empty())
     {
         std::sort(mProcessMemoryUsageKBSamples.begin(), mProcessMemoryUsageKBSamples.end());
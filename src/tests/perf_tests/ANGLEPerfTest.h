@@ -103,6 +103,9 @@ class ANGLEPerfTest : public testing::Test, angle::NonCopyable
 
     int getNumStepsPerformed() const { return mTrialNumStepsPerformed; }
 
+    // Call in tests that move a known amount of data every iteration to also report throughput.
+    void setBytesPerIteration(size_t bytes) { mBytesPerIteration = bytes; }
+
     void runTrial(double maxRunTime, int maxStepsToRun, RunTrialPolicy runPolicy);
 
     // Overriden in trace perf tests.
@@ -145,6 +148,7 @@ class ANGLEPerfTest : public testing::Test, angle::NonCopyable
     int mTrialNumStepsPerformed;
     int mTotalNumStepsPerformed;
     int mIterationsPerStep;
+    size_t mBytesPerIteration;
     bool mRunning;
     std::vector<double> mTestTrialResults;
 
@@ -0,0 +1,276 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// CompactIntermTreePerf:
+//   Performance test for walking a large AST, either with a TIntermTraverser or by iterating over
+//   the compact tree built from it.  The walk collects a few statistics of the shader, which is
+//   typical of the analyses done between transformations.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <sstream>
+
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/Compiler.h"
+#include "compiler/translator/InitializeGlobals.h"
+#include "compiler/translator/PoolAlloc.h"
+#include "compiler/translator/tree_util/CompactIntermTree.h"
+#include "compiler/translator/tree_util/IntermTraverse.h"
+
+namespace
+{
+constexpr unsigned int kNumIterationsPerStep = 10;
+constexpr int kFunctionCount                 = 300;
+
+enum class WalkMethod
+{
+    // A TIntermTraverser visits the AST.
+    Traverser,
+    // The compact tree is built once and iterated over in every step.
+    CompactTree,
+    // The compact tree is built again before every iteration, as done after a transformation.
+    CompactTreeWithBuild,
+};
+
+std::ostream &operator<<(std::ostream &os, WalkMethod method)
+{
+    switch (method)
+    {
+        case WalkMethod::Traverser:
+            os << "traverser";
+            break;
+        case WalkMethod::CompactTree:
+            os << "compact_tree";
+            break;
+        case WalkMethod::CompactTreeWithBuild:
+            os << "compact_tree_with_build";
+            break;
+    }
+    return os;
+}
+
+std::string GenerateShader()
+{
+    std::stringstream shader;
+    shader << "#version 300 es\n"
+              "precision highp float;\n"
+              "uniform vec4 parameters[4];\n"
+              "uniform int iterations;\n"
+              "out vec4 color;\n";
+
+    for (int function = 0; function < kFunctionCount; ++function)
+    {
+        shader << "vec4 f" << function << "(vec4 value)\n"
+               << "{\n"
+               << "    vec4 result = value;\n"
+               << "    for (int i = 0; i < iterations; ++i)\n"
+               << "    {\n"
+               << "        result = result * parameters[" << function % 4
+               << "] + vec4(float(i) * 0.5);\n"
+               << "        if (result.x > " << function << ".0)\n"
+               << "        {\n"
+               << "            result.yz = -result.zy;\n"
+               << "        }\n"
+               << "    }\n"
+               << "    return result.w > 0.0 ? normalize(result) : result;\n"
+               << "}\n";
+    }
+
+    shader << "void main()\n"
+              "{\n"
+              "    color = vec4(0);\n";
+    for (int function = 0; function < kFunctionCount; ++function)
+    {
+        shader << "    color = f" << function << "(color);\n";
+    }
+    shader << "}\n";
+
+    return shader.str();
+}
+
+struct ShaderStatistics
+{
+    size_t nodeCount       = 0;
+    size_t symbolCount     = 0;
+    size_t assignmentCount = 0;
+};
+
+class StatisticsTraverser : public sh::TIntermTraverser
+{
+  public:
+    StatisticsTraverser(ShaderStatistics *statistics)
+        : TIntermTraverser(true, false, false), mStatistics(statistics)
+    {}
+
+    void visitSymbol(sh::TIntermSymbol *node) override
+    {
+        ++mStatistics->nodeCount;
+        ++mStatistics->symbolCount;
+    }
+    void visitConstantUnion(sh::TIntermConstantUnion *node) override { ++mStatistics->nodeCount; }
+    void visitFunctionPrototype(sh::TIntermFunctionPrototype *node) override
+    {
+        ++mStatistics->nodeCount;
+    }
+    bool visitBinary(sh::Visit visit, sh::TIntermBinary *node) override
+    {
+        ++mStatistics->nodeCount;
+        mStatistics->assignmentCount += sh::IsAssignment(node->getOp());
+        return true;
+    }
+    bool visitUnary(sh::Visit visit, sh::TIntermUnary *node) override
+    {
+        ++mStatistics->nodeCount;
+        mStatistics->assignmentCount += sh::IsAssignment(node->getOp());
+        return true;
+    }
+    bool visitSwizzle(sh::Visit visit, sh::TIntermSwizzle *node) override { return count(); }
+    bool visitTernary(sh::Visit visit, sh::TIntermTernary *node) override { return count(); }
+    bool visitIfElse(sh::Visit visit, sh::TIntermIfElse *node) override { return count(); }
+    bool visitFunctionDefinition(sh::Visit visit, sh::TIntermFunctionDefinition *node) override
+    {
+        return count();
+    }
+    bool visitAggregate(sh::Visit visit, sh::TIntermAggregate *node) override { return count(); }
+    bool visitBlock(sh::Visit visit, sh::TIntermBlock *node) override { return count(); }
+    bool visitDeclaration(sh::Visit visit, sh::TIntermDeclaration *node) override
+    {
+        return count();
+    }
+    bool visitLoop(sh::Visit visit, sh::TIntermLoop *node) override { return count(); }
+    bool visitBranch(sh::Visit visit, sh::TIntermBranch *node) override { return count(); }
+
+  private:
+    bool count()
+    {
+        ++mStatistics->nodeCount;
+        return true;
+    }
+
+    ShaderStatistics *mStatistics;
+};
+
+void GatherStatistics(const sh::CompactIntermTree &tree, ShaderStatistics *statistics)
+{
+    for (sh::CompactIntermTree::NodeIndex index = 0; index < tree.size(); ++index)
+    {
+        ++statistics->nodeCount;
+        switch (tree.getKind(index))
+        {
+            case sh::CompactNodeKind::Symbol:
+                ++statistics->symbolCount;
+                break;
+            case sh::CompactNodeKind::Binary:
+            case sh::CompactNodeKind::Unary:
+                statistics->assignmentCount += sh::IsAssignment(tree.getOp(index));
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+std::string GetStory(WalkMethod method)
+{
+    std::stringstream strstr;
+    strstr << "_" << method;
+    return strstr.str();
+}
+
+class CompactIntermTreePerfTest : public ANGLEPerfTest,
+                                  public ::testing::WithParamInterface<WalkMethod>
+{
+  public:
+    CompactIntermTreePerfTest();
+
+    void SetUp() override;
+    void TearDown() override;
+    void step() override;
+
+  private:
+    angle::PoolAllocator mAllocator;
+    sh::TCompiler *mTranslator = nullptr;
+    sh::TIntermBlock *mASTRoot = nullptr;
+    sh::CompactIntermTree mCompactTree;
+    ShaderStatistics mStatistics;
+};
+
+CompactIntermTreePerfTest::CompactIntermTreePerfTest()
+    : ANGLEPerfTest("CompactIntermTreePerf", "", GetStory(GetParam()), kNumIterationsPerStep)
+{}
+
+void CompactIntermTreePerfTest::SetUp()
+{
+    ANGLEPerfTest::SetUp();
+
+    InitializePoolIndex();
+    mAllocator.push();
+    SetGlobalPoolAllocator(&mAllocator);
+
+    ShBuiltInResources resources;
+    sh::InitBuiltInResources(&resources);
+    mTranslator = sh::ConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES3_SPEC, SH_ESSL_OUTPUT);
+    ASSERT_TRUE(mTranslator->Init(resources));
+
+    // The tree is allocated from the test's pool, so it outlives the compilation.
+    const std::string shader        = GenerateShader();
+    const char *shaderStrings[]     = {shader.c_str()};
+    ShCompileOptions compileOptions = {};
+    mASTRoot = mTranslator->compileTreeForTesting(shaderStrings, 1, compileOptions);
+    ASSERT_NE(nullptr, mASTRoot) << mTranslator->getInfoSink().info.c_str();
+
+    mCompactTree.build(mASTRoot);
+}
+
+void CompactIntermTreePerfTest::TearDown()
+{
+    mCompactTree.clear();
+    SafeDelete(mTranslator);
+
+    SetGlobalPoolAllocator(nullptr);
+    mAllocator.pop();
+
+    FreePoolIndex();
+
+    ANGLEPerfTest::TearDown();
+}
+
+void CompactIntermTreePerfTest::step()
+{
+    for (unsigned int iteration = 0; iteration < kNumIterationsPerStep; ++iteration)
+    {
+        switch (GetParam())
+        {
+            case WalkMethod::Traverser:
+            {
+                StatisticsTraverser traverser(&mStatistics);
+                mASTRoot->traverse(&traverser);
+                break;
+            }
+            case WalkMethod::CompactTree:
+                GatherStatistics(mCompactTree, &mStatistics);
+                break;
+            case WalkMethod::CompactTreeWithBuild:
+                mCompactTree.build(mASTRoot);
+                GatherStatistics(mCompactTree, &mStatistics);
+                break;
+        }
+    }
+}
+
+// Measures the cost of walking every node of a large shader.
+TEST_P(CompactIntermTreePerfTest, Run)
+{
+    run();
+}
+
+INSTANTIATE_TEST_SUITE_P(,
+                         CompactIntermTreePerfTest,
+                         ::testing::Values(WalkMethod::Traverser,
+                                           WalkMethod::CompactTree,
+                                           WalkMethod::CompactTreeWithBuild),
+                         ::testing::PrintToStringParamName());
+}  // anonymous namespace
@@ -6,12 +6,16 @@
 // CompilerPerfTest:
 //   Performance test for the shader translator. The test initializes the compiler once and then
 //   compiles the same shader repeatedly. There are different variations of the tests using
-//   different shaders.
+//   different shaders.  CompilerInitPerfTest measures creating and initializing compilers, as done
+//   for every context and parallel compile.
 //
 
 #include "ANGLEPerfTest.h"
 
+#include <string>
+
 #include "GLSLANG/ShaderLang.h"
+#include "common/WorkerThread.h"
 #include "compiler/translator/Compiler.h"
 #include "compiler/translator/InitializeGlobals.h"
 #include "compiler/translator/PoolAlloc.h"
@@ -162,6 +166,60 @@ void main()
 
 const char *kTrickyESSL300Id = "TrickyESSL300";
 
+// A large shader made of many similar functions with loops and switches, to measure the
+// transformations that are run on each function body.
+const char *GetManyFunctionsESSL300FragSource()
+{
+    constexpr int kFunctionCount = 128;
+
+    static const std::string source = []() {
+        std::string shader = R"(#version 300 es
+precision highp float;
+uniform vec4 u[16];
+out vec4 outColor;
+)";
+        for (int index = 0; index < kFunctionCount; ++index)
+        {
+            const std::string name = "f" + std::to_string(index);
+            shader += "float " + name + R"((float x)
+{
+    float r = x;
+    for (int i = 0, k = 1; i < 8 && r < 100.0; ++i, k *= 2)
+    {
+        r = r * 1.5 + u[i].x * float(k);
+    }
+    int j = 0;
+    do
+    {
+        r -= u[j].y;
+    } while (++j < 4 && r > 0.5);
+    switch (j)
+    {
+      case 0:
+        r += 1.0;
+        break;
+      default:
+        r -= 1.0;
+    }
+    return r;
+}
+)";
+        }
+        shader += "void main()\n{\n    float a = 0.0;\n";
+        for (int index = 0; index < kFunctionCount; ++index)
+        {
+            shader += "    a += f" + std::to_string(index) + "(u[" + std::to_string(index % 16) +
+                      "].z);\n";
+        }
+        shader += "    outColor = vec4(a);\n}\n";
+        return shader;
+    }();
+
+    return source.c_str();
+}
+
+const char *kManyFunctionsESSL300Id = "ManyFunctionsESSL300";
+
 constexpr int kNumIterationsPerStep = 4;
 
 struct CompilerParameters
@@ -222,15 +280,30 @@ struct CompilerPerfParameters final : public CompilerParameters
 {
     CompilerPerfParameters(ShShaderOutput output,
                            const char *shaderSource,
-                           const char *shaderSourceId)
-        : CompilerParameters(output), shaderSource(shaderSource)
+                           const char *shaderSourceId,
+                           bool parallelFunctionTransformations = false,
+                           bool pageRecycling                   = true)
+        : CompilerParameters(output),
+          shaderSource(shaderSource),
+          parallelFunctionTransformations(parallelFunctionTransformations),
+          pageRecycling(pageRecycling)
     {
         testId = shaderSourceId;
         testId += "_";
         testId += CompilerParameters::str();
+        if (parallelFunctionTransformations)
+        {
+            testId += "_parallel";
+        }
+        if (!pageRecycling)
+        {
+            testId += "_no_page_recycling";
+        }
     }
 
     const char *shaderSource;
+    bool parallelFunctionTransformations;
+    bool pageRecycling;
     std::string testId;
 };
 
@@ -256,6 +329,8 @@ class CompilerPerfTest : public ANGLEPerfTest,
 
   private:
     const char *mTestShader;
+    bool mParallelFunctionTransformations;
+    size_t mThreadPageCacheLimit;
 
     ShBuiltInResources mResources;
     angle::PoolAllocator mAllocator;
@@ -276,6 +351,14 @@ void CompilerPerfTest::SetUp()
 
     const auto &params = GetParam();
 
+    // Disabling the thread's page cache makes every compile allocate its pages from the OS again.
+    mThreadPageCacheLimit = angle::PoolAllocator::GetThreadPageCacheLimit();
+    if (!params.pageRecycling)
+    {
+        angle::PoolAllocator::SetThreadPageCacheLimit(0);
+        angle::PoolAllocator::ReleaseThreadPageCache();
+    }
+
     mTranslator = sh::ConstructCompiler(GL_FRAGMENT_SHADER, SH_WEBGL2_SPEC, params.output);
     sh::InitBuiltInResources(&mResources);
     mResources.FragmentPrecisionHigh = true;
@@ -284,13 +367,34 @@ void CompilerPerfTest::SetUp()
         SafeDelete(mTranslator);
     }
 
+    mParallelFunctionTransformations = params.parallelFunctionTransformations;
+    if (mTranslator && mParallelFunctionTransformations)
+    {
+        mTranslator->setWorkerThreadPool(
+            angle::WorkerThreadPool::Create(0, ANGLEPlatformCurrent()));
+    }
+
     setTestShader(params.shaderSource);
+
+    mReporter->RegisterFyiMetric(".pool_pages_allocated", "count");
+    mReporter->RegisterFyiMetric(".pool_pages_reused", "count");
+    mReporter->RegisterFyiMetric(".pool_peak_bytes", "sizeInBytes");
 }
 
 void CompilerPerfTest::TearDown()
 {
+    if (mTranslator)
+    {
+        const angle::PoolAllocator::Statistics statistics =
+            mTranslator->getPoolAllocatorStatistics();
+        mReporter->AddResult(".pool_pages_allocated", statistics.pagesAllocated);
+        mReporter->AddResult(".pool_pages_reused", statistics.pagesReused);
+        mReporter->AddResult(".pool_peak_bytes", statistics.peakBytes);
+    }
     SafeDelete(mTranslator);
 
+    angle::PoolAllocator::SetThreadPageCacheLimit(mThreadPageCacheLimit);
+
     SetGlobalPoolAllocator(nullptr);
     mAllocator.pop();
 
@@ -307,6 +411,7 @@ void CompilerPerfTest::step()
     compileOptions.objectCode                    = true;
     compileOptions.initializeUninitializedLocals = true;
     compileOptions.initOutputVariables           = true;
+    compileOptions.parallelFunctionTransformations = mParallelFunctionTransformations;
 
 #if !defined(NDEBUG)
     // Make sure that compilation succeeds and print the info log if it doesn't in debug mode.
@@ -343,6 +448,95 @@ ANGLE_INSTANTIATE_TEST(
     CompilerPerfParameters(SH_ESSL_OUTPUT, kSimpleESSL100FragSource, kSimpleESSL100Id),
     CompilerPerfParameters(SH_ESSL_OUTPUT, kSimpleESSL300FragSource, kSimpleESSL300Id),
     CompilerPerfParameters(SH_ESSL_OUTPUT, kRealWorldESSL100FragSource, kRealWorldESSL100Id),
-    CompilerPerfParameters(SH_ESSL_OUTPUT, kTrickyESSL300FragSource, kTrickyESSL300Id));
+    CompilerPerfParameters(SH_ESSL_OUTPUT, kTrickyESSL300FragSource, kTrickyESSL300Id),
+    CompilerPerfParameters(SH_ESSL_OUTPUT,
+                           kRealWorldESSL100FragSource,
+                           kRealWorldESSL100Id,
+                           false,
+                           false),
+    CompilerPerfParameters(SH_ESSL_OUTPUT,
+                           kTrickyESSL300FragSource,
+                           kTrickyESSL300Id,
+                           false,
+                           false),
+    CompilerPerfParameters(SH_ESSL_OUTPUT,
+                           GetManyFunctionsESSL300FragSource(),
+                           kManyFunctionsESSL300Id),
+    CompilerPerfParameters(SH_ESSL_OUTPUT,
+                           GetManyFunctionsESSL300FragSource(),
+                           kManyFunctionsESSL300Id,
+                           true));
+
+
+std::ostream &operator<<(std::ostream &stream, const CompilerParameters &p)
+{
+    stream << p.str();
+    return stream;
+}
+
+class CompilerInitPerfTest : public ANGLEPerfTest,
+                             public ::testing::WithParamInterface<CompilerParameters>
+{
+  public:
+    CompilerInitPerfTest();
+
+    void step() override;
+
+    void SetUp() override;
+    void TearDown() override;
+
+  private:
+    ShBuiltInResources mResources;
+    angle::PoolAllocator mAllocator;
+};
+
+CompilerInitPerfTest::CompilerInitPerfTest()
+    : ANGLEPerfTest("CompilerInitPerf", "", GetParam().str(), kNumIterationsPerStep)
+{}
+
+void CompilerInitPerfTest::SetUp()
+{
+    ANGLEPerfTest::SetUp();
+
+    InitializePoolIndex();
+    mAllocator.push();
+    SetGlobalPoolAllocator(&mAllocator);
+
+    sh::InitBuiltInResources(&mResources);
+    mResources.FragmentPrecisionHigh = true;
+}
+
+void CompilerInitPerfTest::TearDown()
+{
+    SetGlobalPoolAllocator(nullptr);
+    mAllocator.pop();
+
+    FreePoolIndex();
+
+    ANGLEPerfTest::TearDown();
+}
+
+void CompilerInitPerfTest::step()
+{
+    for (unsigned int iteration = 0; iteration < kNumIterationsPerStep; ++iteration)
+    {
+        for (GLenum shaderType : {GL_VERTEX_SHADER, GL_FRAGMENT_SHADER})
+        {
+            sh::TCompiler *translator =
+                sh::ConstructCompiler(shaderType, SH_WEBGL2_SPEC, GetParam().output);
+            EXPECT_TRUE(translator->Init(mResources));
+            SafeDelete(translator);
+        }
+    }
+}
+
+TEST_P(CompilerInitPerfTest, Run)
+{
+    run();
+}
+
+ANGLE_INSTANTIATE_TEST(CompilerInitPerfTest,
+                       CompilerParameters(SH_GLSL_450_CORE_OUTPUT),
+                       CompilerParameters(SH_ESSL_OUTPUT));
 
 }  // anonymous namespace
@@ -0,0 +1,232 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// DescriptorSetChurnPerf:
+//   Performance test for draws that each use a different combination of textures.  Every new
+//   combination needs a new descriptor set in the Vulkan backend, and combinations that are not
+//   used again go stale and must be recycled.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <array>
+#include <sstream>
+
+#include "common/debug.h"
+#include "util/shader_utils.h"
+
+namespace angle
+{
+namespace
+{
+constexpr unsigned int kDrawsPerStep = 256;
+constexpr size_t kSamplerCount       = 4;
+constexpr size_t kTextureCount       = 16;
+
+// Combinations are numbered by their base-kTextureCount digits, one per sampler.  The first
+// kDrawsPerStep combinations are the ones reused every frame, and new combinations are taken from
+// the rest.
+constexpr size_t kCombinationCount = kTextureCount * kTextureCount * kTextureCount * kTextureCount;
+static_assert(kSamplerCount == 4, "kCombinationCount assumes 4 samplers");
+
+struct DescriptorSetChurnParams final : public RenderTestParams
+{
+    DescriptorSetChurnParams()
+    {
+        iterationsPerStep = kDrawsPerStep;
+
+        // Common default params
+        majorVersion = 2;
+        minorVersion = 0;
+        windowWidth  = 256;
+        windowHeight = 256;
+
+        newSetsPerFrame = kDrawsPerStep;
+    }
+
+    std::string story() const override;
+
+    // The number of draws per frame that use a combination of textures that was never used
+    // before.  The other draws use combinations that are used every frame.
+    size_t newSetsPerFrame;
+};
+
+std::ostream &operator<<(std::ostream &os, const DescriptorSetChurnParams &params)
+{
+    os << params.backendAndStory().substr(1);
+    return os;
+}
+
+std::string DescriptorSetChurnParams::story() const
+{
+    std::stringstream strstr;
+
+    strstr << RenderTestParams::story();
+    strstr << "_" << newSetsPerFrame << "_new_sets";
+
+    return strstr.str();
+}
+
+class DescriptorSetChurnBenchmark : public ANGLERenderTest,
+                                    public ::testing::WithParamInterface<DescriptorSetChurnParams>
+{
+  public:
+    DescriptorSetChurnBenchmark();
+
+    void initializeBenchmark() override;
+    void destroyBenchmark() override;
+    void drawBenchmark() override;
+
+  private:
+    void bindCombination(size_t combination);
+
+    GLuint mProgram;
+    std::array<GLuint, kTextureCount> mTextures;
+    // The index of the texture bound to each sampler's texture unit.
+    std::array<size_t, kSamplerCount> mBoundTextures;
+    size_t mNextNewCombination;
+};
+
+DescriptorSetChurnBenchmark::DescriptorSetChurnBenchmark()
+    : ANGLERenderTest("DescriptorSetChurn", GetParam()),
+      mProgram(0),
+      mTextures{},
+      mBoundTextures{},
+      mNextNewCombination(kDrawsPerStep)
+{}
+
+void DescriptorSetChurnBenchmark::initializeBenchmark()
+{
+    std::stringstream fstrstr;
+    fstrstr << "precision mediump float;\n";
+    for (size_t sampler = 0; sampler < kSamplerCount; ++sampler)
+    {
+        fstrstr << "uniform sampler2D tex" << sampler << ";\n";
+    }
+    fstrstr << "void main()\n"
+               "{\n"
+               "    gl_FragColor = vec4(0)";
+    for (size_t sampler = 0; sampler < kSamplerCount; ++sampler)
+    {
+        fstrstr << " + texture2D(tex" << sampler << ", vec2(0))";
+    }
+    fstrstr << ";\n"
+               "}\n";
+
+    mProgram = CompileProgram(essl1_shaders::vs::Simple(), fstrstr.str().c_str());
+    ASSERT_NE(0u, mProgram);
+    glUseProgram(mProgram);
+
+    for (size_t sampler = 0; sampler < kSamplerCount; ++sampler)
+    {
+        std::stringstream uniformName;
+        uniformName << "tex" << sampler;
+
+        GLint location = glGetUniformLocation(mProgram, uniformName.str().c_str());
+        ASSERT_NE(-1, location);
+        glUniform1i(location, static_cast<GLint>(sampler));
+    }
+
+    glGenTextures(static_cast<GLsizei>(kTextureCount), mTextures.data());
+    for (size_t texture = 0; texture < kTextureCount; ++texture)
+    {
+        const GLubyte texel[4] = {static_cast<GLubyte>(texture * 16), 0, 0, 255};
+        glBindTexture(GL_TEXTURE_2D, mTextures[texture]);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, texel);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    }
+
+    for (size_t sampler = 0; sampler < kSamplerCount; ++sampler)
+    {
+        glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + sampler));
+        glBindTexture(GL_TEXTURE_2D, mTextures[0]);
+    }
+
+    glViewport(0, 0, getWindow()->getWidth(), getWindow()->getHeight());
+
+    ASSERT_GL_NO_ERROR();
+}
+
+void DescriptorSetChurnBenchmark::destroyBenchmark()
+{
+    glDeleteTextures(static_cast<GLsizei>(kTextureCount), mTextures.data());
+    glDeleteProgram(mProgram);
+}
+
+void DescriptorSetChurnBenchmark::bindCombination(size_t combination)
+{
+    for (size_t sampler = 0; sampler < kSamplerCount; ++sampler)
+    {
+        const size_t texture = combination % kTextureCount;
+        combination /= kTextureCount;
+
+        // Only the samplers whose texture changes are rebound, as an application would do.
+        if (mBoundTextures[sampler] != texture)
+        {
+            glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + sampler));
+            glBindTexture(GL_TEXTURE_2D, mTextures[texture]);
+            mBoundTextures[sampler] = texture;
+        }
+    }
+}
+
+void DescriptorSetChurnBenchmark::drawBenchmark()
+{
+    const auto &params = GetParam();
+
+    for (size_t draw = 0; draw < params.iterationsPerStep; ++draw)
+    {
+        if (draw < params.newSetsPerFrame)
+        {
+            bindCombination(mNextNewCombination);
+
+            // Once all combinations have been used, start over.  By then, the descriptor sets of
+            // the first ones have long been evicted.
+            if (++mNextNewCombination == kCombinationCount)
+            {
+                mNextNewCombination = kDrawsPerStep;
+            }
+        }
+        else
+        {
+            bindCombination(draw);
+        }
+
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+    }
+
+    ASSERT_GL_NO_ERROR();
+}
+
+DescriptorSetChurnParams VulkanParams(size_t newSetsPerFrame)
+{
+    DescriptorSetChurnParams params;
+    params.eglParameters   = egl_platform::VULKAN_NULL();
+    params.newSetsPerFrame = newSetsPerFrame;
+    return params;
+}
+
+DescriptorSetChurnParams OpenGLOrGLESParams(size_t newSetsPerFrame)
+{
+    DescriptorSetChurnParams params;
+    params.eglParameters   = egl_platform::OPENGL_OR_GLES_NULL();
+    params.newSetsPerFrame = newSetsPerFrame;
+    return params;
+}
+}  // anonymous namespace
+
+TEST_P(DescriptorSetChurnBenchmark, Run)
+{
+    run();
+}
+
+ANGLE_INSTANTIATE_TEST(DescriptorSetChurnBenchmark,
+                       VulkanParams(0),
+                       VulkanParams(32),
+                       VulkanParams(kDrawsPerStep),
+                       OpenGLOrGLESParams(0),
+                       OpenGLOrGLESParams(kDrawsPerStep));
+}  // namespace angle
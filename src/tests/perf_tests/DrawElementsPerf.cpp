@@ -51,11 +51,18 @@ struct DrawElementsPerfParams final : public DrawCallPerfParams
             strstr << "_ushort";
         }
 
+        if (largeIndexBuffer)
+        {
+            strstr << "_large_index_buffer";
+        }
+
         return strstr.str();
     }
 
     GLenum type             = GL_UNSIGNED_INT;
     bool indexBufferChanged = false;
+    // Uses a multi-megabyte index buffer, so that updating it dominates the draw call overhead.
+    bool largeIndexBuffer = false;
 };
 
 std::ostream &operator<<(std::ostream &os, const DrawElementsPerfParams &params)
@@ -124,9 +131,15 @@ void DrawElementsPerfBenchmark::initializeBenchmark()
 
     for (int i = 0; i < mCount; i++)
     {
-        ASSERT_GE(std::numeric_limits<GLushort>::max(), mCount);
-        mShortIndexData.push_back(static_cast<GLushort>(rand() % mCount));
-        mIntIndexData.push_back(rand() % mCount);
+        if (params.type == GL_UNSIGNED_INT)
+        {
+            mIntIndexData.push_back(rand() % mCount);
+        }
+        else
+        {
+            ASSERT_GE(std::numeric_limits<GLushort>::max(), mCount);
+            mShortIndexData.push_back(static_cast<GLushort>(rand() % mCount));
+        }
     }
 
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
@@ -238,6 +251,31 @@ std::vector<P> gWithChange =
     CombineWithValues(gWithRenderer, {false, true}, CombineIndexBufferChanged);
 std::vector<P> gWithDevice = CombineWithFuncs(gWithChange, {Passthrough<P>, NullDevice<P>});
 
-ANGLE_INSTANTIATE_TEST_ARRAY(DrawElementsPerfBenchmark, gWithDevice);
+// Every update of a large index buffer makes the index range be computed again on the next draw.
+P LargeIndexBuffer(const P &in)
+{
+    P out                  = in;
+    out.type               = GL_UNSIGNED_INT;
+    out.indexBufferChanged = true;
+    out.largeIndexBuffer   = true;
+    // 3M indices, or 12MB.
+    out.numTris           = 1024 * 1024;
+    out.iterationsPerStep = 4;
+    return out;
+}
+
+std::vector<P> gLarge = {LargeIndexBuffer(P())};
+std::vector<P> gLargeWithRenderer =
+    CombineWithFuncs(gLarge, {D3D11<P>, GL<P>, Metal<P>, Vulkan<P>, WGL<P>});
+std::vector<P> gLargeWithDevice = CombineWithFuncs(gLargeWithRenderer, {NullDevice<P>});
+
+std::vector<P> GetAllParams()
+{
+    std::vector<P> allParams = gWithDevice;
+    allParams.insert(allParams.end(), gLargeWithDevice.begin(), gLargeWithDevice.end());
+    return allParams;
+}
+
+ANGLE_INSTANTIATE_TEST_ARRAY(DrawElementsPerfBenchmark, GetAllParams());
 
 }  // anonymous namespace
@@ -0,0 +1,116 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// HandleAllocatorPerf:
+//   Performance test for gl::HandleAllocator with many live handles, releasing and allocating
+//   handles every step like an application that creates and deletes many objects per frame.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <random>
+#include <sstream>
+
+#include "libANGLE/HandleAllocator.h"
+
+namespace
+{
+// Number of handles released and allocated again in each step.
+constexpr size_t kChurnPerStep = 10000;
+
+struct HandleAllocatorParams
+{
+    size_t liveHandles;
+    // Whether the handles are reserved by the test, as with glBind* of unallocated names, instead
+    // of being allocated.
+    bool reserve;
+};
+
+std::ostream &operator<<(std::ostream &os, const HandleAllocatorParams &params)
+{
+    os << params.liveHandles << (params.reserve ? "_reserve" : "_allocate");
+    return os;
+}
+
+std::string GetStory(const HandleAllocatorParams &params)
+{
+    std::stringstream strstr;
+    strstr << "_" << params;
+    return strstr.str();
+}
+
+class HandleAllocatorPerfTest : public ANGLEPerfTest,
+                                public ::testing::WithParamInterface<HandleAllocatorParams>
+{
+  public:
+    HandleAllocatorPerfTest();
+
+    void SetUp() override;
+    void step() override;
+
+  private:
+    gl::HandleAllocator mAllocator;
+    std::vector<GLuint> mHandles;
+    std::mt19937 mRandom;
+};
+
+HandleAllocatorPerfTest::HandleAllocatorPerfTest()
+    : ANGLEPerfTest("HandleAllocatorPerf", "", GetStory(GetParam()), 1)
+{}
+
+void HandleAllocatorPerfTest::SetUp()
+{
+    ANGLEPerfTest::SetUp();
+
+    const HandleAllocatorParams &params = GetParam();
+    mHandles.resize(params.liveHandles);
+    for (GLuint &handle : mHandles)
+    {
+        handle = mAllocator.allocate();
+    }
+}
+
+void HandleAllocatorPerfTest::step()
+{
+    const HandleAllocatorParams &params = GetParam();
+
+    // Release handles scattered over the whole range, then allocate or reserve them again.
+    std::uniform_int_distribution<size_t> distribution(0, mHandles.size() - kChurnPerStep);
+    const size_t first  = distribution(mRandom);
+    const size_t stride = (mHandles.size() - first) / kChurnPerStep;
+
+    for (size_t index = 0; index < kChurnPerStep; ++index)
+    {
+        mAllocator.release(mHandles[first + index * stride]);
+    }
+
+    for (size_t index = 0; index < kChurnPerStep; ++index)
+    {
+        GLuint &handle = mHandles[first + index * stride];
+        if (params.reserve)
+        {
+            mAllocator.reserve(handle);
+        }
+        else
+        {
+            handle = mAllocator.allocate();
+        }
+    }
+}
+
+// Measures the cost of releasing and allocating handles among many live ones.
+TEST_P(HandleAllocatorPerfTest, Run)
+{
+    run();
+}
+
+INSTANTIATE_TEST_SUITE_P(,
+                         HandleAllocatorPerfTest,
+                         ::testing::Values(HandleAllocatorParams{100000, false},
+                                           HandleAllocatorParams{100000, true},
+                                           HandleAllocatorParams{1000000, false},
+                                           HandleAllocatorParams{1000000, true}),
+                         ::testing::PrintToStringParamName());
+}  // anonymous namespace
@@ -16,6 +16,9 @@ using namespace angle;
 
 namespace
 {
+// Index buffers of at least this many triangles take several megabytes.
+constexpr unsigned int kLargeNumIndexTris = 1024 * 1024;
+
 struct IndexConversionPerfParams final : public RenderTestParams
 {
     std::string story() const override
@@ -27,6 +30,11 @@ struct IndexConversionPerfParams final : public RenderTestParams
             strstr << "_index_range";
         }
 
+        if (numIndexTris >= kLargeNumIndexTris)
+        {
+            strstr << "_large";
+        }
+
         strstr << RenderTestParams::story();
 
         return strstr.str();
@@ -211,6 +219,15 @@ IndexConversionPerfParams IndexRangeOffsetPerfD3D11Params()
     return params;
 }
 
+// Converts a 6MB index buffer every frame, which also computes its index range.
+IndexConversionPerfParams IndexConversionLargePerfD3D11Params()
+{
+    IndexConversionPerfParams params = IndexConversionPerfD3D11Params();
+    params.iterationsPerStep         = 2;
+    params.numIndexTris              = kLargeNumIndexTris;
+    return params;
+}
+
 TEST_P(IndexConversionPerfTest, Run)
 {
     run();
@@ -218,6 +235,7 @@ TEST_P(IndexConversionPerfTest, Run)
 
 ANGLE_INSTANTIATE_TEST(IndexConversionPerfTest,
                        IndexConversionPerfD3D11Params(),
+                       IndexConversionLargePerfD3D11Params(),
                        IndexRangeOffsetPerfD3D11Params());
 
 // This test suite is not instantiated on some OSes.
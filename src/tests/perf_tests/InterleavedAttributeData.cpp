@@ -7,6 +7,7 @@
 //   Performance test for draws using interleaved attribute data in vertex buffers.
 //
 
+#include <cstring>
 #include <sstream>
 
 #include "ANGLEPerfTest.h"
@@ -29,10 +30,17 @@ struct InterleavedAttributeDataParams final : public RenderTestParams
         windowWidth  = 512;
         windowHeight = 512;
         numSprites   = 3000;
+        colorType    = GL_UNSIGNED_BYTE;
+        clientArrays = false;
     }
 
     // static parameters
     unsigned int numSprites;
+    // The type of the normalized color components, GL_UNSIGNED_BYTE or GL_SHORT.
+    GLenum colorType;
+    // Whether the attributes are read from client memory rather than from buffers, in which case
+    // they are streamed again on every draw.
+    bool clientArrays;
 };
 
 std::ostream &operator<<(std::ostream &os, const InterleavedAttributeDataParams &params)
@@ -44,6 +52,16 @@ std::ostream &operator<<(std::ostream &os, const InterleavedAttributeDataParams
         os << "_" << params.eglParameters.majorVersion << "_" << params.eglParameters.minorVersion;
     }
 
+    if (params.colorType == GL_SHORT)
+    {
+        os << "_short_color";
+    }
+
+    if (params.clientArrays)
+    {
+        os << "_client_arrays";
+    }
+
     return os;
 }
 
@@ -61,16 +79,22 @@ class InterleavedAttributeDataBenchmark
   private:
     GLuint mPointSpriteProgram;
     GLuint mPositionColorBuffer[2];
+    std::vector<uint8_t> mPositionColorData[2];
 
-    // The buffers contain two floats and 3 unsigned bytes per point sprite
+    // The buffers contain two floats and 3 color components per point sprite
     // Has to be aligned for float access on arm
-    const size_t mBytesPerSpriteUnaligned = 2 * sizeof(float) + 3;
-    const size_t mBytesPerSprite =
-        ((mBytesPerSpriteUnaligned + sizeof(float) - 1) / sizeof(float)) * sizeof(float);
+    const size_t mColorComponentSize;
+    const size_t mBytesPerSpriteUnaligned;
+    const size_t mBytesPerSprite;
 };
 
 InterleavedAttributeDataBenchmark::InterleavedAttributeDataBenchmark()
-    : ANGLERenderTest("InterleavedAttributeData", GetParam()), mPointSpriteProgram(0)
+    : ANGLERenderTest("InterleavedAttributeData", GetParam()),
+      mPointSpriteProgram(0),
+      mColorComponentSize(GetParam().colorType == GL_SHORT ? sizeof(GLshort) : sizeof(GLubyte)),
+      mBytesPerSpriteUnaligned(2 * sizeof(float) + 3 * mColorComponentSize),
+      mBytesPerSprite(((mBytesPerSpriteUnaligned + sizeof(float) - 1) / sizeof(float)) *
+                      sizeof(float))
 {
     if (GetParam().eglParameters.renderer == EGL_PLATFORM_ANGLE_TYPE_OPENGL_ANGLE)
     {
@@ -110,7 +134,8 @@ void InterleavedAttributeDataBenchmark::initializeBenchmark()
     for (size_t i = 0; i < ArraySize(mPositionColorBuffer); i++)
     {
         // Set up initial data for pointsprite positions and colors
-        std::vector<uint8_t> positionColorData(mBytesPerSprite * params.numSprites);
+        std::vector<uint8_t> &positionColorData = mPositionColorData[i];
+        positionColorData.resize(mBytesPerSprite * params.numSprites);
         for (unsigned int j = 0; j < params.numSprites; j++)
         {
             float pointSpriteX =
@@ -121,9 +146,7 @@ void InterleavedAttributeDataBenchmark::initializeBenchmark()
                 (static_cast<float>(rand() % getWindow()->getHeight()) / getWindow()->getHeight()) *
                     2.0f -
                 1.0f;
-            GLubyte pointSpriteRed   = static_cast<GLubyte>(rand() % 255);
-            GLubyte pointSpriteGreen = static_cast<GLubyte>(rand() % 255);
-            GLubyte pointSpriteBlue  = static_cast<GLubyte>(rand() % 255);
+            const int pointSpriteColor[3] = {rand() % 255, rand() % 255, rand() % 255};
 
             // Add position data for the pointsprite
             *reinterpret_cast<float *>(
@@ -133,10 +156,21 @@ void InterleavedAttributeDataBenchmark::initializeBenchmark()
                 &(positionColorData[j * mBytesPerSprite + 1 * sizeof(float) + 0])) =
                 pointSpriteY;  // Y
 
-            // Add color data for the pointsprite
-            positionColorData[j * mBytesPerSprite + 2 * sizeof(float) + 0] = pointSpriteRed;    // R
-            positionColorData[j * mBytesPerSprite + 2 * sizeof(float) + 1] = pointSpriteGreen;  // G
-            positionColorData[j * mBytesPerSprite + 2 * sizeof(float) + 2] = pointSpriteBlue;   // B
+            // Add color data for the pointsprite, scaled to the range of shorts if needed
+            for (size_t component = 0; component < 3; component++)
+            {
+                uint8_t *colorData = &positionColorData[j * mBytesPerSprite + 2 * sizeof(float) +
+                                                        component * mColorComponentSize];
+                if (mColorComponentSize == sizeof(GLshort))
+                {
+                    const GLshort color = static_cast<GLshort>(pointSpriteColor[component] * 128);
+                    memcpy(colorData, &color, sizeof(color));
+                }
+                else
+                {
+                    *colorData = static_cast<GLubyte>(pointSpriteColor[component]);
+                }
+            }
         }
 
         // Generate the GL buffer with the position/color data
@@ -174,19 +208,27 @@ void InterleavedAttributeDataBenchmark::drawBenchmark()
             GLint colorLocation = glGetAttribLocation(mPointSpriteProgram, "aColor");
             ASSERT_NE(colorLocation, -1);
 
+            const size_t colorIndex = (i + 1) % ArraySize(mPositionColorBuffer);
+            const GLsizei stride    = static_cast<GLsizei>(mBytesPerSprite);
+
+            // With client arrays, the attributes point into client memory instead of being offsets
+            // in the buffers.
+            const bool clientArrays     = GetParam().clientArrays;
+            const void *positionPointer = clientArrays ? mPositionColorData[i].data() : nullptr;
+            const void *colorPointer =
+                clientArrays ? mPositionColorData[colorIndex].data() + 2 * sizeof(float)
+                             : reinterpret_cast<const void *>(2 * sizeof(float));
+
             // Bind the position data from one buffer
-            glBindBuffer(GL_ARRAY_BUFFER, mPositionColorBuffer[i]);
+            glBindBuffer(GL_ARRAY_BUFFER, clientArrays ? 0 : mPositionColorBuffer[i]);
             glEnableVertexAttribArray(positionLocation);
-            glVertexAttribPointer(positionLocation, 2, GL_FLOAT, GL_FALSE,
-                                  static_cast<GLsizei>(mBytesPerSprite), 0);
+            glVertexAttribPointer(positionLocation, 2, GL_FLOAT, GL_FALSE, stride, positionPointer);
 
             // But bind the color data from the other buffer.
-            glBindBuffer(GL_ARRAY_BUFFER,
-                         mPositionColorBuffer[(i + 1) % ArraySize(mPositionColorBuffer)]);
+            glBindBuffer(GL_ARRAY_BUFFER, clientArrays ? 0 : mPositionColorBuffer[colorIndex]);
             glEnableVertexAttribArray(colorLocation);
-            glVertexAttribPointer(colorLocation, 3, GL_UNSIGNED_BYTE, GL_TRUE,
-                                  static_cast<GLsizei>(mBytesPerSprite),
-                                  reinterpret_cast<void *>(2 * sizeof(float)));
+            glVertexAttribPointer(colorLocation, 3, GetParam().colorType, GL_TRUE, stride,
+                                  colorPointer);
 
             // Then draw the colored pointsprites
             glDrawArrays(GL_POINTS, 0, GetParam().numSprites);
@@ -232,10 +274,20 @@ InterleavedAttributeDataParams VulkanParams()
     return params;
 }
 
+InterleavedAttributeDataParams ClientArrays(InterleavedAttributeDataParams params, GLenum colorType)
+{
+    params.colorType    = colorType;
+    params.clientArrays = true;
+    return params;
+}
+
 ANGLE_INSTANTIATE_TEST(InterleavedAttributeDataBenchmark,
                        D3D11Params(),
                        MetalParams(),
                        OpenGLOrGLESParams(),
-                       VulkanParams());
+                       VulkanParams(),
+                       ClientArrays(OpenGLOrGLESParams(), GL_UNSIGNED_BYTE),
+                       ClientArrays(VulkanParams(), GL_UNSIGNED_BYTE),
+                       ClientArrays(VulkanParams(), GL_SHORT));
 
 }  // anonymous namespace
@@ -35,18 +35,29 @@ enum class ThreadOption
     Unspecified
 };
 
+enum class StageOption
+{
+    // Vertex and fragment shaders
+    VertexFragment,
+    // Vertex, tessellation, geometry and fragment shaders
+    AllGraphicsStages,
+};
+
 struct LinkProgramParams final : public RenderTestParams
 {
-    LinkProgramParams(TaskOption taskOptionIn, ThreadOption threadOptionIn)
+    LinkProgramParams(TaskOption taskOptionIn,
+                      ThreadOption threadOptionIn,
+                      StageOption stageOptionIn = StageOption::VertexFragment)
     {
         iterationsPerStep = 1;
 
-        majorVersion = 2;
-        minorVersion = 0;
+        majorVersion = stageOptionIn == StageOption::AllGraphicsStages ? 3 : 2;
+        minorVersion = stageOptionIn == StageOption::AllGraphicsStages ? 2 : 0;
         windowWidth  = 256;
         windowHeight = 256;
         taskOption   = taskOptionIn;
         threadOption = threadOptionIn;
+        stageOption  = stageOptionIn;
     }
 
     std::string story() const override
@@ -72,6 +83,11 @@ struct LinkProgramParams final : public RenderTestParams
             strstr << "_multi_thread";
         }
 
+        if (stageOption == StageOption::AllGraphicsStages)
+        {
+            strstr << "_all_stages";
+        }
+
         if (eglParameters.deviceType == EGL_PLATFORM_ANGLE_DEVICE_TYPE_NULL_ANGLE)
         {
             strstr << "_null";
@@ -82,6 +98,7 @@ struct LinkProgramParams final : public RenderTestParams
 
     TaskOption taskOption;
     ThreadOption threadOption;
+    StageOption stageOption;
 };
 
 std::ostream &operator<<(std::ostream &os, const LinkProgramParams &params)
@@ -148,25 +165,88 @@ void LinkProgramBenchmark::drawBenchmark()
         "void main() {\n"
         "    gl_FragColor = vec4(1, 0, 0, 1);\n"
         "}";
-    GLuint vs = CompileShader(GL_VERTEX_SHADER, vertexShader);
-    GLuint fs = CompileShader(GL_FRAGMENT_SHADER, fragmentShader);
 
-    ASSERT_NE(0u, vs);
-    ASSERT_NE(0u, fs);
+    static const char *es32VertexShader =
+        "#version 320 es\n"
+        "in vec2 position;\n"
+        "void main() {\n"
+        "    gl_Position = vec4(position, 0, 1);\n"
+        "}";
+    static const char *es32TessControlShader =
+        "#version 320 es\n"
+        "layout(vertices = 3) out;\n"
+        "void main() {\n"
+        "    gl_out[gl_InvocationID].gl_Position = gl_in[gl_InvocationID].gl_Position;\n"
+        "    gl_TessLevelInner[0] = 1.0;\n"
+        "    gl_TessLevelOuter[0] = 1.0;\n"
+        "    gl_TessLevelOuter[1] = 1.0;\n"
+        "    gl_TessLevelOuter[2] = 1.0;\n"
+        "}";
+    static const char *es32TessEvaluationShader =
+        "#version 320 es\n"
+        "layout(triangles, equal_spacing, cw) in;\n"
+        "void main() {\n"
+        "    gl_Position = gl_TessCoord.x * gl_in[0].gl_Position +\n"
+        "                  gl_TessCoord.y * gl_in[1].gl_Position +\n"
+        "                  gl_TessCoord.z * gl_in[2].gl_Position;\n"
+        "}";
+    static const char *es32GeometryShader =
+        "#version 320 es\n"
+        "layout(triangles) in;\n"
+        "layout(triangle_strip, max_vertices = 3) out;\n"
+        "void main() {\n"
+        "    for (int i = 0; i < 3; ++i) {\n"
+        "        gl_Position = gl_in[i].gl_Position;\n"
+        "        EmitVertex();\n"
+        "    }\n"
+        "    EndPrimitive();\n"
+        "}";
+    static const char *es32FragmentShader =
+        "#version 320 es\n"
+        "precision mediump float;\n"
+        "out vec4 color;\n"
+        "void main() {\n"
+        "    color = vec4(1, 0, 0, 1);\n"
+        "}";
+
+    const bool allGraphicsStages = GetParam().stageOption == StageOption::AllGraphicsStages;
+
+    std::vector<GLuint> shaders;
+    if (allGraphicsStages)
+    {
+        shaders.push_back(CompileShader(GL_VERTEX_SHADER, es32VertexShader));
+        shaders.push_back(CompileShader(GL_TESS_CONTROL_SHADER, es32TessControlShader));
+        shaders.push_back(CompileShader(GL_TESS_EVALUATION_SHADER, es32TessEvaluationShader));
+        shaders.push_back(CompileShader(GL_GEOMETRY_SHADER, es32GeometryShader));
+        shaders.push_back(CompileShader(GL_FRAGMENT_SHADER, es32FragmentShader));
+    }
+    else
+    {
+        shaders.push_back(CompileShader(GL_VERTEX_SHADER, vertexShader));
+        shaders.push_back(CompileShader(GL_FRAGMENT_SHADER, fragmentShader));
+    }
+
+    for (GLuint shader : shaders)
+    {
+        ASSERT_NE(0u, shader);
+    }
     if (GetParam().taskOption == TaskOption::CompileOnly)
     {
-        glDeleteShader(vs);
-        glDeleteShader(fs);
+        for (GLuint shader : shaders)
+        {
+            glDeleteShader(shader);
+        }
         return;
     }
 
     GLuint program = glCreateProgram();
     ASSERT_NE(0u, program);
 
-    glAttachShader(program, vs);
-    glDeleteShader(vs);
-    glAttachShader(program, fs);
-    glDeleteShader(fs);
+    for (GLuint shader : shaders)
+    {
+        glAttachShader(program, shader);
+        glDeleteShader(shader);
+    }
     glLinkProgram(program);
     glUseProgram(program);
 
@@ -175,7 +255,15 @@ void LinkProgramBenchmark::drawBenchmark()
     glEnableVertexAttribArray(positionLoc);
 
     // Draw with the program to ensure the shader gets compiled and used.
-    glDrawArrays(GL_TRIANGLES, 0, 6);
+    if (allGraphicsStages)
+    {
+        glPatchParameteri(GL_PATCH_VERTICES, 3);
+        glDrawArrays(GL_PATCHES, 0, 6);
+    }
+    else
+    {
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+    }
 
     glDeleteProgram(program);
 }
@@ -203,9 +291,11 @@ LinkProgramParams LinkProgramOpenGLOrGLESParams(TaskOption taskOption, ThreadOpt
     return params;
 }
 
-LinkProgramParams LinkProgramVulkanParams(TaskOption taskOption, ThreadOption threadOption)
+LinkProgramParams LinkProgramVulkanParams(TaskOption taskOption,
+                                          ThreadOption threadOption,
+                                          StageOption stageOption = StageOption::VertexFragment)
 {
-    LinkProgramParams params(taskOption, threadOption);
+    LinkProgramParams params(taskOption, threadOption, stageOption);
     params.eglParameters = VULKAN();
     return params;
 }
@@ -232,6 +322,12 @@ ANGLE_INSTANTIATE_TEST(
     LinkProgramD3D11Params(TaskOption::CompileAndLink, ThreadOption::SingleThread),
     LinkProgramMetalParams(TaskOption::CompileAndLink, ThreadOption::SingleThread),
     LinkProgramOpenGLOrGLESParams(TaskOption::CompileAndLink, ThreadOption::SingleThread),
-    LinkProgramVulkanParams(TaskOption::CompileAndLink, ThreadOption::SingleThread));
+    LinkProgramVulkanParams(TaskOption::CompileAndLink, ThreadOption::SingleThread),
+    LinkProgramVulkanParams(TaskOption::CompileAndLink,
+                            ThreadOption::MultiThread,
+                            StageOption::AllGraphicsStages),
+    LinkProgramVulkanParams(TaskOption::CompileAndLink,
+                            ThreadOption::SingleThread,
+                            StageOption::AllGraphicsStages));
 
 }  // anonymous namespace
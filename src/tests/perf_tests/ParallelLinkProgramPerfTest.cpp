@@ -73,6 +73,14 @@ struct ParallelLinkProgramParams final : public RenderTestParams
             strstr << "_serial";
         }
 
+        if (std::find(eglParameters.enabledFeatureOverrides.begin(),
+                      eglParameters.enabledFeatureOverrides.end(),
+                      Feature::UseWorkStealingWorkerPool) !=
+            eglParameters.enabledFeatureOverrides.end())
+        {
+            strstr << "_work_stealing";
+        }
+
         if (eglParameters.deviceType == EGL_PLATFORM_ANGLE_DEVICE_TYPE_NULL_ANGLE)
         {
             strstr << "_null";
@@ -325,6 +333,13 @@ ParallelLinkProgramParams ParallelLinkProgramVulkanParams(CompileLinkOrder compi
     return params;
 }
 
+ParallelLinkProgramParams WorkStealingLinkProgramVulkanParams(CompileLinkOrder compileLinkOrder)
+{
+    ParallelLinkProgramParams params = ParallelLinkProgramVulkanParams(compileLinkOrder);
+    params.enable(Feature::UseWorkStealingWorkerPool);
+    return params;
+}
+
 ParallelLinkProgramParams SerialLinkProgramVulkanParams(CompileLinkOrder compileLinkOrder)
 {
     ParallelLinkProgramParams params(compileLinkOrder);
@@ -350,6 +365,9 @@ ANGLE_INSTANTIATE_TEST(
     ParallelLinkProgramVulkanParams(CompileLinkOrder::AllCompilesFirst),
     ParallelLinkProgramVulkanParams(CompileLinkOrder::Interleaved),
     ParallelLinkProgramVulkanParams(CompileLinkOrder::InterleavedAndImmediateQuery),
+    WorkStealingLinkProgramVulkanParams(CompileLinkOrder::AllCompilesFirst),
+    WorkStealingLinkProgramVulkanParams(CompileLinkOrder::Interleaved),
+    WorkStealingLinkProgramVulkanParams(CompileLinkOrder::InterleavedAndImmediateQuery),
     SerialLinkProgramVulkanParams(CompileLinkOrder::AllCompilesFirst),
     SerialLinkProgramVulkanParams(CompileLinkOrder::Interleaved),
     SerialLinkProgramVulkanParams(CompileLinkOrder::InterleavedAndImmediateQuery));
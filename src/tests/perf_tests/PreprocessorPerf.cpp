@@ -0,0 +1,174 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PreprocessorPerf:
+//   Performance test for the shader preprocessor.  The shaders are similar to the ones generated by
+//   material systems, which are either heavy in macros or have them already expanded.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <sstream>
+
+#include "compiler/preprocessor/DiagnosticsBase.h"
+#include "compiler/preprocessor/DirectiveHandlerBase.h"
+#include "compiler/preprocessor/Preprocessor.h"
+#include "compiler/preprocessor/Token.h"
+
+namespace
+{
+constexpr unsigned int kNumIterationsPerStep = 10;
+constexpr int kLayerCount                    = 500;
+
+enum class ShaderStyle
+{
+    // Every layer is blended with nested function-like macros in conditional blocks.
+    MacroHeavy,
+    // The same shader with the macros expanded by hand.
+    Expanded,
+};
+
+std::ostream &operator<<(std::ostream &os, ShaderStyle style)
+{
+    os << (style == ShaderStyle::MacroHeavy ? "macro_heavy" : "expanded");
+    return os;
+}
+
+std::string GenerateShader(ShaderStyle style)
+{
+    std::stringstream shader;
+    shader << "#version 300 es\n"
+              "precision highp float;\n"
+              "uniform sampler2D materialTexture;\n"
+              "uniform struct { vec2 scale; vec2 bias; } materialParameters;\n"
+              "uniform float layerWeights[4];\n"
+              "in vec4 vertexCoordinates0, vertexCoordinates1, vertexCoordinates2, "
+              "vertexCoordinates3;\n"
+              "out vec4 color;\n";
+
+    if (style == ShaderStyle::MacroHeavy)
+    {
+        shader << "#define MATERIAL_LAYER_COUNT 6\n"
+                  "#define MATERIAL_SCALE(value) ((value) * materialParameters.scale + "
+                  "materialParameters.bias)\n"
+                  "#define MATERIAL_SAMPLE(coordinates) texture(materialTexture, "
+                  "MATERIAL_SCALE(coordinates))\n"
+                  "#define MATERIAL_BLEND(accumulated, coordinates, weight) accumulated = "
+                  "mix(accumulated, MATERIAL_SAMPLE(coordinates), weight)\n";
+    }
+
+    shader << "void main()\n"
+              "{\n"
+              "    color = vec4(0);\n";
+    for (int layer = 0; layer < kLayerCount; ++layer)
+    {
+        const int index = layer % 4;
+        if (style == ShaderStyle::MacroHeavy)
+        {
+            shader << "#if MATERIAL_LAYER_COUNT > " << layer % 8 << "\n"
+                   << "    MATERIAL_BLEND(color, vertexCoordinates" << index << ".xy, layerWeights["
+                   << index << "]);\n"
+                   << "#endif\n";
+        }
+        else if (layer % 8 < 6)
+        {
+            shader << "    color = mix(color, texture(materialTexture, ((vertexCoordinates" << index
+                   << ".xy) * materialParameters.scale + materialParameters.bias)), layerWeights["
+                   << index << "]);\n";
+        }
+    }
+    shader << "}\n";
+
+    return shader.str();
+}
+
+class NullDiagnostics : public angle::pp::Diagnostics
+{
+  protected:
+    void print(ID id, const angle::pp::SourceLocation &loc, const std::string &text) override {}
+};
+
+class NullDirectiveHandler : public angle::pp::DirectiveHandler
+{
+  public:
+    void handleError(const angle::pp::SourceLocation &loc, const std::string &msg) override {}
+    void handlePragma(const angle::pp::SourceLocation &loc,
+                      const std::string &name,
+                      const std::string &value,
+                      bool stdgl) override
+    {}
+    void handleExtension(const angle::pp::SourceLocation &loc,
+                         const std::string &name,
+                         const std::string &behavior) override
+    {}
+    void handleVersion(const angle::pp::SourceLocation &loc,
+                       int version,
+                       ShShaderSpec spec,
+                       angle::pp::MacroSet *macroSet) override
+    {}
+};
+
+std::string GetStory(ShaderStyle style)
+{
+    std::stringstream strstr;
+    strstr << "_" << style;
+    return strstr.str();
+}
+
+class PreprocessorPerfTest : public ANGLEPerfTest, public ::testing::WithParamInterface<ShaderStyle>
+{
+  public:
+    PreprocessorPerfTest();
+
+    void SetUp() override;
+    void step() override;
+
+  private:
+    std::string mShader;
+    size_t mTokenCount = 0;
+};
+
+PreprocessorPerfTest::PreprocessorPerfTest()
+    : ANGLEPerfTest("PreprocessorPerf", "", GetStory(GetParam()), kNumIterationsPerStep)
+{}
+
+void PreprocessorPerfTest::SetUp()
+{
+    ANGLEPerfTest::SetUp();
+    mShader = GenerateShader(GetParam());
+}
+
+void PreprocessorPerfTest::step()
+{
+    const char *shaderStrings[] = {mShader.c_str()};
+
+    for (unsigned int iteration = 0; iteration < kNumIterationsPerStep; ++iteration)
+    {
+        NullDiagnostics diagnostics;
+        NullDirectiveHandler directiveHandler;
+        angle::pp::Preprocessor preprocessor(&diagnostics, &directiveHandler,
+                                             angle::pp::PreprocessorSettings(SH_GLES3_SPEC));
+        preprocessor.init(1, shaderStrings, nullptr);
+
+        angle::pp::Token token;
+        do
+        {
+            preprocessor.lex(&token);
+            ++mTokenCount;
+        } while (token.type != angle::pp::Token::LAST);
+    }
+}
+
+// Measures the cost of preprocessing a shader into tokens, as the translator's lexer does.
+TEST_P(PreprocessorPerfTest, Run)
+{
+    run();
+}
+
+INSTANTIATE_TEST_SUITE_P(,
+                         PreprocessorPerfTest,
+                         ::testing::Values(ShaderStyle::MacroHeavy, ShaderStyle::Expanded),
+                         ::testing::PrintToStringParamName());
+}  // anonymous namespace
@@ -0,0 +1,168 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ResourceMapPerf:
+//   Performance test for gl::ResourceMap lookups, as done by glBind* calls, with many live objects
+//   whose ids are either allocated sequentially or spread over the whole range of values.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <random>
+#include <sstream>
+
+#include "libANGLE/ResourceMap.h"
+
+namespace
+{
+constexpr size_t kLiveObjects    = 50000;
+constexpr size_t kLookupsPerStep = 100000;
+// Number of objects deleted and created again in each step.
+constexpr size_t kChurnPerStep   = 1000;
+
+enum class IdLayout
+{
+    // Ids from 1 to kLiveObjects, which are in the flat and paged ranges of the map.
+    Sequential,
+    // Random ids, which are mostly in the hashed range of the map.
+    Sparse,
+};
+
+struct ResourceMapPerfParams
+{
+    IdLayout idLayout;
+    // Whether the map is one that needs a lock, such as the buffer map.
+    bool locked;
+};
+
+std::ostream &operator<<(std::ostream &os, const ResourceMapPerfParams &params)
+{
+    os << (params.idLayout == IdLayout::Sequential ? "sequential" : "sparse")
+       << (params.locked ? "_locked" : "_lockless");
+    return os;
+}
+
+std::string GetStory(const ResourceMapPerfParams &params)
+{
+    std::stringstream strstr;
+    strstr << "_" << params;
+    return strstr.str();
+}
+
+class ResourceMapPerfTest : public ANGLEPerfTest,
+                            public ::testing::WithParamInterface<ResourceMapPerfParams>
+{
+  public:
+    ResourceMapPerfTest();
+
+    void SetUp() override;
+    void TearDown() override;
+    void step() override;
+
+  private:
+    template <typename ResourceType, typename IDType>
+    void runStep(gl::ResourceMap<ResourceType, IDType> *resourceMap);
+
+    // The values are never dereferenced.
+    template <typename ResourceType>
+    static ResourceType *FakeResource(GLuint id)
+    {
+        return reinterpret_cast<ResourceType *>(static_cast<uintptr_t>(id) * 16 + 16);
+    }
+
+    gl::ResourceMap<gl::Buffer, gl::BufferID> mLockedMap;
+    gl::ResourceMap<gl::Texture, gl::TextureID> mLocklessMap;
+    std::vector<GLuint> mIds;
+    std::vector<uint32_t> mLookupOrder;
+    std::mt19937 mRandom;
+    size_t mFoundCount = 0;
+};
+
+ResourceMapPerfTest::ResourceMapPerfTest()
+    : ANGLEPerfTest("ResourceMapPerf", "", GetStory(GetParam()), 1)
+{}
+
+void ResourceMapPerfTest::SetUp()
+{
+    ANGLEPerfTest::SetUp();
+
+    const ResourceMapPerfParams &params = GetParam();
+
+    mIds.resize(kLiveObjects);
+    std::uniform_int_distribution<GLuint> sparseDistribution(1, 0x7FFFFFFF);
+    for (size_t index = 0; index < kLiveObjects; ++index)
+    {
+        mIds[index] = params.idLayout == IdLayout::Sequential ? static_cast<GLuint>(index + 1)
+                                                              : sparseDistribution(mRandom);
+    }
+
+    for (GLuint id : mIds)
+    {
+        mLockedMap.assign({id}, FakeResource<gl::Buffer>(id));
+        mLocklessMap.assign({id}, FakeResource<gl::Texture>(id));
+    }
+
+    // Bind the objects in a random order, so the lookups don't benefit from prefetching.
+    std::uniform_int_distribution<uint32_t> lookupDistribution(0, kLiveObjects - 1);
+    mLookupOrder.resize(kLookupsPerStep);
+    for (uint32_t &index : mLookupOrder)
+    {
+        index = lookupDistribution(mRandom);
+    }
+}
+
+void ResourceMapPerfTest::TearDown()
+{
+    mLockedMap.clear();
+    mLocklessMap.clear();
+    ANGLEPerfTest::TearDown();
+}
+
+template <typename ResourceType, typename IDType>
+void ResourceMapPerfTest::runStep(gl::ResourceMap<ResourceType, IDType> *resourceMap)
+{
+    for (uint32_t index : mLookupOrder)
+    {
+        mFoundCount += resourceMap->query({mIds[index]}) != nullptr;
+    }
+
+    // Delete and recreate a few objects, as applications do every frame.
+    std::uniform_int_distribution<size_t> churnDistribution(0, kLiveObjects - 1);
+    for (size_t churn = 0; churn < kChurnPerStep; ++churn)
+    {
+        const GLuint id = mIds[churnDistribution(mRandom)];
+
+        ResourceType *resource = nullptr;
+        resourceMap->erase({id}, &resource);
+        resourceMap->assign({id}, resource);
+    }
+}
+
+void ResourceMapPerfTest::step()
+{
+    if (GetParam().locked)
+    {
+        runStep(&mLockedMap);
+    }
+    else
+    {
+        runStep(&mLocklessMap);
+    }
+}
+
+// Measures the cost of looking up objects in a resource map.
+TEST_P(ResourceMapPerfTest, Run)
+{
+    run();
+}
+
+INSTANTIATE_TEST_SUITE_P(,
+                         ResourceMapPerfTest,
+                         ::testing::Values(ResourceMapPerfParams{IdLayout::Sequential, false},
+                                           ResourceMapPerfParams{IdLayout::Sequential, true},
+                                           ResourceMapPerfParams{IdLayout::Sparse, false},
+                                           ResourceMapPerfParams{IdLayout::Sparse, true}),
+                         ::testing::PrintToStringParamName());
+}  // anonymous namespace
@@ -34,6 +34,8 @@ struct TextureUploadParams final : public RenderTestParams
         subImageSize = 64;
 
         webgl = false;
+
+        format = GL_NONE;
     }
 
     std::string story() const override;
@@ -42,8 +44,50 @@ struct TextureUploadParams final : public RenderTestParams
     GLsizei subImageSize;
 
     bool webgl;
+
+    // Unsized format of the uploaded data, for the benchmarks that test per-format throughput.
+    GLenum format;
 };
 
+GLuint GetFormatPixelBytes(GLenum format)
+{
+    switch (format)
+    {
+        case GL_RGBA:
+            return 4;
+        case GL_RGB:
+            return 3;
+        case GL_LUMINANCE_ALPHA:
+            return 2;
+        case GL_LUMINANCE:
+        case GL_ALPHA:
+            return 1;
+        default:
+            UNREACHABLE();
+            return 0;
+    }
+}
+
+const char *GetFormatStory(GLenum format)
+{
+    switch (format)
+    {
+        case GL_RGBA:
+            return "_rgba";
+        case GL_RGB:
+            return "_rgb";
+        case GL_LUMINANCE_ALPHA:
+            return "_luminance_alpha";
+        case GL_LUMINANCE:
+            return "_luminance";
+        case GL_ALPHA:
+            return "_alpha";
+        default:
+            UNREACHABLE();
+            return "";
+    }
+}
+
 std::ostream &operator<<(std::ostream &os, const TextureUploadParams &params)
 {
     os << params.backendAndStory().substr(1);
@@ -61,6 +105,11 @@ std::string TextureUploadParams::story() const
         strstr << "_webgl";
     }
 
+    if (format != GL_NONE)
+    {
+        strstr << GetFormatStory(format);
+    }
+
     return strstr.str();
 }
 
@@ -108,6 +157,93 @@ class TextureUploadSubImageBenchmark : public TextureUploadBenchmarkBase
     void drawBenchmark() override;
 };
 
+// Uploads the whole texture every iteration to measure the throughput of converting each format.
+class TextureUploadFormatBenchmark : public TextureUploadBenchmarkBase
+{
+  public:
+    TextureUploadFormatBenchmark() : TextureUploadBenchmarkBase("TexSubImageFormat")
+    {
+        const auto &params = GetParam();
+        setBytesPerIteration(params.baseSize * params.baseSize *
+                             GetFormatPixelBytes(params.format));
+    }
+
+    void initializeBenchmark() override
+    {
+        TextureUploadBenchmarkBase::initializeBenchmark();
+
+        const auto &params = GetParam();
+        glTexImage2D(GL_TEXTURE_2D, 0, params.format, params.baseSize, params.baseSize, 0,
+                     params.format, GL_UNSIGNED_BYTE, nullptr);
+    }
+
+    void drawBenchmark() override;
+};
+
+// Uploads a row of adjacent tiles every iteration, as done when streaming video or updating a
+// texture atlas.
+class TextureUploadTileStreamingBenchmark : public TextureUploadBenchmarkBase
+{
+  public:
+    TextureUploadTileStreamingBenchmark() : TextureUploadBenchmarkBase("TexSubImageTiles")
+    {
+        addExtensionPrerequisite("GL_EXT_texture_storage");
+
+        const auto &params = GetParam();
+        setBytesPerIteration(params.baseSize * params.subImageSize * 4);
+    }
+
+    void initializeBenchmark() override
+    {
+        TextureUploadBenchmarkBase::initializeBenchmark();
+
+        const auto &params = GetParam();
+        glTexStorage2DEXT(GL_TEXTURE_2D, 1, GL_RGBA8, params.baseSize, params.baseSize);
+
+        // The Vulkan back end reports how many of the tile copies it merges into the copy of
+        // another tile, and how much staging memory the uploads need.
+        if (params.getRenderer() == EGL_PLATFORM_ANGLE_TYPE_VULKAN_ANGLE &&
+            IsGLExtensionEnabled("GL_AMD_performance_monitor"))
+        {
+            mCounterIndexMap = BuildCounterNameToIndexMap();
+            mInitialCounters = GetPerfCounters(mCounterIndexMap);
+            mReporter->RegisterFyiMetric(kCoalescedCopiesMetric, "count");
+            mReporter->RegisterFyiMetric(kStagingBytesMetric, "sizeInBytes");
+        }
+    }
+
+    void destroyBenchmark() override
+    {
+        if (!mCounterIndexMap.empty() && mIterationCount > 0)
+        {
+            const VulkanPerfCounters counters = GetPerfCounters(mCounterIndexMap);
+            recordIntegerMetric(kCoalescedCopiesMetric,
+                                static_cast<size_t>((counters.coalescedBufferUpdates -
+                                                     mInitialCounters.coalescedBufferUpdates) /
+                                                    mIterationCount),
+                                "count");
+            recordIntegerMetric(kStagingBytesMetric,
+                                static_cast<size_t>((counters.imageUpdateStagingBytes -
+                                                     mInitialCounters.imageUpdateStagingBytes) /
+                                                    mIterationCount),
+                                "sizeInBytes");
+        }
+
+        TextureUploadBenchmarkBase::destroyBenchmark();
+    }
+
+    void drawBenchmark() override;
+
+  private:
+    static constexpr char kCoalescedCopiesMetric[] = ".coalesced_copies_per_iteration";
+    static constexpr char kStagingBytesMetric[]    = ".staging_bytes_per_iteration";
+
+    GLint mNextTileRow       = 0;
+    uint64_t mIterationCount = 0;
+    CounterNameToIndexMap mCounterIndexMap;
+    VulkanPerfCounters mInitialCounters = {};
+};
+
 class TextureUploadFullMipBenchmark : public TextureUploadBenchmarkBase
 {
   public:
@@ -379,6 +515,51 @@ void TextureUploadSubImageBenchmark::drawBenchmark()
     ASSERT_GL_NO_ERROR();
 }
 
+void TextureUploadFormatBenchmark::drawBenchmark()
+{
+    const auto &params = GetParam();
+
+    startGpuTimer();
+    for (unsigned int iteration = 0; iteration < params.iterationsPerStep; ++iteration)
+    {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, params.baseSize, params.baseSize, params.format,
+                        GL_UNSIGNED_BYTE, mTextureData.data());
+
+        // Perform a draw just so the texture data is flushed.  With the position attributes not
+        // set, a constant default value is used, resulting in a very cheap draw.
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+    }
+    stopGpuTimer();
+
+    ASSERT_GL_NO_ERROR();
+}
+
+void TextureUploadTileStreamingBenchmark::drawBenchmark()
+{
+    const auto &params       = GetParam();
+    const GLint tilesPerSide = params.baseSize / params.subImageSize;
+
+    startGpuTimer();
+    for (unsigned int iteration = 0; iteration < params.iterationsPerStep; ++iteration)
+    {
+        const GLint y = mNextTileRow * params.subImageSize;
+        for (GLint tile = 0; tile < tilesPerSide; ++tile)
+        {
+            glTexSubImage2D(GL_TEXTURE_2D, 0, tile * params.subImageSize, y, params.subImageSize,
+                            params.subImageSize, GL_RGBA, GL_UNSIGNED_BYTE, mTextureData.data());
+        }
+        mNextTileRow = (mNextTileRow + 1) % tilesPerSide;
+        ++mIterationCount;
+
+        // Perform a draw just so the texture data is flushed.  With the position attributes not
+        // set, a constant default value is used, resulting in a very cheap draw.
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+    }
+    stopGpuTimer();
+
+    ASSERT_GL_NO_ERROR();
+}
+
 void TextureUploadFullMipBenchmark::drawBenchmark()
 {
     const auto &params = GetParam();
@@ -488,6 +669,25 @@ TextureUploadParams ES3VulkanParams(bool webglCompat)
     return params;
 }
 
+std::vector<TextureUploadParams> FormatParams()
+{
+    constexpr GLenum kFormats[] = {GL_RGBA, GL_RGB, GL_LUMINANCE_ALPHA, GL_LUMINANCE, GL_ALPHA};
+
+    std::vector<TextureUploadParams> allParams;
+    for (GLenum format : kFormats)
+    {
+        std::vector<TextureUploadParams> platformParams = {
+            D3D11Params(false), MetalParams(false), OpenGLOrGLESParams(false),
+            VulkanParams(false), params::NullDevice(VulkanParams(false))};
+        for (TextureUploadParams &params : platformParams)
+        {
+            params.format = format;
+            allParams.push_back(params);
+        }
+    }
+    return allParams;
+}
+
 TextureUploadParams MetalPBOParams(GLsizei baseSize, GLsizei subImageSize)
 {
     TextureUploadParams params;
@@ -536,6 +736,17 @@ TEST_P(TextureUploadSubImageBenchmark, Run)
     run();
 }
 
+TEST_P(TextureUploadFormatBenchmark, Run)
+{
+    run();
+}
+
+// Test the upload of many small adjacent tiles per frame.
+TEST_P(TextureUploadTileStreamingBenchmark, Run)
+{
+    run();
+}
+
 TEST_P(TextureUploadFullMipBenchmark, Run)
 {
     run();
@@ -564,8 +775,17 @@ ANGLE_INSTANTIATE_TEST(TextureUploadSubImageBenchmark,
                        NullDevice(VulkanParams(false)),
                        VulkanParams(true));
 
+ANGLE_INSTANTIATE_TEST_ARRAY(TextureUploadFormatBenchmark, FormatParams());
+
 ANGLE_INSTANTIATE_TEST(TextureUploadETC2TranscodingBenchmark, ES3VulkanParams(false));
 
+ANGLE_INSTANTIATE_TEST(TextureUploadTileStreamingBenchmark,
+                       D3D11Params(false),
+                       MetalParams(false),
+                       OpenGLOrGLESParams(false),
+                       VulkanParams(false),
+                       NullDevice(VulkanParams(false)));
+
 ANGLE_INSTANTIATE_TEST(TextureUploadFullMipBenchmark,
                        D3D11Params(false),
                        D3D11Params(true),
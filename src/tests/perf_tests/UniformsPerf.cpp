@@ -24,11 +24,16 @@ namespace
 {
 constexpr unsigned int kIterationsPerStep = 4;
 
-// Controls when we call glUniform, if the data is the same as last frame.
+// Number of uniforms (or array elements) set per draw with DataMode::SPARSE_UPDATE.
+constexpr size_t kSparseUpdatesPerDraw = 4;
+
+// Controls when we call glUniform, if the data is the same as last frame.  SPARSE_UPDATE only sets
+// a few uniforms per draw, like an application animating a few bones of a skinning palette.
 enum DataMode
 {
     UPDATE,
     REPEAT,
+    SPARSE_UPDATE,
 };
 
 // TODO(jmadill): Use an ANGLE enum for this?
@@ -70,6 +75,8 @@ struct UniformsParams final : public RenderTestParams
     std::string story() const override;
     size_t numVertexUniforms   = 200;
     size_t numFragmentUniforms = 200;
+    // If larger than one, each uniform is an array of this many elements.
+    size_t arraySize = 1;
 
     DataType dataType         = DataType::VEC4;
     DataMode dataMode         = DataMode::REPEAT;
@@ -106,6 +113,11 @@ std::string UniformsParams::story() const
         strstr << "_" << (numVertexUniforms + numFragmentUniforms) << "_mat4x4";
     }
 
+    if (arraySize > 1)
+    {
+        strstr << "_array" << arraySize;
+    }
+
     if (matrixLayout == MatrixLayout::TRANSPOSE)
     {
         strstr << "_transpose";
@@ -120,6 +132,10 @@ std::string UniformsParams::story() const
     {
         strstr << "_repeating";
     }
+    else if (dataMode == DataMode::SPARSE_UPDATE)
+    {
+        strstr << "_sparse";
+    }
 
     return strstr.str();
 }
@@ -145,6 +161,12 @@ class UniformsBenchmark : public ANGLERenderTest,
 
     using MatrixData = std::array<std::vector<Matrix4>, 2>;
     MatrixData mMatrixData;
+
+    // The next uniform set with DataMode::SPARSE_UPDATE.
+    size_t mNextSparseUniform;
+
+    // Alternates between the two data sets (and programs) on every draw, across steps too.
+    size_t mFrameIndex;
 };
 
 std::vector<Matrix4> GenMatrixData(size_t count, int parity)
@@ -169,7 +191,11 @@ std::vector<Matrix4> GenMatrixData(size_t count, int parity)
     return data;
 }
 
-UniformsBenchmark::UniformsBenchmark() : ANGLERenderTest("Uniforms", GetParam()), mPrograms({})
+UniformsBenchmark::UniformsBenchmark()
+    : ANGLERenderTest("Uniforms", GetParam()),
+      mPrograms({}),
+      mNextSparseUniform(0),
+      mFrameIndex(0)
 {
     if (IsWindows7() && IsNVIDIA() &&
         GetParam().eglParameters.renderer == EGL_PLATFORM_ANGLE_TYPE_VULKAN_ANGLE)
@@ -212,6 +238,8 @@ void UniformsBenchmark::initializeBenchmark()
             break;
     }
 
+    vectorCountPerUniform *= static_cast<GLint>(params.arraySize);
+
     GLint numVertexUniformVectors =
         static_cast<GLint>(params.numVertexUniforms) * vectorCountPerUniform;
     GLint numFragmentUniformVectors =
@@ -236,7 +264,7 @@ void UniformsBenchmark::initializeBenchmark()
 
     if (isMatrix)
     {
-        size_t count = params.numVertexUniforms + params.numFragmentUniforms;
+        size_t count = mUniformLocations.size();
 
         mMatrixData[0] = GenMatrixData(count, 0);
         if (params.dataMode == DataMode::REPEAT)
@@ -295,6 +323,17 @@ void UniformsBenchmark::initShaders()
             UNREACHABLE();
     }
 
+    // Arrays are indexed dynamically so that all of their elements are active.
+    std::string arrayDeclaration;
+    std::string vertexArrayIndex;
+    std::string fragmentArrayIndex;
+    if (params.arraySize > 1)
+    {
+        arrayDeclaration   = "[" + std::to_string(params.arraySize) + "]";
+        vertexArrayIndex   = "[int(pos.w) % " + std::to_string(params.arraySize) + "]";
+        fragmentArrayIndex = "[int(gl_FragCoord.x) % " + std::to_string(params.arraySize) + "]";
+    }
+
     std::stringstream vstrstr;
     vstrstr << "#version 300 es\n";
     vstrstr << "precision mediump float;\n";
@@ -302,7 +341,8 @@ void UniformsBenchmark::initShaders()
 
     for (size_t i = 0; i < params.numVertexUniforms; i++)
     {
-        vstrstr << "uniform " << typeString << " " << GetUniformLocationName(i, true) << ";\n";
+        vstrstr << "uniform " << typeString << " " << GetUniformLocationName(i, true)
+                << arrayDeclaration << ";\n";
     }
 
     vstrstr << "void main()\n"
@@ -314,7 +354,7 @@ void UniformsBenchmark::initShaders()
         std::size_t pos              = uniformOperation.find(kUniformVarPlaceHolder);
         ASSERT(pos != std::string::npos);
         uniformOperation.replace(pos, kUniformVarPlaceHolder.size(),
-                                 GetUniformLocationName(i, true));
+                                 GetUniformLocationName(i, true) + vertexArrayIndex);
         vstrstr << "    gl_Position += ";
         vstrstr << uniformOperation;
         vstrstr << ";\n";
@@ -328,7 +368,8 @@ void UniformsBenchmark::initShaders()
 
     for (size_t i = 0; i < params.numFragmentUniforms; i++)
     {
-        fstrstr << "uniform " << typeString << " " << GetUniformLocationName(i, false) << ";\n";
+        fstrstr << "uniform " << typeString << " " << GetUniformLocationName(i, false)
+                << arrayDeclaration << ";\n";
     }
     fstrstr << "void main()\n"
                "{\n"
@@ -339,7 +380,7 @@ void UniformsBenchmark::initShaders()
         std::size_t pos              = uniformOperation.find(kUniformVarPlaceHolder);
         ASSERT(pos != std::string::npos);
         uniformOperation.replace(pos, kUniformVarPlaceHolder.size(),
-                                 GetUniformLocationName(i, false));
+                                 GetUniformLocationName(i, false) + fragmentArrayIndex);
         fstrstr << "    fragColor += ";
         fstrstr << uniformOperation;
         fstrstr << ";\n";
@@ -357,7 +398,11 @@ void UniformsBenchmark::initShaders()
         GLint location   = glGetUniformLocation(mPrograms[0], name.c_str());
         ASSERT_NE(-1, location);
         ASSERT_EQ(location, glGetUniformLocation(mPrograms[1], name.c_str()));
-        mUniformLocations.push_back(location);
+        // Array elements have consecutive locations.
+        for (size_t element = 0; element < params.arraySize; ++element)
+        {
+            mUniformLocations.push_back(location + static_cast<GLint>(element));
+        }
     }
     for (size_t i = 0; i < params.numFragmentUniforms; ++i)
     {
@@ -365,7 +410,10 @@ void UniformsBenchmark::initShaders()
         GLint location   = glGetUniformLocation(mPrograms[0], name.c_str());
         ASSERT_NE(-1, location);
         ASSERT_EQ(location, glGetUniformLocation(mPrograms[1], name.c_str()));
-        mUniformLocations.push_back(location);
+        for (size_t element = 0; element < params.arraySize; ++element)
+        {
+            mUniformLocations.push_back(location + static_cast<GLint>(element));
+        }
     }
 
     // Use the program object
@@ -384,10 +432,11 @@ void UniformsBenchmark::drawLoop(const SetUniformFunc &setUniformsFunc)
 {
     const auto &params = GetParam();
 
-    size_t frameIndex = 0;
-
-    for (size_t it = 0; it < params.iterationsPerStep; ++it, frameIndex = (frameIndex == 0 ? 1 : 0))
+    for (size_t it = 0; it < params.iterationsPerStep; ++it)
     {
+        const size_t frameIndex = mFrameIndex;
+        mFrameIndex             = (mFrameIndex == 0 ? 1 : 0);
+
         if (MultiProgram)
         {
             glUseProgram(mPrograms[frameIndex]);
@@ -399,6 +448,14 @@ void UniformsBenchmark::drawLoop(const SetUniformFunc &setUniformsFunc)
                 setUniformsFunc(mUniformLocations, mMatrixData, uniform, frameIndex);
             }
         }
+        else if (params.dataMode == DataMode::SPARSE_UPDATE)
+        {
+            for (size_t update = 0; update < kSparseUpdatesPerDraw; ++update)
+            {
+                setUniformsFunc(mUniformLocations, mMatrixData, mNextSparseUniform, frameIndex);
+                mNextSparseUniform = (mNextSparseUniform + 1) % mUniformLocations.size();
+            }
+        }
         glDrawArrays(GL_TRIANGLES, 0, 3);
     }
 }
@@ -500,6 +557,25 @@ UniformsParams MatrixUniforms(const EGLPlatformParameters &egl,
     return params;
 }
 
+// A skinning palette in each shader stage, of which only a few matrices change per draw.
+UniformsParams MatrixPaletteUniforms(const EGLPlatformParameters &egl, DataMode dataMode)
+{
+    UniformsParams params;
+    params.eglParameters = egl;
+    params.dataType      = DataType::MAT4x4;
+    params.dataMode      = dataMode;
+
+    params.numVertexUniforms   = 1;
+    params.numFragmentUniforms = 1;
+    params.arraySize           = 48;
+
+    // A skinned mesh is typically drawn once per frame.  By the next frame, the GPU is often done
+    // with the palette, which lets the Vulkan backend write only the changed matrices in place.
+    params.iterationsPerStep = 1;
+
+    return params;
+}
+
 }  // anonymous namespace
 
 TEST_P(UniformsBenchmark, Run)
@@ -533,4 +609,9 @@ ANGLE_INSTANTIATE_TEST(
     MatrixUniforms(VULKAN(), DataMode::REPEAT, DataType::MAT4x4, MatrixLayout::NO_TRANSPOSE),
     MatrixUniforms(VULKAN(), DataMode::UPDATE, DataType::MAT3x3, MatrixLayout::NO_TRANSPOSE),
     MatrixUniforms(VULKAN(), DataMode::REPEAT, DataType::MAT3x3, MatrixLayout::NO_TRANSPOSE),
+    MatrixPaletteUniforms(OPENGL_OR_GLES(), DataMode::SPARSE_UPDATE),
+    MatrixPaletteUniforms(VULKAN_NULL(), DataMode::UPDATE),
+    MatrixPaletteUniforms(VULKAN_NULL(), DataMode::SPARSE_UPDATE),
+    MatrixPaletteUniforms(VULKAN(), DataMode::UPDATE),
+    MatrixPaletteUniforms(VULKAN(), DataMode::SPARSE_UPDATE),
     VectorUniforms(D3D11_NULL(), DataMode::REPEAT, ProgramMode::MULTIPLE));
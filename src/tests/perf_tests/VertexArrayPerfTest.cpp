@@ -4,7 +4,7 @@
 // found in the LICENSE file.
 //
 // VertexArrayPerfTest:
-//   Performance test for glBindVertexArray.
+//   Performance test for glBindVertexArray, and for the conversion of client-side vertex data.
 //
 
 #include "ANGLEPerfTest.h"
@@ -15,11 +15,16 @@ using namespace angle;
 
 namespace
 {
+constexpr GLsizei kClientVertexCount = 65536;
+
 enum class TestMode
 {
     BufferData,
     BindBuffer,
     UpdateBufferData,
+    // Draws with a client-side array of 3-component normalized shorts, which backends that don't
+    // support the format convert on the CPU.
+    ConvertClientData,
 };
 
 struct VertexArrayParams final : public RenderTestParams
@@ -63,6 +68,10 @@ std::string VertexArrayParams::story() const
     {
         strstr << "_updatebufferdata";
     }
+    else if (testMode == TestMode::ConvertClientData)
+    {
+        strstr << "_convertclientdata";
+    }
 
     return strstr.str();
 }
@@ -85,6 +94,7 @@ class VertexArrayBenchmark : public ANGLERenderTest,
     GLuint mProgram       = 0;
     GLint mAttribLocation = 0;
     std::vector<GLuint> mVertexArrays;
+    std::vector<GLshort> mClientData;
 };
 
 VertexArrayBenchmark::VertexArrayBenchmark() : ANGLERenderTest("VertexArrayPerf", GetParam()) {}
@@ -130,6 +140,19 @@ void main()
 
     glBindVertexArray(0);
     glBindBuffer(GL_ARRAY_BUFFER, mBuffers[0]);
+
+    if (GetParam().testMode == TestMode::ConvertClientData)
+    {
+        mClientData.resize(kClientVertexCount * 3);
+        for (size_t index = 0; index < mClientData.size(); ++index)
+        {
+            mClientData[index] = static_cast<GLshort>(index * 131);
+        }
+
+        // Client-side arrays can only be used with the default vertex array and no bound buffer.
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glEnableVertexAttribArray(mAttribLocation);
+    }
 }
 
 void VertexArrayBenchmark::rebindVertexArray(GLuint vertexArrayID, GLuint bufferID)
@@ -182,6 +205,12 @@ void VertexArrayBenchmark::drawBenchmark()
             updateBufferData(vertexArray, mBuffers[0], params.bufferSize[bufferSizeIndex]);
         }
     }
+    else if (params.testMode == TestMode::ConvertClientData)
+    {
+        // The client data is streamed and converted again on every draw.
+        glVertexAttribPointer(mAttribLocation, 3, GL_SHORT, GL_TRUE, 0, mClientData.data());
+        glDrawArrays(GL_POINTS, 0, kClientVertexCount);
+    }
     else
     {
         int bufferIndex = 0;
@@ -205,10 +234,11 @@ VertexArrayParams MetalParams()
     return params;
 }
 
-VertexArrayParams VulkanParams()
+VertexArrayParams VulkanParams(TestMode testMode)
 {
     VertexArrayParams params;
     params.eglParameters = egl_platform::VULKAN();
+    params.testMode      = testMode;
     return params;
 }
 
@@ -223,9 +253,11 @@ VertexArrayParams VulkanNullParams(TestMode testMode)
 GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(VertexArrayBenchmark);
 ANGLE_INSTANTIATE_TEST(VertexArrayBenchmark,
                        MetalParams(),
-                       VulkanParams(),
+                       VulkanParams(TestMode::BufferData),
+                       VulkanParams(TestMode::ConvertClientData),
                        VulkanNullParams(TestMode::BindBuffer),
                        VulkanNullParams(TestMode::BufferData),
                        VulkanNullParams(TestMode::UpdateBufferData),
+                       VulkanNullParams(TestMode::ConvertClientData),
                        params::Native(VertexArrayParams()));
 }  // namespace
@@ -10,6 +10,8 @@
 
 #include "ANGLEPerfTest.h"
 #include "common/platform.h"
+#include "common/system_utils.h"
+#include "libANGLE/renderer/vulkan/SecondaryCommandBuffer.h"
 #include "test_utils/third_party/vulkan_command_buffer_utils.h"
 
 #if defined(ANDROID)
@@ -62,6 +64,13 @@ struct CommandBufferTestParams
     std::string story;
     int frames  = NUM_FRAMES;
     int buffers = NUM_CMD_BUFFERS;
+    // Whether the draws are recorded in ANGLE's secondary command buffers instead of with
+    // CBImplementation, and whether the redundant commands are elided before they are replayed.
+    bool angleSecondaryCB       = false;
+    bool elideRedundantCommands = false;
+    // Whether the draw and dynamic state parameters fit in the packed encoding of ANGLE's
+    // secondary command buffers.
+    bool packable = true;
 };
 
 class VulkanCommandBufferPerfTest : public ANGLEPerfTest,
@@ -75,6 +84,9 @@ class VulkanCommandBufferPerfTest : public ANGLEPerfTest,
     void step() override;
 
   private:
+    void angleSecondaryCommandBufferBenchmark();
+    void recordAngleSecondaryCommandBuffer();
+
     VkClearValue mClearValues[2]        = {};
     VkSemaphore mImageAcquiredSemaphore = VK_NULL_HANDLE;
     VkFence mDrawFence                  = VK_NULL_HANDLE;
@@ -86,6 +98,15 @@ class VulkanCommandBufferPerfTest : public ANGLEPerfTest,
     CommandBufferImpl mCBImplementation = nullptr;
     int mFrames                         = 0;
     int mBuffers                        = 0;
+
+    rx::vk::CommandMemorySlabPool mSlabPool;
+    rx::vk::DedicatedCommandBlockAllocator mAngleAllocator;
+    rx::vk::priv::SecondaryCommandBuffer mAngleCommandBuffer;
+    rx::vk::PrimaryCommandBuffer mAnglePrimaryCommandBuffer;
+    rx::vk::Pipeline mAnglePipeline;
+    rx::vk::PipelineLayout mAnglePipelineLayout;
+    double mReplayTime = 0.0;
+    int mReplayCount   = 0;
 };
 
 VulkanCommandBufferPerfTest::VulkanCommandBufferPerfTest()
@@ -153,6 +174,16 @@ void VulkanCommandBufferPerfTest::SetUp()
     fenceInfo.flags = 0;
     res             = vkCreateFence(mInfo.device, &fenceInfo, NULL, &mDrawFence);
     ASSERT_EQ(VK_SUCCESS, res);
+
+    if (GetParam().angleSecondaryCB)
+    {
+        mAngleAllocator.init(&mSlabPool);
+        mAnglePrimaryCommandBuffer.setHandle(mInfo.cmd);
+        mAnglePipeline.setHandle(mInfo.pipeline);
+        mAnglePipelineLayout.setHandle(mInfo.pipeline_layout);
+        mReporter->RegisterFyiMetric(".replay_time", "ns");
+        mReporter->RegisterFyiMetric(".replayed_draws_per_second", "count");
+    }
 }
 
 void VulkanCommandBufferPerfTest::step()
@@ -167,12 +198,35 @@ void VulkanCommandBufferPerfTest::step()
         // Deal with the VK_SUBOPTIMAL_KHR and VK_ERROR_OUT_OF_DATE_KHR
         // return codes
         ASSERT_EQ(VK_SUCCESS, res);
-        mCBImplementation(mInfo, mClearValues, mDrawFence, mImageAcquiredSemaphore, mBuffers);
+        if (GetParam().angleSecondaryCB)
+        {
+            angleSecondaryCommandBufferBenchmark();
+        }
+        else
+        {
+            mCBImplementation(mInfo, mClearValues, mDrawFence, mImageAcquiredSemaphore, mBuffers);
+        }
     }
 }
 
 void VulkanCommandBufferPerfTest::TearDown()
 {
+    if (GetParam().angleSecondaryCB)
+    {
+        // Time to replay the commands of a frame in the primary, including the elision.
+        if (mReplayCount > 0 && mReplayTime > 0.0)
+        {
+            recordDoubleMetric(".replay_time", mReplayTime * 1e9 / mReplayCount, "ns");
+            recordDoubleMetric(".replayed_draws_per_second",
+                               static_cast<double>(mReplayCount) * mBuffers / mReplayTime, "count");
+        }
+
+        mAngleCommandBuffer.reset();
+        mAnglePrimaryCommandBuffer.release();
+        mAnglePipeline.release();
+        mAnglePipelineLayout.release();
+    }
+
     vkDestroySemaphore(mInfo.device, mImageAcquiredSemaphore, NULL);
     vkDestroyFence(mInfo.device, mDrawFence, NULL);
     destroy_pipeline(mInfo);
@@ -547,6 +601,105 @@ void CommandBufferImplicitResetBenchmark(sample_info &info,
                                     numBuffers);
 }
 
+// The draws of SecondaryCommandBufferBenchmark, recorded in one of ANGLE's secondary command
+// buffers and replayed in the render pass of the primary.
+void VulkanCommandBufferPerfTest::angleSecondaryCommandBufferBenchmark()
+{
+    recordAngleSecondaryCommandBuffer();
+
+    VkRenderPassBeginInfo rpBegin;
+    rpBegin.sType                    = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+    rpBegin.pNext                    = NULL;
+    rpBegin.renderPass               = mInfo.render_pass;
+    rpBegin.framebuffer              = mInfo.framebuffers[mInfo.current_buffer];
+    rpBegin.renderArea.offset.x      = 0;
+    rpBegin.renderArea.offset.y      = 0;
+    rpBegin.renderArea.extent.width  = mInfo.width;
+    rpBegin.renderArea.extent.height = mInfo.height;
+    rpBegin.clearValueCount          = 2;
+    rpBegin.pClearValues             = mClearValues;
+
+    VkCommandBufferBeginInfo primaryCommandBufferInfo = {};
+    primaryCommandBufferInfo.sType                    = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    primaryCommandBufferInfo.pNext                    = NULL;
+    primaryCommandBufferInfo.flags                    = 0;
+    primaryCommandBufferInfo.pInheritanceInfo         = NULL;
+
+    vkBeginCommandBuffer(mInfo.cmd, &primaryCommandBufferInfo);
+    vkCmdBeginRenderPass(mInfo.cmd, &rpBegin, VK_SUBPASS_CONTENTS_INLINE);
+
+    // The elision happens right before the replay, so it is part of its cost.
+    const double replayStartTime = angle::GetCurrentSystemTime();
+    if (GetParam().elideRedundantCommands)
+    {
+        mAngleCommandBuffer.elideRedundantCommands();
+    }
+    mAngleCommandBuffer.executeCommands(&mAnglePrimaryCommandBuffer);
+    mReplayTime += angle::GetCurrentSystemTime() - replayStartTime;
+    ++mReplayCount;
+
+    vkCmdEndRenderPass(mInfo.cmd);
+    res = vkEndCommandBuffer(mInfo.cmd);
+    ASSERT_EQ(VK_SUCCESS, res);
+
+    const VkCommandBuffer cmd_bufs[]      = {mInfo.cmd};
+    VkPipelineStageFlags pipe_stage_flags = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    VkSubmitInfo submitInfo[1]            = {};
+    submitInfo[0].pNext                   = NULL;
+    submitInfo[0].sType                   = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo[0].waitSemaphoreCount      = 1;
+    submitInfo[0].pWaitSemaphores         = &mImageAcquiredSemaphore;
+    submitInfo[0].pWaitDstStageMask       = &pipe_stage_flags;
+    submitInfo[0].commandBufferCount      = 1;
+    submitInfo[0].pCommandBuffers         = cmd_bufs;
+    submitInfo[0].signalSemaphoreCount    = 0;
+    submitInfo[0].pSignalSemaphores       = NULL;
+
+    // Queue the command buffer for execution
+    res = vkQueueSubmit(mInfo.graphics_queue, 1, submitInfo, mDrawFence);
+    ASSERT_EQ(VK_SUCCESS, res);
+
+    Present(mInfo, mDrawFence);
+}
+
+// Like applications often do, every draw sets all of its state, most of which doesn't change.
+void VulkanCommandBufferPerfTest::recordAngleSecondaryCommandBuffer()
+{
+    mAngleCommandBuffer.reset();
+    mAngleAllocator.resetAllocator();
+    (void)mAngleCommandBuffer.initialize(nullptr, nullptr, true, mAngleAllocator.getAllocator());
+
+    // Large vertex offsets and fractional viewports need the full encoding.
+    const bool packable        = GetParam().packable;
+    const uint32_t firstVertex = packable ? 0 : 100000;
+    const float viewportOffset = packable ? 0.0f : 0.5f;
+    const uint32_t width       = static_cast<uint32_t>(mInfo.width);
+    const uint32_t height      = static_cast<uint32_t>(mInfo.height);
+
+    VkViewport viewport = {};
+    viewport.x          = viewportOffset;
+    viewport.y          = viewportOffset;
+    viewport.width      = static_cast<float>(width) - viewportOffset;
+    viewport.height     = static_cast<float>(height) - viewportOffset;
+    viewport.maxDepth   = 1.0f;
+
+    const VkRect2D scissor        = {{0, 0}, {width, height}};
+    const VkDeviceSize offsets[1] = {0};
+
+    for (int x = 0; x < mBuffers; x++)
+    {
+        mAngleCommandBuffer.bindGraphicsPipeline(mAnglePipeline);
+        mAngleCommandBuffer.bindDescriptorSets(
+            mAnglePipelineLayout, VK_PIPELINE_BIND_POINT_GRAPHICS,
+            rx::DescriptorSetIndex::UniformsAndXfb, NUM_DESCRIPTOR_SETS, mInfo.desc_set.data(), 0,
+            nullptr);
+        mAngleCommandBuffer.bindVertexBuffers(0, 1, &mInfo.vertex_buffer.buf, offsets);
+        mAngleCommandBuffer.setViewport(0, 1, &viewport);
+        mAngleCommandBuffer.setScissor(0, 1, &scissor);
+        mAngleCommandBuffer.draw(0, firstVertex);
+    }
+}
+
 CommandBufferTestParams PrimaryCBHundredIndividualParams()
 {
     CommandBufferTestParams params;
@@ -619,6 +772,35 @@ CommandBufferTestParams CommandBufferImplicitResetParams()
     return params;
 }
 
+CommandBufferTestParams AngleSecondaryCBParams()
+{
+    CommandBufferTestParams params;
+    params.CBImplementation = nullptr;
+    params.story            = "_AngleSecondaryCB_Submit_1_With_100_Draw";
+    params.angleSecondaryCB = true;
+    return params;
+}
+
+CommandBufferTestParams AngleSecondaryCBElideRedundantCommandsParams()
+{
+    CommandBufferTestParams params;
+    params.CBImplementation       = nullptr;
+    params.story                  = "_AngleSecondaryCB_Submit_1_With_100_Draw_Elide_Redundant";
+    params.angleSecondaryCB       = true;
+    params.elideRedundantCommands = true;
+    return params;
+}
+
+CommandBufferTestParams AngleSecondaryCBNotPackableParams()
+{
+    CommandBufferTestParams params;
+    params.CBImplementation = nullptr;
+    params.story            = "_AngleSecondaryCB_Submit_1_With_100_Draw_Not_Packable";
+    params.angleSecondaryCB = true;
+    params.packable         = false;
+    return params;
+}
+
 TEST_P(VulkanCommandBufferPerfTest, Run)
 {
     run();
@@ -634,4 +816,7 @@ INSTANTIATE_TEST_SUITE_P(,
                                            CommandPoolSoftResetParams(),
                                            CommandBufferExplicitHardResetParams(),
                                            CommandBufferExplicitSoftResetParams(),
-                                           CommandBufferImplicitResetParams()));
+                                           CommandBufferImplicitResetParams(),
+                                           AngleSecondaryCBParams(),
+                                           AngleSecondaryCBElideRedundantCommandsParams(),
+                                           AngleSecondaryCBNotPackableParams()));
@@ -82,9 +82,10 @@ void VulkanPipelineCachePerfTest::SetUp()
 
 void VulkanPipelineCachePerfTest::randomizeDesc(vk::GraphicsPipelineDesc *desc)
 {
-    std::vector<uint8_t> bytes(sizeof(vk::GraphicsPipelineDesc));
+    // Only the key is randomized; the cached hashes that follow it are marked dirty below.
+    std::vector<uint8_t> bytes(vk::kGraphicsPipelineDescSumOfSizes);
     FillVectorWithRandomUBytes(&mRNG, &bytes);
-    memcpy(desc, bytes.data(), sizeof(vk::GraphicsPipelineDesc));
+    memcpy(desc, bytes.data(), vk::kGraphicsPipelineDescSumOfSizes);
 
     desc->setSupportsDynamicStateForTest(GetParam().withDynamicState);
 }
@@ -0,0 +1,144 @@
+//
+// Copyright 2025 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// VulkanSecondaryCommandBufferPerf:
+//   Performance benchmark for recording a draw-heavy render pass in ANGLE's secondary command
+//   buffers, and for the size of the recorded commands.  Replaying the commands needs a device, so
+//   it is measured by the AngleSecondaryCB variants of VulkanCommandBufferPerf instead.
+
+#include "ANGLEPerfTest.h"
+
+#include <array>
+
+#include "libANGLE/renderer/vulkan/SecondaryCommandBuffer.h"
+#include "libANGLE/renderer/vulkan/SecondaryCommandBufferTestUtils.h"
+
+using namespace rx;
+
+namespace
+{
+constexpr unsigned int kIterationsPerStep = 10;
+constexpr uint32_t kDrawsPerRenderPass    = 1000;
+constexpr uint32_t kPipelineCount         = 8;
+
+struct Params
+{
+    // Whether the draw and dynamic state parameters fit in the packed encoding of the commands.
+    bool packable = true;
+};
+
+std::ostream &operator<<(std::ostream &os, const Params &params)
+{
+    os << (params.packable ? "packable" : "not_packable");
+    return os;
+}
+
+class VulkanSecondaryCommandBufferPerfTest : public ANGLEPerfTest,
+                                             public ::testing::WithParamInterface<Params>
+{
+  public:
+    VulkanSecondaryCommandBufferPerfTest();
+    ~VulkanSecondaryCommandBufferPerfTest() override;
+
+    void SetUp() override;
+    void step() override;
+
+  private:
+    void recordRenderPass();
+
+    vk::CommandMemorySlabPool mSlabPool;
+    vk::DedicatedCommandBlockAllocator mAllocator;
+    vk::priv::SecondaryCommandBuffer mCommandBuffer;
+    std::array<vk::Pipeline, kPipelineCount> mPipelines;
+};
+
+VulkanSecondaryCommandBufferPerfTest::VulkanSecondaryCommandBufferPerfTest()
+    : ANGLEPerfTest("VulkanSecondaryCommandBufferPerf",
+                    "",
+                    GetParam().packable ? "_packable" : "_not_packable",
+                    kIterationsPerStep)
+{}
+
+VulkanSecondaryCommandBufferPerfTest::~VulkanSecondaryCommandBufferPerfTest()
+{
+    for (vk::Pipeline &pipeline : mPipelines)
+    {
+        pipeline.setHandle(VK_NULL_HANDLE);
+    }
+}
+
+void VulkanSecondaryCommandBufferPerfTest::SetUp()
+{
+    ANGLEPerfTest::SetUp();
+
+    for (uint32_t index = 0; index < kPipelineCount; ++index)
+    {
+        mPipelines[index].setHandle(vk::MakeHandle<VkPipeline>(index + 1));
+    }
+
+    mAllocator.init(&mSlabPool);
+
+    // Report the size of the commands of one render pass.
+    recordRenderPass();
+
+    size_t usedMemory      = 0;
+    size_t allocatedMemory = 0;
+    mCommandBuffer.getMemoryUsageStats(&usedMemory, &allocatedMemory);
+    mReporter->RegisterFyiMetric(".used_bytes_per_render_pass", "sizeInBytes");
+    mReporter->RegisterFyiMetric(".allocated_bytes_per_render_pass", "sizeInBytes");
+    recordIntegerMetric(".used_bytes_per_render_pass", usedMemory, "sizeInBytes");
+    recordIntegerMetric(".allocated_bytes_per_render_pass", allocatedMemory, "sizeInBytes");
+}
+
+void VulkanSecondaryCommandBufferPerfTest::recordRenderPass()
+{
+    mCommandBuffer.reset();
+    mAllocator.resetAllocator();
+    (void)mCommandBuffer.initialize(nullptr, nullptr, true, mAllocator.getAllocator());
+
+    // Large vertex offsets and fractional viewports need the full encoding.
+    const bool packable        = GetParam().packable;
+    const uint32_t firstVertex = packable ? 0 : 100000;
+    const float viewportOffset = packable ? 0.0f : 0.5f;
+
+    for (uint32_t draw = 0; draw < kDrawsPerRenderPass; ++draw)
+    {
+        if (draw % 16 == 0)
+        {
+            mCommandBuffer.bindGraphicsPipeline(mPipelines[(draw / 16) % kPipelineCount]);
+        }
+
+        // Draw to a different tile of the render target every time.
+        const int32_t x           = static_cast<int32_t>(draw % 32) * 64;
+        const int32_t y           = static_cast<int32_t>(draw / 32 % 32) * 64;
+        const float viewportX     = static_cast<float>(x) + viewportOffset;
+        const float viewportY     = static_cast<float>(y) + viewportOffset;
+        const VkViewport viewport = {viewportX, viewportY, 64.0f, 64.0f, 0.0f, 1.0f};
+        const VkRect2D scissor    = {{x, y}, {64, 64}};
+
+        mCommandBuffer.setViewport(0, 1, &viewport);
+        mCommandBuffer.setScissor(0, 1, &scissor);
+        mCommandBuffer.draw(6, firstVertex + draw * 6);
+    }
+}
+
+void VulkanSecondaryCommandBufferPerfTest::step()
+{
+    for (unsigned int iteration = 0; iteration < kIterationsPerStep; ++iteration)
+    {
+        recordRenderPass();
+    }
+}
+}  // anonymous namespace
+
+// Test performance of recording draws and dynamic state in ANGLE's secondary command buffers.
+TEST_P(VulkanSecondaryCommandBufferPerfTest, Run)
+{
+    run();
+}
+
+INSTANTIATE_TEST_SUITE_P(,
+                         VulkanSecondaryCommandBufferPerfTest,
+                         ::testing::ValuesIn(std::vector<Params>{{Params{true}, Params{false}}}));
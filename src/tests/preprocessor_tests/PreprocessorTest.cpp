@@ -61,20 +61,20 @@ void SimplePreprocessorTest::preprocess(const char *input, const char *expected,
 
 void SimplePreprocessorTest::lexSingleToken(const char *input, pp::Token *token)
 {
-    pp::Preprocessor preprocessor(&mDiagnostics, &mDirectiveHandler,
-                                  pp::PreprocessorSettings(SH_GLES2_SPEC));
-    ASSERT_TRUE(preprocessor.init(1, &input, nullptr));
-    preprocessor.lex(token);
+    mLexPreprocessor.reset(new pp::Preprocessor(&mDiagnostics, &mDirectiveHandler,
+                                                pp::PreprocessorSettings(SH_GLES2_SPEC)));
+    ASSERT_TRUE(mLexPreprocessor->init(1, &input, nullptr));
+    mLexPreprocessor->lex(token);
 }
 
 void SimplePreprocessorTest::lexSingleToken(size_t count,
                                             const char *const input[],
                                             pp::Token *token)
 {
-    pp::Preprocessor preprocessor(&mDiagnostics, &mDirectiveHandler,
-                                  pp::PreprocessorSettings(SH_GLES2_SPEC));
-    ASSERT_TRUE(preprocessor.init(count, input, nullptr));
-    preprocessor.lex(token);
+    mLexPreprocessor.reset(new pp::Preprocessor(&mDiagnostics, &mDirectiveHandler,
+                                                pp::PreprocessorSettings(SH_GLES2_SPEC)));
+    ASSERT_TRUE(mLexPreprocessor->init(count, input, nullptr));
+    mLexPreprocessor->lex(token);
 }
 
 }  // namespace angle
@@ -6,6 +6,8 @@
 
 #include "gtest/gtest.h"
 
+#include <memory>
+
 #include "MockDiagnostics.h"
 #include "MockDirectiveHandler.h"
 #include "compiler/preprocessor/Preprocessor.h"
@@ -49,6 +51,9 @@ class SimplePreprocessorTest : public testing::Test
 
   private:
     void preprocess(const char *input, std::stringstream *output, pp::Preprocessor *preprocessor);
+
+    // The preprocessor used by lexSingleToken, which owns the text of the token.
+    std::unique_ptr<pp::Preprocessor> mLexPreprocessor;
 };
 
 }  // namespace angle
@@ -6,6 +6,7 @@
 
 #include "gtest/gtest.h"
 
+#include "compiler/preprocessor/InternTable.h"
 #include "compiler/preprocessor/Token.h"
 
 namespace angle
@@ -28,7 +29,7 @@ TEST(TokenTest, Assignment)
     token.flags         = 1;
     token.location.line = 1;
     token.location.file = 1;
-    token.text.assign("foo");
+    token.text = "foo";
 
     token = pp::Token();
     EXPECT_EQ(0, token.type);
@@ -59,13 +60,40 @@ TEST(TokenTest, Equals)
     EXPECT_FALSE(token.equals(pp::Token()));
     token.location.file = 0;
 
-    token.text.assign("foo");
+    token.text = "foo";
     EXPECT_FALSE(token.equals(pp::Token()));
-    token.text.clear();
+    token.text = std::string_view();
 
     EXPECT_TRUE(token.equals(pp::Token()));
 }
 
+// Test that equal strings are interned once, and that their storage doesn't move as more strings
+// are added.
+TEST(TokenTest, InternedText)
+{
+    pp::InternTable table;
+    EXPECT_TRUE(table.intern("").empty());
+
+    std::string foo          = "foo";
+    std::string_view fooText = table.intern(foo);
+    foo.clear();
+    EXPECT_EQ("foo", fooText);
+    EXPECT_EQ(fooText.data(), table.intern("foo").data());
+    EXPECT_EQ(table.intern("+").data(), table.intern("+").data());
+    EXPECT_EQ("1.5", table.store("1.5"));
+
+    std::vector<std::string_view> texts;
+    for (int index = 0; index < 10000; ++index)
+    {
+        texts.push_back(table.intern("identifier" + std::to_string(index)));
+    }
+    for (int index = 0; index < 10000; ++index)
+    {
+        EXPECT_EQ("identifier" + std::to_string(index), texts[index]);
+    }
+    EXPECT_EQ(fooText.data(), table.intern("foo").data());
+}
+
 TEST(TokenTest, HasLeadingSpace)
 {
     pp::Token token;
@@ -79,7 +107,7 @@ TEST(TokenTest, HasLeadingSpace)
 TEST(TokenTest, Write)
 {
     pp::Token token;
-    token.text.assign("foo");
+    token.text = "foo";
     std::stringstream out1;
     out1 << token;
     EXPECT_TRUE(out1.good());
@@ -119,6 +119,7 @@ constexpr PackedEnumMap<Feature, const char *> kFeatureNames = {{
     {Feature::DumpShaderSource, "dumpShaderSource"},
     {Feature::DumpTranslatedShaders, "dumpTranslatedShaders"},
     {Feature::EglColorspaceAttributePassthrough, "eglColorspaceAttributePassthrough"},
+    {Feature::ElideRedundantSecondaryCommands, "elideRedundantSecondaryCommands"},
     {Feature::EmulateAbsIntFunction, "emulateAbsIntFunction"},
     {Feature::EmulateAdvancedBlendEquations, "emulateAdvancedBlendEquations"},
     {Feature::EmulateAlphaToCoverage, "emulateAlphaToCoverage"},
@@ -425,6 +426,7 @@ constexpr PackedEnumMap<Feature, const char *> kFeatureNames = {{
     {Feature::SyncAllVertexArraysToDefault, "syncAllVertexArraysToDefault"},
     {Feature::SyncDefaultVertexArraysToDefault, "syncDefaultVertexArraysToDefault"},
     {Feature::SyncMonolithicPipelinesToBlobCache, "syncMonolithicPipelinesToBlobCache"},
+    {Feature::TransformShaderFunctionsInParallel, "transformShaderFunctionsInParallel"},
     {Feature::UnbindFBOBeforeSwitchingContext, "unbindFBOBeforeSwitchingContext"},
     {Feature::UncurrentEglSurfaceUponSurfaceDestroy, "uncurrentEglSurfaceUponSurfaceDestroy"},
     {Feature::UnfoldShortCircuits, "unfoldShortCircuits"},
@@ -457,6 +459,7 @@ constexpr PackedEnumMap<Feature, const char *> kFeatureNames = {{
     {Feature::UseVkEventForBufferBarrier, "useVkEventForBufferBarrier"},
     {Feature::UseVkEventForImageBarrier, "useVkEventForImageBarrier"},
     {Feature::UseVmaForImageSuballocation, "useVmaForImageSuballocation"},
+    {Feature::UseWorkStealingWorkerPool, "useWorkStealingWorkerPool"},
     {Feature::VaryingsRequireMatchingPrecisionInSpirv, "varyingsRequireMatchingPrecisionInSpirv"},
     {Feature::VerifyPipelineCacheInBlobCache, "verifyPipelineCacheInBlobCache"},
     {Feature::VertexIDDoesNotIncludeBaseVertex, "vertexIDDoesNotIncludeBaseVertex"},
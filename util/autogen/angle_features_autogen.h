@@ -119,6 +119,7 @@ enum class Feature
     DumpShaderSource,
     DumpTranslatedShaders,
     EglColorspaceAttributePassthrough,
+    ElideRedundantSecondaryCommands,
     EmulateAbsIntFunction,
     EmulateAdvancedBlendEquations,
     EmulateAlphaToCoverage,
@@ -425,6 +426,7 @@ enum class Feature
     SyncAllVertexArraysToDefault,
     SyncDefaultVertexArraysToDefault,
     SyncMonolithicPipelinesToBlobCache,
+    TransformShaderFunctionsInParallel,
     UnbindFBOBeforeSwitchingContext,
     UncurrentEglSurfaceUponSurfaceDestroy,
     UnfoldShortCircuits,
@@ -457,6 +459,7 @@ enum class Feature
     UseVkEventForBufferBarrier,
     UseVkEventForImageBarrier,
     UseVmaForImageSuballocation,
+    UseWorkStealingWorkerPool,
     VaryingsRequireMatchingPrecisionInSpirv,
     VerifyPipelineCacheInBlobCache,
     VertexIDDoesNotIncludeBaseVertex,